@@ -266,6 +266,35 @@ AbstractCatalog::GetResultWithSeqScan(
   return result_tiles;
 }
 
+/*@brief   Read the oids of every row in the catalog table, and move the oid
+ * counter past them. Recovery brings back rows whose oids have been handed
+ * out before the restart, while the counter starts over
+ * @param   txn               TransactionContext
+ * @param   oid_column_id     Column that holds the oid of a row
+ *
+ * @return  The oids of every row
+ */
+std::vector<oid_t> AbstractCatalog::RecoverOids(
+    concurrency::TransactionContext *txn, oid_t oid_column_id) {
+  auto result_tiles = GetResultWithSeqScan(txn, nullptr, {oid_column_id});
+
+  std::vector<oid_t> oids;
+  for (auto &tile : *result_tiles) {
+    for (auto tuple_id : *tile) {
+      oid_t oid = tile->GetValue(tuple_id, 0).GetAs<oid_t>();
+      oids.push_back(oid);
+
+      // the upper bits of an oid hold its catalog type
+      oid_t next_oid = (oid & ((1 << CATALOG_TYPE_OFFSET) - 1)) + 1;
+      oid_t current_oid = oid_.load();
+      while (current_oid < next_oid &&
+             oid_.compare_exchange_weak(current_oid, next_oid) == false) {
+      }
+    }
+  }
+  return oids;
+}
+
 /*@brief   Add index on catalog table
  * @param   key_attrs    indexed column offset(position)
  * @param   index_oid    index id(global unique)
@@ -370,6 +370,193 @@ void Catalog::Bootstrap() {
   ProcCatalog::GetInstance().UpdateOid(OID_FOR_USER_OFFSET);
 }
 
+/*@brief   Create the storage of the databases, tables and indexes whose
+ * catalog rows have been recovered, and move the oid counters past them.
+ * Recovery calls this whenever it has installed rows of the core catalog
+ * tables, so that the rows of pg_database create the system catalogs of their
+ * databases, and the rows of pg_table then create the user tables
+ * @param   txn         TransactionContext
+ */
+void Catalog::RecoverStorageObjects(concurrency::TransactionContext *txn) {
+  if (txn == nullptr)
+    throw CatalogException("Do not have transaction to recover the catalog");
+
+  auto storage_manager = storage::StorageManager::GetInstance();
+  auto pg_database = DatabaseCatalog::GetInstance(nullptr, nullptr, nullptr);
+  auto database_oids =
+      pg_database->RecoverOids(txn, DatabaseCatalog::ColumnId::DATABASE_OID);
+
+  for (auto database_oid : database_oids) {
+    if (storage_manager->HasDatabase(database_oid) == false) {
+      auto database_object =
+          pg_database->GetDatabaseCatalogEntry(txn, database_oid);
+      storage::Database *database = new storage::Database(database_oid);
+      database->setDBName(database_object->GetDatabaseName());
+      {
+        std::lock_guard<std::mutex> lock(catalog_mutex);
+        storage_manager->AddDatabaseToStorageManager(database);
+      }
+
+      // the rows of its system catalogs are recovered later, and the ones
+      // that are inserted here again are skipped then
+      BootstrapSystemCatalogs(txn, database);
+      catalog_map_[database_oid]->Bootstrap(txn,
+                                            database_object->GetDatabaseName());
+      LOG_DEBUG("Recovered database %s",
+                database_object->GetDatabaseName().c_str());
+    }
+
+    auto system_catalogs = catalog_map_[database_oid];
+    system_catalogs->GetSchemaCatalog()->RecoverOids(
+        txn, SchemaCatalog::ColumnId::SCHEMA_OID);
+    system_catalogs->GetIndexCatalog()->RecoverOids(
+        txn, IndexCatalog::ColumnId::INDEX_OID);
+    system_catalogs->GetConstraintCatalog()->RecoverOids(
+        txn, ConstraintCatalog::ColumnId::CONSTRAINT_OID);
+    auto table_oids = system_catalogs->GetTableCatalog()->RecoverOids(
+        txn, TableCatalog::ColumnId::TABLE_OID);
+
+    auto database = storage_manager->GetDatabaseWithOid(database_oid);
+    std::vector<storage::DataTable *> tables;
+    for (auto table_oid : table_oids) {
+      // system catalogs are created when the database is bootstrapped
+      if ((table_oid & ~TABLE_OID_MASK) < OID_FOR_USER_OFFSET) continue;
+      try {
+        database->GetTableWithOid(table_oid);
+        continue;
+      } catch (CatalogException &e) {
+        tables.push_back(RecoverTable(txn, database_oid, table_oid));
+      }
+    }
+
+    // the sink table of a foreign key may have been recovered after its
+    // source table
+    for (auto table : tables) {
+      for (auto &constraint : table->GetSchema()->GetConstraints()) {
+        if (constraint.second->GetType() != ConstraintType::FOREIGN) continue;
+        auto sink_table =
+            database->GetTableWithOid(constraint.second->GetFKSinkTableOid());
+        std::lock_guard<std::mutex> lock(catalog_mutex);
+        sink_table->GetSchema()->RegisterForeignKeySource(constraint.second);
+      }
+    }
+  }
+}
+
+/*@brief   Create a table, its constraints and its indexes from the rows in
+ * pg_table, pg_attribute, pg_constraint, pg_layout and pg_index. The indexes
+ * are populated as the tuples of the table are recovered
+ * @param   txn           TransactionContext
+ * @param   database_oid  the database which the table belongs to
+ * @param   table_oid     the table to recover
+ * @return  the recovered table
+ */
+storage::DataTable *Catalog::RecoverTable(concurrency::TransactionContext *txn,
+                                          oid_t database_oid,
+                                          oid_t table_oid) {
+  auto table_object = catalog_map_[database_oid]
+                          ->GetTableCatalog()
+                          ->GetTableCatalogEntry(txn, table_oid);
+
+  auto column_objects = table_object->GetColumnCatalogEntries();
+  std::vector<Column> columns(column_objects.size());
+  for (auto &entry : column_objects) {
+    auto column_object = entry.second;
+    Column column(column_object->GetColumnType(),
+                  column_object->GetColumnLength(),
+                  column_object->GetColumnName(),
+                  column_object->IsInlined());
+    if (column_object->IsNotNull()) {
+      column.SetNotNull();
+    }
+    if (column_object->HasDefault()) {
+      column.SetDefaultValue(column_object->GetDefaultValue());
+    }
+    columns[column_object->GetColumnId()] = column;
+  }
+
+  std::unique_ptr<catalog::Schema> schema(new Schema(columns));
+  for (auto &entry : table_object->GetConstraintCatalogEntries()) {
+    auto constraint_object = entry.second;
+    std::shared_ptr<Constraint> constraint;
+    switch (constraint_object->GetConstraintType()) {
+      case ConstraintType::FOREIGN:
+        constraint.reset(new Constraint(constraint_object->GetConstraintOid(),
+                                        ConstraintType::FOREIGN,
+                                        constraint_object->GetConstraintName(),
+                                        table_oid,
+                                        constraint_object->GetColumnIds(),
+                                        constraint_object->GetIndexOid(),
+                                        constraint_object->GetFKSinkTableOid(),
+                                        constraint_object->GetFKSinkColumnIds(),
+                                        constraint_object->GetFKUpdateAction(),
+                                        constraint_object->GetFKDeleteAction()));
+        break;
+      case ConstraintType::CHECK:
+        constraint.reset(new Constraint(constraint_object->GetConstraintOid(),
+                                        ConstraintType::CHECK,
+                                        constraint_object->GetConstraintName(),
+                                        table_oid,
+                                        constraint_object->GetColumnIds(),
+                                        constraint_object->GetIndexOid(),
+                                        constraint_object->GetCheckExp()));
+        break;
+      default:
+        constraint.reset(new Constraint(constraint_object->GetConstraintOid(),
+                                        constraint_object->GetConstraintType(),
+                                        constraint_object->GetConstraintName(),
+                                        table_oid,
+                                        constraint_object->GetColumnIds(),
+                                        constraint_object->GetIndexOid()));
+        break;
+    }
+    schema->AddConstraint(constraint);
+  }
+
+  // Create actual table with the layout it had
+  oid_t default_layout_oid = table_object->GetDefaultLayoutOid();
+  LayoutType layout_type = default_layout_oid == COLUMN_STORE_LAYOUT_OID
+                               ? LayoutType::COLUMN
+                               : LayoutType::ROW;
+  bool own_schema = true;
+  bool adapt_table = false;
+  auto table = storage::TableFactory::GetDataTable(
+      database_oid, table_oid, schema.release(), table_object->GetTableName(),
+      DEFAULT_TUPLES_PER_TILEGROUP, own_schema, adapt_table, false,
+      layout_type);
+  if (default_layout_oid != ROW_STORE_LAYOUT_OID &&
+      default_layout_oid != COLUMN_STORE_LAYOUT_OID) {
+    table->SetDefaultLayout(table_object->GetLayout(default_layout_oid));
+  }
+  storage::StorageManager::GetInstance()
+      ->GetDatabaseWithOid(database_oid)
+      ->AddTable(table, false);
+
+  // pg_index does not tell INCLUDE columns apart from key columns, so they
+  // are recovered as key columns
+  for (auto &entry : table_object->GetIndexCatalogEntries()) {
+    auto index_object = entry.second;
+    auto &key_attrs = index_object->GetKeyAttrs();
+    auto key_schema = catalog::Schema::CopySchema(table->GetSchema(),
+                                                  key_attrs);
+    key_schema->SetIndexedColumns(key_attrs);
+
+    auto index_metadata = new index::IndexMetadata(
+        index_object->GetIndexName(), index_object->GetIndexOid(), table_oid,
+        database_oid, index_object->GetIndexType(),
+        index_object->GetIndexConstraint(), table->GetSchema(), key_schema,
+        key_attrs, index_object->HasUniqueKeys());
+    std::shared_ptr<index::Index> key_index(
+        index::IndexFactory::GetIndex(index_metadata));
+    table->AddIndex(key_index);
+  }
+
+  LOG_DEBUG("Recovered table %s with %d indexes",
+            table_object->GetTableName().c_str(),
+            (int) table->GetValidIndexCount());
+  return table;
+}
+
 //===----------------------------------------------------------------------===//
 // CREATE FUNCTIONS
 //===----------------------------------------------------------------------===//
@@ -580,6 +767,10 @@ ResultType Catalog::CreateTable(concurrency::TransactionContext *txn,
  * @param   key_attrs        collection of the indexed attribute(column) name
  * @param   unique_keys      index supports duplicate key or not
  * @param   index_type       the type of index(default value is BWTREE)
+ * @param   index_valid      false if the index is populated after it is
+ *                           created, see SetIndexValid()
+ * @param   include_attrs    columns stored in the index but not part of its
+ *                           key (INCLUDE), see the other overload
  * @return  TransactionContext ResultType(SUCCESS or FAILURE)
  */
 ResultType Catalog::CreateIndex(concurrency::TransactionContext *txn,
@@ -589,7 +780,9 @@ ResultType Catalog::CreateIndex(concurrency::TransactionContext *txn,
                                 const std::string &index_name,
                                 const std::vector<oid_t> &key_attrs,
                                 bool unique_keys,
-                                IndexType index_type) {
+                                IndexType index_type,
+                                bool index_valid,
+                                const std::vector<oid_t> &include_attrs) {
   if (txn == nullptr)
     throw CatalogException("Do not have transaction to create database " +
         index_name);
@@ -630,7 +823,9 @@ ResultType Catalog::CreateIndex(concurrency::TransactionContext *txn,
                                    key_attrs,
                                    unique_keys,
                                    index_type,
-                                   index_constraint);
+                                   index_constraint,
+                                   index_valid,
+                                   include_attrs);
 
   return success;
 }
@@ -648,6 +843,14 @@ ResultType Catalog::CreateIndex(concurrency::TransactionContext *txn,
  * @param   unique_keys      index supports duplicate key or not
  * @param   index_type       the type of index
  * @param   index_constraint the constraint type of index
+ * @param   index_valid      false if the index is populated after it is
+ *                           created. Writers buffer their changes to it until
+ *                           the build finishes
+ * @param   include_attrs    columns that are stored in the index after the
+ *                           key columns (INCLUDE), so that index-only scans
+ *                           can return them. They are appended to key_attrs
+ *                           in pg_index. Unique indexes can not have them,
+ *                           as their keys would be compared as well
  * @return  TransactionContext ResultType(SUCCESS or FAILURE)
  */
 ResultType Catalog::CreateIndex(concurrency::TransactionContext *txn,
@@ -660,11 +863,17 @@ ResultType Catalog::CreateIndex(concurrency::TransactionContext *txn,
                                 const std::vector<oid_t> &key_attrs,
                                 bool unique_keys,
                                 IndexType index_type,
-                                IndexConstraintType index_constraint) {
+                                IndexConstraintType index_constraint,
+                                bool index_valid,
+                                const std::vector<oid_t> &include_attrs) {
   if (txn == nullptr)
     throw CatalogException("Do not have transaction to create index " +
         index_name);
 
+  if (unique_keys && include_attrs.empty() == false)
+    throw CatalogException("Unique index " + index_name +
+        " can not have INCLUDE columns");
+
   LOG_TRACE("Trying to create index for table %d", table_oid);
 
   if (is_catalog == false) {
@@ -690,17 +899,27 @@ ResultType Catalog::CreateIndex(concurrency::TransactionContext *txn,
   // Passed all checks, now get all index metadata
   LOG_TRACE("Trying to create index %s on table %d", index_name.c_str(),
             table_oid);
-  auto key_schema = catalog::Schema::CopySchema(schema, key_attrs);
-  key_schema->SetIndexedColumns(key_attrs);
+  // INCLUDE columns are stored as trailing key columns
+  std::vector<oid_t> stored_attrs(key_attrs);
+  stored_attrs.insert(stored_attrs.end(), include_attrs.begin(),
+                      include_attrs.end());
+  auto key_schema = catalog::Schema::CopySchema(schema, stored_attrs);
+  key_schema->SetIndexedColumns(stored_attrs);
 
   // Set index metadata
   auto index_metadata = new index::IndexMetadata(
       index_name, index_oid, table_oid, database_oid, index_type,
-      index_constraint, schema, key_schema, key_attrs, unique_keys);
+      index_constraint, schema, key_schema, stored_attrs, unique_keys,
+      include_attrs.size());
 
-  // Add index to table
+  // Add index to table. An index that is still to be populated starts
+  // buffering before writers can see it, so that none of their changes reach
+  // it before the build does
   std::shared_ptr<index::Index> key_index(
       index::IndexFactory::GetIndex(index_metadata));
+  if (index_valid == false) {
+    key_index->StartBuild();
+  }
   table->AddIndex(key_index);
 
   // Put index object into rw_object_set
@@ -715,8 +934,9 @@ ResultType Catalog::CreateIndex(concurrency::TransactionContext *txn,
                         index_type,
                         index_constraint,
                         unique_keys,
-                        key_attrs,
-                        pool_.get());
+                        stored_attrs,
+                        pool_.get(),
+                        index_valid);
 
   LOG_TRACE("Successfully add index for table %s contains %d indexes",
             table->GetName().c_str(), (int) table->GetValidIndexCount());
@@ -866,6 +1086,26 @@ ResultType Catalog::SetDefaultConstraint(concurrency::TransactionContext *txn,
   return ResultType::SUCCESS;
 }
 
+/**
+ * @brief   Mark an index as valid, i.e. usable by scans
+ * @param   txn           TransactionContext
+ * @param   database_oid  Database to which the index belongs to
+ * @param   index_oid     Index that has been built
+ * @return  ResultType(SUCCESS or FAILURE)
+ */
+ResultType Catalog::SetIndexValid(concurrency::TransactionContext *txn,
+                                  oid_t database_oid,
+                                  oid_t index_oid) {
+  auto pg_index = catalog_map_[database_oid]->GetIndexCatalog();
+  if (pg_index->UpdateIndexValid(txn, database_oid, index_oid, true) ==
+      false) {
+    return ResultType::FAILURE;
+  }
+
+  LOG_TRACE("Index %d is now valid", index_oid);
+  return ResultType::SUCCESS;
+}
+
 //===--------------------------------------------------------------------===//
 // ADD FUNCTIONS FOR TABLE CONSTRAINT
 //===--------------------------------------------------------------------===//
@@ -41,6 +41,8 @@ IndexCatalogEntry::IndexCatalogEntry(executor::LogicalTile *tile, int tupleId)
           tile->GetValue(tupleId, IndexCatalog::ColumnId::INDEX_CONSTRAINT)
               .GetAs<IndexConstraintType>()),
       unique_keys_(tile->GetValue(tupleId, IndexCatalog::ColumnId::UNIQUE_KEYS)
+                      .GetAs<bool>()),
+      index_valid_(tile->GetValue(tupleId, IndexCatalog::ColumnId::INDEX_VALID)
                       .GetAs<bool>()) {
   std::string attr_str =
       tile->GetValue(tupleId, IndexCatalog::ColumnId::INDEXED_ATTRIBUTES)
@@ -120,11 +122,15 @@ std::unique_ptr<catalog::Schema> IndexCatalog::InitializeSchema() {
       type::TypeId::VARCHAR, max_name_size_, "indexed_attributes", false);
   indexed_attributes_column.SetNotNull();
 
+  auto index_valid_column = catalog::Column(
+      type::TypeId::BOOLEAN, type::Type::GetTypeSize(type::TypeId::BOOLEAN),
+      "index_valid", true);
+  index_valid_column.SetNotNull();
 
   std::unique_ptr<catalog::Schema> index_schema(new catalog::Schema(
       {index_id_column, index_name_column, table_id_column, schema_name_column,
        index_type_column, index_constraint_column, unique_keys,
-       indexed_attributes_column}));
+       indexed_attributes_column, index_valid_column}));
 
   index_schema->AddConstraint(std::make_shared<catalog::Constraint>(
       INDEX_CATALOG_CON_PKEY_OID, ConstraintType::PRIMARY, "con_primary",
@@ -148,7 +154,8 @@ bool IndexCatalog::InsertIndex(concurrency::TransactionContext *txn,
                                IndexConstraintType index_constraint,
                                bool unique_keys,
                                std::vector<oid_t> index_keys,
-                               type::AbstractPool *pool) {
+                               type::AbstractPool *pool,
+                               bool index_valid) {
   // Create the tuple first
   std::unique_ptr<storage::Tuple> tuple(
       new storage::Tuple(catalog_table_->GetSchema(), true));
@@ -165,6 +172,7 @@ bool IndexCatalog::InsertIndex(concurrency::TransactionContext *txn,
   std::stringstream os;
   for (oid_t indkey : index_keys) os << std::to_string(indkey) << " ";
   auto val7 = type::ValueFactory::GetVarcharValue(os.str(), nullptr);
+  auto val8 = type::ValueFactory::GetBooleanValue(index_valid);
 
   tuple->SetValue(IndexCatalog::ColumnId::INDEX_OID, val0, pool);
   tuple->SetValue(IndexCatalog::ColumnId::INDEX_NAME, val1, pool);
@@ -174,6 +182,7 @@ bool IndexCatalog::InsertIndex(concurrency::TransactionContext *txn,
   tuple->SetValue(IndexCatalog::ColumnId::INDEX_CONSTRAINT, val5, pool);
   tuple->SetValue(IndexCatalog::ColumnId::UNIQUE_KEYS, val6, pool);
   tuple->SetValue(IndexCatalog::ColumnId::INDEXED_ATTRIBUTES, val7, pool);
+  tuple->SetValue(IndexCatalog::ColumnId::INDEX_VALID, val8, pool);
 
   // Insert the tuple
   return InsertTuple(txn, std::move(tuple));
@@ -192,12 +201,55 @@ bool IndexCatalog::DeleteIndex(concurrency::TransactionContext *txn,
     auto table_object =
         txn->catalog_cache.GetCachedTableObject(database_oid,
                                                 index_object->GetTableOid());
-    table_object->EvictAllIndexCatalogEntries();
+    if (table_object) {
+      table_object->EvictAllIndexCatalogEntries();
+    }
   }
 
   return DeleteWithIndexScan(txn, index_offset, values);
 }
 
+/*@brief   mark an index as valid (usable by scans) or not
+ * @param   txn           TransactionContext
+ * @param   database_oid  the database the index belongs to
+ * @param   index_oid     oid of the index to update
+ * @param   index_valid   whether the index is complete
+ * @return  Whether update is successful
+ */
+bool IndexCatalog::UpdateIndexValid(concurrency::TransactionContext *txn,
+                                    oid_t database_oid,
+                                    oid_t index_oid,
+                                    bool index_valid) {
+  std::vector<oid_t> update_columns({ColumnId::INDEX_VALID});
+  oid_t index_offset = IndexId::PRIMARY_KEY;  // Index of index_oid
+  // values to execute index scan
+  std::vector<type::Value> scan_values;
+  scan_values.push_back(type::ValueFactory::GetIntegerValue(index_oid).Copy());
+
+  // values to update
+  std::vector<type::Value> update_values;
+  update_values.push_back(
+      type::ValueFactory::GetBooleanValue(index_valid).Copy());
+
+  // delete the cached index objects of the table
+  auto index_object = txn->catalog_cache.GetCachedIndexObject(database_oid,
+                                                              index_oid);
+  if (index_object) {
+    auto table_object =
+        txn->catalog_cache.GetCachedTableObject(database_oid,
+                                                index_object->GetTableOid());
+    if (table_object) {
+      table_object->EvictAllIndexCatalogEntries();
+    }
+  }
+
+  return UpdateWithIndexScan(txn,
+                             index_offset,
+                             scan_values,
+                             update_columns,
+                             update_values);
+}
+
 std::shared_ptr<IndexCatalogEntry> IndexCatalog::GetIndexCatalogEntry(
     concurrency::TransactionContext *txn,
     oid_t database_oid,
@@ -29,7 +29,9 @@ IndexMetricsCatalog::IndexMetricsCatalog(concurrency::TransactionContext *txn,
     "reads          INT NOT NULL, "
     "deletes        INT NOT NULL, "
     "inserts        INT NOT NULL, "
-    "time_stamp     INT NOT NULL);") {
+    "time_stamp     INT NOT NULL, "
+    "memory_bytes   BIGINT NOT NULL, "
+    "garbage_bytes  BIGINT NOT NULL);") {
   // Add secondary index here if necessary
 }
 
@@ -42,6 +44,8 @@ bool IndexMetricsCatalog::InsertIndexMetrics(concurrency::TransactionContext *tx
                                              int64_t deletes,
                                              int64_t inserts,
                                              int64_t time_stamp,
+                                             int64_t memory_bytes,
+                                             int64_t garbage_bytes,
                                              type::AbstractPool *pool) {
   std::unique_ptr<storage::Tuple> tuple(
       new storage::Tuple(catalog_table_->GetSchema(), true));
@@ -52,6 +56,8 @@ bool IndexMetricsCatalog::InsertIndexMetrics(concurrency::TransactionContext *tx
   auto val4 = type::ValueFactory::GetIntegerValue(deletes);
   auto val5 = type::ValueFactory::GetIntegerValue(inserts);
   auto val6 = type::ValueFactory::GetIntegerValue(time_stamp);
+  auto val7 = type::ValueFactory::GetBigIntValue(memory_bytes);
+  auto val8 = type::ValueFactory::GetBigIntValue(garbage_bytes);
 
   tuple->SetValue(ColumnId::TABLE_OID, val1, pool);
   tuple->SetValue(ColumnId::INDEX_OID, val2, pool);
@@ -59,6 +65,8 @@ bool IndexMetricsCatalog::InsertIndexMetrics(concurrency::TransactionContext *tx
   tuple->SetValue(ColumnId::DELETES, val4, pool);
   tuple->SetValue(ColumnId::INSERTS, val5, pool);
   tuple->SetValue(ColumnId::TIME_STAMP, val6, pool);
+  tuple->SetValue(ColumnId::MEMORY_BYTES, val7, pool);
+  tuple->SetValue(ColumnId::GARBAGE_BYTES, val8, pool);
 
   // Insert the tuple
   return InsertTuple(txn, std::move(tuple));
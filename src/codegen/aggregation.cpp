@@ -572,6 +572,95 @@ void Aggregation::AdvanceValues(CodeGen &codegen, llvm::Value *space,
   AdvanceValues(codegen, space, next, empty);
 }
 
+// Copy each component of the partial aggregates into the provided storage
+// space, including their NULL indicators
+void Aggregation::CopyPartialValues(CodeGen &codegen, llvm::Value *space,
+                                    llvm::Value *partial_space) const {
+  UpdateableStorage::NullBitmap null_bitmap{codegen, storage_, space};
+  UpdateableStorage::NullBitmap partial_null_bitmap{codegen, storage_,
+                                                    partial_space};
+  null_bitmap.InitAllNull(codegen);
+
+  for (uint32_t i = 0; i < storage_.GetNumElements(); i++) {
+    codegen::Value partial =
+        storage_.GetValue(codegen, partial_space, i, partial_null_bitmap);
+    storage_.SetValue(codegen, space, i, partial, null_bitmap);
+  }
+
+  // Write the final contents of the null bitmap
+  null_bitmap.WriteBack(codegen);
+}
+
+// Merge the partial aggregates into the provided storage space. The components
+// of partial SUM, MIN and MAX aggregates are merged using the aggregate itself,
+// while partial COUNTs (including the COUNT component of AVG) are summed up.
+void Aggregation::MergePartialValues(CodeGen &codegen, llvm::Value *space,
+                                     llvm::Value *partial_space) const {
+  UpdateableStorage::NullBitmap null_bitmap{codegen, storage_, space};
+  UpdateableStorage::NullBitmap partial_null_bitmap{codegen, storage_,
+                                                    partial_space};
+
+  // Merge a single component, performing the NULL check only if needed
+  auto merge_component = [&](ExpressionType type, uint32_t storage_index) {
+    codegen::Value partial = storage_.GetValue(codegen, partial_space,
+                                               storage_index,
+                                               partial_null_bitmap);
+    if (!null_bitmap.IsNullable(storage_index)) {
+      DoAdvanceValue(codegen, space, type, storage_index, partial);
+    } else {
+      DoNullCheck(codegen, space, type, storage_index, partial, null_bitmap);
+    }
+  };
+
+  for (const auto &agg_info : aggregate_infos_) {
+    PELOTON_ASSERT(!agg_info.is_distinct);
+    switch (agg_info.aggregate_type) {
+      case ExpressionType::AGGREGATE_SUM:
+      case ExpressionType::AGGREGATE_MIN:
+      case ExpressionType::AGGREGATE_MAX: {
+        merge_component(agg_info.aggregate_type, agg_info.storage_indices[0]);
+        break;
+      }
+      case ExpressionType::AGGREGATE_COUNT:
+      case ExpressionType::AGGREGATE_COUNT_STAR: {
+        merge_component(ExpressionType::AGGREGATE_SUM,
+                        agg_info.storage_indices[0]);
+        break;
+      }
+      case ExpressionType::AGGREGATE_AVG: {
+        merge_component(ExpressionType::AGGREGATE_SUM,
+                        agg_info.storage_indices[0]);
+        merge_component(ExpressionType::AGGREGATE_SUM,
+                        agg_info.storage_indices[1]);
+        break;
+      }
+      default: {
+        std::string message = StringUtil::Format(
+            "Unexpected aggregate type [%s] when merging aggregates",
+            ExpressionTypeToString(agg_info.aggregate_type).c_str());
+        LOG_ERROR("%s", message.c_str());
+        throw Exception{ExceptionType::UNKNOWN_TYPE, message};
+      }
+    }
+  }
+
+  // Write the final contents of the null bitmap
+  null_bitmap.WriteBack(codegen);
+}
+
+bool Aggregation::SupportsPartialAggregation(
+    const std::vector<planner::AggregatePlan::AggTerm> &agg_terms) {
+  for (const auto &agg_term : agg_terms) {
+    // DISTINCT is ignored for MIN/MAX, see Setup()
+    if (agg_term.distinct &&
+        agg_term.aggtype != ExpressionType::AGGREGATE_MIN &&
+        agg_term.aggtype != ExpressionType::AGGREGATE_MAX) {
+      return false;
+    }
+  }
+  return true;
+}
+
 // This function will compute the final values of all aggregates stored in the
 // provided storage space, populating the provided vector with these values.
 void Aggregation::FinalizeValues(
@@ -12,6 +12,8 @@
 
 #include "codegen/hash_table.h"
 
+#include <llvm/IR/Intrinsics.h>
+
 #include "codegen/proxy/hash_table_proxy.h"
 #include "codegen/hash.h"
 #include "codegen/lang/if.h"
@@ -178,6 +180,64 @@ void HashTable::MergeLazyUnfinished(CodeGen &codegen, llvm::Value *global_ht,
   codegen.Call(HashTableProxy::MergeLazyUnfinished, {global_ht, local_ht});
 }
 
+void HashTable::BuildPartitioned(CodeGen &codegen, llvm::Value *ht_ptr) const {
+  codegen.Call(HashTableProxy::BuildPartitioned, {ht_ptr});
+}
+
+void HashTable::BuildPartitionedParallel(CodeGen &codegen, llvm::Value *ht_ptr,
+                                         llvm::Value *thread_states,
+                                         uint32_t ht_state_offset) const {
+  codegen.Call(HashTableProxy::BuildPartitionedParallel,
+               {ht_ptr, thread_states, codegen.Const32(ht_state_offset)});
+}
+
+void HashTable::PartitionLazy(CodeGen &codegen, llvm::Value *ht_ptr,
+                              llvm::Value *build_ht_ptr) const {
+  codegen.Call(HashTableProxy::PartitionLazy, {ht_ptr, build_ht_ptr});
+}
+
+void HashTable::PartitionLazyParallel(CodeGen &codegen, llvm::Value *ht_ptr,
+                                      llvm::Value *thread_states,
+                                      uint32_t ht_state_offset,
+                                      llvm::Value *build_ht_ptr) const {
+  codegen.Call(HashTableProxy::PartitionLazyParallel,
+               {ht_ptr, thread_states, codegen.Const32(ht_state_offset),
+                build_ht_ptr});
+}
+
+llvm::Value *HashTable::NumPartitions(CodeGen &codegen,
+                                      llvm::Value *ht_ptr) const {
+  return codegen.Load(HashTableProxy::num_partitions, ht_ptr);
+}
+
+void HashTable::IteratePartition(CodeGen &codegen, llvm::Value *ht_ptr,
+                                 llvm::Value *partition_idx,
+                                 PartitionIterateCallback &callback) const {
+  llvm::Value *partitions = codegen.Load(HashTableProxy::partitions, ht_ptr);
+  llvm::Value *head =
+      codegen->CreateLoad(codegen->CreateGEP(partitions, partition_idx));
+
+  llvm::Type *entry_type = EntryProxy::GetType(codegen);
+  llvm::Value *null = codegen.NullPtr(entry_type->getPointerTo());
+
+  lang::Loop chain_loop(codegen, codegen->CreateICmpNE(head, null),
+                        {{"entry", head}});
+  {
+    llvm::Value *entry = chain_loop.GetLoopVar(0);
+    llvm::Value *entry_hash = codegen.Load(EntryProxy::hash, entry);
+    llvm::Value *entry_data =
+        codegen->CreateConstInBoundsGEP2_32(entry_type, entry, 1, 0);
+
+    // Pull out keys and invoke callback
+    std::vector<codegen::Value> keys;
+    auto *data_area_ptr = key_storage_.LoadValues(codegen, entry_data, keys);
+    callback.ProcessEntry(codegen, entry_hash, keys, data_area_ptr);
+
+    entry = codegen.Load(EntryProxy::next, entry);
+    chain_loop.LoopEnd(codegen->CreateICmpNE(entry, null), {entry});
+  }
+}
+
 void HashTable::Iterate(CodeGen &codegen, llvm::Value *ht_ptr,
                         IterateCallback &callback) const {
   llvm::Value *buckets_ptr = codegen.Load(HashTableProxy::directory, ht_ptr);
@@ -218,9 +278,13 @@ void HashTable::Iterate(CodeGen &codegen, llvm::Value *ht_ptr,
 }
 
 void HashTable::FindAll(CodeGen &codegen, llvm::Value *ht_ptr,
+                        llvm::Value *hash,
                         const std::vector<codegen::Value> &key,
                         IterateCallback &callback) const {
-  llvm::Value *hash = Hash::HashValues(codegen, key);
+  // Compute the hash value, if it wasn't provided
+  if (hash == nullptr) {
+    hash = Hash::HashValues(codegen, key);
+  }
 
   llvm::Value *mask = codegen.Load(HashTableProxy::mask, ht_ptr);
   llvm::Value *bucket_idx = codegen->CreateAnd(hash, mask);
@@ -260,6 +324,84 @@ void HashTable::FindAll(CodeGen &codegen, llvm::Value *ht_ptr,
   }
 }
 
+void HashTable::FindAllPartitioned(CodeGen &codegen, llvm::Value *ht_ptr,
+                                   llvm::Value *hash,
+                                   const std::vector<codegen::Value> &key,
+                                   IterateCallback &callback) const {
+  // A partitioned table's directory is indexed by the high bits of the hash
+  llvm::Value *shift = codegen.Load(HashTableProxy::shift, ht_ptr);
+  llvm::Value *bucket_idx = codegen->CreateLShr(hash, shift);
+  llvm::Value *directory = codegen.Load(HashTableProxy::directory, ht_ptr);
+  llvm::Value *bucket =
+      codegen->CreateLoad(codegen->CreateInBoundsGEP(directory, {bucket_idx}));
+
+  llvm::Type *entry_type = EntryProxy::GetType(codegen);
+  llvm::Value *null = codegen.NullPtr(entry_type->getPointerTo());
+
+  // Loop chain
+  llvm::Value *end_condition = codegen->CreateICmpNE(bucket, null);
+  lang::Loop chain_loop(codegen, end_condition, {{"iter", bucket}});
+  {
+    llvm::Value *entry = chain_loop.GetLoopVar(0);
+
+    llvm::Value *entry_hash = codegen.Load(EntryProxy::hash, entry);
+    lang::If hash_match(codegen, codegen->CreateICmpEQ(entry_hash, hash),
+                        "hashMatch");
+    {
+      llvm::Value *iter_keys =
+          codegen->CreateConstInBoundsGEP1_32(entry_type, entry, 1);
+      std::vector<codegen::Value> entry_keys;
+      llvm::Value *data_area =
+          key_storage_.LoadValues(codegen, iter_keys, entry_keys);
+
+      auto keys_are_equal = Value::TestEquality(codegen, key, entry_keys);
+      lang::If key_match(codegen, keys_are_equal.GetValue(), "keyMatch");
+      {
+        callback.ProcessEntry(codegen, key, data_area);
+        key_match.EndIf();
+      }
+      hash_match.EndIf();
+    }
+    entry = codegen.Load(EntryProxy::next, entry);
+    chain_loop.LoopEnd(codegen->CreateICmpNE(entry, null), {entry});
+  }
+}
+
+void HashTable::Prefetch(CodeGen &codegen, llvm::Value *addr) {
+  // LLVM's prefetch intrinsic signature is:
+  //
+  //   void prefetch(i8* addr, i32 rw, i32 locality, i32 cache-type)
+  //
+  // We prefetch for a read (0), with high temporal locality (3), from the
+  // data cache (1).
+  llvm::Function *prefetch_func = llvm::Intrinsic::getDeclaration(
+      &codegen.GetModule(), llvm::Intrinsic::prefetch);
+  llvm::Value *ptr = codegen->CreateBitCast(addr, codegen.CharPtrType());
+  codegen.CallFunc(prefetch_func, {ptr, codegen.Const32(0), codegen.Const32(3),
+                                   codegen.Const32(1)});
+}
+
+void HashTable::PrefetchDirectorySlot(CodeGen &codegen, llvm::Value *ht_ptr,
+                                      llvm::Value *hash) const {
+  llvm::Value *mask = codegen.Load(HashTableProxy::mask, ht_ptr);
+  llvm::Value *bucket_idx = codegen->CreateAnd(hash, mask);
+  llvm::Value *directory = codegen.Load(HashTableProxy::directory, ht_ptr);
+  llvm::Value *slot = codegen->CreateInBoundsGEP(directory, {bucket_idx});
+  Prefetch(codegen, slot);
+}
+
+void HashTable::PrefetchBucketHead(CodeGen &codegen, llvm::Value *ht_ptr,
+                                   llvm::Value *hash) const {
+  // Prefetching an invalid (i.e., null) address is harmless, so we needn't
+  // check if the bucket is empty
+  llvm::Value *mask = codegen.Load(HashTableProxy::mask, ht_ptr);
+  llvm::Value *bucket_idx = codegen->CreateAnd(hash, mask);
+  llvm::Value *directory = codegen.Load(HashTableProxy::directory, ht_ptr);
+  llvm::Value *bucket =
+      codegen->CreateLoad(codegen->CreateInBoundsGEP(directory, {bucket_idx}));
+  Prefetch(codegen, bucket);
+}
+
 void HashTable::Destroy(CodeGen &codegen, llvm::Value *ht_ptr) const {
   codegen.Call(HashTableProxy::Destroy, {ht_ptr});
 }
@@ -0,0 +1,121 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// index_scanner.cpp
+//
+// Identification: src/codegen/index_scanner.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "codegen/index_scanner.h"
+
+#include "catalog/schema.h"
+#include "codegen/transaction_runtime.h"
+#include "executor/executor_context.h"
+#include "index/index.h"
+#include "index/scan_optimizer.h"
+#include "storage/data_table.h"
+#include "storage/storage_manager.h"
+#include "storage/tile_group.h"
+#include "storage/tile_group_header.h"
+
+namespace peloton {
+namespace codegen {
+
+IndexScanner::IndexScanner(storage::DataTable *table, uint32_t index_oid,
+                           executor::ExecutorContext *executor_context)
+    : table_(table),
+      index_(table->GetIndexWithOid(index_oid)),
+      executor_context_(executor_context),
+      next_location_(0) {
+  PELOTON_ASSERT(index_ != nullptr && executor_context != nullptr);
+}
+
+void IndexScanner::Init(IndexScanner &scanner, storage::DataTable *table,
+                        uint32_t index_oid,
+                        executor::ExecutorContext *executor_context) {
+  new (&scanner) IndexScanner(table, index_oid, executor_context);
+}
+
+void IndexScanner::AddKey(uint32_t column_id, uint32_t expr_type,
+                          uint32_t parameter_idx) {
+  key_column_ids_.push_back(column_id);
+  expr_types_.push_back(static_cast<ExpressionType>(expr_type));
+  parameter_idxs_.push_back(parameter_idx);
+}
+
+void IndexScanner::Scan() {
+  locations_.clear();
+  next_location_ = 0;
+
+  std::vector<ItemPointer *> index_entries;
+  if (key_column_ids_.empty()) {
+    index_->ScanAllKeys(index_entries);
+  } else {
+    // Bind the values of this invocation to the keys
+    const auto &parameter_values =
+        executor_context_->GetParams().GetParameterValues();
+    const auto *schema = table_->GetSchema();
+    std::vector<peloton::type::Value> values;
+    for (size_t i = 0; i < key_column_ids_.size(); i++) {
+      const auto &value = parameter_values[parameter_idxs_[i]];
+      values.push_back(value.CastAs(schema->GetType(key_column_ids_[i])));
+    }
+
+    index::IndexScanPredicate index_predicate;
+    index_predicate.AddConjunctionScanPredicate(index_.get(), values,
+                                                key_column_ids_, expr_types_);
+    index_->Scan(values, key_column_ids_, expr_types_,
+                 ScanDirectionType::FORWARD, index_entries,
+                 &index_predicate.GetConjunctionList()[0]);
+  }
+
+  LOG_TRACE("Index '%s' returned %lu entries", index_->GetName().c_str(),
+            index_entries.size());
+
+  // Resolve the version of every entry that is visible to the transaction
+  auto *txn = executor_context_->GetTransaction();
+  auto *storage_manager = storage::StorageManager::GetInstance();
+  locations_.reserve(index_entries.size());
+  for (auto *index_entry : index_entries) {
+    ItemPointer location = *index_entry;
+    // Tuples in all-visible tile groups need no walk of the version chain
+    auto tile_group = storage_manager->GetTileGroup(location.block);
+    if (tile_group->GetHeader()->IsVisibleToAll(location.offset,
+                                                index_entry)) {
+      locations_.push_back(location);
+      continue;
+    }
+    if (TransactionRuntime::FindVisibleVersion(*txn, location)) {
+      locations_.push_back(location);
+    }
+  }
+}
+
+uint32_t IndexScanner::NextBatch(uint32_t *selection_vector,
+                                 uint32_t max_count) {
+  if (next_location_ >= locations_.size()) {
+    tile_group_.reset();
+    return 0;
+  }
+
+  // Collect the run of tuples that live in the same tile group
+  oid_t tile_group_id = locations_[next_location_].block;
+  uint32_t count = 0;
+  while (next_location_ < locations_.size() && count < max_count &&
+         locations_[next_location_].block == tile_group_id) {
+    selection_vector[count++] = locations_[next_location_++].offset;
+  }
+
+  tile_group_ = storage::StorageManager::GetInstance()->GetTileGroup(
+      tile_group_id);
+  return count;
+}
+
+void IndexScanner::Destroy(IndexScanner &scanner) { scanner.~IndexScanner(); }
+
+}  // namespace codegen
+}  // namespace peloton
@@ -12,7 +12,6 @@
 
 #include "codegen/inserter.h"
 #include "codegen/transaction_runtime.h"
-#include "common/container_tuple.h"
 #include "concurrency/transaction_manager_factory.h"
 #include "executor/executor_context.h"
 #include "executor/logical_tile.h"
@@ -29,6 +28,7 @@ void Inserter::Init(storage::DataTable *table,
   PELOTON_ASSERT(table && executor_context);
   table_ = table;
   executor_context_ = executor_context;
+  num_pending_ = 0;
 }
 
 char *Inserter::AllocateTupleStorage() {
@@ -51,22 +51,38 @@ peloton::type::AbstractPool *Inserter::GetPool() {
 
 void Inserter::Insert() {
   PELOTON_ASSERT(table_ && executor_context_ && tile_);
+  pending_locations_[num_pending_++] = location_;
+  if (num_pending_ == kInsertBatchSize) {
+    InsertPending();
+  }
+}
+
+void Inserter::InsertPending() {
+  if (num_pending_ == 0) {
+    return;
+  }
   auto *txn = executor_context_->GetTransaction();
   auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
 
-  ContainerTuple<storage::TileGroup> tuple(
-      table_->GetTileGroupById(location_.block).get(), location_.offset);
-  ItemPointer *index_entry_ptr = nullptr;
-  bool result = table_->InsertTuple(&tuple, location_, txn, &index_entry_ptr);
+  std::vector<ItemPointer> locations(pending_locations_,
+                                     pending_locations_ + num_pending_);
+  num_pending_ = 0;
+
+  std::vector<ItemPointer *> index_entry_ptrs;
+  bool result = table_->InsertTuples(locations, txn, index_entry_ptrs);
   if (result == false) {
     txn_manager.SetTransactionResult(txn, ResultType::FAILURE);
     return;
   }
-  txn_manager.PerformInsert(txn, location_, index_entry_ptr);
-  executor_context_->num_processed++;
+  for (uint32_t i = 0; i < locations.size(); i++) {
+    txn_manager.PerformInsert(txn, locations[i], index_entry_ptrs[i]);
+  }
+  executor_context_->num_processed += locations.size();
 }
 
 void Inserter::TearDown() {
+  InsertPending();
+
   // Updater object does not destruct its own data structures
   tile_.reset();
 }
@@ -24,6 +24,7 @@
 #include "codegen/util/bloom_filter.h"
 #include "codegen/buffering_consumer.h"
 #include "codegen/deleter.h"
+#include "codegen/index_scanner.h"
 #include "codegen/inserter.h"
 #include "codegen/query_parameters.h"
 #include "codegen/runtime_functions.h"
@@ -472,10 +472,14 @@ OAHashTable::ProbeResult OAHashTable::TranslateProbing(
 }
 
 void OAHashTable::Init(CodeGen &codegen, llvm::Value *ht_ptr) const {
+  Init(codegen, ht_ptr, codegen::util::OAHashTable::kDefaultInitialSize);
+}
+
+void OAHashTable::Init(CodeGen &codegen, llvm::Value *ht_ptr,
+                       uint64_t estimated_num_entries) const {
   auto *key_size = codegen.Const64(key_storage_.MaxStorageSize());
   auto *value_size = codegen.Const64(value_size_);
-  auto *initial_size =
-      codegen.Const64(codegen::util::OAHashTable::kDefaultInitialSize);
+  auto *initial_size = codegen.Const64(estimated_num_entries);
   codegen.Call(OAHashTableProxy::Init,
                {ht_ptr, key_size, value_size, initial_size});
 }
@@ -683,6 +687,7 @@ void OAHashTable::VectorizedIterate(
 }
 
 void OAHashTable::FindAll(CodeGen &codegen, llvm::Value *ht_ptr,
+                          llvm::Value *hash,
                           const std::vector<codegen::Value> &key,
                           IterateCallback &callback) const {
   auto key_found = [&codegen, &callback, &key](llvm::Value *data_ptr) {
@@ -692,7 +697,7 @@ void OAHashTable::FindAll(CodeGen &codegen, llvm::Value *ht_ptr,
   // It does not do anything for a key that is not found
   auto key_not_found = [](llvm::Value *data_ptr) { (void)data_ptr; };
 
-  TranslateProbing(codegen, ht_ptr, nullptr, key, key_found, key_not_found,
+  TranslateProbing(codegen, ht_ptr, hash, key, key_found, key_not_found,
                    true, false,
                    false,  // If key is missing create it in empty slot
                    false);
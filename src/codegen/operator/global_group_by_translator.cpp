@@ -23,7 +23,10 @@ GlobalGroupByTranslator::GlobalGroupByTranslator(
     const planner::AggregatePlan &plan, CompilationContext &context,
     Pipeline &pipeline)
     : OperatorTranslator(plan, context, pipeline),
-      child_pipeline_(this, Pipeline::Parallelism::Serial),
+      child_pipeline_(this, Aggregation::SupportsPartialAggregation(
+                                plan.GetUniqueAggTerms())
+                                ? Pipeline::Parallelism::Flexible
+                                : Pipeline::Parallelism::Serial),
       aggregation_(context.GetQueryState()) {
   LOG_DEBUG("Constructing GlobalGroupByTranslator ...");
 
@@ -47,14 +50,14 @@ GlobalGroupByTranslator::GlobalGroupByTranslator(
   auto *aggregate_storage = aggregation_.GetAggregateStorage().GetStorageType();
   PELOTON_ASSERT(aggregate_storage->isStructTy());
 
-  auto *mat_buffer_type = llvm::StructType::create(
+  mat_buffer_type_ = llvm::StructType::create(
       codegen.GetContext(),
       llvm::cast<llvm::StructType>(aggregate_storage)->elements(), "Buffer",
       true);
 
   // Allocate state in the function argument for our materialization buffer
   QueryState &query_state = context.GetQueryState();
-  mat_buffer_id_ = query_state.RegisterState("buf", mat_buffer_type);
+  mat_buffer_id_ = query_state.RegisterState("buf", mat_buffer_type_);
 
   LOG_DEBUG("Finished constructing GlobalGroupByTranslator ...");
 }
@@ -109,7 +112,7 @@ void GlobalGroupByTranslator::Produce() const {
   GetPipeline().RunSerial(producer);
 }
 
-void GlobalGroupByTranslator::Consume(ConsumerContext &,
+void GlobalGroupByTranslator::Consume(ConsumerContext &context,
                                       RowBatch::Row &row) const {
   // Get the updates to advance the aggregates
   const auto &plan = GetPlanAs<planner::AggregatePlan>();
@@ -124,8 +127,57 @@ void GlobalGroupByTranslator::Consume(ConsumerContext &,
   }
 
   // Just advance each of the aggregates in the buffer with the provided
-  // new values
-  aggregation_.AdvanceValues(GetCodeGen(), LoadStatePtr(mat_buffer_id_), vals);
+  // new values. When consuming in parallel, each thread aggregates into its
+  // own buffer.
+  llvm::Value *mat_buffer = nullptr;
+  if (context.GetPipeline().IsParallel()) {
+    mat_buffer = context.GetPipelineContext()->LoadStatePtr(
+        GetCodeGen(), local_mat_buffer_id_);
+  } else {
+    mat_buffer = LoadStatePtr(mat_buffer_id_);
+  }
+  aggregation_.AdvanceValues(GetCodeGen(), mat_buffer, vals);
+}
+
+void GlobalGroupByTranslator::RegisterPipelineState(
+    PipelineContext &pipeline_ctx) {
+  if (IsParallelChildPipeline(pipeline_ctx)) {
+    local_mat_buffer_id_ =
+        pipeline_ctx.RegisterState("localBuf", mat_buffer_type_);
+  }
+}
+
+void GlobalGroupByTranslator::InitializePipelineState(
+    PipelineContext &pipeline_ctx) {
+  if (IsParallelChildPipeline(pipeline_ctx)) {
+    CodeGen &codegen = GetCodeGen();
+    aggregation_.CreateInitialGlobalValues(
+        codegen, pipeline_ctx.LoadStatePtr(codegen, local_mat_buffer_id_));
+  }
+}
+
+void GlobalGroupByTranslator::FinishPipeline(PipelineContext &pipeline_ctx) {
+  if (!IsParallelChildPipeline(pipeline_ctx)) {
+    return;
+  }
+
+  // Merge the partial aggregates of each thread into the global buffer. There
+  // is only a single group, so this is cheap enough to do serially.
+  CodeGen &codegen = GetCodeGen();
+  PipelineContext::LoopOverStates loop_states{pipeline_ctx};
+  loop_states.Do([this, &codegen, &pipeline_ctx](llvm::Value *thread_state) {
+    PipelineContext::SetState state_access(pipeline_ctx, thread_state);
+    llvm::Value *local_mat_buffer =
+        pipeline_ctx.LoadStatePtr(codegen, local_mat_buffer_id_);
+    aggregation_.MergePartialValues(codegen, LoadStatePtr(mat_buffer_id_),
+                                    local_mat_buffer);
+  });
+}
+
+bool GlobalGroupByTranslator::IsParallelChildPipeline(
+    PipelineContext &pipeline_ctx) const {
+  return pipeline_ctx.IsParallel() &&
+         pipeline_ctx.GetPipeline() == child_pipeline_;
 }
 
 // Cleanup by destroying the aggregation hash-table
@@ -13,16 +13,22 @@
 #include "codegen/operator/hash_group_by_translator.h"
 
 #include "codegen/compilation_context.h"
+#include "codegen/function_builder.h"
 #include "codegen/lang/if.h"
+#include "codegen/lang/loop.h"
 #include "codegen/proxy/oa_hash_table_proxy.h"
+#include "codegen/proxy/runtime_functions_proxy.h"
 #include "codegen/operator/projection_translator.h"
 #include "codegen/lang/vectorized_loop.h"
 #include "codegen/type/integer_type.h"
+#include "codegen/util/oa_hash_table.h"
+#include "settings/settings_manager.h"
 
 namespace peloton {
 namespace codegen {
 
-std::atomic<bool> HashGroupByTranslator::kUsePrefetch{false};
+constexpr uint32_t HashGroupByTranslator::kNumPartitionBits;
+constexpr uint32_t HashGroupByTranslator::kNumPartitions;
 
 //===----------------------------------------------------------------------===//
 // HASH GROUP BY TRANSLATOR
@@ -33,7 +39,10 @@ HashGroupByTranslator::HashGroupByTranslator(
     const planner::AggregatePlan &group_by, CompilationContext &context,
     Pipeline &pipeline)
     : OperatorTranslator(group_by, context, pipeline),
-      child_pipeline_(this, Pipeline::Parallelism::Serial),
+      child_pipeline_(this, Aggregation::SupportsPartialAggregation(
+                                group_by.GetUniqueAggTerms())
+                                ? Pipeline::Parallelism::Flexible
+                                : Pipeline::Parallelism::Serial),
       aggregation_(context.GetQueryState()) {
   // If we should be prefetching into the hash-table, install a boundary in the
   // pipeline at the input into this translator to ensure it receives a vector
@@ -42,15 +51,20 @@ HashGroupByTranslator::HashGroupByTranslator(
     child_pipeline_.InstallStageBoundary(this);
   }
 
-  // Register the hash-table instance in the runtime state
-  CodeGen &codegen = GetCodeGen();
-  QueryState &query_state = context.GetQueryState();
-  hash_table_id_ =
-      query_state.RegisterState("groupBy", OAHashTableProxy::GetType(codegen));
-
   // Prepare the input operator to this group by
   context.Prepare(*group_by.GetChild(0), child_pipeline_);
 
+  // Register the hash-table instance in the runtime state. If the input is
+  // consumed in parallel, each thread pre-aggregates into its own partitioned
+  // hash-tables which are merged partition-wise into an array of global ones.
+  CodeGen &codegen = GetCodeGen();
+  QueryState &query_state = context.GetQueryState();
+  llvm::Type *hash_table_type = OAHashTableProxy::GetType(codegen);
+  if (IsParallel()) {
+    hash_table_type = llvm::ArrayType::get(hash_table_type, kNumPartitions);
+  }
+  hash_table_id_ = query_state.RegisterState("groupBy", hash_table_type);
+
   // Prepare the predicate if one exists
   if (group_by.GetPredicate() != nullptr) {
     context.Prepare(*group_by.GetPredicate());
@@ -89,8 +103,18 @@ HashGroupByTranslator::HashGroupByTranslator(
 
 // Initialize the hash table instance
 void HashGroupByTranslator::InitializeQueryState() {
-  hash_table_.Init(GetCodeGen(), LoadStatePtr(hash_table_id_));
-  aggregation_.InitializeQueryState(GetCodeGen());
+  CodeGen &codegen = GetCodeGen();
+  if (IsParallel()) {
+    uint64_t partition_size =
+        util::OAHashTable::kDefaultInitialSize / kNumPartitions;
+    ForEachPartition(codegen, LoadStatePtr(hash_table_id_),
+                     [this, &codegen, partition_size](llvm::Value *ht_ptr) {
+                       hash_table_.Init(codegen, ht_ptr, partition_size);
+                     });
+  } else {
+    hash_table_.Init(codegen, LoadStatePtr(hash_table_id_));
+  }
+  aggregation_.InitializeQueryState(codegen);
 }
 
 // Produce!
@@ -111,8 +135,17 @@ void HashGroupByTranslator::Produce() const {
     // Iterate
     const auto &plan = GetPlanAs<planner::AggregatePlan>();
     ProduceResults produce_results{ctx, plan, aggregation_};
-    hash_table_.VectorizedIterate(codegen, LoadStatePtr(hash_table_id_),
-                                  selection_vec, produce_results);
+    if (IsParallel()) {
+      // Each group lives in exactly one partition
+      ForEachPartition(codegen, LoadStatePtr(hash_table_id_),
+                       [&](llvm::Value *ht_ptr) {
+                         hash_table_.VectorizedIterate(
+                             codegen, ht_ptr, selection_vec, produce_results);
+                       });
+    } else {
+      hash_table_.VectorizedIterate(codegen, LoadStatePtr(hash_table_id_),
+                                    selection_vec, produce_results);
+    }
   };
 
   GetPipeline().RunSerial(producer);
@@ -160,7 +193,7 @@ void HashGroupByTranslator::Consume(ConsumerContext &context,
       hashes.SetValue(codegen, p, hash_val);
 
       // Prefetch the actual hash table bucket
-      hash_table_.PrefetchBucket(codegen, LoadStatePtr(hash_table_id_),
+      hash_table_.PrefetchBucket(codegen, LoadHashTablePtr(context, hash_val),
                                  hash_val, OAHashTable::PrefetchType::Read,
                                  OAHashTable::Locality::Medium);
 
@@ -205,7 +238,7 @@ void HashGroupByTranslator::Consume(ConsumerContext &context,
 }
 
 // Consume the tuples from the context, grouping them into the hash table
-void HashGroupByTranslator::Consume(ConsumerContext &,
+void HashGroupByTranslator::Consume(ConsumerContext &context,
                                     RowBatch::Row &row) const {
   CodeGen &codegen = GetCodeGen();
 
@@ -223,24 +256,121 @@ void HashGroupByTranslator::Consume(ConsumerContext &,
     }
   }
 
-  // If the hash value is available, use it
+  // If the hash value is available, use it. When aggregating in parallel, we
+  // need the hash value up front to find the partition the group belongs to.
   llvm::Value *hash = nullptr;
   if (row.HasAttribute(&OAHashTable::kHashAI)) {
     codegen::Value hash_val = row.DeriveValue(codegen, &OAHashTable::kHashAI);
     hash = hash_val.GetValue();
+  } else if (IsParallel()) {
+    hash = hash_table_.HashKey(codegen, key);
   }
 
   // Perform the insertion into the hash table
-  llvm::Value *hash_table = LoadStatePtr(hash_table_id_);
+  llvm::Value *hash_table = LoadHashTablePtr(context, hash);
   ConsumerProbe probe{GetCompilationContext(), aggregation_, vals, key};
   ConsumerInsert insert{aggregation_, vals, key};
   hash_table_.ProbeOrInsert(codegen, hash_table, hash, key, probe, insert);
 }
 
+void HashGroupByTranslator::RegisterPipelineState(
+    PipelineContext &pipeline_ctx) {
+  if (IsParallelChildPipeline(pipeline_ctx)) {
+    CodeGen &codegen = GetCodeGen();
+    auto *local_ht_type =
+        llvm::ArrayType::get(OAHashTableProxy::GetType(codegen), kNumPartitions);
+    local_hash_table_id_ =
+        pipeline_ctx.RegisterState("localGroupBy", local_ht_type);
+  }
+}
+
+void HashGroupByTranslator::InitializePipelineState(
+    PipelineContext &pipeline_ctx) {
+  if (IsParallelChildPipeline(pipeline_ctx)) {
+    CodeGen &codegen = GetCodeGen();
+    uint64_t partition_size =
+        util::OAHashTable::kDefaultInitialSize / kNumPartitions;
+    ForEachPartition(codegen,
+                     pipeline_ctx.LoadStatePtr(codegen, local_hash_table_id_),
+                     [this, &codegen, partition_size](llvm::Value *ht_ptr) {
+                       hash_table_.Init(codegen, ht_ptr, partition_size);
+                     });
+  }
+}
+
+void HashGroupByTranslator::FinishPipeline(PipelineContext &pipeline_ctx) {
+  if (!IsParallelChildPipeline(pipeline_ctx)) {
+    return;
+  }
+
+  CodeGen &codegen = GetCodeGen();
+  CodeContext &cc = codegen.GetCodeContext();
+  QueryState &query_state = GetCompilationContext().GetQueryState();
+
+  // Generate a function that merges one partition of every thread-local
+  // hash-table into the same partition of the global hash-table. Partitions
+  // are disjoint, so all partitions can be merged in parallel without any
+  // synchronization.
+  auto name = StringUtil::Format("_%" PRId64 "_pipeline_%u_mergeGroupBy",
+                                 cc.GetID(), pipeline_ctx.GetPipeline().GetId());
+  std::vector<FunctionDeclaration::ArgumentInfo> args = {
+      {"queryState", query_state.GetType()->getPointerTo()},
+      {"partition", codegen.Int32Type()}};
+  FunctionDeclaration decl(cc, name, FunctionDeclaration::Visibility::Internal,
+                           codegen.VoidType(), args);
+  FunctionBuilder merge_func(cc, decl);
+  {
+    llvm::Value *partition = merge_func.GetArgumentByPosition(1);
+    llvm::Value *global_ht_ptr =
+        GetPartitionPtr(codegen, LoadStatePtr(hash_table_id_), partition);
+
+    PipelineContext::LoopOverStates loop_states{pipeline_ctx};
+    loop_states.Do([&](llvm::Value *thread_state) {
+      PipelineContext::SetState state_access(pipeline_ctx, thread_state);
+      llvm::Value *local_ht_ptr = GetPartitionPtr(
+          codegen, pipeline_ctx.LoadStatePtr(codegen, local_hash_table_id_),
+          partition);
+      MergePartials merge_partials{hash_table_, aggregation_, global_ht_ptr};
+      hash_table_.Iterate(codegen, local_ht_ptr, merge_partials);
+    });
+
+    merge_func.ReturnAndFinish();
+  }
+
+  // Merge all partitions in parallel
+  std::vector<llvm::Value *> dispatch_args = {
+      codegen->CreatePointerCast(codegen.GetState(), codegen.VoidPtrType()),
+      codegen.Const32(kNumPartitions),
+      codegen->CreatePointerCast(
+          merge_func.GetFunction(),
+          proxy::TypeBuilder<void (*)(void *, uint32_t)>::GetType(codegen))};
+  codegen.Call(RuntimeFunctionsProxy::ExecutePerPartition, dispatch_args);
+}
+
+void HashGroupByTranslator::TearDownPipelineState(
+    PipelineContext &pipeline_ctx) {
+  if (IsParallelChildPipeline(pipeline_ctx)) {
+    CodeGen &codegen = GetCodeGen();
+    ForEachPartition(codegen,
+                     pipeline_ctx.LoadStatePtr(codegen, local_hash_table_id_),
+                     [this, &codegen](llvm::Value *ht_ptr) {
+                       hash_table_.Destroy(codegen, ht_ptr);
+                     });
+  }
+}
+
 // Cleanup by destroying the aggregation hash-table
 void HashGroupByTranslator::TearDownQueryState() {
-  hash_table_.Destroy(GetCodeGen(), LoadStatePtr(hash_table_id_));
-  aggregation_.TearDownQueryState(GetCodeGen());
+  CodeGen &codegen = GetCodeGen();
+  if (IsParallel()) {
+    ForEachPartition(codegen, LoadStatePtr(hash_table_id_),
+                     [this, &codegen](llvm::Value *ht_ptr) {
+                       hash_table_.Destroy(codegen, ht_ptr);
+                     });
+  } else {
+    hash_table_.Destroy(codegen, LoadStatePtr(hash_table_id_));
+  }
+  aggregation_.TearDownQueryState(codegen);
 }
 
 // Estimate the size of the dynamically constructed hash-table
@@ -251,8 +381,8 @@ uint64_t HashGroupByTranslator::EstimateHashTableSize() const {
 
 // Should this aggregation use prefetching
 bool HashGroupByTranslator::UsePrefetching() const {
-  // TODO: Implement me
-  return kUsePrefetch;
+  return settings::SettingsManager::GetBool(
+      settings::SettingId::codegen_hash_group_by_prefetch);
 }
 
 void HashGroupByTranslator::CollectHashKeys(
@@ -264,6 +394,55 @@ void HashGroupByTranslator::CollectHashKeys(
   }
 }
 
+bool HashGroupByTranslator::IsParallelChildPipeline(
+    PipelineContext &pipeline_ctx) const {
+  return pipeline_ctx.IsParallel() &&
+         pipeline_ctx.GetPipeline() == child_pipeline_;
+}
+
+llvm::Value *HashGroupByTranslator::LoadHashTablePtr(ConsumerContext &context,
+                                                     llvm::Value *hash) const {
+  if (!IsParallel()) {
+    return LoadStatePtr(hash_table_id_);
+  }
+
+  // The partition is taken from the high bits of the hash value since the
+  // hash-table itself uses the low bits to find a bucket
+  PELOTON_ASSERT(hash != nullptr);
+  CodeGen &codegen = GetCodeGen();
+  llvm::Value *partition = codegen->CreateTrunc(
+      codegen->CreateLShr(hash, codegen.Const64(64 - kNumPartitionBits)),
+      codegen.Int32Type());
+
+  auto *pipeline_ctx = context.GetPipelineContext();
+  return GetPartitionPtr(
+      codegen, pipeline_ctx->LoadStatePtr(codegen, local_hash_table_id_),
+      partition);
+}
+
+llvm::Value *HashGroupByTranslator::GetPartitionPtr(
+    CodeGen &codegen, llvm::Value *partitions, llvm::Value *partition) const {
+  return codegen->CreateInBoundsGEP(partitions,
+                                    {codegen.Const32(0), partition});
+}
+
+void HashGroupByTranslator::ForEachPartition(
+    CodeGen &codegen, llvm::Value *partitions,
+    const std::function<void(llvm::Value *)> &body) const {
+  llvm::Value *num_partitions = codegen.Const32(kNumPartitions);
+  llvm::Value *partition = codegen.Const32(0);
+  lang::Loop partition_loop{codegen,
+                            codegen->CreateICmpULT(partition, num_partitions),
+                            {{"partition", partition}}};
+  {
+    partition = partition_loop.GetLoopVar(0);
+    body(GetPartitionPtr(codegen, partitions, partition));
+    partition = codegen->CreateAdd(partition, codegen.Const32(1));
+    partition_loop.LoopEnd(codegen->CreateICmpULT(partition, num_partitions),
+                           {partition});
+  }
+}
+
 //===----------------------------------------------------------------------===//
 // AGGREGATE FINALIZER
 //===----------------------------------------------------------------------===//
@@ -374,6 +553,65 @@ void HashGroupByTranslator::ProduceResults::ProcessEntries(
   }
 }
 
+//===----------------------------------------------------------------------===//
+// MERGE PARTIALS
+//===----------------------------------------------------------------------===//
+
+namespace {
+
+// Merges the partial aggregates of a group into an existing group
+class MergeProbe : public HashTable::ProbeCallback {
+ public:
+  MergeProbe(const Aggregation &aggregation, llvm::Value *partial_aggs)
+      : aggregation_(aggregation), partial_aggs_(partial_aggs) {}
+
+  void ProcessEntry(CodeGen &codegen, llvm::Value *data_area) const override {
+    aggregation_.MergePartialValues(codegen, data_area, partial_aggs_);
+  }
+
+ private:
+  const Aggregation &aggregation_;
+  llvm::Value *partial_aggs_;
+};
+
+// Stores the partial aggregates of a group as the initial aggregates of a
+// new group
+class MergeInsert : public HashTable::InsertCallback {
+ public:
+  MergeInsert(const Aggregation &aggregation, llvm::Value *partial_aggs)
+      : aggregation_(aggregation), partial_aggs_(partial_aggs) {}
+
+  void StoreValue(CodeGen &codegen, llvm::Value *space) const override {
+    aggregation_.CopyPartialValues(codegen, space, partial_aggs_);
+  }
+
+  llvm::Value *GetValueSize(CodeGen &codegen) const override {
+    return codegen.Const32(aggregation_.GetAggregatesStorageSize());
+  }
+
+ private:
+  const Aggregation &aggregation_;
+  llvm::Value *partial_aggs_;
+};
+
+}  // namespace
+
+HashGroupByTranslator::MergePartials::MergePartials(
+    const OAHashTable &hash_table, const Aggregation &aggregation,
+    llvm::Value *partition_ptr)
+    : hash_table_(hash_table),
+      aggregation_(aggregation),
+      partition_ptr_(partition_ptr) {}
+
+void HashGroupByTranslator::MergePartials::ProcessEntry(
+    CodeGen &codegen, const std::vector<codegen::Value> &keys,
+    llvm::Value *partial_aggs) const {
+  MergeProbe probe{aggregation_, partial_aggs};
+  MergeInsert insert{aggregation_, partial_aggs};
+  hash_table_.ProbeOrInsert(codegen, partition_ptr_, nullptr, keys, probe,
+                            insert);
+}
+
 //===----------------------------------------------------------------------===//
 // CONSUMER PROBE
 //===----------------------------------------------------------------------===//
@@ -13,18 +13,22 @@
 #include "codegen/operator/hash_join_translator.h"
 
 #include "codegen/expression/tuple_value_translator.h"
+#include "codegen/hash.h"
 #include "codegen/lang/if.h"
+#include "codegen/lang/loop.h"
 #include "codegen/lang/vectorized_loop.h"
+#include "codegen/oa_hash_table.h"
 #include "codegen/proxy/bloom_filter_proxy.h"
 #include "codegen/proxy/hash_table_proxy.h"
+#include "codegen/proxy/runtime_functions_proxy.h"
+#include "codegen/type/integer_type.h"
 #include "expression/tuple_value_expression.h"
 #include "planner/hash_join_plan.h"
+#include "settings/settings_manager.h"
 
 namespace peloton {
 namespace codegen {
 
-std::atomic<bool> HashJoinTranslator::kUsePrefetch{false};
-
 /**
  * The callback used when we probe the hash table with right-side tuples during
  * the probe phase of the join.
@@ -111,6 +115,46 @@ class HashJoinTranslator::InsertLeft : public HashTable::InsertCallback {
   const std::vector<codegen::Value> &values_;
 };
 
+/**
+ * The callback used when iterating over the materialized right-side tuples of
+ * a partition in a radix-partitioned join. Each tuple is reconstructed into a
+ * row that is used to probe the (partitioned) build table.
+ */
+class HashJoinTranslator::ProbePartition
+    : public HashTable::PartitionIterateCallback {
+ public:
+  /**
+   * Constructor.
+   *
+   * @param join_translator The translator reference
+   * @param context The context reference
+   * @param batch The single-row batch the right tuple is placed into
+   */
+  ProbePartition(const HashJoinTranslator &join_translator,
+                 ConsumerContext &context, RowBatch &batch)
+      : join_translator_(join_translator), context_(context), batch_(batch) {}
+
+  /**
+   * Probe the build table with the given right-side tuple.
+   *
+   * @param codegen The codegen instance
+   * @param hash The hash value of the right key
+   * @param key The right key stored in the probe table
+   * @param data_area Memory space where the right values are stored
+   */
+  void ProcessEntry(CodeGen &codegen, llvm::Value *hash,
+                    const std::vector<codegen::Value> &key,
+                    llvm::Value *data_area) const override;
+
+ private:
+  // The translator (we need lots of its state)
+  const HashJoinTranslator &join_translator_;
+
+  // The context and batch
+  ConsumerContext &context_;
+  RowBatch &batch_;
+};
+
 ////////////////////////////////////////////////////////////////////////////////
 ///
 /// Hash Join Translator
@@ -125,6 +169,11 @@ HashJoinTranslator::HashJoinTranslator(const planner::HashJoinPlan &join,
   CodeGen &codegen = GetCodeGen();
   QueryState &query_state = context.GetQueryState();
 
+  // Radix partitioning is only supported for inner joins without prefetching
+  radix_partitioned_ = join.IsRadixPartitioned() &&
+                       join.GetJoinType() == JoinType::INNER &&
+                       !UsePrefetching();
+
   // If we should be prefetching into the hash-table, install a boundary in the
   // both the left and right pipeline at the input into this translator to
   // ensure it receives a vector of input tuples
@@ -142,9 +191,17 @@ HashJoinTranslator::HashJoinTranslator(const planner::HashJoinPlan &join,
         "bloomfilter", BloomFilterProxy::GetType(codegen));
   }
 
-  // Prepare translators for the left and right input operators
+  // Prepare translators for the left and right input operators. In radix
+  // partitioned mode, the right side is materialized in its own pipeline and
+  // we become the source of our pipeline, producing the join results.
   context.Prepare(*join.GetChild(0), left_pipeline_);
-  context.Prepare(*join.GetChild(1)->GetChild(0), pipeline);
+  if (radix_partitioned_) {
+    pipeline.MarkSource(this, Pipeline::Parallelism::Parallel);
+    right_pipeline_.reset(new Pipeline(this, Pipeline::Parallelism::Flexible));
+    context.Prepare(*join.GetChild(1)->GetChild(0), *right_pipeline_);
+  } else {
+    context.Prepare(*join.GetChild(1)->GetChild(0), pipeline);
+  }
 
   // Prepare the expressions that produce the build-size keys
   join.GetLeftHashKeys(left_key_exprs_);
@@ -215,12 +272,46 @@ HashJoinTranslator::HashJoinTranslator(const planner::HashJoinPlan &join,
   // Create the hash table
   hash_table_ =
       HashTable{codegen, left_key_type, left_value_storage_.MaxStorageSize()};
+
+  if (radix_partitioned_) {
+    // Collect (unique) attributes that are stored in the probe table
+    std::unordered_set<const planner::AttributeInfo *> right_key_ais;
+    for (auto *right_key_exp : right_key_exprs_) {
+      if (right_key_exp->GetExpressionType() == ExpressionType::VALUE_TUPLE) {
+        auto *tve = static_cast<const expression::TupleValueExpression *>(
+            right_key_exp);
+        right_key_ais.insert(tve->GetAttributeRef());
+      }
+    }
+    for (const auto *right_val_ai : join.GetRightAttributes()) {
+      if (right_key_ais.count(right_val_ai) == 0) {
+        right_val_ais_.push_back(right_val_ai);
+      }
+    }
+
+    // Construct the format of the right side
+    std::vector<type::Type> right_value_types;
+    for (const auto *right_val_ai : right_val_ais_) {
+      right_value_types.push_back(right_val_ai->type);
+    }
+    right_value_storage_.Setup(codegen, right_value_types);
+
+    // Create the probe table
+    probe_table_id_ =
+        query_state.RegisterState("probe", HashTableProxy::GetType(codegen));
+    probe_table_ = HashTable{codegen, right_key_type,
+                             right_value_storage_.MaxStorageSize()};
+  }
 }
 
 // Initialize the hash-table instance
 void HashJoinTranslator::InitializeQueryState() {
   hash_table_.Init(GetCodeGen(), GetExecutorContextPtr(),
                    LoadStatePtr(hash_table_id_));
+  if (radix_partitioned_) {
+    probe_table_.Init(GetCodeGen(), GetExecutorContextPtr(),
+                      LoadStatePtr(probe_table_id_));
+  }
   if (GetJoinPlan().IsBloomFilterEnabled()) {
     bloom_filter_.Init(GetCodeGen(), LoadStatePtr(bloom_filter_id_),
                        EstimateCardinalityLeft());
@@ -233,69 +324,140 @@ void HashJoinTranslator::Produce() const {
   GetCompilationContext().Produce(*GetJoinPlan().GetChild(0));
 
   // Let the right child produce tuples, which we use to probe the hash table
+  // (or, when radix-partitioned, materialize into the probe table)
   GetCompilationContext().Produce(*GetJoinPlan().GetChild(1)->GetChild(0));
 
+  // Join the partitions of both sides
+  if (radix_partitioned_) {
+    ProducePartitioned();
+  }
+
   // That's it, we've produced all the tuples
 }
 
+void HashJoinTranslator::ProducePartitioned() const {
+  CodeGen &codegen = GetCodeGen();
+
+  // Probe the build table with each right tuple of the given partition range
+  auto join_partitions = [this, &codegen](ConsumerContext &ctx,
+                                          llvm::Value *start,
+                                          llvm::Value *end) {
+    // A single-row batch the right tuples are placed into
+    auto *raw_vec =
+        codegen.AllocateBuffer(codegen.Int32Type(), 1, "joinSelVector");
+    Vector selection_vector{raw_vec, 1, codegen.Int32Type()};
+    selection_vector.SetValue(codegen, codegen.Const32(0), codegen.Const32(0));
+    RowBatch batch{GetCompilationContext(), codegen.Const32(0),
+                   codegen.Const32(1), selection_vector, false};
+
+    lang::Loop partition_loop{codegen, codegen->CreateICmpULT(start, end),
+                              {{"partition", start}}};
+    {
+      llvm::Value *partition = partition_loop.GetLoopVar(0);
+      ProbePartition probe_partition{*this, ctx, batch};
+      probe_table_.IteratePartition(codegen, LoadStatePtr(probe_table_id_),
+                                    partition, probe_partition);
+
+      partition = codegen->CreateAdd(partition, codegen.Const32(1));
+      partition_loop.LoopEnd(codegen->CreateICmpULT(partition, end),
+                             {partition});
+    }
+  };
+
+  if (GetPipeline().IsParallel()) {
+    // Each task joins a contiguous range of partitions. Both sides are
+    // partitioned identically.
+    llvm::Value *num_partitions = codegen->CreateTrunc(
+        probe_table_.NumPartitions(codegen, LoadStatePtr(probe_table_id_)),
+        codegen.Int32Type());
+    auto *dispatcher =
+        RuntimeFunctionsProxy::ExecutePartitionedScan.GetFunction(codegen);
+    std::vector<llvm::Value *> dispatch_args = {num_partitions};
+    std::vector<llvm::Type *> pipeline_arg_types = {codegen.Int32Type(),
+                                                    codegen.Int32Type()};
+    auto producer = [&join_partitions](
+        ConsumerContext &ctx, const std::vector<llvm::Value *> &params) {
+      PELOTON_ASSERT(params.size() == 2);
+      join_partitions(ctx, params[0], params[1]);
+    };
+    GetPipeline().RunParallel(dispatcher, dispatch_args, pipeline_arg_types,
+                              producer);
+  } else {
+    auto producer = [this, &codegen, &join_partitions](ConsumerContext &ctx) {
+      llvm::Value *num_partitions = codegen->CreateTrunc(
+          probe_table_.NumPartitions(codegen, LoadStatePtr(probe_table_id_)),
+          codegen.Int32Type());
+      join_partitions(ctx, codegen.Const32(0), num_partitions);
+    };
+    GetPipeline().RunSerial(producer);
+  }
+}
+
 void HashJoinTranslator::Consume(ConsumerContext &context,
                                  RowBatch &batch) const {
-  OperatorTranslator::Consume(context, batch);
-#if 0
-  if (!UsePrefetching()) {
+  // Only probes benefit from prefetching, insertions into the build side are
+  // lazy and never touch the directory
+  if (!UsePrefetching() || IsFromLeftChild(context)) {
     OperatorTranslator::Consume(context, batch);
     return;
   }
 
-  // This aggregation uses prefetching
-  // TODO: This code is copied verbatime from aggregation ... REFACTOR!
+  // This join uses group prefetching. We process the batch in groups. For
+  // each group, we first compute the hash of every probe key and prefetch the
+  // directory slots they map to. Then, we prefetch the head of each bucket
+  // chain. By the time we walk the chains in the final pass, the first
+  // entries of each chain should be cache-resident.
 
   CodeGen &codegen = GetCodeGen();
 
   // The vector holding the hash values for the group
-  auto *raw_vec = codegen.AllocateBuffer(
-      codegen.Int64Type(), OAHashTable::kDefaultGroupPrefetchSize, "pfVector");
-  Vector hashes{raw_vec, OAHashTable::kDefaultGroupPrefetchSize,
-                codegen.Int64Type()};
+  auto group_size = OAHashTable::kDefaultGroupPrefetchSize;
+  auto *raw_vec =
+      codegen.AllocateBuffer(codegen.Int64Type(), group_size, "pfVector");
+  Vector hashes{raw_vec, group_size, codegen.Int64Type()};
 
   auto group_prefetch = [&](
       RowBatch::VectorizedIterateCallback::IterationInstance &iter_instance) {
+    llvm::Value *ht_ptr = LoadStatePtr(hash_table_id_);
     llvm::Value *p = codegen.Const32(0);
     llvm::Value *end =
         codegen->CreateSub(iter_instance.end, iter_instance.start);
 
-    // The first loop does hash computation and prefetching
-    lang::Loop prefetch_loop{
-        codegen, codegen->CreateICmpULT(p, end), {{"p", p}}};
+    // The first loop does hash computation and prefetches directory slots
+    lang::Loop hash_loop{codegen, codegen->CreateICmpULT(p, end), {{"p", p}}};
     {
-      p = prefetch_loop.GetLoopVar(0);
+      p = hash_loop.GetLoopVar(0);
       RowBatch::Row row =
           batch.GetRowAt(codegen->CreateAdd(p, iter_instance.start));
 
       // Collect keys
       std::vector<codegen::Value> key;
-      if (IsFromLeftChild(context)) {
-        CollectKeys(row, left_key_exprs_, key);
-      } else {
-        CollectKeys(row, right_key_exprs_, key);
-      }
+      CollectKeys(row, right_key_exprs_, key);
 
       // Hash the key and store in prefetch vector
-      llvm::Value *hash_val = hash_table_.HashKey(codegen, key);
-
-      // StoreValue hashed val in prefetch vector
+      llvm::Value *hash_val = Hash::HashValues(codegen, key);
       hashes.SetValue(codegen, p, hash_val);
 
-      // Prefetch the actual hash table bucket
-      hash_table_.PrefetchBucket(codegen, LoadStatePtr(hash_table_id_),
-                                 hash_val, OAHashTable::PrefetchType::Read,
-                                 OAHashTable::Locality::Medium);
+      // Prefetch the directory slot
+      hash_table_.PrefetchDirectorySlot(codegen, ht_ptr, hash_val);
 
-      // End prefetch loop
       p = codegen->CreateAdd(p, codegen.Const32(1));
-      prefetch_loop.LoopEnd(codegen->CreateICmpULT(p, end), {p});
+      hash_loop.LoopEnd(codegen->CreateICmpULT(p, end), {p});
     }
 
+    // The second loop prefetches the first entry in each bucket
+    p = codegen.Const32(0);
+    lang::Loop bucket_loop{codegen, codegen->CreateICmpULT(p, end), {{"p", p}}};
+    {
+      p = bucket_loop.GetLoopVar(0);
+      hash_table_.PrefetchBucketHead(codegen, ht_ptr,
+                                     hashes.GetValue(codegen, p));
+
+      p = codegen->CreateAdd(p, codegen.Const32(1));
+      bucket_loop.LoopEnd(codegen->CreateICmpULT(p, end), {p});
+    }
+
+    // The final loop probes the hash table with the precomputed hashes
     p = codegen.Const32(0);
     std::vector<lang::Loop::LoopVariable> loop_vars = {
         {"p", p}, {"writeIdx", iter_instance.write_pos}};
@@ -308,14 +470,13 @@ void HashJoinTranslator::Consume(ConsumerContext &context,
       RowBatch::OutputTracker tracker{batch.GetSelectionVector(), write_pos};
       RowBatch::Row row = batch.GetRowAt(read_pos, &tracker);
 
-      codegen::Value row_hash{type::Type{peloton::type::TypeId::INTEGER, false},
+      codegen::Value row_hash{type::Integer::Instance(),
                               hashes.GetValue(codegen, p)};
       row.RegisterAttributeValue(&OAHashTable::kHashAI, row_hash);
 
       // Consume row
       Consume(context, row);
 
-      // End prefetch loop
       p = codegen->CreateAdd(p, codegen.Const32(1));
       process_loop.LoopEnd(codegen->CreateICmpULT(p, end),
                            {p, tracker.GetFinalOutputPos()});
@@ -327,9 +488,7 @@ void HashJoinTranslator::Consume(ConsumerContext &context,
     return final_vals[0];
   };
 
-  batch.VectorizedIterate(codegen, OAHashTable::kDefaultGroupPrefetchSize,
-                          group_prefetch);
-#endif
+  batch.VectorizedIterate(codegen, group_size, group_prefetch);
 }
 
 // Consume the tuples produced by a child operator
@@ -354,14 +513,8 @@ void HashJoinTranslator::ConsumeFromLeft(ConsumerContext &ctx,
   std::vector<codegen::Value> vals;
   CollectValues(row, left_val_ais_, vals);
 
-  // If the hash value is available, use it
+  // Build-side tuples are inserted lazily, their hash is computed on insertion
   llvm::Value *hash = nullptr;
-#if 0
-  if (row.HasAttribute(&OAHashTable::kHashAI)) {
-    codegen::Value hash_val = row.DeriveValue(codegen, &OAHashTable::kHashAI);
-    hash = hash_val.GetValue();
-  }
-#endif
 
   llvm::Value *ht_ptr = nullptr;
   if (ctx.GetPipeline().IsParallel()) {
@@ -384,6 +537,10 @@ void HashJoinTranslator::RegisterPipelineState(PipelineContext &pipeline_ctx) {
   if (pipeline_ctx.IsParallel() && IsLeftPipeline(pipeline_ctx.GetPipeline())) {
     hash_table_tl_id_ = pipeline_ctx.RegisterState(
         "localHT", HashTableProxy::GetType(GetCodeGen()));
+  } else if (pipeline_ctx.IsParallel() &&
+             IsRightPipeline(pipeline_ctx.GetPipeline())) {
+    probe_table_tl_id_ = pipeline_ctx.RegisterState(
+        "localProbeHT", HashTableProxy::GetType(GetCodeGen()));
   }
 }
 
@@ -393,11 +550,40 @@ void HashJoinTranslator::InitializePipelineState(
     CodeGen &codegen = GetCodeGen();
     hash_table_.Init(codegen, GetExecutorContextPtr(),
                      pipeline_ctx.LoadStatePtr(codegen, hash_table_tl_id_));
+  } else if (pipeline_ctx.IsParallel() &&
+             IsRightPipeline(pipeline_ctx.GetPipeline())) {
+    CodeGen &codegen = GetCodeGen();
+    probe_table_.Init(codegen, GetExecutorContextPtr(),
+                      pipeline_ctx.LoadStatePtr(codegen, probe_table_tl_id_));
   }
 }
 
 void HashJoinTranslator::FinishPipeline(PipelineContext &pipeline_ctx) {
-  if (IsLeftPipeline(pipeline_ctx.GetPipeline())) {
+  if (IsLeftPipeline(pipeline_ctx.GetPipeline()) && radix_partitioned_) {
+    // Partition the build side and build the table one partition at a time
+    CodeGen &codegen = GetCodeGen();
+    llvm::Value *global_ht_ptr = LoadStatePtr(hash_table_id_);
+    if (!pipeline_ctx.IsParallel()) {
+      hash_table_.BuildPartitioned(codegen, global_ht_ptr);
+    } else {
+      hash_table_.BuildPartitionedParallel(
+          codegen, global_ht_ptr, GetThreadStatesPtr(),
+          pipeline_ctx.GetEntryOffset(codegen, hash_table_tl_id_));
+    }
+  } else if (IsRightPipeline(pipeline_ctx.GetPipeline())) {
+    // Partition the probe side the same way the build side was partitioned
+    CodeGen &codegen = GetCodeGen();
+    llvm::Value *probe_ht_ptr = LoadStatePtr(probe_table_id_);
+    llvm::Value *build_ht_ptr = LoadStatePtr(hash_table_id_);
+    if (!pipeline_ctx.IsParallel()) {
+      probe_table_.PartitionLazy(codegen, probe_ht_ptr, build_ht_ptr);
+    } else {
+      probe_table_.PartitionLazyParallel(
+          codegen, probe_ht_ptr, GetThreadStatesPtr(),
+          pipeline_ctx.GetEntryOffset(codegen, probe_table_tl_id_),
+          build_ht_ptr);
+    }
+  } else if (IsLeftPipeline(pipeline_ctx.GetPipeline())) {
     CodeGen &codegen = GetCodeGen();
     llvm::Value *global_ht_ptr = LoadStatePtr(hash_table_id_);
     if (!pipeline_ctx.IsParallel()) {
@@ -427,6 +613,12 @@ void HashJoinTranslator::TearDownPipelineState(PipelineContext &pipeline_ctx) {
     CodeGen &codegen = GetCodeGen();
     auto *local_ht_ptr = pipeline_ctx.LoadStatePtr(codegen, hash_table_tl_id_);
     hash_table_.Destroy(codegen, local_ht_ptr);
+  } else if (pipeline_ctx.IsParallel() &&
+             IsRightPipeline(pipeline_ctx.GetPipeline())) {
+    CodeGen &codegen = GetCodeGen();
+    auto *local_ht_ptr =
+        pipeline_ctx.LoadStatePtr(codegen, probe_table_tl_id_);
+    probe_table_.Destroy(codegen, local_ht_ptr);
   }
 }
 
@@ -437,6 +629,11 @@ void HashJoinTranslator::ConsumeFromRight(ConsumerContext &context,
   std::vector<codegen::Value> key;
   CollectKeys(row, right_key_exprs_, key);
 
+  if (radix_partitioned_) {
+    MaterializeRight(context, row, key);
+    return;
+  }
+
   if (GetJoinPlan().IsBloomFilterEnabled()) {
     // Prefilter the tuple using Bloom Filter
     llvm::Value *contains = bloom_filter_.Contains(
@@ -455,13 +652,50 @@ void HashJoinTranslator::ConsumeFromRight(ConsumerContext &context,
   }
 }
 
+void HashJoinTranslator::MaterializeRight(
+    ConsumerContext &context, RowBatch::Row &row,
+    std::vector<codegen::Value> &key) const {
+  CodeGen &codegen = GetCodeGen();
+
+  std::vector<codegen::Value> vals;
+  CollectValues(row, right_val_ais_, vals);
+
+  llvm::Value *ht_ptr = nullptr;
+  if (context.GetPipeline().IsParallel()) {
+    ht_ptr = context.GetPipelineContext()->LoadStatePtr(codegen,
+                                                        probe_table_tl_id_);
+  } else {
+    ht_ptr = LoadStatePtr(probe_table_id_);
+  }
+
+  // Tuples that can't find a join partner needn't be materialized
+  InsertLeft insert_right{right_value_storage_, vals};
+  if (GetJoinPlan().IsBloomFilterEnabled()) {
+    llvm::Value *contains =
+        bloom_filter_.Contains(codegen, LoadStatePtr(bloom_filter_id_), key);
+    lang::If is_valid_row{codegen, contains};
+    {
+      probe_table_.InsertLazy(codegen, ht_ptr, nullptr, key, insert_right);
+    }
+    is_valid_row.EndIf();
+  } else {
+    probe_table_.InsertLazy(codegen, ht_ptr, nullptr, key, insert_right);
+  }
+}
+
 void HashJoinTranslator::CodegenHashProbe(
     ConsumerContext &context, RowBatch::Row &row,
     std::vector<codegen::Value> &key) const {
   if (GetJoinPlan().GetJoinType() == JoinType::INNER) {
+    // If the hash value was computed during group prefetching, use it
+    llvm::Value *hash = nullptr;
+    if (row.HasAttribute(&OAHashTable::kHashAI)) {
+      hash = row.DeriveValue(GetCodeGen(), &OAHashTable::kHashAI).GetValue();
+    }
+
     // For inner joins, find all join partners
     ProbeRight probe_right{*this, context, row, key};
-    hash_table_.FindAll(GetCodeGen(), LoadStatePtr(hash_table_id_), key,
+    hash_table_.FindAll(GetCodeGen(), LoadStatePtr(hash_table_id_), hash, key,
                         probe_right);
   }
 }
@@ -470,6 +704,9 @@ void HashJoinTranslator::CodegenHashProbe(
 void HashJoinTranslator::TearDownQueryState() {
   CodeGen &codegen = GetCodeGen();
   hash_table_.Destroy(codegen, LoadStatePtr(hash_table_id_));
+  if (radix_partitioned_) {
+    probe_table_.Destroy(codegen, LoadStatePtr(probe_table_id_));
+  }
   if (GetJoinPlan().IsBloomFilterEnabled()) {
     bloom_filter_.Destroy(GetCodeGen(), LoadStatePtr(bloom_filter_id_));
   }
@@ -489,10 +726,10 @@ uint64_t HashJoinTranslator::EstimateCardinalityLeft() const {
   return (uint64_t)GetJoinPlan().GetChild(0)->GetCardinality();
 }
 
-// Should this aggregation use prefetching
+// Should the probes of this join use prefetching
 bool HashJoinTranslator::UsePrefetching() const {
-  // TODO: Implement me
-  return kUsePrefetch;
+  return settings::SettingsManager::GetBool(
+      settings::SettingId::codegen_hash_join_prefetch);
 }
 
 void HashJoinTranslator::CollectKeys(
@@ -579,5 +816,41 @@ void HashJoinTranslator::ProbeRight::ProcessEntry(
   }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+///
+/// ProbePartition
+///
+////////////////////////////////////////////////////////////////////////////////
+
+void HashJoinTranslator::ProbePartition::ProcessEntry(
+    CodeGen &codegen, llvm::Value *hash, const std::vector<codegen::Value> &key,
+    llvm::Value *data_area) const {
+  // Reconstruct the right tuple
+  RowBatch::Row row = batch_.GetRowAt(codegen.Const32(0));
+
+  std::vector<codegen::Value> right_vals;
+  join_translator_.right_value_storage_.LoadValues(codegen, data_area,
+                                                   right_vals);
+  const auto &right_val_ais = join_translator_.right_val_ais_;
+  for (uint32_t i = 0; i < right_val_ais.size(); i++) {
+    row.RegisterAttributeValue(right_val_ais[i], right_vals[i]);
+  }
+
+  const auto &right_key_exprs = join_translator_.right_key_exprs_;
+  for (uint32_t i = 0; i < right_key_exprs.size(); i++) {
+    const auto *exp = right_key_exprs[i];
+    if (exp->GetExpressionType() == ExpressionType::VALUE_TUPLE) {
+      auto *tve = static_cast<const expression::TupleValueExpression *>(exp);
+      row.RegisterAttributeValue(tve->GetAttributeRef(), key[i]);
+    }
+  }
+
+  // Find all join partners in the build-side partition
+  ProbeRight probe_right{join_translator_, context_, row, key};
+  join_translator_.hash_table_.FindAllPartitioned(
+      codegen, join_translator_.LoadStatePtr(join_translator_.hash_table_id_),
+      hash, key, probe_right);
+}
+
 }  // namespace codegen
-}  // namespace peloton
\ No newline at end of file
+}  // namespace peloton
@@ -0,0 +1,433 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// index_scan_translator.cpp
+//
+// Identification: src/codegen/operator/index_scan_translator.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "codegen/operator/index_scan_translator.h"
+
+#include "codegen/lang/loop.h"
+#include "codegen/proxy/index_scanner_proxy.h"
+#include "codegen/proxy/storage_manager_proxy.h"
+#include "codegen/proxy/transaction_runtime_proxy.h"
+#include "codegen/type/boolean_type.h"
+#include "codegen/vector.h"
+#include "expression/expression_util.h"
+#include "expression/tuple_value_expression.h"
+#include "planner/index_scan_plan.h"
+#include "storage/data_table.h"
+
+namespace peloton {
+namespace codegen {
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// AttributeAccess
+///
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * This class enables deferred access to any one available attribute in an input
+ * row. The main (overridden) function, Access(), is responsible for loading the
+ * attribute the class was constructed with from the input row provided to the
+ * function.
+ */
+class IndexScanTranslator::AttributeAccess : public RowBatch::AttributeAccess {
+ public:
+  AttributeAccess(const TileGroup::TileGroupAccess &access,
+                  const planner::AttributeInfo *ai)
+      : tile_group_access_(access), ai_(ai) {}
+
+  // Access an attribute in the given row
+  codegen::Value Access(CodeGen &codegen, RowBatch::Row &row) override {
+    auto raw_row = tile_group_access_.GetRow(row.GetTID(codegen));
+    return raw_row.LoadColumn(codegen, ai_->attribute_id);
+  }
+
+  const planner::AttributeInfo *GetAttributeRef() const { return ai_; }
+
+ private:
+  // The accessor we use to load column values
+  const TileGroup::TileGroupAccess &tile_group_access_;
+  // The attribute we will access
+  const planner::AttributeInfo *ai_;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// ScanConsumer
+///
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * The ScanConsumer is the callback functor used to process a batch of tuples
+ * found by the index. When ProcessTuples() is called, the selection vector
+ * already holds the offsets of the visible tuples in the tile group.
+ */
+class IndexScanTranslator::ScanConsumer : public codegen::ScanCallback {
+ public:
+  // Constructor
+  ScanConsumer(ConsumerContext &ctx, const planner::IndexScanPlan &plan,
+               Vector &selection_vector)
+      : ctx_(ctx),
+        plan_(plan),
+        selection_vector_(selection_vector),
+        tile_group_id_(nullptr),
+        tile_group_ptr_(nullptr) {}
+
+  // The callback when starting iteration over a new tile group
+  void TileGroupStart(CodeGen &, llvm::Value *tile_group_id,
+                      llvm::Value *tile_group_ptr) override {
+    tile_group_id_ = tile_group_id;
+    tile_group_ptr_ = tile_group_ptr;
+  }
+
+  // The code that processes a batch of tuples
+  void ProcessTuples(CodeGen &codegen, llvm::Value *tid_start,
+                     llvm::Value *tid_end,
+                     TileGroup::TileGroupAccess &tile_group_access) override;
+
+  // The callback when finishing iteration over a tile group
+  void TileGroupFinish(CodeGen &, llvm::Value *) override {}
+
+ private:
+  void SetupRowBatch(RowBatch &batch,
+                     TileGroup::TileGroupAccess &tile_group_access,
+                     std::vector<AttributeAccess> &access) const;
+
+  void PerformReads(CodeGen &codegen, Vector &selection_vector) const;
+
+  // Filter all the rows in the selection vector by the predicate of the scan
+  void FilterRowsByPredicate(CodeGen &codegen,
+                             const TileGroup::TileGroupAccess &access,
+                             llvm::Value *tid_start, llvm::Value *tid_end,
+                             Vector &selection_vector) const;
+
+ private:
+  // The consumer context
+  ConsumerContext &ctx_;
+  // The plan node
+  const planner::IndexScanPlan &plan_;
+  // The selection vector holding the tuples of the batch
+  Vector &selection_vector_;
+  // The current tile group id
+  llvm::Value *tile_group_id_;
+  // The current tile group
+  llvm::Value *tile_group_ptr_;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// Index Scan Translator
+///
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+// Collect the terms of the top-level conjunction of the predicate
+void CollectConjuncts(
+    const expression::AbstractExpression *expr,
+    std::vector<const expression::AbstractExpression *> &conjuncts) {
+  if (expr->GetExpressionType() == ExpressionType::CONJUNCTION_AND) {
+    for (size_t i = 0; i < expr->GetChildrenSize(); i++) {
+      CollectConjuncts(expr->GetChild(i), conjuncts);
+    }
+  } else {
+    conjuncts.push_back(expr);
+  }
+}
+
+}  // namespace
+
+IndexScanTranslator::IndexScanTranslator(
+    const planner::IndexScanPlan &index_scan, CompilationContext &context,
+    Pipeline &pipeline)
+    : OperatorTranslator(index_scan, context, pipeline),
+      table_(*index_scan.GetTable()) {
+  // Index scans are short, we always produce tuples serially
+  pipeline.MarkSource(this, Pipeline::Parallelism::Serial);
+
+  // If there is a predicate, prepare a translator for it
+  const auto *predicate = index_scan.GetPredicate();
+  if (predicate != nullptr) {
+    context.Prepare(*predicate);
+    CollectScanKeys(predicate);
+  }
+
+  // Register the index scanner
+  index_scanner_id_ = context.GetQueryState().RegisterState(
+      "indexScanner", IndexScannerProxy::GetType(GetCodeGen()));
+}
+
+// The optimizer copies the values of the keys out of the predicate. The
+// compiled query is reused for other values, so the keys are tied back to the
+// constants and parameters of the predicate, whose values are bound at runtime.
+// Keys that cannot be tied back are left out. This only widens the range of
+// the index scan, as the whole predicate is evaluated on every tuple.
+void IndexScanTranslator::CollectScanKeys(
+    const expression::AbstractExpression *predicate) {
+  std::vector<const expression::AbstractExpression *> conjuncts;
+  CollectConjuncts(predicate, conjuncts);
+
+  const auto &plan = GetIndexScanPlan();
+  const auto &key_column_ids = plan.GetKeyColumnIds();
+  const auto &expr_types = plan.GetExprTypes();
+  for (size_t i = 0; i < key_column_ids.size(); i++) {
+    for (const auto *conjunct : conjuncts) {
+      if (conjunct->GetChildrenSize() != 2) {
+        continue;
+      }
+
+      // Put the column reference on the left
+      auto expr_type = conjunct->GetExpressionType();
+      const auto *column_expr = conjunct->GetChild(0);
+      const auto *value_expr = conjunct->GetChild(1);
+      if (value_expr->GetExpressionType() == ExpressionType::VALUE_TUPLE) {
+        std::swap(column_expr, value_expr);
+        expr_type =
+            expression::ExpressionUtil::ReverseComparisonExpressionType(
+                expr_type);
+      }
+
+      auto value_type = value_expr->GetExpressionType();
+      if (column_expr->GetExpressionType() != ExpressionType::VALUE_TUPLE ||
+          (value_type != ExpressionType::VALUE_CONSTANT &&
+           value_type != ExpressionType::VALUE_PARAMETER)) {
+        continue;
+      }
+
+      const auto *ai =
+          static_cast<const expression::TupleValueExpression *>(column_expr)
+              ->GetAttributeRef();
+      PELOTON_ASSERT(ai != nullptr);
+      if (ai->attribute_id == key_column_ids[i] && expr_type == expr_types[i]) {
+        scan_keys_.push_back(ScanKey{key_column_ids[i], expr_types[i],
+                                     value_expr});
+        break;
+      }
+    }
+  }
+
+  LOG_TRACE("Index scan on '%s' uses %lu of %lu keys",
+            plan.GetTable()->GetName().c_str(), scan_keys_.size(),
+            key_column_ids.size());
+}
+
+llvm::Value *IndexScanTranslator::LoadTablePtr(CodeGen &codegen) const {
+  const storage::DataTable &table = *GetIndexScanPlan().GetTable();
+
+  // Get the table instance from the database
+  llvm::Value *db_oid = codegen.Const32(table.GetDatabaseOid());
+  llvm::Value *table_oid = codegen.Const32(table.GetOid());
+  return codegen.Call(StorageManagerProxy::GetTableWithOid,
+                      {GetStorageManagerPtr(), db_oid, table_oid});
+}
+
+void IndexScanTranslator::InitializeQueryState() {
+  CodeGen &codegen = GetCodeGen();
+  const auto &plan = GetIndexScanPlan();
+
+  // Call IndexScanner::Init(table, index_oid, executor_context)
+  llvm::Value *index_scanner = LoadStatePtr(index_scanner_id_);
+  codegen.Call(IndexScannerProxy::Init,
+               {index_scanner, LoadTablePtr(codegen),
+                codegen.Const32(plan.GetIndexId()), GetExecutorContextPtr()});
+
+  // Register the keys with the query parameters that carry their values
+  auto &parameter_cache = GetCompilationContext().GetParameterCache();
+  for (const auto &scan_key : scan_keys_) {
+    uint32_t parameter_idx = parameter_cache.GetIndex(scan_key.value_expr);
+    codegen.Call(IndexScannerProxy::AddKey,
+                 {index_scanner, codegen.Const32(scan_key.column_id),
+                  codegen.Const32(static_cast<int32_t>(scan_key.expr_type)),
+                  codegen.Const32(parameter_idx)});
+  }
+}
+
+// Produce the tuples found by the index.
+//
+// @code
+// IndexScanner::Scan()
+//
+// num_tuples := IndexScanner::NextBatch(pos_list, vector_size)
+// while (num_tuples > 0) {
+//   tile_group_ptr := IndexScanner::GetTileGroup()
+//   consumer.ProcessTuples(tile_group_ptr, pos_list[0:num_tuples])
+//   num_tuples := IndexScanner::NextBatch(pos_list, vector_size)
+// }
+// @endcode
+void IndexScanTranslator::Produce() const {
+  auto producer = [this](ConsumerContext &ctx) {
+    CodeGen &codegen = GetCodeGen();
+
+    // Probe the index
+    llvm::Value *index_scanner = LoadStatePtr(index_scanner_id_);
+    codegen.Call(IndexScannerProxy::Scan, {index_scanner});
+
+    // The selection vector for the scan
+    auto *i32_type = codegen.Int32Type();
+    auto vec_size = Vector::kDefaultVectorSize.load();
+    auto *raw_vec = codegen.AllocateBuffer(i32_type, vec_size, "scanPosList");
+    Vector position_list{raw_vec, vec_size, i32_type};
+
+    ScanConsumer scan_consumer{ctx, GetIndexScanPlan(), position_list};
+
+    // Pull batches out of the scanner until every tuple has been produced
+    llvm::Value *num_tuples =
+        codegen.Call(IndexScannerProxy::NextBatch,
+                     {index_scanner, raw_vec, codegen.Const32(vec_size)});
+    lang::Loop batch_loop{
+        codegen, codegen->CreateICmpUGT(num_tuples, codegen.Const32(0)),
+        {{"numTuples", num_tuples}}};
+    {
+      num_tuples = batch_loop.GetLoopVar(0);
+      position_list.SetNumElements(num_tuples);
+
+      llvm::Value *tile_group_ptr =
+          codegen.Call(IndexScannerProxy::GetTileGroup, {index_scanner});
+      table_.GenerateBatchScan(codegen, tile_group_ptr, codegen.Const32(0),
+                               num_tuples, scan_consumer);
+
+      num_tuples =
+          codegen.Call(IndexScannerProxy::NextBatch,
+                       {index_scanner, raw_vec, codegen.Const32(vec_size)});
+      batch_loop.LoopEnd(
+          codegen->CreateICmpUGT(num_tuples, codegen.Const32(0)),
+          {num_tuples});
+    }
+  };
+
+  // Index scans are always serial
+  GetPipeline().RunSerial(producer);
+}
+
+void IndexScanTranslator::TearDownQueryState() {
+  // Call IndexScanner::Destroy()
+  llvm::Value *index_scanner = LoadStatePtr(index_scanner_id_);
+  GetCodeGen().Call(IndexScannerProxy::Destroy, {index_scanner});
+}
+
+const planner::IndexScanPlan &IndexScanTranslator::GetIndexScanPlan() const {
+  return GetPlanAs<planner::IndexScanPlan>();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// Scan Consumer
+///
+////////////////////////////////////////////////////////////////////////////////
+
+// Generate the body of the batch
+void IndexScanTranslator::ScanConsumer::ProcessTuples(
+    CodeGen &codegen, llvm::Value *tid_start, llvm::Value *tid_end,
+    TileGroup::TileGroupAccess &tile_group_access) {
+  // 1. The selection vector only holds tuples that are visible, the scanner
+  //    has checked visibility when it walked the version chains
+
+  // 2. Filter rows by the given predicate (if one exists). This also drops
+  //    the rows at the boundaries of open ranges, which the index returns.
+  auto *predicate = plan_.GetPredicate();
+  if (predicate != nullptr) {
+    FilterRowsByPredicate(codegen, tile_group_access, tid_start, tid_end,
+                          selection_vector_);
+  }
+
+  // 3. Record reads for all of the tuple that pass the predicate
+  PerformReads(codegen, selection_vector_);
+
+  // 4. Setup the (filtered) row batch and setup attribute accessors
+  RowBatch batch{ctx_.GetCompilationContext(), tile_group_id_, tid_start,
+                 tid_end, selection_vector_, true};
+
+  std::vector<IndexScanTranslator::AttributeAccess> attribute_accesses;
+  SetupRowBatch(batch, tile_group_access, attribute_accesses);
+
+  // 5. Push the batch into the pipeline
+  ctx_.Consume(batch);
+}
+
+void IndexScanTranslator::ScanConsumer::SetupRowBatch(
+    RowBatch &batch, TileGroup::TileGroupAccess &tile_group_access,
+    std::vector<IndexScanTranslator::AttributeAccess> &access) const {
+  // Grab a hold of the stuff we need (i.e., the plan, all the attributes, and
+  // the IDs of the columns the scan _actually_ produces)
+  std::vector<const planner::AttributeInfo *> ais;
+  plan_.GetAttributes(ais);
+  const auto &output_col_ids = plan_.GetColumnIds();
+
+  // 1. Put all the attribute accessors into a vector
+  access.clear();
+  for (oid_t col_idx = 0; col_idx < output_col_ids.size(); col_idx++) {
+    access.emplace_back(tile_group_access, ais[output_col_ids[col_idx]]);
+  }
+
+  // 2. Add the attribute accessors into the row batch
+  for (oid_t col_idx = 0; col_idx < output_col_ids.size(); col_idx++) {
+    auto *attribute = ais[output_col_ids[col_idx]];
+    batch.AddAttribute(attribute, &access[col_idx]);
+  }
+}
+
+void IndexScanTranslator::ScanConsumer::FilterRowsByPredicate(
+    CodeGen &codegen, const TileGroup::TileGroupAccess &access,
+    llvm::Value *tid_start, llvm::Value *tid_end,
+    Vector &selection_vector) const {
+  // The batch we're filtering
+  RowBatch batch{ctx_.GetCompilationContext(), tile_group_id_, tid_start,
+                 tid_end, selection_vector, true};
+
+  // Determine the attributes the predicate needs
+  const auto *predicate = plan_.GetPredicate();
+
+  std::unordered_set<const planner::AttributeInfo *> used_attributes;
+  predicate->GetUsedAttributes(used_attributes);
+
+  // Setup the row batch with attribute accessors for the predicate
+  std::vector<AttributeAccess> attribute_accessors;
+  for (const auto *ai : used_attributes) {
+    attribute_accessors.emplace_back(access, ai);
+  }
+  for (uint32_t i = 0; i < attribute_accessors.size(); i++) {
+    auto &accessor = attribute_accessors[i];
+    batch.AddAttribute(accessor.GetAttributeRef(), &accessor);
+  }
+
+  // Iterate over the batch using a scalar loop
+  batch.Iterate(codegen, [&](RowBatch::Row &row) {
+    // Evaluate the predicate to determine row validity
+    codegen::Value valid_row = row.DeriveValue(codegen, *predicate);
+
+    // Reify the boolean value since it may be NULL
+    PELOTON_ASSERT(valid_row.GetType().GetSqlType() ==
+                   type::Boolean::Instance());
+    llvm::Value *bool_val = type::Boolean::Instance().Reify(codegen, valid_row);
+
+    // Set the validity of the row
+    row.SetValidity(codegen, bool_val);
+  });
+}
+
+void IndexScanTranslator::ScanConsumer::PerformReads(
+    CodeGen &codegen, Vector &selection_vector) const {
+  ExecutionConsumer &ec = ctx_.GetCompilationContext().GetExecutionConsumer();
+  llvm::Value *txn = ec.GetTransactionPtr(ctx_.GetCompilationContext());
+  llvm::Value *raw_sel_vec = selection_vector.GetVectorPtr();
+
+  llvm::Value *is_for_update = codegen.ConstBool(plan_.IsForUpdate());
+  llvm::Value *end_idx = selection_vector.GetNumElements();
+
+  // Invoke TransactionRuntime::PerformVectorizedRead(...)
+  llvm::Value *out_idx =
+      codegen.Call(TransactionRuntimeProxy::PerformVectorizedRead,
+                   {txn, tile_group_ptr_, raw_sel_vec, end_idx, is_for_update});
+  selection_vector.SetNumElements(out_idx);
+}
+
+}  // namespace codegen
+}  // namespace peloton
@@ -37,6 +37,13 @@ LimitTranslator::LimitTranslator(const planner::LimitPlan &plan,
                                  Pipeline &pipeline)
     : OperatorTranslator(plan, context, pipeline) {
   PELOTON_ASSERT(plan.GetChildrenSize() == 1);
+
+  // Limiting sorted input must see the tuples in sort order. Force serial
+  // execution so the ORDER BY below us doesn't scan its output in parallel.
+  if (plan.GetChild(0)->GetPlanNodeType() == PlanNodeType::ORDERBY) {
+    pipeline.SetSerial();
+  }
+
   context.Prepare(*plan.GetChild(0), pipeline);
 
   auto &codegen = GetCodeGen();
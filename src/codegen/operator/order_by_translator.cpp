@@ -125,8 +125,15 @@ OrderByTranslator::OrderByTranslator(const planner::OrderByPlan &plan,
                                      Pipeline &pipeline)
     : OperatorTranslator(plan, context, pipeline),
       child_pipeline_(this, Pipeline::Parallelism::Flexible) {
-  // Scanning the sorter happens serially (for now ...)
-  pipeline.MarkSource(this, Pipeline::Parallelism::Serial);
+  // The sorted output is scanned in parallel, one contiguous range of the
+  // sorted tuples per task, unless the order in which tuples are delivered
+  // matters. That is the case when we feed the query's consumer directly. A
+  // LIMIT on top of us also forces our output pipeline to be serial.
+  if (context.IsLastPipeline(pipeline)) {
+    pipeline.MarkSource(this, Pipeline::Parallelism::Serial);
+  } else {
+    pipeline.MarkSource(this, Pipeline::Parallelism::Parallel);
+  }
 
   // Prepare the child
   context.Prepare(*plan.GetChild(0), child_pipeline_);
@@ -304,6 +311,14 @@ void OrderByTranslator::Produce() const {
   // Let the child produce the tuples we materialize into a buffer
   GetCompilationContext().Produce(*GetPlan().GetChild(0));
 
+  if (GetPipeline().IsParallel()) {
+    ProduceParallel();
+  } else {
+    ProduceSerial();
+  }
+}
+
+void OrderByTranslator::ProduceSerial() const {
   auto producer = [this](ConsumerContext &ctx) {
     CodeGen &codegen = GetCodeGen();
     auto *sorter_ptr = LoadStatePtr(sorter_id_);
@@ -319,10 +334,43 @@ void OrderByTranslator::Produce() const {
     sorter_.VectorizedIterate(codegen, sorter_ptr, vec_size, 0, callback);
   };
 
-  // We set the pipeline to be serial in the constructor. Sanity check here.
-  auto &pipeline = GetPipeline();
-  PELOTON_ASSERT(!pipeline.IsParallel());
-  pipeline.RunSerial(producer);
+  GetPipeline().RunSerial(producer);
+}
+
+void OrderByTranslator::ProduceParallel() const {
+  CodeGen &codegen = GetCodeGen();
+
+  // We use util::Sorter::ScanParallel() to split the sorted tuples into
+  // disjoint ranges that are scanned in parallel
+  auto *dispatcher = SorterProxy::ScanParallel.GetFunction(codegen);
+  std::vector<llvm::Value *> dispatch_args = {LoadStatePtr(sorter_id_)};
+
+  // Our function needs to know the start and stop positions to scan
+  std::vector<llvm::Type *> pipeline_arg_types = {codegen.Int64Type(),
+                                                  codegen.Int64Type()};
+
+  auto producer = [this, &codegen](ConsumerContext &ctx,
+                                   const std::vector<llvm::Value *> params) {
+    PELOTON_ASSERT(params.size() == 2);
+    llvm::Value *start = params[0];
+    llvm::Value *end = params[1];
+
+    auto *sorter_ptr = LoadStatePtr(sorter_id_);
+
+    // Iterate over our range of the sorted list
+    auto *i32_type = codegen.Int32Type();
+    auto vec_size = Vector::kDefaultVectorSize.load();
+    auto *raw_vec = codegen.AllocateBuffer(i32_type, vec_size, "obPosList");
+    Vector position_list(raw_vec, vec_size, i32_type);
+
+    const auto &plan = GetPlanAs<planner::OrderByPlan>();
+    ProduceResults callback(ctx, plan, position_list);
+    sorter_.VectorizedIterate(codegen, sorter_ptr, vec_size, start, end,
+                              callback);
+  };
+
+  GetPipeline().RunParallel(dispatcher, dispatch_args, pipeline_arg_types,
+                            producer);
 }
 
 void OrderByTranslator::Consume(ConsumerContext &ctx,
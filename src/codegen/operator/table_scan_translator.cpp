@@ -154,6 +154,36 @@ TableScanTranslator::TableScanTranslator(const planner::SeqScanPlan &scan,
 // live as long as the compiled query. Hence, it may point to invalid memory
 // at some invocation of the query.
 
+namespace {
+
+// Collect the constants of a zone-mappable predicate, in the order in which
+// ExpressionUtil::GetPredicateForZoneMap() parsed them
+void CollectZoneMapConstants(
+    const expression::AbstractExpression &expr,
+    std::vector<const expression::AbstractExpression *> &constants) {
+  if (expr.GetExpressionType() == ExpressionType::CONJUNCTION_AND) {
+    CollectZoneMapConstants(*expr.GetChild(0), constants);
+    CollectZoneMapConstants(*expr.GetChild(1), constants);
+  } else {
+    constants.push_back(expr.GetChild(1));
+  }
+}
+
+}  // namespace
+
+std::vector<codegen::Value> TableScanTranslator::LoadZoneMapValues(
+    const expression::AbstractExpression &predicate) const {
+  std::vector<const expression::AbstractExpression *> constants;
+  CollectZoneMapConstants(predicate, constants);
+
+  const auto &parameter_cache = GetCompilationContext().GetParameterCache();
+  std::vector<codegen::Value> values;
+  for (const auto *constant : constants) {
+    values.push_back(parameter_cache.GetValue(constant));
+  }
+  return values;
+}
+
 llvm::Value *TableScanTranslator::LoadTablePtr(CodeGen &codegen) const {
   const storage::DataTable &table = *GetScanPlan().GetTable();
 
@@ -182,18 +212,21 @@ void TableScanTranslator::ProduceSerial() const {
     llvm::Value *predicate_ptr = codegen->CreateIntToPtr(
         codegen.Const64((int64_t)predicate),
         AbstractExpressionProxy::GetType(codegen)->getPointerTo());
-    size_t num_preds = 0;
+    const std::vector<storage::PredicateInfo> *zone_map_preds = nullptr;
+    std::vector<codegen::Value> zone_map_values;
 
     auto *zone_map_manager = storage::ZoneMapManager::GetInstance();
     if (predicate != nullptr && zone_map_manager->ZoneMapTableExists()) {
       if (predicate->IsZoneMappable()) {
-        num_preds = predicate->GetNumberofParsedPredicates();
+        zone_map_preds = predicate->GetParsedPredicates();
+        zone_map_values = LoadZoneMapValues(*predicate);
       }
     }
 
     ScanConsumer scan_consumer{ctx, GetScanPlan(), position_list};
     table_.GenerateScan(codegen, table_ptr, nullptr, nullptr, vec_size,
-                        predicate_ptr, num_preds, scan_consumer);
+                        predicate_ptr, zone_map_preds, zone_map_values,
+                        scan_consumer);
   };
 
   // Execute serially
@@ -239,19 +272,22 @@ void TableScanTranslator::ProduceParallel() const {
     llvm::Value *predicate_ptr = codegen->CreateIntToPtr(
         codegen.Const64((int64_t)predicate),
         AbstractExpressionProxy::GetType(codegen)->getPointerTo());
-    size_t num_preds = 0;
+    const std::vector<storage::PredicateInfo> *zone_map_preds = nullptr;
+    std::vector<codegen::Value> zone_map_values;
 
     auto *zone_map_manager = storage::ZoneMapManager::GetInstance();
     if (predicate != nullptr && zone_map_manager->ZoneMapTableExists()) {
       if (predicate->IsZoneMappable()) {
-        num_preds = predicate->GetNumberofParsedPredicates();
+        zone_map_preds = predicate->GetParsedPredicates();
+        zone_map_values = LoadZoneMapValues(*predicate);
       }
     }
 
     // Scan the given range of the table
     ScanConsumer scan_consumer{ctx, GetScanPlan(), position_list};
     table_.GenerateScan(codegen, table_ptr, tilegroup_start, tilegroup_end,
-                        vec_size, predicate_ptr, num_preds, scan_consumer);
+                        vec_size, predicate_ptr, zone_map_preds,
+                        zone_map_values, scan_consumer);
   };
 
   // Execute parallel
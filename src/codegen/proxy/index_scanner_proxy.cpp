@@ -0,0 +1,32 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// index_scanner_proxy.cpp
+//
+// Identification: src/codegen/proxy/index_scanner_proxy.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "codegen/proxy/index_scanner_proxy.h"
+
+#include "codegen/proxy/data_table_proxy.h"
+#include "codegen/proxy/executor_context_proxy.h"
+#include "codegen/proxy/tile_group_proxy.h"
+
+namespace peloton {
+namespace codegen {
+
+DEFINE_TYPE(IndexScanner, "codegen::IndexScanner", opaque);
+
+DEFINE_METHOD(peloton::codegen, IndexScanner, Init);
+DEFINE_METHOD(peloton::codegen, IndexScanner, AddKey);
+DEFINE_METHOD(peloton::codegen, IndexScanner, Scan);
+DEFINE_METHOD(peloton::codegen, IndexScanner, NextBatch);
+DEFINE_METHOD(peloton::codegen, IndexScanner, GetTileGroup);
+DEFINE_METHOD(peloton::codegen, IndexScanner, Destroy);
+
+}  // namespace codegen
+}  // namespace peloton
@@ -34,7 +34,9 @@ DEFINE_METHOD(peloton::codegen, RuntimeFunctions, GetTileGroup);
 DEFINE_METHOD(peloton::codegen, RuntimeFunctions, GetTileGroupLayout);
 DEFINE_METHOD(peloton::codegen, RuntimeFunctions, FillPredicateArray);
 DEFINE_METHOD(peloton::codegen, RuntimeFunctions, ExecuteTableScan);
+DEFINE_METHOD(peloton::codegen, RuntimeFunctions, ExecutePartitionedScan);
 DEFINE_METHOD(peloton::codegen, RuntimeFunctions, ExecutePerState);
+DEFINE_METHOD(peloton::codegen, RuntimeFunctions, ExecutePerPartition);
 DEFINE_METHOD(peloton::codegen, RuntimeFunctions, ThrowDivideByZeroException);
 DEFINE_METHOD(peloton::codegen, RuntimeFunctions, ThrowOverflowException);
 
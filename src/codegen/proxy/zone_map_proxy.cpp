@@ -20,9 +20,12 @@ namespace codegen {
 
 DEFINE_TYPE(PredicateInfo, "peloton::storage::PredicateInfo", col_id,
             comparison_operator, predicate_value);
+DEFINE_TYPE(RawColumnStatistics, "peloton::storage::RawColumnStatistics",
+            min_integer, max_integer, min_decimal, max_decimal, null_count);
 DEFINE_TYPE(ZoneMapManager, "peloton::storage::ZoneMapManager", opaque);
 
 DEFINE_METHOD(peloton::storage, ZoneMapManager, ShouldScanTileGroup);
+DEFINE_METHOD(peloton::storage, ZoneMapManager, GetRawZoneMap);
 DEFINE_METHOD(peloton::storage, ZoneMapManager, GetInstance);
 
 }  // namespace codegen
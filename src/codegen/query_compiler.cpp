@@ -12,9 +12,12 @@
 
 #include "codegen/query_compiler.h"
 
+#include <algorithm>
+
 #include "codegen/compilation_context.h"
 #include "planner/aggregate_plan.h"
 #include "planner/hash_join_plan.h"
+#include "planner/index_scan_plan.h"
 #include "planner/projection_plan.h"
 #include "planner/seq_scan_plan.h"
 
@@ -46,6 +49,7 @@ std::unique_ptr<Query> QueryCompiler::Compile(
 bool QueryCompiler::IsSupported(const planner::AbstractPlan &plan) {
   switch (plan.GetPlanNodeType()) {
     case PlanNodeType::SEQSCAN:
+    case PlanNodeType::INDEXSCAN:
     case PlanNodeType::CSVSCAN:
     case PlanNodeType::ORDERBY:
     case PlanNodeType::DELETE:
@@ -94,6 +98,17 @@ bool QueryCompiler::IsSupported(const planner::AbstractPlan &plan) {
       pred = scan_plan.GetPredicate();
       break;
     }
+    case PlanNodeType::INDEXSCAN: {
+      auto &scan_plan = static_cast<const planner::IndexScanPlan &>(plan);
+      // IN list keys are probed as one batch by the index scan executor
+      const auto &expr_types = scan_plan.GetExprTypes();
+      if (std::find(expr_types.begin(), expr_types.end(),
+                    ExpressionType::COMPARE_IN) != expr_types.end()) {
+        return false;
+      }
+      pred = scan_plan.GetPredicate();
+      break;
+    }
     case PlanNodeType::AGGREGATE_V2: {
       auto &agg_plan = static_cast<const planner::AggregatePlan &>(plan);
       pred = agg_plan.GetPredicate();
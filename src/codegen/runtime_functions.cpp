@@ -208,6 +208,63 @@ void RuntimeFunctions::ExecuteTableScan(
   latch.Await(0);
 }
 
+void RuntimeFunctions::ExecutePartitionedScan(
+    void *query_state, executor::ExecutorContext::ThreadStates &thread_states,
+    uint32_t num_partitions, void *func) {
+  using ScanFunc = void (*)(void *, void *, uint32_t, uint32_t);
+  auto *scanner = reinterpret_cast<ScanFunc>(func);
+
+  // The worker pool
+  auto &worker_pool = threadpool::MonoQueuePool::GetExecutionInstance();
+
+  // Determine the number of tasks to generate. Each task processes a
+  // contiguous range of partitions.
+  uint32_t num_tasks =
+      std::max(1u, std::min(worker_pool.NumWorkers(), num_partitions));
+  uint32_t num_partitions_per_task = num_partitions / num_tasks;
+
+  // Allocate states for each task
+  thread_states.Allocate(num_tasks);
+
+  // Create count down latch
+  common::synchronization::CountDownLatch latch{num_tasks};
+
+  // Now, submit the tasks
+  for (uint32_t task_id = 0; task_id < num_tasks; task_id++) {
+    bool last_task = (task_id == num_tasks - 1);
+    auto partition_start = task_id * num_partitions_per_task;
+    auto partition_stop =
+        last_task ? num_partitions : partition_start + num_partitions_per_task;
+    auto work = [&query_state, &thread_states, &scanner, &latch, task_id,
+                 partition_start, partition_stop]() {
+      LOG_DEBUG("Task-%u scanning partitions [%u-%u)", task_id,
+                partition_start, partition_stop);
+
+      // Time this
+      Timer<std::milli> timer;
+      timer.Start();
+
+      // Pull out this task's thread state
+      auto thread_state = thread_states.AccessThreadState(task_id);
+
+      // Invoke scan function
+      scanner(query_state, thread_state, partition_start, partition_stop);
+
+      // Count down latch
+      latch.CountDown();
+
+      // Log stuff
+      timer.Stop();
+      LOG_DEBUG("Task-%u done scanning partitions (%.2lf ms) ...", task_id,
+                timer.GetDuration());
+    };
+    worker_pool.SubmitTask(work);
+  }
+
+  // Wait for everything to finish
+  latch.Await(0);
+}
+
 void RuntimeFunctions::ExecutePerState(
     void *query_state, executor::ExecutorContext::ThreadStates &thread_states,
     void (*work_func)(void *, void *)) {
@@ -247,6 +304,40 @@ void RuntimeFunctions::ExecutePerState(
   latch.Await(0);
 }
 
+void RuntimeFunctions::ExecutePerPartition(
+    void *query_state, uint32_t num_partitions,
+    void (*work_func)(void *, uint32_t)) {
+  // The worker pool
+  auto &worker_pool = threadpool::MonoQueuePool::GetExecutionInstance();
+
+  // Create count down latch
+  common::synchronization::CountDownLatch latch{num_partitions};
+
+  // Loop over partitions
+  for (uint32_t partition = 0; partition < num_partitions; partition++) {
+    worker_pool.SubmitTask([&query_state, &work_func, &latch, partition]() {
+      LOG_DEBUG("Processing partition %u ...", partition);
+
+      // Time this
+      Timer<std::milli> timer;
+      timer.Start();
+
+      // Invoke work function on this partition
+      work_func(query_state, partition);
+
+      // Count down the latch
+      latch.CountDown();
+
+      timer.Stop();
+      LOG_DEBUG("Finished processing partition %u (%.2lf ms) ...", partition,
+                timer.GetDuration());
+    });
+  }
+
+  // Wait for all tasks to complete
+  latch.Await(0);
+}
+
 void RuntimeFunctions::ThrowDivideByZeroException() {
   throw DivideByZeroException("ERROR: division by zero");
 }
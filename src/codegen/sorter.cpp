@@ -167,6 +167,35 @@ void Sorter::VectorizedIterate(
   }
 }
 
+// Iterate over the tuples in the given range of the sorter in batches/vectors
+// of the given size
+void Sorter::VectorizedIterate(
+    CodeGen &codegen, llvm::Value *sorter_ptr, uint32_t vector_size,
+    llvm::Value *start_index, llvm::Value *end_index,
+    Sorter::VectorizedIterateCallback &callback) const {
+  llvm::Value *start_pos = codegen.Load(SorterProxy::tuples_start, sorter_ptr);
+  start_pos = codegen->CreateInBoundsGEP(codegen.CharPtrType(), start_pos,
+                                         start_index);
+  llvm::Value *num_tuples = codegen->CreateSub(end_index, start_index);
+  num_tuples = codegen->CreateTrunc(num_tuples, codegen.Int32Type());
+
+  lang::VectorizedLoop loop(codegen, num_tuples, vector_size, {});
+  {
+    // Current loop range
+    auto curr_range = loop.GetCurrentRange();
+
+    // Provide an accessor into the sorted space, relative to the range start
+    SorterAccess sorter_access(*this, start_pos);
+
+    // Issue the callback
+    callback.ProcessEntries(codegen, curr_range.start, curr_range.end,
+                            sorter_access);
+
+    // That's it
+    loop.LoopEnd(codegen, {});
+  }
+}
+
 void Sorter::Destroy(CodeGen &codegen, llvm::Value *sorter_ptr) const {
   codegen.Call(SorterProxy::Destroy, {sorter_ptr});
 }
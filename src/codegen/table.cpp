@@ -19,6 +19,7 @@
 #include "codegen/proxy/runtime_functions_proxy.h"
 #include "codegen/proxy/zone_map_proxy.h"
 #include "storage/data_table.h"
+#include "storage/zone_map_manager.h"
 
 namespace peloton {
 namespace codegen {
@@ -45,6 +46,137 @@ llvm::Value *Table::GetZoneMapManager(CodeGen &codegen) const {
   return codegen.Call(ZoneMapManagerProxy::GetInstance, {});
 }
 
+namespace {
+
+// Both sides of the comparison are integral, so the integer pair of the raw
+// zone map is used
+bool IsIntegerComparison(peloton::type::TypeId column_type,
+                         peloton::type::TypeId value_type) {
+  return column_type != peloton::type::TypeId::DECIMAL &&
+         value_type != peloton::type::TypeId::DECIMAL;
+}
+
+// Widen the value of a zone-mapped predicate to the representation of the
+// raw zone map it is compared with
+llvm::Value *GetRawConstant(CodeGen &codegen, const codegen::Value &value,
+                            bool is_integer) {
+  const auto value_type = value.GetType().type_id;
+  if (!is_integer) {
+    return value_type == peloton::type::TypeId::DECIMAL
+               ? value.GetValue()
+               : codegen->CreateSIToFP(value.GetValue(), codegen.DoubleType());
+  }
+  // Dates are unsigned, everything else is sign-extended
+  if (value_type == peloton::type::TypeId::DATE) {
+    return codegen->CreateZExtOrTrunc(value.GetValue(), codegen.Int64Type());
+  }
+  return codegen->CreateSExtOrTrunc(value.GetValue(), codegen.Int64Type());
+}
+
+}  // namespace
+
+bool Table::CanUseRawZoneMap(
+    const std::vector<storage::PredicateInfo> &predicates) const {
+  const auto *schema = table_.GetSchema();
+  for (const auto &predicate : predicates) {
+    if (predicate.predicate_value.IsNull() ||
+        !storage::ZoneMapManager::IsRawComparable(
+            schema->GetType(predicate.col_id),
+            predicate.predicate_value.GetTypeId())) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Check the predicates against the raw zone maps of a tile group. Tile groups
+// without zone maps are always scanned. The predicate values are loaded from
+// the query parameters, so a cached query prunes with the constants of the
+// plan it is executed for.
+//
+// @code
+// if (GetRawZoneMap(tile_group_id, raw_stats)) {
+//   should_scan := raw_stats[col_a].min_integer <= 10 &&
+//                  raw_stats[col_a].max_integer >= 10 && ...
+// } else {
+//   should_scan := true
+// }
+// @endcode
+llvm::Value *Table::ShouldScanTileGroup(
+    CodeGen &codegen, llvm::Value *tile_group_id, llvm::Value *raw_stats,
+    const std::vector<storage::PredicateInfo> &predicates,
+    const std::vector<codegen::Value> &predicate_values) const {
+  PELOTON_ASSERT(predicates.size() == predicate_values.size());
+  const auto *schema = table_.GetSchema();
+  auto *raw_stats_type = RawColumnStatisticsProxy::GetType(codegen);
+
+  llvm::Value *has_zone_map =
+      codegen.Call(ZoneMapManagerProxy::GetRawZoneMap,
+                   {GetZoneMapManager(codegen), tile_group_id, raw_stats});
+
+  llvm::Value *should_scan = nullptr;
+  lang::If zone_map_exists{codegen, has_zone_map};
+  {
+    should_scan = codegen.ConstBool(true);
+    for (uint32_t i = 0; i < predicates.size(); i++) {
+      const auto &predicate = predicates[i];
+      const auto col_id = static_cast<uint32_t>(predicate.col_id);
+      const auto &value = predicate.predicate_value;
+      bool is_integer =
+          IsIntegerComparison(schema->GetType(col_id), value.GetTypeId());
+
+      // The integer pair comes first in RawColumnStatistics
+      uint32_t min_offset = is_integer ? 0 : 2;
+      llvm::Value *min =
+          codegen->CreateLoad(codegen->CreateConstInBoundsGEP2_32(
+              raw_stats_type, raw_stats, col_id, min_offset));
+      llvm::Value *max =
+          codegen->CreateLoad(codegen->CreateConstInBoundsGEP2_32(
+              raw_stats_type, raw_stats, col_id, min_offset + 1));
+
+      llvm::Value *constant =
+          GetRawConstant(codegen, predicate_values[i], is_integer);
+
+      llvm::Value *cmp = nullptr;
+      switch (static_cast<ExpressionType>(predicate.comparison_operator)) {
+        case ExpressionType::COMPARE_EQUAL: {
+          llvm::Value *min_le =
+              is_integer ? codegen->CreateICmpSLE(min, constant)
+                         : codegen->CreateFCmpOLE(min, constant);
+          llvm::Value *max_ge =
+              is_integer ? codegen->CreateICmpSGE(max, constant)
+                         : codegen->CreateFCmpOGE(max, constant);
+          cmp = codegen->CreateAnd(min_le, max_ge);
+          break;
+        }
+        case ExpressionType::COMPARE_LESSTHAN:
+          cmp = is_integer ? codegen->CreateICmpSLT(min, constant)
+                           : codegen->CreateFCmpOLT(min, constant);
+          break;
+        case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+          cmp = is_integer ? codegen->CreateICmpSLE(min, constant)
+                           : codegen->CreateFCmpOLE(min, constant);
+          break;
+        case ExpressionType::COMPARE_GREATERTHAN:
+          cmp = is_integer ? codegen->CreateICmpSGT(max, constant)
+                           : codegen->CreateFCmpOGT(max, constant);
+          break;
+        case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+          cmp = is_integer ? codegen->CreateICmpSGE(max, constant)
+                           : codegen->CreateFCmpOGE(max, constant);
+          break;
+        default: {
+          throw Exception{"Invalid expression type for translation "};
+        }
+      }
+      should_scan = codegen->CreateAnd(should_scan, cmp);
+    }
+  }
+  zone_map_exists.EndIf();
+
+  return zone_map_exists.BuildPHI(should_scan, codegen.ConstBool(true));
+}
+
 // Generate a scan over all tile groups.
 //
 // @code
@@ -70,7 +202,9 @@ llvm::Value *Table::GetZoneMapManager(CodeGen &codegen) const {
 void Table::GenerateScan(CodeGen &codegen, llvm::Value *table_ptr,
                          llvm::Value *tilegroup_start,
                          llvm::Value *tilegroup_end, uint32_t batch_size,
-                         llvm::Value *predicate_ptr, size_t num_predicates,
+                         llvm::Value *predicate_ptr,
+                         const std::vector<storage::PredicateInfo> *predicates,
+                         const std::vector<codegen::Value> &predicate_values,
                          ScanCallback &consumer) const {
   // Allocate some space for the column layouts
   const auto num_columns =
@@ -78,10 +212,20 @@ void Table::GenerateScan(CodeGen &codegen, llvm::Value *table_ptr,
   llvm::Value *column_layouts = codegen.AllocateBuffer(
       ColumnLayoutInfoProxy::GetType(codegen), num_columns, "columnLayout");
 
+  // Numeric predicates are compared against the raw zone maps in generated
+  // code. Everything else goes through the zone map manager.
+  const size_t num_predicates = predicates != nullptr ? predicates->size() : 0;
+  const bool use_raw_zone_map =
+      num_predicates != 0 && CanUseRawZoneMap(*predicates);
+
   // Allocate some space for the parsed predicates (if need be!)
   llvm::Value *predicate_array =
       codegen.NullPtr(PredicateInfoProxy::GetType(codegen)->getPointerTo());
-  if (num_predicates != 0) {
+  llvm::Value *raw_stats = nullptr;
+  if (use_raw_zone_map) {
+    raw_stats = codegen.AllocateBuffer(
+        RawColumnStatisticsProxy::GetType(codegen), num_columns, "rawZoneMap");
+  } else if (num_predicates != 0) {
     predicate_array = codegen.AllocateBuffer(
         PredicateInfoProxy::GetType(codegen), num_predicates, "predicateInfo");
     codegen.Call(RuntimeFunctionsProxy::FillPredicateArray,
@@ -107,10 +251,18 @@ void Table::GenerateScan(CodeGen &codegen, llvm::Value *table_ptr,
         tile_group_.GetTileGroupId(codegen, tile_group_ptr);
 
     // Check zone map
-    llvm::Value *cond = codegen.Call(
-        ZoneMapManagerProxy::ShouldScanTileGroup,
-        {GetZoneMapManager(codegen), predicate_array,
-         codegen.Const32(num_predicates), table_ptr, tile_group_idx});
+    llvm::Value *cond = nullptr;
+    if (use_raw_zone_map) {
+      cond = ShouldScanTileGroup(codegen, tile_group_id, raw_stats,
+                                 *predicates, predicate_values);
+    } else if (num_predicates != 0) {
+      cond = codegen.Call(
+          ZoneMapManagerProxy::ShouldScanTileGroup,
+          {GetZoneMapManager(codegen), predicate_array,
+           codegen.Const32(num_predicates), table_ptr, tile_group_idx});
+    } else {
+      cond = codegen.ConstBool(true);
+    }
 
     codegen::lang::If should_scan_tilegroup{codegen, cond};
     {
@@ -133,5 +285,34 @@ void Table::GenerateScan(CodeGen &codegen, llvm::Value *table_ptr,
   }
 }
 
+// Generate the scan of a single batch of tuples in the given tile group.
+//
+// @code
+// column_layouts := alloca<peloton::ColumnLayoutInfo>(
+//     table.GetSchema().GetColumnCount())
+//
+// consumer.TileGroupStart(tile_group_ptr);
+// tile_group.BatchScan(tile_group_ptr, column_layouts, tid_start, tid_end,
+//                      consumer);
+// consumer.TileGroupEnd(tile_group_ptr);
+// @endcode
+void Table::GenerateBatchScan(CodeGen &codegen, llvm::Value *tile_group_ptr,
+                              llvm::Value *tid_start, llvm::Value *tid_end,
+                              ScanCallback &consumer) const {
+  // Allocate some space for the column layouts
+  const auto num_columns =
+      static_cast<uint32_t>(table_.GetSchema()->GetColumnCount());
+  llvm::Value *column_layouts = codegen.AllocateBuffer(
+      ColumnLayoutInfoProxy::GetType(codegen), num_columns, "columnLayout");
+
+  llvm::Value *tile_group_id =
+      tile_group_.GetTileGroupId(codegen, tile_group_ptr);
+
+  consumer.TileGroupStart(codegen, tile_group_id, tile_group_ptr);
+  tile_group_.GenerateBatchScan(codegen, tile_group_ptr, column_layouts,
+                                tid_start, tid_end, consumer);
+  consumer.TileGroupFinish(codegen, tile_group_ptr);
+}
+
 }  // namespace codegen
 }  // namespace peloton
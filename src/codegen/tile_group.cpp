@@ -65,6 +65,21 @@ void TileGroup::GenerateTidScan(CodeGen &codegen, llvm::Value *tile_group_ptr,
   }
 }
 
+// This method generates code to pass a single batch of tuples in the provided
+// tile group to the consumer. Scans that locate their tuples through an index
+// use this rather than a full scan of the tile group.
+void TileGroup::GenerateBatchScan(CodeGen &codegen, llvm::Value *tile_group_ptr,
+                                  llvm::Value *column_layouts,
+                                  llvm::Value *tid_start, llvm::Value *tid_end,
+                                  ScanCallback &consumer) const {
+  // Get the column layouts
+  auto col_layouts = GetColumnLayouts(codegen, tile_group_ptr, column_layouts);
+
+  // Pass the batch to the consumer
+  TileGroupAccess tile_group_access{*this, col_layouts};
+  consumer.ProcessTuples(codegen, tid_start, tid_end, tile_group_access);
+}
+
 // Call TileGroup::GetNextTupleSlot(...) to determine # of tuples in tile group.
 llvm::Value *TileGroup::GetNumTuples(CodeGen &codegen,
                                      llvm::Value *tile_group) const {
@@ -16,8 +16,11 @@
 #include "common/container_tuple.h"
 #include "concurrency/transaction_context.h"
 #include "concurrency/transaction_manager_factory.h"
+#include "concurrency/version_index_manager.h"
 #include "executor/executor_context.h"
+#include "storage/storage_manager.h"
 #include "storage/tile_group.h"
+#include "storage/tile_group_header.h"
 
 namespace peloton {
 namespace codegen {
@@ -73,6 +76,66 @@ uint32_t TransactionRuntime::PerformVectorizedRead(
   return out_idx;
 }
 
+bool TransactionRuntime::FindVisibleVersion(
+    concurrency::TransactionContext &txn, ItemPointer &location) {
+  // Get the transaction manager
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+
+  auto *storage_manager = storage::StorageManager::GetInstance();
+  auto tile_group = storage_manager->GetTileGroup(location.block);
+  auto *tile_group_header = tile_group->GetHeader();
+
+  // Versions tracked by the version index are found without walking the chain
+  auto *version_index_manager =
+      concurrency::VersionIndexManager::GetInstance();
+  ItemPointer versioned_location = version_index_manager->GetVisibleVersion(
+      tile_group_header->GetIndirection(location.offset), &txn);
+  if (!versioned_location.IsNull()) {
+    location = versioned_location;
+    return true;
+  }
+
+  size_t chain_length = 0;
+  while (true) {
+    ++chain_length;
+
+    auto visibility =
+        txn_manager.IsVisible(&txn, tile_group_header, location.offset);
+    if (visibility == VisibilityType::DELETED) {
+      return false;
+    } else if (visibility == VisibilityType::OK) {
+      return true;
+    }
+
+    PELOTON_ASSERT(visibility == VisibilityType::INVISIBLE);
+
+    bool is_acquired = (tile_group_header->GetTransactionId(location.offset) ==
+                        INITIAL_TXN_ID);
+    bool is_alive = (tile_group_header->GetEndCommitId(location.offset) <=
+                     txn.GetReadId());
+    if (is_acquired && is_alive) {
+      // Another transaction has modified the version chain while we were
+      // walking it. Start over from the head of the chain.
+      location = *(tile_group_header->GetIndirection(location.offset));
+      chain_length = 0;
+    } else {
+      location = tile_group_header->GetNextItemPointer(location.offset);
+      if (location.IsNull()) {
+        // A chain of a single invisible version was inserted by a
+        // transaction that has not committed yet. Otherwise, there must have
+        // been a visible version.
+        if (chain_length != 1) {
+          txn_manager.SetTransactionResult(&txn, ResultType::FAILURE);
+        }
+        return false;
+      }
+    }
+
+    tile_group = storage_manager->GetTileGroup(location.block);
+    tile_group_header = tile_group->GetHeader();
+  }
+}
+
 bool TransactionRuntime::IsOwner(concurrency::TransactionContext &txn,
                                  storage::TileGroupHeader *tile_group_header,
                                  uint32_t tuple_offset) {
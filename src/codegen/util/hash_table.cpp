@@ -12,7 +12,11 @@
 
 #include "codegen/util/hash_table.h"
 
+#include <algorithm>
+
 #include "common/platform.h"
+#include "common/synchronization/count_down_latch.h"
+#include "threadpool/mono_queue_pool.h"
 #include "type/abstract_pool.h"
 
 namespace peloton {
@@ -22,6 +26,11 @@ namespace util {
 static const uint32_t kDefaultNumElements = 256;
 static const uint32_t kNumBlockElems = 1024;
 
+// The target size of a radix partition (roughly the size of an L2 cache), and
+// the maximum number of radix bits we partition on
+static const uint64_t kTargetPartitionSize = 256 * 1024;
+static const uint32_t kMaxPartitionBits = 12;
+
 static_assert((kDefaultNumElements & (kDefaultNumElements - 1)) == 0,
               "Default number of elements must be a power of two");
 
@@ -114,7 +123,12 @@ HashTable::HashTable(::peloton::type::AbstractPool &memory, uint32_t key_size,
       directory_mask_(0),
       entry_buffer_(memory, Entry::Size(key_size, value_size)),
       num_elems_(0),
-      capacity_(kDefaultNumElements) {
+      capacity_(kDefaultNumElements),
+      directory_shift_(0),
+      num_partitions_(0),
+      partition_heads_(nullptr),
+      partition_tails_(nullptr),
+      num_partition_bits_(0) {
   // Upon creation, we allocate room for kDefaultNumElements in the hash table.
   // We assume 50% load factor on the directory, thus the directory size is
   // twice the number of elements.
@@ -133,6 +147,13 @@ HashTable::~HashTable() {
     memory_.Free(directory_);
     directory_ = nullptr;
   }
+
+  // Free the partitions
+  if (partition_heads_ != nullptr) {
+    memory_.Free(partition_heads_);
+    memory_.Free(partition_tails_);
+    partition_heads_ = partition_tails_ = nullptr;
+  }
 }
 
 void HashTable::Init(HashTable &table, executor::ExecutorContext &exec_ctx,
@@ -279,6 +300,201 @@ void HashTable::MergeLazyUnfinished(HashTable &other) {
   other.entry_buffer_.TransferMemoryBlocks(entry_buffer_);
 }
 
+void HashTable::BuildPartitioned() {
+  // Scatter the entries into cache-sized partitions, then build the directory
+  // one partition at a time
+  ScatterLazy(ChoosePartitionBits(num_elems_));
+  AllocatePartitionedDirectory();
+  for (uint64_t idx = 0; idx < num_partitions_; idx++) {
+    BuildPartition(idx);
+  }
+}
+
+void HashTable::BuildPartitionedParallel(
+    const executor::ExecutorContext::ThreadStates &thread_states,
+    uint32_t hash_table_offset) {
+  // Determine the total number of tuples stored across each hash table
+  uint64_t total_size = num_elems_;
+  for (uint32_t i = 0; i < thread_states.NumThreads(); i++) {
+    auto *hash_table = reinterpret_cast<HashTable *>(
+        thread_states.AccessThreadState(i) + hash_table_offset);
+    total_size += hash_table->NumElements();
+  }
+
+  // Partition all thread-local tables
+  GatherPartitions(thread_states, hash_table_offset,
+                   ChoosePartitionBits(total_size));
+
+  // Allocate the directory, then build each partition's slice of it in
+  // parallel. Slices are disjoint, so no synchronization is needed.
+  AllocatePartitionedDirectory();
+
+  auto &work_pool = threadpool::MonoQueuePool::GetExecutionInstance();
+  auto num_tasks = static_cast<uint32_t>(std::max<uint64_t>(
+      1, std::min<uint64_t>(work_pool.NumWorkers(), num_partitions_)));
+  uint64_t partitions_per_task = num_partitions_ / num_tasks;
+
+  common::synchronization::CountDownLatch latch(num_tasks);
+  for (uint32_t task_id = 0; task_id < num_tasks; task_id++) {
+    bool last_task = (task_id == num_tasks - 1);
+    uint64_t start = task_id * partitions_per_task;
+    uint64_t end = last_task ? num_partitions_ : start + partitions_per_task;
+    work_pool.SubmitTask([this, &latch, start, end]() {
+      for (uint64_t idx = start; idx < end; idx++) {
+        BuildPartition(idx);
+      }
+      latch.CountDown();
+    });
+  }
+  latch.Await(0);
+}
+
+void HashTable::PartitionLazy(const HashTable &build_table) {
+  PELOTON_ASSERT(build_table.IsPartitioned());
+  ScatterLazy(build_table.num_partition_bits_);
+}
+
+void HashTable::PartitionLazyParallel(
+    const executor::ExecutorContext::ThreadStates &thread_states,
+    uint32_t hash_table_offset, const HashTable &build_table) {
+  PELOTON_ASSERT(build_table.IsPartitioned());
+  GatherPartitions(thread_states, hash_table_offset,
+                   build_table.num_partition_bits_);
+}
+
+uint32_t HashTable::ChoosePartitionBits(uint64_t num_elems) const {
+  // Each entry also needs (on average) two directory slots at 50% load
+  uint64_t entry_size = entry_buffer_.EntrySize() + 2 * sizeof(Entry *);
+  uint64_t total_size = num_elems * entry_size;
+
+  uint32_t num_bits = 0;
+  while (num_bits < kMaxPartitionBits &&
+         (total_size >> num_bits) > kTargetPartitionSize) {
+    num_bits++;
+  }
+  return num_bits;
+}
+
+void HashTable::AllocatePartitions(uint32_t num_partition_bits) {
+  PELOTON_ASSERT(num_partition_bits <= kMaxPartitionBits);
+
+  if (partition_heads_ != nullptr) {
+    memory_.Free(partition_heads_);
+    memory_.Free(partition_tails_);
+  }
+
+  num_partition_bits_ = num_partition_bits;
+  num_partitions_ = 1ull << num_partition_bits;
+
+  uint64_t alloc_size = sizeof(Entry *) * num_partitions_;
+  partition_heads_ = static_cast<Entry **>(memory_.Allocate(alloc_size));
+  partition_tails_ = static_cast<Entry **>(memory_.Allocate(alloc_size));
+  PELOTON_MEMSET(partition_heads_, 0, alloc_size);
+  PELOTON_MEMSET(partition_tails_, 0, alloc_size);
+}
+
+void HashTable::ScatterLazy(uint32_t num_partition_bits) {
+  AllocatePartitions(num_partition_bits);
+
+  // Nothing was inserted, the partitions are all empty
+  if (num_elems_ == 0) {
+    return;
+  }
+
+  // The lazily inserted entries are linked from the first directory slot
+  Entry *head = directory_[0];
+  directory_[0] = directory_[1] = nullptr;
+
+  while (head != nullptr) {
+    uint64_t idx = num_partition_bits_ == 0
+                       ? 0
+                       : head->hash >> (64 - num_partition_bits_);
+    Entry *next = head->next;
+    if (partition_heads_[idx] == nullptr) {
+      partition_tails_[idx] = head;
+    }
+    head->next = partition_heads_[idx];
+    partition_heads_[idx] = head;
+    head = next;
+  }
+}
+
+void HashTable::GatherPartitions(
+    const executor::ExecutorContext::ThreadStates &thread_states,
+    uint32_t hash_table_offset, uint32_t num_partition_bits) {
+  // Partition anything we hold ourselves
+  ScatterLazy(num_partition_bits);
+
+  // Partition each thread-local table in parallel
+  std::vector<HashTable *> tables;
+  for (uint32_t i = 0; i < thread_states.NumThreads(); i++) {
+    tables.push_back(reinterpret_cast<HashTable *>(
+        thread_states.AccessThreadState(i) + hash_table_offset));
+  }
+
+  auto &work_pool = threadpool::MonoQueuePool::GetExecutionInstance();
+  common::synchronization::CountDownLatch latch(tables.size());
+  for (auto *table : tables) {
+    work_pool.SubmitTask([table, &latch, num_partition_bits]() {
+      table->ScatterLazy(num_partition_bits);
+      latch.CountDown();
+    });
+  }
+  latch.Await(0);
+
+  // Prepend each thread-local partition to our partition
+  for (auto *table : tables) {
+    PELOTON_ASSERT(&memory_ == &table->memory_);
+    for (uint64_t idx = 0; idx < num_partitions_; idx++) {
+      if (table->partition_heads_[idx] == nullptr) {
+        continue;
+      }
+      if (partition_heads_[idx] == nullptr) {
+        partition_tails_[idx] = table->partition_tails_[idx];
+      }
+      table->partition_tails_[idx]->next = partition_heads_[idx];
+      partition_heads_[idx] = table->partition_heads_[idx];
+      table->partition_heads_[idx] = table->partition_tails_[idx] = nullptr;
+    }
+
+    // Take custody of the entries
+    num_elems_ += table->num_elems_;
+    table->num_elems_ = table->capacity_ = 0;
+    table->entry_buffer_.TransferMemoryBlocks(entry_buffer_);
+  }
+}
+
+void HashTable::AllocatePartitionedDirectory() {
+  PELOTON_ASSERT(IsPartitioned());
+
+  // Clean up old directory
+  memory_.Free(directory_);
+
+  // A 50% loaded directory that has at least one slot per partition. It is
+  // indexed by the high bits of the hash, so that each partition owns a
+  // contiguous slice.
+  capacity_ = NextPowerOf2(std::max(num_elems_, UINT64_C(2)));
+  directory_size_ = std::max(capacity_ * 2, num_partitions_);
+  directory_mask_ = directory_size_ - 1;
+  directory_shift_ = CountLeadingZeroes(directory_size_) + 1;
+
+  uint64_t alloc_size = sizeof(Entry *) * directory_size_;
+  directory_ = static_cast<Entry **>(memory_.Allocate(alloc_size));
+  PELOTON_MEMSET(directory_, 0, alloc_size);
+}
+
+void HashTable::BuildPartition(uint64_t partition_idx) {
+  Entry *head = partition_heads_[partition_idx];
+  while (head != nullptr) {
+    uint64_t index = head->hash >> directory_shift_;
+    Entry *next = head->next;
+    head->next = directory_[index];
+    directory_[index] = head;
+    head = next;
+  }
+  partition_heads_[partition_idx] = partition_tails_[partition_idx] = nullptr;
+}
+
 void HashTable::Resize() {
   // Sanity check
   PELOTON_ASSERT(NeedsResize());
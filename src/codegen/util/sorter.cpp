@@ -166,14 +166,27 @@ struct MergeWork {
 void Sorter::SortParallel(
     const executor::ExecutorContext::ThreadStates &thread_states,
     uint32_t sorter_offset) {
-  // Collect all sorter instances
+  // Collect all sorter instances. Only non-empty sorters take part in the
+  // sort and merge, but we take custody of the memory of all of them.
   uint64_t num_tuples = 0;
-  std::vector<Sorter *> sorters;
-  thread_states.ForEach<Sorter>(sorter_offset,
-                                [&num_tuples, &sorters](Sorter *sorter) {
-                                  sorters.push_back(sorter);
-                                  num_tuples += sorter->NumTuples();
-                                });
+  std::vector<Sorter *> all_sorters, sorters;
+  thread_states.ForEach<Sorter>(
+      sorter_offset, [&num_tuples, &all_sorters, &sorters](Sorter *sorter) {
+        all_sorters.push_back(sorter);
+        if (sorter->NumTuples() > 0) {
+          sorters.push_back(sorter);
+          num_tuples += sorter->NumTuples();
+        }
+      });
+
+  if (sorters.empty()) {
+    for (auto *sorter : all_sorters) {
+      sorter->TransferMemoryBlocks(*this);
+    }
+    tuples_.clear();
+    tuples_start_ = tuples_end_ = tuples_.data();
+    return;
+  }
 
   // The worker pool we use to execute parallel work
   auto &work_pool = threadpool::MonoQueuePool::GetExecutionInstance();
@@ -307,6 +320,14 @@ void Sorter::SortParallel(
         };
     for (auto &work : merge_work) {
       work_pool.SubmitTask([&work, &latch, &heap_cmp] {
+        // A single input range is already sorted, just copy it out
+        if (work.input_ranges.size() == 1) {
+          const auto &range = work.input_ranges[0];
+          std::copy(range.first, range.second, work.destination);
+          latch.CountDown();
+          return;
+        }
+
         std::priority_queue<MergeWork::InputRange,
                             std::vector<MergeWork::InputRange>,
                             decltype(heap_cmp)> heap(heap_cmp,
@@ -333,7 +354,7 @@ void Sorter::SortParallel(
   /// Step 4 - Transfer ownership of thread-local memory
   //////////////////////////////////////////////////////////////////
   {
-    for (auto *sorter : sorters) {
+    for (auto *sorter : all_sorters) {
       sorter->TransferMemoryBlocks(*this);
     }
   }
@@ -352,11 +373,59 @@ void Sorter::SortTopKParallel(
   SortParallel(thread_states, sorter_offset);
 
   // Trim to top-K
-  tuples_.resize(top_k);
+  if (tuples_.size() > top_k) {
+    tuples_.resize(top_k);
+  }
   tuples_start_ = tuples_.data();
   tuples_end_ = tuples_start_ + tuples_.size();
 }
 
+// The sorted tuples live in a single contiguous array, whether they were
+// sorted serially or merged in parallel by SortParallel(). Since every merge
+// package writes a disjoint slice of that array, any split of the array into
+// ranges yields independent scan tasks that see their tuples in sort order.
+// We split it evenly, rather than along the merge packages, so that skewed
+// splitters don't leave one task with most of the work.
+void Sorter::ScanParallel(
+    void *query_state, executor::ExecutorContext::ThreadStates &thread_states,
+    Sorter &sorter, void *func) {
+  using ScanFunc = void (*)(void *, void *, uint64_t, uint64_t);
+  auto *scanner = reinterpret_cast<ScanFunc>(func);
+
+  // The worker pool
+  auto &work_pool = threadpool::MonoQueuePool::GetExecutionInstance();
+
+  // Determine the number of tasks, such that each task has a reasonable
+  // amount of work to do
+  uint64_t num_tuples = sorter.NumTuples();
+  uint64_t max_tasks =
+      (num_tuples + kMinTuplesPerScanTask - 1) / kMinTuplesPerScanTask;
+  auto num_tasks = static_cast<uint32_t>(std::max(
+      UINT64_C(1), std::min<uint64_t>(work_pool.NumWorkers(), max_tasks)));
+  uint64_t tuples_per_task = num_tuples / num_tasks;
+
+  // Allocate states for each task
+  thread_states.Allocate(num_tasks);
+
+  common::synchronization::CountDownLatch latch(num_tasks);
+  for (uint32_t task_id = 0; task_id < num_tasks; task_id++) {
+    bool last_task = (task_id == num_tasks - 1);
+    uint64_t start = task_id * tuples_per_task;
+    uint64_t end = last_task ? num_tuples : start + tuples_per_task;
+    work_pool.SubmitTask(
+        [query_state, &thread_states, scanner, &latch, task_id, start, end]() {
+          LOG_DEBUG("Task-%u scanning sorted tuples [%lu-%lu)", task_id,
+                    start, end);
+          auto *thread_state = thread_states.AccessThreadState(task_id);
+          scanner(query_state, thread_state, start, end);
+          latch.CountDown();
+        });
+  }
+
+  // Wait for everything to finish
+  latch.Await(0);
+}
+
 void Sorter::MakeRoomForNewTuple() {
   bool has_room =
       (buffer_pos_ != nullptr && buffer_pos_ + tuple_size_ < buffer_end_);
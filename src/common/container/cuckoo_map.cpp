@@ -18,12 +18,14 @@
 #include "common/item_pointer.h"
 #include "common/logger.h"
 #include "common/macros.h"
+#include "index/index_key.h"
 
 namespace peloton {
 
 namespace storage {
 class TileGroup;
-}
+class ZoneMap;
+}  // namespace storage
 
 namespace stats {
 class BackendStatsContext;
@@ -61,6 +63,29 @@ bool CUCKOO_MAP_TYPE::Update(const KeyType &key, ValueType value) {
   return status;
 }
 
+CUCKOO_MAP_TEMPLATE_ARGUMENTS
+bool CUCKOO_MAP_TYPE::UpdateFn(const KeyType &key,
+                               std::function<void(ValueType &)> fn) {
+  auto status = cuckoo_map.update_fn(key, fn);
+  LOG_TRACE("update_fn status : %d", status);
+  return status;
+}
+
+CUCKOO_MAP_TEMPLATE_ARGUMENTS
+void CUCKOO_MAP_TYPE::UpsertFn(const KeyType &key,
+                               std::function<void(ValueType &)> fn,
+                               ValueType value) {
+  cuckoo_map.upsert(key, fn, value);
+}
+
+CUCKOO_MAP_TEMPLATE_ARGUMENTS
+bool CUCKOO_MAP_TYPE::EraseFn(const KeyType &key,
+                              std::function<bool(ValueType &)> fn) {
+  auto status = cuckoo_map.erase_fn(key, fn);
+  LOG_TRACE("erase_fn status : %d", status);
+  return status;
+}
+
 CUCKOO_MAP_TEMPLATE_ARGUMENTS
 bool CUCKOO_MAP_TYPE::Erase(const KeyType &key) {
   auto status = cuckoo_map.erase(key);
@@ -75,6 +100,11 @@ bool CUCKOO_MAP_TYPE::Find(const KeyType &key, ValueType &value) const {
   return status;
 }
 
+CUCKOO_MAP_TEMPLATE_ARGUMENTS
+void CUCKOO_MAP_TYPE::Prefetch(const KeyType &key) const {
+  cuckoo_map.prefetch(key);
+}
+
 CUCKOO_MAP_TEMPLATE_ARGUMENTS
 bool CUCKOO_MAP_TYPE::Contains(const KeyType &key) {
   return cuckoo_map.contains(key);
@@ -89,6 +119,13 @@ size_t CUCKOO_MAP_TYPE::GetSize() const { return cuckoo_map.size(); }
 CUCKOO_MAP_TEMPLATE_ARGUMENTS
 bool CUCKOO_MAP_TYPE::IsEmpty() const { return cuckoo_map.empty(); }
 
+CUCKOO_MAP_TEMPLATE_ARGUMENTS
+size_t CUCKOO_MAP_TYPE::GetMemoryFootprint() const {
+  const size_t slot_size =
+      sizeof(std::pair<KeyType, ValueType>) + sizeof(char);
+  return cuckoo_map.bucket_count() * cuckoo_map_t::slot_per_bucket * slot_size;
+}
+
 CUCKOO_MAP_TEMPLATE_ARGUMENTS
 CUCKOO_MAP_ITERATOR_TYPE
 CUCKOO_MAP_TYPE::GetIterator() { return cuckoo_map.lock_table(); }
@@ -125,4 +162,36 @@ template class CuckooMap<std::shared_ptr<oid_t>, std::shared_ptr<oid_t>>;
 // Used in StatementCacheManager
 template class CuckooMap<StatementCache *, StatementCache *>;
 
+// Used in ZoneMapManager
+template class CuckooMap<oid_t, std::shared_ptr<const storage::ZoneMap>>;
+
+// Used in HashIndex
+template class CuckooMap<index::CompactIntsKey<1>, std::vector<ItemPointer *>,
+                         index::CompactIntsHasher<1>,
+                         index::CompactIntsEqualityChecker<1>>;
+template class CuckooMap<index::CompactIntsKey<2>, std::vector<ItemPointer *>,
+                         index::CompactIntsHasher<2>,
+                         index::CompactIntsEqualityChecker<2>>;
+template class CuckooMap<index::CompactIntsKey<3>, std::vector<ItemPointer *>,
+                         index::CompactIntsHasher<3>,
+                         index::CompactIntsEqualityChecker<3>>;
+template class CuckooMap<index::CompactIntsKey<4>, std::vector<ItemPointer *>,
+                         index::CompactIntsHasher<4>,
+                         index::CompactIntsEqualityChecker<4>>;
+template class CuckooMap<index::GenericKey<4>, std::vector<ItemPointer *>,
+                         index::GenericHasher<4>,
+                         index::GenericEqualityChecker<4>>;
+template class CuckooMap<index::GenericKey<8>, std::vector<ItemPointer *>,
+                         index::GenericHasher<8>,
+                         index::GenericEqualityChecker<8>>;
+template class CuckooMap<index::GenericKey<16>, std::vector<ItemPointer *>,
+                         index::GenericHasher<16>,
+                         index::GenericEqualityChecker<16>>;
+template class CuckooMap<index::GenericKey<64>, std::vector<ItemPointer *>,
+                         index::GenericHasher<64>,
+                         index::GenericEqualityChecker<64>>;
+template class CuckooMap<index::GenericKey<256>, std::vector<ItemPointer *>,
+                         index::GenericHasher<256>,
+                         index::GenericEqualityChecker<256>>;
+
 }  // namespace peloton
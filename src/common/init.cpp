@@ -21,10 +21,14 @@
 #include "concurrency/transaction_manager_factory.h"
 #include "gc/gc_manager_factory.h"
 #include "index/index.h"
+#include "logging/checkpoint_manager_factory.h"
+#include "logging/log_manager_factory.h"
+#include "logging/logical_log_manager.h"
 #include "settings/settings_manager.h"
 #include "threadpool/mono_queue_pool.h"
 #include "tuning/index_tuner.h"
 #include "tuning/layout_tuner.h"
+#include "util/string_util.h"
 
 namespace peloton {
 
@@ -55,9 +59,6 @@ void PelotonInit::Initialize() {
   storage::DataTable::SetActiveTileGroupCount(parallelism);
   storage::DataTable::SetActiveIndirectionArrayCount(parallelism);
 
-  // start epoch.
-  concurrency::EpochManagerFactory::GetInstance().StartEpoch();
-
   // start GC.
   gc::GCManagerFactory::Configure(settings::SettingsManager::GetInt(settings::SettingId::gc_num_threads));
   gc::GCManagerFactory::GetInstance().StartGC();
@@ -91,6 +92,54 @@ void PelotonInit::Initialize() {
 
   txn_manager.CommitTransaction(txn);
 
+  // recover from the latest checkpoint and the log, then start logging and
+  // checkpointing. one logger thread is started for every log directory. the
+  // catalog is bootstrapped above, and recovery adds the rows of the core
+  // catalog tables and creates the databases and tables that they describe.
+  bool logging_enabled =
+      settings::SettingsManager::GetBool(settings::SettingId::logging_enabled);
+  bool checkpoint_enabled =
+      settings::SettingsManager::GetBool(settings::SettingId::checkpoint_enabled);
+  auto &log_manager = logging::LogicalLogManager::GetInstance();
+  auto &checkpoint_manager = logging::LogicalCheckpointManager::GetInstance(
+      settings::SettingsManager::GetInt(
+          settings::SettingId::checkpoint_thread_count));
+  if (logging_enabled) {
+    auto log_dirs = StringUtil::Split(
+        settings::SettingsManager::GetString(settings::SettingId::log_directory),
+        ',');
+    logging::LogManagerFactory::Configure(log_dirs.size());
+    log_manager.SetDirectories(log_dirs);
+  }
+  if (checkpoint_enabled) {
+    logging::CheckpointManagerFactory::Configure(
+        settings::SettingsManager::GetInt(
+            settings::SettingId::checkpoint_thread_count));
+    checkpoint_manager.SetDirectory(settings::SettingsManager::GetString(
+        settings::SettingId::checkpoint_directory));
+    checkpoint_manager.SetCheckpointInterval(settings::SettingsManager::GetInt(
+        settings::SettingId::checkpoint_interval));
+  }
+  if (logging_enabled || checkpoint_enabled) {
+    log_manager.DoRecovery(
+        settings::SettingsManager::GetInt(
+            settings::SettingId::log_recovery_thread_count),
+        checkpoint_enabled ? checkpoint_manager.GetDirectory() : "");
+  }
+
+  // start epoch. recovery moves the current epoch past the recovered ones,
+  // so the epoch thread must not advance it concurrently.
+  concurrency::EpochManagerFactory::GetInstance().StartEpoch();
+
+  if (logging_enabled) {
+    log_manager.SetSynchronousCommit(settings::SettingsManager::GetBool(
+        settings::SettingId::log_synchronous_commit));
+    log_manager.StartLogging();
+  }
+  if (checkpoint_enabled) {
+    checkpoint_manager.StartCheckpointing();
+  }
+
   // Initialize the Statement Cache Manager
   StatementCacheManager::Init();
 }
@@ -108,6 +157,18 @@ void PelotonInit::Shutdown() {
     layout_tuner.Stop();
   }
 
+  // shut down checkpointing before logging, since a checkpoint truncates the
+  // log.
+  if (settings::SettingsManager::GetBool(
+          settings::SettingId::checkpoint_enabled)) {
+    logging::CheckpointManagerFactory::GetInstance().StopCheckpointing();
+  }
+
+  // shut down logging. every committed transaction is durable afterwards.
+  if (settings::SettingsManager::GetBool(settings::SettingId::logging_enabled)) {
+    logging::LogManagerFactory::GetInstance().StopLogging();
+  }
+
   // shut down GC.
   gc::GCManagerFactory::GetInstance().StopGC();
 
@@ -2259,6 +2259,9 @@ std::string ProtocolTypeToString(ProtocolType type) {
     case ProtocolType::TIMESTAMP_ORDERING: {
       return "TIMESTAMP_ORDERING";
     }
+    case ProtocolType::OPTIMISTIC: {
+      return "OPTIMISTIC";
+    }
     default: {
       throw ConversionException(
           StringUtil::Format("No string conversion for ProtocolType value '%d'",
@@ -2274,6 +2277,8 @@ ProtocolType StringToProtocolType(const std::string &str) {
     return ProtocolType::INVALID;
   } else if (upper_str == "TIMESTAMP_ORDERING") {
     return ProtocolType::TIMESTAMP_ORDERING;
+  } else if (upper_str == "OPTIMISTIC") {
+    return ProtocolType::OPTIMISTIC;
   } else {
     throw ConversionException(StringUtil::Format(
         "No ProtocolType conversion from string '%s'", upper_str.c_str()));
@@ -12,6 +12,10 @@
 
 #include "concurrency/decentralized_epoch_manager.h"
 
+#include <algorithm>
+
+#include "settings/settings_manager.h"
+
 
 namespace peloton {
 namespace concurrency {
@@ -24,9 +28,11 @@ namespace concurrency {
 
     if (ts_type == TimestampType::SNAPSHOT_READ) {
 
-      local_epochs_.at(thread_id)->EnterEpoch(snapshot_global_epoch_id_, ts_type);
+      eid_t snapshot_epoch_id = snapshot_global_epoch_id_.load();
+
+      local_epochs_.at(thread_id)->EnterEpoch(snapshot_epoch_id, ts_type);
 
-      return (snapshot_global_epoch_id_ << 32) | 0x0;
+      return (snapshot_epoch_id << 32) | 0x0;
 
     } else {
 
@@ -62,6 +68,7 @@ namespace concurrency {
     eid_t global_expired_eid = MAX_EID;
     
     // for all the local epoch contexts, obtain the minimum max committed epoch id.
+    local_epoch_lock_.Lock();
     for (auto &local_epoch_itr : local_epochs_) {
       
       // the centralized epoch manager must notify each local epoch
@@ -72,17 +79,127 @@ namespace concurrency {
         global_expired_eid = local_expired_eid;
       }
     }
+    local_epoch_lock_.Unlock();
 
     // if we observe that global_expired_eid is larger than snapshot_global_epoch,
     // then it means the current thread's progress is too slow.
     // we should directly update it to global_expired_eid + 1.
-    if (global_expired_eid != MAX_EID && 
-        global_expired_eid >= snapshot_global_epoch_id_) {
-      snapshot_global_epoch_id_ = global_expired_eid + 1;
+    eid_t snapshot_epoch_id = snapshot_global_epoch_id_.load();
+    while (global_expired_eid != MAX_EID &&
+           global_expired_eid >= snapshot_epoch_id) {
+      if (snapshot_global_epoch_id_.compare_exchange_weak(
+              snapshot_epoch_id, global_expired_eid + 1)) {
+        break;
+      }
+    }
+
+    if (global_expired_eid != MAX_EID) {
+      expired_global_epoch_id_ = global_expired_eid;
     }
 
     return global_expired_eid;
   }
 
+  uint64_t DecentralizedEpochManager::GetActiveTransactionCount(
+      const eid_t max_epoch_id) {
+    uint64_t txn_count = 0;
+
+    local_epoch_lock_.Lock();
+    for (auto &local_epoch_itr : local_epochs_) {
+      txn_count +=
+          local_epoch_itr.second->GetActiveTransactionCount(max_epoch_id);
+    }
+    local_epoch_lock_.Unlock();
+
+    return txn_count;
+  }
+
+  uint64_t DecentralizedEpochManager::GetEpochLag() {
+    eid_t current_eid = current_global_epoch_id_.load();
+    eid_t expired_eid = expired_global_epoch_id_.load();
+    if (expired_eid >= current_eid) {
+      return 0;
+    }
+    return current_eid - expired_eid;
+  }
+
+  uint64_t DecentralizedEpochManager::GetPersistEpochLag() {
+    eid_t current_eid = current_global_epoch_id_.load();
+    eid_t persist_eid = persist_global_epoch_id_.load();
+    if (persist_eid == INVALID_EID || persist_eid >= current_eid) {
+      return 0;
+    }
+    return current_eid - persist_eid;
+  }
+
+  void DecentralizedEpochManager::AdjustEpochLength(const uint64_t txn_count) {
+    uint64_t min_length =
+        settings::SettingsManager::GetInt(settings::SettingId::min_epoch_length);
+    uint64_t max_length =
+        settings::SettingsManager::GetInt(settings::SettingId::max_epoch_length);
+    uint64_t target_txn_count = settings::SettingsManager::GetInt(
+        settings::SettingId::epoch_target_txn_count);
+
+    if (max_length < min_length) {
+      max_length = min_length;
+    }
+
+    // every epoch is one group commit of the loggers. an epoch that closes
+    // before the previous flush is done only queues up behind it, so while
+    // logging is on the epoch is at least as long as a flush.
+    if (persist_global_epoch_id_.load() != INVALID_EID) {
+      uint64_t flush_length = (epoch_flush_time_us_.load() + 999) / 1000;
+      if (flush_length > min_length) {
+        min_length = std::min(flush_length, max_length);
+      }
+    }
+
+    uint64_t length = max_length;
+    if (target_txn_count != 0 && txn_count != 0) {
+      // the length at which the last epoch would have held the target number
+      // of transactions. move halfway towards it so that a single burst does
+      // not swing the epoch length from one bound to the other.
+      uint64_t current_length = epoch_length_.load();
+      uint64_t ideal_length = current_length * target_txn_count / txn_count;
+      length = (current_length + ideal_length) / 2;
+    }
+
+    if (length < min_length) {
+      length = min_length;
+    } else if (length > max_length) {
+      length = max_length;
+    }
+
+    epoch_length_ = length;
+  }
+
+  void DecentralizedEpochManager::Running() {
+
+    PELOTON_ASSERT(is_running_ == true);
+
+    uint32_t last_txn_id = next_txn_id_.load();
+
+    while (is_running_ == true) {
+      gc::TransactionLevelGCManager::GetInstance().InsertEpochNode(current_global_epoch_id_);
+      // short epochs reclaim garbage sooner under load, while long epochs
+      // keep the epoch thread and the GC threads idle when there is none.
+      std::this_thread::sleep_for(std::chrono::milliseconds(epoch_length_.load()));
+
+      // next_txn_id_ is reset along with the epoch id, e.g. by
+      // SetCurrentEpochId().
+      uint32_t txn_id = next_txn_id_.load();
+      uint64_t txn_count = (txn_id >= last_txn_id) ? txn_id - last_txn_id : txn_id;
+      last_txn_id = txn_id;
+
+      current_global_epoch_id_.fetch_add(1);
+
+      // keep the epoch lag current even if no GC thread asks for it.
+      GetExpiredEpochId();
+
+      epoch_txn_count_ = txn_count;
+      AdjustEpochLength(txn_count);
+    }
+  }
+
 }
 }
\ No newline at end of file
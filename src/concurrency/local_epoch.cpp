@@ -111,5 +111,19 @@ namespace concurrency {
     return ret;
   }
 
+  size_t LocalEpoch::GetActiveTransactionCount(const eid_t max_epoch_id) {
+    size_t txn_count = 0;
+
+    epoch_lock_.Lock();
+    for (auto &epoch_map_itr : epoch_map_) {
+      if (epoch_map_itr.first <= max_epoch_id) {
+        txn_count += epoch_map_itr.second->txn_count_;
+      }
+    }
+    epoch_lock_.Unlock();
+
+    return txn_count;
+  }
+
 }
 }
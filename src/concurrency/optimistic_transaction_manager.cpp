@@ -0,0 +1,137 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// optimistic_transaction_manager.cpp
+//
+// Identification: src/concurrency/optimistic_transaction_manager.cpp
+//
+// Copyright (c) 2015-18, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "concurrency/optimistic_transaction_manager.h"
+
+#include "common/logger.h"
+#include "concurrency/epoch_manager_factory.h"
+#include "concurrency/transaction_context.h"
+#include "gc/transaction_level_gc_manager.h"
+#include "storage/storage_manager.h"
+
+namespace peloton {
+namespace concurrency {
+
+OptimisticTransactionManager &OptimisticTransactionManager::GetInstance(
+    const ProtocolType protocol, const IsolationLevelType isolation,
+    const ConflictAvoidanceType conflict) {
+  static OptimisticTransactionManager txn_manager;
+
+  txn_manager.Init(protocol, isolation, conflict);
+
+  return txn_manager;
+}
+
+bool OptimisticTransactionManager::PerformRead(
+    TransactionContext *const current_txn, const ItemPointer &read_location,
+    storage::TileGroupHeader *tile_group_header, bool acquire_ownership) {
+  // select for update, read-only transactions and the weaker isolation
+  // levels do not write read timestamps either, so they behave as in
+  // timestamp ordering.
+  if (acquire_ownership == true || current_txn->IsReadOnly() ||
+      (current_txn->GetIsolationLevel() != IsolationLevelType::SERIALIZABLE &&
+       current_txn->GetIsolationLevel() !=
+           IsolationLevelType::REPEATABLE_READS)) {
+    return TimestampOrderingTransactionManager::PerformRead(
+        current_txn, read_location, tile_group_header, acquire_ownership);
+  }
+
+  if (current_txn->GetReadFlag() == false &&
+      current_txn->GetWriteFlag() == false) {
+    auto &transaction_level_gc_manager =
+        gc::TransactionLevelGCManager::GetInstance();
+    transaction_level_gc_manager.IncrementEpochNodeRefCount(
+        current_txn->GetEpochId());
+    current_txn->SetReadFlag(true);
+  }
+
+  oid_t tuple_id = read_location.offset;
+
+  LOG_TRACE("PerformRead (%u, %u)\n", read_location.block,
+            read_location.offset);
+
+  if (IsOwner(current_txn, tile_group_header, tuple_id) == true) {
+    // this version must already be in the read/write set.
+    return true;
+  }
+
+  if (IsOwned(current_txn, tile_group_header, tuple_id) == true) {
+    // the tuple is being written by a concurrent transaction,
+    // which would fail the validation anyway.
+    LOG_TRACE("Transaction read failed");
+    return false;
+  }
+
+  // only remember the version. it is validated at commit.
+  current_txn->RecordRead(read_location);
+  return true;
+}
+
+ResultType OptimisticTransactionManager::CommitTransaction(
+    TransactionContext *const current_txn) {
+  if (current_txn->IsReadOnly()) {
+    return TimestampOrderingTransactionManager::CommitTransaction(current_txn);
+  }
+
+  // all the written tuples are owned by now, so the commit id drawn here
+  // orders the transaction after every version it read and before every
+  // write that is not yet visible to the validation.
+  cid_t commit_id = EpochManagerFactory::GetInstance().EnterEpoch(
+      current_txn->GetThreadId(), TimestampType::COMMIT);
+  current_txn->SetCommitId(commit_id);
+
+  if (ValidateReadSet(current_txn) == false) {
+    LOG_TRACE("Validation failed for txn : %" PRId64,
+              current_txn->GetTransactionId());
+    return AbortTransaction(current_txn);
+  }
+
+  return TimestampOrderingTransactionManager::CommitTransaction(current_txn);
+}
+
+bool OptimisticTransactionManager::ValidateReadSet(
+    TransactionContext *const current_txn) {
+  auto storage_manager = storage::StorageManager::GetInstance();
+
+  oid_t last_tile_group_id = INVALID_OID;
+  storage::TileGroupHeader *tile_group_header = nullptr;
+
+  current_txn->SortReadWriteSet();
+
+  for (const auto &tuple_entry : current_txn->GetReadWriteSet()) {
+    if (tuple_entry.second != RWType::READ) {
+      continue;
+    }
+
+    oid_t tile_group_id = tuple_entry.first.block;
+    oid_t tuple_slot = tuple_entry.first.offset;
+
+    if (tile_group_id != last_tile_group_id) {
+      tile_group_header =
+          storage_manager->GetTileGroup(tile_group_id)->GetHeader();
+      last_tile_group_id = tile_group_id;
+    }
+
+    // a concurrent writer either still owns the version, or has already
+    // committed a newer one and set the end commit id of this version
+    // before releasing it.
+    if (tile_group_header->GetTransactionId(tuple_slot) != INITIAL_TXN_ID ||
+        tile_group_header->GetEndCommitId(tuple_slot) != MAX_CID) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+}  // namespace concurrency
+}  // namespace peloton
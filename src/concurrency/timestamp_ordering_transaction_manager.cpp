@@ -23,6 +23,7 @@
 #include "gc/gc_manager_factory.h"
 #include "logging/log_manager_factory.h"
 #include "settings/settings_manager.h"
+#include "storage/zone_map_manager.h"
 #include "concurrency/version_index_manager.h"
 
 namespace peloton {
@@ -31,31 +32,45 @@ namespace concurrency {
 bool TimestampOrderingTransactionManager::SetLastReaderCommitId(
     const storage::TileGroupHeader *const tile_group_header,
     const oid_t &tuple_id, const cid_t &current_cid, const bool is_owner) {
-  // get the pointer to the last_reader_cid field.
+  // the last_reader_cid field only moves forward, so it is maintained with
+  // compare-and-swap instead of the tuple latch. a hot tuple is mostly read
+  // by transactions that are older than its last reader, and these do not
+  // write to the tuple header at all.
   cid_t read_ts = tile_group_header->GetLastReaderCommitId(tuple_id);
 
-  auto &latch = tile_group_header->GetSpinLatch(tuple_id);
+  while (true) {
+    txn_id_t tuple_txn_id = tile_group_header->GetTransactionId(tuple_id);
 
-  latch.Lock();
+    if (is_owner == false && tuple_txn_id != INITIAL_TXN_ID) {
+      // if the write lock has already been acquired by some concurrent
+      // transactions,
+      // then return without setting the last_reader_cid.
+      return false;
+    }
 
-  txn_id_t tuple_txn_id = tile_group_header->GetTransactionId(tuple_id);
+    if (read_ts >= current_cid) {
+      // a newer reader has already protected the tuple.
+      return true;
+    }
 
-  if (is_owner == false && tuple_txn_id != INITIAL_TXN_ID) {
-    // if the write lock has already been acquired by some concurrent
-    // transactions,
-    // then return without setting the last_reader_cid.
-    latch.Unlock();
-    return false;
-  } else {
     // if current_cid is larger than the current value of last_reader_cid field,
     // then set last_reader_cid to current_cid.
-    if (read_ts < current_cid) {
-      tile_group_header->SetLastReaderCommitId(tuple_id, current_cid);
+    // on failure, read_ts is reloaded and the ownership is checked again.
+    if (tile_group_header->UpdateLastReaderCommitId(tuple_id, read_ts,
+                                                    current_cid) == true) {
+      break;
     }
+  }
 
-    latch.Unlock();
+  if (is_owner == true) {
     return true;
   }
+
+  // a writer may have acquired the tuple between the ownership check and the
+  // update. the writer checks last_reader_cid after acquiring the tuple (see
+  // AcquireOwnership), so with sequentially consistent accesses at least one
+  // of the two sees the other. if the writer is still there, the read fails.
+  return tile_group_header->GetTransactionId(tuple_id) == INITIAL_TXN_ID;
 }
 
 TimestampOrderingTransactionManager &
@@ -115,30 +130,29 @@ bool TimestampOrderingTransactionManager::AcquireOwnership(
   // to acquire the ownership,
   // we must guarantee that no transaction that has read
   // the tuple has a larger timestamp than the current transaction.
-  auto &latch = tile_group_header->GetSpinLatch(tuple_id);
-  latch.Lock();
-  // change timestamp
-  cid_t last_reader_cid = tile_group_header->GetLastReaderCommitId(tuple_id);
-
   // must compare last_reader_cid with a transaction's commit_id
   // (rather than read_id).
   // consider a transaction that is executed under snapshot isolation.
   // in this case, commit_id is not equal to read_id.
-  if (last_reader_cid > current_txn->GetCommitId()) {
-    latch.Unlock();
-
+  if (tile_group_header->GetLastReaderCommitId(tuple_id) >
+      current_txn->GetCommitId()) {
     return false;
-  } else {
-    if (tile_group_header->SetAtomicTransactionId(tuple_id, txn_id) == false) {
-      latch.Unlock();
+  }
 
-      return false;
-    } else {
-      latch.Unlock();
+  if (tile_group_header->SetAtomicTransactionId(tuple_id, txn_id) == false) {
+    return false;
+  }
 
-      return true;
-    }
+  // readers update last_reader_cid without a latch, so check it again now
+  // that the tuple is owned. a reader that bumped it before this check
+  // either is seen here, or sees the ownership and fails its read.
+  if (tile_group_header->GetLastReaderCommitId(tuple_id) >
+      current_txn->GetCommitId()) {
+    tile_group_header->SetTransactionId(tuple_id, INITIAL_TXN_ID);
+    return false;
   }
+
+  return true;
 }
 
 void TimestampOrderingTransactionManager::YieldOwnership(
@@ -644,13 +658,17 @@ ResultType TimestampOrderingTransactionManager::CommitTransaction(
   //////////////////////////////////////////////////////////
 
   auto storage_manager = storage::StorageManager::GetInstance();
-  auto &log_manager = logging::LogManager::GetInstance();
-
-  log_manager.StartLogging();
+  auto &log_manager = logging::LogManagerFactory::GetInstance();
 
   // generate transaction id.
   cid_t end_commit_id = current_txn->GetCommitId();
 
+  // records of this transaction go to the current epoch.
+  log_manager.LogBegin(end_commit_id);
+
+  // visit the tile groups in order, one lookup each.
+  current_txn->SortReadWriteSet();
+
   auto &rw_set = current_txn->GetReadWriteSet();
   auto &rw_object_set = current_txn->GetCreateDropSet();
 
@@ -674,6 +692,7 @@ ResultType TimestampOrderingTransactionManager::CommitTransaction(
 
   oid_t last_tile_group_id = INVALID_OID;
   storage::TileGroupHeader *tile_group_header = nullptr;
+  auto zone_map_manager = storage::ZoneMapManager::GetInstance();
 
   for (const auto &tuple_entry : rw_set) {
     ItemPointer item_ptr = tuple_entry.first;
@@ -703,6 +722,12 @@ ResultType TimestampOrderingTransactionManager::CommitTransaction(
       PELOTON_ASSERT(cid > end_commit_id);
       auto new_tile_group_header =
           storage_manager->GetTileGroup(new_version.block)->GetHeader();
+
+      // the zone maps must cover the new version before it becomes visible.
+      if (new_tile_group_header->GetImmutability() == true) {
+        zone_map_manager->WidenZoneMap(new_version);
+      }
+
       new_tile_group_header->SetBeginCommitId(new_version.offset,
                                               end_commit_id);
       new_tile_group_header->SetEndCommitId(new_version.offset, cid);
@@ -720,8 +745,7 @@ ResultType TimestampOrderingTransactionManager::CommitTransaction(
 
       // add old version into gc set.
       // may need to delete versions from secondary indexes.
-      gc_set->operator[](tile_group_id)[tuple_slot] =
-          GCVersionType::COMMIT_UPDATE;
+      gc_set->emplace_back(item_ptr, GCVersionType::COMMIT_UPDATE);
 
       log_manager.LogUpdate(new_version);
 
@@ -753,14 +777,19 @@ ResultType TimestampOrderingTransactionManager::CommitTransaction(
       // we require the GC to delete tuple from index only once.
       // recycle old version, delete from index
       // the gc should be responsible for recycling the newer empty version.
-      gc_set->operator[](tile_group_id)[tuple_slot] =
-          GCVersionType::COMMIT_DELETE;
+      gc_set->emplace_back(item_ptr, GCVersionType::COMMIT_DELETE);
 
       log_manager.LogDelete(ItemPointer(tile_group_id, tuple_slot));
 
     } else if (tuple_entry.second == RWType::INSERT) {
       PELOTON_ASSERT(tile_group_header->GetTransactionId(tuple_slot) ==
                      current_txn->GetTransactionId());
+
+      // the zone maps must cover the new version before it becomes visible.
+      if (tile_group_header->GetImmutability() == true) {
+        zone_map_manager->WidenZoneMap(item_ptr);
+      }
+
       // set the begin commit id to persist insert
       tile_group_header->SetBeginCommitId(tuple_slot, end_commit_id);
       tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
@@ -788,8 +817,7 @@ ResultType TimestampOrderingTransactionManager::CommitTransaction(
       tile_group_header->SetTransactionId(tuple_slot, INVALID_TXN_ID);
 
       // add to gc set.
-      gc_set->operator[](tile_group_id)[tuple_slot] =
-          GCVersionType::COMMIT_INS_DEL;
+      gc_set->emplace_back(item_ptr, GCVersionType::COMMIT_INS_DEL);
 
       // no log is needed for this case
     }
@@ -817,6 +845,9 @@ ResultType TimestampOrderingTransactionManager::AbortTransaction(
   LOG_TRACE("Aborting peloton txn : %" PRId64, current_txn->GetTransactionId());
   auto storage_manager = storage::StorageManager::GetInstance();
 
+  // visit the tile groups in order, one lookup each.
+  current_txn->SortReadWriteSet();
+
   auto &rw_set = current_txn->GetReadWriteSet();
   auto &rw_object_set = current_txn->GetCreateDropSet();
 
@@ -900,8 +931,7 @@ ResultType TimestampOrderingTransactionManager::AbortTransaction(
       // add the version to gc set.
       // this version has already been unlinked from the version chain.
       // however, the gc should further unlink it from indexes.
-      gc_set->operator[](new_version.block)[new_version.offset] =
-          GCVersionType::ABORT_UPDATE;
+      gc_set->emplace_back(new_version, GCVersionType::ABORT_UPDATE);
 
     } else if (tuple_entry.second == RWType::DELETE) {
       ItemPointer new_version =
@@ -946,8 +976,7 @@ ResultType TimestampOrderingTransactionManager::AbortTransaction(
       tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
 
       // add the version to gc set.
-      gc_set->operator[](new_version.block)[new_version.offset] =
-          GCVersionType::ABORT_DELETE;
+      gc_set->emplace_back(new_version, GCVersionType::ABORT_DELETE);
 
     } else if (tuple_entry.second == RWType::INSERT) {
       tile_group_header->SetBeginCommitId(tuple_slot, MAX_CID);
@@ -960,8 +989,7 @@ ResultType TimestampOrderingTransactionManager::AbortTransaction(
 
       // add the version to gc set.
       // delete from index.
-      gc_set->operator[](tile_group_id)[tuple_slot] =
-          GCVersionType::ABORT_INSERT;
+      gc_set->emplace_back(item_ptr, GCVersionType::ABORT_INSERT);
 
     } else if (tuple_entry.second == RWType::INS_DEL) {
       tile_group_header->SetBeginCommitId(tuple_slot, MAX_CID);
@@ -973,8 +1001,7 @@ ResultType TimestampOrderingTransactionManager::AbortTransaction(
       tile_group_header->SetTransactionId(tuple_slot, INVALID_TXN_ID);
 
       // add to gc set.
-      gc_set->operator[](tile_group_id)[tuple_slot] =
-          GCVersionType::ABORT_INS_DEL;
+      gc_set->emplace_back(item_ptr, GCVersionType::ABORT_INS_DEL);
     }
   }
 
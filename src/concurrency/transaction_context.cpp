@@ -80,56 +80,94 @@ void TransactionContext::Init(const size_t thread_id,
 
   isolation_level_ = isolation;
 
-  gc_set_ = std::make_shared<GCSet>();
-  gc_object_set_ = std::make_shared<GCObjectSet>();
+  // a reused context was cleared when it was released.
+  if (gc_object_set_ == nullptr) {
+    gc_object_set_ = std::make_shared<GCObjectSet>();
+  }
+}
 
+void TransactionContext::Clear() {
+  rw_set_.Clear();
+  rw_object_set_.clear();
+  gc_set_.clear();
+  gc_object_set_->clear();
+  query_strings_.clear();
+  catalog_cache.Clear();
   on_commit_triggers_.reset();
+
+  result_ = ResultType::SUCCESS;
+  read_only_ = false;
+  read_flag_ = false;
+  write_flag_ = false;
 }
 
 RWType TransactionContext::GetRWType(const ItemPointer &location) {
-  const auto rw_set_it = rw_set_.find(location);
-  if (rw_set_it != rw_set_.end()) {
-    return rw_set_it->second;
+  RWType rw_type = RWType::INVALID;
+  rw_set_latch_.Lock();
+  const RWType *existing = rw_set_.Find(location);
+  if (existing != nullptr) {
+    rw_type = *existing;
   }
-  return RWType::INVALID;
+  rw_set_latch_.Unlock();
+  return rw_type;
+}
+
+void TransactionContext::RecordRead(const ItemPointer &location) {
+  rw_set_latch_.Lock();
+  // a read never downgrades an entry that is already in the set.
+  if (rw_set_.Find(location) == nullptr) {
+    rw_set_.Set(location, RWType::READ);
+  }
+  rw_set_latch_.Unlock();
 }
 
 void TransactionContext::RecordReadOwn(const ItemPointer &location) {
-  PELOTON_ASSERT(rw_set_.find(location) == rw_set_.end() ||
-                 (rw_set_[location] != RWType::DELETE &&
-                  rw_set_[location] != RWType::INS_DEL));
-  rw_set_[location] = RWType::READ_OWN;
+  rw_set_latch_.Lock();
+  PELOTON_ASSERT(rw_set_.Find(location) == nullptr ||
+                 (*rw_set_.Find(location) != RWType::DELETE &&
+                  *rw_set_.Find(location) != RWType::INS_DEL));
+  rw_set_.Set(location, RWType::READ_OWN);
+  rw_set_latch_.Unlock();
   is_written_ = true;
 }
 
 void TransactionContext::RecordUpdate(const ItemPointer &location) {
-  PELOTON_ASSERT(rw_set_.find(location) == rw_set_.end() ||
-                 (rw_set_[location] != RWType::DELETE &&
-                  rw_set_[location] != RWType::INS_DEL));
-  rw_set_[location] = RWType::UPDATE;
+  rw_set_latch_.Lock();
+  PELOTON_ASSERT(rw_set_.Find(location) == nullptr ||
+                 (*rw_set_.Find(location) != RWType::DELETE &&
+                  *rw_set_.Find(location) != RWType::INS_DEL));
+  rw_set_.Set(location, RWType::UPDATE);
+  rw_set_latch_.Unlock();
   is_written_ = true;
 }
 
 void TransactionContext::RecordInsert(const ItemPointer &location) {
-  PELOTON_ASSERT(rw_set_.find(location) == rw_set_.end());
-  rw_set_[location] = RWType::INSERT;
+  rw_set_latch_.Lock();
+  PELOTON_ASSERT(rw_set_.Find(location) == nullptr);
+  rw_set_.Set(location, RWType::INSERT);
+  rw_set_latch_.Unlock();
   is_written_ = true;
 }
 
 bool TransactionContext::RecordDelete(const ItemPointer &location) {
-  PELOTON_ASSERT(rw_set_.find(location) == rw_set_.end() ||
-                 (rw_set_[location] != RWType::DELETE &&
-                  rw_set_[location] != RWType::INS_DEL));
-  auto rw_set_it = rw_set_.find(location);
-  if (rw_set_it != rw_set_.end() && rw_set_it->second == RWType::INSERT) {
+  bool ins_del;
+  rw_set_latch_.Lock();
+  RWType *rw_type = rw_set_.Find(location);
+  PELOTON_ASSERT(rw_type == nullptr ||
+                 (*rw_type != RWType::DELETE && *rw_type != RWType::INS_DEL));
+  if (rw_type != nullptr && *rw_type == RWType::INSERT) {
     PELOTON_ASSERT(is_written_);
-    rw_set_it->second = RWType::INS_DEL;
-    return true;
+    *rw_type = RWType::INS_DEL;
+    ins_del = true;
   } else {
-    rw_set_[location] = RWType::DELETE;
+    rw_set_.Set(location, RWType::DELETE);
+    ins_del = false;
+  }
+  rw_set_latch_.Unlock();
+  if (ins_del == false) {
     is_written_ = true;
-    return false;
   }
+  return ins_del;
 }
 
 const std::string TransactionContext::GetInfo() const {
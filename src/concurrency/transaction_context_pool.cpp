@@ -0,0 +1,99 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// transaction_context_pool.cpp
+//
+// Identification: src/concurrency/transaction_context_pool.cpp
+//
+// Copyright (c) 2015-18, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "concurrency/transaction_context_pool.h"
+
+#include <vector>
+
+#include "concurrency/transaction_context.h"
+#include "trigger/trigger.h"
+
+namespace peloton {
+namespace concurrency {
+
+namespace {
+
+// Number of contexts a thread keeps for itself
+const size_t kLocalPoolSize = 16;
+
+// Number of contexts kept in the shared queue. Contexts beyond it are freed
+const size_t kSharedPoolSize = 1024;
+
+// Contexts released by the current thread
+struct LocalContextPool {
+  ~LocalContextPool() {
+    for (auto txn : contexts) {
+      delete txn;
+    }
+  }
+
+  std::vector<TransactionContext *> contexts;
+};
+
+thread_local LocalContextPool tl_context_pool;
+
+}  // namespace
+
+TransactionContextPool &TransactionContextPool::GetInstance() {
+  static TransactionContextPool pool;
+  return pool;
+}
+
+TransactionContextPool::TransactionContextPool()
+    : shared_contexts_(kSharedPoolSize), shared_context_count_(0) {}
+
+TransactionContext *TransactionContextPool::Acquire(
+    const size_t thread_id, const IsolationLevelType isolation,
+    const cid_t &read_id, const cid_t &commit_id) {
+  TransactionContext *txn = nullptr;
+
+  auto &local_contexts = tl_context_pool.contexts;
+  if (local_contexts.empty() == false) {
+    txn = local_contexts.back();
+    local_contexts.pop_back();
+  } else if (shared_contexts_.Dequeue(txn) == true) {
+    shared_context_count_.fetch_sub(1, std::memory_order_relaxed);
+  } else {
+    return new TransactionContext(thread_id, isolation, read_id, commit_id);
+  }
+
+  txn->Init(thread_id, isolation, read_id, commit_id);
+  return txn;
+}
+
+void TransactionContextPool::Release(TransactionContext *txn) {
+  auto &local_contexts = tl_context_pool.contexts;
+  if (local_contexts.size() >= kLocalPoolSize) {
+    ReleaseShared(txn);
+    return;
+  }
+
+  txn->Clear();
+  local_contexts.push_back(txn);
+}
+
+void TransactionContextPool::ReleaseShared(TransactionContext *txn) {
+  if (shared_context_count_.load(std::memory_order_relaxed) >=
+      kSharedPoolSize) {
+    delete txn;
+    return;
+  }
+
+  // the context is cleared by the releasing thread, off the critical path
+  // of the thread that reuses it.
+  txn->Clear();
+  shared_context_count_.fetch_add(1, std::memory_order_relaxed);
+  shared_contexts_.Enqueue(txn);
+}
+
+}  // namespace concurrency
+}  // namespace peloton
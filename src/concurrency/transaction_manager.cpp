@@ -12,8 +12,12 @@
 
 #include "concurrency/transaction_manager.h"
 
+#include <chrono>
+#include <thread>
+
 #include "catalog/manager.h"
 #include "concurrency/transaction_context.h"
+#include "concurrency/transaction_context_pool.h"
 #include "function/date_functions.h"
 #include "gc/gc_manager_factory.h"
 #include "logging/log_manager.h"
@@ -41,13 +45,16 @@ TransactionContext *TransactionManager::BeginTransaction(
     cid_t read_id = EpochManagerFactory::GetInstance().EnterEpoch(
         thread_id, TimestampType::SNAPSHOT_READ);
 
-    if (protocol_ == ProtocolType::TIMESTAMP_ORDERING) {
+    if (protocol_ == ProtocolType::TIMESTAMP_ORDERING ||
+        protocol_ == ProtocolType::OPTIMISTIC) {
       cid_t commit_id = EpochManagerFactory::GetInstance().EnterEpoch(
           thread_id, TimestampType::COMMIT);
 
-      txn = new TransactionContext(thread_id, type, read_id, commit_id);
+      txn = TransactionContextPool::GetInstance().Acquire(thread_id, type,
+                                                         read_id, commit_id);
     } else {
-      txn = new TransactionContext(thread_id, type, read_id);
+      txn = TransactionContextPool::GetInstance().Acquire(thread_id, type,
+                                                         read_id);
     }
 
   } else {
@@ -58,7 +65,8 @@ TransactionContext *TransactionManager::BeginTransaction(
     // transaction processing with decentralized epoch manager
     cid_t read_id = EpochManagerFactory::GetInstance().EnterEpoch(
         thread_id, TimestampType::READ);
-    txn = new TransactionContext(thread_id, type, read_id);
+    txn = TransactionContextPool::GetInstance().Acquire(thread_id, type,
+                                                        read_id);
   }
 
   if (read_only) {
@@ -89,7 +97,7 @@ void TransactionManager::EndTransaction(TransactionContext *current_txn) {
   if (gc::GCManagerFactory::GetGCType() == GarbageCollectionType::ON) {
     gc::GCManagerFactory::GetInstance().RecycleTransaction(current_txn);
   } else {
-    delete current_txn;
+    TransactionContextPool::GetInstance().Release(current_txn);
   }
 
   current_txn = nullptr;
@@ -167,6 +175,31 @@ bool TransactionManager::IsOccupied(TransactionContext *const current_txn,
   }
 }
 
+bool TransactionManager::WaitForOlderTransactions(
+    TransactionContext *const current_txn, const size_t timeout_ms) {
+  auto &epoch_manager = EpochManagerFactory::GetInstance();
+
+  // every transaction that began so far entered an epoch up to this one. the
+  // current transaction is one of them.
+  eid_t epoch_id = epoch_manager.GetCurrentEpochId();
+  auto deadline =
+      std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+  while (epoch_manager.GetActiveTransactionCount(epoch_id) > 1) {
+    if (std::chrono::steady_clock::now() > deadline) {
+      LOG_TRACE("Transactions older than epoch %lu are still running",
+                (unsigned long)epoch_id);
+      return false;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  // a new timestamp is larger than that of any transaction that has
+  // finished above.
+  current_txn->SetReadId(epoch_manager.EnterEpoch(current_txn->GetThreadId(),
+                                                  TimestampType::COMMIT));
+  return true;
+}
+
 // this function checks whether a version is visible to current transaction.
 VisibilityType TransactionManager::IsVisible(
     TransactionContext *const current_txn,
@@ -15,6 +15,7 @@
 #include "catalog/catalog.h"
 #include "catalog/system_catalogs.h"
 #include "concurrency/transaction_context.h"
+#include "concurrency/transaction_manager_factory.h"
 #include "executor/executor_context.h"
 #include "planner/create_plan.h"
 #include "storage/database.h"
@@ -24,6 +25,9 @@
 namespace peloton {
 namespace executor {
 
+// How long building an index waits for older transactions to finish
+static const size_t kIndexBuildWaitTimeoutMs = 10000;
+
 // Constructor for drop executor
 CreateExecutor::CreateExecutor(const planner::AbstractPlan *node,
                                ExecutorContext *executor_context)
@@ -274,6 +278,8 @@ bool CreateExecutor::CreateIndex(const planner::CreatePlan &node) {
 
   auto key_attrs = node.GetKeyAttrs();
 
+  // The index is created as not valid and populated by the PopulateIndex
+  // executor above us, which marks it valid once it is built
   ResultType result = catalog::Catalog::GetInstance()->CreateIndex(txn,
                                                                    database_name,
                                                                    schema_name,
@@ -281,7 +287,19 @@ bool CreateExecutor::CreateIndex(const planner::CreatePlan &node) {
                                                                    index_name,
                                                                    key_attrs,
                                                                    unique_flag,
-                                                                   index_type);
+                                                                   index_type,
+                                                                   false);
+
+  // Writers that inserted into the table before the index was added did not
+  // buffer their changes for it. Wait for them to finish, so that the scan
+  // feeding the PopulateIndex executor reads what they committed
+  if (result == ResultType::SUCCESS &&
+      concurrency::TransactionManagerFactory::GetInstance()
+              .WaitForOlderTransactions(txn, kIndexBuildWaitTimeoutMs) ==
+          false) {
+    LOG_TRACE("Older transactions are still running, giving up the build");
+    result = ResultType::FAILURE;
+  }
   txn->SetResult(result);
 
   if (txn->GetResult() == ResultType::SUCCESS) {
@@ -12,8 +12,11 @@
 
 #include "executor/index_scan_executor.h"
 
+#include <algorithm>
+
 #include "catalog/catalog.h"
 #include "catalog/manager.h"
+#include "catalog/schema.h"
 #include "common/container_tuple.h"
 #include "common/internal_types.h"
 #include "common/logger.h"
@@ -27,9 +30,11 @@
 #include "planner/index_scan_plan.h"
 #include "storage/data_table.h"
 #include "storage/masked_tuple.h"
+#include "storage/tile.h"
 #include "storage/tile_group.h"
 #include "storage/tile_group_header.h"
 #include "storage/storage_manager.h"
+#include "storage/tuple.h"
 #include "type/value.h"
 
 namespace peloton {
@@ -81,6 +86,13 @@ bool IndexScanExecutor::DInit() {
   limit_offset_ = node.GetLimitOffset();
   descend_ = node.GetDescend();
 
+  // The index-only lookup relies on the predicate to drop the boundaries of
+  // open ranges, and does not know about limits or IN lists
+  index_only_ = node.IsIndexOnly() && !limit_ && !column_ids_.empty() &&
+                (predicate_ != nullptr || (!left_open_ && !right_open_)) &&
+                std::find(expr_types_.begin(), expr_types_.end(),
+                          ExpressionType::COMPARE_IN) == expr_types_.end();
+
   if (runtime_keys_.size() != 0) {
     PELOTON_ASSERT(runtime_keys_.size() == values_.size());
 
@@ -128,7 +140,10 @@ bool IndexScanExecutor::DExecute() {
   LOG_TRACE("Index Scan executor :: 0 child");
 
   if (!done_) {
-    if (index_->GetIndexType() == IndexConstraintType::PRIMARY_KEY) {
+    if (index_only_) {
+      auto status = ExecIndexOnlyLookup();
+      if (status == false) return false;
+    } else if (index_->GetIndexType() == IndexConstraintType::PRIMARY_KEY) {
       auto status = ExecPrimaryIndexLookup();
       if (status == false) return false;
     } else {
@@ -167,6 +182,8 @@ bool IndexScanExecutor::ExecPrimaryIndexLookup() {
 
   if (0 == key_column_ids_.size()) {
     index_->ScanAllKeys(tuple_location_ptrs);
+  } else if (!limit_ && ExecInListLookup(tuple_location_ptrs)) {
+    LOG_TRACE("IN list lookup in Primary Index");
   } else {
     // Limit clause accelerate
     if (limit_) {
@@ -418,6 +435,8 @@ bool IndexScanExecutor::ExecSecondaryIndexLookup() {
 
   if (0 == key_column_ids_.size()) {
     index_->ScanAllKeys(tuple_location_ptrs);
+  } else if (!limit_ && ExecInListLookup(tuple_location_ptrs)) {
+    LOG_TRACE("IN list lookup in Secondary Index");
   } else {
     // Limit clause accelerate
     if (limit_) {
@@ -685,6 +704,336 @@ bool IndexScanExecutor::ExecSecondaryIndexLookup() {
   return true;
 }
 
+bool IndexScanExecutor::ExecInListLookup(
+    std::vector<ItemPointer *> &tuple_location_ptrs) {
+  const std::vector<oid_t> &tuple_to_index_map =
+      index_->GetMetadata()->GetTupleToIndexMapping();
+  const catalog::Schema *key_schema = index_->GetKeySchema();
+  const oid_t key_column_count = key_schema->GetColumnCount();
+
+  // The values bound to each index key column, and how the column is bound.
+  // The optimizer emits one IN entry per element of a list, and an IN list
+  // on a column that also has an = predicate is dropped before it gets here
+  std::vector<std::vector<type::Value>> column_values(key_column_count);
+  std::vector<ExpressionType> column_bound(key_column_count,
+                                           ExpressionType::INVALID);
+  bool has_in_list = false;
+
+  for (oid_t i = 0; i < key_column_ids_.size(); i++) {
+    oid_t index_column_id = tuple_to_index_map[key_column_ids_[i]];
+    if (index_column_id >= key_column_count) {
+      return false;
+    }
+
+    ExpressionType &bound = column_bound[index_column_id];
+    const type::Value &value = values_[i];
+    if (expr_types_[i] == ExpressionType::COMPARE_EQUAL &&
+        bound == ExpressionType::INVALID) {
+      column_values[index_column_id].push_back(value);
+    } else if (expr_types_[i] == ExpressionType::COMPARE_IN &&
+               bound != ExpressionType::COMPARE_EQUAL) {
+      if (value.GetTypeId() == type::TypeId::ARRAY) {
+        for (uint64_t j = 0; j < value.GetElementCount(); j++) {
+          column_values[index_column_id].push_back(value.GetElementAt(j));
+        }
+      } else {
+        column_values[index_column_id].push_back(value);
+      }
+      has_in_list = true;
+    } else {
+      return false;
+    }
+    bound = expr_types_[i];
+  }
+
+  if (has_in_list == false ||
+      std::find(column_bound.begin(), column_bound.end(),
+                ExpressionType::INVALID) != column_bound.end()) {
+    return false;
+  }
+
+  // Sort and deduplicate the values of every column, so that enumerating
+  // their combinations produces keys in ascending key order
+  for (auto &values : column_values) {
+    if (values.empty()) {
+      // IN () matches nothing
+      return true;
+    }
+    std::sort(values.begin(), values.end(),
+              [](const type::Value &lhs, const type::Value &rhs) {
+                return lhs.CompareLessThan(rhs) == CmpBool::CmpTrue;
+              });
+    values.erase(std::unique(values.begin(), values.end(),
+                             [](const type::Value &lhs,
+                                const type::Value &rhs) {
+                               return lhs.CompareEquals(rhs) ==
+                                      CmpBool::CmpTrue;
+                             }),
+                 values.end());
+  }
+
+  std::vector<std::unique_ptr<storage::Tuple>> keys;
+  std::vector<const storage::Tuple *> key_ptrs;
+  std::vector<size_t> positions(key_column_count, 0);
+  auto pool = executor_context_->GetPool();
+  while (true) {
+    keys.emplace_back(new storage::Tuple(key_schema, true));
+    for (oid_t column_id = 0; column_id < key_column_count; column_id++) {
+      keys.back()->SetValue(column_id,
+                            column_values[column_id][positions[column_id]],
+                            pool);
+    }
+    key_ptrs.push_back(keys.back().get());
+
+    // Advance the last column first, like an odometer
+    oid_t column_id = key_column_count;
+    while (column_id > 0 && ++positions[column_id - 1] ==
+                                column_values[column_id - 1].size()) {
+      positions[column_id - 1] = 0;
+      column_id--;
+    }
+    if (column_id == 0) {
+      break;
+    }
+  }
+
+  LOG_TRACE("IN list lookup of %lu keys", key_ptrs.size());
+
+  std::vector<std::vector<ItemPointer *>> results;
+  index_->ScanKeyBatch(key_ptrs, results);
+  for (const auto &result : results) {
+    tuple_location_ptrs.insert(tuple_location_ptrs.end(), result.begin(),
+                               result.end());
+  }
+
+  return true;
+}
+
+bool IndexScanExecutor::ExecIndexOnlyLookup() {
+  PELOTON_ASSERT(!done_);
+
+  std::vector<ItemPointer *> tuple_location_ptrs;
+  std::vector<std::unique_ptr<storage::Tuple>> keys;
+  if (index_->ScanWithKeys(values_, key_column_ids_, expr_types_,
+                           tuple_location_ptrs, keys,
+                           &index_predicate_.GetConjunctionList()[0]) ==
+      false) {
+    LOG_TRACE("Index %s can not hand back its keys",
+              index_->GetName().c_str());
+    index_only_ = false;
+    if (index_->GetIndexType() == IndexConstraintType::PRIMARY_KEY) {
+      return ExecPrimaryIndexLookup();
+    }
+    return ExecSecondaryIndexLookup();
+  }
+  PELOTON_ASSERT(keys.size() == tuple_location_ptrs.size());
+
+  if (tuple_location_ptrs.size() == 0) {
+    LOG_TRACE("no tuple is retrieved from index.");
+    return false;
+  }
+
+  auto &transaction_manager =
+      concurrency::TransactionManagerFactory::GetInstance();
+  auto current_txn = executor_context_->GetTransaction();
+  auto storage_manager = storage::StorageManager::GetInstance();
+
+  // The predicate refers to table columns, which are mapped to key columns
+  const std::vector<oid_t> &tuple_to_key_map =
+      index_->GetMetadata()->GetTupleToIndexMapping();
+  const std::vector<oid_t> &indexed_columns =
+      index_->GetKeySchema()->GetIndexedColumns();
+
+  // The visible tuples in index order. A tuple is read from its key if one
+  // is given, and from the table otherwise
+  std::vector<ItemPointer> visible_tuple_locations;
+  std::vector<const storage::Tuple *> visible_tuple_keys;
+
+#ifdef LOG_TRACE_ENABLED
+  int num_tuples_from_keys = 0;
+#endif
+
+  for (size_t i = 0; i < tuple_location_ptrs.size(); i++) {
+    ItemPointer tuple_location = *tuple_location_ptrs[i];
+    auto tile_group = storage_manager->GetTileGroup(tuple_location.block);
+    auto tile_group_header = tile_group->GetHeader();
+
+    if (tile_group_header->IsVisibleToAll(tuple_location.offset,
+                                          tuple_location_ptrs[i])) {
+      // The tuple is the only version of its row, so its key is up to date
+      storage::MaskedTuple key_tuple(keys[i].get(), tuple_to_key_map);
+      if (predicate_ != nullptr &&
+          predicate_->Evaluate(&key_tuple, nullptr, executor_context_)
+                  .IsTrue() == false) {
+        continue;
+      }
+      if (transaction_manager.PerformRead(current_txn, tuple_location,
+                                          tile_group_header, false) == false) {
+        transaction_manager.SetTransactionResult(current_txn,
+                                                 ResultType::FAILURE);
+        return false;
+      }
+      visible_tuple_locations.push_back(tuple_location);
+      visible_tuple_keys.push_back(keys[i].get());
+#ifdef LOG_TRACE_ENABLED
+      num_tuples_from_keys++;
+#endif
+      continue;
+    }
+
+    if (FindVisibleVersion(tuple_location) == false) {
+      if (current_txn->GetResult() == ResultType::FAILURE) {
+        return false;
+      }
+      continue;
+    }
+    tile_group = storage_manager->GetTileGroup(tuple_location.block);
+    tile_group_header = tile_group->GetHeader();
+    ContainerTuple<storage::TileGroup> tuple(tile_group.get(),
+                                             tuple_location.offset);
+
+    // Skip entries of other versions of the row, which have other keys
+    bool key_matched = true;
+    for (oid_t column_id = 0; column_id < indexed_columns.size();
+         column_id++) {
+      if (tuple.GetValue(indexed_columns[column_id])
+              .CompareNotEquals(keys[i]->GetValue(column_id)) ==
+          CmpBool::CmpTrue) {
+        key_matched = false;
+        break;
+      }
+    }
+    if (key_matched == false ||
+        (predicate_ != nullptr &&
+         predicate_->Evaluate(&tuple, nullptr, executor_context_).IsTrue() ==
+             false)) {
+      continue;
+    }
+    if (transaction_manager.PerformRead(current_txn, tuple_location,
+                                        tile_group_header, false) == false) {
+      transaction_manager.SetTransactionResult(current_txn,
+                                               ResultType::FAILURE);
+      return false;
+    }
+    visible_tuple_locations.push_back(tuple_location);
+    visible_tuple_keys.push_back(nullptr);
+  }
+  LOG_TRACE("%d of %lu tuples are read from the keys of index %s",
+            num_tuples_from_keys, visible_tuple_locations.size(),
+            index_->GetName().c_str());
+
+  // Tuples read from the keys are copied into temporary tiles. Consecutive
+  // tuples from the same source share a logical tile, which keeps the order
+  // of the index
+  std::unique_ptr<catalog::Schema> output_schema(
+      catalog::Schema::CopySchema(table_->GetSchema(), column_ids_));
+  size_t run_start = 0;
+  while (run_start < visible_tuple_locations.size()) {
+    size_t run_end = run_start + 1;
+    if (visible_tuple_keys[run_start] != nullptr) {
+      while (run_end < visible_tuple_locations.size() &&
+             visible_tuple_keys[run_end] != nullptr) {
+        run_end++;
+      }
+
+      std::shared_ptr<storage::Tile> tile(storage::TileFactory::GetTempTile(
+          *output_schema, run_end - run_start));
+      for (size_t i = run_start; i < run_end; i++) {
+        for (oid_t column_id = 0; column_id < column_ids_.size();
+             column_id++) {
+          tile->SetValue(visible_tuple_keys[i]->GetValue(
+                             tuple_to_key_map[column_ids_[column_id]]),
+                         i - run_start, column_id);
+        }
+      }
+      result_.push_back(LogicalTileFactory::WrapTiles({tile}));
+    } else {
+      oid_t tile_group_oid = visible_tuple_locations[run_start].block;
+      while (run_end < visible_tuple_locations.size() &&
+             visible_tuple_keys[run_end] == nullptr &&
+             visible_tuple_locations[run_end].block == tile_group_oid) {
+        run_end++;
+      }
+
+      std::vector<oid_t> tuples;
+      for (size_t i = run_start; i < run_end; i++) {
+        tuples.push_back(visible_tuple_locations[i].offset);
+      }
+      auto tile_group = storage_manager->GetTileGroup(tile_group_oid);
+      std::unique_ptr<LogicalTile> logical_tile(LogicalTileFactory::GetTile());
+      logical_tile->AddColumns(tile_group, full_column_ids_);
+      logical_tile->AddPositionList(std::move(tuples));
+      logical_tile->ProjectColumns(full_column_ids_, column_ids_);
+      result_.push_back(logical_tile.release());
+    }
+    run_start = run_end;
+  }
+
+  done_ = true;
+
+  LOG_TRACE("Result tiles : %lu", result_.size());
+
+  return true;
+}
+
+bool IndexScanExecutor::FindVisibleVersion(ItemPointer &tuple_location) {
+  auto &transaction_manager =
+      concurrency::TransactionManagerFactory::GetInstance();
+  auto current_txn = executor_context_->GetTransaction();
+  auto storage_manager = storage::StorageManager::GetInstance();
+
+  auto tile_group = storage_manager->GetTileGroup(tuple_location.block);
+  auto tile_group_header = tile_group->GetHeader();
+
+  auto version_index_manager = concurrency::VersionIndexManager::GetInstance();
+  ItemPointer versioned_location = version_index_manager->GetVisibleVersion(
+      tile_group_header->GetIndirection(tuple_location.offset), current_txn);
+  if (!versioned_location.IsNull()) {
+    tuple_location = versioned_location;
+    return true;
+  }
+
+  size_t chain_length = 0;
+  while (true) {
+    ++chain_length;
+
+    auto visibility = transaction_manager.IsVisible(
+        current_txn, tile_group_header, tuple_location.offset);
+    if (visibility == VisibilityType::DELETED) {
+      return false;
+    } else if (visibility == VisibilityType::OK) {
+      return true;
+    }
+    PELOTON_ASSERT(visibility == VisibilityType::INVISIBLE);
+
+    bool is_acquired = (tile_group_header->GetTransactionId(
+                            tuple_location.offset) == INITIAL_TXN_ID);
+    bool is_alive = (tile_group_header->GetEndCommitId(tuple_location.offset) <=
+                     current_txn->GetReadId());
+    if (is_acquired && is_alive) {
+      // Some other transaction has modified the version chain, search from
+      // its head again
+      tuple_location =
+          *(tile_group_header->GetIndirection(tuple_location.offset));
+      chain_length = 0;
+    } else {
+      tuple_location =
+          tile_group_header->GetNextItemPointer(tuple_location.offset);
+      if (tuple_location.IsNull()) {
+        // Only an aborted version may have no visible version in its chain
+        if (chain_length != 1) {
+          transaction_manager.SetTransactionResult(current_txn,
+                                                   ResultType::FAILURE);
+        }
+        return false;
+      }
+    }
+
+    tile_group = storage_manager->GetTileGroup(tuple_location.block);
+    tile_group_header = tile_group->GetHeader();
+  }
+}
+
 void IndexScanExecutor::CheckOpenRangeWithReturnedTuples(
     std::vector<ItemPointer> &tuple_locations) {
   while (left_open_) {
@@ -746,6 +1095,15 @@ bool IndexScanExecutor::CheckKeyConditions(const ItemPointer &tuple_location) {
     // Possible results of comparison are: EQ, >, <
     const ExpressionType expr_type = expr_types_[i];
 
+    // An IN list is an array value, look the tuple value up in it
+    if (expr_type == ExpressionType::COMPARE_IN &&
+        rhs.GetTypeId() == type::TypeId::ARRAY) {
+      if (rhs.InList(lhs).IsTrue()) {
+        continue;
+      }
+      return false;
+    }
+
     // If the operation is IN, then use the boolean values comparator
     // that determines whether a value is in a list
     //
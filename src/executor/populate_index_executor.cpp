@@ -10,15 +10,23 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
+
+#include "catalog/catalog.h"
 #include "common/logger.h"
 #include "type/value.h"
+#include "concurrency/transaction_manager_factory.h"
 #include "executor/logical_tile.h"
 #include "executor/populate_index_executor.h"
 #include "executor/executor_context.h"
+#include "index/index.h"
 #include "planner/populate_index_plan.h"
 #include "expression/tuple_value_expression.h"
 #include "storage/data_table.h"
 #include "storage/tile.h"
+#include "storage/tile_group.h"
+#include "storage/tile_group_header.h"
+#include "util/parallel_util.h"
 
 namespace peloton {
 namespace executor {
@@ -52,47 +60,122 @@ bool PopulateIndexExecutor::DExecute() {
   LOG_TRACE("Populate Index Executor");
   PELOTON_ASSERT(executor_context_ != nullptr);
   auto current_txn = executor_context_->GetTransaction();
-  auto executor_pool = executor_context_->GetPool();
   if (done_ == false) {
     //Get the output from seq_scan
     while (children_[0]->Execute()) {
       child_tiles_.emplace_back(children_[0]->GetOutput());
     }
 
-    if (child_tiles_.size() == 0) {
-      LOG_TRACE("PopulateIndex Executor : false -- no child tiles ");
-      return false;
+    // The index to populate is the one created by our child, i.e. the
+    // latest index on exactly these columns. Other indexes of the table
+    // already hold every tuple
+    std::shared_ptr<index::Index> target_index;
+    for (int index_itr = target_table_->GetIndexCount() - 1; index_itr >= 0;
+         --index_itr) {
+      auto index = target_table_->GetIndex(index_itr);
+      if (index != nullptr &&
+          index->GetMetadata()->GetKeyAttrs() == column_ids_) {
+        target_index = index;
+        break;
+      }
     }
+    PELOTON_ASSERT(target_index != nullptr);
+
+    // Collect the indirection of every tuple, which is the value all indexes
+    // of the table store for it. Tables without indexes do not allocate
+    // indirections, so the first index has to
+    std::vector<std::pair<LogicalTile *, oid_t>> rows;
+    std::vector<ItemPointer *> values;
+    for (auto &child_tile : child_tiles_) {
+      auto tile = child_tile.get();
+      auto tile_group = tile->GetBaseTile(0)->GetTileGroup();
+      auto tile_group_header = tile_group->GetHeader();
+      auto &position_list =
+          tile->GetPositionList(tile->GetColumnInfo(0).position_list_idx);
 
-    auto target_table_schema = target_table_->GetSchema();
-
-    std::unique_ptr<storage::Tuple> tuple(
-        new storage::Tuple(target_table_schema, true));
-
-    // Go over the logical tile and insert in the index the values
-    for (size_t child_tile_itr = 0; child_tile_itr < child_tiles_.size();
-         child_tile_itr++) {
-      auto tile = child_tiles_[child_tile_itr].get();
-
-      // Go over all tuples in the logical tile
       for (oid_t tuple_id : *tile) {
-        ContainerTuple<LogicalTile> cur_tuple(tile, tuple_id);
+        oid_t physical_tuple_id = position_list[tuple_id];
+        ItemPointer *index_entry_ptr =
+            tile_group_header->GetIndirection(physical_tuple_id);
+        if (index_entry_ptr == nullptr) {
+          index_entry_ptr = target_table_->AllocateIndirection(
+              ItemPointer(tile_group->GetTileGroupId(), physical_tuple_id));
+          tile_group_header->SetIndirection(physical_tuple_id,
+                                            index_entry_ptr);
+        }
+
+        rows.emplace_back(tile, tuple_id);
+        values.push_back(index_entry_ptr);
+      }
+    }
 
-        // Materialize the logical tile tuple
+    // Build the keys in parallel. The scan projects exactly the key columns
+    // in key order
+    auto key_schema = target_index->GetKeySchema();
+    auto index_pool = target_index->GetPool();
+    std::vector<std::unique_ptr<storage::Tuple>> keys(rows.size());
+    std::vector<const storage::Tuple *> key_ptrs(rows.size());
+    ParallelUtil::ParallelFor(rows.size(), [&](size_t begin, size_t end) {
+      for (size_t i = begin; i < end; i++) {
+        ContainerTuple<LogicalTile> cur_tuple(rows[i].first, rows[i].second);
+        keys[i].reset(new storage::Tuple(key_schema, true));
         for (oid_t column_itr = 0; column_itr < column_ids_.size();
              column_itr++) {
-          type::Value val = (cur_tuple.GetValue(column_itr));
-          tuple->SetValue(column_ids_[column_itr], val, executor_pool);
+          keys[i]->SetValue(column_itr, cur_tuple.GetValue(column_itr),
+                            index_pool);
         }
+        key_ptrs[i] = keys[i].get();
+      }
+    });
+
+    auto &transaction_manager =
+        concurrency::TransactionManagerFactory::GetInstance();
 
-        ItemPointer location(tile->GetBaseTile(0)->GetTileGroup()->GetTileGroupId(),
-                             tuple_id);
+    // Let the index sort the entries and build itself from them. Writers
+    // have been buffering their changes since the index was created
+    bool res = true;
+    if (rows.empty() == false) {
+      res = target_index->BulkInsert(key_ptrs, values);
+    }
 
-        // insert tuple into the index.
-        ItemPointer *index_entry_ptr = nullptr;
-        target_table_->InsertInIndexes(tuple.get(), location, current_txn,
-                                       &index_entry_ptr);
+    // Merge the changes that writers made while we were scanning. Their
+    // inserts are checked against the snapshot entries like any other insert
+    std::function<bool(const void *)> fn =
+        std::bind(&concurrency::TransactionManager::IsOccupied,
+                  &transaction_manager, current_txn, std::placeholders::_1);
+    bool unique_keys = target_index->HasUniqueKeys();
+    auto insert_func = [&](const storage::Tuple *key, ItemPointer *location) {
+      // A writer may have buffered a tuple that the scan read as well
+      std::vector<ItemPointer *> existing;
+      target_index->ScanKey(key, existing);
+      if (std::find(existing.begin(), existing.end(), location) !=
+          existing.end()) {
+        return true;
       }
+      if (unique_keys) {
+        return target_index->CondInsertEntry(key, location, fn);
+      }
+      return target_index->InsertEntry(key, location);
+    };
+    // The buffer is drained even if the bulk load failed, so that writers
+    // stop buffering
+    if (target_index->FinishBuild(insert_func) == false) {
+      res = false;
+    }
+
+    if (res == false) {
+      LOG_TRACE("PopulateIndex Executor : failed -- duplicated key");
+      transaction_manager.SetTransactionResult(current_txn,
+                                               ResultType::FAILURE);
+      return false;
+    }
+
+    // The index now holds every tuple and can be used by scans
+    auto result = catalog::Catalog::GetInstance()->SetIndexValid(
+        current_txn, target_table_->GetDatabaseOid(), target_index->GetOid());
+    if (result != ResultType::SUCCESS) {
+      transaction_manager.SetTransactionResult(current_txn, result);
+      return false;
     }
 
     done_ = true;
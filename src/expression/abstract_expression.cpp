@@ -158,6 +158,8 @@ hash_t AbstractExpression::HashForExactMatch() const {
 }
 
 bool AbstractExpression::IsZoneMappable() {
+  // Parse from scratch, a plan may be compiled more than once
+  parsed_predicates.clear();
   bool is_zone_mappable =
       ExpressionUtil::GetPredicateForZoneMap(parsed_predicates, this);
   return is_zone_mappable;
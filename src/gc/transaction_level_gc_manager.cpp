@@ -16,6 +16,7 @@
 #include "catalog/manager.h"
 #include "common/container_tuple.h"
 #include "concurrency/epoch_manager_factory.h"
+#include "concurrency/transaction_context_pool.h"
 #include "concurrency/transaction_manager_factory.h"
 #include "index/index.h"
 #include "settings/settings_manager.h"
@@ -56,6 +57,7 @@ void TransactionLevelGCManager::Running(const int &thread_id) {
   while (true) {
     int reclaimed_count = Reclaim(thread_id);
     int unlinked_count = Unlink(thread_id);
+    MarkAllVisible(thread_id);
 
     if (is_running_ == false) {
       return;
@@ -85,6 +87,13 @@ void TransactionLevelGCManager::RecycleTransaction(
     txn->SetEpochId(epoch_manager.GetNextEpochId());
   }
 
+  if (txn->GetWriteFlag() == false) {
+    // only transactions that wrote are bound to an epoch node, and reclaimed
+    // later. nothing refers to this context anymore.
+    concurrency::TransactionContextPool::GetInstance().Release(txn);
+    return;
+  }
+
   // Add the transaction context to the lock-free queue
   unlink_queues_[HashToThread(txn->GetThreadId())]->Enqueue(txn);
 }
@@ -187,6 +196,7 @@ int TransactionLevelGCManager::Reclaim(const int &thread_id) {
   // we delete garbage in the free list
   auto garbage_ctx_entry = reclaim_maps_[thread_id].begin();
   while (garbage_ctx_entry != reclaim_maps_[thread_id].end()) {
+    AddVisibilityCandidates(thread_id, *garbage_ctx_entry);
     AddToRecycleMap(*garbage_ctx_entry);
 
     // Remove from the original map
@@ -197,49 +207,140 @@ int TransactionLevelGCManager::Reclaim(const int &thread_id) {
   return gc_counter;
 }
 
-// Multiple GC thread share the same recycle map
-void TransactionLevelGCManager::AddToRecycleMap(
-    concurrency::TransactionContext *txn_ctx) {
-  for (auto &entry : *(txn_ctx->GetGCSetPtr().get())) {
-    auto storage_manager = storage::StorageManager::GetInstance();
-    auto tile_group = storage_manager->GetTileGroup(entry.first);
+void TransactionLevelGCManager::AddVisibilityCandidates(
+    const int &thread_id, concurrency::TransactionContext *txn_ctx) {
+  auto &candidates = visibility_candidates_[thread_id];
 
-    // During the resetting, a table may be deconstructed because of the DROP
-    // TABLE request
-    if (tile_group == nullptr) {
-      delete txn_ctx;
-      return;
+  // new versions of updated tuples never make their tile group all-visible,
+  // so only inserted tuples are of interest.
+  for (auto &entry : txn_ctx->GetReadWriteSet()) {
+    if (entry.second == RWType::INSERT) {
+      candidates.insert(entry.first.block);
     }
+  }
 
-    PELOTON_ASSERT(tile_group != nullptr);
+  // reclaimed versions are about to leave their tile groups.
+  for (auto &entry : *(txn_ctx->GetGCSetPtr())) {
+    candidates.insert(entry.first.block);
+  }
+}
 
-    storage::DataTable *table =
-        dynamic_cast<storage::DataTable *>(tile_group->GetAbstractTable());
-    PELOTON_ASSERT(table != nullptr);
+// executed by a single thread. so no synchronization is required.
+int TransactionLevelGCManager::MarkAllVisible(const int &thread_id) {
+  auto &candidates = visibility_candidates_[thread_id];
+  if (candidates.empty()) {
+    return 0;
+  }
 
-    oid_t table_id = table->GetOid();
-    auto tile_group_header = tile_group->GetHeader();
-    PELOTON_ASSERT(tile_group_header != nullptr);
-    bool immutable = tile_group_header->GetImmutability();
+  // versions committed up to the expired cid are seen by every transaction.
+  auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+  cid_t expired_cid = epoch_manager.GetExpiredCid();
+  auto storage_manager = storage::StorageManager::GetInstance();
 
-    for (auto &element : entry.second) {
-      // as this transaction has been committed, we should reclaim older
-      // versions.
-      ItemPointer location(entry.first, element.first);
+  int marked_count = 0;
+  auto candidate = candidates.begin();
+  while (candidate != candidates.end()) {
+    auto tile_group = storage_manager->GetTileGroup(*candidate);
+    if (tile_group == nullptr) {
+      candidate = candidates.erase(candidate);
+      continue;
+    }
 
-      // If the tuple being reset no longer exists, just skip it
-      if (ResetTuple(location) == false) {
+    auto tile_group_header = tile_group->GetHeader();
+    // the stamp has to be read before the tuples are.
+    uint64_t write_stamp = tile_group_header->GetWriteStamp();
+    oid_t tuple_count = tile_group_header->GetCurrentNextTupleSlot();
+
+    bool all_visible = true;
+    bool check_again = false;
+    for (oid_t tuple_id = 0; tuple_id < tuple_count; tuple_id++) {
+      txn_id_t txn_id = tile_group_header->GetTransactionId(tuple_id);
+      if (txn_id == INVALID_TXN_ID) {
+        // empty slot.
         continue;
       }
-      // if immutable is false and the entry for table_id exists.
-      if ((!immutable) &&
-          recycle_queue_map_.find(table_id) != recycle_queue_map_.end()) {
-        recycle_queue_map_[table_id]->Enqueue(location);
+      if (txn_id != INITIAL_TXN_ID ||
+          tile_group_header->GetBeginCommitId(tuple_id) > expired_cid) {
+        // the version is being written, or some transaction can not see it
+        // yet.
+        all_visible = false;
+        check_again = true;
+        break;
+      }
+      if (tile_group_header->GetEndCommitId(tuple_id) != MAX_CID ||
+          tile_group_header->GetNextItemPointer(tuple_id).IsNull() == false) {
+        // the tuple has been updated or deleted. the indexes may still hold
+        // entries of its old versions that lead to this one. reclaiming a
+        // deleted tuple brings the tile group back here.
+        all_visible = false;
+        break;
       }
     }
+
+    if (all_visible) {
+      tile_group_header->SetAllVisible(write_stamp);
+      marked_count++;
+    }
+
+    if (check_again) {
+      candidate++;
+    } else {
+      candidate = candidates.erase(candidate);
+    }
   }
 
+  LOG_TRACE("Marked %d tile groups as all-visible", marked_count);
+  return marked_count;
+}
+
+// Multiple GC thread share the same recycle map
+void TransactionLevelGCManager::AddToRecycleMap(
+    concurrency::TransactionContext *txn_ctx) {
   auto storage_manager = storage::StorageManager::GetInstance();
+
+  // versions of the same tile group are mostly next to each other.
+  oid_t last_tile_group_id = INVALID_OID;
+  oid_t table_id = INVALID_OID;
+  bool immutable = false;
+
+  for (auto &entry : *(txn_ctx->GetGCSetPtr())) {
+    // as this transaction has been committed, we should reclaim older
+    // versions.
+    ItemPointer location = entry.first;
+
+    if (location.block != last_tile_group_id) {
+      auto tile_group = storage_manager->GetTileGroup(location.block);
+
+      // During the resetting, a table may be deconstructed because of the DROP
+      // TABLE request
+      if (tile_group == nullptr) {
+        concurrency::TransactionContextPool::GetInstance().ReleaseShared(
+            txn_ctx);
+        return;
+      }
+
+      storage::DataTable *table =
+          dynamic_cast<storage::DataTable *>(tile_group->GetAbstractTable());
+      PELOTON_ASSERT(table != nullptr);
+
+      table_id = table->GetOid();
+      auto tile_group_header = tile_group->GetHeader();
+      PELOTON_ASSERT(tile_group_header != nullptr);
+      immutable = tile_group_header->GetImmutability();
+      last_tile_group_id = location.block;
+    }
+
+    // If the tuple being reset no longer exists, just skip it
+    if (ResetTuple(location) == false) {
+      continue;
+    }
+    // if immutable is false and the entry for table_id exists.
+    if ((!immutable) &&
+        recycle_queue_map_.find(table_id) != recycle_queue_map_.end()) {
+      recycle_queue_map_[table_id]->Enqueue(location);
+    }
+  }
+
   for (auto &entry : *(txn_ctx->GetGCObjectSetPtr().get())) {
     oid_t database_oid = std::get<0>(entry);
     oid_t table_oid = std::get<1>(entry);
@@ -264,7 +365,7 @@ void TransactionLevelGCManager::AddToRecycleMap(
     LOG_DEBUG("GCing index %u", index_oid);
   }
 
-  delete txn_ctx;
+  concurrency::TransactionContextPool::GetInstance().ReleaseShared(txn_ctx);
 }
 
 // this function returns a free tuple slot, if one exists
@@ -309,10 +410,8 @@ void TransactionLevelGCManager::StopGC() {
 
 void TransactionLevelGCManager::UnlinkVersions(
     concurrency::TransactionContext *txn_ctx) {
-  for (auto entry : *(txn_ctx->GetGCSetPtr().get())) {
-    for (auto &element : entry.second) {
-      UnlinkVersion(ItemPointer(entry.first, element.first), element.second);
-    }
+  for (auto &entry : *(txn_ctx->GetGCSetPtr())) {
+    UnlinkVersion(entry.first, entry.second);
   }
 }
 
@@ -387,7 +486,11 @@ void TransactionLevelGCManager::UnlinkVersion(const ItemPointer location,
       current_key->SetFromTuple(&current_tuple, indexed_columns,
                                 index->GetPool());
 
-      index->DeleteEntry(current_key.get(), indirection);
+      // An index that is being built removes the entry when it merges its
+      // side buffer, after the entry may have been added
+      if (index->BufferDelete(current_key.get(), indirection) == false) {
+        index->DeleteEntry(current_key.get(), indirection);
+      }
     }
   }
 }
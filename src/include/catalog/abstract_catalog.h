@@ -43,6 +43,11 @@ class AbstractCatalog {
  public:
   virtual ~AbstractCatalog() {}
 
+  /* Read the oids of every row after recovery, and make sure that the oids
+   * handed out from now on do not collide with them */
+  std::vector<oid_t> RecoverOids(concurrency::TransactionContext *txn,
+                                 oid_t oid_column_id);
+
  protected:
   /* For pg_database, pg_table, pg_index, pg_column */
   AbstractCatalog(storage::Database *pg_catalog,
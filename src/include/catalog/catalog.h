@@ -85,6 +85,10 @@ class Catalog {
   // Bootstrap additional catalogs, only used in system initialization phase
   void Bootstrap();
 
+  // Create the databases, tables and indexes whose catalog rows have been
+  // recovered but that do not exist yet, only used in recovery
+  void RecoverStorageObjects(concurrency::TransactionContext *txn);
+
   // Deconstruct the catalog database when destroying the catalog.
   ~Catalog();
 
@@ -118,7 +122,9 @@ class Catalog {
                          const std::string &index_name,
                          const std::vector<oid_t> &key_attrs,
                          bool unique_keys,
-                         IndexType index_type);
+                         IndexType index_type,
+                         bool index_valid = true,
+                         const std::vector<oid_t> &include_attrs = {});
 
   ResultType CreateIndex(concurrency::TransactionContext *txn,
                          oid_t database_oid,
@@ -130,7 +136,9 @@ class Catalog {
                          const std::vector<oid_t> &key_attrs,
                          bool unique_keys,
                          IndexType index_type,
-                         IndexConstraintType index_constraint);
+                         IndexConstraintType index_constraint,
+                         bool index_valid = true,
+                         const std::vector<oid_t> &include_attrs = {});
 
 
   /**
@@ -179,6 +187,15 @@ class Catalog {
                                   oid_t column_id,
                                   const type::Value &default_value);
 
+  //===--------------------------------------------------------------------===//
+  // SET FUNCTIONS FOR INDEX
+  //===--------------------------------------------------------------------===//
+
+  // Mark an index that was created as not valid as valid once it is built
+  ResultType SetIndexValid(concurrency::TransactionContext *txn,
+                           oid_t database_oid,
+                           oid_t index_oid);
+
   //===--------------------------------------------------------------------===//
   // ADD FUNCTIONS FOR TABLE CONSTRAINT
   //===--------------------------------------------------------------------===//
@@ -372,6 +389,10 @@ class Catalog {
   void BootstrapSystemCatalogs(concurrency::TransactionContext *txn,
                                storage::Database *database);
 
+  storage::DataTable *RecoverTable(concurrency::TransactionContext *txn,
+                                   oid_t database_oid,
+                                   oid_t table_oid);
+
   // The pool for new varlen tuple fields
   std::unique_ptr<type::AbstractPool> pool_;
   std::mutex catalog_mutex;
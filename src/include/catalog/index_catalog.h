@@ -54,6 +54,8 @@ class IndexCatalogEntry {
   inline IndexConstraintType GetIndexConstraint() { return index_constraint_; }
   inline bool HasUniqueKeys() { return unique_keys_; }
   inline const std::vector<oid_t> &GetKeyAttrs() { return key_attrs_; }
+  // An index is not valid while it is being built and must not be scanned
+  inline bool IsValid() { return index_valid_; }
 
  private:
   // member variables
@@ -65,6 +67,7 @@ class IndexCatalogEntry {
   IndexConstraintType index_constraint_;
   bool unique_keys_;
   std::vector<oid_t> key_attrs_;
+  bool index_valid_;
 };
 
 class IndexCatalog : public AbstractCatalog {
@@ -93,12 +96,18 @@ class IndexCatalog : public AbstractCatalog {
                    IndexConstraintType index_constraint,
                    bool unique_keys,
                    std::vector<oid_t> index_keys,
-                   type::AbstractPool *pool);
+                   type::AbstractPool *pool,
+                   bool index_valid = true);
 
   bool DeleteIndex(concurrency::TransactionContext *txn,
                    oid_t database_oid,
                    oid_t index_oid);
 
+  bool UpdateIndexValid(concurrency::TransactionContext *txn,
+                        oid_t database_oid,
+                        oid_t index_oid,
+                        bool index_valid);
+
   /** Read Related API */
   std::shared_ptr<IndexCatalogEntry> GetIndexCatalogEntry(concurrency::TransactionContext *txn,
                                                           const std::string &database_name,
@@ -126,9 +135,10 @@ class IndexCatalog : public AbstractCatalog {
     INDEX_CONSTRAINT = 5,
     UNIQUE_KEYS = 6,
     INDEXED_ATTRIBUTES = 7,
+    INDEX_VALID = 8,
     // Add new columns here in creation order
   };
-  std::vector<oid_t> all_column_ids = {0, 1, 2, 3, 4, 5, 6, 7};
+  std::vector<oid_t> all_column_ids = {0, 1, 2, 3, 4, 5, 6, 7, 8};
 
   enum IndexId {
     PRIMARY_KEY = 0,
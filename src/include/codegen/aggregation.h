@@ -78,11 +78,27 @@ class Aggregation {
   void AdvanceValues(CodeGen &codegen, llvm::Value *space,
                      const std::vector<codegen::Value> &next) const;
 
+  // Store a copy of the partial aggregates stored in the partial storage space
+  // as the initial values of the aggregates in the provided storage space
+  void CopyPartialValues(CodeGen &codegen, llvm::Value *space,
+                         llvm::Value *partial_space) const;
+
+  // Merge the partial aggregates stored in the partial storage space into the
+  // aggregates stored in the provided storage space
+  void MergePartialValues(CodeGen &codegen, llvm::Value *space,
+                          llvm::Value *partial_space) const;
+
   // Compute the final values of all the aggregates stored in the provided
   // storage space, inserting them into the provided output vector.
   void FinalizeValues(CodeGen &codegen, llvm::Value *space,
                       std::vector<codegen::Value> &final_vals) const;
 
+  // Can the provided aggregates be computed as partial aggregates over disjoint
+  // parts of the input that are merged later? DISTINCT aggregates can't, since
+  // the values they have seen are tracked in a single shared hash table.
+  static bool SupportsPartialAggregation(
+      const std::vector<planner::AggregatePlan::AggTerm> &agg_terms);
+
   // Get the total number of bytes needed to store all the aggregates this is
   // configured to store
   uint32_t GetAggregatesStorageSize() const {
@@ -189,6 +189,7 @@ class CodeGen {
 
  private:
   friend class Hash;
+  friend class HashTable;
   friend class Value;
   friend class OAHashTable;
 
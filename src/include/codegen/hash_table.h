@@ -109,6 +109,29 @@ class HashTable {
                               llvm::Value *values) const = 0;
   };
 
+  /**
+   * A callback used when iterating over the entries in one partition of a
+   * radix-partitioned hash table. The hash value of each entry is provided
+   * so that it need not be recomputed.
+   */
+  class PartitionIterateCallback {
+   public:
+    /** Virtual destructor */
+    virtual ~PartitionIterateCallback() = default;
+
+    /**
+     * The callback function for each entry in the partition.
+     *
+     * @param codegen The codegen instance
+     * @param hash The hash value of the entry
+     * @param keys The key stored in the hash table
+     * @param values A pointer to a set of bytes where the value is stored
+     */
+    virtual void ProcessEntry(CodeGen &codegen, llvm::Value *hash,
+                              const std::vector<codegen::Value> &keys,
+                              llvm::Value *values) const = 0;
+  };
+
   class HashTableAccess;
 
   /**
@@ -216,6 +239,26 @@ class HashTable {
   void MergeLazyUnfinished(CodeGen &codegen, llvm::Value *global_ht,
                            llvm::Value *local_ht) const;
 
+  void BuildPartitioned(CodeGen &codegen, llvm::Value *ht_ptr) const;
+
+  void BuildPartitionedParallel(CodeGen &codegen, llvm::Value *ht_ptr,
+                                llvm::Value *thread_states,
+                                uint32_t ht_state_offset) const;
+
+  void PartitionLazy(CodeGen &codegen, llvm::Value *ht_ptr,
+                     llvm::Value *build_ht_ptr) const;
+
+  void PartitionLazyParallel(CodeGen &codegen, llvm::Value *ht_ptr,
+                             llvm::Value *thread_states,
+                             uint32_t ht_state_offset,
+                             llvm::Value *build_ht_ptr) const;
+
+  llvm::Value *NumPartitions(CodeGen &codegen, llvm::Value *ht_ptr) const;
+
+  void IteratePartition(CodeGen &codegen, llvm::Value *ht_ptr,
+                        llvm::Value *partition_idx,
+                        PartitionIterateCallback &callback) const;
+
   virtual void Iterate(CodeGen &codegen, llvm::Value *ht_ptr,
                        IterateCallback &callback) const;
 
@@ -224,11 +267,44 @@ class HashTable {
                                  VectorizedIterateCallback &callback) const;
 
   virtual void FindAll(CodeGen &codegen, llvm::Value *ht_ptr,
+                       llvm::Value *hash,
                        const std::vector<codegen::Value> &key,
                        IterateCallback &callback) const;
 
+  void FindAllPartitioned(CodeGen &codegen, llvm::Value *ht_ptr,
+                          llvm::Value *hash,
+                          const std::vector<codegen::Value> &key,
+                          IterateCallback &callback) const;
+
+  /**
+   * Prefetch the directory slot the given hash value maps to. This is the
+   * first stage of a group-prefetched probe.
+   *
+   * @param codegen The codegen instance
+   * @param ht_ptr A pointer to the hash table
+   * @param hash The hash value of the probe key
+   */
+  void PrefetchDirectorySlot(CodeGen &codegen, llvm::Value *ht_ptr,
+                             llvm::Value *hash) const;
+
+  /**
+   * Prefetch the first entry in the bucket the given hash value maps to. This
+   * is the second stage of a group-prefetched probe, and should only be issued
+   * once the directory slot has been prefetched.
+   *
+   * @param codegen The codegen instance
+   * @param ht_ptr A pointer to the hash table
+   * @param hash The hash value of the probe key
+   */
+  void PrefetchBucketHead(CodeGen &codegen, llvm::Value *ht_ptr,
+                          llvm::Value *hash) const;
+
   virtual void Destroy(CodeGen &codegen, llvm::Value *ht_ptr) const;
 
+ private:
+  // Issue a read-prefetch of the given address
+  static void Prefetch(CodeGen &codegen, llvm::Value *addr);
+
  private:
   uint32_t value_size_;
 
@@ -0,0 +1,105 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// index_scanner.h
+//
+// Identification: src/include/codegen/index_scanner.h
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "common/internal_types.h"
+#include "common/item_pointer.h"
+#include "common/macros.h"
+
+namespace peloton {
+
+namespace executor {
+class ExecutorContext;
+}  // namespace executor
+
+namespace index {
+class Index;
+}  // namespace index
+
+namespace storage {
+class DataTable;
+class TileGroup;
+}  // namespace storage
+
+namespace codegen {
+
+// This class performs index lookups on behalf of generated code. The keys of
+// the scan are registered once (through AddKey()) when the query state is
+// initialized. Their values are read from the query parameters on every
+// invocation, so the compiled query can be reused for any key. Scan() probes
+// the index and resolves the version of every tuple that is visible to the
+// transaction. The visible tuples are then handed out in batches of tuples
+// that live in the same tile group, in the order the index returned them.
+class IndexScanner {
+ public:
+  // Constructor
+  IndexScanner(storage::DataTable *table, uint32_t index_oid,
+               executor::ExecutorContext *executor_context);
+
+  // Initialize this scanner over the index with the given OID of the table
+  static void Init(IndexScanner &scanner, storage::DataTable *table,
+                   uint32_t index_oid,
+                   executor::ExecutorContext *executor_context);
+
+  // Add a key to the scan. The value of the key is the query parameter at
+  // the given index, compared to the given column using the given
+  // ExpressionType.
+  void AddKey(uint32_t column_id, uint32_t expr_type,
+              uint32_t parameter_idx);
+
+  // Probe the index and collect the location of every visible tuple
+  void Scan();
+
+  // Store the offsets of the next batch of tuples in the selection vector.
+  // All tuples of a batch live in the same tile group. Returns the number of
+  // tuples in the batch, or zero once every tuple has been returned.
+  uint32_t NextBatch(uint32_t *selection_vector, uint32_t max_count);
+
+  // The tile group of the last batch
+  storage::TileGroup *GetTileGroup() const { return tile_group_.get(); }
+
+  // Destroy the given scanner
+  static void Destroy(IndexScanner &scanner);
+
+ private:
+  // The table that is scanned
+  storage::DataTable *table_;
+
+  // The index that is probed
+  std::shared_ptr<index::Index> index_;
+
+  // The executor context with which the current execution happens
+  executor::ExecutorContext *executor_context_;
+
+  // The keys of the scan
+  std::vector<oid_t> key_column_ids_;
+  std::vector<ExpressionType> expr_types_;
+  std::vector<uint32_t> parameter_idxs_;
+
+  // The locations of the visible tuples, and the next one to return
+  std::vector<ItemPointer> locations_;
+  size_t next_location_;
+
+  // The tile group of the last batch
+  std::shared_ptr<storage::TileGroup> tile_group_;
+
+ private:
+  DISALLOW_COPY_AND_MOVE(IndexScanner);
+};
+
+}  // namespace codegen
+}  // namespace peloton
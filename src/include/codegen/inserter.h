@@ -53,7 +53,8 @@ class Inserter {
   // Get the pool address
   peloton::type::AbstractPool *GetPool();
 
-  // Insert a tuple
+  // Insert a tuple. Tuples are put into the indexes in batches, the last
+  // batch is inserted at TearDown()
   void Insert();
 
   // Finalize the instance
@@ -63,6 +64,12 @@ class Inserter {
   // No external constructor
   Inserter(): table_(nullptr), executor_context_(nullptr), tile_(nullptr) {}
 
+  // Insert the pending tuples into the indexes of the table
+  void InsertPending();
+
+  // The number of tuples that are inserted into the indexes together
+  static constexpr uint32_t kInsertBatchSize = 256;
+
  private:
   // Provided by its insert translator
   storage::DataTable *table_;
@@ -72,6 +79,10 @@ class Inserter {
   std::shared_ptr<storage::Tile> tile_;
   ItemPointer location_;
 
+  // Tuples that are stored in the table but not yet in its indexes
+  ItemPointer pending_locations_[kInsertBatchSize];
+  uint32_t num_pending_;
+
  private:
   DISALLOW_COPY_AND_MOVE(Inserter);
 };
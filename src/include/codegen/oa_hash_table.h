@@ -64,6 +64,10 @@ class OAHashTable : public HashTable {
 
   void Init(CodeGen &codegen, llvm::Value *ht_ptr) const override;
 
+  // Initialize the hash table, sized for the given estimated number of entries
+  void Init(CodeGen &codegen, llvm::Value *ht_ptr,
+            uint64_t estimated_num_entries) const;
+
   llvm::Value *HashKey(CodeGen &codegen,
                        const std::vector<codegen::Value> &key) const;
 
@@ -95,7 +99,7 @@ class OAHashTable : public HashTable {
       HashTable::VectorizedIterateCallback &callback) const override;
 
   // Generate code that iterates all the matches
-  void FindAll(CodeGen &codegen, llvm::Value *ht_ptr,
+  void FindAll(CodeGen &codegen, llvm::Value *ht_ptr, llvm::Value *hash,
                const std::vector<codegen::Value> &key,
                HashTable::IterateCallback &callback) const override;
 
@@ -30,8 +30,10 @@ namespace codegen {
 //===----------------------------------------------------------------------===//
 class HashGroupByTranslator : public OperatorTranslator {
  public:
-  // Global/configurable variable controlling whether hash aggregations prefetch
-  static std::atomic<bool> kUsePrefetch;
+  // The number of partitions the groups are split into when the input to the
+  // aggregation is processed in parallel
+  static constexpr uint32_t kNumPartitionBits = 4;
+  static constexpr uint32_t kNumPartitions = 1u << kNumPartitionBits;
 
   // Constructor
   HashGroupByTranslator(const planner::AggregatePlan &group_by,
@@ -50,6 +52,12 @@ class HashGroupByTranslator : public OperatorTranslator {
   void Consume(ConsumerContext &context, RowBatch::Row &row) const override;
   void Consume(ConsumerContext &context, RowBatch &batch) const override;
 
+  // Thread-local pre-aggregation state when the input is consumed in parallel
+  void RegisterPipelineState(PipelineContext &pipeline_ctx) override;
+  void InitializePipelineState(PipelineContext &pipeline_ctx) override;
+  void FinishPipeline(PipelineContext &pipeline_ctx) override;
+  void TearDownPipelineState(PipelineContext &pipeline_ctx) override;
+
   // Codegen any cleanup work for this translator
   void TearDownQueryState() override;
 
@@ -166,9 +174,53 @@ class HashGroupByTranslator : public OperatorTranslator {
     uint32_t agg_index_;
   };
 
+  //===--------------------------------------------------------------------===//
+  // The callback used to merge the partial aggregates of a thread-local hash
+  // table into a partition of the global hash table. Groups that don't exist
+  // in the partition yet are inserted with a copy of the partial aggregates.
+  //===--------------------------------------------------------------------===//
+  class MergePartials : public HashTable::IterateCallback {
+   public:
+    // Constructor
+    MergePartials(const OAHashTable &hash_table, const Aggregation &aggregation,
+                  llvm::Value *partition_ptr);
+
+    // The callback
+    void ProcessEntry(CodeGen &codegen, const std::vector<codegen::Value> &keys,
+                      llvm::Value *partial_aggs) const override;
+
+   private:
+    // The hash table
+    const OAHashTable &hash_table_;
+    // The guy that handles the computation of the aggregates
+    const Aggregation &aggregation_;
+    // The partition of the global hash table we merge into
+    llvm::Value *partition_ptr_;
+  };
+
   void CollectHashKeys(RowBatch::Row &row,
                        std::vector<codegen::Value> &key) const;
 
+  // Is the input to this aggregation consumed in parallel?
+  bool IsParallel() const { return child_pipeline_.IsParallel(); }
+
+  // Is the given pipeline context for our (parallel) input pipeline?
+  bool IsParallelChildPipeline(PipelineContext &pipeline_ctx) const;
+
+  // Load a pointer to the hash table that groups with the given hash value
+  // are aggregated into while consuming tuples
+  llvm::Value *LoadHashTablePtr(ConsumerContext &context,
+                                llvm::Value *hash) const;
+
+  // Return a pointer to the given partition in an array of hash tables
+  llvm::Value *GetPartitionPtr(CodeGen &codegen, llvm::Value *partitions,
+                               llvm::Value *partition) const;
+
+  // Generate a loop over each partition in the given array of hash tables
+  void ForEachPartition(
+      CodeGen &codegen, llvm::Value *partitions,
+      const std::function<void(llvm::Value *)> &body) const;
+
   // Estimate the size of the constructed hash table
   uint64_t EstimateHashTableSize() const;
 
@@ -179,9 +231,13 @@ class HashGroupByTranslator : public OperatorTranslator {
   // The pipeline forming all child operators of this aggregation
   Pipeline child_pipeline_;
 
-  // The ID of the hash-table in the runtime state
+  // The ID of the hash-table in the runtime state. When the input is consumed
+  // in parallel, this is an array of kNumPartitions hash-tables.
   QueryState::Id hash_table_id_;
 
+  // The ID of the thread-local partitioned hash-tables in the pipeline state
+  PipelineContext::Id local_hash_table_id_;
+
   // The hash table
   OAHashTable hash_table_;
 
@@ -28,13 +28,18 @@ class HashJoinPlan;
 namespace codegen {
 
 //===----------------------------------------------------------------------===//
-// The translator for a hash-join operator
+// The translator for a hash-join operator.
+//
+// By default, the left (build) side is materialized into a hash table that is
+// probed by each tuple of the right side as it flows through the pipeline.
+// When the plan requests a radix-partitioned join, both sides are instead
+// materialized and scattered into cache-sized partitions on the high bits of
+// the join key's hash. The join then becomes the source of its pipeline: it
+// joins the inputs partition by partition, in parallel if possible, so that
+// every probe hits a cache-resident portion of the build table.
 //===----------------------------------------------------------------------===//
 class HashJoinTranslator : public OperatorTranslator {
  public:
-  // Global/configurable variable controlling whether hash aggregations prefetch
-  static std::atomic<bool> kUsePrefetch;
-
   HashJoinTranslator(const planner::HashJoinPlan &join,
                      CompilationContext &context, Pipeline &pipeline);
 
@@ -64,10 +69,17 @@ class HashJoinTranslator : public OperatorTranslator {
     return pipeline == left_pipeline_;
   }
 
+  bool IsRightPipeline(const Pipeline &pipeline) const {
+    return right_pipeline_ != nullptr && pipeline == *right_pipeline_;
+  }
+
   bool IsFromLeftChild(ConsumerContext &context) const {
     return IsLeftPipeline(context.GetPipeline());
   }
 
+  // Join the materialized inputs partition-wise in radix-partitioned mode
+  void ProducePartitioned() const;
+
   void CollectKeys(
       RowBatch::Row &row,
       const std::vector<const expression::AbstractExpression *> &key,
@@ -80,6 +92,10 @@ class HashJoinTranslator : public OperatorTranslator {
   void CodegenHashProbe(ConsumerContext &context, RowBatch::Row &row,
                         std::vector<codegen::Value> &key) const;
 
+  // Insert the given right row into the probe table in radix-partitioned mode
+  void MaterializeRight(ConsumerContext &context, RowBatch::Row &row,
+                        std::vector<codegen::Value> &key) const;
+
   /// Estimate the size of the constructed hash table
   uint64_t EstimateHashTableSize() const;
 
@@ -100,6 +116,10 @@ class HashJoinTranslator : public OperatorTranslator {
   /// Callback used when inserting a tuple in the hash table during build
   class InsertLeft;
 
+  /// Callback used to probe the build table with the materialized right side
+  /// tuples of a partition
+  class ProbePartition;
+
  private:
   // The build-side pipeline
   Pipeline left_pipeline_;
@@ -129,6 +149,25 @@ class HashJoinTranslator : public OperatorTranslator {
 
   // Does this join need an output vector
   bool needs_output_vector_;
+
+  // Are the inputs of this join radix-partitioned?
+  bool radix_partitioned_;
+
+  // The probe-side pipeline, only used when radix-partitioned
+  std::unique_ptr<Pipeline> right_pipeline_;
+
+  // The ID of the hash table materializing the right side in the runtime state
+  QueryState::Id probe_table_id_;
+  PipelineContext::Id probe_table_tl_id_;
+
+  // The hash table materializing the right side of the join
+  HashTable probe_table_;
+
+  // The (unique) set of probe-side attributes that are materialized
+  std::vector<const planner::AttributeInfo *> right_val_ais_;
+
+  // The storage format used to store probe-attributes in the probe table
+  CompactStorage right_value_storage_;
 };
 
 }  // namespace codegen
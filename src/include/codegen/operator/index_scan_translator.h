@@ -0,0 +1,97 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// index_scan_translator.h
+//
+// Identification: src/include/codegen/operator/index_scan_translator.h
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "codegen/compilation_context.h"
+#include "codegen/consumer_context.h"
+#include "codegen/operator/operator_translator.h"
+#include "codegen/query_state.h"
+#include "codegen/scan_callback.h"
+#include "codegen/table.h"
+
+namespace peloton {
+
+namespace expression {
+class AbstractExpression;
+}  // namespace expression
+
+namespace planner {
+class IndexScanPlan;
+}  // namespace planner
+
+namespace codegen {
+
+//===----------------------------------------------------------------------===//
+// A translator for index scans. The index is probed through the runtime
+// IndexScanner, which resolves the visible version of every tuple it finds.
+// The tuples are then pushed through the pipeline in batches of tuples that
+// live in the same tile group, in the order the index returned them.
+//===----------------------------------------------------------------------===//
+class IndexScanTranslator : public OperatorTranslator {
+ public:
+  // Constructor
+  IndexScanTranslator(const planner::IndexScanPlan &index_scan,
+                      CompilationContext &context, Pipeline &pipeline);
+
+  // Initialize the index scanner and register the keys of the scan
+  void InitializeQueryState() override;
+
+  // Index scans don't rely on any auxiliary functions
+  void DefineAuxiliaryFunctions() override {}
+
+  // The method that produces new tuples
+  void Produce() const override;
+
+  // Scans are leaves in the query plan and, hence, do not consume tuples
+  void Consume(ConsumerContext &, RowBatch &) const override {}
+  void Consume(ConsumerContext &, RowBatch::Row &) const override {}
+
+  // Destroy the index scanner
+  void TearDownQueryState() override;
+
+ private:
+  // A key of the scan, and the expression in the predicate that provides its
+  // value
+  struct ScanKey {
+    oid_t column_id;
+    ExpressionType expr_type;
+    const expression::AbstractExpression *value_expr;
+  };
+
+  // Find the expressions that provide the values of the index keys
+  void CollectScanKeys(const expression::AbstractExpression *predicate);
+
+  // Load the table pointer
+  llvm::Value *LoadTablePtr(CodeGen &codegen) const;
+
+  // Plan accessor
+  const planner::IndexScanPlan &GetIndexScanPlan() const;
+
+ private:
+  // Helper class declarations (defined in implementation)
+  class AttributeAccess;
+  class ScanConsumer;
+
+ private:
+  // The code-generating table instance
+  codegen::Table table_;
+
+  // The keys of the scan
+  std::vector<ScanKey> scan_keys_;
+
+  // The index scanner
+  QueryState::Id index_scanner_id_;
+};
+
+}  // namespace codegen
+}  // namespace peloton
@@ -48,6 +48,11 @@ class OrderByTranslator : public OperatorTranslator {
 
   void Consume(ConsumerContext &context, RowBatch::Row &row) const override;
 
+ private:
+  // Scan the sorted results serially or in parallel
+  void ProduceSerial() const;
+  void ProduceParallel() const;
+
  private:
   // Helper class declarations (defined in implementation)
   class ProduceResults;
@@ -59,6 +59,10 @@ class TableScanTranslator : public OperatorTranslator {
   // Load the table pointer
   llvm::Value *LoadTablePtr(CodeGen &codegen) const;
 
+  // Load the values of the zone-mapped predicates from the query parameters
+  std::vector<codegen::Value> LoadZoneMapValues(
+      const expression::AbstractExpression &predicate) const;
+
   // Functions to produce tuples serially or in parallel
   void ProduceSerial() const;
   void ProduceParallel() const;
@@ -34,7 +34,11 @@ PROXY(HashTable) {
   DECLARE_MEMBER(4, char[sizeof(util::HashTable::EntryBuffer)], entry_buffer);
   DECLARE_MEMBER(5, uint64_t, num_elems);
   DECLARE_MEMBER(6, uint64_t, capacity);
-  DECLARE_MEMBER(7, char[sizeof(std::unique_ptr<char>)], stats);
+  DECLARE_MEMBER(7, uint64_t, shift);
+  DECLARE_MEMBER(8, uint64_t, num_partitions);
+  DECLARE_MEMBER(9, util::HashTable::Entry **, partitions);
+  DECLARE_MEMBER(10, util::HashTable::Entry **, partition_tails);
+  DECLARE_MEMBER(11, uint32_t, num_partition_bits);
   DECLARE_TYPE;
 
   // Proxy all methods that will be called from codegen
@@ -44,6 +48,10 @@ PROXY(HashTable) {
   DECLARE_METHOD(BuildLazy);
   DECLARE_METHOD(ReserveLazy);
   DECLARE_METHOD(MergeLazyUnfinished);
+  DECLARE_METHOD(BuildPartitioned);
+  DECLARE_METHOD(BuildPartitionedParallel);
+  DECLARE_METHOD(PartitionLazy);
+  DECLARE_METHOD(PartitionLazyParallel);
   DECLARE_METHOD(Destroy);
 };
 
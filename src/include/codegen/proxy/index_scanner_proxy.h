@@ -0,0 +1,38 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// index_scanner_proxy.h
+//
+// Identification: src/include/codegen/proxy/index_scanner_proxy.h
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "codegen/proxy/proxy.h"
+#include "codegen/index_scanner.h"
+
+namespace peloton {
+namespace codegen {
+
+PROXY(IndexScanner) {
+  /// We don't need access to internal fields, so use an opaque byte array
+  DECLARE_MEMBER(0, char[sizeof(IndexScanner)], opaque);
+  DECLARE_TYPE;
+
+  /// Proxy methods in codegen::IndexScanner
+  DECLARE_METHOD(Init);
+  DECLARE_METHOD(AddKey);
+  DECLARE_METHOD(Scan);
+  DECLARE_METHOD(NextBatch);
+  DECLARE_METHOD(GetTileGroup);
+  DECLARE_METHOD(Destroy);
+};
+
+TYPE_BUILDER(IndexScanner, codegen::IndexScanner);
+
+}  // namespace codegen
+}  // namespace peloton
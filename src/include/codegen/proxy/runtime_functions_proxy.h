@@ -45,7 +45,9 @@ PROXY(RuntimeFunctions) {
   DECLARE_METHOD(GetTileGroupLayout);
   DECLARE_METHOD(FillPredicateArray);
   DECLARE_METHOD(ExecuteTableScan);
+  DECLARE_METHOD(ExecutePartitionedScan);
   DECLARE_METHOD(ExecutePerState);
+  DECLARE_METHOD(ExecutePerPartition);
   DECLARE_METHOD(ThrowDivideByZeroException);
   DECLARE_METHOD(ThrowOverflowException);
 };
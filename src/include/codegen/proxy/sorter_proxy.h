@@ -44,6 +44,7 @@ PROXY(Sorter) {
   DECLARE_METHOD(Sort);
   DECLARE_METHOD(SortParallel);
   DECLARE_METHOD(SortTopKParallel);
+  DECLARE_METHOD(ScanParallel);
   DECLARE_METHOD(Destroy);
 };
 
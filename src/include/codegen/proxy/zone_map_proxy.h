@@ -26,14 +26,25 @@ PROXY(PredicateInfo) {
   DECLARE_TYPE;
 };
 
+PROXY(RawColumnStatistics) {
+  DECLARE_MEMBER(0, int64_t, min_integer);
+  DECLARE_MEMBER(1, int64_t, max_integer);
+  DECLARE_MEMBER(2, double, min_decimal);
+  DECLARE_MEMBER(3, double, max_decimal);
+  DECLARE_MEMBER(4, int64_t, null_count);
+  DECLARE_TYPE;
+};
+
 PROXY(ZoneMapManager) {
   DECLARE_MEMBER(0, char[sizeof(storage::ZoneMapManager)], opaque);
   DECLARE_TYPE;
   DECLARE_METHOD(ShouldScanTileGroup);
+  DECLARE_METHOD(GetRawZoneMap);
   DECLARE_METHOD(GetInstance);
 };
 
 TYPE_BUILDER(PredicateInfo, storage::PredicateInfo);
+TYPE_BUILDER(RawColumnStatistics, storage::RawColumnStatistics);
 TYPE_BUILDER(ZoneMapManager, storage::ZoneMapManager);
 
 }  // namespace codegen
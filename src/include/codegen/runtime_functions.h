@@ -94,6 +94,21 @@ class RuntimeFunctions {
       uint32_t db_oid, uint32_t table_oid, void *func);
   //      void (*scanner)(void *, void *, uint64_t, uint64_t));
 
+  /**
+   * Execute a parallel scan over the partitions of a radix-partitioned hash
+   * table. Each task is given a contiguous range of partitions.
+   *
+   * @param query_state An opaque (but usually a JITed struct) state used during
+   * query execution.
+   * @param thread_states The set of all thread states.
+   * @param num_partitions The total number of partitions.
+   * @param func The callback function that is provided a range of partitions
+   * to scan.
+   */
+  static void ExecutePartitionedScan(
+      void *query_state, executor::ExecutorContext::ThreadStates &thread_states,
+      uint32_t num_partitions, void *func);
+
   /**
    * Invoke a function for each available thread state in parallel.
    *
@@ -106,6 +121,17 @@ class RuntimeFunctions {
       void *query_state, executor::ExecutorContext::ThreadStates &thread_states,
       void (*work_func)(void *, void *));
 
+  /**
+   * Invoke a function for each of the given number of partitions in parallel.
+   *
+   * @param query_state An opaque (but usually a JITed struct) state used during
+   * query execution.
+   * @param num_partitions The number of partitions to process.
+   * @param work_func Callback function called for each partition.
+   */
+  static void ExecutePerPartition(void *query_state, uint32_t num_partitions,
+                                  void (*work_func)(void *, uint32_t));
+
   //////////////////////////////////////////////////////////////////////////////
   ///
   /// Exception related functions
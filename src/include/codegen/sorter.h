@@ -105,6 +105,15 @@ class Sorter {
                          uint32_t vector_size, uint64_t offset,
                          VectorizedIterateCallback &callback) const;
 
+  /**
+   * @brief Iterate over the tuples in the range [start_index, end_index) of
+   * this sorter batch-at-a-time. Used by parallel scans over sorted results.
+   */
+  void VectorizedIterate(CodeGen &codegen, llvm::Value *sorter_ptr,
+                         uint32_t vector_size, llvm::Value *start_index,
+                         llvm::Value *end_index,
+                         VectorizedIterateCallback &callback) const;
+
   /**
    * @brief Destroy all resources managed by this sorter
    */
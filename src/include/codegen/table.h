@@ -15,12 +15,14 @@
 #include "codegen/codegen.h"
 #include "codegen/scan_callback.h"
 #include "codegen/tile_group.h"
+#include "codegen/value.h"
 #include "type/value.h"
 
 namespace peloton {
 
 namespace storage {
 class DataTable;
+struct PredicateInfo;
 }  // namespace storage
 
 namespace codegen {
@@ -42,11 +44,22 @@ class Table {
 
   /// Generate code to perform a scan over the given table. The table pointer
   /// is provided as the second argument. The scan consumer (third argument)
-  /// should be notified when ready to generate the scan loop body.
+  /// should be notified when ready to generate the scan loop body. Tile
+  /// groups whose zone maps rule out the given predicates are skipped.
+  /// predicate_values holds the run time value of each predicate.
   void GenerateScan(CodeGen &codegen, llvm::Value *table_ptr,
                     llvm::Value *tilegroup_start, llvm::Value *tilegroup_end,
-                    uint32_t batch_size, llvm::Value *predicate_array,
-                    size_t num_predicates, ScanCallback &consumer) const;
+                    uint32_t batch_size, llvm::Value *predicate_ptr,
+                    const std::vector<storage::PredicateInfo> *predicates,
+                    const std::vector<codegen::Value> &predicate_values,
+                    ScanCallback &consumer) const;
+
+  /// Generate code that passes the tuples in the range [tid_start, tid_end)
+  /// of the given tile group to the consumer as a single batch. This is used
+  /// by scans that find their tuples through an index.
+  void GenerateBatchScan(CodeGen &codegen, llvm::Value *tile_group_ptr,
+                         llvm::Value *tid_start, llvm::Value *tid_end,
+                         ScanCallback &consumer) const;
 
   /// Given a table instance, return the number of tile groups in the table.
   llvm::Value *GetTileGroupCount(CodeGen &codegen,
@@ -60,6 +73,18 @@ class Table {
   llvm::Value *GetZoneMapManager(CodeGen &codegen) const;
 
  private:
+  /// Whether every predicate can be checked against the raw zone maps
+  bool CanUseRawZoneMap(
+      const std::vector<storage::PredicateInfo> &predicates) const;
+
+  /// Generate code that checks the predicates against the raw zone maps of
+  /// the tile group. The min and max values are compared with the predicate
+  /// values, no type::Value is materialized.
+  llvm::Value *ShouldScanTileGroup(
+      CodeGen &codegen, llvm::Value *tile_group_id, llvm::Value *raw_stats,
+      const std::vector<storage::PredicateInfo> &predicates,
+      const std::vector<codegen::Value> &predicate_values) const;
+
   // The table associated with this generator
   storage::DataTable &table_;
 
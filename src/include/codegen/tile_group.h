@@ -45,6 +45,12 @@ class TileGroup {
                        llvm::Value *column_layouts, uint32_t batch_size,
                        ScanCallback &consumer) const;
 
+  // Generate code that passes the tuples in the range [tid_start, tid_end) of
+  // the provided tile group to the consumer as a single batch
+  void GenerateBatchScan(CodeGen &codegen, llvm::Value *tile_group_ptr,
+                         llvm::Value *column_layouts, llvm::Value *tid_start,
+                         llvm::Value *tid_end, ScanCallback &consumer) const;
+
   llvm::Value *GetNumTuples(CodeGen &codegen, llvm::Value *tile_group) const;
 
   llvm::Value *GetTileGroupId(CodeGen &codegen, llvm::Value *tile_group) const;
@@ -16,6 +16,8 @@
 
 namespace peloton {
 
+class ItemPointer;
+
 namespace concurrency {
 class TransactionContext;
 }  // namespace concurrency
@@ -55,6 +57,14 @@ class TransactionRuntime {
                                         storage::TileGroup &tile_group,
                                         uint32_t *selection_vector,
                                         uint32_t end_idx, bool is_for_update);
+
+  // Walk the version chain that starts at the given location until the
+  // version that is visible to the given transaction is found. Returns false
+  // if the tuple is not visible, otherwise the location is updated to the
+  // visible version
+  static bool FindVisibleVersion(concurrency::TransactionContext &txn,
+                                 ItemPointer &location);
+
   // Check Ownership
   static bool IsOwner(concurrency::TransactionContext &txn,
                       storage::TileGroupHeader *tile_group_header,
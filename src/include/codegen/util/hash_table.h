@@ -45,6 +45,16 @@ namespace util {
  * thread-local hash tables to. Finally, calls to MergeLazyUnfinished() are
  * made concurrently from multiple threads to merge lazily-built thread-local
  * hash tables.
+ *
+ * Lazily built tables can also be radix-partitioned on the high bits of the
+ * hash value. BuildPartitioned() scatters the entries into partitions that are
+ * small enough to be cache-resident, and builds a directory that is indexed by
+ * the high bits of the hash. Thus, each partition owns a contiguous slice of
+ * the directory, which is built one partition at a time. PartitionLazy()
+ * scatters the entries of a second (probe) table into the same partitions as
+ * a built table, without building a directory. Partition i of the probe table
+ * then only ever needs to look at the directory slice of partition i of the
+ * built table.
  */
 class HashTable {
  public:
@@ -135,6 +145,54 @@ class HashTable {
    */
   void MergeLazyUnfinished(HashTable &other);
 
+  /**
+   * Build a radix-partitioned hash table over all elements that have been
+   * lazily inserted into this table. The number of partitions is chosen so
+   * that each partition is roughly cache-sized. After this call, the table is
+   * frozen.
+   */
+  void BuildPartitioned();
+
+  /**
+   * Build a radix-partitioned hash table over all elements that have been
+   * lazily inserted into the thread-local hash tables stored in the thread
+   * states. The thread-local tables are partitioned in parallel, and then each
+   * partition of the directory is built in parallel. After this call, all
+   * entries (and their memory) belong to this table, which is frozen.
+   *
+   * @param thread_states Where thread-local hash tables are located
+   * @param hash_table_offset The offset into each state where the thread-local
+   * hash table can be found.
+   */
+  void BuildPartitionedParallel(
+      const executor::ExecutorContext::ThreadStates &thread_states,
+      uint32_t hash_table_offset);
+
+  /**
+   * Scatter all elements that have been lazily inserted into this table into
+   * the same radix partitions as the given (built) partitioned table. No
+   * directory is built. The entries of each partition can be probed against
+   * the matching partition of the built table.
+   *
+   * @param build_table The radix-partitioned table whose partitioning to use
+   */
+  void PartitionLazy(const HashTable &build_table);
+
+  /**
+   * Scatter all elements that have been lazily inserted into the thread-local
+   * hash tables stored in the thread states into the same radix partitions as
+   * the given (built) partitioned table. Thread-local tables are partitioned
+   * in parallel. After this call, all entries belong to this table.
+   *
+   * @param thread_states Where thread-local hash tables are located
+   * @param hash_table_offset The offset into each state where the thread-local
+   * hash table can be found.
+   * @param build_table The radix-partitioned table whose partitioning to use
+   */
+  void PartitionLazyParallel(
+      const executor::ExecutorContext::ThreadStates &thread_states,
+      uint32_t hash_table_offset, const HashTable &build_table);
+
   //////////////////////////////////////////////////////////////////////////////
   ///
   /// Accessors
@@ -144,6 +202,8 @@ class HashTable {
   uint64_t NumElements() const { return num_elems_; }
   uint64_t Capacity() const { return capacity_; }
   double LoadFactor() const { return num_elems_ / 1.0 / directory_size_; }
+  uint64_t NumPartitions() const { return num_partitions_; }
+  bool IsPartitioned() const { return num_partitions_ > 0; }
 
   //////////////////////////////////////////////////////////////////////////////
   ///
@@ -245,6 +305,11 @@ class HashTable {
      */
     void TransferMemoryBlocks(EntryBuffer &target);
 
+    /**
+     * Return the size of the entries in this buffer.
+     */
+    uint32_t EntrySize() const { return entry_size_; }
+
    private:
     // This struct represents a chunk of heap memory. We chain together these
     // chunks to avoid the need for a std::vector.
@@ -276,6 +341,32 @@ class HashTable {
   // Resize the hash table
   void Resize();
 
+  // The directory index of the given hash value
+  uint64_t BucketIndex(uint64_t hash) const {
+    return IsPartitioned() ? (hash >> directory_shift_)
+                           : (hash & directory_mask_);
+  }
+
+  // The number of radix bits to partition the given number of entries on
+  uint32_t ChoosePartitionBits(uint64_t num_elems) const;
+
+  // Setup (empty) partitions for the given number of radix bits
+  void AllocatePartitions(uint32_t num_partition_bits);
+
+  // Scatter the lazily inserted entries into the given number of partitions
+  void ScatterLazy(uint32_t num_partition_bits);
+
+  // Move the partitioned entries of all thread-local tables into this table
+  void GatherPartitions(
+      const executor::ExecutorContext::ThreadStates &thread_states,
+      uint32_t hash_table_offset, uint32_t num_partition_bits);
+
+  // Allocate a directory indexed by the high bits of the hash value
+  void AllocatePartitionedDirectory();
+
+  // Build the directory slice of the partition with the given index
+  void BuildPartition(uint64_t partition_idx);
+
  private:
   // The memory allocator used for all allocations in this hash table
   ::peloton::type::AbstractPool &memory_;
@@ -293,8 +384,16 @@ class HashTable {
   uint64_t num_elems_;
   uint64_t capacity_;
 
-  // Info about partitions
-  // ...
+  // Info about partitions. In partitioned mode, the directory is indexed by
+  // the high bits of the hash; 'directory_shift_' is the shift to apply to the
+  // hash to find its bucket. The partitions are lists of entries (with both
+  // heads and tails to allow cheap concatenation) that are consumed when the
+  // directory is built.
+  uint64_t directory_shift_;
+  uint64_t num_partitions_;
+  Entry **partition_heads_;
+  Entry **partition_tails_;
+  uint32_t num_partition_bits_;
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -322,7 +421,7 @@ template <typename Key, typename Value>
 bool HashTable::TypedProbe(uint64_t hash, const Key &key,
                            std::function<void(const Value &)> &consumer) {
   // Initial index in the directory
-  uint64_t index = hash & directory_mask_;
+  uint64_t index = BucketIndex(hash);
 
   auto *entry = directory_[index];
   if (entry == nullptr) {
@@ -40,6 +40,9 @@ class Sorter {
   // We allocate 4KB of buffer space upon initialization
   static constexpr uint64_t kInitialBufferSize = 4 * 1024;
 
+  // The minimum number of sorted tuples each task scans in a parallel scan
+  static constexpr uint64_t kMinTuplesPerScanTask = 1024;
+
   using TupleList = std::vector<char *>;
 
  public:
@@ -147,6 +150,24 @@ class Sorter {
       const executor::ExecutorContext::ThreadStates &thread_states,
       uint32_t sorter_offset, uint64_t top_k);
 
+  /**
+   * Scan the sorted contents of the given sorter instance in parallel. The
+   * sorted tuples are split into disjoint, contiguous ranges, one per task.
+   * The given scan function is invoked once per range with the query state,
+   * the task's thread state and the [start, end) range of tuple indexes to
+   * scan. Within each range, tuples are visited in sort order.
+   *
+   * @param query_state The (opaque) query state
+   * @param thread_states The states object where each task's state lives
+   * @param sorter The sorted sorter instance to scan
+   * @param func The scan function, with signature:
+   * void (*)(void *query_state, void *thread_state, uint64_t start,
+   *          uint64_t end)
+   */
+  static void ScanParallel(
+      void *query_state, executor::ExecutorContext::ThreadStates &thread_states,
+      Sorter &sorter, void *func);
+
   //////////////////////////////////////////////////////////////////////////////
   ///
   /// Accessors
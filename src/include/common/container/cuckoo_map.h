@@ -16,6 +16,7 @@
 #include <cstdlib>
 #include <cstring>
 #include <cstdio>
+#include <functional>
 
 #include "libcuckoo/cuckoohash_map.hh"
 #include "libcuckoo/default_hasher.hh"
@@ -58,9 +59,26 @@ class CuckooMap {
   // Extracts item with high priority
   bool Update(const KeyType &key, ValueType value);
 
+  // Runs the function on the value of the key while holding its bucket
+  // locks. Returns false if the key is not present
+  bool UpdateFn(const KeyType &key, std::function<void(ValueType &)> fn);
+
+  // Runs the function on the value of the key if present, inserts the item
+  // otherwise. Like Upsert, this always succeeds
+  void UpsertFn(const KeyType &key, std::function<void(ValueType &)> fn,
+                ValueType value);
+
+  // Runs the function on the value of the key and erases the key if the
+  // function returns true. Returns false if the key is not present
+  bool EraseFn(const KeyType &key, std::function<bool(ValueType &)> fn);
+
   // Extracts the corresponding value
   bool Find(const KeyType &key, ValueType &value) const;
 
+  // Brings the buckets of the key into the cache without locking them, so
+  // that a batch of lookups can overlap its cache misses
+  void Prefetch(const KeyType &key) const;
+
   // Delete key from the cuckoo_map
   bool Erase(const KeyType &key);
 
@@ -76,6 +94,11 @@ class CuckooMap {
   // Checks if the cuckoo_map is empty
   bool IsEmpty() const;
 
+  // Estimates the bytes held by the table itself. Every slot of every bucket
+  // stores a key-value pair and a partial key, occupied or not. Memory the
+  // values point to is not included
+  size_t GetMemoryFootprint() const;
+
   // Lock the table and get iterator
   // The table would be unlock when the iterator
   // is out of scope
@@ -373,7 +373,8 @@ enum class SqlStateErrorCode {
 
 enum class ProtocolType {
   INVALID = INVALID_TYPE_ID,
-  TIMESTAMP_ORDERING = 1  // timestamp ordering
+  TIMESTAMP_ORDERING = 1,  // timestamp ordering
+  OPTIMISTIC = 2           // optimistic concurrency control
 };
 std::string ProtocolTypeToString(ProtocolType type);
 ProtocolType StringToProtocolType(const std::string &str);
@@ -1232,11 +1233,6 @@ std::string RWTypeToString(RWType type);
 RWType StringToRWType(const std::string &str);
 std::ostream &operator<<(std::ostream &os, const RWType &type);
 
-// ItemPointer -> type
-typedef tbb::concurrent_unordered_map<ItemPointer, RWType, ItemPointerHasher,
-                                      ItemPointerComparator>
-    ReadWriteSet;
-
 typedef tbb::concurrent_unordered_set<ItemPointer, ItemPointerHasher,
                                       ItemPointerComparator>
     WriteSet;
@@ -1256,9 +1252,8 @@ std::string GCVersionTypeToString(GCVersionType type);
 GCVersionType StringToGCVersionType(const std::string &str);
 std::ostream &operator<<(std::ostream &os, const GCVersionType &type);
 
-// block -> offset -> type
-typedef std::unordered_map<oid_t, std::unordered_map<oid_t, GCVersionType>>
-    GCSet;
+// location -> type, in the order the versions were added
+typedef std::vector<std::pair<ItemPointer, GCVersionType>> GCSet;
 
 enum class DDLType {
   INVALID,
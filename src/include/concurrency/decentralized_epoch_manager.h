@@ -40,6 +40,11 @@ public:
     current_global_epoch_id_(1), 
     next_txn_id_(0),
     snapshot_global_epoch_id_(1),
+    expired_global_epoch_id_(0),
+    persist_global_epoch_id_(INVALID_EID),
+    epoch_flush_time_us_(0),
+    epoch_length_(EPOCH_LENGTH),
+    epoch_txn_count_(0),
     is_running_(false) {
       // register a default thread for handling catalog stuffs.
       RegisterThread(0);
@@ -71,6 +76,11 @@ public:
     current_global_epoch_id_ = current_epoch_id;
     next_txn_id_ = 0;
     snapshot_global_epoch_id_ = 1;
+    expired_global_epoch_id_ = 0;
+    persist_global_epoch_id_ = INVALID_EID;
+    epoch_flush_time_us_ = 0;
+    epoch_length_ = EPOCH_LENGTH;
+    epoch_txn_count_ = 0;
     local_epochs_.clear();
     
     RegisterThread(0);
@@ -184,6 +194,36 @@ public:
     return current_global_epoch_id_.load();
   }  
 
+  virtual uint64_t GetEpochLength() override {
+    return epoch_length_.load();
+  }
+
+  virtual uint64_t GetEpochTransactionCount() override {
+    return epoch_txn_count_.load();
+  }
+
+  virtual uint64_t GetActiveTransactionCount(
+      const eid_t max_epoch_id = MAX_EID) override;
+
+  virtual uint64_t GetEpochLag() override;
+
+  virtual uint64_t GetPersistEpochLag() override;
+
+  virtual void ReportEpochFlush(const eid_t persist_epoch_id,
+                                const uint64_t flush_time_us) override {
+    persist_global_epoch_id_ = persist_epoch_id;
+    epoch_flush_time_us_ = flush_time_us;
+  }
+
+  /**
+   * @brief      Computes the length of the next epoch from the number of
+   *             transactions that began in the last one. The epoch is never
+   *             shorter than the last log flush.
+   *
+   * @param[in]  txn_count  The transaction count of the last epoch
+   */
+  void AdjustEpochLength(const uint64_t txn_count);
+
 private:
 
 
@@ -197,23 +237,14 @@ private:
   }
 
 
-  void Running() {
-
-    PELOTON_ASSERT(is_running_ == true);
-
-    while (is_running_ == true) {
-      gc::TransactionLevelGCManager::GetInstance().InsertEpochNode(current_global_epoch_id_);
-      // the epoch advances every EPOCH_LENGTH milliseconds.
-      std::this_thread::sleep_for(std::chrono::milliseconds(EPOCH_LENGTH));
-      current_global_epoch_id_.fetch_add(1);
-    }
-  }
+  void Running();
 
 private:
 
   /**
    * Each thread holds a pointer to a local epoch.
    * It updates the local epoch to report their local time.
+   * Walking local_epochs_ requires local_epoch_lock_.
    */
   common::synchronization::SpinLatch local_epoch_lock_;
   std::unordered_map<int, std::unique_ptr<LocalEpoch>> local_epochs_;
@@ -226,7 +257,25 @@ private:
    * Snapshot epoch is an epoch where the corresponding tuples may be still
    * visible to on-the-fly transactions
    */
-  eid_t snapshot_global_epoch_id_;
+  std::atomic<eid_t> snapshot_global_epoch_id_;
+
+  /**
+   * The expired epoch last computed by GetExpiredEpochId(). The epoch thread
+   * refreshes it whenever the epoch advances.
+   */
+  std::atomic<eid_t> expired_global_epoch_id_;
+
+  /** The last durable epoch reported by the log manager */
+  std::atomic<eid_t> persist_global_epoch_id_;
+
+  /** How long the last log flush took, in microseconds */
+  std::atomic<uint64_t> epoch_flush_time_us_;
+
+  /** Length of the current epoch in milliseconds */
+  std::atomic<uint64_t> epoch_length_;
+
+  /** Number of transactions that began in the last completed epoch */
+  std::atomic<uint64_t> epoch_txn_count_;
 
   bool is_running_;
 
@@ -104,6 +104,65 @@ public:
    */
   virtual cid_t GetExpiredCid() = 0;
 
+  //====================================================
+  // epoch statistics
+  //====================================================
+
+  /**
+   * @brief      Gets the length of the current epoch in milliseconds.
+   *
+   * @return     The epoch length.
+   */
+  virtual uint64_t GetEpochLength() = 0;
+
+  /**
+   * @brief      Gets the number of transactions that began in the last
+   *             completed epoch.
+   *
+   * @return     The epoch transaction count.
+   */
+  virtual uint64_t GetEpochTransactionCount() = 0;
+
+  /**
+   * @brief      Gets the number of transactions that are still in an epoch.
+   *
+   * @param[in]  max_epoch_id  Only transactions in this epoch or an earlier
+   *                           one are counted
+   *
+   * @return     The active transaction count.
+   */
+  virtual uint64_t GetActiveTransactionCount(
+      const eid_t max_epoch_id = MAX_EID) = 0;
+
+  /**
+   * @brief      Gets the number of epochs between the current epoch and the
+   *             last expired epoch. A growing lag means that a long running
+   *             transaction holds back garbage collection.
+   *
+   * @return     The epoch lag.
+   */
+  virtual uint64_t GetEpochLag() = 0;
+
+  /**
+   * @brief      Gets the number of epochs between the current epoch and the
+   *             last durable epoch, or 0 if logging is off.
+   *
+   * @return     The persist epoch lag.
+   */
+  virtual uint64_t GetPersistEpochLag() = 0;
+
+  /**
+   * @brief      Called by the log manager whenever it has made epochs
+   *             durable. Every epoch is one group commit, so the epoch length
+   *             is kept above the time a flush takes.
+   *
+   * @param[in]  persist_epoch_id  The last durable epoch, or INVALID_EID once
+   *                               logging stops
+   * @param[in]  flush_time_us     How long the flush took, in microseconds
+   */
+  virtual void ReportEpochFlush(const eid_t persist_epoch_id,
+                                const uint64_t flush_time_us) = 0;
+
 };
 
 }
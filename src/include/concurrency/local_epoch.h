@@ -76,6 +76,17 @@ public:
    */
   uint64_t GetExpiredEpochId(const uint64_t current_epoch_id);
 
+  /**
+   * @brief      Gets the number of transactions that have entered an epoch
+   *             in this thread and not exited it yet.
+   *
+   * @param[in]  max_epoch_id  Only transactions in this epoch or an earlier
+   *                           one are counted
+   *
+   * @return     The active transaction count.
+   */
+  size_t GetActiveTransactionCount(const eid_t max_epoch_id);
+
 private:
   common::synchronization::SpinLatch epoch_lock_;
   
@@ -0,0 +1,97 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// optimistic_transaction_manager.h
+//
+// Identification:
+// src/include/concurrency/optimistic_transaction_manager.h
+//
+// Copyright (c) 2015-18, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "concurrency/timestamp_ordering_transaction_manager.h"
+
+namespace peloton {
+namespace concurrency {
+
+//===--------------------------------------------------------------------===//
+// optimistic concurrency control
+//===--------------------------------------------------------------------===//
+
+/**
+ * @brief      Class for optimistic (Silo-style) transaction manager.
+ *
+ * Writes acquire ownership of the tuples eagerly, exactly as in timestamp
+ * ordering. Reads under SERIALIZABLE and REPEATABLE_READS do not touch the
+ * tuple headers, but are buffered in the read write set. At commit, the
+ * transaction draws its commit id from the epoch manager, and then checks
+ * that every version it read is still the latest committed version of its
+ * tuple. Reads of versions created by other transactions in the meantime
+ * fail the validation, and the transaction aborts.
+ *
+ * Phantoms are not detected, as index scans are not validated.
+ */
+class OptimisticTransactionManager
+    : public TimestampOrderingTransactionManager {
+ public:
+  OptimisticTransactionManager() {}
+
+  /**
+   * @brief      Destroys the object.
+   */
+  virtual ~OptimisticTransactionManager() {}
+
+  /**
+   * @brief      Gets the instance.
+   *
+   * @param[in]  protocol   The protocol
+   * @param[in]  isolation  The isolation
+   * @param[in]  conflict   The conflict
+   *
+   * @return     The instance.
+   */
+  static OptimisticTransactionManager &GetInstance(
+      const ProtocolType protocol,
+      const IsolationLevelType isolation,
+      const ConflictAvoidanceType conflict);
+
+  /**
+   * @brief      Perform a read operation
+   *
+   * @param      current_txn        The current transaction
+   * @param[in]  location           The location of the tuple to be read
+   * @param[in]  tile_group_header  Pointer to the tile group header
+   * @param[in]  acquire_ownership  The acquire ownership
+   */
+  virtual bool PerformRead(TransactionContext *const current_txn,
+                           const ItemPointer &location,
+                           storage::TileGroupHeader *tile_group_header,
+                           bool acquire_ownership) override;
+
+  /**
+   * @brief      Validates the reads of a transaction and commits it.
+   *
+   * @param      current_txn  The current transaction
+   *
+   * @return     The result type
+   */
+  virtual ResultType CommitTransaction(
+      TransactionContext *const current_txn) override;
+
+ private:
+  /**
+   * @brief      Checks whether every version read by the transaction is
+   *             still the latest committed version of its tuple.
+   *
+   * @param      current_txn  The current transaction
+   *
+   * @return     True if the reads are still valid, False otherwise
+   */
+  bool ValidateReadSet(TransactionContext *const current_txn);
+};
+}
+}
@@ -0,0 +1,173 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// read_write_set.h
+//
+// Identification: src/include/concurrency/read_write_set.h
+//
+// Copyright (c) 2015-18, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "common/internal_types.h"
+#include "common/item_pointer.h"
+
+namespace peloton {
+namespace concurrency {
+
+//===--------------------------------------------------------------------===//
+// ReadWriteSet
+//===--------------------------------------------------------------------===//
+
+/**
+ * @brief      The tuple versions a transaction has accessed, and how.
+ *
+ * The entries are kept in a flat array in the order they were recorded, and
+ * are looked up through an open-addressing table of positions in that array.
+ * Clear() keeps the memory of both, so a recycled set does not allocate
+ * again unless it outgrows the previous transaction.
+ */
+class ReadWriteSet {
+ public:
+  typedef std::pair<ItemPointer, RWType> Entry;
+  typedef std::vector<Entry>::const_iterator const_iterator;
+
+  ReadWriteSet() : sorted_(true) {}
+
+  /**
+   * @brief      Finds the type recorded for a location.
+   *
+   * @param[in]  location  The location
+   *
+   * @return     The type, or nullptr if the location is not in the set.
+   */
+  RWType *Find(const ItemPointer &location) {
+    if (slots_.empty()) {
+      return nullptr;
+    }
+    size_t mask = slots_.size() - 1;
+    for (size_t pos = ItemPointerHasher()(location) & mask;;
+         pos = (pos + 1) & mask) {
+      uint32_t slot = slots_[pos];
+      if (slot == kEmptySlot) {
+        return nullptr;
+      }
+      if (entries_[slot].first == location) {
+        return &entries_[slot].second;
+      }
+    }
+  }
+
+  const RWType *Find(const ItemPointer &location) const {
+    return const_cast<ReadWriteSet *>(this)->Find(location);
+  }
+
+  /**
+   * @brief      Sets the type of a location, adding the location if it is
+   *             not in the set yet.
+   *
+   * @param[in]  location  The location
+   * @param[in]  type      The type
+   */
+  void Set(const ItemPointer &location, const RWType type) {
+    RWType *existing = Find(location);
+    if (existing != nullptr) {
+      *existing = type;
+      return;
+    }
+
+    if ((entries_.size() + 1) * 2 > slots_.size()) {
+      Rehash(slots_.empty() ? static_cast<size_t>(kMinSlotCount)
+                          : slots_.size() * 2);
+    }
+    if (entries_.empty() == false && location < entries_.back().first) {
+      sorted_ = false;
+    }
+    entries_.emplace_back(location, type);
+    InsertSlot(static_cast<uint32_t>(entries_.size() - 1));
+  }
+
+  /**
+   * @brief      Orders the entries by tile group, and by offset within a tile
+   *             group, so that iterating the set touches each tile group
+   *             once.
+   */
+  void SortByTileGroup() {
+    if (sorted_) {
+      return;
+    }
+    std::sort(entries_.begin(), entries_.end(),
+              [](const Entry &lhs, const Entry &rhs) {
+                return lhs.first < rhs.first;
+              });
+    Rehash(slots_.size());
+    sorted_ = true;
+  }
+
+  /**
+   * @brief      Empties the set. The memory is kept unless a large
+   *             transaction made the set grow past kMaxRetainedSlotCount.
+   */
+  void Clear() {
+    entries_.clear();
+    if (slots_.size() > kMaxRetainedSlotCount) {
+      std::vector<uint32_t>().swap(slots_);
+      std::vector<Entry>().swap(entries_);
+    } else {
+      std::fill(slots_.begin(), slots_.end(), kEmptySlot);
+    }
+    sorted_ = true;
+  }
+
+  size_t size() const { return entries_.size(); }
+
+  bool empty() const { return entries_.empty(); }
+
+  const_iterator begin() const { return entries_.begin(); }
+
+  const_iterator end() const { return entries_.end(); }
+
+ private:
+  void InsertSlot(const uint32_t slot) {
+    size_t mask = slots_.size() - 1;
+    size_t pos = ItemPointerHasher()(entries_[slot].first) & mask;
+    while (slots_[pos] != kEmptySlot) {
+      pos = (pos + 1) & mask;
+    }
+    slots_[pos] = slot;
+  }
+
+  void Rehash(const size_t slot_count) {
+    slots_.assign(slot_count, kEmptySlot);
+    for (uint32_t slot = 0; slot < entries_.size(); slot++) {
+      InsertSlot(slot);
+    }
+  }
+
+  enum : uint32_t {
+    kEmptySlot = UINT32_MAX,
+    // Must be a power of two
+    kMinSlotCount = 16,
+    kMaxRetainedSlotCount = 4096
+  };
+
+  // The entries in the order they were recorded, or sorted
+  std::vector<Entry> entries_;
+
+  // Positions in entries_, kEmptySlot if free
+  std::vector<uint32_t> slots_;
+
+  // Whether the entries are ordered by location
+  bool sorted_;
+};
+
+}  // namespace concurrency
+}  // namespace peloton
@@ -23,6 +23,8 @@
 #include "common/item_pointer.h"
 #include "common/printable.h"
 #include "common/internal_types.h"
+#include "common/synchronization/spin_latch.h"
+#include "concurrency/read_write_set.h"
 
 namespace peloton {
 
@@ -42,6 +44,7 @@ namespace concurrency {
  */
 class TransactionContext : public Printable {
   TransactionContext(TransactionContext const &) = delete;
+  friend class TransactionContextPool;
 
  public:
   TransactionContext(const size_t thread_id, const IsolationLevelType isolation,
@@ -64,6 +67,12 @@ class TransactionContext : public Printable {
   void Init(const size_t thread_id, const IsolationLevelType isolation,
             const cid_t &read_id, const cid_t &commit_id);
 
+  /**
+   * @brief      Drops the state of a finished transaction, keeping the memory
+   *             of its containers, so that the context can be reused.
+   */
+  void Clear();
+
  public:
   //===--------------------------------------------------------------------===//
   // Mutators and Accessors
@@ -90,6 +99,14 @@ class TransactionContext : public Printable {
    */
   inline cid_t GetReadId() const { return read_id_; }
 
+  /**
+   * @brief      Moves the snapshot of the transaction forward. The epoch the
+   *             transaction was registered in does not change.
+   *
+   * @param[in]  read_id  The read identifier
+   */
+  inline void SetReadId(const cid_t read_id) { read_id_ = read_id; }
+
   /**
    * @brief      Gets the commit identifier.
    *
@@ -159,6 +176,8 @@ class TransactionContext : public Printable {
                                 index_oid, DDLType::DROP));
   }
 
+  void RecordRead(const ItemPointer &);
+
   void RecordReadOwn(const ItemPointer &);
 
   void RecordUpdate(const ItemPointer &);
@@ -192,15 +211,30 @@ class TransactionContext : public Printable {
    * @return     True if in rw set, False otherwise.
    */
   bool IsInRWSet(const ItemPointer &location) {
-    return (rw_set_.find(location) != rw_set_.end());
+    rw_set_latch_.Lock();
+    bool in_rw_set = (rw_set_.Find(location) != nullptr);
+    rw_set_latch_.Unlock();
+    return in_rw_set;
   }
 
   /**
-   * @brief      Gets the read write set.
+   * @brief      Gets the read write set. It is only iterated at commit or
+   *             abort, when no other thread works on the transaction.
    *
    * @return     The read write set.
    */
   inline const ReadWriteSet &GetReadWriteSet() const { return rw_set_; }
+
+  /**
+   * @brief      Orders the read write set by tile group before it is
+   *             iterated at commit or abort.
+   */
+  inline void SortReadWriteSet() {
+    rw_set_latch_.Lock();
+    rw_set_.SortByTileGroup();
+    rw_set_latch_.Unlock();
+  }
+
   inline const CreateDropSet &GetCreateDropSet() { return rw_object_set_; }
 
   /**
@@ -208,7 +242,7 @@ class TransactionContext : public Printable {
    *
    * @return     The gc set pointer.
    */
-  inline std::shared_ptr<GCSet> GetGCSetPtr() { return gc_set_; }
+  inline GCSet *GetGCSetPtr() { return &gc_set_; }
 
   /**
    * @brief      Gets the gc object set pointer.
@@ -224,7 +258,7 @@ class TransactionContext : public Printable {
    *
    * @return     True if gc set empty, False otherwise.
    */
-  inline bool IsGCSetEmpty() { return gc_set_->size() == 0; }
+  inline bool IsGCSetEmpty() { return gc_set_.size() == 0; }
 
   /**
    * @brief      Determines if gc object set empty.
@@ -339,12 +373,18 @@ class TransactionContext : public Printable {
   uint64_t timestamp_;
 
   ReadWriteSet rw_set_;
+  /**
+   * parallel scans and index probes may use the read write set of the same
+   * transaction concurrently. every access to rw_set_ holds this latch, since
+   * a new entry can rehash the set.
+   */
+  common::synchronization::SpinLatch rw_set_latch_;
   CreateDropSet rw_object_set_;
 
   /** 
    * this set contains data location that needs to be gc'd in the transaction. 
    */
-  std::shared_ptr<GCSet> gc_set_;
+  GCSet gc_set_;
   std::shared_ptr<GCObjectSet> gc_object_set_;
 
   /** result of the transaction */
@@ -0,0 +1,89 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// transaction_context_pool.h
+//
+// Identification: src/include/concurrency/transaction_context_pool.h
+//
+// Copyright (c) 2015-18, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+
+#include "common/container/lock_free_queue.h"
+#include "common/internal_types.h"
+
+namespace peloton {
+namespace concurrency {
+
+class TransactionContext;
+
+//===--------------------------------------------------------------------===//
+// TransactionContextPool
+//===--------------------------------------------------------------------===//
+
+/**
+ * @brief      Recycles transaction contexts, together with the memory of
+ *             their read write sets and GC sets.
+ *
+ * Each thread keeps a small free list of the contexts it released itself,
+ * which it reuses without any synchronization. Contexts released by other
+ * threads, such as the GC threads, go through a shared lock-free queue.
+ */
+class TransactionContextPool {
+ public:
+  static TransactionContextPool &GetInstance();
+
+  /**
+   * @brief      Gets a context for a new transaction.
+   *
+   * @param[in]  thread_id  The thread identifier
+   * @param[in]  isolation  The isolation level
+   * @param[in]  read_id    The read identifier
+   * @param[in]  commit_id  The commit identifier
+   *
+   * @return     The transaction context.
+   */
+  TransactionContext *Acquire(const size_t thread_id,
+                              const IsolationLevelType isolation,
+                              const cid_t &read_id, const cid_t &commit_id);
+
+  TransactionContext *Acquire(const size_t thread_id,
+                              const IsolationLevelType isolation,
+                              const cid_t &read_id) {
+    return Acquire(thread_id, isolation, read_id, read_id);
+  }
+
+  /**
+   * @brief      Returns the context of a finished transaction. The calling
+   *             thread reuses it first.
+   *
+   * @param      txn   The transaction context
+   */
+  void Release(TransactionContext *txn);
+
+  /**
+   * @brief      Returns the context of a finished transaction from a thread
+   *             that does not begin transactions, e.g. a GC thread.
+   *
+   * @param      txn   The transaction context
+   */
+  void ReleaseShared(TransactionContext *txn);
+
+ private:
+  TransactionContextPool();
+
+  // Contexts released through ReleaseShared(), or by threads whose own free
+  // list was full
+  LockFreeQueue<TransactionContext *> shared_contexts_;
+
+  // Approximate number of contexts in shared_contexts_
+  std::atomic<size_t> shared_context_count_;
+};
+
+}  // namespace concurrency
+}  // namespace peloton
@@ -94,6 +94,21 @@ class TransactionManager {
       const oid_t &tuple_id,
       const VisibilityIdType type = VisibilityIdType::READ_ID);
 
+  /**
+   * @brief      Waits until every other transaction that began before this
+   *             call has finished, then moves the snapshot of the current
+   *             transaction forward so that it reads their commits. Used by
+   *             DDL that must not miss writes made before it became visible
+   *             to writers, e.g. an index built online.
+   *
+   * @param      current_txn  The current transaction
+   * @param[in]  timeout_ms   How long to wait, in milliseconds
+   *
+   * @return     False if older transactions were still running at the timeout.
+   */
+  bool WaitForOlderTransactions(TransactionContext *const current_txn,
+                                const size_t timeout_ms);
+
   /**
    * Test whether the current transaction is the owner of this tuple.
    *
@@ -61,6 +61,25 @@ class IndexScanExecutor : public AbstractScanExecutor {
   bool ExecPrimaryIndexLookup();
   bool ExecSecondaryIndexLookup();
 
+  // If the scan binds every index key column with = or IN (...), look up all
+  // combinations of the bound values as one batch of point keys. An IN list
+  // is either one array value or one IN entry per element. All IN entries of
+  // a column are merged, which can only widen the lookup, since the scan
+  // predicate is still checked. Returns false without scanning if the scan
+  // predicate has any other shape.
+  bool ExecInListLookup(std::vector<ItemPointer *> &tuple_location_ptrs);
+
+  // Answer a scan that only reads columns stored in the index. The tuples of
+  // all-visible tile groups are produced from the index keys without reading
+  // the table. Falls back to the lookups above if the index can not hand
+  // back its keys.
+  bool ExecIndexOnlyLookup();
+
+  // Walk the version chain that starts at the given location until the
+  // version that is visible to the transaction is found. Returns false if
+  // there is none, otherwise the location is updated to the visible version.
+  bool FindVisibleVersion(ItemPointer &tuple_location);
+
   // When the required scan range has open boundaries, the tuples found by the
   // index might not be exact since the index can only give back tuples in a
   // close range. This function prune the head and the tail of the returned
@@ -134,6 +153,9 @@ class IndexScanExecutor : public AbstractScanExecutor {
 
   // whether order by is descending
   bool descend_ = false;
+
+  // whether the tuples can be produced from the index keys
+  bool index_only_ = false;
 };
 
 }  // namespace executor
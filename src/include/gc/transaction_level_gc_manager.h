@@ -16,6 +16,7 @@
 #include <map>
 #include <thread>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "common/init.h"
@@ -53,6 +54,7 @@ class TransactionLevelGCManager : public GCManager {
  public:
   TransactionLevelGCManager(const int thread_count)
       : gc_thread_count_(thread_count), reclaim_maps_(thread_count),
+        visibility_candidates_(thread_count),
         epoch_tree_(), garbage_queue_(MAX_QUEUE_LENGTH) {
     unlink_queues_.reserve(thread_count);
     for (int i = 0; i < gc_thread_count_; ++i) {
@@ -82,6 +84,8 @@ class TransactionLevelGCManager : public GCManager {
 
     reclaim_maps_.clear();
     reclaim_maps_.resize(gc_thread_count_);
+    visibility_candidates_.clear();
+    visibility_candidates_.resize(gc_thread_count_);
     recycle_queue_map_.clear();
 
     is_running_ = false;
@@ -146,6 +150,15 @@ class TransactionLevelGCManager : public GCManager {
 
   int Reclaim(const int &thread_id);
 
+  /**
+   * @brief Marks the tile groups written by reclaimed transactions
+   * all-visible once every active transaction can see all of their tuples.
+   * See TileGroupHeader::IsAllVisible().
+   *
+   * @return The number of tile groups marked all-visible.
+   */
+  int MarkAllVisible(const int &thread_id);
+
   EpochLeafNode* GetEpochNode(const eid_t &epoch_id);
 
   void InsertEpochNode(const eid_t &epoch_id);
@@ -179,6 +192,11 @@ class TransactionLevelGCManager : public GCManager {
 
   bool ResetTuple(const ItemPointer &);
 
+  // this function remembers the tile groups in which the transaction inserted
+  // or reclaimed tuples, so that MarkAllVisible() checks them.
+  void AddVisibilityCandidates(const int &thread_id,
+                               concurrency::TransactionContext *txn_ctx);
+
   // this function iterates the gc context and unlinks every version
   // from the indexes.
   // this function will call the UnlinkVersion() function.
@@ -212,6 +230,10 @@ class TransactionLevelGCManager : public GCManager {
   std::vector<std::set<concurrency::TransactionContext* >>
       reclaim_maps_;
 
+  // tile groups that may have become all-visible.
+  // # visibility_candidates == # gc_threads
+  std::vector<std::unordered_set<oid_t>> visibility_candidates_;
+
   // queues for to-be-reused tuples.
   // # recycle_queue_maps == # tables
   std::unordered_map<oid_t,
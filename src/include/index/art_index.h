@@ -12,6 +12,8 @@
 
 #pragma once
 
+#include <limits>
+
 #include "adaptive_radix_tree/Tree.h"
 #include "index/index.h"
 
@@ -29,6 +31,16 @@ class ArtIndex : public Index {
  public:
   explicit ArtIndex(IndexMetadata *metadata);
 
+  /**
+   * @param metadata The index metadata
+   * @param store_keys Whether the leaves keep a copy of the full key. If so,
+   * lookups and scans never load keys from the table. Otherwise the keys are
+   * loaded from the table through the load-key function, which costs less
+   * memory but a random tuple access for every key comparison below a long
+   * compressed prefix.
+   */
+  ArtIndex(IndexMetadata *metadata, bool store_keys);
+
   // Forward declare iterator class for later
   class Iterator;
 
@@ -39,6 +51,14 @@ class ArtIndex : public Index {
   bool CondInsertEntry(const storage::Tuple *key, ItemPointer *value,
                        std::function<bool(const void *)> predicate) override;
 
+  /**
+   * Sorts the keys and inserts contiguous ranges of them from several
+   * threads. Neighboring keys in a range share most of their path, which
+   * stays in cache, and the ranges touch mostly disjoint subtrees.
+   */
+  bool BulkInsert(const std::vector<const storage::Tuple *> &keys,
+                  const std::vector<ItemPointer *> &values) override;
+
   /**
    * Perform a range scan of keys between [start,end] inclusive.
    *
@@ -66,7 +86,9 @@ class ArtIndex : public Index {
 
   /**
    * ArtIndex throws away the first three arguments and only uses the conjuncts
-   * from the scan predicate.
+   * from the scan predicate. Like the other indexes, only a forward scan with
+   * limit == 1 and offset == 0 is pushed down. It stops at the first entry
+   * within the bounds. Everything else falls back to Scan().
    *
    * @param scan_predicate The only parameter that's used
    * @param[out] result Where the results of the scan are stored
@@ -86,13 +108,19 @@ class ArtIndex : public Index {
   void ScanKey(const storage::Tuple *key,
                std::vector<ItemPointer *> &result) override;
 
+  void ScanKeyBatch(const std::vector<const storage::Tuple *> &keys,
+                    std::vector<std::vector<ItemPointer *>> &results) override;
+
   /// Return the index type
   std::string GetTypeName() const override {
     return IndexTypeToString(GetIndexMethodType());
   }
 
-  // TODO(pmenon): Implement me
-  size_t GetMemoryFootprint() override { return 0; }
+  size_t GetMemoryFootprint() override { return container_.getMemoryUsage(); }
+
+  size_t GetGarbageFootprint() override {
+    return container_.getGarbageMemoryUsage();
+  }
 
   // TODO(pmenon): Implement me
   bool NeedGC() override { return false; }
@@ -109,9 +137,14 @@ class ArtIndex : public Index {
    * @param load_func The loading key function pointer
    * @param ctx An opaque pointer to some user-provided context. This context is
    * passed as the first argument to the load-key function on each invocation.
+   *
+   * Has no effect if the index stores the keys in its leaves.
    */
   void SetLoadKeyFunc(art::Tree::LoadKeyFunction load_func, void *ctx);
 
+  /// Whether the leaves keep a copy of the full key
+  bool StoresKeys() const { return container_.storesKeys(); }
+
   /**
    * Convert the provided Peloton key into an ART-based key
    *
@@ -123,8 +156,11 @@ class ArtIndex : public Index {
   }
 
  private:
+  // Scan the keys between [start,end] inclusive, stopping once at least
+  // max_results entries have been found
   void ScanRange(const art::Key &start, const art::Key &end,
-                 std::vector<ItemPointer *> &result);
+                 std::vector<ItemPointer *> &result,
+                 uint32_t max_results = std::numeric_limits<uint32_t>::max());
 
   //===--------------------------------------------------------------------===//
   //
@@ -1748,13 +1748,47 @@ class BwTree : public BwTreeBase {
     // This forms a linked list which needs to be traversed in order to
     // free chunks of memory
     std::atomic<AllocationMeta *> next;
+    // Number of bytes allocated for this chunk, including the base node
+    // for the first chunk in the list
+    const size_t size;
+    // The footprint counter of the tree owning this chunk. Allocations
+    // and frees of chunks are reflected on this counter
+    std::atomic<size_t> *const footprint_p;
 
    public:
     /*
      * Constructor
      */
-    AllocationMeta(char *p_tail, char *p_limit)
-        : tail{p_tail}, limit{p_limit}, next{nullptr} {}
+    AllocationMeta(char *p_tail, char *p_limit, size_t p_size,
+                   std::atomic<size_t> *p_footprint_p)
+        : tail{p_tail},
+          limit{p_limit},
+          next{nullptr},
+          size{p_size},
+          footprint_p{p_footprint_p} {}
+
+    /*
+     * GetFootprintCounter() - Returns the counter of the owning tree
+     */
+    inline std::atomic<size_t> *GetFootprintCounter() const {
+      return footprint_p;
+    }
+
+    /*
+     * GetTotalSize() - Returns the number of bytes of all chunks in the list
+     *
+     * This is only accurate if no other thread could grow the list, i.e.
+     * the node has been unlinked from the tree
+     */
+    size_t GetTotalSize() const {
+      size_t total_size = 0;
+      for (const AllocationMeta *meta_p = this; meta_p != nullptr;
+           meta_p = meta_p->next.load()) {
+        total_size += meta_p->size;
+      }
+
+      return total_size;
+    }
 
     /*
      * TryAllocate() - Try to allocate from this chunk
@@ -1815,13 +1849,15 @@ class BwTree : public BwTreeBase {
       // and let tail points to the first byte after this chunk, and the limit
       // is the first byte after AllocationMeta
       new (new_meta_base)
-          AllocationMeta{new_chunk + CHUNK_SIZE(),             // tail
-                         new_chunk + sizeof(AllocationMeta)};  // limit
+          AllocationMeta{new_chunk + CHUNK_SIZE(),            // tail
+                         new_chunk + sizeof(AllocationMeta),  // limit
+                         CHUNK_SIZE(), footprint_p};
 
       // Always CAS with nullptr such that we will never install/replace
       // a chunk that has already been installed here
       bool ret = next.compare_exchange_strong(expected, new_meta_base);
       if (ret == true) {
+        footprint_p->fetch_add(CHUNK_SIZE());
         return new_meta_base;
       }
 
@@ -1881,6 +1917,10 @@ class BwTree : public BwTreeBase {
     void Destroy() {
       AllocationMeta *meta_p = this;
 
+      // Saved since the counter pointer is freed together with this chunk
+      std::atomic<size_t> *counter_p = footprint_p;
+      size_t freed_size = 0;
+
       while (meta_p != nullptr) {
         // Save the next pointer to traverse to it later
         AllocationMeta *next_p = meta_p->next.load();
@@ -1889,12 +1929,15 @@ class BwTree : public BwTreeBase {
         // 2. Delete it as a char[]
         // Note that we know the base of meta_p is always the address
         // returned by operator new[]
+        freed_size += meta_p->size;
         meta_p->~AllocationMeta();
         delete[] reinterpret_cast<char *>(meta_p);
 
         meta_p = next_p;
       }
 
+      counter_p->fetch_sub(freed_size);
+
       return;
     }
   };
@@ -1944,7 +1987,8 @@ class BwTree : public BwTreeBase {
     static ElasticNode *Copy(const ElasticNode &other) {
       ElasticNode *node_p = ElasticNode::Get(
           other.GetItemCount(), other.GetType(), other.GetDepth(),
-          other.GetItemCount(), other.GetLowKeyPair(), other.GetHighKeyPair());
+          other.GetItemCount(), other.GetLowKeyPair(), other.GetHighKeyPair(),
+          GetAllocationHeader(&other)->GetFootprintCounter());
 
       node_p->PushBack(other.Begin(), other.End());
 
@@ -2074,7 +2118,8 @@ class BwTree : public BwTreeBase {
                                    NodeType p_type, int p_depth,
                                    int p_item_count,  // Usually equal to size
                                    const KeyNodeIDPair &p_low_key,
-                                   const KeyNodeIDPair &p_high_key) {
+                                   const KeyNodeIDPair &p_high_key,
+                                   std::atomic<size_t> *p_footprint_p) {
       // Currently this is always true - if we want a larger array then
       // just remove this line
       PELOTON_ASSERT(size == p_item_count);
@@ -2086,17 +2131,19 @@ class BwTree : public BwTreeBase {
       // basic template + ElementType element size * (node size) + CHUNK_SIZE()
       // Note: do not make it constant since it is going to be modified
       // after being returned
-      char *alloc_base =
-          new char[sizeof(ElasticNode) + size * sizeof(ElementType) +
-                   AllocationMeta::CHUNK_SIZE()];
+      size_t alloc_size = sizeof(ElasticNode) + size * sizeof(ElementType) +
+                          AllocationMeta::CHUNK_SIZE();
+      char *alloc_base = new char[alloc_size];
       PELOTON_ASSERT(alloc_base != nullptr);
+      p_footprint_p->fetch_add(alloc_size);
 
       // Initialize the AllocationMeta - tail points to the first byte inside
       // class ElasticNode; limit points to the first byte after class
       // AllocationMeta
       new (reinterpret_cast<AllocationMeta *>(alloc_base))
           AllocationMeta{alloc_base + AllocationMeta::CHUNK_SIZE(),
-                         alloc_base + sizeof(AllocationMeta)};
+                         alloc_base + sizeof(AllocationMeta), alloc_size,
+                         p_footprint_p};
 
       // The first CHUNK_SIZE() byte is used by class AllocationMeta
       // and chunk data
@@ -2232,7 +2279,9 @@ class BwTree : public BwTreeBase {
       InnerNode *inner_node_p =
           reinterpret_cast<InnerNode *>(ElasticNode<KeyNodeIDPair>::Get(
               sibling_size, NodeType::InnerType, 0, sibling_size,
-              this->At(split_item_index), this->GetHighKeyPair()));
+              this->At(split_item_index), this->GetHighKeyPair(),
+              ElasticNode<KeyNodeIDPair>::GetAllocationHeader(this)
+                  ->GetFootprintCounter()));
 
       // Call overloaded PushBack() to insert an array of elements
       inner_node_p->PushBack(copy_start_it, this->End());
@@ -2397,7 +2446,9 @@ class BwTree : public BwTreeBase {
           reinterpret_cast<LeafNode *>(ElasticNode<KeyValuePair>::Get(
               sibling_size, NodeType::LeafType, 0, sibling_size,
               std::make_pair(split_key, ~INVALID_NODE_ID),
-              this->GetHighKeyPair()));
+              this->GetHighKeyPair(),
+              ElasticNode<KeyValuePair>::GetAllocationHeader(this)
+                  ->GetFootprintCounter()));
 
       // Copy data item into the new node using PushBack()
       leaf_node_p->PushBack(copy_start_it, copy_end_it);
@@ -2466,6 +2517,9 @@ class BwTree : public BwTreeBase {
         update_op_count{0},
         update_abort_count{0},
 
+        // Memory accounting
+        memory_footprint{0},
+
         // Epoch Manager that does garbage collection
         epoch_manager{this} {
     LOG_TRACE(
@@ -2803,7 +2857,7 @@ class BwTree : public BwTreeBase {
     InnerNode *root_node_p =
         reinterpret_cast<InnerNode *>(ElasticNode<KeyNodeIDPair>::Get(
             1, NodeType::InnerType, 0, 1, first_sep,
-            std::make_pair(KeyType(), INVALID_NODE_ID)));
+            std::make_pair(KeyType(), INVALID_NODE_ID), &memory_footprint));
 
 #else
 
@@ -2819,7 +2873,7 @@ class BwTree : public BwTreeBase {
         reinterpret_cast<InnerNode *>(ElasticNode<KeyNodeIDPair>::Get(
             1, NodeType::InnerType, 0, 1,
             first_sep,  // Copy this as the first key
-            std::make_pair(KeyType{}, INVALID_NODE_ID)));
+            std::make_pair(KeyType{}, INVALID_NODE_ID), &memory_footprint));
 
 #endif
 
@@ -2838,7 +2892,7 @@ class BwTree : public BwTreeBase {
         reinterpret_cast<LeafNode *>(ElasticNode<KeyValuePair>::Get(
             0, NodeType::LeafType, 0, 0,
             std::make_pair(KeyType(), INVALID_NODE_ID),
-            std::make_pair(KeyType(), INVALID_NODE_ID)));
+            std::make_pair(KeyType(), INVALID_NODE_ID), &memory_footprint));
 
 #else
 
@@ -2846,7 +2900,7 @@ class BwTree : public BwTreeBase {
         reinterpret_cast<LeafNode *>(ElasticNode<KeyValuePair>::Get(
             0, NodeType::LeafType, 0, 0,
             std::make_pair(KeyType{}, INVALID_NODE_ID),
-            std::make_pair(KeyType{}, INVALID_NODE_ID)));
+            std::make_pair(KeyType{}, INVALID_NODE_ID), &memory_footprint));
 
 #endif
 
@@ -3676,7 +3730,7 @@ class BwTree : public BwTreeBase {
         reinterpret_cast<InnerNode *>(ElasticNode<KeyNodeIDPair>::Get(
             node_p->GetItemCount(), NodeType::InnerType, p_depth,
             node_p->GetItemCount(), node_p->GetLowKeyPair(),
-            node_p->GetHighKeyPair()));
+            node_p->GetHighKeyPair(), &memory_footprint));
 
     // The first element is always the low key
     // since we know it will never be deleted
@@ -4560,7 +4614,8 @@ class BwTree : public BwTreeBase {
     if (leaf_node_p == nullptr) {
       leaf_node_p = reinterpret_cast<LeafNode *>(ElasticNode<KeyValuePair>::Get(
           node_p->GetItemCount(), NodeType::LeafType, 0, node_p->GetItemCount(),
-          node_p->GetLowKeyPair(), node_p->GetHighKeyPair()));
+          node_p->GetLowKeyPair(), node_p->GetHighKeyPair(),
+          &memory_footprint));
     }
 
     PELOTON_ASSERT(leaf_node_p != nullptr);
@@ -5839,7 +5894,8 @@ class BwTree : public BwTreeBase {
           InnerNode *inner_node_p =
               reinterpret_cast<InnerNode *>(ElasticNode<KeyNodeIDPair>::Get(
                   2, NodeType::InnerType, 0, 2, first_item,
-                  std::make_pair(KeyType(), INVALID_NODE_ID)));
+                  std::make_pair(KeyType(), INVALID_NODE_ID),
+                  &memory_footprint));
 
 #else
 
@@ -5852,7 +5908,8 @@ class BwTree : public BwTreeBase {
           InnerNode *inner_node_p =
               reinterpret_cast<InnerNode *>(ElasticNode<KeyNodeIDPair>::Get(
                   2, NodeType::InnerType, 0, 2, first_item,
-                  std::make_pair(KeyType{}, INVALID_NODE_ID)));
+                  std::make_pair(KeyType{}, INVALID_NODE_ID),
+                  &memory_footprint));
 
 #endif
 
@@ -7092,6 +7149,209 @@ class BwTree : public BwTreeBase {
     return true;
   }
 
+  /*
+   * BulkLoad() - Build the tree bottom-up from sorted key-value pairs
+   *
+   * The items must be sorted by key and must not contain duplicated
+   * key-value pairs. Leaf nodes are filled to 3/4 of their capacity without
+   * splitting the values of a key over two leaves, and inner levels are
+   * built on top of them until a single node is left, which replaces the
+   * root. This avoids all the traversals, delta records and SMOs that
+   * inserting the items one by one would go through.
+   *
+   * This only works on an empty tree. If the tree is not empty (or becomes
+   * non-empty while the nodes are built) nothing is changed and false is
+   * returned; the caller should then fall back to Insert().
+   *
+   * NOTE: The leaves are installed before the inner nodes. If another thread
+   * changes the root in between, the new inner nodes are dropped and the
+   * leaves are only reachable through the sibling chain of the first leaf.
+   * The tree is still correct in this case, just slower to traverse, so
+   * callers should make sure there are no concurrent writers
+   */
+  bool BulkLoad(const std::vector<KeyValuePair> &items) {
+    LOG_TRACE("BulkLoad called with %lu items", items.size());
+
+    if (items.empty() == true) {
+      return true;
+    }
+
+    EpochNode *epoch_node_p = epoch_manager.JoinEpoch();
+
+    // The tree is empty iff the root is a base node with a single separator
+    // pointing to the first leaf, which is an empty base node
+    NodeID old_root_id = root_id.load();
+    const BaseNode *old_root_p = GetNode(old_root_id);
+    const BaseNode *old_leaf_p = GetNode(FIRST_LEAF_NODE_ID);
+    if ((old_root_p->GetType() != NodeType::InnerType) ||
+        (old_root_p->GetItemCount() != 1) ||
+        (old_leaf_p->GetType() != NodeType::LeafType) ||
+        (old_leaf_p->GetItemCount() != 0) ||
+        (old_leaf_p->GetNextNodeID() != INVALID_NODE_ID)) {
+      epoch_manager.LeaveEpoch(epoch_node_p);
+
+      return false;
+    }
+
+    static constexpr size_t leaf_fill_size =
+        LEAF_NODE_SIZE_UPPER_THRESHOLD * 3 / 4;
+    static constexpr size_t inner_fill_size =
+        INNER_NODE_SIZE_UPPER_THRESHOLD * 3 / 4;
+
+    // Split items into leaves. The values of a key always stay together
+    // since leaves are searched by key only
+    std::vector<size_t> leaf_start_list{};
+    for (size_t start = 0; start < items.size();) {
+      leaf_start_list.push_back(start);
+
+      size_t end = std::min(start + leaf_fill_size, items.size());
+      while ((end < items.size()) &&
+             (KeyCmpEqual(items[end].first, items[end - 1].first) == true)) {
+        end++;
+      }
+
+      start = end;
+    }
+    leaf_start_list.push_back(items.size());
+
+    // The first leaf replaces the current one such that iterators could
+    // still start from FIRST_LEAF_NODE_ID
+    size_t leaf_count = leaf_start_list.size() - 1;
+    std::vector<NodeID> leaf_id_list{FIRST_LEAF_NODE_ID};
+    std::vector<KeyNodeIDPair> sep_list{};
+    sep_list.emplace_back(KeyType(), FIRST_LEAF_NODE_ID);
+    for (size_t i = 1; i < leaf_count; i++) {
+      leaf_id_list.push_back(GetNextNodeID());
+      sep_list.emplace_back(items[leaf_start_list[i]].first, leaf_id_list[i]);
+    }
+
+    std::vector<LeafNode *> leaf_list{};
+    for (size_t i = 0; i < leaf_count; i++) {
+      size_t start = leaf_start_list[i];
+      int size = static_cast<int>(leaf_start_list[i + 1] - start);
+
+      KeyNodeIDPair low_key_pair =
+          (i == 0) ? std::make_pair(KeyType(), INVALID_NODE_ID)
+                   : std::make_pair(sep_list[i].first, ~INVALID_NODE_ID);
+      KeyNodeIDPair high_key_pair =
+          (i + 1 == leaf_count) ? std::make_pair(KeyType(), INVALID_NODE_ID)
+                                : sep_list[i + 1];
+
+      LeafNode *leaf_node_p =
+          reinterpret_cast<LeafNode *>(ElasticNode<KeyValuePair>::Get(
+              size, NodeType::LeafType, 0, size, low_key_pair, high_key_pair,
+              &memory_footprint));
+      leaf_node_p->PushBack(items.data() + start, items.data() + start + size);
+
+      leaf_list.push_back(leaf_node_p);
+    }
+
+    // Leaves other than the first one could be installed right away since
+    // no other thread knows their NodeIDs
+    for (size_t i = 1; i < leaf_count; i++) {
+      InstallNewNode(leaf_id_list[i], leaf_list[i]);
+    }
+
+    // Build inner levels until all separators of a level fit into a single
+    // node, which becomes the new root. Inner nodes use their first
+    // separator as the low key
+    std::vector<InnerNode *> inner_list{};
+    std::vector<NodeID> inner_id_list{};
+    InnerNode *new_root_p = nullptr;
+    while (new_root_p == nullptr) {
+      size_t node_count =
+          (sep_list.size() + inner_fill_size - 1) / inner_fill_size;
+
+      std::vector<NodeID> level_id_list{};
+      for (size_t i = 0; i < node_count; i++) {
+        level_id_list.push_back((node_count == 1) ? old_root_id
+                                                  : GetNextNodeID());
+      }
+
+      std::vector<KeyNodeIDPair> upper_sep_list{};
+      for (size_t i = 0; i < node_count; i++) {
+        size_t start = i * inner_fill_size;
+        size_t end = std::min(start + inner_fill_size, sep_list.size());
+        int size = static_cast<int>(end - start);
+
+        KeyNodeIDPair high_key_pair =
+            (i + 1 == node_count)
+                ? std::make_pair(KeyType(), INVALID_NODE_ID)
+                : std::make_pair(sep_list[end].first, level_id_list[i + 1]);
+
+        InnerNode *inner_node_p =
+            reinterpret_cast<InnerNode *>(ElasticNode<KeyNodeIDPair>::Get(
+                size, NodeType::InnerType, 0, size, sep_list[start],
+                high_key_pair, &memory_footprint));
+        inner_node_p->PushBack(sep_list.data() + start,
+                               sep_list.data() + end);
+
+        if (node_count == 1) {
+          new_root_p = inner_node_p;
+        } else {
+          InstallNewNode(level_id_list[i], inner_node_p);
+
+          inner_list.push_back(inner_node_p);
+          inner_id_list.push_back(level_id_list[i]);
+          upper_sep_list.emplace_back(sep_list[start].first,
+                                      level_id_list[i]);
+        }
+      }
+
+      sep_list.swap(upper_sep_list);
+    }
+
+    // Swap in the first leaf. If this fails the tree is no longer empty and
+    // none of the new nodes has become reachable, so they are freed directly
+    if (InstallNodeToReplace(FIRST_LEAF_NODE_ID, leaf_list[0], old_leaf_p) ==
+        false) {
+      LOG_TRACE("BulkLoad failed to install the first leaf");
+
+      for (size_t i = 1; i < leaf_count; i++) {
+        mapping_table[leaf_id_list[i]] = nullptr;
+      }
+      for (LeafNode *leaf_node_p : leaf_list) {
+        leaf_node_p->~LeafNode();
+        leaf_node_p->Destroy();
+      }
+      for (size_t i = 0; i < inner_list.size(); i++) {
+        mapping_table[inner_id_list[i]] = nullptr;
+        inner_list[i]->~InnerNode();
+        inner_list[i]->Destroy();
+      }
+      new_root_p->~InnerNode();
+      new_root_p->Destroy();
+
+      epoch_manager.LeaveEpoch(epoch_node_p);
+
+      return false;
+    }
+
+    epoch_manager.AddGarbageNode(old_leaf_p);
+
+    // Swap in the root. On failure the leaves remain reachable from the
+    // first leaf, but the inner nodes are never seen by anyone
+    if (InstallNodeToReplace(old_root_id, new_root_p, old_root_p) == true) {
+      epoch_manager.AddGarbageNode(old_root_p);
+    } else {
+      LOG_WARN("BwTree bulk load raced with a concurrent update; "
+               "%lu leaves are only reachable through sibling links",
+               leaf_count);
+
+      for (size_t i = 0; i < inner_list.size(); i++) {
+        mapping_table[inner_id_list[i]] = nullptr;
+        inner_list[i]->~InnerNode();
+        inner_list[i]->Destroy();
+      }
+      new_root_p->~InnerNode();
+      new_root_p->Destroy();
+    }
+
+    epoch_manager.LeaveEpoch(epoch_node_p);
+
+    return true;
+  }
+
 #ifdef BWTREE_PELOTON
 
   /*
@@ -7313,6 +7573,64 @@ class BwTree : public BwTreeBase {
     return value_set;
   }
 
+  /*
+   * GetValueBatch() - Fill a value list for each key in a batch
+   *
+   * Keys should be sorted in ascending order. Then a key that falls into the
+   * same leaf as the previous one is searched on the leaf snapshot we already
+   * hold, as long as the leaf has not changed in the meantime, instead of
+   * traversing the tree from the root again. The whole batch runs in a single
+   * epoch.
+   */
+  void GetValueBatch(const std::vector<KeyType> &search_key_list,
+                     std::vector<std::vector<ValueType>> &value_list_list) {
+    LOG_TRACE("GetValueBatch()");
+
+    value_list_list.resize(search_key_list.size());
+
+    EpochNode *epoch_node_p = epoch_manager.JoinEpoch();
+
+    // The leaf on which the previous key was found
+    NodeSnapshot leaf_snapshot{INVALID_NODE_ID, nullptr};
+
+    for (size_t i = 0; i < search_key_list.size(); i++) {
+      const KeyType &search_key = search_key_list[i];
+      std::vector<ValueType> &value_list = value_list_list[i];
+
+      Context context{search_key};
+
+      // The key is known to be >= the low key of the leaf only if it is
+      // not less than the previous key which was found on that leaf
+      if (leaf_snapshot.node_p != nullptr &&
+          KeyCmpLess(search_key, search_key_list[i - 1]) == false &&
+          GetNode(leaf_snapshot.node_id) == leaf_snapshot.node_p &&
+          (leaf_snapshot.node_p->GetNextNodeID() == INVALID_NODE_ID ||
+           KeyCmpLess(search_key, leaf_snapshot.node_p->GetHighKey()))) {
+        context.current_snapshot = leaf_snapshot;
+
+        NavigateLeafNode(&context, value_list);
+
+        if (context.abort_flag == false) {
+          continue;
+        }
+
+        // Start over from the root with a clean context
+        value_list.clear();
+        context.abort_flag = false;
+      }
+
+      context.current_snapshot.node_id = INVALID_NODE_ID;
+
+      TraverseReadOptimized(&context, &value_list);
+
+      leaf_snapshot = context.current_snapshot;
+    }
+
+    epoch_manager.LeaveEpoch(epoch_node_p);
+
+    return;
+  }
+
   ///////////////////////////////////////////////////////////////////
   // Garbage Collection Interface
   ///////////////////////////////////////////////////////////////////
@@ -7347,6 +7665,23 @@ class BwTree : public BwTreeBase {
     return;
   }
 
+  /*
+   * GetMemoryFootprint() - Bytes of all base nodes and their delta chunks
+   *                        that have not been freed, including garbage
+   *
+   * The mapping table is reserved with mmap() and only its touched pages
+   * are backed by memory, so it is not counted here
+   */
+  size_t GetMemoryFootprint() const { return memory_footprint.load(); }
+
+  /*
+   * GetGarbageFootprint() - Bytes of unlinked delta chains waiting for
+   *                         their epoch to be reclaimed
+   */
+  size_t GetGarbageFootprint() const {
+    return epoch_manager.garbage_footprint.load();
+  }
+
 /*
  * Private Method Implementation
  */
@@ -7411,6 +7746,10 @@ class BwTree : public BwTreeBase {
   std::atomic<uint64_t> update_op_count;
   std::atomic<uint64_t> update_abort_count;
 
+  // Bytes of all base nodes and delta chunks that have not been freed,
+  // including those waiting in the garbage list
+  std::atomic<size_t> memory_footprint;
+
   // InteractiveDebugger idb;
 
   EpochManager epoch_manager;
@@ -7435,6 +7774,9 @@ class BwTree : public BwTreeBase {
     struct GarbageNode {
       const BaseNode *node_p;
 
+      // Bytes freed with this delta chain, see GetDeltaChainSize()
+      size_t size;
+
       // This does not have to be atomic, since we only
       // insert at the head of garbage list
       GarbageNode *next_p;
@@ -7481,6 +7823,9 @@ class BwTree : public BwTreeBase {
     // Otherwise it points to a thread created by EpochManager internally
     std::thread *thread_p;
 
+    // Bytes of unlinked delta chains that have not been freed yet
+    std::atomic<size_t> garbage_footprint;
+
 // The counter that counts how many free is called
 // inside the epoch manager
 // NOTE: We cannot precisely count the size of memory freed
@@ -7526,6 +7871,8 @@ class BwTree : public BwTreeBase {
       // This is used to notify the cleaner thread that it has ended
       exited_flag.store(false);
 
+      garbage_footprint.store(0UL);
+
 // Initialize atomic counter to record how many
 // freed has been called inside epoch manager
 #ifdef BWTREE_DEBUG
@@ -7694,6 +8041,9 @@ class BwTree : public BwTreeBase {
       // These two could be predetermined
       GarbageNode *garbage_node_p = new GarbageNode;
       garbage_node_p->node_p = node_p;
+      garbage_node_p->size = GetDeltaChainSize(node_p);
+
+      garbage_footprint.fetch_add(garbage_node_p->size);
 
       garbage_node_p->next_p = epoch_p->garbage_list_p.load();
 
@@ -7822,6 +8172,54 @@ class BwTree : public BwTreeBase {
 
 #endif  // #ifdef USE_OLD_EPOCH
 
+    /*
+     * GetDeltaChainSize() - Returns the number of bytes FreeEpochDeltaChain()
+     *                       releases for the given delta chain
+     *
+     * Delta nodes live in the chunks of their base node, so this is the size
+     * of the chunk lists reachable the same way FreeEpochDeltaChain() walks
+     * the chain. Remove and abort nodes are heap allocated outside of the
+     * chunks and are not counted
+     */
+    size_t GetDeltaChainSize(const BaseNode *node_p) const {
+      while (1) {
+        switch (node_p->GetType()) {
+          case NodeType::LeafType:
+            return ElasticNode<KeyValuePair>::GetAllocationHeader(
+                       static_cast<const LeafNode *>(node_p))
+                ->GetTotalSize();
+          case NodeType::InnerType:
+            return ElasticNode<KeyNodeIDPair>::GetAllocationHeader(
+                       static_cast<const InnerNode *>(node_p))
+                ->GetTotalSize();
+          case NodeType::LeafMergeType:
+            return GetDeltaChainSize(
+                       static_cast<const LeafMergeNode *>(node_p)
+                           ->child_node_p) +
+                   GetDeltaChainSize(
+                       static_cast<const LeafMergeNode *>(node_p)
+                           ->right_merge_p);
+          case NodeType::InnerMergeType:
+            return GetDeltaChainSize(
+                       static_cast<const InnerMergeNode *>(node_p)
+                           ->child_node_p) +
+                   GetDeltaChainSize(
+                       static_cast<const InnerMergeNode *>(node_p)
+                           ->right_merge_p);
+          case NodeType::LeafRemoveType:
+          case NodeType::InnerRemoveType:
+          case NodeType::InnerAbortType:
+            return 0UL;
+          default:
+            node_p = static_cast<const DeltaNode *>(node_p)->child_node_p;
+            break;
+        }
+      }
+
+      PELOTON_ASSERT(false);
+      return 0UL;
+    }
+
     /*
      * FreeEpochDeltaChain() - Free a delta chain (used by EpochManager)
      *
@@ -8069,6 +8467,7 @@ class BwTree : public BwTreeBase {
                  head_epoch_p->garbage_list_p.load();
              garbage_node_p != nullptr; garbage_node_p = next_garbage_node_p) {
           FreeEpochDeltaChain(garbage_node_p->node_p);
+          garbage_footprint.fetch_sub(garbage_node_p->size);
 
           // Save the next pointer so that we could
           // delete current node directly
@@ -8611,6 +9010,44 @@ class BwTree : public BwTreeBase {
      */
     inline const KeyValuePair *operator->() { return &*kv_p; }
 
+    /*
+     * GetLeafRange() - Returns the key value pairs from the current one to
+     *                  the end of the cached leaf page
+     *
+     * Pairs in the page are stored contiguously, which allows the caller to
+     * process the page as a whole instead of advancing one pair at a time
+     */
+    inline std::pair<const KeyValuePair *, const KeyValuePair *>
+    GetLeafRange() const {
+      if (ic_p == nullptr) {
+        return std::make_pair(nullptr, nullptr);
+      }
+
+      return std::make_pair(kv_p, ic_p->GetLeafNode()->End());
+    }
+
+    /*
+     * MoveToNextLeaf() - Skips the rest of the cached leaf page and loads
+     *                    the next one
+     *
+     * If the cached page is the last one then the iterator becomes End()
+     */
+    inline void MoveToNextLeaf() {
+      if (IsEnd() == true) {
+        return;
+      }
+
+      kv_p = ic_p->GetLeafNode()->End();
+      if (IsEnd() == true) {
+        return;
+      }
+
+      LowerBound(ic_p->GetTree(),
+                 &ic_p->GetLeafNode()->GetHighKeyPair().first);
+
+      return;
+    }
+
     /*
      * operator< - Compares two iterators by comparing their current key
      *
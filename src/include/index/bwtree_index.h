@@ -33,6 +33,9 @@
 
 namespace peloton {
 namespace index {
+
+template <size_t KeySize>
+class CompactIntsKey;
   
 /**
  * BW tree-based index implementation.
@@ -75,6 +78,13 @@ class BWTreeIndex : public Index {
                        ItemPointer *value,
                        std::function<bool(const void *)> predicate) override;
 
+  bool BulkInsert(const std::vector<const storage::Tuple *> &keys,
+                  const std::vector<ValueType> &values) override;
+
+  bool InsertEntryBatch(const std::vector<const storage::Tuple *> &keys,
+                        const std::vector<ValueType> &values,
+                        std::function<bool(const void *)> predicate) override;
+
   void Scan(const std::vector<type::Value> &values,
             const std::vector<oid_t> &key_column_ids,
             const std::vector<ExpressionType> &expr_types,
@@ -91,15 +101,30 @@ class BWTreeIndex : public Index {
                  uint64_t limit,
                  uint64_t offset) override;
 
+  bool ScanWithKeys(const std::vector<type::Value> &values,
+                    const std::vector<oid_t> &key_column_ids,
+                    const std::vector<ExpressionType> &expr_types,
+                    std::vector<ValueType> &result,
+                    std::vector<std::unique_ptr<storage::Tuple>> &keys,
+                    const ConjunctionScanPredicate *csp_p) override;
+
   void ScanAllKeys(std::vector<ValueType> &result) override;
 
   void ScanKey(const storage::Tuple *key,
                std::vector<ValueType> &result) override;
 
+  void ScanKeyBatch(const std::vector<const storage::Tuple *> &keys,
+                    std::vector<std::vector<ValueType>> &results) override;
+
   std::string GetTypeName() const override;
 
-  // TODO: Implement this
-  size_t GetMemoryFootprint() override { return 0; }
+  size_t GetMemoryFootprint() override {
+    return container.GetMemoryFootprint();
+  }
+
+  size_t GetGarbageFootprint() override {
+    return container.GetGarbageFootprint();
+  }
   
   bool NeedGC() override {
     return container.NeedGarbageCollection();
@@ -113,6 +138,19 @@ class BWTreeIndex : public Index {
   }
 
  protected:
+  // Scans the keys between the low key and the high key of a range scan.
+  // The last argument only selects the overload for the key type
+  template <typename RangeKeyType>
+  void ScanRange(const storage::Tuple *low_key_p,
+                 const storage::Tuple *high_key_p,
+                 std::vector<ValueType> &result, const RangeKeyType *);
+
+  template <size_t KeySize>
+  void ScanRange(const storage::Tuple *low_key_p,
+                 const storage::Tuple *high_key_p,
+                 std::vector<ValueType> &result,
+                 const CompactIntsKey<KeySize> *);
+
   // equality checker and comparator
   KeyComparator comparator;
   KeyEqualityChecker equals;
@@ -12,7 +12,9 @@
 
 #pragma once
 
+#include <algorithm>
 #include <sstream>
+#include <vector>
 
 #include "util/string_util.h"
 #include "util/portable_endian.h"
@@ -319,6 +321,21 @@ class CompactIntsKey {
     return Compare(a, b) == 0;
   }
 
+  /*
+   * GetColumnBits() - Returns the stored bits of a column in host endian
+   *
+   * UIntType must be the unsigned type of the column's width. Since integers
+   * are stored sign flipped, the results compare in the same order as the
+   * values of the column
+   */
+  template <typename UIntType>
+  inline UIntType GetColumnBits(size_t offset) const {
+    UIntType data;
+    memcpy(&data, key_data + offset, sizeof(UIntType));
+
+    return ToHostEndian(data);
+  }
+
  public:
 
   /**
@@ -645,5 +662,196 @@ class CompactIntsHasher {
   }
 };
 
+/*
+ * class CompactIntsScanFilter - Filters the keys of a range scan in bulk
+ *
+ * A range scan walks every key between the low key and the high key, but
+ * that range only bounds the leading column. For the other columns this
+ * class checks the bounds of each column on the compact representation,
+ * without building values from the key. Keys are processed in batches of
+ * one column at a time, which keeps the comparison loops free of branches
+ * so that the compiler can vectorize them
+ */
+template <size_t KeySize>
+class CompactIntsScanFilter {
+ public:
+  using KeyType = CompactIntsKey<KeySize>;
+
+  // Number of keys whose columns are compared together
+  static constexpr size_t BATCH_SIZE = 64;
+
+  CompactIntsScanFilter(const storage::Tuple *low_key_p,
+                        const storage::Tuple *high_key_p)
+      : is_empty{false} {
+    low_key.SetFromKey(low_key_p);
+    high_key.SetFromKey(high_key_p);
+
+    const catalog::Schema *key_schema = low_key_p->GetSchema();
+    size_t offset = 0;
+    for (oid_t column_id = 0; column_id < key_schema->GetColumnCount();
+         column_id++) {
+      ColumnBound bound;
+      bound.offset = offset;
+      bound.size = key_schema->GetColumn(column_id).GetFixedLength();
+      bound.low = GetColumnBits(low_key, bound.offset, bound.size);
+      offset += bound.size;
+
+      uint64_t high = GetColumnBits(high_key, bound.offset, bound.size);
+      uint64_t max_bits = (bound.size == sizeof(uint64_t))
+                              ? ~0UL
+                              : (1UL << (bound.size * 8)) - 1;
+      if (bound.low > high) {
+        is_empty = true;
+      }
+
+      // A column the predicate does not bound on one side gets the min or
+      // max value of its type there. NULL is stored below the min value, so
+      // that side must not be checked, or rows with a NULL in the column
+      // would be dropped
+      type::Value low_value = low_key_p->GetValue(column_id);
+      if (low_value.CompareEquals(type::Type::GetMinValue(
+              low_value.GetTypeId())) == CmpBool::CmpTrue) {
+        bound.low = 0;
+      }
+      type::Value high_value = high_key_p->GetValue(column_id);
+      if (high_value.CompareEquals(type::Type::GetMaxValue(
+              high_value.GetTypeId())) == CmpBool::CmpTrue) {
+        high = max_bits;
+      }
+
+      // The leading column is bounded by the key range itself, and columns
+      // that take any value need no check
+      if (column_id == 0 || (bound.low == 0 && high == max_bits)) {
+        continue;
+      }
+
+      // low <= bits <= high is checked as bits - low <= high - low
+      bound.range = high - bound.low;
+      column_bounds.push_back(bound);
+    }
+
+    return;
+  }
+
+  /*
+   * GetLowKey() - Returns the low key of the scan
+   */
+  inline const KeyType &GetLowKey() const { return low_key; }
+
+  /*
+   * GetHighKey() - Returns the high key of the scan
+   */
+  inline const KeyType &GetHighKey() const { return high_key; }
+
+  /*
+   * IsEmpty() - Returns true if the bounds of some column can not be met
+   */
+  inline bool IsEmpty() const { return is_empty; }
+
+  /*
+   * Filter() - Writes the values of qualifying key value pairs to the result
+   *
+   * The result must have room for every pair in [begin, end). Returns the
+   * number of values written
+   */
+  template <typename ValueType>
+  size_t Filter(const std::pair<KeyType, ValueType> *begin,
+                const std::pair<KeyType, ValueType> *end,
+                ValueType *result) const {
+    size_t count = 0;
+
+    if (column_bounds.empty() == true) {
+      for (auto kv_p = begin; kv_p != end; kv_p++) {
+        result[count++] = kv_p->second;
+      }
+
+      return count;
+    }
+
+    uint64_t column_bits[BATCH_SIZE];
+    uint8_t matched[BATCH_SIZE];
+    while (begin != end) {
+      size_t batch_size =
+          std::min(BATCH_SIZE, static_cast<size_t>(end - begin));
+      std::fill(matched, matched + batch_size, 1);
+
+      for (const ColumnBound &bound : column_bounds) {
+        switch (bound.size) {
+          case sizeof(uint64_t):
+            LoadColumnBits<uint64_t>(begin, batch_size, bound.offset,
+                                     column_bits);
+            break;
+          case sizeof(uint32_t):
+            LoadColumnBits<uint32_t>(begin, batch_size, bound.offset,
+                                     column_bits);
+            break;
+          case sizeof(uint16_t):
+            LoadColumnBits<uint16_t>(begin, batch_size, bound.offset,
+                                     column_bits);
+            break;
+          default:
+            LoadColumnBits<uint8_t>(begin, batch_size, bound.offset,
+                                    column_bits);
+            break;
+        }
+
+        for (size_t i = 0; i < batch_size; i++) {
+          matched[i] &= ((column_bits[i] - bound.low) <= bound.range);
+        }
+      }
+
+      // Always write the value and only keep it if the pair matched
+      for (size_t i = 0; i < batch_size; i++) {
+        result[count] = begin[i].second;
+        count += matched[i];
+      }
+
+      begin += batch_size;
+    }
+
+    return count;
+  }
+
+ private:
+  struct ColumnBound {
+    size_t offset;
+    size_t size;
+    uint64_t low;
+    uint64_t range;
+  };
+
+  static uint64_t GetColumnBits(const KeyType &key, size_t offset,
+                                size_t size) {
+    switch (size) {
+      case sizeof(uint64_t):
+        return key.template GetColumnBits<uint64_t>(offset);
+      case sizeof(uint32_t):
+        return key.template GetColumnBits<uint32_t>(offset);
+      case sizeof(uint16_t):
+        return key.template GetColumnBits<uint16_t>(offset);
+      default:
+        return key.template GetColumnBits<uint8_t>(offset);
+    }
+  }
+
+  template <typename UIntType, typename ValueType>
+  static inline void LoadColumnBits(const std::pair<KeyType, ValueType> *begin,
+                                    size_t batch_size, size_t offset,
+                                    uint64_t *column_bits) {
+    for (size_t i = 0; i < batch_size; i++) {
+      column_bits[i] = begin[i].first.template GetColumnBits<UIntType>(offset);
+    }
+  }
+
+  KeyType low_key;
+  KeyType high_key;
+
+  // Bounds of the columns that have to be checked
+  std::vector<ColumnBound> column_bounds;
+
+  // True if no key can be in the range
+  bool is_empty;
+};
+
 }  // namespace index
 }  // namespace peloton
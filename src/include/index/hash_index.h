@@ -0,0 +1,114 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// hash_index.h
+//
+// Identification: src/include/index/hash_index.h
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include "common/container/cuckoo_map.h"
+#include "common/internal_types.h"
+#include "index/index.h"
+
+#define HASH_INDEX_TEMPLATE_ARGUMENTS                                    \
+  template <typename KeyType, typename ValueType, typename KeyHashFunc, \
+            typename KeyEqualityChecker, typename ValueEqualityChecker>
+
+#define HASH_INDEX_TYPE                                              \
+  HashIndex<KeyType, ValueType, KeyHashFunc, KeyEqualityChecker, \
+            ValueEqualityChecker>
+
+namespace peloton {
+namespace index {
+
+/**
+ * Hash index implementation on top of the cuckoo hash map.
+ *
+ * Every key maps to the list of its values, which is only ever read or
+ * modified under the bucket locks of the key. This makes unique and
+ * non-unique keys behave the same as in the BwTree index. The index does not
+ * keep keys in order, so it only answers point queries. The optimizer only
+ * picks a hash index when every key column has an equality predicate.
+ *
+ * @see Index
+ */
+template <typename KeyType, typename ValueType, typename KeyHashFunc,
+          typename KeyEqualityChecker, typename ValueEqualityChecker>
+class HashIndex : public Index {
+  friend class IndexFactory;
+
+  using ValueList = std::vector<ValueType>;
+
+  using MapType =
+      CuckooMap<KeyType, ValueList, KeyHashFunc, KeyEqualityChecker>;
+
+ public:
+  HashIndex(IndexMetadata *metadata);
+
+  ~HashIndex();
+
+  bool InsertEntry(const storage::Tuple *key, ItemPointer *value) override;
+
+  bool DeleteEntry(const storage::Tuple *key, ItemPointer *value) override;
+
+  bool CondInsertEntry(const storage::Tuple *key, ItemPointer *value,
+                       std::function<bool(const void *)> predicate) override;
+
+  void Scan(const std::vector<type::Value> &values,
+            const std::vector<oid_t> &key_column_ids,
+            const std::vector<ExpressionType> &expr_types,
+            ScanDirectionType scan_direction, std::vector<ValueType> &result,
+            const ConjunctionScanPredicate *csp_p) override;
+
+  void ScanLimit(const std::vector<type::Value> &values,
+                 const std::vector<oid_t> &key_column_ids,
+                 const std::vector<ExpressionType> &expr_types,
+                 ScanDirectionType scan_direction,
+                 std::vector<ValueType> &result,
+                 const ConjunctionScanPredicate *csp_p, uint64_t limit,
+                 uint64_t offset) override;
+
+  void ScanAllKeys(std::vector<ValueType> &result) override;
+
+  void ScanKey(const storage::Tuple *key,
+               std::vector<ValueType> &result) override;
+
+  void ScanKeyBatch(const std::vector<const storage::Tuple *> &keys,
+                    std::vector<std::vector<ValueType>> &results) override;
+
+  std::string GetTypeName() const override;
+
+  // Slots of the cuckoo table plus one pointer per value in the value lists
+  size_t GetMemoryFootprint() override {
+    return container.GetMemoryFootprint() +
+           value_count.load() * sizeof(ValueType);
+  }
+
+  // Deleted entries are freed in place, there is no garbage to collect
+  bool NeedGC() override { return false; }
+
+  void PerformGC() override { return; }
+
+ protected:
+  // equality checker for values
+  ValueEqualityChecker value_equals;
+
+  // container
+  MapType container;
+
+  // Number of values across all value lists, for the memory footprint
+  std::atomic<size_t> value_count;
+};
+
+}  // namespace index
+}  // namespace peloton
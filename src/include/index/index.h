@@ -22,6 +22,7 @@
 #include "common/item_pointer.h"
 #include "common/logger.h"
 #include "common/printable.h"
+#include "common/synchronization/spin_latch.h"
 #include "type/value.h"
 
 namespace peloton {
@@ -63,7 +64,8 @@ class IndexMetadata : public Printable {
                 IndexConstraintType index_constraint_type,
                 const catalog::Schema *tuple_schema,
                 const catalog::Schema *key_schema,
-                const std::vector<oid_t> &key_attrs, bool unique_keys);
+                const std::vector<oid_t> &key_attrs, bool unique_keys,
+                oid_t include_column_count = 0);
 
   ~IndexMetadata();
 
@@ -95,9 +97,18 @@ class IndexMetadata : public Printable {
 
   // Returns the mapping relation between indexed columns and base table columns
   // The entry whose value is j on index i means the i-th column in the key is
-  // mapped to the j-th column in the base table tuple
+  // mapped to the j-th column in the base table tuple. INCLUDE columns are
+  // the trailing entries
   const std::vector<oid_t> &GetKeyAttrs() const { return key_attrs; }
 
+  // Returns the number of trailing key columns that are only carried along
+  // with the key (INCLUDE columns) so that index-only scans can return them
+  oid_t GetIncludeColumnCount() const { return include_column_count; }
+
+  // Returns true if every given base table column is stored in the key, so
+  // that a scan reading only these columns can be answered from the index
+  bool CoversColumns(const std::vector<oid_t> &column_ids) const;
+
   // Returns the mapping relation between tuple key column and index key columns
   const std::vector<oid_t> &GetTupleToIndexMapping() const {
     return tuple_attrs;
@@ -160,6 +171,9 @@ class IndexMetadata : public Printable {
   // Whether keys are unique (e.g. primary key)
   const bool unique_keys;
 
+  // The number of INCLUDE columns at the end of key_attrs
+  const oid_t include_column_count;
+
   // utility of an index
   double utility_ratio = INVALID_RATIO;
 
@@ -251,6 +265,81 @@ class Index : public Printable {
   virtual bool CondInsertEntry(const storage::Tuple *key, ItemPointer *location,
                                std::function<bool(const void *)> predicate) = 0;
 
+  /**
+   * Inserts a batch of key-value pairs at once, e.g. when an index is built
+   * over existing data. keys[i] is inserted with values[i]. Indexes that can
+   * build their structure from sorted input override this; the default
+   * implementation inserts the pairs one by one.
+   *
+   * @param keys The keys to insert
+   * @param values The value of each key
+   * @return True if all pairs were inserted. False if a pair was rejected,
+   * e.g. because it violates the uniqueness of the index
+   */
+  virtual bool BulkInsert(const std::vector<const storage::Tuple *> &keys,
+                          const std::vector<ItemPointer *> &values);
+
+  /**
+   * Inserts the entries of a batch of new tuples into an index that is in
+   * use. Unlike BulkInsert() this is safe with concurrent readers and
+   * writers. The entries are inserted in key order, so that consecutive
+   * inserts work on the same part of the index.
+   *
+   * @param keys The keys to insert
+   * @param values The value of each key
+   * @param predicate If set, every key is checked against the values already
+   * in the index like CondInsertEntry() does, and the keys of the batch must
+   * be distinct
+   * @return False if a key was rejected by the predicate, true otherwise. The
+   * pairs inserted before a rejected key are kept
+   */
+  virtual bool InsertEntryBatch(
+      const std::vector<const storage::Tuple *> &keys,
+      const std::vector<ItemPointer *> &values,
+      std::function<bool(const void *)> predicate);
+
+  ///////////////////////////////////////////////////////////////////
+  // Online Build
+  ///////////////////////////////////////////////////////////////////
+
+  /**
+   * Marks the index as being built. Until FinishBuild() returns, writers
+   * hand their changes to BufferInsert()/BufferDelete() instead of applying
+   * them, so that the builder can populate the index from a snapshot without
+   * racing with them.
+   */
+  void StartBuild();
+
+  bool IsBuilding() const { return building_.load(); }
+
+  /**
+   * Records an insert that happened while the index is being built. The key
+   * is copied, so the caller keeps ownership of it.
+   *
+   * @return True if the insert was buffered. False if the index is not being
+   * built, in which case the caller must apply it to the index itself
+   */
+  bool BufferInsert(const storage::Tuple *key, ItemPointer *location);
+
+  /**
+   * Records a delete that happened while the index is being built
+   *
+   * @return True if the delete was buffered. False if the index is not being
+   * built, in which case the caller must apply it to the index itself
+   */
+  bool BufferDelete(const storage::Tuple *key, ItemPointer *location);
+
+  /**
+   * Applies the buffered changes in the order they were recorded and ends
+   * the build. Inserts are applied with insert_func, deletes with
+   * DeleteEntry(). Changes recorded while the buffer is drained are applied
+   * as well; writers only go back to the index once the buffer is empty.
+   *
+   * @return False if insert_func rejected one of the inserts
+   */
+  bool FinishBuild(
+      std::function<bool(const storage::Tuple *, ItemPointer *)> insert_func);
+
   ///////////////////////////////////////////////////////////////////
   // Index Scan
   ///////////////////////////////////////////////////////////////////
@@ -301,6 +390,23 @@ class Index : public Printable {
                          const ConjunctionScanPredicate *csp_p, uint64_t limit,
                          uint64_t offset) = 0;
 
+  /**
+   * Performs the same forward scan as Scan() and also returns a copy of the
+   * key of every entry, so that index-only scans can read the key columns
+   * without going to the table. keys[i] is the key of result[i].
+   *
+   * @param[out] result Where the results of the scan are stored
+   * @param[out] keys Where the keys of the results are stored
+   * @return False if the index can not hand back its keys, in which case
+   * nothing is scanned. The default implementation returns false.
+   */
+  virtual bool ScanWithKeys(const std::vector<type::Value> &value_list,
+                            const std::vector<oid_t> &tuple_column_id_list,
+                            const std::vector<ExpressionType> &expr_list,
+                            std::vector<ItemPointer *> &result,
+                            std::vector<std::unique_ptr<storage::Tuple>> &keys,
+                            const ConjunctionScanPredicate *csp_p);
+
   /**
    * This is the version used to test the basic scan operation. Since it does a
    * scan planning every time it is invoked, it will be slower than the regular
@@ -334,6 +440,21 @@ class Index : public Printable {
   virtual void ScanKey(const storage::Tuple *key,
                        std::vector<ItemPointer *> &result) = 0;
 
+  /**
+   * Finds the values of a batch of keys at once. results[i] receives the
+   * values of keys[i], exactly as if ScanKey() was called on it. The keys
+   * should be sorted in ascending key order, which allows ordered indexes to
+   * reuse the part of the traversal shared by neighboring keys. Unsorted keys
+   * are still answered correctly, only slower.
+   *
+   * The default implementation probes every key with ScanKey().
+   *
+   * @param keys The keys to look up, preferably in ascending order
+   * @param[out] results Where the values of each key are stored
+   */
+  virtual void ScanKeyBatch(const std::vector<const storage::Tuple *> &keys,
+                            std::vector<std::vector<ItemPointer *>> &results);
+
   //////////////////////////////////////////////////////////////////////////////
   /// Garbage Collection
   //////////////////////////////////////////////////////////////////////////////
@@ -433,6 +554,15 @@ class Index : public Printable {
    */
   virtual size_t GetMemoryFootprint() = 0;
 
+  /**
+   * @brief Calculate the number of bytes held by entries that have been
+   * unlinked from the index but not yet reclaimed. These bytes are included
+   * in GetMemoryFootprint()
+   *
+   * @return The number of bytes waiting for garbage collection
+   */
+  virtual size_t GetGarbageFootprint() { return 0; }
+
   // Get the indexed tile group offset
   virtual size_t GetIndexedTileGroupOff() {
     return indexed_tile_group_offset.load();
@@ -470,6 +600,25 @@ class Index : public Printable {
 
   // This is used by index tuner
   std::atomic<size_t> indexed_tile_group_offset;
+
+ private:
+  bool BufferChange(bool is_insert, const storage::Tuple *key,
+                    ItemPointer *location);
+
+  // A change made to the table while the index is being built
+  struct BufferedChange {
+    bool is_insert;
+    std::unique_ptr<storage::Tuple> key;
+    ItemPointer *location;
+  };
+
+  // Whether the index is being built. Writers check this without taking
+  // build_latch_ and only take it to buffer a change
+  std::atomic<bool> building_;
+
+  common::synchronization::SpinLatch build_latch_;
+
+  std::vector<BufferedChange> build_buffer_;
 };
 
 }  // namespace index
@@ -12,6 +12,16 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <new>
+#include <thread>
+#include <vector>
+
+#include "common/logger.h"
+#include "common/macros.h"
+
 namespace peloton {
 namespace index {
 
@@ -21,10 +31,1074 @@ namespace index {
 #define SKIPLIST_TEMPLATE_ARGUMENTS                                       \
   template <typename KeyType, typename ValueType, typename KeyComparator, \
             typename KeyEqualityChecker, typename ValueEqualityChecker>
+
+/*
+ * class SkipList - Lock-free skip list with epoch-based reclamation
+ *
+ * Every distinct key is stored in exactly one key node that is linked into
+ * the tower levels of the list. The values of a key live in a lock-free
+ * linked list hanging off the key node, so non-unique keys never produce
+ * duplicated towers.
+ *
+ * Deletion is two-phased: a value node is first logically deleted by marking
+ * its next pointer and then physically unlinked with CAS. Once the value
+ * list of a key becomes empty the key node is killed by marking the value
+ * list pointer itself, after which its tower is marked top-down and unlinked
+ * by any thread that walks over it. Unlinked nodes are handed to the epoch
+ * manager, and are only freed after every thread that could have observed
+ * them has left its epoch.
+ */
 template <typename KeyType, typename ValueType, typename KeyComparator,
           typename KeyEqualityChecker, typename ValueEqualityChecker>
 class SkipList {
-  // TODO: Add your declarations here
+ public:
+  // The tallest tower a key node could have
+  static constexpr int MAX_HEIGHT = 16;
+
+  // One in BRANCHING_FACTOR towers on a level also reaches the next level
+  static constexpr uint32_t BRANCHING_FACTOR = 4;
+
+ private:
+  /*
+   * struct ValueNode - One value of a key
+   *
+   * The lowest bit of next_p marks the value as deleted
+   */
+  struct ValueNode {
+    ValueType value;
+    std::atomic<ValueNode *> next_p;
+
+    ValueNode(const ValueType &p_value) : value{p_value}, next_p{nullptr} {}
+  };
+
+  /*
+   * struct KeyNode - A key and its tower
+   *
+   * The lowest bit of value_list_p marks the key node as dead, and the
+   * lowest bit of next_p[i] marks the node as removed from level i. The tower
+   * is allocated inline behind the node, so next_p must be the last member.
+   */
+  struct KeyNode {
+    KeyType key;
+    std::atomic<ValueNode *> value_list_p;
+
+    // The inserting thread and the thread killing the node each hold a
+    // reference. Whoever drops the last one unlinks and retires the node,
+    // which guarantees no level is linked in after the node is retired
+    std::atomic<int> unlink_ref;
+
+    int height;
+    std::atomic<KeyNode *> next_p[1];
+
+    KeyNode(const KeyType &p_key, int p_height)
+        : key{p_key}, value_list_p{nullptr}, unlink_ref{2}, height{p_height} {}
+  };
+
+  /*
+   * Mark bit helpers - Pointers are at least 8-byte aligned, so the lowest
+   * bit is free to carry the deletion mark
+   */
+  template <typename NodeType>
+  static inline bool IsMarked(NodeType *node_p) {
+    return (reinterpret_cast<uintptr_t>(node_p) & 0x1UL) != 0;
+  }
+
+  template <typename NodeType>
+  static inline NodeType *GetMarked(NodeType *node_p) {
+    return reinterpret_cast<NodeType *>(reinterpret_cast<uintptr_t>(node_p) |
+                                        0x1UL);
+  }
+
+  template <typename NodeType>
+  static inline NodeType *GetUnmarked(NodeType *node_p) {
+    return reinterpret_cast<NodeType *>(reinterpret_cast<uintptr_t>(node_p) &
+                                        ~0x1UL);
+  }
+
+  static inline bool IsDead(const KeyNode *node_p) {
+    return IsMarked(node_p->value_list_p.load());
+  }
+
+  ///////////////////////////////////////////////////////////////////
+  // Epoch manager
+  ///////////////////////////////////////////////////////////////////
+
+  /*
+   * class EpochManager - Maintains a linked list of unlinked nodes for
+   *                      threads to access until all threads entering epochs
+   *                      before the unlinking have exited
+   *
+   * This follows the epoch manager of BwTree. Garbage collection is driven
+   * by an external thread through PerformGarbageCollection()
+   */
+  class EpochManager {
+   public:
+    struct GarbageNode {
+      void *node_p;
+      bool is_key_node;
+      GarbageNode *next_p;
+    };
+
+    struct EpochNode {
+      // Number of threads in the epoch. Negative while the epoch is being
+      // cleaned
+      std::atomic<int> active_thread_count;
+
+      // Garbage is CASed onto the head of this list
+      std::atomic<GarbageNode *> garbage_list_p;
+
+      // Only maintained by the garbage collecting thread
+      EpochNode *next_p;
+    };
+
+    EpochManager(SkipList *p_list_p) : list_p{p_list_p}, gc_flag{false} {
+      current_epoch_p = new EpochNode{};
+      current_epoch_p->active_thread_count = 0;
+      current_epoch_p->garbage_list_p = nullptr;
+      current_epoch_p->next_p = nullptr;
+
+      head_epoch_p = current_epoch_p;
+    }
+
+    /*
+     * Destructor - Free all garbage, no thread may be in any epoch anymore
+     */
+    ~EpochManager() {
+      current_epoch_p = nullptr;
+      ClearEpoch();
+
+      PELOTON_ASSERT(head_epoch_p == nullptr);
+    }
+
+    void AddGarbageNode(void *node_p, bool is_key_node) {
+      // The current epoch can not be recycled while this thread is in an
+      // epoch that is not newer than it
+      EpochNode *epoch_p = current_epoch_p;
+
+      GarbageNode *garbage_node_p = new GarbageNode;
+      garbage_node_p->node_p = node_p;
+      garbage_node_p->is_key_node = is_key_node;
+      garbage_node_p->next_p = epoch_p->garbage_list_p.load();
+
+      while (epoch_p->garbage_list_p.compare_exchange_weak(
+                 garbage_node_p->next_p, garbage_node_p) == false) {
+      }
+    }
+
+    inline EpochNode *JoinEpoch() {
+      while (1) {
+        EpochNode *epoch_p = current_epoch_p;
+        if (epoch_p->active_thread_count.fetch_add(1) >= 0) {
+          return epoch_p;
+        }
+
+        // The epoch is being cleaned, the current epoch must have moved
+        epoch_p->active_thread_count.fetch_sub(1);
+      }
+    }
+
+    inline void LeaveEpoch(EpochNode *epoch_p) {
+      epoch_p->active_thread_count.fetch_sub(1);
+    }
+
+    /*
+     * PerformGarbageCollection() - Only one thread collects at a time, others
+     *                              return immediately
+     */
+    void PerformGarbageCollection() {
+      bool expected = false;
+      if (gc_flag.compare_exchange_strong(expected, true) == false) {
+        return;
+      }
+
+      ClearEpoch();
+      CreateNewEpoch();
+
+      gc_flag.store(false);
+    }
+
+   private:
+    void CreateNewEpoch() {
+      EpochNode *epoch_node_p = new EpochNode{};
+      epoch_node_p->active_thread_count = 0;
+      epoch_node_p->garbage_list_p = nullptr;
+      epoch_node_p->next_p = nullptr;
+
+      current_epoch_p->next_p = epoch_node_p;
+      current_epoch_p = epoch_node_p;
+    }
+
+    /*
+     * ClearEpoch() - Free epochs from the head until one is still in use or
+     *                the current epoch is reached
+     */
+    void ClearEpoch() {
+      while (head_epoch_p != current_epoch_p) {
+        if (head_epoch_p->active_thread_count.load() != 0) {
+          break;
+        }
+
+        // Make late joiners back off. If some thread sneaked in, give up
+        if (head_epoch_p->active_thread_count.fetch_sub(
+                CLEANING_THREAD_COUNT) > 0) {
+          head_epoch_p->active_thread_count.fetch_add(CLEANING_THREAD_COUNT);
+          break;
+        }
+
+        const GarbageNode *next_garbage_node_p = nullptr;
+        for (const GarbageNode *garbage_node_p =
+                 head_epoch_p->garbage_list_p.load();
+             garbage_node_p != nullptr;
+             garbage_node_p = next_garbage_node_p) {
+          if (garbage_node_p->is_key_node == true) {
+            list_p->FreeKeyNode(static_cast<KeyNode *>(garbage_node_p->node_p));
+          } else {
+            list_p->FreeValueNode(
+                static_cast<ValueNode *>(garbage_node_p->node_p));
+          }
+
+          next_garbage_node_p = garbage_node_p->next_p;
+          delete garbage_node_p;
+        }
+
+        EpochNode *next_epoch_node_p = head_epoch_p->next_p;
+        delete head_epoch_p;
+        head_epoch_p = next_epoch_node_p;
+      }
+    }
+
+    static constexpr int CLEANING_THREAD_COUNT = 0x7FFFFFFF;
+
+    SkipList *list_p;
+
+    // Only accessed by the garbage collecting thread
+    EpochNode *head_epoch_p;
+
+    // Written by the garbage collecting thread and read by workers. Joining
+    // the previous epoch for a short while is harmless
+    EpochNode *current_epoch_p;
+
+    // Set while a thread is collecting garbage
+    std::atomic<bool> gc_flag;
+  };
+
+  using EpochNode = typename EpochManager::EpochNode;
+
+ public:
+  /*
+   * Constructor - Creates the head tower, which has the maximum height and
+   *               whose key is never compared
+   */
+  SkipList(KeyComparator p_key_cmp_obj = KeyComparator{},
+           KeyEqualityChecker p_key_eq_obj = KeyEqualityChecker{},
+           ValueEqualityChecker p_value_eq_obj = ValueEqualityChecker{})
+      : key_cmp_obj{p_key_cmp_obj},
+        key_eq_obj{p_key_eq_obj},
+        value_eq_obj{p_value_eq_obj},
+        memory_footprint{0},
+        modification_count{0},
+        epoch_manager{this} {
+    head_p = AllocateKeyNode(KeyType{}, MAX_HEIGHT);
+
+    return;
+  }
+
+  /*
+   * Destructor - Frees every node still linked into the list
+   *
+   * Nodes that have been unlinked are owned by the epoch manager, which
+   * frees them when it is destroyed right after this body
+   */
+  ~SkipList() {
+    KeyNode *node_p = head_p;
+    while (node_p != nullptr) {
+      KeyNode *next_node_p = GetUnmarked(node_p->next_p[0].load());
+
+      ValueNode *value_node_p = GetUnmarked(node_p->value_list_p.load());
+      while (value_node_p != nullptr) {
+        ValueNode *next_value_node_p = GetUnmarked(value_node_p->next_p.load());
+        FreeValueNode(value_node_p);
+        value_node_p = next_value_node_p;
+      }
+
+      FreeKeyNode(node_p);
+      node_p = next_node_p;
+    }
+
+    return;
+  }
+
+  ///////////////////////////////////////////////////////////////////
+  // Key comparison
+  ///////////////////////////////////////////////////////////////////
+
+  inline bool KeyCmpLess(const KeyType &key1, const KeyType &key2) const {
+    return key_cmp_obj(key1, key2);
+  }
+
+  inline bool KeyCmpEqual(const KeyType &key1, const KeyType &key2) const {
+    return key_eq_obj(key1, key2);
+  }
+
+  inline bool KeyCmpLessEqual(const KeyType &key1, const KeyType &key2) const {
+    return !KeyCmpLess(key2, key1);
+  }
+
+  ///////////////////////////////////////////////////////////////////
+  // Modification
+  ///////////////////////////////////////////////////////////////////
+
+  /*
+   * Insert() - Insert a key-value pair
+   *
+   * If unique_key is true, the insert fails if the key already has a value.
+   * Otherwise it only fails if the exact key-value pair is already present
+   */
+  bool Insert(const KeyType &key, const ValueType &value, bool unique_key) {
+    return InsertInternal(key, value, unique_key, nullptr, nullptr);
+  }
+
+  /*
+   * ConditionalInsert() - Insert a key-value pair only if a given
+   *                       predicate fails for all values with a key
+   *
+   * If return false then either the predicate returned true for one of the
+   * values of the key (*predicate_satisfied is set), or the value is already
+   * in the index
+   */
+  bool ConditionalInsert(const KeyType &key, const ValueType &value,
+                         std::function<bool(const void *)> predicate,
+                         bool *predicate_satisfied) {
+    *predicate_satisfied = false;
+    return InsertInternal(key, value, false, &predicate, predicate_satisfied);
+  }
+
+  /*
+   * Delete() - Remove a key-value pair
+   *
+   * Returns false if the pair is not in the list
+   */
+  bool Delete(const KeyType &key, const ValueType &value) {
+    EpochNode *epoch_node_p = epoch_manager.JoinEpoch();
+
+    KeyNode *preds[MAX_HEIGHT];
+    KeyNode *succs[MAX_HEIGHT];
+    KeyNode *node_p = Find(key, preds, succs);
+
+    bool ret = false;
+    if (node_p != nullptr) {
+      // Claim the value by marking its next pointer. Only one thread may
+      // succeed, and that thread reports the deletion
+      ValueNode *value_node_p = GetUnmarked(node_p->value_list_p.load());
+      while (value_node_p != nullptr) {
+        ValueNode *next_p = value_node_p->next_p.load();
+        if (IsMarked(next_p) == false &&
+            value_eq_obj(value_node_p->value, value) == true) {
+          if (value_node_p->next_p.compare_exchange_strong(
+                  next_p, GetMarked(next_p)) == true) {
+            ret = true;
+            break;
+          }
+
+          // Someone inserted behind the value or deleted it, look again
+          continue;
+        }
+
+        value_node_p = GetUnmarked(next_p);
+      }
+
+      if (ret == true) {
+        modification_count.fetch_add(1);
+        CleanValueList(node_p);
+      }
+    }
+
+    epoch_manager.LeaveEpoch(epoch_node_p);
+
+    return ret;
+  }
+
+  ///////////////////////////////////////////////////////////////////
+  // Lookup
+  ///////////////////////////////////////////////////////////////////
+
+  /*
+   * GetValue() - Append all values of a key to the given vector
+   */
+  void GetValue(const KeyType &key, std::vector<ValueType> &value_list) {
+    EpochNode *epoch_node_p = epoch_manager.JoinEpoch();
+
+    KeyNode *node_p = FindGreaterEqual(key);
+    if (node_p != nullptr && KeyCmpEqual(node_p->key, key) == true) {
+      CollectValues(node_p, value_list);
+    }
+
+    epoch_manager.LeaveEpoch(epoch_node_p);
+
+    return;
+  }
+
+  /*
+   * class ForwardIterator - Iterates key-value pairs in ascending key order
+   *
+   * The iterator stays in the epoch it joined when it was created, so nodes
+   * it points to are not freed until it is destroyed
+   */
+  class ForwardIterator {
+   public:
+    ForwardIterator(SkipList *p_list_p, KeyNode *p_node_p)
+        : list_p{p_list_p},
+          epoch_node_p{nullptr},
+          node_p{p_node_p},
+          value_node_p{nullptr} {}
+
+    ForwardIterator(ForwardIterator &&other)
+        : list_p{other.list_p},
+          epoch_node_p{other.epoch_node_p},
+          node_p{other.node_p},
+          value_node_p{other.value_node_p} {
+      other.epoch_node_p = nullptr;
+    }
+
+    ~ForwardIterator() {
+      if (epoch_node_p != nullptr) {
+        list_p->epoch_manager.LeaveEpoch(epoch_node_p);
+      }
+    }
+
+    inline bool IsEnd() const { return node_p == nullptr; }
+
+    inline const KeyType &GetKey() const { return node_p->key; }
+
+    inline const ValueType &GetValue() const { return value_node_p->value; }
+
+    /*
+     * operator++ - Move to the next live value, crossing key nodes if the
+     *              current value list is exhausted
+     */
+    inline void operator++(int) {
+      value_node_p = list_p->NextLiveValue(value_node_p->next_p.load());
+      if (value_node_p == nullptr) {
+        node_p = GetUnmarked(node_p->next_p[0].load());
+        SkipEmpty();
+      }
+    }
+
+   private:
+    friend class SkipList;
+
+    // Advance to the first key node with a live value
+    void SkipEmpty() {
+      while (node_p != nullptr) {
+        value_node_p = list_p->NextLiveValue(node_p->value_list_p.load());
+        if (value_node_p != nullptr) {
+          break;
+        }
+        node_p = GetUnmarked(node_p->next_p[0].load());
+      }
+    }
+
+    SkipList *list_p;
+    EpochNode *epoch_node_p;
+    KeyNode *node_p;
+    ValueNode *value_node_p;
+
+    DISALLOW_COPY(ForwardIterator);
+  };
+
+  /*
+   * class ReverseIterator - Iterates key-value pairs in descending key order
+   *
+   * The list is singly linked, so every step back to the previous key is a
+   * search for the largest key less than the current one
+   */
+  class ReverseIterator {
+   public:
+    ReverseIterator(SkipList *p_list_p, KeyNode *p_node_p)
+        : list_p{p_list_p},
+          epoch_node_p{nullptr},
+          node_p{p_node_p},
+          value_node_p{nullptr} {}
+
+    ReverseIterator(ReverseIterator &&other)
+        : list_p{other.list_p},
+          epoch_node_p{other.epoch_node_p},
+          node_p{other.node_p},
+          value_node_p{other.value_node_p} {
+      other.epoch_node_p = nullptr;
+    }
+
+    ~ReverseIterator() {
+      if (epoch_node_p != nullptr) {
+        list_p->epoch_manager.LeaveEpoch(epoch_node_p);
+      }
+    }
+
+    inline bool IsEnd() const { return node_p == nullptr; }
+
+    inline const KeyType &GetKey() const { return node_p->key; }
+
+    inline const ValueType &GetValue() const { return value_node_p->value; }
+
+    inline void operator++(int) {
+      value_node_p = list_p->NextLiveValue(value_node_p->next_p.load());
+      if (value_node_p == nullptr) {
+        node_p = list_p->FindLess(node_p->key);
+        SkipEmpty();
+      }
+    }
+
+   private:
+    friend class SkipList;
+
+    // Step back to the first key node with a live value
+    void SkipEmpty() {
+      while (node_p != nullptr) {
+        value_node_p = list_p->NextLiveValue(node_p->value_list_p.load());
+        if (value_node_p != nullptr) {
+          break;
+        }
+        node_p = list_p->FindLess(node_p->key);
+      }
+    }
+
+    SkipList *list_p;
+    EpochNode *epoch_node_p;
+    KeyNode *node_p;
+    ValueNode *value_node_p;
+
+    DISALLOW_COPY(ReverseIterator);
+  };
+
+  /*
+   * Begin() - Iterator on the smallest key
+   */
+  ForwardIterator Begin() {
+    EpochNode *epoch_node_p = epoch_manager.JoinEpoch();
+
+    ForwardIterator itr{this, GetUnmarked(head_p->next_p[0].load())};
+    itr.epoch_node_p = epoch_node_p;
+    itr.SkipEmpty();
+
+    return itr;
+  }
+
+  /*
+   * Begin() - Iterator on the smallest key greater than or equal to the
+   *           given key
+   */
+  ForwardIterator Begin(const KeyType &start_key) {
+    EpochNode *epoch_node_p = epoch_manager.JoinEpoch();
+
+    ForwardIterator itr{this, FindGreaterEqual(start_key)};
+    itr.epoch_node_p = epoch_node_p;
+    itr.SkipEmpty();
+
+    return itr;
+  }
+
+  /*
+   * ReverseBegin() - Iterator on the largest key
+   */
+  ReverseIterator ReverseBegin() {
+    EpochNode *epoch_node_p = epoch_manager.JoinEpoch();
+
+    ReverseIterator itr{this, FindLast()};
+    itr.epoch_node_p = epoch_node_p;
+    itr.SkipEmpty();
+
+    return itr;
+  }
+
+  /*
+   * ReverseBegin() - Iterator on the largest key less than or equal to the
+   *                  given key
+   */
+  ReverseIterator ReverseBegin(const KeyType &start_key) {
+    EpochNode *epoch_node_p = epoch_manager.JoinEpoch();
+
+    ReverseIterator itr{this, FindLessEqual(start_key)};
+    itr.epoch_node_p = epoch_node_p;
+    itr.SkipEmpty();
+
+    return itr;
+  }
+
+  ///////////////////////////////////////////////////////////////////
+  // Garbage collection and statistics
+  ///////////////////////////////////////////////////////////////////
+
+  /*
+   * NeedGarbageCollection() - Whether any node could have been unlinked
+   *                           since the last garbage collection
+   */
+  bool NeedGarbageCollection() { return modification_count.load() != 0; }
+
+  /*
+   * PerformGarbageCollection() - Free the nodes of all epochs that no thread
+   *                              is in anymore, and start a new epoch
+   */
+  void PerformGarbageCollection() {
+    modification_count.store(0);
+    epoch_manager.PerformGarbageCollection();
+
+    return;
+  }
+
+  /*
+   * GetMemoryFootprint() - Bytes of all key and value nodes that have not
+   *                        been freed yet, including garbage
+   */
+  size_t GetMemoryFootprint() const { return memory_footprint.load(); }
+
+ private:
+  ///////////////////////////////////////////////////////////////////
+  // Node allocation
+  ///////////////////////////////////////////////////////////////////
+
+  static inline size_t GetKeyNodeSize(int height) {
+    return sizeof(KeyNode) + (height - 1) * sizeof(std::atomic<KeyNode *>);
+  }
+
+  KeyNode *AllocateKeyNode(const KeyType &key, int height) {
+    size_t size = GetKeyNodeSize(height);
+    void *memory_p = ::operator new(size);
+
+    KeyNode *node_p = new (memory_p) KeyNode{key, height};
+    for (int level = 0; level < height; level++) {
+      new (&node_p->next_p[level]) std::atomic<KeyNode *>{nullptr};
+    }
+
+    memory_footprint.fetch_add(size);
+    return node_p;
+  }
+
+  void FreeKeyNode(KeyNode *node_p) {
+    memory_footprint.fetch_sub(GetKeyNodeSize(node_p->height));
+
+    node_p->~KeyNode();
+    ::operator delete(node_p);
+  }
+
+  ValueNode *AllocateValueNode(const ValueType &value) {
+    memory_footprint.fetch_add(sizeof(ValueNode));
+    return new ValueNode{value};
+  }
+
+  void FreeValueNode(ValueNode *value_node_p) {
+    memory_footprint.fetch_sub(sizeof(ValueNode));
+    delete value_node_p;
+  }
+
+  /*
+   * RandomHeight() - Height of a new tower, geometrically distributed
+   */
+  static int RandomHeight() {
+    static thread_local uint64_t seed =
+        std::hash<std::thread::id>{}(std::this_thread::get_id()) | 0x1UL;
+
+    // xorshift64
+    seed ^= seed << 13;
+    seed ^= seed >> 7;
+    seed ^= seed << 17;
+
+    int height = 1;
+    uint64_t bits = seed;
+    while (height < MAX_HEIGHT && (bits % BRANCHING_FACTOR) == 0) {
+      height++;
+      bits /= BRANCHING_FACTOR;
+    }
+
+    return height;
+  }
+
+  ///////////////////////////////////////////////////////////////////
+  // Search
+  ///////////////////////////////////////////////////////////////////
+
+  /*
+   * MarkLevel() - Mark a dead node as removed from the given level
+   */
+  static void MarkLevel(KeyNode *node_p, int level) {
+    KeyNode *next_p = node_p->next_p[level].load();
+    while (IsMarked(next_p) == false) {
+      if (node_p->next_p[level].compare_exchange_weak(next_p,
+                                                      GetMarked(next_p))) {
+        break;
+      }
+    }
+  }
+
+  /*
+   * Find() - Locate the predecessor and successor of a key on every level
+   *
+   * Dead nodes on the way are marked and unlinked. If walk_equal is true the
+   * search also walks past the live node of the key, which the final unlink
+   * of a dead node uses to make sure no level still reaches it.
+   *
+   * Returns the live node of the key, or nullptr if there is none
+   */
+  KeyNode *Find(const KeyType &key, KeyNode **preds, KeyNode **succs,
+                bool walk_equal = false) {
+  retry:
+    KeyNode *pred_p = head_p;
+    for (int level = MAX_HEIGHT - 1; level >= 0; level--) {
+      KeyNode *curr_p = GetUnmarked(pred_p->next_p[level].load());
+      while (curr_p != nullptr) {
+        if (IsDead(curr_p) == true) {
+          MarkLevel(curr_p, level);
+        }
+
+        KeyNode *succ_p = curr_p->next_p[level].load();
+        if (IsMarked(succ_p) == true) {
+          // Unlink the node from this level. If the predecessor changed in
+          // the meantime, start over from the top
+          KeyNode *expected_p = curr_p;
+          if (pred_p->next_p[level].compare_exchange_strong(
+                  expected_p, GetUnmarked(succ_p)) == false) {
+            goto retry;
+          }
+
+          curr_p = GetUnmarked(succ_p);
+          continue;
+        }
+
+        if (KeyCmpLess(curr_p->key, key) == true ||
+            (walk_equal == true && KeyCmpEqual(curr_p->key, key) == true)) {
+          pred_p = curr_p;
+          curr_p = succ_p;
+        } else {
+          break;
+        }
+      }
+
+      preds[level] = pred_p;
+      succs[level] = curr_p;
+    }
+
+    if (succs[0] != nullptr && KeyCmpEqual(succs[0]->key, key) == true) {
+      return succs[0];
+    }
+
+    return nullptr;
+  }
+
+  /*
+   * FindGreaterEqual() - Read-only search for the first node whose key is
+   *                      greater than or equal to the given key
+   */
+  KeyNode *FindGreaterEqual(const KeyType &key) {
+    KeyNode *pred_p = head_p;
+    KeyNode *curr_p = nullptr;
+    for (int level = MAX_HEIGHT - 1; level >= 0; level--) {
+      curr_p = GetUnmarked(pred_p->next_p[level].load());
+      while (curr_p != nullptr && KeyCmpLess(curr_p->key, key) == true) {
+        pred_p = curr_p;
+        curr_p = GetUnmarked(curr_p->next_p[level].load());
+      }
+    }
+
+    return curr_p;
+  }
+
+  /*
+   * FindLess() - Read-only search for the last node whose key is less than
+   *              the given key, or nullptr if there is none
+   */
+  KeyNode *FindLess(const KeyType &key) {
+    KeyNode *pred_p = head_p;
+    for (int level = MAX_HEIGHT - 1; level >= 0; level--) {
+      KeyNode *curr_p = GetUnmarked(pred_p->next_p[level].load());
+      while (curr_p != nullptr && KeyCmpLess(curr_p->key, key) == true) {
+        pred_p = curr_p;
+        curr_p = GetUnmarked(curr_p->next_p[level].load());
+      }
+    }
+
+    return (pred_p == head_p) ? nullptr : pred_p;
+  }
+
+  /*
+   * FindLessEqual() - Read-only search for the last node whose key is less
+   *                   than or equal to the given key
+   */
+  KeyNode *FindLessEqual(const KeyType &key) {
+    KeyNode *pred_p = head_p;
+    for (int level = MAX_HEIGHT - 1; level >= 0; level--) {
+      KeyNode *curr_p = GetUnmarked(pred_p->next_p[level].load());
+      while (curr_p != nullptr && KeyCmpLessEqual(curr_p->key, key) == true) {
+        pred_p = curr_p;
+        curr_p = GetUnmarked(curr_p->next_p[level].load());
+      }
+    }
+
+    return (pred_p == head_p) ? nullptr : pred_p;
+  }
+
+  /*
+   * FindLast() - Read-only search for the node with the largest key
+   */
+  KeyNode *FindLast() {
+    KeyNode *pred_p = head_p;
+    for (int level = MAX_HEIGHT - 1; level >= 0; level--) {
+      KeyNode *curr_p = GetUnmarked(pred_p->next_p[level].load());
+      while (curr_p != nullptr) {
+        pred_p = curr_p;
+        curr_p = GetUnmarked(curr_p->next_p[level].load());
+      }
+    }
+
+    return (pred_p == head_p) ? nullptr : pred_p;
+  }
+
+  /*
+   * NextLiveValue() - The first value node starting at the given (possibly
+   *                   marked) pointer that has not been deleted
+   */
+  ValueNode *NextLiveValue(ValueNode *value_node_p) const {
+    value_node_p = GetUnmarked(value_node_p);
+    while (value_node_p != nullptr &&
+           IsMarked(value_node_p->next_p.load()) == true) {
+      value_node_p = GetUnmarked(value_node_p->next_p.load());
+    }
+
+    return value_node_p;
+  }
+
+  void CollectValues(KeyNode *node_p, std::vector<ValueType> &value_list) {
+    for (ValueNode *value_node_p =
+             NextLiveValue(node_p->value_list_p.load());
+         value_node_p != nullptr;
+         value_node_p = NextLiveValue(value_node_p->next_p.load())) {
+      value_list.push_back(value_node_p->value);
+    }
+  }
+
+  ///////////////////////////////////////////////////////////////////
+  // Modification internals
+  ///////////////////////////////////////////////////////////////////
+
+  enum class InsertValueResult { SUCCESS, DUPLICATE, DEAD };
+
+  /*
+   * InsertValue() - Push a value node at the head of the value list of a
+   *                 live key node
+   *
+   * All inserts go through the head, so a concurrent insert always makes
+   * the CAS fail and the duplicate check is repeated
+   */
+  InsertValueResult InsertValue(KeyNode *node_p, ValueNode *new_value_node_p,
+                                bool unique_key,
+                                std::function<bool(const void *)> *predicate_p,
+                                bool *predicate_satisfied) {
+    while (1) {
+      ValueNode *head_value_p = node_p->value_list_p.load();
+      if (IsMarked(head_value_p) == true) {
+        return InsertValueResult::DEAD;
+      }
+
+      for (ValueNode *value_node_p = NextLiveValue(head_value_p);
+           value_node_p != nullptr;
+           value_node_p = NextLiveValue(value_node_p->next_p.load())) {
+        if (predicate_p != nullptr &&
+            (*predicate_p)(value_node_p->value) == true) {
+          *predicate_satisfied = true;
+          return InsertValueResult::DUPLICATE;
+        }
+
+        if (unique_key == true ||
+            value_eq_obj(value_node_p->value, new_value_node_p->value)) {
+          return InsertValueResult::DUPLICATE;
+        }
+      }
+
+      new_value_node_p->next_p.store(head_value_p);
+      if (node_p->value_list_p.compare_exchange_strong(
+              head_value_p, new_value_node_p) == true) {
+        return InsertValueResult::SUCCESS;
+      }
+    }
+  }
+
+  bool InsertInternal(const KeyType &key, const ValueType &value,
+                      bool unique_key,
+                      std::function<bool(const void *)> *predicate_p,
+                      bool *predicate_satisfied) {
+    EpochNode *epoch_node_p = epoch_manager.JoinEpoch();
+
+    KeyNode *preds[MAX_HEIGHT];
+    KeyNode *succs[MAX_HEIGHT];
+
+    ValueNode *value_node_p = AllocateValueNode(value);
+    KeyNode *new_node_p = nullptr;
+
+    bool ret = false;
+    while (1) {
+      KeyNode *node_p = Find(key, preds, succs);
+      if (node_p != nullptr) {
+        InsertValueResult result = InsertValue(
+            node_p, value_node_p, unique_key, predicate_p, predicate_satisfied);
+        if (result == InsertValueResult::DEAD) {
+          // The next Find() unlinks the dead node
+          continue;
+        }
+
+        ret = (result == InsertValueResult::SUCCESS);
+        break;
+      }
+
+      // The key is not in the list, link a new tower at level 0 first
+      if (new_node_p == nullptr) {
+        new_node_p = AllocateKeyNode(key, RandomHeight());
+      }
+
+      value_node_p->next_p.store(nullptr);
+      new_node_p->value_list_p.store(value_node_p);
+      for (int level = 0; level < new_node_p->height; level++) {
+        new_node_p->next_p[level].store(succs[level]);
+      }
+
+      KeyNode *expected_p = succs[0];
+      if (preds[0]->next_p[0].compare_exchange_strong(expected_p,
+                                                      new_node_p) == true) {
+        LinkUpperLevels(new_node_p, preds, succs);
+        ReleaseKeyNode(new_node_p);
+
+        new_node_p = nullptr;
+        ret = true;
+        break;
+      }
+    }
+
+    // Nodes that were never published are freed immediately
+    if (new_node_p != nullptr) {
+      FreeKeyNode(new_node_p);
+    }
+
+    if (ret == false) {
+      FreeValueNode(value_node_p);
+    }
+
+    epoch_manager.LeaveEpoch(epoch_node_p);
+
+    return ret;
+  }
+
+  /*
+   * LinkUpperLevels() - Link a tower that is already on level 0 into the
+   *                     remaining levels, giving up once the node dies
+   */
+  void LinkUpperLevels(KeyNode *node_p, KeyNode **preds, KeyNode **succs) {
+    for (int level = 1; level < node_p->height; level++) {
+      while (1) {
+        KeyNode *next_p = node_p->next_p[level].load();
+        if (IsMarked(next_p) == true) {
+          return;
+        }
+
+        if (next_p != succs[level] &&
+            node_p->next_p[level].compare_exchange_strong(
+                next_p, succs[level]) == false) {
+          return;
+        }
+
+        KeyNode *expected_p = succs[level];
+        if (preds[level]->next_p[level].compare_exchange_strong(
+                expected_p, node_p) == true) {
+          break;
+        }
+
+        if (Find(node_p->key, preds, succs) != node_p) {
+          return;
+        }
+      }
+    }
+  }
+
+  /*
+   * CleanValueList() - Unlink every deleted value node of a key node and
+   *                    kill the key node if no value is left
+   */
+  void CleanValueList(KeyNode *node_p) {
+  retry:
+    std::atomic<ValueNode *> *prev_p = &node_p->value_list_p;
+    ValueNode *curr_p = prev_p->load();
+    if (IsMarked(curr_p) == true) {
+      return;
+    }
+
+    while (curr_p != nullptr) {
+      ValueNode *next_p = curr_p->next_p.load();
+      if (IsMarked(next_p) == true) {
+        ValueNode *expected_p = curr_p;
+        if (prev_p->compare_exchange_strong(expected_p, GetUnmarked(next_p)) ==
+            false) {
+          goto retry;
+        }
+
+        // Whoever unlinks a value node retires it
+        epoch_manager.AddGarbageNode(curr_p, false);
+        curr_p = GetUnmarked(next_p);
+      } else {
+        prev_p = &curr_p->next_p;
+        curr_p = next_p;
+      }
+    }
+
+    // Kill the key node if its value list is empty. Inserts that see the
+    // mark give up on the node, so it can be unlinked
+    ValueNode *empty_p = nullptr;
+    if (node_p->value_list_p.compare_exchange_strong(
+            empty_p, GetMarked<ValueNode>(nullptr)) == true) {
+      for (int level = node_p->height - 1; level >= 0; level--) {
+        MarkLevel(node_p, level);
+      }
+
+      ReleaseKeyNode(node_p);
+    }
+  }
+
+  /*
+   * ReleaseKeyNode() - Drop a reference on a key node. The last reference is
+   *                    only dropped once the node is dead, and then unlinks
+   *                    it from all levels and retires it
+   */
+  void ReleaseKeyNode(KeyNode *node_p) {
+    if (node_p->unlink_ref.fetch_sub(1) != 1) {
+      return;
+    }
+
+    PELOTON_ASSERT(IsDead(node_p) == true);
+
+    KeyNode *preds[MAX_HEIGHT];
+    KeyNode *succs[MAX_HEIGHT];
+    Find(node_p->key, preds, succs, true);
+
+    epoch_manager.AddGarbageNode(node_p, true);
+  }
+
+ private:
+  // Key comparator
+  const KeyComparator key_cmp_obj;
+
+  // Raw key eq checker
+  const KeyEqualityChecker key_eq_obj;
+
+  // Check whether values are equivalent
+  const ValueEqualityChecker value_eq_obj;
+
+  // Bytes of allocated nodes
+  std::atomic<size_t> memory_footprint;
+
+  // Number of deletes since the last garbage collection
+  std::atomic<uint64_t> modification_count;
+
+  // The head tower, its key is never looked at
+  KeyNode *head_p;
+
+  // Declared last, so it is destroyed first and frees the garbage before
+  // the list tears down
+  EpochManager epoch_manager;
 };
 
 }  // namespace index
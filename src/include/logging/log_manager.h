@@ -61,8 +61,10 @@ class LogManager {
 
   virtual size_t GetTableCount() { return 0; }
 
-  virtual void LogBegin() {}
+  // called once the commit id of a transaction is known.
+  virtual void LogBegin(const cid_t &commit_id UNUSED_ATTRIBUTE) {}
 
+  // called after a transaction has installed all its versions.
   virtual void LogEnd() {}
 
   virtual void LogInsert(const ItemPointer & UNUSED_ATTRIBUTE) {}
@@ -0,0 +1,90 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// logging_util.h
+//
+// Identification: src/include/logging/logging_util.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "common/internal_types.h"
+
+namespace peloton {
+
+namespace storage {
+class DataTable;
+}
+
+namespace logging {
+
+//===--------------------------------------------------------------------===//
+// LoggingUtil
+//===--------------------------------------------------------------------===//
+
+class LoggingUtil {
+ public:
+  //===--------------------------------------------------------------------===//
+  // FILE SYSTEM RELATED OPERATIONS
+  //===--------------------------------------------------------------------===//
+
+  static bool CheckDirectoryExistence(const char *dir_name);
+
+  static bool CreateDirectory(const char *dir_name, int mode);
+
+  static bool RemoveDirectory(const char *dir_name, bool only_remove_file);
+
+  static bool OpenFile(const char *name, const char *mode,
+                       FileHandle &file_handle);
+
+  static bool CloseFile(FileHandle &file_handle);
+
+  // flush the user-space buffer and force the file to disk.
+  static void FFlushFsync(FileHandle &file_handle);
+
+  static size_t GetFileSize(FileHandle &file_handle);
+
+  static bool ReadNBytesFromFile(FileHandle &file_handle, void *bytes_read,
+                                 size_t n);
+
+  //===--------------------------------------------------------------------===//
+  // LOG RECORD RELATED OPERATIONS
+  //===--------------------------------------------------------------------===//
+
+  /**
+   * @brief      Gets the columns that identify a tuple in update and delete
+   *             records: the primary key if the table has one, otherwise
+   *             every column of the table.
+   *
+   * @param      table  The table
+   *
+   * @return     The key columns.
+   */
+  static std::vector<oid_t> GetLogKeyColumns(storage::DataTable *table);
+
+  /**
+   * @brief      Whether the table is one of the core catalog tables
+   *             (pg_database, pg_namespace, pg_table, pg_index, pg_attribute,
+   *             pg_layout and pg_constraint). They are recovered before the
+   *             tables that they describe.
+   */
+  static bool IsCoreCatalogTable(const oid_t database_id,
+                                 const oid_t table_id);
+
+  /**
+   * @brief      Whether the tuples of the table are checkpointed and
+   *             recovered. The other system catalogs are rebuilt when the
+   *             catalog is bootstrapped.
+   */
+  static bool IsRecoveredTable(const oid_t database_id, const oid_t table_id);
+};
+
+}  // namespace logging
+}  // namespace peloton
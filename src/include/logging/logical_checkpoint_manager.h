@@ -12,15 +12,42 @@
 
 #pragma once
 
+#include <atomic>
+#include <string>
+
 #include "logging/checkpoint_manager.h"
+#include "type/serializeio.h"
 
 namespace peloton {
+
+namespace storage {
+class DataTable;
+}
+
 namespace logging {
 
 //===--------------------------------------------------------------------===//
 // logical checkpoint Manager
 //===--------------------------------------------------------------------===//
 
+/**
+ * checkpoint directory layout :
+ *
+ * dir_name + "/checkpoint_" + epoch_id + "/"
+ *    + "table_" + database_id + "_" + table_id + "_" + part_id
+ *    + "checkpoint_info"
+ *
+ * a checkpoint holds every tuple that is visible to the snapshot of all
+ * transactions that began in epoch_id or an earlier epoch. the tile groups
+ * of a table are split into parts that are written in parallel. every tuple
+ * is framed as | length (int) | values of every column |.
+ *
+ * checkpoint_info holds the snapshot commit id and is written once every
+ * table file is durable. a checkpoint without it is incomplete.
+ *
+ * the checkpoint only reads version headers. writers are never blocked, and
+ * the snapshot transaction keeps the versions it needs from being recycled.
+ */
 class LogicalCheckpointManager : public CheckpointManager {
  public:
   LogicalCheckpointManager(const LogicalCheckpointManager &) = delete;
@@ -28,7 +55,12 @@ class LogicalCheckpointManager : public CheckpointManager {
   LogicalCheckpointManager(LogicalCheckpointManager &&) = delete;
   LogicalCheckpointManager &operator=(LogicalCheckpointManager &&) = delete;
 
-  LogicalCheckpointManager(const int thread_count) : checkpointer_thread_count_(thread_count) {}
+  LogicalCheckpointManager(const int thread_count)
+      : checkpointer_thread_count_(thread_count),
+        checkpoint_dir_("./checkpoints"),
+        checkpoint_interval_(30),
+        checkpoint_thread_(nullptr),
+        last_checkpoint_eid_(INVALID_EID) {}
 
   virtual ~LogicalCheckpointManager() {}
 
@@ -37,23 +69,102 @@ class LogicalCheckpointManager : public CheckpointManager {
     return checkpoint_manager;
   }
 
-  virtual void Reset() { is_running_ = false; }
+  virtual void Reset() override { is_running_ = false; }
+
+  /**
+   * @brief      Sets the checkpoint directory. Must be called before
+   *             checkpointing starts.
+   *
+   * @param[in]  checkpoint_dir  The checkpoint directory
+   */
+  void SetDirectory(const std::string &checkpoint_dir);
+
+  const std::string &GetDirectory() const { return checkpoint_dir_; }
+
+  // the number of seconds between two checkpoints.
+  void SetCheckpointInterval(const int checkpoint_interval) {
+    checkpoint_interval_ = checkpoint_interval;
+  }
+
+  virtual void StartCheckpointing(
+      std::vector<std::unique_ptr<std::thread>> &checkpoint_threads) override;
+
+  virtual void StartCheckpointing() override;
+
+  virtual void StopCheckpointing() override;
+
+  virtual void RegisterTable(const oid_t &table_id UNUSED_ATTRIBUTE) override {}
 
-  virtual void StartLogging(std::vector<std::unique_ptr<std::thread>> & UNUSED_ATTRIBUTE) {}
+  virtual void DeregisterTable(const oid_t &table_id UNUSED_ATTRIBUTE) override {}
 
-  virtual void StartLogging() {}
+  virtual size_t GetTableCount() override { return 0; }
 
-  virtual void StopLogging() {}
+  /**
+   * @brief      Takes a checkpoint, then drops the older checkpoints and the
+   *             log files it covers.
+   *
+   * @return     The epoch identifier of the checkpoint.
+   */
+  eid_t DoCheckpoint();
 
-  virtual void RegisterTable(const oid_t &table_id UNUSED_ATTRIBUTE) {}
+  eid_t GetLastCheckpointEpochId() const { return last_checkpoint_eid_.load(); }
 
-  virtual void DeregisterTable(const oid_t &table_id UNUSED_ATTRIBUTE) {}
+  // the commit id of the snapshot of the checkpoint of the given epoch.
+  static cid_t GetCheckpointCommitId(const eid_t checkpoint_eid) {
+    return ((checkpoint_eid + 1) << 32) - 1;
+  }
 
-  virtual size_t GetTableCount() { return 0; }
+ private:
+  // a range of tile groups of a table that goes into a single file.
+  struct CheckpointTask {
+    storage::DataTable *table;
+    oid_t tile_group_begin;
+    oid_t tile_group_end;
+    size_t part_id;
+  };
+
+  void Run();
+
+  void RunCheckpointThread(const std::vector<CheckpointTask> *tasks,
+                           const std::string *checkpoint_path,
+                           const cid_t snapshot_cid);
+
+  void CheckpointTileGroups(const CheckpointTask &task,
+                            const std::string &checkpoint_path,
+                            const cid_t snapshot_cid,
+                            CopySerializeOutput &output);
+
+  // drop every checkpoint that is older than the given one.
+  void RemoveOldCheckpoints(const eid_t checkpoint_eid);
+
+  std::string GetCheckpointPath(const eid_t checkpoint_eid) const {
+    return checkpoint_dir_ + "/" + checkpoint_dirname_prefix_ + "_" +
+           std::to_string(checkpoint_eid);
+  }
 
  private:
   int checkpointer_thread_count_;
 
+  std::string checkpoint_dir_;
+
+  int checkpoint_interval_;
+
+  std::unique_ptr<std::thread> checkpoint_thread_;
+
+  std::atomic<eid_t> last_checkpoint_eid_;
+
+  std::atomic<size_t> next_task_;
+
+  const std::string checkpoint_dirname_prefix_ = "checkpoint";
+
+  // how often the checkpoint thread checks whether it should stop.
+  const size_t sleep_period_ms_ = 100;
+
+  // the number of tile groups in a single table file.
+  const oid_t tile_group_chunk_size_ = 64;
+
+  // the output buffer is written out once it grows beyond this size.
+  const size_t flush_threshold_ = 1 << 20;
 };
 
 }  // namespace logging
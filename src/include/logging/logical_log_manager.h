@@ -12,7 +12,15 @@
 
 #pragma once
 
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+
 #include "logging/log_manager.h"
+#include "logging/log_record.h"
+#include "logging/logical_logger.h"
+#include "logging/worker_context.h"
 
 namespace peloton {
 namespace logging {
@@ -24,8 +32,8 @@ namespace logging {
 
 /**
  * logging file name layout :
- * 
- * dir_name + "/" + prefix + "_" + epoch_id
+ *
+ * dir_name + "/" + prefix + "_" + logger_id + "_" + epoch_id
  *
  *
  * logging file layout :
@@ -38,6 +46,19 @@ namespace logging {
  *
  * NOTE: tuple length can be obtained from the table schema.
  *
+ * every record is framed as | length (int) | record_type (byte) | body |.
+ * records of the same epoch are grouped between an EPOCH_BEGIN and an
+ * EPOCH_END record. the bodies are:
+ *
+ *  TRANSACTION_BEGIN / TRANSACTION_COMMIT : | commit_id |
+ *  TUPLE_INSERT : | database_id | table_id | new tuple |
+ *  TUPLE_UPDATE : | database_id | table_id | old key | new tuple |
+ *  TUPLE_DELETE : | database_id | table_id | old key |
+ *
+ * the key is made of the columns returned by LoggingUtil::GetLogKeyColumns.
+ *
+ * the persistent epoch file (pepoch) lives in the first logging directory.
+ * every epoch up to the last id appended to it is durable.
  */
 
 class LogicalLogManager : public LogManager {
@@ -47,7 +68,14 @@ class LogicalLogManager : public LogManager {
   LogicalLogManager(LogicalLogManager &&) = delete;
   LogicalLogManager &operator=(LogicalLogManager &&) = delete;
 
-  LogicalLogManager(const int thread_count) : logger_thread_count_(thread_count) {}
+  LogicalLogManager(const int thread_count)
+      : logger_thread_count_(thread_count),
+        worker_count_(0),
+        session_id_(0),
+        pepoch_thread_(nullptr),
+        pepoch_running_(false),
+        persist_epoch_id_(INVALID_EID),
+        synchronous_commit_(true) {}
 
   virtual ~LogicalLogManager() {}
 
@@ -56,73 +84,145 @@ class LogicalLogManager : public LogManager {
     return log_manager;
   }
 
-  // virtual void SetDirectories(const std::vector<std::string> &logging_dirs) override {
-  //   logger_dirs_ = logging_dirs;
+  /**
+   * @brief      Sets the logging directories. One logger is created for
+   *             every directory. Must be called before logging starts.
+   *
+   * @param[in]  logging_dirs  The logging directories
+   */
+  void SetDirectories(const std::vector<std::string> &logging_dirs);
+
+  const std::vector<std::string> &GetDirectories() { return logger_dirs_; }
+
+  /**
+   * @brief      Whether a commit waits for its epoch to become durable.
+   */
+  void SetSynchronousCommit(const bool synchronous_commit) {
+    synchronous_commit_ = synchronous_commit;
+  }
 
-  //   if (logging_dirs.size() > 0) {
-  //     pepoch_dir_ = logging_dirs.at(0);
-  //   }
-  //   // check the existence of logging directories.
-  //   // if not exists, then create the directory.
-  //   for (auto logging_dir : logging_dirs) {
-  //     if (LoggingUtil::CheckDirectoryExistence(logging_dir.c_str()) == false) {
-  //       LOG_INFO("Logging directory %s is not accessible or does not exist", logging_dir.c_str());
-  //       bool res = LoggingUtil::CreateDirectory(logging_dir.c_str(), 0700);
-  //       if (res == false) {
-  //         LOG_ERROR("Cannot create directory: %s", logging_dir.c_str());
-  //       }
-  //     }
-  //   }
+  /**
+   * @brief      Recovers the tables from the log in the logging directories.
+   *             Must be called before logging and the epoch thread start,
+   *             since it moves the current epoch past the recovered ones.
+   *             The catalog is recovered first, and creates the tables
+   *             that it describes. Throws a CatalogException if the log or
+   *             the checkpoint holds records of tables that neither exist
+   *             nor are in the recovered catalog.
+   *
+   * @param[in]  recovery_thread_count  The number of recovery threads
+   * @param[in]  checkpoint_dir         The checkpoint directory, if any
+   *
+   * @return     The persist epoch identifier of the log.
+   */
+  eid_t DoRecovery(const size_t recovery_thread_count,
+                   const std::string &checkpoint_dir = "");
+
+  /**
+   * @brief      Removes the log files that only hold epochs up to the given
+   *             one. Called once a checkpoint of that epoch is durable.
+   *
+   * @param[in]  checkpoint_eid  The epoch identifier of the checkpoint
+   */
+  void TruncateLog(const eid_t checkpoint_eid);
+
+  virtual void StartLogging(
+      std::vector<std::unique_ptr<std::thread>> &pepoch_threads) override;
+
+  virtual void StartLogging() override;
+
+  virtual void StopLogging() override;
 
-  //   logger_count_ = logging_dirs.size();
-  //   for (size_t i = 0; i < logger_count_; ++i) {
-  //     loggers_.emplace_back(new PhyLogLogger(i, logging_dirs.at(i)));
-  //   }
-  // }
+  virtual void RegisterTable(const oid_t &table_id UNUSED_ATTRIBUTE) override {}
 
-  // virtual const std::vector<std::string> &GetDirectories() override {
-  //   return logger_dirs_;
-  // }
+  virtual void DeregisterTable(const oid_t &table_id UNUSED_ATTRIBUTE) override {}
 
+  virtual size_t GetTableCount() override { return 0; }
 
-  virtual void StartLogging(std::vector<std::unique_ptr<std::thread>> & UNUSED_ATTRIBUTE) override {}
+  // bind the current thread to a logger.
+  void RegisterWorker();
 
-  virtual void StartLogging() override {}
+  // the logger drops the context once it has persisted everything in it.
+  void DeregisterWorker();
 
-  virtual void StopLogging() override {}
+  // whether the current thread is bound to a logger of the current session.
+  bool IsRegisteredWorker() const;
 
-  virtual void RegisterTable(const oid_t &table_id UNUSED_ATTRIBUTE) override {}
+  virtual void LogBegin(const cid_t &commit_id) override;
 
-  virtual void DeregisterTable(const oid_t &table_id UNUSED_ATTRIBUTE) override {}
+  virtual void LogEnd() override;
 
-  virtual size_t GetTableCount() override { return 0; }
+  virtual void LogInsert(const ItemPointer &tuple_pos) override;
+
+  virtual void LogUpdate(const ItemPointer &tuple_pos) override;
 
-  virtual void LogBegin() override {}
+  virtual void LogDelete(const ItemPointer &tuple_pos_deleted) override;
 
-  virtual void LogEnd() override {}
+  /**
+   * @brief      Gets the persist epoch identifier. Every transaction that
+   *             committed in this epoch or an earlier one is durable.
+   *
+   * @return     The persist epoch identifier.
+   */
+  eid_t GetPersistEpochId() const { return persist_epoch_id_.load(); }
 
-  virtual void LogInsert(const ItemPointer & UNUSED_ATTRIBUTE) override {}
-  
-  virtual void LogUpdate(const ItemPointer & UNUSED_ATTRIBUTE) override {}
-  
-  virtual void LogDelete(const ItemPointer & UNUSED_ATTRIBUTE) override { }
+  /**
+   * @brief      Blocks until the given epoch is durable or logging stops.
+   *
+   * @param[in]  epoch_id  The epoch identifier
+   */
+  void WaitForPersistEpoch(const eid_t epoch_id);
+
+ private:
+  void StartLoggers();
+
+  void RunPepochLogger();
+
+  // write the begin record of the current transaction before its first
+  // tuple record. transactions that write nothing are never logged.
+  void LogTxnBeginIfNeeded();
+
+  void WriteRecordToBuffer(LogRecord &record);
+
+  // get a buffer for the open epoch of the current worker.
+  std::unique_ptr<LogBuffer> GetBuffer(WorkerContext *ctx,
+                                       const eid_t epoch_id);
+
+  std::string GetPepochFileFullPath() {
+    return pepoch_dir_ + "/" + pepoch_filename_;
+  }
 
  private:
   int logger_thread_count_;
 
-  // std::atomic<oid_t> worker_count_;
+  std::atomic<oid_t> worker_count_;
+
+  // bumped whenever the loggers are replaced.
+  std::atomic<size_t> session_id_;
+
+  std::vector<std::string> logger_dirs_;
+
+  std::vector<std::shared_ptr<LogicalLogger>> loggers_;
+
+  std::unique_ptr<std::thread> pepoch_thread_;
+
+  // set to false only after every logger has drained its workers.
+  std::atomic<bool> pepoch_running_;
 
-  // std::vector<std::string> logger_dirs_;
+  std::string pepoch_dir_;
 
-  // std::vector<std::shared_ptr<PhyLogLogger>> loggers_;
+  const std::string pepoch_filename_ = "pepoch";
 
-  // std::unique_ptr<std::thread> pepoch_thread_;
-  // volatile bool is_running_;
+  // how long the pepoch thread waits for the loggers to make progress.
+  const size_t pepoch_sleep_period_us_ = 1000;
 
-  // std::string pepoch_dir_;
+  std::atomic<eid_t> persist_epoch_id_;
 
-  // const std::string pepoch_filename_ = "pepoch";
+  // committing transactions wait here for their epoch to become durable.
+  std::mutex persist_mutex_;
+  std::condition_variable persist_cv_;
 
+  bool synchronous_commit_;
 };
 
 }  // namespace logging
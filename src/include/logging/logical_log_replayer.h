@@ -0,0 +1,261 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// logical_log_replayer.h
+//
+// Identification: src/include/logging/logical_log_replayer.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "common/internal_types.h"
+#include "common/macros.h"
+
+namespace peloton {
+
+class SerializeInput;
+
+namespace storage {
+class DataTable;
+}
+
+namespace logging {
+
+//===--------------------------------------------------------------------===//
+// Logical Log Replayer
+//===--------------------------------------------------------------------===//
+
+/**
+ * Rebuilds the tables from the files written by the logical loggers.
+ *
+ * Recovery runs in three parallel phases:
+ *
+ *  0. if there is a checkpoint, every checkpoint file is loaded by its own
+ *     thread. the log records it covers are skipped.
+ *  1. every log file is read by its own thread. only the epochs up to the
+ *     persist epoch found in the pepoch file are kept, and only the
+ *     transactions that reached their commit record.
+ *  2. the records are partitioned by table. every table is replayed by a
+ *     single thread in commit id order, which leaves the latest committed
+ *     image of every key.
+ *  3. the images are split into chunks that are inserted by all threads at
+ *     once, so that tile groups and indexes are populated in parallel.
+ *
+ * The non-durable tail of the log is cut off afterwards, so that it can
+ * never be replayed by a later recovery.
+ *
+ * The core catalog tables are recovered like the user tables, and the
+ * tables they describe are created from their rows. records of tables that
+ * do not exist yet are kept unparsed, and phases 2 and 3 run in rounds: once
+ * the rows of pg_database are installed, the catalog creates the databases
+ * and their system catalogs. once the rows of pg_table and the other
+ * catalogs are installed, it creates the user tables, whose records are
+ * installed in the next round. the rows that the rebuilt catalog holds
+ * already fail to insert and are skipped.
+ *
+ * records of tables that are still missing after the last round are counted,
+ * unless the log drops the table or its database, so that the caller can
+ * refuse to start instead of silently dropping them.
+ */
+class LogicalLogReplayer {
+ public:
+  LogicalLogReplayer(const std::vector<std::string> &log_dirs,
+                     const std::string &pepoch_file,
+                     const size_t recovery_thread_count)
+      : log_dirs_(log_dirs),
+        pepoch_file_(pepoch_file),
+        recovery_thread_count_(recovery_thread_count),
+        persist_epoch_id_(INVALID_EID),
+        begin_commit_id_(INVALID_CID),
+        replayed_bytes_(0),
+        replayed_txn_count_(0),
+        recovered_tuple_count_(0),
+        unknown_table_count_(0) {
+    PELOTON_ASSERT(recovery_thread_count_ > 0);
+  }
+
+  DISALLOW_COPY_AND_MOVE(LogicalLogReplayer);
+
+  /**
+   * @brief      Reads the persist epoch identifier from the pepoch file.
+   *
+   * @return     The largest durable epoch, or INVALID_EID if there is none.
+   */
+  eid_t ReadPersistEpochId();
+
+  /**
+   * @brief      Loads the latest complete checkpoint in the directory. Log
+   *             records of transactions it covers are skipped by Replay.
+   *
+   * @param[in]  checkpoint_dir  The checkpoint directory
+   *
+   * @return     The epoch identifier of the checkpoint, or INVALID_EID if
+   *             there is none.
+   */
+  eid_t LoadCheckpoint(const std::string &checkpoint_dir);
+
+  /**
+   * @brief      Replays every durable record into the tables.
+   *
+   * @param[in]  persist_epoch_id  The largest durable epoch
+   */
+  void Replay(const eid_t persist_epoch_id);
+
+  /**
+   * @brief      Removes everything after the persist epoch from the log
+   *             files. Must be called after Replay.
+   */
+  void TruncateLogFiles();
+
+  // the number of bytes that have been read from the log files.
+  size_t GetReplayedBytes() const { return replayed_bytes_.load(); }
+
+  size_t GetReplayedTxnCount() const { return replayed_txn_count_.load(); }
+
+  size_t GetRecoveredTupleCount() const {
+    return recovered_tuple_count_.load();
+  }
+
+  // the number of tables in the log or the checkpoint that do not exist.
+  size_t GetUnknownTableCount() const { return unknown_table_count_.load(); }
+
+ private:
+  // a tuple record read back from the log.
+  struct ReplayRecord {
+    cid_t commit_id;
+    LogRecordType type;
+    // the key of the replaced version. set for updates and deletes.
+    std::string old_key;
+    // the key of the new version. set for inserts and updates.
+    std::string new_key;
+    // the serialized values of every column. set for inserts and updates.
+    // holds the unparsed rest of the record while the table is deferred.
+    std::string tuple_data;
+  };
+
+  // every table that shows up in the log.
+  struct ReplayTable {
+    oid_t database_id;
+    oid_t table_id;
+    // nullptr until the table exists.
+    storage::DataTable *table;
+    bool is_catalog;
+    // the table did not exist when its records were read. they are parsed
+    // once it has been created from the recovered catalog.
+    bool deferred;
+    bool installed;
+    std::vector<oid_t> key_columns;
+    std::vector<ReplayRecord> records;
+    // the unparsed checkpoint tuples of a deferred table.
+    std::vector<std::string> checkpoint_tuples;
+    // the committed images of every key. tables without a primary key can
+    // hold the same image more than once.
+    std::unordered_map<std::string, std::vector<std::string>> tuples;
+    // protects tuples while the checkpoint is loaded.
+    std::mutex tuples_lock;
+  };
+
+  struct LogFile {
+    std::string path;
+    eid_t file_eid;
+    // the file is cut off here once the replay has finished. the maximum
+    // value if the file could not be read.
+    size_t durable_size;
+    size_t size;
+  };
+
+  typedef std::unordered_map<uint64_t, std::vector<ReplayRecord>>
+      TableRecordMap;
+
+  void ListLogFiles();
+
+  void RunLoadCheckpointThread(const std::vector<std::string> *files);
+
+  // add every tuple in the file to the images of its table.
+  void LoadCheckpointFile(const std::string &file_path);
+
+  void RunReplayFileThread();
+
+  void RunReplayTableThread(const std::vector<ReplayTable *> *replay_tables);
+
+  void RunInstallThread(
+      std::vector<std::pair<ReplayTable *, std::string *>> *tuples);
+
+  // replay the records of every table and insert the images.
+  void InstallTables(const std::vector<ReplayTable *> &replay_tables);
+
+  // look up the deferred tables that have been created from the catalog.
+  void ResolveDeferredTables();
+
+  // parse the file and add every committed record to records.
+  void ReplayLogFile(LogFile &log_file, TableRecordMap &records);
+
+  // returns nullptr if the table is not recovered.
+  ReplayTable *GetReplayTable(const oid_t database_id, const oid_t table_id);
+
+  void ReplayTableRecords(ReplayTable &replay_table);
+
+  // parse the records and checkpoint tuples that have been kept unparsed.
+  void ParseDeferredTable(ReplayTable &replay_table);
+
+  // remember the tables and databases whose catalog rows the log deletes.
+  void CollectDroppedObjects(ReplayTable &replay_table);
+
+  // read the old key and the new tuple of the record, as its type requires.
+  void ParseRecord(ReplayTable &replay_table, SerializeInput &input,
+                   ReplayRecord &record);
+
+  // read the values of every column and collect the key columns on the way.
+  void ParseTuple(ReplayTable &replay_table, SerializeInput &input,
+                  std::string &key, std::string &tuple_data);
+
+  static uint64_t GetTableKey(const oid_t database_id, const oid_t table_id) {
+    return ((uint64_t)database_id << 32) | table_id;
+  }
+
+ private:
+  std::vector<std::string> log_dirs_;
+  std::string pepoch_file_;
+  size_t recovery_thread_count_;
+
+  eid_t persist_epoch_id_;
+
+  // records that committed before this commit id are skipped.
+  cid_t begin_commit_id_;
+
+  std::vector<LogFile> log_files_;
+  std::atomic<size_t> next_log_file_;
+
+  std::mutex replay_tables_lock_;
+  std::unordered_map<uint64_t, std::unique_ptr<ReplayTable>> replay_tables_;
+
+  // the tables and databases that the recovered catalog no longer holds.
+  // protected by replay_tables_lock_.
+  std::unordered_set<uint64_t> dropped_tables_;
+  std::unordered_set<oid_t> dropped_databases_;
+
+  std::atomic<size_t> next_task_;
+
+  // the number of tuples inserted by a single recovery transaction.
+  const size_t install_chunk_size_ = 4096;
+
+  std::atomic<size_t> replayed_bytes_;
+  std::atomic<size_t> replayed_txn_count_;
+  std::atomic<size_t> recovered_tuple_count_;
+  std::atomic<size_t> unknown_table_count_;
+};
+
+}  // namespace logging
+}  // namespace peloton
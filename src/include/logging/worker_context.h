@@ -0,0 +1,108 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// worker_context.h
+//
+// Identification: src/include/logging/worker_context.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "common/internal_types.h"
+#include "common/macros.h"
+#include "common/synchronization/spin_latch.h"
+#include "logging/log_buffer.h"
+#include "logging/log_buffer_pool.h"
+#include "type/serializeio.h"
+
+namespace peloton {
+namespace logging {
+
+class LogicalLogger;
+
+//===--------------------------------------------------------------------===//
+// Worker Context
+//===--------------------------------------------------------------------===//
+
+/**
+ * Every thread that commits transactions owns a worker context. The worker
+ * appends log records to the buffers of the epoch that its current
+ * transaction commits in, and the logger it is bound to picks up the buffers
+ * of every epoch the worker has moved past.
+ */
+struct WorkerContext {
+  WorkerContext(const oid_t id, const eid_t persist_eid)
+      : current_buffers(nullptr),
+        pooled_buffer_count(0),
+        buffer_pool(id),
+        output_buffer(),
+        current_commit_eid(MAX_EID),
+        current_buffer_eid(INVALID_EID),
+        persist_eid(persist_eid),
+        current_cid(INVALID_CID),
+        txn_logged(false),
+        terminated(false),
+        worker_id(id),
+        logger(nullptr) {}
+
+  // every epoch the worker has written in has a list of buffers, keyed by
+  // the epoch id. only the last buffer of an epoch is writable. the worker
+  // adds epochs and the logger removes the closed ones, both under
+  // epoch_buffers_lock. the buffers of the open epoch are only touched by
+  // the worker.
+  std::map<eid_t, std::vector<std::unique_ptr<LogBuffer>>> epoch_buffers;
+  common::synchronization::SpinLatch epoch_buffers_lock;
+
+  // the buffers of current_buffer_eid.
+  std::vector<std::unique_ptr<LogBuffer>> *current_buffers;
+
+  // number of buffers of current_buffer_eid that came from buffer_pool.
+  size_t pooled_buffer_count;
+
+  // buffers that have been persisted are handed back to this pool.
+  LogBufferPool buffer_pool;
+
+  // scratch space for serializing a single record.
+  CopySerializeOutput output_buffer;
+
+  // the epoch of the transaction that is currently committing.
+  // MAX_EID if the worker is not committing any transaction.
+  // this is the only field that is read concurrently by the logger.
+  std::atomic<eid_t> current_commit_eid;
+
+  // the epoch of the buffer that was written last.
+  eid_t current_buffer_eid;
+
+  // every epoch up to (and including) this one has been handed to the logger.
+  // only touched by the logger thread.
+  eid_t persist_eid;
+
+  // the commit id of the transaction that is currently committing.
+  cid_t current_cid;
+
+  // whether the current transaction has written any record yet.
+  bool txn_logged;
+
+  // set when the thread owning this context exits.
+  std::atomic<bool> terminated;
+
+  oid_t worker_id;
+
+  // the logger this worker is bound to.
+  LogicalLogger *logger;
+};
+
+// the worker context of the current thread.
+extern thread_local WorkerContext *tl_worker_ctx;
+
+}  // namespace logging
+}  // namespace peloton
@@ -55,6 +55,10 @@ class HashJoinPlan : public AbstractJoinPlan {
 
   void SetBloomFilterFlag(bool flag) { build_bloomfilter_ = flag; }
 
+  bool IsRadixPartitioned() const { return radix_partitioned_; }
+
+  void SetRadixPartitionedFlag(bool flag) { radix_partitioned_ = flag; }
+
   const std::string GetInfo() const override { return "HashJoinPlan"; }
 
   void GetLeftHashKeys(
@@ -87,6 +91,10 @@ class HashJoinPlan : public AbstractJoinPlan {
 
   // Flag indicating whether we build a bloom filter
   bool build_bloomfilter_;
+
+  // Flag indicating whether both inputs are radix-partitioned into
+  // cache-sized partitions that are then joined partition-wise
+  bool radix_partitioned_;
 };
 
 }  // namespace planner
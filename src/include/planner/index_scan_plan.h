@@ -115,8 +115,6 @@ class IndexScanPlan : public AbstractScan {
 
   oid_t GetIndexId() const { return index_id_; }
 
-  const std::vector<oid_t> &GetColumnIds() const { return column_ids_; }
-
   const std::vector<oid_t> &GetKeyColumnIds() const { return key_column_ids_; }
 
   const std::vector<ExpressionType> &GetExprTypes() const {
@@ -145,6 +143,8 @@ class IndexScanPlan : public AbstractScan {
 
   inline bool GetDescend() const { return descend_; }
 
+  inline bool IsIndexOnly() const { return index_only_; }
+
   const std::string GetInfo() const { return "IndexScanPlan"; }
 
   void SetLimit(bool limit) { limit_ = limit; }
@@ -155,8 +155,22 @@ class IndexScanPlan : public AbstractScan {
 
   void SetDescend(bool descend) { descend_ = descend; }
 
+  void SetIndexOnly(bool index_only) { index_only_ = index_only; }
+
   void SetParameterValues(std::vector<type::Value> *values);
 
+  hash_t Hash() const override;
+
+  bool operator==(const AbstractPlan &rhs) const override;
+  bool operator!=(const AbstractPlan &rhs) const override {
+    return !(*this == rhs);
+  }
+
+  void VisitParameters(
+      codegen::QueryParametersMap &map,
+      std::vector<peloton::type::Value> &values,
+      const std::vector<peloton::type::Value> &values_from_user) override;
+
   std::unique_ptr<AbstractPlan> Copy() const {
     std::vector<expression::AbstractExpression *> new_runtime_keys;
     for (auto *key : runtime_keys_) {
@@ -167,6 +181,7 @@ class IndexScanPlan : public AbstractScan {
                        new_runtime_keys);
     IndexScanPlan *new_plan = new IndexScanPlan(
         GetTable(), GetPredicate()->Copy(), GetColumnIds(), desc, false);
+    new_plan->SetIndexOnly(index_only_);
     return std::unique_ptr<AbstractPlan>(new_plan);
   }
 
@@ -174,10 +189,6 @@ class IndexScanPlan : public AbstractScan {
   /** @brief index associated with index scan. */
   oid_t index_id_;
 
-  // A list of column IDs involved in the index scan no matter whether
-  // it is indexed or not (i.e. select statement)
-  const std::vector<oid_t> column_ids_;
-
   // A list of column IDs involved in the index scan that are indexed by
   // the index choen inside the optimizer
   const std::vector<oid_t> key_column_ids_;
@@ -218,6 +229,10 @@ class IndexScanPlan : public AbstractScan {
   // whether order by is descending
   bool descend_ = false;
 
+  // whether the index stores every column that the scan reads, so that the
+  // tuples of all-visible tile groups can be produced from the index keys
+  bool index_only_ = false;
+
  private:
   DISALLOW_COPY_AND_MOVE(IndexScanPlan);
 };
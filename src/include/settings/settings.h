@@ -116,6 +116,26 @@ SETTING_int(gc_num_threads,
             1, 128,
             true, true)
 
+// The epoch length adapts to the number of transactions that begin in an
+// epoch. It stays between the two bounds below, in milliseconds.
+SETTING_int(min_epoch_length,
+            "Minimum length of an epoch in milliseconds (default: 5)",
+            5,
+            1, 1000,
+            true, true)
+
+SETTING_int(max_epoch_length,
+            "Maximum length of an epoch in milliseconds (default: 40)",
+            40,
+            1, 1000,
+            true, true)
+
+SETTING_int(epoch_target_txn_count,
+            "Number of transactions an epoch should hold, 0 keeps epochs at their maximum length (default: 4096)",
+            4096,
+            0, std::numeric_limits<int32_t>::max(),
+            true, true)
+
 SETTING_bool(parallel_execution,
              "Enable parallel execution of queries (default: true)",
              true,
@@ -131,10 +151,65 @@ SETTING_int(min_parallel_table_scan_size,
 // WRITE AHEAD LOG
 //===----------------------------------------------------------------------===//
 
+SETTING_bool(logging_enabled,
+             "Enable write ahead logging (default: false)",
+             false,
+             false, false)
+
+// One logger thread is started for every directory
+SETTING_string(log_directory,
+               "Comma-separated list of log directories (default: ./logs)",
+               "./logs",
+               false, false)
+
+SETTING_int(log_recovery_thread_count,
+            "Number of threads that replay the log on startup (default: std::hardware_concurrency())",
+            std::thread::hardware_concurrency(),
+            1, 64,
+            false, false)
+
+SETTING_bool(log_synchronous_commit,
+             "Wait for the epoch of a transaction to be durable before acknowledging its commit (default: true)",
+             true,
+             true, true)
+
+SETTING_bool(checkpoint_enabled,
+             "Enable fuzzy checkpoints (default: false)",
+             false,
+             false, false)
+
+SETTING_string(checkpoint_directory,
+               "The directory for checkpoints (default: ./checkpoints)",
+               "./checkpoints",
+               false, false)
+
+SETTING_int(checkpoint_interval,
+            "The number of seconds between two checkpoints (default: 30)",
+            30,
+            1, 86400,
+            false, false)
+
+SETTING_int(checkpoint_thread_count,
+            "Number of threads that write a checkpoint (default: 1)",
+            1,
+            1, 64,
+            false, false)
+
 //===----------------------------------------------------------------------===//
 // ERROR REPORTING AND LOGGING
 //===----------------------------------------------------------------------===//
 
+//===----------------------------------------------------------------------===//
+// INDEX
+//===----------------------------------------------------------------------===//
+
+// Store full keys in ART leaves instead of loading them from the table
+SETTING_bool(art_index_store_keys,
+            "Store full keys in ART index leaves instead of loading them "
+                "from the table (default: false)",
+            false,
+            true, true)
+
 //===----------------------------------------------------------------------===//
 // STATISTICS
 //===----------------------------------------------------------------------===//
@@ -214,6 +289,18 @@ SETTING_bool(dump_ir,
              false,
              true, true)
 
+SETTING_bool(codegen_hash_join_prefetch,
+             "Group-prefetch the hash table probes of hash joins in codegen "
+                 "(default: false)",
+             false,
+             true, true)
+
+SETTING_bool(codegen_hash_group_by_prefetch,
+             "Group-prefetch the hash table lookups of hash aggregations in "
+                 "codegen (default: false)",
+             false,
+             true, true)
+
 //===----------------------------------------------------------------------===//
 // Optimizer
 //===----------------------------------------------------------------------===//
@@ -227,6 +314,13 @@ SETTING_bool(hash_join_bloom_filter,
              false,
              true, true)
 
+SETTING_int(hash_join_radix_partition_threshold,
+            "Minimum estimated build-side cardinality for a radix-partitioned "
+                "hash join in codegen, 0 disables (default: 1000000)",
+            1000000,
+            0, 2147483647,
+            true, true)
+
 SETTING_int(task_execution_timeout,
             "Maximum allowed length of time (in ms) for task "
                 "execution step of optimizer, "
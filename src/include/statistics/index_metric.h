@@ -50,16 +50,35 @@ class IndexMetric : public AbstractMetric {
 
   inline oid_t GetIndexId() { return index_id_; }
 
+  // Bytes held by the index as of the last sample
+  inline size_t GetMemoryBytes() { return memory_bytes_; }
+
+  // Bytes of unlinked entries waiting for garbage collection as of the last
+  // sample. These are included in GetMemoryBytes()
+  inline size_t GetGarbageBytes() { return garbage_bytes_; }
+
+  // Records a sample of the memory footprint of the index
+  inline void SetMemoryFootprint(size_t memory_bytes, size_t garbage_bytes) {
+    memory_bytes_ = memory_bytes;
+    garbage_bytes_ = garbage_bytes;
+  }
+
   //===--------------------------------------------------------------------===//
   // HELPER METHODS
   //===--------------------------------------------------------------------===//
 
-  inline void Reset() { index_access_.Reset(); }
+  inline void Reset() {
+    index_access_.Reset();
+    memory_bytes_ = 0;
+    garbage_bytes_ = 0;
+  }
 
   inline bool operator==(const IndexMetric &other) {
     return database_id_ == other.database_id_ && table_id_ == other.table_id_ &&
            index_id_ == other.index_id_ && index_name_ == other.index_name_ &&
-           index_access_ == other.index_access_;
+           index_access_ == other.index_access_ &&
+           memory_bytes_ == other.memory_bytes_ &&
+           garbage_bytes_ == other.garbage_bytes_;
   }
 
   inline bool operator!=(const IndexMetric &other) { return !(*this == other); }
@@ -71,6 +90,8 @@ class IndexMetric : public AbstractMetric {
     ss << "INDEXES: " << std::endl;
     ss << index_name_ << "(OID=" << index_id_ << "): ";
     ss << index_access_.GetInfo();
+    ss << " Memory: " << memory_bytes_ << " bytes (" << garbage_bytes_
+       << " bytes pending GC)";
     return ss.str();
   }
 
@@ -93,6 +114,11 @@ class IndexMetric : public AbstractMetric {
 
   // Counts the number of index entries accessed
   AccessMetric index_access_{MetricType::ACCESS};
+
+  // Memory footprint of the index, sampled from the index itself rather
+  // than counted, so it is not summed by Aggregate()
+  size_t memory_bytes_ = 0;
+  size_t garbage_bytes_ = 0;
 };
 
 }  // namespace stats
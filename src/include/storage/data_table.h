@@ -137,6 +137,15 @@ class DataTable : public AbstractTable {
                    concurrency::TransactionContext *transaction,
                    ItemPointer **index_entry_ptr, bool check_fk = true);
 
+  // Insert a batch of tuples that have been copied into claimed slots
+  // already. index entries are built and inserted one index at a time, and
+  // the pointer to the index entry of every tuple is returned in
+  // index_entry_ptrs.
+  bool InsertTuples(const std::vector<ItemPointer> &locations,
+                    concurrency::TransactionContext *transaction,
+                    std::vector<ItemPointer *> &index_entry_ptrs,
+                    bool check_fk = true);
+
   //===--------------------------------------------------------------------===//
   // TILE GROUP
   //===--------------------------------------------------------------------===//
@@ -275,6 +284,10 @@ class DataTable : public AbstractTable {
   // deprecated, use catalog::TableCatalog::GetInstance()->GetDatabaseOid()
   inline oid_t GetDatabaseOid() const { return (database_oid); }
 
+  // allocate an indirection slot pointing to the given tuple location.
+  // index entries point to this slot instead of the tuple.
+  ItemPointer *AllocateIndirection(ItemPointer location);
+
   // try to insert into all indexes.
   // the last argument is the index entry in primary index holding the new
   // tuple.
@@ -282,6 +295,12 @@ class DataTable : public AbstractTable {
                        concurrency::TransactionContext *transaction,
                        ItemPointer **index_entry_ptr);
 
+  // try to insert a batch of tuples into all indexes. index_entry_ptrs holds
+  // the index entry of every tuple.
+  bool InsertInIndexes(const std::vector<const AbstractTuple *> &tuples,
+                       concurrency::TransactionContext *transaction,
+                       const std::vector<ItemPointer *> &index_entry_ptrs);
+
   inline static size_t GetActiveTileGroupCount() {
     return default_active_tilegroup_count_;
   }
@@ -33,9 +33,8 @@ class TileGroup;
 //===--------------------------------------------------------------------===//
 
 struct TupleHeader {
-  common::synchronization::SpinLatch latch;
   std::atomic<txn_id_t> txn_id;
-  cid_t read_ts;
+  std::atomic<cid_t> read_ts;
   cid_t begin_ts;
   cid_t end_ts;
   ItemPointer next;
@@ -46,9 +45,9 @@ struct TupleHeader {
 /**
  *  FIELD DESCRIPTIONS:
  *  ===================
- *  latch: Tuple header latch used to acquire ownership or update read_ts
  *  txn_id: serve as a write lock on the tuple version
- *  read_ts: the last txn to read this tuple
+ *  read_ts: the last txn to read this tuple. Only ever moves forward, and is
+ *           updated with compare-and-swap rather than under a latch.
  *  begin_ts: the lower bound of the version visibility range.
  *  end_ts: the upper bound of the version visibility range.
  *  next: the pointer pointing to the next (older) version in the version chain.
@@ -164,11 +163,6 @@ class TileGroupHeader : public Printable {
     return tile_group;
   }
 
-  inline common::synchronization::SpinLatch &GetSpinLatch(
-      const oid_t &tuple_slot_id) const {
-    return tuple_headers_[tuple_slot_id].latch;
-  }
-
   inline txn_id_t GetTransactionId(const oid_t &tuple_slot_id) const {
     return tuple_headers_[tuple_slot_id].txn_id;
   }
@@ -206,6 +200,10 @@ class TileGroupHeader : public Printable {
   inline void SetTransactionId(const oid_t &tuple_slot_id,
                                const txn_id_t &transaction_id) const {
     tuple_headers_[tuple_slot_id].txn_id = transaction_id;
+    // A transaction takes over the tuple, see IsAllVisible()
+    if (transaction_id != INITIAL_TXN_ID && transaction_id != INVALID_TXN_ID) {
+      write_stamp.fetch_add(1);
+    }
   }
 
   inline void SetLastReaderCommitId(const oid_t &tuple_slot_id,
@@ -213,6 +211,17 @@ class TileGroupHeader : public Printable {
     tuple_headers_[tuple_slot_id].read_ts = read_cid;
   }
 
+  /*
+  * @brief Atomically replaces the last reader cid if it still equals
+  * expected_cid. On failure, expected_cid is set to the current value.
+  */
+  inline bool UpdateLastReaderCommitId(const oid_t &tuple_slot_id,
+                                       cid_t &expected_cid,
+                                       const cid_t &read_cid) const {
+    return tuple_headers_[tuple_slot_id].read_ts.compare_exchange_weak(
+        expected_cid, read_cid);
+  }
+
   inline void SetBeginCommitId(const oid_t &tuple_slot_id,
                                const cid_t &begin_cid) {
     tuple_headers_[tuple_slot_id].begin_ts = begin_cid;
@@ -241,8 +250,47 @@ class TileGroupHeader : public Printable {
   inline bool SetAtomicTransactionId(const oid_t &tuple_slot_id,
                                      const txn_id_t &transaction_id) const {
     auto old_val = INITIAL_TXN_ID;
-    return tuple_headers_[tuple_slot_id].txn_id.compare_exchange_strong(
-        old_val, transaction_id);
+    if (tuple_headers_[tuple_slot_id].txn_id.compare_exchange_strong(
+            old_val, transaction_id) == false) {
+      return false;
+    }
+    write_stamp.fetch_add(1);
+    return true;
+  }
+
+  /*
+  * @brief A tile group is all-visible when every tuple in it is the only
+  * version of its row, and was committed before every active transaction
+  * started. Such tuples need no visibility check. The GC marks tile groups
+  * all-visible, and any transaction that takes over one of their tuples
+  * clears the mark. A tuple still has to be checked to be committed
+  * (INITIAL_TXN_ID), as new tuples are linked before they are taken over.
+  */
+  inline bool IsAllVisible() const {
+    return all_visible_stamp.load() == write_stamp.load();
+  }
+
+  /*
+  * @brief Checks whether the tuple an index entry points to can be read
+  * without a visibility check. The indirection guards against slots that
+  * were recycled after the entry was read.
+  */
+  inline bool IsVisibleToAll(const oid_t &tuple_slot_id,
+                             const ItemPointer *indirection) const {
+    return IsAllVisible() &&
+           GetTransactionId(tuple_slot_id) == INITIAL_TXN_ID &&
+           GetIndirection(tuple_slot_id) == indirection;
+  }
+
+  inline uint64_t GetWriteStamp() const { return write_stamp.load(); }
+
+  /*
+  * @brief Marks the tile group all-visible as of the given write stamp, which
+  * must be read before the tuples are checked. Writes after that keep the
+  * tile group unmarked.
+  */
+  inline void SetAllVisible(const uint64_t stamp) {
+    all_visible_stamp.store(stamp);
   }
 
   /*
@@ -301,6 +349,12 @@ class TileGroupHeader : public Printable {
   // Immmutable Flag. Should be set by the indextuner to be true.
   // By default it will be set to false.
   bool immutable;
+
+  // Bumped whenever a transaction takes over a tuple of the tile group
+  mutable std::atomic<uint64_t> write_stamp;
+
+  // The write stamp at which the tile group was found all-visible
+  std::atomic<uint64_t> all_visible_stamp;
 };
 
 }  // namespace storage
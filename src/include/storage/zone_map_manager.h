@@ -12,10 +12,14 @@
 
 #pragma once
 
+#include <memory>
+#include <mutex>
 #include <sstream>
 
+#include "common/container/cuckoo_map.h"
 #include "common/macros.h"
 #include "common/internal_types.h"
+#include "common/item_pointer.h"
 #include "type/value.h"
 
 namespace peloton {
@@ -28,6 +32,7 @@ namespace storage {
 
 class DataTable;
 class TileGroup;
+class ZoneMap;
 
 struct PredicateInfo {
   int col_id;
@@ -35,6 +40,19 @@ struct PredicateInfo {
   type::Value predicate_value;
 };
 
+// The min and max of a numeric column in a fixed-length form, so that they
+// can be compared without materializing a type::Value. Integral, date and
+// timestamp columns fill in both pairs, decimal columns only the decimal
+// pair. A column that only holds NULLs has min > max.
+struct RawColumnStatistics {
+  int64_t min_integer;
+  int64_t max_integer;
+  double min_decimal;
+  double max_decimal;
+  // The number of NULLs among all versions in the tile group
+  int64_t null_count;
+};
+
 class ZoneMapManager {
  public:
   typedef struct ColumnStatistics {
@@ -66,10 +84,25 @@ class ZoneMapManager {
   std::unique_ptr<ZoneMapManager::ColumnStatistics> GetZoneMapFromCatalog(
       oid_t database_id, oid_t table_id, oid_t tile_group_id, oid_t col_itr);
 
+  void CreateZoneMapForFullTileGroup(storage::TileGroup *tile_group);
+
+  void WidenZoneMap(const ItemPointer &location);
+
+  void DropZoneMap(oid_t tile_group_id);
+
+  std::shared_ptr<const ZoneMap> GetZoneMap(oid_t tile_group_id) const;
+
   bool ShouldScanTileGroup(storage::PredicateInfo *parsed_predicates,
                            int32_t num_predicates, storage::DataTable *table,
                            int64_t tile_group_id);
 
+  bool GetRawZoneMap(oid_t tile_group_id, RawColumnStatistics *raw_stats);
+
+  // Whether a predicate on a column can be evaluated against the raw zone
+  // map of the column.
+  static bool IsRawComparable(type::TypeId column_type,
+                              type::TypeId predicate_type);
+
   bool ZoneMapTableExists();
 
  private:
@@ -86,8 +119,15 @@ class ZoneMapManager {
   std::unique_ptr<ZoneMapManager::ColumnStatistics> GetResultVectorAsZoneMap(
       std::unique_ptr<std::vector<type::Value>> &result_vector);
 
+  static std::shared_ptr<ZoneMap> BuildZoneMap(storage::TileGroup *tile_group);
+
+  // Widens the zone map of the column so that it covers the value. Returns
+  // true if the zone map has changed.
+  static bool AddValue(ZoneMap &zone_map, oid_t column_id,
+                       const type::Value &value);
+
   static bool CheckEqual(const type::Value &predicate_val,
-                         ColumnStatistics *stats) {
+                         const ColumnStatistics *stats) {
     const type::Value &min = stats->min;
     const type::Value &max = stats->max;
     return (min.CompareLessThanEquals(predicate_val)) == CmpBool::CmpTrue &&
@@ -95,23 +135,23 @@ class ZoneMapManager {
   }
 
   static bool CheckLessThan(const type::Value &predicate_val,
-                            ColumnStatistics *stats) {
+                            const ColumnStatistics *stats) {
     return predicate_val.CompareGreaterThan(stats->min) == CmpBool::CmpTrue;
   }
 
   static bool CheckLessThanEquals(const type::Value &predicate_val,
-                                  ColumnStatistics *stats) {
+                                  const ColumnStatistics *stats) {
     return predicate_val.CompareGreaterThanEquals(stats->min) ==
            CmpBool::CmpTrue;
   }
 
   static bool CheckGreaterThan(const type::Value &predicate_val,
-                               ColumnStatistics *stats) {
+                               const ColumnStatistics *stats) {
     return predicate_val.CompareLessThan(stats->max) == CmpBool::CmpTrue;
   }
 
   static bool CheckGreaterThanEquals(const type::Value &predicate_val,
-                                     ColumnStatistics *stats) {
+                                     const ColumnStatistics *stats) {
     return predicate_val.CompareLessThanEquals(stats->max) == CmpBool::CmpTrue;
   }
 
@@ -120,8 +160,23 @@ class ZoneMapManager {
   //===--------------------------------------------------------------------===//
   std::unique_ptr<type::AbstractPool> pool_;
 
+  // The zone maps of every tile group, keyed by tile group id. Scans look
+  // them up here instead of in the catalog.
+  CuckooMap<oid_t, std::shared_ptr<const ZoneMap>> zone_maps_;
+
+  // Serializes the writers of zone_maps_, so that no widening is lost
+  std::mutex zone_map_lock_;
+
   bool zone_map_table_exists;
 };
 
+// The zone maps of every column of a tile group. It is never modified once it
+// has been published, a refresh publishes a new one.
+class ZoneMap {
+ public:
+  std::vector<ZoneMapManager::ColumnStatistics> stats;
+  std::vector<RawColumnStatistics> raw_stats;
+};
+
 }  // namespace storage
 }  // namespace peloton
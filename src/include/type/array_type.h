@@ -34,6 +34,9 @@ class ArrayType : public Type {
 
   TypeId GetElementType(const Value& val UNUSED_ATTRIBUTE) const override;
 
+  // Get the number of elements in this array
+  uint64_t GetElementCount(const Value& val) const override;
+
   // Does this value exist in this array?
   Value InList(const Value& list, const Value &object) const override;
 
@@ -61,7 +64,9 @@ class ArrayType : public Type {
     throw Exception("Can't serialize array types to storage");
   }
 
-  Value Copy(const Value& val UNUSED_ATTRIBUTE) const override { return ValueFactory::GetNullValueByType(type_id_); }
+  // An array value only refers to its elements, so the copy refers to the
+  // same elements
+  Value Copy(const Value& val) const override { return Value(val); }
 
 };
 
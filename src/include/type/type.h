@@ -144,6 +144,9 @@ class Type {
 
   virtual TypeId GetElementType(const Value& val) const;
 
+  // Get the number of elements in this array
+  virtual uint64_t GetElementCount(const Value& val) const;
+
   // Does this value exist in this array?
   virtual Value InList(const Value& list, const Value& object) const;
 
@@ -274,6 +274,11 @@ class Value : public Printable {
     return Type::GetInstance(type_id_)->GetElementType(*this);
   }
 
+  // Get the number of elements in this array
+  inline uint64_t GetElementCount() const {
+    return Type::GetInstance(type_id_)->GetElementCount(*this);
+  }
+
   // Does this value exist in this array?
   inline Value InList(const Value &object) const {
     return Type::GetInstance(type_id_)->InList(*this, object);
@@ -114,6 +114,13 @@ class ValueFactory {
                  manage_data);
   }
 
+  // The array value refers to the given vector, which must outlive it
+  template <class T>
+  static inline Value GetArrayValue(const std::vector<T> &values,
+                                    TypeId element_type) {
+    return Value(TypeId::ARRAY, values, element_type);
+  }
+
   static inline Value GetNullValueByType(TypeId type_id) {
     Value ret_value;
     switch (type_id) {
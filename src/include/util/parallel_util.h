@@ -0,0 +1,123 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// parallel_util.h
+//
+// Identification: src/include/util/parallel_util.h
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <algorithm>
+#include <iterator>
+#include <thread>
+#include <vector>
+
+namespace peloton {
+
+class ParallelUtil {
+ public:
+  // Ranges shorter than this are not worth spawning a thread for
+  static constexpr size_t kMinPartitionSize = 4096;
+
+  // Returns the number of partitions a range of the given size is split into
+  static size_t GetPartitionCount(size_t size);
+
+  /**
+   * Splits [0, size) into contiguous partitions and calls func(begin, end)
+   * for each of them on its own thread. The calling thread runs the first
+   * partition and returns once all of them are done. Small ranges are run
+   * entirely on the calling thread.
+   */
+  template <typename Func>
+  static void ParallelFor(size_t size, Func func);
+
+  /**
+   * Sorts [first, last) by sorting partitions in parallel and then merging
+   * neighboring runs pairwise, again in parallel. Like std::sort the result
+   * is not stable.
+   */
+  template <typename RandomIt, typename Compare>
+  static void Sort(RandomIt first, RandomIt last, Compare comp);
+};
+
+inline size_t ParallelUtil::GetPartitionCount(size_t size) {
+  size_t thread_count = std::max(std::thread::hardware_concurrency(), 1u);
+  size_t max_partitions = std::max(size / kMinPartitionSize, (size_t)1);
+  return std::min(thread_count, max_partitions);
+}
+
+template <typename Func>
+inline void ParallelUtil::ParallelFor(size_t size, Func func) {
+  size_t partition_count = GetPartitionCount(size);
+  if (partition_count <= 1) {
+    func((size_t)0, size);
+    return;
+  }
+
+  size_t partition_size = (size + partition_count - 1) / partition_count;
+  std::vector<std::thread> threads;
+  for (size_t begin = partition_size; begin < size; begin += partition_size) {
+    size_t end = std::min(begin + partition_size, size);
+    threads.emplace_back([&func, begin, end] { func(begin, end); });
+  }
+  func((size_t)0, std::min(partition_size, size));
+
+  for (auto &thread : threads) {
+    thread.join();
+  }
+}
+
+template <typename RandomIt, typename Compare>
+inline void ParallelUtil::Sort(RandomIt first, RandomIt last, Compare comp) {
+  size_t size = std::distance(first, last);
+  size_t partition_count = GetPartitionCount(size);
+  if (partition_count <= 1) {
+    std::sort(first, last, comp);
+    return;
+  }
+
+  // Sort each partition on its own, remembering where the runs start
+  size_t partition_size = (size + partition_count - 1) / partition_count;
+  std::vector<size_t> bounds;
+  for (size_t begin = 0; begin < size; begin += partition_size) {
+    bounds.push_back(begin);
+  }
+  bounds.push_back(size);
+
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i + 1 < bounds.size(); i++) {
+    threads.emplace_back([first, comp, &bounds, i] {
+      std::sort(first + bounds[i], first + bounds[i + 1], comp);
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  // Merge neighboring runs until only one is left
+  while (bounds.size() > 2) {
+    threads.clear();
+    std::vector<size_t> merged_bounds;
+    for (size_t i = 0; i + 1 < bounds.size(); i += 2) {
+      merged_bounds.push_back(bounds[i]);
+      if (i + 2 < bounds.size()) {
+        threads.emplace_back([first, comp, &bounds, i] {
+          std::inplace_merge(first + bounds[i], first + bounds[i + 1],
+                             first + bounds[i + 2], comp);
+        });
+      }
+    }
+    merged_bounds.push_back(size);
+    for (auto &thread : threads) {
+      thread.join();
+    }
+    bounds.swap(merged_bounds);
+  }
+}
+
+}  // namespace peloton
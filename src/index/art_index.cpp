@@ -18,6 +18,7 @@
 #include "statistics/backend_stats_context.h"
 #include "storage/data_table.h"
 #include "storage/storage_manager.h"
+#include "util/parallel_util.h"
 #include "util/portable_endian.h"
 
 namespace peloton {
@@ -52,8 +53,13 @@ void LoadKey(void *ctx, TID tid, art::Key &key) {
 }  // namespace
 
 ArtIndex::ArtIndex(IndexMetadata *metadata)
+    : ArtIndex(metadata, settings::SettingsManager::GetBool(
+                             settings::SettingId::art_index_store_keys)) {}
+
+// A tree without a load-key function stores the keys in its leaves
+ArtIndex::ArtIndex(IndexMetadata *metadata, bool store_keys)
     : Index(metadata),
-      container_(LoadKey, this),
+      container_(store_keys ? nullptr : LoadKey, this),
       key_constructor_(*GetKeySchema()) {}
 
 bool ArtIndex::InsertEntry(const storage::Tuple *key, ItemPointer *value) {
@@ -124,6 +130,53 @@ bool ArtIndex::CondInsertEntry(const storage::Tuple *key, ItemPointer *value,
   return inserted;
 }
 
+bool ArtIndex::BulkInsert(const std::vector<const storage::Tuple *> &keys,
+                          const std::vector<ItemPointer *> &values) {
+  PELOTON_ASSERT(keys.size() == values.size());
+
+  // Construct the keys for the tree
+  std::vector<art::Key> tree_keys(keys.size());
+  ParallelUtil::ParallelFor(keys.size(), [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++) {
+      ConstructArtKey(*keys[i], tree_keys[i]);
+    }
+  });
+
+  // Keys are binary-comparable, so byte order is key order. Keys can only be
+  // moved, hence we sort their positions instead
+  std::vector<size_t> order(keys.size());
+  for (size_t i = 0; i < order.size(); i++) {
+    order[i] = i;
+  }
+  auto key_less = [&tree_keys](size_t a, size_t b) {
+    const art::Key &key_a = tree_keys[a], &key_b = tree_keys[b];
+    auto len = std::min(key_a.getKeyLen(), key_b.getKeyLen());
+    int cmp = std::memcmp(&key_a[0], &key_b[0], len);
+    return cmp < 0 || (cmp == 0 && key_a.getKeyLen() < key_b.getKeyLen());
+  };
+  ParallelUtil::Sort(order.begin(), order.end(), key_less);
+
+  // Perform inserts (always succeed)
+  ParallelUtil::ParallelFor(order.size(), [&](size_t begin, size_t end) {
+    auto thread_info = container_.getThreadInfo();
+    for (size_t i = begin; i < end; i++) {
+      container_.insert(tree_keys[order[i]],
+                        reinterpret_cast<TID>(values[order[i]]), thread_info);
+    }
+  });
+
+  if (static_cast<StatsType>(settings::SettingsManager::GetInt(
+          settings::SettingId::stats_mode)) != StatsType::INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementIndexInserts(
+        keys.size(), GetMetadata());
+  }
+
+  // Update stats
+  IncreaseNumberOfTuplesBy(keys.size());
+
+  return true;
+}
+
 void ArtIndex::ScanRange(const storage::Tuple *start, const storage::Tuple *end,
                          std::vector<ItemPointer *> &result) {
   // Build boundary keys
@@ -167,15 +220,19 @@ void ArtIndex::ScanLimit(const std::vector<type::Value> &values,
                          std::vector<ItemPointer *> &result,
                          const ConjunctionScanPredicate *scan_predicate,
                          uint64_t limit, uint64_t offset) {
-  (void)values;
-  (void)key_column_ids;
-  (void)expr_types;
-  (void)scan_direction;
-  (void)result;
-  (void)scan_predicate;
-  (void)limit;
-  (void)offset;
-  // This fucking function takes seven fucking arguments ... The fuck?
+  // The tree only scans forward, and the index can not check visibility, so
+  // it just returns the first key within the bounds
+  if (scan_predicate->IsFullIndexScan() == false &&
+      scan_predicate->IsPointQuery() == false && limit == 1 && offset == 0 &&
+      scan_direction == ScanDirectionType::FORWARD) {
+    art::Key start_key, end_key;
+    ConstructArtKey(*scan_predicate->GetLowKey(), start_key);
+    ConstructArtKey(*scan_predicate->GetHighKey(), end_key);
+    ScanRange(start_key, end_key, result, 1);
+  } else {
+    Scan(values, key_column_ids, expr_types, scan_direction, result,
+         scan_predicate);
+  }
 }
 
 void ArtIndex::ScanAllKeys(std::vector<ItemPointer *> &result) {
@@ -200,16 +257,48 @@ void ArtIndex::ScanKey(const storage::Tuple *key,
   }
 }
 
+void ArtIndex::ScanKeyBatch(const std::vector<const storage::Tuple *> &keys,
+                            std::vector<std::vector<ItemPointer *>> &results) {
+  // Construct the keys for the tree
+  std::vector<art::Key> tree_keys(keys.size());
+  for (size_t i = 0; i < keys.size(); i++) {
+    ConstructArtKey(*keys[i], tree_keys[i]);
+  }
+
+  // Perform lookups, sharing the descent between neighboring keys
+  std::vector<std::vector<TID>> tmp_results;
+  auto thread_info = container_.getThreadInfo();
+  container_.lookupBatch(tree_keys, tmp_results, thread_info);
+
+  results.resize(keys.size());
+  size_t num_reads = 0;
+  for (size_t i = 0; i < keys.size(); i++) {
+    for (const auto &tid : tmp_results[i]) {
+      results[i].push_back(reinterpret_cast<ItemPointer *>(tid));
+    }
+    num_reads += tmp_results[i].size();
+  }
+
+  // Update stats
+  if (static_cast<StatsType>(settings::SettingsManager::GetInt(
+          settings::SettingId::stats_mode)) != StatsType::INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementIndexReads(
+        num_reads, GetMetadata());
+  }
+}
+
 void ArtIndex::ScanRange(const art::Key &start, const art::Key &end,
-                         std::vector<ItemPointer *> &result) {
-  const uint32_t batch_size = 1000;
+                         std::vector<ItemPointer *> &result,
+                         uint32_t max_results) {
+  const uint32_t batch_size = std::min<uint32_t>(1000, max_results);
   std::vector<TID> tmp_result;
 
   art::Key start_key;
   start_key.setFrom(start);
 
+  size_t num_results = 0;
   bool has_more = true;
-  while (has_more) {
+  while (has_more && num_results < max_results) {
     art::Key next_start_key;
     auto thread_info = container_.getThreadInfo();
     has_more = container_.lookupRange(start_key, end, next_start_key,
@@ -219,6 +308,7 @@ void ArtIndex::ScanRange(const art::Key &start, const art::Key &end,
     for (const auto &tid : tmp_result) {
       result.push_back(reinterpret_cast<ItemPointer *>(tid));
     }
+    num_results += tmp_result.size();
 
     // Set the next key
     start_key.setFrom(next_start_key);
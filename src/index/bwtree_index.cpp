@@ -16,6 +16,7 @@
 #include "index/scan_optimizer.h"
 #include "statistics/stats_aggregator.h"
 #include "settings/settings_manager.h"
+#include "util/parallel_util.h"
  
 namespace peloton {
 namespace index {
@@ -133,6 +134,138 @@ bool BWTREE_INDEX_TYPE::CondInsertEntry(
   return ret;
 }
 
+/*
+ * BulkInsert() - Sorts all pairs and builds the tree bottom-up
+ *
+ * Keys are converted and sorted in parallel. The uniqueness checks that
+ * Insert() would do on every pair are done on neighbors of the sorted
+ * pairs. If the tree is not empty the sorted pairs are inserted one by one,
+ * which still benefits from the locality of sorted keys
+ */
+BWTREE_TEMPLATE_ARGUMENTS
+bool BWTREE_INDEX_TYPE::BulkInsert(
+    const std::vector<const storage::Tuple *> &keys,
+    const std::vector<ValueType> &values) {
+  PELOTON_ASSERT(keys.size() == values.size());
+
+  std::vector<std::pair<KeyType, ValueType>> items(keys.size());
+  ParallelUtil::ParallelFor(keys.size(), [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++) {
+      items[i].first.SetFromKey(keys[i]);
+      items[i].second = values[i];
+    }
+  });
+
+  // Values of the same key are ordered by address so that duplicated
+  // key-value pairs end up next to each other
+  std::less<ValueType> value_less{};
+  auto item_less = [this, &value_less](
+      const std::pair<KeyType, ValueType> &a,
+      const std::pair<KeyType, ValueType> &b) {
+    if (comparator(a.first, b.first) == true) {
+      return true;
+    } else if (comparator(b.first, a.first) == true) {
+      return false;
+    }
+    return value_less(a.second, b.second);
+  };
+  ParallelUtil::Sort(items.begin(), items.end(), item_less);
+
+  for (size_t i = 1; i < items.size(); i++) {
+    if (equals(items[i - 1].first, items[i].first) == true &&
+        (HasUniqueKeys() == true || items[i - 1].second == items[i].second)) {
+      LOG_TRACE("BulkInsert found a duplicated entry");
+      return false;
+    }
+  }
+
+  bool ret = container.BulkLoad(items);
+  if (ret == false) {
+    LOG_TRACE("BulkInsert falls back to Insert() on a non-empty tree");
+
+    ret = true;
+    for (const auto &item : items) {
+      if (container.Insert(item.first, item.second, HasUniqueKeys()) ==
+          false) {
+        ret = false;
+        break;
+      }
+    }
+  }
+
+  if (static_cast<StatsType>(settings::SettingsManager::GetInt(settings::SettingId::stats_mode)) != StatsType::INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementIndexInserts(
+        items.size(), metadata);
+  }
+
+  LOG_TRACE("BulkInsert(%lu entries) [%s]", items.size(),
+            (ret ? "SUCCESS" : "FAIL"));
+
+  return ret;
+}
+
+/*
+ * InsertEntryBatch() - Sorts the pairs by key and inserts them one by one
+ *
+ * Keys are converted and sorted the way BulkInsert() does, but the tree is
+ * never built bottom-up since it is in use
+ */
+BWTREE_TEMPLATE_ARGUMENTS
+bool BWTREE_INDEX_TYPE::InsertEntryBatch(
+    const std::vector<const storage::Tuple *> &keys,
+    const std::vector<ValueType> &values,
+    std::function<bool(const void *)> predicate) {
+  PELOTON_ASSERT(keys.size() == values.size());
+
+  std::vector<std::pair<KeyType, ValueType>> items(keys.size());
+  for (size_t i = 0; i < keys.size(); i++) {
+    items[i].first.SetFromKey(keys[i]);
+    items[i].second = values[i];
+  }
+
+  std::sort(items.begin(), items.end(),
+            [this](const std::pair<KeyType, ValueType> &a,
+                   const std::pair<KeyType, ValueType> &b) {
+              return comparator(a.first, b.first);
+            });
+
+  // Entries of the batch are not visible to the predicate yet, so their
+  // uniqueness is checked on neighbors of the sorted keys
+  if (predicate) {
+    for (size_t i = 1; i < items.size(); i++) {
+      if (equals(items[i - 1].first, items[i].first) == true) {
+        LOG_TRACE("InsertEntryBatch found a duplicated key");
+        return false;
+      }
+    }
+  }
+
+  bool ret = true;
+  for (const auto &item : items) {
+    if (!predicate) {
+      container.Insert(item.first, item.second, HasUniqueKeys());
+      continue;
+    }
+
+    bool predicate_satisfied = false;
+    if (container.ConditionalInsert(item.first, item.second, predicate,
+                                    &predicate_satisfied) == false) {
+      ret = false;
+      break;
+    }
+  }
+
+  if (static_cast<StatsType>(settings::SettingsManager::GetInt(settings::SettingId::stats_mode)) != StatsType::INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementIndexInserts(
+        items.size(), metadata);
+  }
+
+  LOG_TRACE("InsertEntryBatch(%lu entries) [%s]", items.size(),
+            (ret ? "SUCCESS" : "FAIL"));
+
+  return ret;
+}
+
 /*
  * Scan() - Scans a range inside the index using index scan optimizer
  *
@@ -181,23 +314,8 @@ void BWTREE_INDEX_TYPE::Scan(
     LOG_TRACE("Partial scan low key: %s\n high key: %s",
               low_key_p->GetInfo().c_str(), high_key_p->GetInfo().c_str());
 
-    // Construct low key and high key in KeyType form, rather than
-    // the standard in-memory tuple
-    KeyType index_low_key;
-    KeyType index_high_key;
-    index_low_key.SetFromKey(low_key_p);
-    index_high_key.SetFromKey(high_key_p);
-
-    // We use bwtree Begin() to first reach the lower bound
-    // of the search key
-    // Also we keep scanning until we have reached the end of the index
-    // or we have seen a key higher than the high key
-    for (auto scan_itr = container.Begin(index_low_key);
-         (scan_itr.IsEnd() == false) &&
-             (container.KeyCmpLessEqual(scan_itr->first, index_high_key));
-         scan_itr++) {
-      result.push_back(scan_itr->second);
-    }
+    ScanRange(low_key_p, high_key_p, result,
+              static_cast<const KeyType *>(nullptr));
   }  // if is full scan
 
   if (static_cast<StatsType>(settings::SettingsManager::GetInt(settings::SettingId::stats_mode)) != StatsType::INVALID) {
@@ -208,6 +326,84 @@ void BWTREE_INDEX_TYPE::Scan(
   return;
 }
 
+/*
+ * ScanRange() - Scans the keys between the low key and the high key
+ */
+BWTREE_TEMPLATE_ARGUMENTS
+template <typename RangeKeyType>
+void BWTREE_INDEX_TYPE::ScanRange(const storage::Tuple *low_key_p,
+                                  const storage::Tuple *high_key_p,
+                                  std::vector<ValueType> &result,
+                                  const RangeKeyType *) {
+  // Construct low key and high key in KeyType form, rather than
+  // the standard in-memory tuple
+  KeyType index_low_key;
+  KeyType index_high_key;
+  index_low_key.SetFromKey(low_key_p);
+  index_high_key.SetFromKey(high_key_p);
+
+  // We use bwtree Begin() to first reach the lower bound
+  // of the search key
+  // Also we keep scanning until we have reached the end of the index
+  // or we have seen a key higher than the high key
+  for (auto scan_itr = container.Begin(index_low_key);
+       (scan_itr.IsEnd() == false) &&
+           (container.KeyCmpLessEqual(scan_itr->first, index_high_key));
+       ++scan_itr) {
+    result.push_back(scan_itr->second);
+  }
+
+  return;
+}
+
+/*
+ * ScanRange() - Scans the keys between the low key and the high key of an
+ *               index on integer columns
+ *
+ * Instead of comparing one key at a time, this works on the leaf page
+ * cached by the iterator: a binary search finds where the page passes the
+ * high key, and the keys before that are filtered in bulk against the
+ * bounds of every key column. Values are written into the result in place
+ */
+BWTREE_TEMPLATE_ARGUMENTS
+template <size_t KeySize>
+void BWTREE_INDEX_TYPE::ScanRange(const storage::Tuple *low_key_p,
+                                  const storage::Tuple *high_key_p,
+                                  std::vector<ValueType> &result,
+                                  const CompactIntsKey<KeySize> *) {
+  CompactIntsScanFilter<KeySize> filter{low_key_p, high_key_p};
+  if (filter.IsEmpty() == true) {
+    return;
+  }
+
+  const KeyType &index_high_key = filter.GetHighKey();
+  auto scan_itr = container.Begin(filter.GetLowKey());
+  while (scan_itr.IsEnd() == false) {
+    auto leaf_range = scan_itr.GetLeafRange();
+
+    // The first pair whose key is greater than the high key
+    auto end_p = std::upper_bound(
+        leaf_range.first, leaf_range.second, index_high_key,
+        [](const KeyType &key, const std::pair<KeyType, ValueType> &kv) {
+          return KeyType::LessThan(key, kv.first);
+        });
+
+    size_t result_size = result.size();
+    result.resize(result_size + (end_p - leaf_range.first));
+    result_size +=
+        filter.Filter(leaf_range.first, end_p, result.data() + result_size);
+    result.resize(result_size);
+
+    if (end_p != leaf_range.second) {
+      break;
+    }
+
+    scan_itr.MoveToNextLeaf();
+  }
+
+  return;
+}
+
 /*
  * ScanLimit() - Scan the index with predicate and limit/offset
  *
@@ -257,6 +453,73 @@ void BWTREE_INDEX_TYPE::ScanLimit(
   return;
 }
 
+/*
+ * ScanWithKeys() - Scans like Scan() and copies out the key of every entry
+ *
+ * TupleKey only points at the data it was built from, so indexes using it
+ * can not hand back their keys
+ */
+BWTREE_TEMPLATE_ARGUMENTS
+bool BWTREE_INDEX_TYPE::ScanWithKeys(
+    UNUSED_ATTRIBUTE const std::vector<type::Value> &value_list,
+    UNUSED_ATTRIBUTE const std::vector<oid_t> &tuple_column_id_list,
+    UNUSED_ATTRIBUTE const std::vector<ExpressionType> &expr_list,
+    std::vector<ValueType> &result,
+    std::vector<std::unique_ptr<storage::Tuple>> &keys,
+    const ConjunctionScanPredicate *csp_p) {
+  if (std::is_same<KeyType, TupleKey>::value) {
+    return false;
+  }
+
+  const catalog::Schema *key_schema = metadata->GetKeySchema();
+  auto copy_key = [&keys, key_schema](const storage::Tuple &key_tuple) {
+    keys.emplace_back(new storage::Tuple(key_schema, true));
+    PELOTON_MEMCPY(keys.back()->GetData(), key_tuple.GetData(),
+                   key_schema->GetLength());
+  };
+
+  if (csp_p->IsPointQuery() == true) {
+    const storage::Tuple *point_query_key_p = csp_p->GetPointQueryKey();
+
+    KeyType point_query_key;
+    point_query_key.SetFromKey(point_query_key_p);
+
+    // Every entry found carries the key that was looked up
+    container.GetValue(point_query_key, result);
+    for (size_t i = 0; i < result.size(); i++) {
+      copy_key(*point_query_key_p);
+    }
+  } else {
+    auto scan_itr = container.Begin();
+    KeyType index_high_key;
+    bool has_high_key = false;
+    if (csp_p->IsFullIndexScan() == false) {
+      KeyType index_low_key;
+      index_low_key.SetFromKey(csp_p->GetLowKey());
+      index_high_key.SetFromKey(csp_p->GetHighKey());
+      scan_itr = container.Begin(index_low_key);
+      has_high_key = true;
+    }
+
+    for (; (scan_itr.IsEnd() == false) &&
+               (has_high_key == false ||
+                container.KeyCmpLessEqual(scan_itr->first, index_high_key));
+         scan_itr++) {
+      KeyType key = scan_itr->first;
+      const storage::Tuple key_tuple = key.GetTupleForComparison(key_schema);
+      result.push_back(scan_itr->second);
+      copy_key(key_tuple);
+    }
+  }
+
+  if (static_cast<StatsType>(settings::SettingsManager::GetInt(settings::SettingId::stats_mode)) != StatsType::INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementIndexReads(
+        result.size(), metadata);
+  }
+
+  return true;
+}
+
 BWTREE_TEMPLATE_ARGUMENTS
 void BWTREE_INDEX_TYPE::ScanAllKeys(std::vector<ValueType> &result) {
   auto it = container.Begin();
@@ -291,6 +554,34 @@ void BWTREE_INDEX_TYPE::ScanKey(const storage::Tuple *key,
   return;
 }
 
+/*
+ * ScanKeyBatch() - Looks up all keys in one pass over the tree
+ *
+ * Sorted keys that land on the same leaf share one traversal
+ */
+BWTREE_TEMPLATE_ARGUMENTS
+void BWTREE_INDEX_TYPE::ScanKeyBatch(
+    const std::vector<const storage::Tuple *> &keys,
+    std::vector<std::vector<ValueType>> &results) {
+  std::vector<KeyType> index_keys(keys.size());
+  for (size_t i = 0; i < keys.size(); i++) {
+    index_keys[i].SetFromKey(keys[i]);
+  }
+
+  container.GetValueBatch(index_keys, results);
+
+  if (static_cast<StatsType>(settings::SettingsManager::GetInt(settings::SettingId::stats_mode)) != StatsType::INVALID) {
+    size_t num_reads = 0;
+    for (const auto &result : results) {
+      num_reads += result.size();
+    }
+    stats::BackendStatsContext::GetInstance()->IncrementIndexReads(num_reads,
+                                                                   metadata);
+  }
+
+  return;
+}
+
 BWTREE_TEMPLATE_ARGUMENTS
 std::string BWTREE_INDEX_TYPE::GetTypeName() const { return "BWTree"; }
 
@@ -0,0 +1,347 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// hash_index.cpp
+//
+// Identification: src/index/hash_index.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "index/hash_index.h"
+
+#include <algorithm>
+
+#include "common/exception.h"
+#include "index/index_key.h"
+#include "index/scan_optimizer.h"
+#include "settings/settings_manager.h"
+#include "statistics/stats_aggregator.h"
+#include "storage/tuple.h"
+
+namespace peloton {
+namespace index {
+
+// Number of keys whose buckets are prefetched before they are probed
+static const size_t kPrefetchGroupSize = 16;
+
+HASH_INDEX_TEMPLATE_ARGUMENTS
+HASH_INDEX_TYPE::HashIndex(IndexMetadata *metadata)
+    :  // Base class
+      Index{metadata},
+      // Value equality checker
+      value_equals{},
+      container{},
+      value_count{0} {
+  return;
+}
+
+HASH_INDEX_TEMPLATE_ARGUMENTS
+HASH_INDEX_TYPE::~HashIndex() {}
+
+/*
+ * InsertEntry() - insert a key-value pair into the map
+ *
+ * If the key value pair already exists in the map, or the index has unique
+ * keys and the key already exists, just return false
+ */
+HASH_INDEX_TEMPLATE_ARGUMENTS
+bool HASH_INDEX_TYPE::InsertEntry(const storage::Tuple *key,
+                                  ItemPointer *value) {
+  KeyType index_key;
+  index_key.SetFromKey(key);
+
+  const bool unique_keys = HasUniqueKeys();
+
+  // The update runs if the key is present, otherwise a new list holding
+  // just this value is inserted
+  bool ret = true;
+  container.UpsertFn(index_key,
+                     [this, value, unique_keys, &ret](ValueList &values) {
+                       if (unique_keys == true && values.empty() == false) {
+                         ret = false;
+                         return;
+                       }
+                       for (const auto &existing : values) {
+                         if (value_equals(existing, value) == true) {
+                           ret = false;
+                           return;
+                         }
+                       }
+                       values.push_back(value);
+                     },
+                     ValueList{value});
+
+  if (ret == true) {
+    value_count.fetch_add(1);
+  }
+
+  if (static_cast<StatsType>(settings::SettingsManager::GetInt(
+          settings::SettingId::stats_mode)) != StatsType::INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementIndexInserts(metadata);
+  }
+
+  LOG_TRACE("InsertEntry(key=%s, val=%s) [%s]", key->GetInfo().c_str(),
+            IndexUtil::GetInfo(value).c_str(), (ret ? "SUCCESS" : "FAIL"));
+
+  return ret;
+}
+
+/*
+ * DeleteEntry() - Removes a key-value pair
+ *
+ * If the key-value pair does not exists yet in the map return false. The key
+ * is erased together with its last value
+ */
+HASH_INDEX_TEMPLATE_ARGUMENTS
+bool HASH_INDEX_TYPE::DeleteEntry(const storage::Tuple *key,
+                                  ItemPointer *value) {
+  KeyType index_key;
+  index_key.SetFromKey(key);
+
+  bool ret = false;
+  container.EraseFn(index_key, [this, value, &ret](ValueList &values) {
+    for (auto itr = values.begin(); itr != values.end(); itr++) {
+      if (value_equals(*itr, value) == true) {
+        // Order does not matter, move the last value into the hole
+        *itr = values.back();
+        values.pop_back();
+        ret = true;
+        break;
+      }
+    }
+    return values.empty();
+  });
+
+  if (ret == true) {
+    value_count.fetch_sub(1);
+  }
+
+  if (static_cast<StatsType>(settings::SettingsManager::GetInt(
+          settings::SettingId::stats_mode)) != StatsType::INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementIndexDeletes(
+        ret ? 1 : 0, metadata);
+  }
+
+  LOG_TRACE("DeleteEntry(key=%s, val=%s) [%s]", key->GetInfo().c_str(),
+            IndexUtil::GetInfo(value).c_str(), (ret ? "SUCCESS" : "FAIL"));
+
+  return ret;
+}
+
+/*
+ * CondInsertEntry() - Insert a key-value pair only if the predicate fails for
+ *                     all values of the key
+ *
+ * The predicate is evaluated under the bucket locks of the key, so no value
+ * can be inserted for the key in the meantime
+ */
+HASH_INDEX_TEMPLATE_ARGUMENTS
+bool HASH_INDEX_TYPE::CondInsertEntry(
+    const storage::Tuple *key, ItemPointer *value,
+    std::function<bool(const void *)> predicate) {
+  KeyType index_key;
+  index_key.SetFromKey(key);
+
+  bool ret = true;
+  container.UpsertFn(index_key,
+                     [this, value, &predicate, &ret](ValueList &values) {
+                       for (const auto &existing : values) {
+                         if (predicate(existing) == true ||
+                             value_equals(existing, value) == true) {
+                           ret = false;
+                           return;
+                         }
+                       }
+                       values.push_back(value);
+                     },
+                     ValueList{value});
+
+  if (ret == true) {
+    value_count.fetch_add(1);
+  }
+
+  if (static_cast<StatsType>(settings::SettingsManager::GetInt(
+          settings::SettingId::stats_mode)) != StatsType::INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementIndexInserts(metadata);
+  }
+
+  return ret;
+}
+
+/*
+ * Scan() - Scans the index using index scan optimizer
+ *
+ * Only point queries can be answered, since there is no key order to scan a
+ * range in. The optimizer only picks a hash index when every key column has
+ * an equality predicate, so anything else is a bad plan rather than a reason
+ * to fall back to a scan of all entries
+ */
+HASH_INDEX_TEMPLATE_ARGUMENTS
+void HASH_INDEX_TYPE::Scan(
+    UNUSED_ATTRIBUTE const std::vector<type::Value> &value_list,
+    UNUSED_ATTRIBUTE const std::vector<oid_t> &tuple_column_id_list,
+    UNUSED_ATTRIBUTE const std::vector<ExpressionType> &expr_list,
+    ScanDirectionType scan_direction, std::vector<ValueType> &result,
+    const ConjunctionScanPredicate *csp_p) {
+  if (scan_direction == ScanDirectionType::INVALID) {
+    throw Exception("Invalid scan direction \n");
+  }
+
+  LOG_TRACE("Scan() Point Query = %d; Full Scan = %d ", csp_p->IsPointQuery(),
+            csp_p->IsFullIndexScan());
+
+  if (csp_p->IsPointQuery() == false) {
+    throw IndexException("Hash index only supports point queries");
+  }
+
+  KeyType point_query_key;
+  point_query_key.SetFromKey(csp_p->GetPointQueryKey());
+
+  container.UpdateFn(point_query_key, [&result](ValueList &values) {
+    result.insert(result.end(), values.begin(), values.end());
+  });
+
+  if (static_cast<StatsType>(settings::SettingsManager::GetInt(
+          settings::SettingId::stats_mode)) != StatsType::INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementIndexReads(
+        result.size(), metadata);
+  }
+
+  return;
+}
+
+/*
+ * ScanLimit() - Scan the index with predicate and limit/offset
+ *
+ * BwTree and SkipList only push down limit == 1 and offset == 0 for range
+ * scans, and answer point queries with a full Scan(). Every hash index scan
+ * is a point query, so the same rule leaves nothing to push down: the index
+ * can not check visibility, and cutting the values of a key short could drop
+ * the only visible version. The executor applies limit and offset
+ */
+HASH_INDEX_TEMPLATE_ARGUMENTS
+void HASH_INDEX_TYPE::ScanLimit(
+    const std::vector<type::Value> &value_list,
+    const std::vector<oid_t> &tuple_column_id_list,
+    const std::vector<ExpressionType> &expr_list,
+    ScanDirectionType scan_direction, std::vector<ValueType> &result,
+    const ConjunctionScanPredicate *csp_p, UNUSED_ATTRIBUTE uint64_t limit,
+    UNUSED_ATTRIBUTE uint64_t offset) {
+  Scan(value_list, tuple_column_id_list, expr_list, scan_direction, result,
+       csp_p);
+
+  return;
+}
+
+HASH_INDEX_TEMPLATE_ARGUMENTS
+void HASH_INDEX_TYPE::ScanAllKeys(std::vector<ValueType> &result) {
+  {
+    // The table stays locked while the iterator is alive
+    auto locked_table = container.GetIterator();
+    for (const auto &entry : locked_table) {
+      result.insert(result.end(), entry.second.begin(), entry.second.end());
+    }
+  }
+
+  if (static_cast<StatsType>(settings::SettingsManager::GetInt(
+          settings::SettingId::stats_mode)) != StatsType::INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementIndexReads(
+        result.size(), metadata);
+  }
+
+  return;
+}
+
+HASH_INDEX_TEMPLATE_ARGUMENTS
+void HASH_INDEX_TYPE::ScanKey(const storage::Tuple *key,
+                              std::vector<ValueType> &result) {
+  KeyType index_key;
+  index_key.SetFromKey(key);
+
+  container.UpdateFn(index_key, [&result](ValueList &values) {
+    result.insert(result.end(), values.begin(), values.end());
+  });
+
+  if (static_cast<StatsType>(settings::SettingsManager::GetInt(
+          settings::SettingId::stats_mode)) != StatsType::INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementIndexReads(
+        result.size(), metadata);
+  }
+
+  return;
+}
+
+/*
+ * ScanKeyBatch() - Looks up all keys with group prefetching
+ *
+ * Keys are probed in groups. The buckets of every key in a group are
+ * prefetched before the first of them is probed, so that the cache misses of
+ * the group overlap instead of being paid one probe at a time
+ */
+HASH_INDEX_TEMPLATE_ARGUMENTS
+void HASH_INDEX_TYPE::ScanKeyBatch(
+    const std::vector<const storage::Tuple *> &keys,
+    std::vector<std::vector<ValueType>> &results) {
+  results.resize(keys.size());
+
+  std::vector<KeyType> index_keys(std::min(keys.size(), kPrefetchGroupSize));
+  size_t num_reads = 0;
+  for (size_t group_start = 0; group_start < keys.size();
+       group_start += kPrefetchGroupSize) {
+    size_t group_size =
+        std::min(keys.size() - group_start, kPrefetchGroupSize);
+
+    for (size_t i = 0; i < group_size; i++) {
+      index_keys[i].SetFromKey(keys[group_start + i]);
+      container.Prefetch(index_keys[i]);
+    }
+
+    for (size_t i = 0; i < group_size; i++) {
+      auto &result = results[group_start + i];
+      container.UpdateFn(index_keys[i], [&result](ValueList &values) {
+        result.insert(result.end(), values.begin(), values.end());
+      });
+      num_reads += result.size();
+    }
+  }
+
+  if (static_cast<StatsType>(settings::SettingsManager::GetInt(
+          settings::SettingId::stats_mode)) != StatsType::INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementIndexReads(num_reads,
+                                                                   metadata);
+  }
+
+  return;
+}
+
+HASH_INDEX_TEMPLATE_ARGUMENTS
+std::string HASH_INDEX_TYPE::GetTypeName() const { return "Hash"; }
+
+// IMPORTANT: Make sure you don't exceed CompactIntegerKey_MAX_SLOTS
+
+template class HashIndex<CompactIntsKey<1>, ItemPointer *, CompactIntsHasher<1>,
+                         CompactIntsEqualityChecker<1>, ItemPointerComparator>;
+template class HashIndex<CompactIntsKey<2>, ItemPointer *, CompactIntsHasher<2>,
+                         CompactIntsEqualityChecker<2>, ItemPointerComparator>;
+template class HashIndex<CompactIntsKey<3>, ItemPointer *, CompactIntsHasher<3>,
+                         CompactIntsEqualityChecker<3>, ItemPointerComparator>;
+template class HashIndex<CompactIntsKey<4>, ItemPointer *, CompactIntsHasher<4>,
+                         CompactIntsEqualityChecker<4>, ItemPointerComparator>;
+
+// Generic key
+template class HashIndex<GenericKey<4>, ItemPointer *, GenericHasher<4>,
+                         GenericEqualityChecker<4>, ItemPointerComparator>;
+template class HashIndex<GenericKey<8>, ItemPointer *, GenericHasher<8>,
+                         GenericEqualityChecker<8>, ItemPointerComparator>;
+template class HashIndex<GenericKey<16>, ItemPointer *, GenericHasher<16>,
+                         GenericEqualityChecker<16>, ItemPointerComparator>;
+template class HashIndex<GenericKey<64>, ItemPointer *, GenericHasher<64>,
+                         GenericEqualityChecker<64>, ItemPointerComparator>;
+template class HashIndex<GenericKey<256>, ItemPointer *, GenericHasher<256>,
+                         GenericEqualityChecker<256>, ItemPointerComparator>;
+
+}  // namespace index
+}  // namespace peloton
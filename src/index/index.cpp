@@ -11,12 +11,15 @@
 
 #include "index/index.h"
 
+#include <algorithm>
+#include <numeric>
 #include <sstream>
 
 #include "catalog/manager.h"
 #include "catalog/schema.h"
 #include "index/scan_optimizer.h"
 #include "settings/settings_manager.h"
+#include "storage/tuple.h"
 #include "type/ephemeral_pool.h"
 
 namespace peloton {
@@ -45,7 +48,7 @@ IndexMetadata::IndexMetadata(std::string index_name, oid_t index_oid,
                              const catalog::Schema *tuple_schema,
                              const catalog::Schema *key_schema,
                              const std::vector<oid_t> &key_attrs,
-                             bool unique_keys)
+                             bool unique_keys, oid_t include_column_count)
     : name_(index_name),
       index_oid(index_oid),
       table_oid(table_oid),
@@ -57,12 +60,15 @@ IndexMetadata::IndexMetadata(std::string index_name, oid_t index_oid,
       key_attrs(key_attrs),
       tuple_attrs(),
       unique_keys(unique_keys),
+      include_column_count(include_column_count),
       visible_(IndexMetadata::index_default_visibility) {
   // Push the reverse mapping relation into tuple_attrs which maps
   // tuple key's column into index key's column
   // resize() automatially does allocation, extending and insertion
   tuple_attrs.resize(tuple_schema->GetColumnCount(), INVALID_OID);
 
+  PELOTON_ASSERT(include_column_count <= key_attrs.size());
+
   // For those column IDs not mapped, they are set to INVALID_OID
   for (oid_t i = 0; i < key_attrs.size(); i++) {
     // That is the tuple column ID that index key column i is mapped to
@@ -95,6 +101,16 @@ IndexMetadata::~IndexMetadata() {
   return;
 }
 
+bool IndexMetadata::CoversColumns(const std::vector<oid_t> &column_ids) const {
+  for (auto column_id : column_ids) {
+    if (column_id >= tuple_attrs.size() ||
+        tuple_attrs[column_id] == INVALID_OID) {
+      return false;
+    }
+  }
+  return true;
+}
+
 const std::string IndexMetadata::GetInfo() const {
   std::stringstream os;
 
@@ -105,6 +121,7 @@ const std::string IndexMetadata::GetInfo() const {
      << "ConstraintType=" << IndexConstraintTypeToString(index_constraint_type_)
      << ", "
      << "UtilityRatio=" << utility_ratio << ", "
+     << "IncludeColumns=" << include_column_count << ", "
      << "Visible=" << visible_ << "]";
 
   os << " -> " << key_schema->GetInfo();
@@ -120,7 +137,7 @@ const std::string IndexMetadata::GetInfo() const {
 // caller, the Index object owns that metadata and is responsible for
 // destructing the metadata object on its own destruction
 Index::Index(IndexMetadata *metadata)
-    : metadata(metadata), indexed_tile_group_offset(0) {
+    : metadata(metadata), indexed_tile_group_offset(0), building_(false) {
   // This is redundant
   index_oid = metadata->GetOid();
 
@@ -187,6 +204,179 @@ void Index::ScanTest(const std::vector<type::Value> &value_list,
   return;
 }
 
+/*
+ * BulkInsert() - Inserts all pairs one by one
+ *
+ * Indexes that can build themselves from sorted input override this
+ */
+bool Index::BulkInsert(const std::vector<const storage::Tuple *> &keys,
+                       const std::vector<ItemPointer *> &values) {
+  PELOTON_ASSERT(keys.size() == values.size());
+
+  for (size_t i = 0; i < keys.size(); i++) {
+    if (InsertEntry(keys[i], values[i]) == false) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/*
+ * InsertEntryBatch() - Sorts the pairs by key and inserts them one by one
+ */
+bool Index::InsertEntryBatch(const std::vector<const storage::Tuple *> &keys,
+                             const std::vector<ItemPointer *> &values,
+                             std::function<bool(const void *)> predicate) {
+  PELOTON_ASSERT(keys.size() == values.size());
+
+  std::vector<size_t> order(keys.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&keys](size_t a, size_t b) {
+    return keys[a]->Compare(*keys[b]) < 0;
+  });
+
+  // Entries of the batch are not visible to the predicate yet, so their
+  // uniqueness is checked on neighbors of the sorted keys
+  if (predicate) {
+    for (size_t i = 1; i < order.size(); i++) {
+      if (keys[order[i - 1]]->Compare(*keys[order[i]]) == 0) {
+        LOG_TRACE("InsertEntryBatch found a duplicated key");
+        return false;
+      }
+    }
+  }
+
+  for (size_t i : order) {
+    if (!predicate) {
+      InsertEntry(keys[i], values[i]);
+    } else if (CondInsertEntry(keys[i], values[i], predicate) == false) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/*
+ * StartBuild() - Starts buffering the changes writers make to the index
+ */
+void Index::StartBuild() {
+  build_latch_.Lock();
+  building_ = true;
+  build_latch_.Unlock();
+}
+
+bool Index::BufferInsert(const storage::Tuple *key, ItemPointer *location) {
+  return BufferChange(true, key, location);
+}
+
+bool Index::BufferDelete(const storage::Tuple *key, ItemPointer *location) {
+  return BufferChange(false, key, location);
+}
+
+/*
+ * BufferChange() - Records a change if the index is being built
+ *
+ * The flag is checked again under the latch since FinishBuild() clears it
+ * once the buffer has been drained
+ */
+bool Index::BufferChange(bool is_insert, const storage::Tuple *key,
+                         ItemPointer *location) {
+  if (building_.load() == false) {
+    return false;
+  }
+
+  // Copy the key outside of the latch. Varlen values are copied into the
+  // index pool which lives as long as the index
+  std::unique_ptr<storage::Tuple> key_copy(
+      new storage::Tuple(GetKeySchema(), true));
+  for (oid_t column_itr = 0; column_itr < GetColumnCount(); column_itr++) {
+    key_copy->SetValue(column_itr, key->GetValue(column_itr), pool);
+  }
+
+  build_latch_.Lock();
+  if (building_.load() == false) {
+    build_latch_.Unlock();
+    return false;
+  }
+  build_buffer_.push_back(BufferedChange{is_insert, std::move(key_copy),
+                                         location});
+  build_latch_.Unlock();
+
+  return true;
+}
+
+/*
+ * FinishBuild() - Drains the buffered changes and ends the build
+ *
+ * The buffer is swapped out and applied without holding the latch so that
+ * writers are not blocked while the changes are merged. This repeats until
+ * the buffer is found empty, at which point the build ends under the latch
+ */
+bool Index::FinishBuild(
+    std::function<bool(const storage::Tuple *, ItemPointer *)> insert_func) {
+  bool res = true;
+
+  while (true) {
+    std::vector<BufferedChange> changes;
+
+    build_latch_.Lock();
+    if (build_buffer_.empty()) {
+      building_ = false;
+      build_latch_.Unlock();
+      break;
+    }
+    changes.swap(build_buffer_);
+    build_latch_.Unlock();
+
+    LOG_TRACE("Merging %lu buffered changes into index %s", changes.size(),
+              GetName().c_str());
+
+    for (auto &change : changes) {
+      if (change.is_insert == false) {
+        DeleteEntry(change.key.get(), change.location);
+      } else if (res == true) {
+        // Once an insert is rejected the build fails, but the buffer is still
+        // drained so that writers stop buffering
+        res = insert_func(change.key.get(), change.location);
+      }
+    }
+  }
+
+  return res;
+}
+
+/*
+ * ScanKeyBatch() - Probes all keys one by one
+ *
+ * Indexes that can share work between neighboring keys override this
+ */
+void Index::ScanKeyBatch(const std::vector<const storage::Tuple *> &keys,
+                         std::vector<std::vector<ItemPointer *>> &results) {
+  results.resize(keys.size());
+
+  for (size_t i = 0; i < keys.size(); i++) {
+    ScanKey(keys[i], results[i]);
+  }
+
+  return;
+}
+
+/*
+ * ScanWithKeys() - Indexes that can not rebuild their keys do not support
+ *                  index-only scans
+ */
+bool Index::ScanWithKeys(
+    UNUSED_ATTRIBUTE const std::vector<type::Value> &value_list,
+    UNUSED_ATTRIBUTE const std::vector<oid_t> &tuple_column_id_list,
+    UNUSED_ATTRIBUTE const std::vector<ExpressionType> &expr_list,
+    UNUSED_ATTRIBUTE std::vector<ItemPointer *> &result,
+    UNUSED_ATTRIBUTE std::vector<std::unique_ptr<storage::Tuple>> &keys,
+    UNUSED_ATTRIBUTE const ConjunctionScanPredicate *csp_p) {
+  return false;
+}
+
 // Check whether a given index key satisfies a predicate. The predicate has the
 // same specification as those in Scan()
 bool Index::Compare(const AbstractTuple &index_key,
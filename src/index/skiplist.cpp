@@ -15,7 +15,7 @@
 namespace peloton {
 namespace index {
 
-// Add your function definitions here
+// SkipList is a class template, see index/skiplist.h
 
 }  // namespace index
 }  // namespace peloton
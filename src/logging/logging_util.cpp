@@ -0,0 +1,195 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// logging_util.cpp
+//
+// Identification: src/logging/logging_util.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cstring>
+
+#include "logging/logging_util.h"
+
+#include "catalog/catalog_defaults.h"
+#include "catalog/schema.h"
+#include "common/logger.h"
+#include "common/macros.h"
+#include "index/index.h"
+#include "storage/data_table.h"
+
+namespace peloton {
+namespace logging {
+
+//===--------------------------------------------------------------------===//
+// FILE SYSTEM RELATED OPERATIONS
+//===--------------------------------------------------------------------===//
+
+bool LoggingUtil::CheckDirectoryExistence(const char *dir_name) {
+  struct stat info;
+  int return_val = stat(dir_name, &info);
+  return return_val == 0 && S_ISDIR(info.st_mode);
+}
+
+bool LoggingUtil::CreateDirectory(const char *dir_name, int mode) {
+  int return_val = mkdir(dir_name, mode);
+  if (return_val == 0) {
+    LOG_TRACE("Created directory %s successfully", dir_name);
+  } else if (errno == EEXIST) {
+    LOG_TRACE("Directory %s already exists", dir_name);
+  } else {
+    LOG_ERROR("Creating directory failed: %s", strerror(errno));
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @return false if fail to remove directory
+ */
+bool LoggingUtil::RemoveDirectory(const char *dir_name, bool only_remove_file) {
+  struct dirent *file;
+  DIR *dir;
+
+  dir = opendir(dir_name);
+  if (dir == nullptr) {
+    return true;
+  }
+
+  // XXX readdir is not thread safe???
+  while ((file = readdir(dir)) != nullptr) {
+    if (strcmp(file->d_name, ".") == 0 || strcmp(file->d_name, "..") == 0) {
+      continue;
+    }
+    std::string complete_path = std::string(dir_name) + "/" + file->d_name;
+    auto ret_val = remove(complete_path.c_str());
+    if (ret_val != 0) {
+      LOG_ERROR("Failed to delete file: %s, error: %s", complete_path.c_str(),
+                strerror(errno));
+    }
+  }
+  closedir(dir);
+
+  if (!only_remove_file) {
+    auto ret_val = remove(dir_name);
+    if (ret_val != 0) {
+      LOG_ERROR("Failed to delete dir: %s, error: %s", dir_name,
+                strerror(errno));
+    }
+  }
+  return true;
+}
+
+bool LoggingUtil::OpenFile(const char *name, const char *mode,
+                           FileHandle &file_handle) {
+  auto file = fopen(name, mode);
+  if (file == nullptr) {
+    LOG_ERROR("Failed to open file %s: %s", name, strerror(errno));
+    return false;
+  } else {
+    file_handle.file = file;
+  }
+
+  // also, get the descriptor
+  auto fd = fileno(file);
+  if (fd == INVALID_FILE_DESCRIPTOR) {
+    LOG_ERROR("Failed to get the descriptor of file %s", name);
+    return false;
+  } else {
+    file_handle.fd = fd;
+  }
+
+  file_handle.size = GetFileSize(file_handle);
+  return true;
+}
+
+bool LoggingUtil::CloseFile(FileHandle &file_handle) {
+  PELOTON_ASSERT(file_handle.file != nullptr &&
+                 file_handle.fd != INVALID_FILE_DESCRIPTOR);
+  int ret = fclose(file_handle.file);
+
+  if (ret == 0) {
+    file_handle.file = nullptr;
+    file_handle.fd = INVALID_FILE_DESCRIPTOR;
+  } else {
+    LOG_ERROR("Error when closing log file");
+  }
+
+  return ret == 0;
+}
+
+void LoggingUtil::FFlushFsync(FileHandle &file_handle) {
+  // First, flush
+  PELOTON_ASSERT(file_handle.fd != INVALID_FILE_DESCRIPTOR);
+  if (file_handle.fd == INVALID_FILE_DESCRIPTOR) return;
+  int ret = fflush(file_handle.file);
+  if (ret != 0) {
+    LOG_ERROR("Error occured in fflush(%d)", ret);
+  }
+  // Finally, sync
+  ret = fsync(file_handle.fd);
+  if (ret != 0) {
+    LOG_ERROR("Error occured in fsync(%d)", ret);
+  }
+}
+
+size_t LoggingUtil::GetFileSize(FileHandle &file_handle) {
+  struct stat file_stats;
+  fstat(file_handle.fd, &file_stats);
+  return file_stats.st_size;
+}
+
+bool LoggingUtil::ReadNBytesFromFile(FileHandle &file_handle, void *bytes_read,
+                                     size_t n) {
+  PELOTON_ASSERT(file_handle.fd != INVALID_FILE_DESCRIPTOR &&
+                 file_handle.fd != -1);
+  int res = fread(bytes_read, n, 1, file_handle.file);
+  return res == 1;
+}
+
+//===--------------------------------------------------------------------===//
+// LOG RECORD RELATED OPERATIONS
+//===--------------------------------------------------------------------===//
+
+std::vector<oid_t> LoggingUtil::GetLogKeyColumns(storage::DataTable *table) {
+  size_t index_count = table->GetIndexCount();
+  for (size_t index_itr = 0; index_itr < index_count; ++index_itr) {
+    auto index = table->GetIndex(index_itr);
+    if (index == nullptr) continue;
+    if (index->GetIndexType() == IndexConstraintType::PRIMARY_KEY) {
+      return index->GetMetadata()->GetKeyAttrs();
+    }
+  }
+
+  // no primary key. the whole tuple identifies the version.
+  std::vector<oid_t> key_columns;
+  oid_t column_count = table->GetSchema()->GetColumnCount();
+  for (oid_t column_itr = 0; column_itr < column_count; ++column_itr) {
+    key_columns.push_back(column_itr);
+  }
+  return key_columns;
+}
+
+bool LoggingUtil::IsCoreCatalogTable(const oid_t database_id,
+                                     const oid_t table_id) {
+  // pg_database is shared by every database and lives in the catalog one.
+  if (table_id == DATABASE_CATALOG_OID) {
+    return database_id == CATALOG_DATABASE_OID;
+  }
+  return table_id >= SCHEMA_CATALOG_OID && table_id <= CONSTRAINT_CATALOG_OID;
+}
+
+bool LoggingUtil::IsRecoveredTable(const oid_t database_id,
+                                   const oid_t table_id) {
+  return IsCoreCatalogTable(database_id, table_id) == true ||
+         (table_id & ~TABLE_OID_MASK) >= OID_FOR_USER_OFFSET;
+}
+
+}  // namespace logging
+}  // namespace peloton
@@ -0,0 +1,280 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// logical_checkpoint_manager.cpp
+//
+// Identification: src/logging/logical_checkpoint_manager.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <dirent.h>
+#include <chrono>
+#include <cstring>
+
+#include "logging/logical_checkpoint_manager.h"
+
+#include "catalog/schema.h"
+#include "concurrency/epoch_manager_factory.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "logging/logging_util.h"
+#include "logging/logical_log_manager.h"
+#include "storage/data_table.h"
+#include "storage/database.h"
+#include "storage/storage_manager.h"
+#include "storage/tile_group.h"
+#include "storage/tile_group_header.h"
+
+namespace peloton {
+namespace logging {
+
+void LogicalCheckpointManager::SetDirectory(const std::string &checkpoint_dir) {
+  PELOTON_ASSERT(is_running_ == false);
+
+  checkpoint_dir_ = checkpoint_dir;
+  if (LoggingUtil::CheckDirectoryExistence(checkpoint_dir_.c_str()) == false) {
+    LOG_INFO("Checkpoint directory %s is not accessible or does not exist",
+             checkpoint_dir_.c_str());
+    bool res = LoggingUtil::CreateDirectory(checkpoint_dir_.c_str(), 0700);
+    if (res == false) {
+      LOG_ERROR("Cannot create directory: %s", checkpoint_dir_.c_str());
+    }
+  }
+}
+
+void LogicalCheckpointManager::StartCheckpointing(
+    std::vector<std::unique_ptr<std::thread>> &checkpoint_threads) {
+  is_running_ = true;
+  checkpoint_threads.emplace_back(
+      new std::thread(&LogicalCheckpointManager::Run, this));
+}
+
+void LogicalCheckpointManager::StartCheckpointing() {
+  is_running_ = true;
+  checkpoint_thread_.reset(
+      new std::thread(&LogicalCheckpointManager::Run, this));
+}
+
+void LogicalCheckpointManager::StopCheckpointing() {
+  is_running_ = false;
+  if (checkpoint_thread_ != nullptr) {
+    checkpoint_thread_->join();
+    checkpoint_thread_.reset();
+  }
+}
+
+void LogicalCheckpointManager::Run() {
+  auto last_checkpoint_time = std::chrono::steady_clock::now();
+
+  while (is_running_ == true) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(sleep_period_ms_));
+
+    auto now = std::chrono::steady_clock::now();
+    if (now - last_checkpoint_time <
+        std::chrono::seconds(checkpoint_interval_)) {
+      continue;
+    }
+
+    DoCheckpoint();
+    last_checkpoint_time = std::chrono::steady_clock::now();
+  }
+}
+
+eid_t LogicalCheckpointManager::DoCheckpoint() {
+  auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+
+  // move the snapshot epoch past every transaction that has finished.
+  epoch_manager.GetExpiredEpochId();
+
+  // every transaction that began before the snapshot epoch has finished.
+  auto txn = txn_manager.BeginTransaction(0, IsolationLevelType::SNAPSHOT,
+                                          true);
+  eid_t checkpoint_eid = (txn->GetReadId() >> 32) - 1;
+  cid_t snapshot_cid = GetCheckpointCommitId(checkpoint_eid);
+
+  if (checkpoint_eid == INVALID_EID ||
+      checkpoint_eid <= last_checkpoint_eid_) {
+    // nothing has committed since the last checkpoint.
+    txn_manager.CommitTransaction(txn);
+    return last_checkpoint_eid_;
+  }
+
+  std::string checkpoint_path = GetCheckpointPath(checkpoint_eid);
+  LoggingUtil::RemoveDirectory(checkpoint_path.c_str(), false);
+  if (LoggingUtil::CreateDirectory(checkpoint_path.c_str(), 0700) == false) {
+    txn_manager.CommitTransaction(txn);
+    return last_checkpoint_eid_;
+  }
+
+  // split every table into ranges of tile groups. versions that are
+  // visible to the snapshot all live in the tile groups that exist by now.
+  std::vector<CheckpointTask> tasks;
+  auto storage_manager = storage::StorageManager::GetInstance();
+  oid_t database_count = storage_manager->GetDatabaseCount();
+  for (oid_t db_offset = 0; db_offset < database_count; ++db_offset) {
+    auto database = storage_manager->GetDatabaseWithOffset(db_offset);
+    oid_t table_count = database->GetTableCount();
+    for (oid_t table_offset = 0; table_offset < table_count; ++table_offset) {
+      auto table = database->GetTable(table_offset);
+      // the core catalog tables are written along with the user tables, so
+      // that recovery can create the tables again.
+      if (LoggingUtil::IsRecoveredTable(database->GetOid(), table->GetOid()) ==
+          false) {
+        continue;
+      }
+      oid_t tile_group_count = table->GetTileGroupCount();
+      size_t part_id = 0;
+      for (oid_t begin = 0; begin < tile_group_count;
+           begin += tile_group_chunk_size_) {
+        tasks.push_back({table, begin,
+                         std::min(begin + tile_group_chunk_size_,
+                                  tile_group_count),
+                         part_id++});
+      }
+    }
+  }
+
+  next_task_ = 0;
+  std::vector<std::thread> threads;
+  size_t thread_count =
+      std::min((size_t)checkpointer_thread_count_, tasks.size());
+  for (size_t i = 0; i < thread_count; ++i) {
+    threads.emplace_back(&LogicalCheckpointManager::RunCheckpointThread, this,
+                         &tasks, &checkpoint_path, snapshot_cid);
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  // the checkpoint becomes visible to recovery once this file is durable.
+  FileHandle file_handle;
+  std::string info_path = checkpoint_path + "/checkpoint_info";
+  if (LoggingUtil::OpenFile(info_path.c_str(), "wb", file_handle) == false) {
+    txn_manager.CommitTransaction(txn);
+    return last_checkpoint_eid_;
+  }
+  CopySerializeOutput output;
+  output.WriteLong((int64_t)snapshot_cid);
+  fwrite((const void *)output.Data(), output.Size(), 1, file_handle.file);
+  LoggingUtil::FFlushFsync(file_handle);
+  LoggingUtil::CloseFile(file_handle);
+
+  txn_manager.CommitTransaction(txn);
+
+  last_checkpoint_eid_ = checkpoint_eid;
+  LOG_INFO("Checkpoint of epoch %" PRId64 " is done (%lu parts)",
+           checkpoint_eid, tasks.size());
+
+  // recovery never needs anything the checkpoint covers.
+  RemoveOldCheckpoints(checkpoint_eid);
+  LogicalLogManager::GetInstance().TruncateLog(checkpoint_eid);
+
+  return checkpoint_eid;
+}
+
+void LogicalCheckpointManager::RunCheckpointThread(
+    const std::vector<CheckpointTask> *tasks,
+    const std::string *checkpoint_path, const cid_t snapshot_cid) {
+  CopySerializeOutput output;
+  while (true) {
+    size_t task_id = next_task_.fetch_add(1);
+    if (task_id >= tasks->size()) {
+      break;
+    }
+    CheckpointTileGroups(tasks->at(task_id), *checkpoint_path, snapshot_cid,
+                         output);
+  }
+}
+
+void LogicalCheckpointManager::CheckpointTileGroups(
+    const CheckpointTask &task, const std::string &checkpoint_path,
+    const cid_t snapshot_cid, CopySerializeOutput &output) {
+  auto table = task.table;
+  std::string file_path = checkpoint_path + "/table_" +
+                          std::to_string(table->GetDatabaseOid()) + "_" +
+                          std::to_string(table->GetOid()) + "_" +
+                          std::to_string(task.part_id);
+
+  FileHandle file_handle;
+  if (LoggingUtil::OpenFile(file_path.c_str(), "wb", file_handle) == false) {
+    return;
+  }
+
+  oid_t column_count = table->GetSchema()->GetColumnCount();
+  output.Reset();
+
+  for (oid_t offset = task.tile_group_begin; offset < task.tile_group_end;
+       ++offset) {
+    auto tile_group = table->GetTileGroup(offset);
+    if (tile_group == nullptr) {
+      continue;
+    }
+    auto tile_group_header = tile_group->GetHeader();
+    oid_t active_tuple_count = tile_group->GetNextTupleSlot();
+
+    for (oid_t tuple_id = 0; tuple_id < active_tuple_count; ++tuple_id) {
+      // the version that was current at the snapshot. versions of aborted
+      // or unfinished transactions are never visible.
+      if (tile_group_header->GetTransactionId(tuple_id) == INVALID_TXN_ID) {
+        continue;
+      }
+      cid_t begin_cid = tile_group_header->GetBeginCommitId(tuple_id);
+      cid_t end_cid = tile_group_header->GetEndCommitId(tuple_id);
+      if (begin_cid > snapshot_cid || end_cid <= snapshot_cid) {
+        continue;
+      }
+
+      size_t start = output.Position();
+      output.WriteInt(0);
+      for (oid_t column_id = 0; column_id < column_count; ++column_id) {
+        tile_group->GetValue(tuple_id, column_id).SerializeTo(output);
+      }
+      output.WriteIntAt(start,
+                        (int32_t)(output.Position() - start - sizeof(int32_t)));
+
+      if (output.Size() > flush_threshold_) {
+        fwrite((const void *)output.Data(), output.Size(), 1,
+               file_handle.file);
+        output.Reset();
+      }
+    }
+  }
+
+  if (output.Size() > 0) {
+    fwrite((const void *)output.Data(), output.Size(), 1, file_handle.file);
+    output.Reset();
+  }
+
+  LoggingUtil::FFlushFsync(file_handle);
+  LoggingUtil::CloseFile(file_handle);
+}
+
+void LogicalCheckpointManager::RemoveOldCheckpoints(
+    const eid_t checkpoint_eid) {
+  DIR *dir = opendir(checkpoint_dir_.c_str());
+  if (dir == nullptr) {
+    return;
+  }
+
+  std::vector<std::string> old_checkpoints;
+  struct dirent *file;
+  while ((file = readdir(dir)) != nullptr) {
+    unsigned long long eid;
+    char tail;
+    if (sscanf(file->d_name, "checkpoint_%llu%c", &eid, &tail) == 1 &&
+        eid < checkpoint_eid) {
+      old_checkpoints.push_back(checkpoint_dir_ + "/" + file->d_name);
+    }
+  }
+  closedir(dir);
+
+  for (auto &path : old_checkpoints) {
+    LoggingUtil::RemoveDirectory(path.c_str(), false);
+  }
+}
+
+}  // namespace logging
+}  // namespace peloton
@@ -0,0 +1,551 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// logical_log_manager.cpp
+//
+// Identification: src/logging/logical_log_manager.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <dirent.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <map>
+
+#include "logging/logical_log_manager.h"
+
+#include "catalog/schema.h"
+#include "common/exception.h"
+#include "concurrency/epoch_manager_factory.h"
+#include "logging/logging_util.h"
+#include "logging/logical_log_replayer.h"
+#include "storage/data_table.h"
+#include "storage/storage_manager.h"
+#include "storage/tile_group.h"
+#include "storage/tile_group_header.h"
+
+namespace peloton {
+namespace logging {
+
+thread_local WorkerContext *tl_worker_ctx = nullptr;
+
+// the session the worker context of this thread was registered in.
+thread_local size_t tl_worker_session = 0;
+
+namespace {
+
+// deregisters the worker context of a thread when the thread exits.
+struct WorkerContextGuard {
+  ~WorkerContextGuard() {
+    auto &log_manager = LogicalLogManager::GetInstance();
+    if (log_manager.IsRegisteredWorker() == true) {
+      log_manager.DeregisterWorker();
+    }
+  }
+};
+
+thread_local WorkerContextGuard tl_worker_guard;
+
+}  // namespace
+
+void LogicalLogManager::SetDirectories(
+    const std::vector<std::string> &logging_dirs) {
+  PELOTON_ASSERT(is_running_ == false);
+
+  logger_dirs_ = logging_dirs;
+  loggers_.clear();
+  // worker contexts are owned by the loggers that have just been dropped.
+  session_id_++;
+
+  if (logging_dirs.size() > 0) {
+    pepoch_dir_ = logging_dirs.at(0);
+  }
+  // check the existence of logging directories.
+  // if not exists, then create the directory.
+  for (auto logging_dir : logging_dirs) {
+    if (LoggingUtil::CheckDirectoryExistence(logging_dir.c_str()) == false) {
+      LOG_INFO("Logging directory %s is not accessible or does not exist",
+               logging_dir.c_str());
+      bool res = LoggingUtil::CreateDirectory(logging_dir.c_str(), 0700);
+      if (res == false) {
+        LOG_ERROR("Cannot create directory: %s", logging_dir.c_str());
+      }
+    }
+  }
+
+  for (size_t i = 0; i < logging_dirs.size(); ++i) {
+    loggers_.emplace_back(new LogicalLogger(i, logging_dirs.at(i)));
+  }
+  logger_thread_count_ = logging_dirs.size();
+}
+
+eid_t LogicalLogManager::DoRecovery(const size_t recovery_thread_count,
+                                    const std::string &checkpoint_dir) {
+  PELOTON_ASSERT(is_running_ == false);
+
+  std::string pepoch_file =
+      logger_dirs_.empty() == true ? "" : GetPepochFileFullPath();
+  LogicalLogReplayer replayer(logger_dirs_, pepoch_file,
+                              recovery_thread_count);
+
+  eid_t checkpoint_eid = INVALID_EID;
+  if (checkpoint_dir.empty() == false) {
+    checkpoint_eid = replayer.LoadCheckpoint(checkpoint_dir);
+  }
+  eid_t persist_eid = replayer.ReadPersistEpochId();
+  if (persist_eid == INVALID_EID && checkpoint_eid == INVALID_EID) {
+    LOG_INFO("Nothing to recover");
+    return INVALID_EID;
+  }
+
+  // new epochs must never collide with the ones that have been recovered.
+  eid_t recovered_eid = std::max(persist_eid, checkpoint_eid);
+  auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+  if (epoch_manager.GetCurrentEpochId() <= recovered_eid) {
+    epoch_manager.SetCurrentEpochId(recovered_eid + 1);
+  }
+
+  replayer.Replay(persist_eid);
+
+  // refuse to start rather than drop the records of the tables that neither
+  // exist nor are described by the recovered catalog, and keep the log
+  // intact.
+  if (replayer.GetUnknownTableCount() > 0) {
+    throw CatalogException(
+        "Recovery found records of " +
+        std::to_string(replayer.GetUnknownTableCount()) +
+        " tables that do not exist and are not in the recovered catalog. "
+        "These tables must be created before recovery, or the log and "
+        "checkpoint directories removed.");
+  }
+
+  replayer.TruncateLogFiles();
+
+  persist_epoch_id_ = persist_eid;
+  return recovered_eid;
+}
+
+void LogicalLogManager::TruncateLog(const eid_t checkpoint_eid) {
+  for (auto &log_dir : logger_dirs_) {
+    DIR *dir = opendir(log_dir.c_str());
+    if (dir == nullptr) {
+      continue;
+    }
+
+    // log_<logger_id>_<epoch_id>
+    std::map<size_t, std::vector<eid_t>> logger_file_eids;
+    struct dirent *file;
+    while ((file = readdir(dir)) != nullptr) {
+      unsigned long logger_id;
+      unsigned long long file_eid;
+      char tail;
+      if (sscanf(file->d_name, "log_%lu_%llu%c", &logger_id, &file_eid,
+                 &tail) == 2) {
+        logger_file_eids[logger_id].push_back(file_eid);
+      }
+    }
+    closedir(dir);
+
+    for (auto &entry : logger_file_eids) {
+      auto &file_eids = entry.second;
+      std::sort(file_eids.begin(), file_eids.end());
+      // a file only holds epochs that are earlier than the next file's. the
+      // last file is still written by the logger.
+      for (size_t i = 0; i + 1 < file_eids.size(); ++i) {
+        if (file_eids[i + 1] - 1 > checkpoint_eid) {
+          break;
+        }
+        std::string path = log_dir + "/log_" + std::to_string(entry.first) +
+                           "_" + std::to_string(file_eids[i]);
+        if (remove(path.c_str()) != 0) {
+          LOG_ERROR("Failed to delete file: %s, error: %s", path.c_str(),
+                    strerror(errno));
+        }
+      }
+    }
+  }
+}
+
+void LogicalLogManager::StartLoggers() {
+  PELOTON_ASSERT(loggers_.size() > 0);
+
+  is_running_ = true;
+  pepoch_running_ = true;
+
+  for (auto &logger : loggers_) {
+    logger->StartLogging();
+  }
+}
+
+void LogicalLogManager::StartLogging(
+    std::vector<std::unique_ptr<std::thread>> &pepoch_threads) {
+  if (loggers_.empty() == true) {
+    LOG_ERROR("No logging directory is set");
+    return;
+  }
+  StartLoggers();
+
+  pepoch_threads.emplace_back(
+      new std::thread(&LogicalLogManager::RunPepochLogger, this));
+}
+
+void LogicalLogManager::StartLogging() {
+  if (loggers_.empty() == true) {
+    LOG_ERROR("No logging directory is set");
+    return;
+  }
+  StartLoggers();
+
+  pepoch_thread_.reset(
+      new std::thread(&LogicalLogManager::RunPepochLogger, this));
+}
+
+void LogicalLogManager::StopLogging() {
+  if (is_running_ == false) {
+    return;
+  }
+  // transactions that begin from now on are not logged.
+  is_running_ = false;
+
+  // every logger drains the buffers of its workers before it exits.
+  for (auto &logger : loggers_) {
+    logger->StopLogging();
+  }
+
+  // the pepoch thread persists the final epoch and exits.
+  pepoch_running_ = false;
+  if (pepoch_thread_ != nullptr) {
+    pepoch_thread_->join();
+    pepoch_thread_.reset();
+  }
+}
+
+void LogicalLogManager::RegisterWorker() {
+  PELOTON_ASSERT(loggers_.size() > 0);
+
+  // make sure the context is dropped when this thread exits.
+  UNUSED_ATTRIBUTE auto guard = &tl_worker_guard;
+
+  if (IsRegisteredWorker() == true) {
+    DeregisterWorker();
+  }
+
+  oid_t worker_id = worker_count_.fetch_add(1);
+  std::shared_ptr<WorkerContext> worker_ctx(
+      new WorkerContext(worker_id, INVALID_EID));
+  worker_ctx->logger = loggers_[worker_id % loggers_.size()].get();
+  worker_ctx->logger->RegisterWorker(worker_ctx);
+
+  tl_worker_ctx = worker_ctx.get();
+  tl_worker_session = session_id_;
+}
+
+void LogicalLogManager::DeregisterWorker() {
+  PELOTON_ASSERT(IsRegisteredWorker() == true);
+
+  tl_worker_ctx->terminated = true;
+  tl_worker_ctx = nullptr;
+}
+
+bool LogicalLogManager::IsRegisteredWorker() const {
+  // contexts of an earlier session have been released with their loggers.
+  return tl_worker_ctx != nullptr && tl_worker_session == session_id_;
+}
+
+void LogicalLogManager::LogBegin(const cid_t &commit_id) {
+  if (is_running_ == false) {
+    return;
+  }
+  if (IsRegisteredWorker() == false) {
+    RegisterWorker();
+  }
+
+  auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+
+  // announce the commit epoch. the loggers close every epoch that is earlier
+  // than both the announced epoch and the global epoch, so retry if the
+  // global epoch has moved while announcing.
+  eid_t epoch_id;
+  do {
+    epoch_id = epoch_manager.GetCurrentEpochId();
+    tl_worker_ctx->current_commit_eid = epoch_id;
+  } while (epoch_id != epoch_manager.GetCurrentEpochId());
+
+  tl_worker_ctx->current_cid = commit_id;
+  tl_worker_ctx->txn_logged = false;
+}
+
+void LogicalLogManager::LogEnd() {
+  if (IsRegisteredWorker() == false ||
+      tl_worker_ctx->current_commit_eid == MAX_EID) {
+    return;
+  }
+
+  eid_t epoch_id = tl_worker_ctx->current_commit_eid;
+  bool txn_logged = tl_worker_ctx->txn_logged;
+
+  if (txn_logged == true) {
+    LogRecord record = LogRecordFactory::CreateTxnRecord(
+        LogRecordType::TRANSACTION_COMMIT, tl_worker_ctx->current_cid);
+    WriteRecordToBuffer(record);
+  }
+
+  // from now on, the loggers may close the epoch.
+  tl_worker_ctx->current_commit_eid = MAX_EID;
+  tl_worker_ctx->current_cid = INVALID_CID;
+  tl_worker_ctx->txn_logged = false;
+
+  if (txn_logged == true && synchronous_commit_ == true) {
+    WaitForPersistEpoch(epoch_id);
+  }
+}
+
+void LogicalLogManager::LogInsert(const ItemPointer &tuple_pos) {
+  if (IsRegisteredWorker() == false ||
+      tl_worker_ctx->current_commit_eid == MAX_EID) {
+    return;
+  }
+  LogTxnBeginIfNeeded();
+
+  LogRecord record = LogRecordFactory::CreateTupleRecord(
+      LogRecordType::TUPLE_INSERT, tuple_pos);
+  WriteRecordToBuffer(record);
+}
+
+void LogicalLogManager::LogUpdate(const ItemPointer &tuple_pos) {
+  if (IsRegisteredWorker() == false ||
+      tl_worker_ctx->current_commit_eid == MAX_EID) {
+    return;
+  }
+  LogTxnBeginIfNeeded();
+
+  LogRecord record = LogRecordFactory::CreateTupleRecord(
+      LogRecordType::TUPLE_UPDATE, tuple_pos);
+  WriteRecordToBuffer(record);
+}
+
+void LogicalLogManager::LogDelete(const ItemPointer &tuple_pos_deleted) {
+  if (IsRegisteredWorker() == false ||
+      tl_worker_ctx->current_commit_eid == MAX_EID) {
+    return;
+  }
+  LogTxnBeginIfNeeded();
+
+  LogRecord record = LogRecordFactory::CreateTupleRecord(
+      LogRecordType::TUPLE_DELETE, tuple_pos_deleted);
+  WriteRecordToBuffer(record);
+}
+
+void LogicalLogManager::WaitForPersistEpoch(const eid_t epoch_id) {
+  std::unique_lock<std::mutex> lock(persist_mutex_);
+  persist_cv_.wait(lock, [this, epoch_id] {
+    return persist_epoch_id_ >= epoch_id || pepoch_running_ == false;
+  });
+}
+
+void LogicalLogManager::LogTxnBeginIfNeeded() {
+  if (tl_worker_ctx->txn_logged == true) {
+    return;
+  }
+  tl_worker_ctx->txn_logged = true;
+
+  LogRecord record = LogRecordFactory::CreateTxnRecord(
+      LogRecordType::TRANSACTION_BEGIN, tl_worker_ctx->current_cid);
+  WriteRecordToBuffer(record);
+}
+
+void LogicalLogManager::WriteRecordToBuffer(LogRecord &record) {
+  WorkerContext *ctx = tl_worker_ctx;
+  auto &output = ctx->output_buffer;
+
+  output.Reset();
+
+  // Reserve for the frame length
+  size_t start = output.Position();
+  output.WriteInt(0);
+
+  LogRecordType type = record.GetType();
+  output.WriteEnumInSingleByte(static_cast<int>(type));
+
+  switch (type) {
+    case LogRecordType::TRANSACTION_BEGIN:
+    case LogRecordType::TRANSACTION_COMMIT: {
+      output.WriteLong((int64_t)ctx->current_cid);
+      break;
+    }
+    case LogRecordType::TUPLE_INSERT:
+    case LogRecordType::TUPLE_UPDATE:
+    case LogRecordType::TUPLE_DELETE: {
+      auto storage_manager = storage::StorageManager::GetInstance();
+
+      auto &tuple_pos = record.GetItemPointer();
+      auto tile_group = storage_manager->GetTileGroup(tuple_pos.block);
+      auto table =
+          dynamic_cast<storage::DataTable *>(tile_group->GetAbstractTable());
+      PELOTON_ASSERT(table != nullptr);
+
+      output.WriteInt(tile_group->GetDatabaseId());
+      output.WriteInt(tile_group->GetTableId());
+
+      if (type != LogRecordType::TUPLE_INSERT) {
+        // the key of the version that is replaced or deleted.
+        ItemPointer old_pos = tuple_pos;
+        if (type == LogRecordType::TUPLE_UPDATE) {
+          old_pos = tile_group->GetHeader()->GetNextItemPointer(
+              tuple_pos.offset);
+        }
+        auto old_tile_group = storage_manager->GetTileGroup(old_pos.block);
+        for (auto column_id : LoggingUtil::GetLogKeyColumns(table)) {
+          old_tile_group->GetValue(old_pos.offset, column_id)
+              .SerializeTo(output);
+        }
+      }
+
+      if (type != LogRecordType::TUPLE_DELETE) {
+        oid_t column_count = table->GetSchema()->GetColumnCount();
+        for (oid_t column_id = 0; column_id < column_count; ++column_id) {
+          tile_group->GetValue(tuple_pos.offset, column_id)
+              .SerializeTo(output);
+        }
+      }
+      break;
+    }
+    default: {
+      LOG_ERROR("Unsupported log record type: %s",
+                LogRecordTypeToString(type).c_str());
+      PELOTON_ASSERT(false);
+    }
+  }
+
+  // Add the frame length
+  output.WriteIntAt(start,
+                    (int32_t)(output.Position() - start - sizeof(int32_t)));
+
+  eid_t epoch_id = ctx->current_commit_eid;
+
+  if (ctx->current_buffer_eid != epoch_id || ctx->current_buffers == nullptr) {
+    // the first record of this worker in this epoch.
+    ctx->pooled_buffer_count = 0;
+    auto buffer = GetBuffer(ctx, epoch_id);
+
+    ctx->epoch_buffers_lock.Lock();
+    auto &buffers = ctx->epoch_buffers[epoch_id];
+    PELOTON_ASSERT(buffers.empty() == true);
+    buffers.push_back(std::move(buffer));
+    ctx->current_buffers = &buffers;
+    ctx->current_buffer_eid = epoch_id;
+    ctx->epoch_buffers_lock.Unlock();
+  }
+
+  auto &buffers = *ctx->current_buffers;
+  if (buffers.back()->WriteData(output.Data(), output.Size()) == false) {
+    // the buffer is full.
+    buffers.push_back(GetBuffer(ctx, epoch_id));
+    UNUSED_ATTRIBUTE bool res =
+        buffers.back()->WriteData(output.Data(), output.Size());
+    PELOTON_ASSERT(res == true);
+  }
+}
+
+std::unique_ptr<LogBuffer> LogicalLogManager::GetBuffer(WorkerContext *ctx,
+                                                        const eid_t epoch_id) {
+  auto &buffer_pool = ctx->buffer_pool;
+
+  // the logger only hands back the buffers of closed epochs. if the open
+  // epoch of this worker holds every buffer of the pool, waiting for a free
+  // one would never end, so the epoch spills into a buffer of its own. the
+  // logger drops it once the pool is full again.
+  size_t used_buffer_count =
+      buffer_pool.GetMaxSlotCount() - buffer_pool.GetEmptySlotCount();
+  if (buffer_pool.GetEmptySlotCount() <= 1 &&
+      ctx->pooled_buffer_count >= used_buffer_count) {
+    LOG_DEBUG("Worker %d spills epoch %lu out of its buffer pool",
+              (int)ctx->worker_id, (unsigned long)epoch_id);
+    return std::unique_ptr<LogBuffer>(new LogBuffer(ctx->worker_id, epoch_id));
+  }
+
+  ctx->pooled_buffer_count++;
+  return buffer_pool.GetBuffer(epoch_id);
+}
+
+void LogicalLogManager::RunPepochLogger() {
+  FileHandle file_handle;
+  if (LoggingUtil::OpenFile(GetPepochFileFullPath().c_str(), "ab",
+                            file_handle) == false) {
+    LOG_ERROR("Cannot open pepoch file %s", GetPepochFileFullPath().c_str());
+    pepoch_running_ = false;
+    persist_cv_.notify_all();
+    return;
+  }
+
+  auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+
+  while (true) {
+    // read the flag first, so that the last round sees the final epochs of
+    // the loggers.
+    bool is_running = pepoch_running_;
+
+    // an epoch is durable once every logger has persisted it.
+    eid_t min_persist_eid = MAX_EID;
+    for (auto &logger : loggers_) {
+      eid_t logger_persist_eid = logger->GetPersistEpochId();
+      if (logger_persist_eid < min_persist_eid) {
+        min_persist_eid = logger_persist_eid;
+      }
+    }
+
+    if (min_persist_eid != MAX_EID && min_persist_eid > persist_epoch_id_) {
+      auto flush_begin = std::chrono::steady_clock::now();
+      fwrite((const void *)(&min_persist_eid), sizeof(min_persist_eid), 1,
+             file_handle.file);
+      LoggingUtil::FFlushFsync(file_handle);
+
+      // a commit is acknowledged after the slowest logger and the pepoch
+      // file have both been synced. the epoch manager keeps epochs longer
+      // than that.
+      uint64_t flush_time_us =
+          std::chrono::duration_cast<std::chrono::microseconds>(
+              std::chrono::steady_clock::now() - flush_begin)
+              .count();
+      uint64_t logger_flush_time_us = 0;
+      for (auto &logger : loggers_) {
+        logger_flush_time_us =
+            std::max(logger_flush_time_us, logger->GetFlushTime());
+      }
+      epoch_manager.ReportEpochFlush(min_persist_eid,
+                                     flush_time_us + logger_flush_time_us);
+
+      {
+        std::lock_guard<std::mutex> lock(persist_mutex_);
+        persist_epoch_id_ = min_persist_eid;
+      }
+      // acknowledge every transaction in the durable epochs at once.
+      persist_cv_.notify_all();
+    }
+
+    if (is_running == false) {
+      break;
+    }
+
+    std::this_thread::sleep_for(
+        std::chrono::microseconds(pepoch_sleep_period_us_));
+  }
+
+  LoggingUtil::CloseFile(file_handle);
+
+  // epochs no longer wait for a flush.
+  epoch_manager.ReportEpochFlush(INVALID_EID, 0);
+
+  // wake up whoever still waits.
+  {
+    std::lock_guard<std::mutex> lock(persist_mutex_);
+  }
+  persist_cv_.notify_all();
+}
+
+}  // namespace logging
+}  // namespace peloton
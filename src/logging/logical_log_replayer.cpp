@@ -0,0 +1,797 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// logical_log_replayer.cpp
+//
+// Identification: src/logging/logical_log_replayer.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <dirent.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <thread>
+
+#include "logging/logical_log_replayer.h"
+
+#include "catalog/catalog.h"
+#include "catalog/catalog_defaults.h"
+#include "catalog/schema.h"
+#include "common/exception.h"
+#include "common/logger.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "logging/logging_util.h"
+#include "storage/data_table.h"
+#include "storage/storage_manager.h"
+#include "storage/tuple.h"
+#include "type/ephemeral_pool.h"
+#include "type/serializeio.h"
+
+namespace peloton {
+namespace logging {
+
+eid_t LogicalLogReplayer::LoadCheckpoint(const std::string &checkpoint_dir) {
+  DIR *dir = opendir(checkpoint_dir.c_str());
+  if (dir == nullptr) {
+    return INVALID_EID;
+  }
+
+  // the latest checkpoint that has been completed.
+  eid_t checkpoint_eid = INVALID_EID;
+  cid_t checkpoint_cid = INVALID_CID;
+  struct dirent *file;
+  while ((file = readdir(dir)) != nullptr) {
+    unsigned long long eid;
+    char tail;
+    if (sscanf(file->d_name, "checkpoint_%llu%c", &eid, &tail) != 1 ||
+        eid <= checkpoint_eid) {
+      continue;
+    }
+    std::string info_path =
+        checkpoint_dir + "/" + file->d_name + "/checkpoint_info";
+    FileHandle file_handle;
+    if (access(info_path.c_str(), F_OK) != 0 ||
+        LoggingUtil::OpenFile(info_path.c_str(), "rb", file_handle) == false) {
+      continue;
+    }
+    int64_t cid;
+    if (LoggingUtil::ReadNBytesFromFile(file_handle, (void *)&cid,
+                                        sizeof(cid)) == true) {
+      ReferenceSerializeInput input(&cid, sizeof(cid));
+      checkpoint_eid = eid;
+      checkpoint_cid = (cid_t)input.ReadLong();
+    }
+    LoggingUtil::CloseFile(file_handle);
+  }
+  closedir(dir);
+
+  if (checkpoint_eid == INVALID_EID) {
+    return INVALID_EID;
+  }
+
+  std::string checkpoint_path =
+      checkpoint_dir + "/checkpoint_" + std::to_string(checkpoint_eid);
+  std::vector<std::string> files;
+  dir = opendir(checkpoint_path.c_str());
+  if (dir == nullptr) {
+    return INVALID_EID;
+  }
+  while ((file = readdir(dir)) != nullptr) {
+    if (strncmp(file->d_name, "table_", 6) == 0) {
+      files.push_back(checkpoint_path + "/" + file->d_name);
+    }
+  }
+  closedir(dir);
+
+  next_task_ = 0;
+  std::vector<std::thread> threads;
+  size_t thread_count = std::min(recovery_thread_count_, files.size());
+  for (size_t i = 0; i < thread_count; ++i) {
+    threads.emplace_back(&LogicalLogReplayer::RunLoadCheckpointThread, this,
+                         &files);
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  begin_commit_id_ = checkpoint_cid;
+  LOG_INFO("Loaded checkpoint of epoch %" PRId64 " (%lu files)",
+           checkpoint_eid, files.size());
+  return checkpoint_eid;
+}
+
+void LogicalLogReplayer::RunLoadCheckpointThread(
+    const std::vector<std::string> *files) {
+  while (true) {
+    size_t file_id = next_task_.fetch_add(1);
+    if (file_id >= files->size()) {
+      break;
+    }
+    LoadCheckpointFile(files->at(file_id));
+  }
+}
+
+void LogicalLogReplayer::LoadCheckpointFile(const std::string &file_path) {
+  // table_<database_id>_<table_id>_<part_id>
+  auto file_name = file_path.substr(file_path.rfind('/') + 1);
+  unsigned int database_id, table_id;
+  unsigned long part_id;
+  if (sscanf(file_name.c_str(), "table_%u_%u_%lu", &database_id, &table_id,
+             &part_id) != 3) {
+    return;
+  }
+  ReplayTable *replay_table = GetReplayTable(database_id, table_id);
+  if (replay_table == nullptr) {
+    return;
+  }
+
+  FileHandle file_handle;
+  if (LoggingUtil::OpenFile(file_path.c_str(), "rb", file_handle) == false) {
+    return;
+  }
+  std::vector<char> data(file_handle.size);
+  bool res = data.empty() == true ||
+             LoggingUtil::ReadNBytesFromFile(file_handle, data.data(),
+                                             data.size());
+  LoggingUtil::CloseFile(file_handle);
+  if (res == false) {
+    LOG_ERROR("Failed to read checkpoint file %s", file_path.c_str());
+    return;
+  }
+
+  std::vector<std::pair<std::string, std::string>> tuples;
+  std::vector<std::string> deferred_tuples;
+  size_t offset = 0;
+  while (offset + sizeof(int32_t) <= data.size()) {
+    ReferenceSerializeInput length_input(data.data() + offset,
+                                         sizeof(int32_t));
+    int32_t length = length_input.ReadInt();
+    size_t frame_end = offset + sizeof(int32_t) + length;
+    if (length <= 0 || frame_end > data.size()) {
+      LOG_ERROR("Corrupted checkpoint file %s", file_path.c_str());
+      break;
+    }
+    const char *frame_begin = data.data() + offset + sizeof(int32_t);
+    offset = frame_end;
+
+    if (replay_table->deferred == true) {
+      deferred_tuples.emplace_back(frame_begin, length);
+      continue;
+    }
+    ReferenceSerializeInput input(frame_begin, length);
+    std::string key, tuple_data;
+    ParseTuple(*replay_table, input, key, tuple_data);
+    tuples.emplace_back(std::move(key), std::move(tuple_data));
+  }
+
+  std::lock_guard<std::mutex> lock(replay_table->tuples_lock);
+  for (auto &tuple : tuples) {
+    replay_table->tuples[tuple.first].push_back(std::move(tuple.second));
+  }
+  for (auto &tuple : deferred_tuples) {
+    replay_table->checkpoint_tuples.push_back(std::move(tuple));
+  }
+}
+
+void LogicalLogReplayer::ParseRecord(ReplayTable &replay_table,
+                                     SerializeInput &input,
+                                     ReplayRecord &record) {
+  if (record.type != LogRecordType::TUPLE_INSERT) {
+    auto schema = replay_table.table->GetSchema();
+    const char *key_begin = (const char *)input.getRawPointer(0);
+    for (auto column_id : replay_table.key_columns) {
+      type::Value::DeserializeFrom(input, schema->GetType(column_id));
+    }
+    const char *key_end = (const char *)input.getRawPointer(0);
+    record.old_key.assign(key_begin, key_end - key_begin);
+  }
+
+  if (record.type != LogRecordType::TUPLE_DELETE) {
+    ParseTuple(replay_table, input, record.new_key, record.tuple_data);
+  }
+}
+
+void LogicalLogReplayer::ParseTuple(ReplayTable &replay_table,
+                                    SerializeInput &input, std::string &key,
+                                    std::string &tuple_data) {
+  auto schema = replay_table.table->GetSchema();
+  oid_t column_count = schema->GetColumnCount();
+
+  std::vector<const char *> column_offsets(column_count + 1);
+  for (oid_t column_id = 0; column_id < column_count; ++column_id) {
+    column_offsets[column_id] = (const char *)input.getRawPointer(0);
+    type::Value::DeserializeFrom(input, schema->GetType(column_id));
+  }
+  column_offsets[column_count] = (const char *)input.getRawPointer(0);
+
+  for (auto column_id : replay_table.key_columns) {
+    key.append(column_offsets[column_id],
+               column_offsets[column_id + 1] - column_offsets[column_id]);
+  }
+  tuple_data.assign(column_offsets[0],
+                    column_offsets[column_count] - column_offsets[0]);
+}
+
+eid_t LogicalLogReplayer::ReadPersistEpochId() {
+  if (pepoch_file_.empty() == true || access(pepoch_file_.c_str(), F_OK) != 0) {
+    LOG_INFO("No pepoch file found at %s", pepoch_file_.c_str());
+    return INVALID_EID;
+  }
+
+  FileHandle file_handle;
+  if (LoggingUtil::OpenFile(pepoch_file_.c_str(), "rb", file_handle) == false) {
+    LOG_INFO("No pepoch file found at %s", pepoch_file_.c_str());
+    return INVALID_EID;
+  }
+
+  // a torn entry at the end of the file is ignored.
+  eid_t persist_eid = INVALID_EID;
+  eid_t epoch_id;
+  while (LoggingUtil::ReadNBytesFromFile(file_handle, (void *)&epoch_id,
+                                         sizeof(epoch_id)) == true) {
+    persist_eid = std::max(persist_eid, epoch_id);
+  }
+
+  LoggingUtil::CloseFile(file_handle);
+  return persist_eid;
+}
+
+void LogicalLogReplayer::Replay(const eid_t persist_epoch_id) {
+  persist_epoch_id_ = persist_epoch_id;
+
+  ListLogFiles();
+
+  // phase 1: read every log file.
+  next_log_file_ = 0;
+  std::vector<std::thread> threads;
+  size_t file_thread_count =
+      std::min(recovery_thread_count_, log_files_.size());
+  for (size_t i = 0; i < file_thread_count; ++i) {
+    threads.emplace_back(&LogicalLogReplayer::RunReplayFileThread, this);
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  threads.clear();
+
+  // phases 2 and 3 run once for the tables that exist, and once more for
+  // every round of tables that the recovered catalog creates.
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  while (true) {
+    std::vector<ReplayTable *> replay_tables;
+    bool has_catalog = false;
+    for (auto &entry : replay_tables_) {
+      auto replay_table = entry.second.get();
+      if (replay_table != nullptr && replay_table->table != nullptr &&
+          replay_table->installed == false) {
+        replay_tables.push_back(replay_table);
+        has_catalog = has_catalog || replay_table->is_catalog;
+      }
+    }
+    if (replay_tables.empty() == true) {
+      break;
+    }
+
+    InstallTables(replay_tables);
+
+    if (has_catalog == true) {
+      auto txn = txn_manager.BeginTransaction();
+      catalog::Catalog::GetInstance()->RecoverStorageObjects(txn);
+      txn_manager.CommitTransaction(txn);
+      ResolveDeferredTables();
+    }
+  }
+
+  for (auto &entry : replay_tables_) {
+    auto replay_table = entry.second.get();
+    if (replay_table == nullptr || replay_table->table != nullptr) {
+      continue;
+    }
+    if (dropped_databases_.count(replay_table->database_id) > 0 ||
+        dropped_tables_.count(entry.first) > 0) {
+      LOG_DEBUG("Skipping log records of dropped table %u in database %u",
+                replay_table->table_id, replay_table->database_id);
+      continue;
+    }
+    LOG_ERROR("Skipping log records of unknown table %u in database %u",
+              replay_table->table_id, replay_table->database_id);
+    unknown_table_count_++;
+  }
+
+  LOG_INFO("Recovered %lu tuples from %lu transactions (%lu bytes of log)",
+           recovered_tuple_count_.load(), replayed_txn_count_.load(),
+           replayed_bytes_.load());
+}
+
+void LogicalLogReplayer::InstallTables(
+    const std::vector<ReplayTable *> &replay_tables) {
+  std::vector<std::thread> threads;
+
+  // phase 2: replay every table.
+  next_task_ = 0;
+  size_t table_thread_count =
+      std::min(recovery_thread_count_, replay_tables.size());
+  for (size_t i = 0; i < table_thread_count; ++i) {
+    threads.emplace_back(&LogicalLogReplayer::RunReplayTableThread, this,
+                         &replay_tables);
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  threads.clear();
+
+  // phase 3: install the images into the tables.
+  std::vector<std::pair<ReplayTable *, std::string *>> tuples;
+  for (auto replay_table : replay_tables) {
+    for (auto &entry : replay_table->tuples) {
+      for (auto &tuple_data : entry.second) {
+        tuples.emplace_back(replay_table, &tuple_data);
+      }
+    }
+  }
+
+  next_task_ = 0;
+  size_t chunk_count =
+      (tuples.size() + install_chunk_size_ - 1) / install_chunk_size_;
+  size_t install_thread_count = std::min(recovery_thread_count_, chunk_count);
+  for (size_t i = 0; i < install_thread_count; ++i) {
+    threads.emplace_back(&LogicalLogReplayer::RunInstallThread, this, &tuples);
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  for (auto replay_table : replay_tables) {
+    replay_table->installed = true;
+    replay_table->tuples.clear();
+  }
+}
+
+void LogicalLogReplayer::ResolveDeferredTables() {
+  for (auto &entry : replay_tables_) {
+    auto replay_table = entry.second.get();
+    if (replay_table == nullptr || replay_table->table != nullptr) {
+      continue;
+    }
+    try {
+      replay_table->table =
+          storage::StorageManager::GetInstance()->GetTableWithOid(
+              replay_table->database_id, replay_table->table_id);
+    } catch (CatalogException &e) {
+      continue;
+    }
+    replay_table->key_columns =
+        LoggingUtil::GetLogKeyColumns(replay_table->table);
+  }
+}
+
+void LogicalLogReplayer::TruncateLogFiles() {
+  for (auto &log_file : log_files_) {
+    if (log_file.durable_size == std::numeric_limits<size_t>::max()) {
+      // the file could not be read. leave it alone.
+      continue;
+    }
+    if (log_file.durable_size == 0) {
+      if (remove(log_file.path.c_str()) != 0) {
+        LOG_ERROR("Failed to delete file: %s, error: %s",
+                  log_file.path.c_str(), strerror(errno));
+      }
+    } else if (log_file.durable_size < log_file.size) {
+      if (truncate(log_file.path.c_str(), log_file.durable_size) != 0) {
+        LOG_ERROR("Failed to truncate file: %s, error: %s",
+                  log_file.path.c_str(), strerror(errno));
+      }
+    }
+  }
+}
+
+void LogicalLogReplayer::ListLogFiles() {
+  log_files_.clear();
+
+  for (auto &log_dir : log_dirs_) {
+    DIR *dir = opendir(log_dir.c_str());
+    if (dir == nullptr) {
+      continue;
+    }
+
+    struct dirent *file;
+    while ((file = readdir(dir)) != nullptr) {
+      // log_<logger_id>_<epoch_id>
+      unsigned long logger_id;
+      unsigned long long file_eid;
+      char tail;
+      if (sscanf(file->d_name, "log_%lu_%llu%c", &logger_id, &file_eid,
+                 &tail) != 2) {
+        continue;
+      }
+
+      LogFile log_file;
+      log_file.path = log_dir + "/" + file->d_name;
+      log_file.file_eid = file_eid;
+      log_file.durable_size = std::numeric_limits<size_t>::max();
+      log_file.size = 0;
+      log_files_.push_back(log_file);
+    }
+    closedir(dir);
+  }
+
+  // older files are read first.
+  std::sort(log_files_.begin(), log_files_.end(),
+            [](const LogFile &lhs, const LogFile &rhs) {
+              return lhs.file_eid < rhs.file_eid;
+            });
+}
+
+void LogicalLogReplayer::RunReplayFileThread() {
+  TableRecordMap records;
+
+  while (true) {
+    size_t file_id = next_log_file_.fetch_add(1);
+    if (file_id >= log_files_.size()) {
+      break;
+    }
+    ReplayLogFile(log_files_[file_id], records);
+  }
+
+  std::lock_guard<std::mutex> lock(replay_tables_lock_);
+  for (auto &entry : records) {
+    auto &replay_table = replay_tables_.at(entry.first);
+    PELOTON_ASSERT(replay_table != nullptr);
+    auto &table_records = replay_table->records;
+    if (table_records.empty() == true) {
+      table_records = std::move(entry.second);
+    } else {
+      std::move(entry.second.begin(), entry.second.end(),
+                std::back_inserter(table_records));
+    }
+  }
+}
+
+void LogicalLogReplayer::ReplayLogFile(LogFile &log_file,
+                                       TableRecordMap &records) {
+  FileHandle file_handle;
+  if (LoggingUtil::OpenFile(log_file.path.c_str(), "rb", file_handle) ==
+      false) {
+    return;
+  }
+  log_file.size = file_handle.size;
+
+  // the file starts at an epoch that is not durable.
+  if (persist_epoch_id_ == INVALID_EID ||
+      log_file.file_eid > persist_epoch_id_) {
+    log_file.durable_size = 0;
+    LoggingUtil::CloseFile(file_handle);
+    return;
+  }
+
+  std::vector<char> data(log_file.size);
+  if (log_file.size > 0 &&
+      LoggingUtil::ReadNBytesFromFile(file_handle, data.data(),
+                                      log_file.size) == false) {
+    LOG_ERROR("Failed to read log file %s", log_file.path.c_str());
+    LoggingUtil::CloseFile(file_handle);
+    return;
+  }
+  LoggingUtil::CloseFile(file_handle);
+  log_file.durable_size = 0;
+
+  // records of the epoch and the transaction that are currently read.
+  std::vector<std::pair<uint64_t, ReplayRecord>> epoch_records;
+  std::vector<std::pair<uint64_t, ReplayRecord>> txn_records;
+  size_t epoch_txn_count = 0;
+  eid_t current_eid = INVALID_EID;
+  cid_t current_cid = INVALID_CID;
+
+  size_t offset = 0;
+  while (offset + sizeof(int32_t) <= data.size()) {
+    ReferenceSerializeInput length_input(data.data() + offset,
+                                         sizeof(int32_t));
+    int32_t length = length_input.ReadInt();
+    size_t frame_end = offset + sizeof(int32_t) + length;
+    if (length <= 0 || frame_end > data.size()) {
+      // a torn write at the end of the file.
+      break;
+    }
+
+    ReferenceSerializeInput input(data.data() + offset + sizeof(int32_t),
+                                  length);
+    const char *body_end = data.data() + frame_end;
+    offset = frame_end;
+
+    LogRecordType type = static_cast<LogRecordType>(input.ReadEnumInSingleByte());
+    switch (type) {
+      case LogRecordType::EPOCH_BEGIN: {
+        current_eid = (eid_t)input.ReadLong();
+        epoch_records.clear();
+        epoch_txn_count = 0;
+        break;
+      }
+      case LogRecordType::EPOCH_END: {
+        eid_t epoch_id = (eid_t)input.ReadLong();
+        if (epoch_id != current_eid || epoch_id > persist_epoch_id_) {
+          break;
+        }
+        for (auto &entry : epoch_records) {
+          records[entry.first].push_back(std::move(entry.second));
+        }
+        epoch_records.clear();
+        replayed_txn_count_ += epoch_txn_count;
+        log_file.durable_size = offset;
+        break;
+      }
+      case LogRecordType::TRANSACTION_BEGIN: {
+        current_cid = (cid_t)input.ReadLong();
+        txn_records.clear();
+        break;
+      }
+      case LogRecordType::TRANSACTION_COMMIT: {
+        cid_t commit_id = (cid_t)input.ReadLong();
+        if (commit_id != current_cid) {
+          break;
+        }
+        if (begin_commit_id_ == INVALID_CID || commit_id > begin_commit_id_) {
+          for (auto &entry : txn_records) {
+            epoch_records.push_back(std::move(entry));
+          }
+          epoch_txn_count++;
+        }
+        txn_records.clear();
+        current_cid = INVALID_CID;
+        break;
+      }
+      case LogRecordType::TUPLE_INSERT:
+      case LogRecordType::TUPLE_UPDATE:
+      case LogRecordType::TUPLE_DELETE: {
+        oid_t database_id = (oid_t)input.ReadInt();
+        oid_t table_id = (oid_t)input.ReadInt();
+        ReplayTable *replay_table = GetReplayTable(database_id, table_id);
+        if (replay_table == nullptr) {
+          break;
+        }
+
+        ReplayRecord record;
+        record.commit_id = current_cid;
+        record.type = type;
+
+        if (replay_table->deferred == true) {
+          const char *rest_begin = (const char *)input.getRawPointer(0);
+          record.tuple_data.assign(rest_begin, body_end - rest_begin);
+        } else {
+          ParseRecord(*replay_table, input, record);
+          PELOTON_ASSERT(type == LogRecordType::TUPLE_DELETE ||
+                         input.getRawPointer(0) == body_end);
+        }
+
+        txn_records.emplace_back(GetTableKey(database_id, table_id),
+                                 std::move(record));
+        break;
+      }
+      default: {
+        LOG_ERROR("Unknown log record type %d in %s", (int)type,
+                  log_file.path.c_str());
+        break;
+      }
+    }
+  }
+
+  replayed_bytes_ += log_file.size;
+}
+
+LogicalLogReplayer::ReplayTable *LogicalLogReplayer::GetReplayTable(
+    const oid_t database_id, const oid_t table_id) {
+  uint64_t table_key = GetTableKey(database_id, table_id);
+
+  std::lock_guard<std::mutex> lock(replay_tables_lock_);
+  auto itr = replay_tables_.find(table_key);
+  if (itr != replay_tables_.end()) {
+    return itr->second.get();
+  }
+
+  if (LoggingUtil::IsRecoveredTable(database_id, table_id) == false) {
+    replay_tables_[table_key] = nullptr;
+    return nullptr;
+  }
+
+  // the table may be created once the catalog has been recovered.
+  storage::DataTable *table = nullptr;
+  try {
+    table = storage::StorageManager::GetInstance()->GetTableWithOid(
+        database_id, table_id);
+  } catch (CatalogException &e) {
+    LOG_DEBUG("Deferring log records of table %u in database %u", table_id,
+              database_id);
+  }
+
+  std::unique_ptr<ReplayTable> replay_table(new ReplayTable());
+  replay_table->database_id = database_id;
+  replay_table->table_id = table_id;
+  replay_table->table = table;
+  replay_table->is_catalog =
+      LoggingUtil::IsCoreCatalogTable(database_id, table_id);
+  replay_table->deferred = table == nullptr;
+  replay_table->installed = false;
+  if (table != nullptr) {
+    replay_table->key_columns = LoggingUtil::GetLogKeyColumns(table);
+  }
+  auto replay_table_ptr = replay_table.get();
+  replay_tables_[table_key] = std::move(replay_table);
+  return replay_table_ptr;
+}
+
+void LogicalLogReplayer::RunReplayTableThread(
+    const std::vector<ReplayTable *> *replay_tables) {
+  while (true) {
+    size_t table_id = next_task_.fetch_add(1);
+    if (table_id >= replay_tables->size()) {
+      break;
+    }
+    ReplayTableRecords(*replay_tables->at(table_id));
+  }
+}
+
+void LogicalLogReplayer::ReplayTableRecords(ReplayTable &replay_table) {
+  if (replay_table.deferred == true) {
+    ParseDeferredTable(replay_table);
+  }
+
+  auto &records = replay_table.records;
+  auto &tuples = replay_table.tuples;
+
+  // conflicting writes are ordered by commit id.
+  std::stable_sort(records.begin(), records.end(),
+                   [](const ReplayRecord &lhs, const ReplayRecord &rhs) {
+                     return lhs.commit_id < rhs.commit_id;
+                   });
+
+  size_t txn_begin = 0;
+  while (txn_begin < records.size()) {
+    size_t txn_end = txn_begin;
+    while (txn_end < records.size() &&
+           records[txn_end].commit_id == records[txn_begin].commit_id) {
+      txn_end++;
+    }
+
+    // the records of a transaction are not ordered. every version it
+    // replaced is removed before any version it created is added.
+    for (size_t i = txn_begin; i < txn_end; ++i) {
+      auto &record = records[i];
+      if (record.type == LogRecordType::TUPLE_INSERT) {
+        continue;
+      }
+      auto itr = tuples.find(record.old_key);
+      if (itr == tuples.end()) {
+        LOG_TRACE("No version to replace for commit id %" PRId64,
+                  record.commit_id);
+        continue;
+      }
+      itr->second.pop_back();
+      if (itr->second.empty() == true) {
+        tuples.erase(itr);
+      }
+    }
+
+    for (size_t i = txn_begin; i < txn_end; ++i) {
+      auto &record = records[i];
+      if (record.type == LogRecordType::TUPLE_DELETE) {
+        continue;
+      }
+      tuples[record.new_key].push_back(std::move(record.tuple_data));
+    }
+
+    txn_begin = txn_end;
+  }
+
+  if (replay_table.is_catalog == true) {
+    CollectDroppedObjects(replay_table);
+  }
+
+  records.clear();
+  records.shrink_to_fit();
+}
+
+void LogicalLogReplayer::ParseDeferredTable(ReplayTable &replay_table) {
+  // checkpoint tuples come before the records, which are replayed on them.
+  for (auto &checkpoint_tuple : replay_table.checkpoint_tuples) {
+    ReferenceSerializeInput input(checkpoint_tuple.data(),
+                                  checkpoint_tuple.size());
+    std::string key, tuple_data;
+    ParseTuple(replay_table, input, key, tuple_data);
+    replay_table.tuples[key].push_back(std::move(tuple_data));
+  }
+  replay_table.checkpoint_tuples.clear();
+  replay_table.checkpoint_tuples.shrink_to_fit();
+
+  for (auto &record : replay_table.records) {
+    std::string rest = std::move(record.tuple_data);
+    record.tuple_data.clear();
+    ReferenceSerializeInput input(rest.data(), rest.size());
+    ParseRecord(replay_table, input, record);
+  }
+  replay_table.deferred = false;
+}
+
+void LogicalLogReplayer::CollectDroppedObjects(ReplayTable &replay_table) {
+  // the key of pg_table and pg_database is the oid of the row.
+  if (replay_table.table_id != TABLE_CATALOG_OID &&
+      replay_table.table_id != DATABASE_CATALOG_OID) {
+    return;
+  }
+  PELOTON_ASSERT(replay_table.key_columns.size() == 1);
+
+  for (auto &record : replay_table.records) {
+    if (record.type != LogRecordType::TUPLE_DELETE ||
+        replay_table.tuples.count(record.old_key) > 0) {
+      continue;
+    }
+    ReferenceSerializeInput input(record.old_key.data(),
+                                  record.old_key.size());
+    oid_t oid = type::Value::DeserializeFrom(input, type::TypeId::INTEGER)
+                    .GetAs<oid_t>();
+
+    std::lock_guard<std::mutex> lock(replay_tables_lock_);
+    if (replay_table.table_id == DATABASE_CATALOG_OID) {
+      dropped_databases_.insert(oid);
+    } else {
+      dropped_tables_.insert(GetTableKey(replay_table.database_id, oid));
+    }
+  }
+}
+
+void LogicalLogReplayer::RunInstallThread(
+    std::vector<std::pair<ReplayTable *, std::string *>> *tuples) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+
+  while (true) {
+    size_t chunk_begin = next_task_.fetch_add(1) * install_chunk_size_;
+    if (chunk_begin >= tuples->size()) {
+      break;
+    }
+    size_t chunk_end = std::min(chunk_begin + install_chunk_size_,
+                                tuples->size());
+
+    type::EphemeralPool pool;
+    size_t recovered_tuple_count = 0;
+    auto txn = txn_manager.BeginTransaction();
+
+    for (size_t i = chunk_begin; i < chunk_end; ++i) {
+      auto table = tuples->at(i).first->table;
+      auto &tuple_data = *tuples->at(i).second;
+      auto schema = table->GetSchema();
+
+      storage::Tuple tuple(schema, true);
+      ReferenceSerializeInput input(tuple_data.data(), tuple_data.size());
+      oid_t column_count = schema->GetColumnCount();
+      for (oid_t column_id = 0; column_id < column_count; ++column_id) {
+        tuple.SetValue(column_id,
+                       type::Value::DeserializeFrom(
+                           input, schema->GetType(column_id), &pool),
+                       &pool);
+      }
+
+      // the indexes of the table are populated along with the tile groups.
+      ItemPointer *index_entry_ptr = nullptr;
+      ItemPointer location =
+          table->InsertTuple(&tuple, txn, &index_entry_ptr, false);
+      if (location.block == INVALID_OID) {
+        // the catalog rows that bootstrapping has inserted already.
+        if (tuples->at(i).first->is_catalog == false) {
+          LOG_ERROR("Failed to recover a tuple of table %u", table->GetOid());
+        }
+        continue;
+      }
+      txn_manager.PerformInsert(txn, location, index_entry_ptr);
+      recovered_tuple_count++;
+    }
+
+    txn_manager.CommitTransaction(txn);
+    recovered_tuple_count_ += recovered_tuple_count;
+  }
+}
+
+}  // namespace logging
+}  // namespace peloton
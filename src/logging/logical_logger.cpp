@@ -0,0 +1,245 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// logical_logger.cpp
+//
+// Identification: src/logging/logical_logger.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <chrono>
+
+#include "logging/logical_logger.h"
+
+#include "concurrency/epoch_manager_factory.h"
+#include "logging/logging_util.h"
+
+namespace peloton {
+namespace logging {
+
+void LogicalLogger::RegisterWorker(std::shared_ptr<WorkerContext> worker_ctx) {
+  worker_map_lock_.Lock();
+  // the worker cannot commit in any epoch earlier than the current one.
+  worker_ctx->persist_eid =
+      concurrency::EpochManagerFactory::GetInstance().GetCurrentEpochId() - 1;
+  worker_map_[worker_ctx->worker_id] = worker_ctx;
+  worker_map_lock_.Unlock();
+}
+
+size_t LogicalLogger::GetWorkerCount() {
+  worker_map_lock_.Lock();
+  size_t worker_count = worker_map_.size();
+  worker_map_lock_.Unlock();
+  return worker_count;
+}
+
+void LogicalLogger::Run() {
+  auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+
+  // every log file is named after the first epoch it may contain.
+  eid_t file_eid = epoch_manager.GetCurrentEpochId();
+  FileHandle file_handle;
+  if (LoggingUtil::OpenFile(GetLogFileFullPath(file_eid).c_str(), "wb",
+                            file_handle) == false) {
+    LOG_ERROR("Logger %d cannot open log file in %s", (int)logger_id_,
+              log_dir_.c_str());
+    return;
+  }
+  bool file_empty = true;
+  auto last_file_time = std::chrono::steady_clock::now();
+
+  eid_t last_global_eid = INVALID_EID;
+
+  while (true) {
+    // read the flag before collecting, so that the last round drains
+    // everything the workers wrote before logging was stopped.
+    bool is_running = is_running_;
+
+    eid_t current_global_eid = epoch_manager.GetCurrentEpochId();
+    if (is_running == true && current_global_eid == last_global_eid) {
+      // no epoch has been closed since the last round.
+      std::this_thread::sleep_for(std::chrono::microseconds(sleep_period_us_));
+      continue;
+    }
+    last_global_eid = current_global_eid;
+
+    if (is_running == false) {
+      // workers are idle now, the current epoch can be closed as well.
+      current_global_eid++;
+    }
+
+    auto flush_begin = std::chrono::steady_clock::now();
+
+    std::map<eid_t, std::vector<std::pair<std::shared_ptr<WorkerContext>,
+                                          std::unique_ptr<LogBuffer>>>>
+        epoch_buffers;
+    eid_t min_persist_eid = CollectBuffers(current_global_eid, epoch_buffers);
+
+    for (auto &epoch_entry : epoch_buffers) {
+      PersistEpochBegin(file_handle, epoch_entry.first);
+      for (auto &buffer_entry : epoch_entry.second) {
+        PersistLogBuffer(file_handle, buffer_entry.second);
+        // only the logger returns buffers to a worker's pool.
+        ReturnBuffer(*buffer_entry.first, std::move(buffer_entry.second));
+      }
+      PersistEpochEnd(file_handle, epoch_entry.first);
+    }
+
+    if (epoch_buffers.empty() == false) {
+      // group commit: one sync for every epoch collected in this round.
+      LoggingUtil::FFlushFsync(file_handle);
+      file_empty = false;
+
+      flush_time_us_ = std::chrono::duration_cast<std::chrono::microseconds>(
+                           std::chrono::steady_clock::now() - flush_begin)
+                           .count();
+    }
+
+    if (min_persist_eid > persist_epoch_id_) {
+      persist_epoch_id_ = min_persist_eid;
+    }
+
+    if (is_running == false) {
+      break;
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    if (file_empty == false &&
+        now - last_file_time > std::chrono::milliseconds(new_file_interval_)) {
+      // every epoch written from now on is larger than the persisted one.
+      LoggingUtil::CloseFile(file_handle);
+      file_eid = persist_epoch_id_ + 1;
+      if (LoggingUtil::OpenFile(GetLogFileFullPath(file_eid).c_str(), "wb",
+                                file_handle) == false) {
+        LOG_ERROR("Logger %d cannot open log file in %s", (int)logger_id_,
+                  log_dir_.c_str());
+        return;
+      }
+      file_empty = true;
+      last_file_time = now;
+    }
+  }
+
+  LoggingUtil::CloseFile(file_handle);
+}
+
+eid_t LogicalLogger::CollectBuffers(
+    const eid_t current_global_eid,
+    std::map<eid_t, std::vector<std::pair<std::shared_ptr<WorkerContext>,
+                                          std::unique_ptr<LogBuffer>>>> &
+        epoch_buffers) {
+  // without any worker, every epoch before the current one is durable.
+  eid_t min_persist_eid = current_global_eid - 1;
+
+  worker_map_lock_.Lock();
+
+  auto worker_itr = worker_map_.begin();
+  while (worker_itr != worker_map_.end()) {
+    auto &worker_ctx = worker_itr->second;
+
+    // an idle worker can only commit in the current epoch or a later one.
+    eid_t worker_current_eid =
+        std::min(worker_ctx->current_commit_eid.load(), current_global_eid);
+
+    worker_ctx->epoch_buffers_lock.Lock();
+    auto epoch_itr = worker_ctx->epoch_buffers.begin();
+    while (epoch_itr != worker_ctx->epoch_buffers.end() &&
+           epoch_itr->first < worker_current_eid) {
+      for (auto &buffer : epoch_itr->second) {
+        if (buffer->Empty() == true) {
+          ReturnBuffer(*worker_ctx, std::move(buffer));
+        } else {
+          epoch_buffers[epoch_itr->first].emplace_back(worker_ctx,
+                                                       std::move(buffer));
+        }
+      }
+      epoch_itr = worker_ctx->epoch_buffers.erase(epoch_itr);
+    }
+    bool buffers_collected = worker_ctx->epoch_buffers.empty();
+    worker_ctx->epoch_buffers_lock.Unlock();
+
+    if (worker_current_eid - 1 > worker_ctx->persist_eid) {
+      worker_ctx->persist_eid = worker_current_eid - 1;
+    }
+
+    if (worker_ctx->persist_eid < min_persist_eid) {
+      min_persist_eid = worker_ctx->persist_eid;
+    }
+
+    // the thread of this worker has exited and everything it wrote has been
+    // collected.
+    if (worker_ctx->terminated == true && buffers_collected == true) {
+      worker_itr = worker_map_.erase(worker_itr);
+    } else {
+      ++worker_itr;
+    }
+  }
+
+  worker_map_lock_.Unlock();
+
+  return min_persist_eid;
+}
+
+void LogicalLogger::ReturnBuffer(WorkerContext &worker_ctx,
+                                 std::unique_ptr<LogBuffer> log_buffer) {
+  auto &buffer_pool = worker_ctx.buffer_pool;
+  // buffers that an oversized epoch spilled beyond the pool are dropped.
+  if (buffer_pool.GetEmptySlotCount() < buffer_pool.GetMaxSlotCount()) {
+    buffer_pool.PutBuffer(std::move(log_buffer));
+  }
+}
+
+void LogicalLogger::PersistEpochBegin(FileHandle &file_handle,
+                                      const eid_t epoch_id) {
+  // Write down the epoch begin record
+  logger_output_buffer_.Reset();
+
+  size_t start = logger_output_buffer_.Position();
+  logger_output_buffer_.WriteInt(0);
+  logger_output_buffer_.WriteEnumInSingleByte(
+      static_cast<int>(LogRecordType::EPOCH_BEGIN));
+  logger_output_buffer_.WriteLong((int64_t)epoch_id);
+
+  // Add the frame length
+  logger_output_buffer_.WriteIntAt(
+      start, (int32_t)(logger_output_buffer_.Position() - start -
+                       sizeof(int32_t)));
+
+  fwrite((const void *)(logger_output_buffer_.Data()),
+         logger_output_buffer_.Size(), 1, file_handle.file);
+}
+
+void LogicalLogger::PersistEpochEnd(FileHandle &file_handle,
+                                    const eid_t epoch_id) {
+  // Write down the epoch end record
+  logger_output_buffer_.Reset();
+
+  size_t start = logger_output_buffer_.Position();
+  logger_output_buffer_.WriteInt(0);
+  logger_output_buffer_.WriteEnumInSingleByte(
+      static_cast<int>(LogRecordType::EPOCH_END));
+  logger_output_buffer_.WriteLong((int64_t)epoch_id);
+
+  // Add the frame length
+  logger_output_buffer_.WriteIntAt(
+      start, (int32_t)(logger_output_buffer_.Position() - start -
+                       sizeof(int32_t)));
+
+  fwrite((const void *)(logger_output_buffer_.Data()),
+         logger_output_buffer_.Size(), 1, file_handle.file);
+}
+
+void LogicalLogger::PersistLogBuffer(FileHandle &file_handle,
+                                     std::unique_ptr<LogBuffer> &log_buffer) {
+  fwrite((const void *)(log_buffer->GetData()), log_buffer->GetSize(), 1,
+         file_handle.file);
+
+  // the buffer is ready to be reused by its worker.
+  log_buffer->Reset();
+}
+
+}  // namespace logging
+}  // namespace peloton
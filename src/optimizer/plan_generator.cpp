@@ -18,6 +18,8 @@
 #include "codegen/type/type.h"
 #include "concurrency/transaction_context.h"
 #include "expression/expression_util.h"
+#include "expression/tuple_value_expression.h"
+#include "index/index.h"
 #include "optimizer/operator_expression.h"
 #include "optimizer/properties.h"
 #include "planner/aggregate_plan.h"
@@ -122,14 +124,33 @@ void PlanGenerator::Visit(const PhysicalIndexScan *op) {
 
   vector<expression::AbstractExpression *> runtime_keys;
 
+  // The scan is index-only if the index stores every column that it reads
+  auto *data_table = storage::StorageManager::GetInstance()->GetTableWithOid(
+      op->table_->GetDatabaseOid(), op->table_->GetTableOid());
+  auto index = data_table->GetIndexWithOid(op->index_id);
+  vector<oid_t> read_column_ids(column_ids);
+  if (predicate != nullptr) {
+    ExprSet predicate_columns;
+    expression::ExpressionUtil::GetTupleValueExprs(predicate_columns,
+                                                   predicate.get());
+    for (auto *column : predicate_columns) {
+      read_column_ids.push_back(
+          static_cast<expression::TupleValueExpression *>(column)
+              ->GetColumnId());
+    }
+  }
+  bool index_only = !column_ids.empty() && !op->is_for_update &&
+                    index->GetMetadata()->CoversColumns(read_column_ids);
+
   // Create index scan desc
   planner::IndexScanPlan::IndexScanDesc index_scan_desc(
       op->index_id, op->key_column_id_list, op->expr_type_list, op->value_list,
       runtime_keys);
-  output_plan_.reset(new planner::IndexScanPlan(
-      storage::StorageManager::GetInstance()->GetTableWithOid(
-          op->table_->GetDatabaseOid(), op->table_->GetTableOid()),
-      predicate.release(), column_ids, index_scan_desc, false));
+  auto *index_scan_plan =
+      new planner::IndexScanPlan(data_table, predicate.release(), column_ids,
+                                 index_scan_desc, false);
+  index_scan_plan->SetIndexOnly(index_only);
+  output_plan_.reset(index_scan_plan);
 }
 
 void PlanGenerator::Visit(const ExternalFileScan *op) {
@@ -326,11 +347,21 @@ void PlanGenerator::Visit(const PhysicalInnerHashJoin *op) {
   unique_ptr<planner::HashPlan> hash_plan(new planner::HashPlan(hash_keys));
   hash_plan->AddChild(move(children_plans_[1]));
 
-  auto join_plan = unique_ptr<planner::AbstractPlan>(new planner::HashJoinPlan(
+  auto *hash_join_plan = new planner::HashJoinPlan(
       JoinType::INNER, move(join_predicate), move(proj_info), proj_schema,
       left_keys, right_keys, settings::SettingsManager::GetBool(
-                                 settings::SettingId::hash_join_bloom_filter)));
+                                 settings::SettingId::hash_join_bloom_filter));
+
+  // Radix-partition both inputs when the build side is expected to be too
+  // large for the hash table to stay cache-resident
+  auto radix_threshold = settings::SettingsManager::GetInt(
+      settings::SettingId::hash_join_radix_partition_threshold);
+  if (radix_threshold > 0 &&
+      children_plans_[0]->GetCardinality() >= radix_threshold) {
+    hash_join_plan->SetRadixPartitionedFlag(true);
+  }
 
+  auto join_plan = unique_ptr<planner::AbstractPlan>(hash_join_plan);
   join_plan->AddChild(move(children_plans_[0]));
   join_plan->AddChild(move(hash_plan));
   output_plan_ = move(join_plan);
@@ -252,6 +252,62 @@ bool GetToIndexScan::Check(std::shared_ptr<OperatorExpression> plan,
   return index_exist;
 }
 
+// The value an index scan key is compared to. Parameters are bound when the
+// executor is initialized
+static type::Value GetIndexScanValue(
+    const expression::AbstractExpression *value_expr) {
+  if (value_expr->GetExpressionType() == ExpressionType::VALUE_CONSTANT) {
+    LOG_TRACE("Value Type: %d",
+              static_cast<int>(value_expr->GetValueType()));
+    return static_cast<const expression::ConstantValueExpression *>(
+               value_expr)->GetValue();
+  }
+  auto value = type::ValueFactory::GetParameterOffsetValue(
+      static_cast<const expression::ParameterValueExpression *>(value_expr)
+          ->GetValueIdx()).Copy();
+  LOG_TRACE("Parameter offset: %s", value.GetInfo().c_str());
+  return value;
+}
+
+// Collects the values of a disjunction of equalities on one column, e.g.
+// a = 1 OR a = 2 OR 3 = a, which is what an IN list on a is. Returns false
+// for any other shape
+static bool CollectInList(const expression::AbstractExpression *expr,
+                          std::string &col_name,
+                          std::vector<type::Value> &values) {
+  if (expr->GetExpressionType() == ExpressionType::CONJUNCTION_OR) {
+    return expr->GetChildrenSize() == 2 &&
+           CollectInList(expr->GetChild(0), col_name, values) &&
+           CollectInList(expr->GetChild(1), col_name, values);
+  }
+  if (expr->GetExpressionType() != ExpressionType::COMPARE_EQUAL) {
+    return false;
+  }
+
+  const expression::AbstractExpression *tv_expr = expr->GetChild(0);
+  const expression::AbstractExpression *value_expr = expr->GetChild(1);
+  if (value_expr->GetExpressionType() == ExpressionType::VALUE_TUPLE) {
+    std::swap(tv_expr, value_expr);
+  }
+  auto value_type = value_expr->GetExpressionType();
+  if (tv_expr->GetExpressionType() != ExpressionType::VALUE_TUPLE ||
+      (value_type != ExpressionType::VALUE_CONSTANT &&
+       value_type != ExpressionType::VALUE_PARAMETER)) {
+    return false;
+  }
+
+  std::string tv_col_name(
+      static_cast<const expression::TupleValueExpression *>(tv_expr)
+          ->GetColumnName());
+  if (col_name.empty()) {
+    col_name = tv_col_name;
+  } else if (col_name != tv_col_name) {
+    return false;
+  }
+  values.push_back(GetIndexScanValue(value_expr));
+  return true;
+}
+
 void GetToIndexScan::Transform(
     std::shared_ptr<OperatorExpression> input,
     std::vector<std::shared_ptr<OperatorExpression>> &transformed,
@@ -284,6 +340,14 @@ void GetToIndexScan::Transform(
       for (auto &index_id_object_pair : get->table->GetIndexCatalogEntries()) {
         auto &index_id = index_id_object_pair.first;
         auto &index = index_id_object_pair.second;
+        // Indexes that are still being built do not hold every tuple
+        if (index->IsValid() == false) {
+          continue;
+        }
+        // Hash indexes do not keep their keys in order
+        if (index->GetIndexType() == IndexType::HASH) {
+          continue;
+        }
         auto &index_col_ids = index->GetKeyAttrs();
         // We want to ensure that Sort(a, b, c, d, e) can fit Sort(a, b, c)
         size_t l_num_sort_columns = index_col_ids.size();
@@ -317,6 +381,22 @@ void GetToIndexScan::Transform(
     std::vector<type::Value> value_list;
     for (auto &pred : get->predicates) {
       auto expr = pred.expr.get();
+
+      // An IN list becomes one IN key per value
+      std::string in_col_name;
+      std::vector<type::Value> in_values;
+      if (expr->GetExpressionType() == ExpressionType::CONJUNCTION_OR &&
+          CollectInList(expr, in_col_name, in_values)) {
+        auto column_id =
+            get->table->GetColumnCatalogEntry(in_col_name)->GetColumnId();
+        for (auto &value : in_values) {
+          key_column_id_list.push_back(column_id);
+          expr_type_list.push_back(ExpressionType::COMPARE_IN);
+          value_list.push_back(value);
+        }
+        continue;
+      }
+
       if (expr->GetChildrenSize() != 2) continue;
       auto expr_type = expr->GetExpressionType();
       expression::AbstractExpression *tv_expr = nullptr;
@@ -353,31 +433,22 @@ void GetToIndexScan::Transform(
         auto column_id = get->table->GetColumnCatalogEntry(col_name)->GetColumnId();
         key_column_id_list.push_back(column_id);
         expr_type_list.push_back(expr_type);
-
-        if (value_expr->GetExpressionType() == ExpressionType::VALUE_CONSTANT) {
-          value_list.push_back(
-              reinterpret_cast<expression::ConstantValueExpression *>(
-                  value_expr)->GetValue());
-          LOG_TRACE("Value Type: %d",
-                    static_cast<int>(
-                        reinterpret_cast<expression::ConstantValueExpression *>(
-                            expr->GetModifiableChild(1))->GetValueType()));
-        } else {
-          value_list.push_back(
-              type::ValueFactory::GetParameterOffsetValue(
-                  reinterpret_cast<expression::ParameterValueExpression *>(
-                      value_expr)->GetValueIdx()).Copy());
-          LOG_TRACE("Parameter offset: %s",
-                    (*value_list.rbegin()).GetInfo().c_str());
-        }
+        value_list.push_back(GetIndexScanValue(value_expr));
       }
     }  // Loop predicates end
 
-    // Find match index for the predicates
+    // Find match index for the predicates. A hash index only matches if
+    // every key column is bound by an equality predicate, and is then
+    // preferred over all ordered indexes
+    std::vector<std::shared_ptr<OperatorExpression>> index_scans;
+    std::vector<std::shared_ptr<OperatorExpression>> hash_index_scans;
     auto index_objects = get->table->GetIndexCatalogEntries();
     for (auto &index_id_object_pair : index_objects) {
       auto &index_id = index_id_object_pair.first;
       auto &index_object = index_id_object_pair.second;
+      if (index_object->IsValid() == false) {
+        continue;
+      }
       std::vector<oid_t> index_key_column_id_list;
       std::vector<ExpressionType> index_expr_type_list;
       std::vector<type::Value> index_value_list;
@@ -392,16 +463,63 @@ void GetToIndexScan::Transform(
           index_value_list.push_back(value_list[offset]);
         }
       }
-      // Add transformed plan
-      if (!index_key_column_id_list.empty()) {
-        auto index_scan_op = PhysicalIndexScan::make(
-            get->get_id, get->table, get->table_alias, get->predicates,
-            get->is_for_update, index_id, index_key_column_id_list,
-            index_expr_type_list, index_value_list);
-        transformed.push_back(
-            std::make_shared<OperatorExpression>(index_scan_op));
+
+      // IN keys are only useful if every key column is bound by = or IN and
+      // by nothing else, so that the executor can probe all combinations as
+      // point keys. A column that also has an = predicate only needs that
+      // one value. Otherwise the IN keys are dropped and the IN lists are
+      // left to the predicate
+      std::unordered_set<oid_t> eq_col_set;
+      std::unordered_set<oid_t> point_col_set;
+      bool only_point_keys = true;
+      for (size_t offset = 0; offset < index_key_column_id_list.size();
+           offset++) {
+        auto col_id = index_key_column_id_list[offset];
+        if (index_expr_type_list[offset] == ExpressionType::COMPARE_EQUAL) {
+          eq_col_set.insert(col_id);
+          point_col_set.insert(col_id);
+        } else if (index_expr_type_list[offset] == ExpressionType::COMPARE_IN) {
+          point_col_set.insert(col_id);
+        } else {
+          only_point_keys = false;
+        }
       }
+      bool all_point_keys = only_point_keys && point_col_set == index_col_set;
+      for (size_t offset = 0; offset < index_key_column_id_list.size();) {
+        if (index_expr_type_list[offset] == ExpressionType::COMPARE_IN &&
+            (all_point_keys == false ||
+             eq_col_set.count(index_key_column_id_list[offset]) != 0)) {
+          index_key_column_id_list.erase(index_key_column_id_list.begin() +
+                                         offset);
+          index_expr_type_list.erase(index_expr_type_list.begin() + offset);
+          index_value_list.erase(index_value_list.begin() + offset);
+        } else {
+          offset++;
+        }
+      }
+      if (index_key_column_id_list.empty()) {
+        continue;
+      }
+
+      // A hash index only answers point keys on the whole key
+      bool is_hash_index = (index_object->GetIndexType() == IndexType::HASH);
+      if (is_hash_index && all_point_keys == false) {
+        continue;
+      }
+
+      // Add transformed plan
+      auto index_scan_op = PhysicalIndexScan::make(
+          get->get_id, get->table, get->table_alias, get->predicates,
+          get->is_for_update, index_id, index_key_column_id_list,
+          index_expr_type_list, index_value_list);
+      (is_hash_index ? hash_index_scans : index_scans)
+          .push_back(std::make_shared<OperatorExpression>(index_scan_op));
     }
+
+    auto &matched_scans =
+        hash_index_scans.empty() ? index_scans : hash_index_scans;
+    transformed.insert(transformed.end(), matched_scans.begin(),
+                       matched_scans.end());
   }
 }
 
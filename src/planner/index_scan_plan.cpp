@@ -12,6 +12,7 @@
 
 #include "planner/index_scan_plan.h"
 #include "common/internal_types.h"
+#include "common/macros.h"
 #include "expression/constant_value_expression.h"
 #include "expression/expression_util.h"
 #include "storage/data_table.h"
@@ -24,8 +25,8 @@ IndexScanPlan::IndexScanPlan(storage::DataTable *table,
                              const std::vector<oid_t> &column_ids,
                              const IndexScanDesc &index_scan_desc,
                              bool for_update_flag)
-    : index_id_(index_scan_desc.index_id),
-      column_ids_(column_ids),
+    : AbstractScan(table, predicate, column_ids, false),
+      index_id_(index_scan_desc.index_id),
       key_column_ids_(std::move(index_scan_desc.tuple_column_id_list)),
       expr_types_(std::move(index_scan_desc.expr_list)),
       values_with_params_(std::move(index_scan_desc.value_list)),
@@ -36,12 +37,6 @@ IndexScanPlan::IndexScanPlan(storage::DataTable *table,
     SetForUpdateFlag(true);
   }
 
-  SetTargetTable(table);
-
-  if (predicate != NULL) {
-    SetPredicate(predicate);
-  }
-
   // copy the value over for binding purpose
   for (auto val : values_with_params_) {
     values_.push_back(val.Copy());
@@ -94,5 +89,82 @@ void IndexScanPlan::SetParameterValues(std::vector<type::Value> *values) {
   }
 }
 
+hash_t IndexScanPlan::Hash() const {
+  auto type = GetPlanNodeType();
+  hash_t hash = HashUtil::Hash(&type);
+
+  hash = HashUtil::CombineHashes(hash, GetTable()->Hash());
+  hash = HashUtil::CombineHashes(hash, HashUtil::Hash(&index_id_));
+  if (GetPredicate() != nullptr) {
+    hash = HashUtil::CombineHashes(hash, GetPredicate()->Hash());
+  }
+
+  for (auto &column_id : GetColumnIds()) {
+    hash = HashUtil::CombineHashes(hash, HashUtil::Hash(&column_id));
+  }
+
+  // The values of the keys are bound as parameters, only the shape of the
+  // keys is part of the plan
+  for (size_t i = 0; i < key_column_ids_.size(); i++) {
+    hash = HashUtil::CombineHashes(hash, HashUtil::Hash(&key_column_ids_[i]));
+    hash = HashUtil::CombineHashes(hash, HashUtil::Hash(&expr_types_[i]));
+  }
+
+  auto is_update = IsForUpdate();
+  hash = HashUtil::CombineHashes(hash, HashUtil::Hash(&is_update));
+
+  return HashUtil::CombineHashes(hash, AbstractPlan::Hash());
+}
+
+bool IndexScanPlan::operator==(const AbstractPlan &rhs) const {
+  if (GetPlanNodeType() != rhs.GetPlanNodeType())
+    return false;
+
+  auto &other = static_cast<const planner::IndexScanPlan &>(rhs);
+  auto *table = GetTable();
+  auto *other_table = other.GetTable();
+  PELOTON_ASSERT(table && other_table);
+  if (*table != *other_table)
+    return false;
+
+  if (GetIndexId() != other.GetIndexId())
+    return false;
+
+  // Predicate
+  auto *pred = GetPredicate();
+  auto *other_pred = other.GetPredicate();
+  if ((pred == nullptr && other_pred != nullptr) ||
+      (pred != nullptr && other_pred == nullptr))
+    return false;
+  if (pred && *pred != *other_pred)
+    return false;
+
+  // Column Ids
+  if (GetColumnIds() != other.GetColumnIds())
+    return false;
+
+  // Keys
+  if (GetKeyColumnIds() != other.GetKeyColumnIds() ||
+      GetExprTypes() != other.GetExprTypes())
+    return false;
+
+  if (IsForUpdate() != other.IsForUpdate())
+    return false;
+
+  return AbstractPlan::operator==(rhs);
+}
+
+void IndexScanPlan::VisitParameters(
+    codegen::QueryParametersMap &map, std::vector<peloton::type::Value> &values,
+    const std::vector<peloton::type::Value> &values_from_user) {
+  AbstractPlan::VisitParameters(map, values, values_from_user);
+
+  auto *predicate =
+      const_cast<expression::AbstractExpression *>(GetPredicate());
+  if (predicate != nullptr) {
+    predicate->VisitParameters(map, values, values_from_user);
+  }
+}
+
 }  // namespace planner
 }  // namespace peloton
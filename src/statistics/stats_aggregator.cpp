@@ -293,6 +293,10 @@ void StatsAggregator::UpdateIndexMetrics(storage::Database *database,
     auto reads = index_access.GetReads();
     auto deletes = index_access.GetDeletes();
     auto inserts = index_access.GetInserts();
+    index_metric->SetMemoryFootprint(index->GetMemoryFootprint(),
+                                     index->GetGarbageFootprint());
+    auto memory_bytes = index_metric->GetMemoryBytes();
+    auto garbage_bytes = index_metric->GetGarbageBytes();
     // insert record into index metrics catalog
     auto index_metrics_catalog = catalog::Catalog::GetInstance()
                                      ->GetSystemCatalogs(database_oid)
@@ -304,6 +308,8 @@ void StatsAggregator::UpdateIndexMetrics(storage::Database *database,
                                               deletes,
                                               inserts,
                                               time_stamp,
+                                              memory_bytes,
+                                              garbage_bytes,
                                               pool_.get());
   }
 }
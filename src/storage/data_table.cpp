@@ -36,6 +36,7 @@
 #include "storage/tile_group_factory.h"
 #include "storage/tile_group_header.h"
 #include "storage/tuple.h"
+#include "storage/zone_map_manager.h"
 #include "tuning/clusterer.h"
 #include "tuning/sample.h"
 
@@ -95,6 +96,7 @@ DataTable::~DataTable() {
   // clean up tile groups by dropping the references in the catalog
   auto &catalog_manager = catalog::Manager::GetInstance();
   auto storage_manager = storage::StorageManager::GetInstance();
+  auto zone_map_manager = storage::ZoneMapManager::GetInstance();
   auto tile_groups_size = tile_groups_.GetSize();
   std::size_t tile_groups_itr;
 
@@ -106,6 +108,7 @@ DataTable::~DataTable() {
       LOG_TRACE("Dropping tile group : %u ", tile_group_id);
       // drop tile group in catalog
       storage_manager->DropTileGroup(tile_group_id);
+      zone_map_manager->DropZoneMap(tile_group_id);
     }
   }
 
@@ -212,13 +215,17 @@ ItemPointer DataTable::GetEmptyTupleSlot(const storage::Tuple *tuple) {
   auto &gc_manager = gc::GCManagerFactory::GetInstance();
   auto free_item_pointer = gc_manager.ReturnFreeSlot(this->table_oid);
   if (free_item_pointer.IsNull() == false) {
-    // when inserting a tuple
-    if (tuple != nullptr) {
-      auto tile_group = storage::StorageManager::GetInstance()->GetTileGroup(
-          free_item_pointer.block);
-      tile_group->CopyTuple(tuple, free_item_pointer.offset);
+    auto tile_group = storage::StorageManager::GetInstance()->GetTileGroup(
+        free_item_pointer.block);
+    // slots that were recycled before their tile group became immutable
+    // are dropped, the tile group must not change anymore.
+    if (tile_group->GetHeader()->GetImmutability() == false) {
+      // when inserting a tuple
+      if (tuple != nullptr) {
+        tile_group->CopyTuple(tuple, free_item_pointer.offset);
+      }
+      return free_item_pointer;
     }
-    return free_item_pointer;
   }
   //====================================================
 
@@ -245,6 +252,15 @@ ItemPointer DataTable::GetEmptyTupleSlot(const storage::Tuple *tuple) {
   // then create a new tile group
   if (tuple_slot == tile_group->GetAllocatedTupleCount() - 1) {
     AddDefaultTileGroup(active_tile_group_id);
+
+    // the tile group is full. if zone maps are in use, freeze it so that its
+    // zone maps can be maintained from now on.
+    auto zone_map_manager = storage::ZoneMapManager::GetInstance();
+    if (zone_map_manager->ZoneMapTableExists() &&
+        (table_oid & ~TABLE_OID_MASK) >= OID_FOR_USER_OFFSET &&
+        tile_group->GetHeader()->SetImmutability()) {
+      zone_map_manager->CreateZoneMapForFullTileGroup(tile_group.get());
+    }
   }
 
   LOG_TRACE("tile group count: %lu, tile group id: %u, address: %p",
@@ -371,6 +387,62 @@ bool DataTable::InsertTuple(const AbstractTuple *tuple, ItemPointer location,
   return true;
 }
 
+bool DataTable::InsertTuples(const std::vector<ItemPointer> &locations,
+                             concurrency::TransactionContext *transaction,
+                             std::vector<ItemPointer *> &index_entry_ptrs,
+                             bool check_fk) {
+  auto storage_manager = storage::StorageManager::GetInstance();
+  std::vector<ContainerTuple<storage::TileGroup>> container_tuples;
+  std::vector<const AbstractTuple *> tuples;
+  container_tuples.reserve(locations.size());
+  tuples.reserve(locations.size());
+  for (auto location : locations) {
+    LOG_TRACE("Location: %u, %u", location.block, location.offset);
+    // ItemPointer is packed, so its fields can not bind to a reference
+    oid_t offset = location.offset;
+    container_tuples.emplace_back(
+        storage_manager->GetTileGroup(location.block).get(), offset);
+    tuples.push_back(&container_tuples.back());
+  }
+
+  for (auto tuple : tuples) {
+    if (CheckConstraints(tuple) == false) {
+      LOG_TRACE("InsertTuples(): Constraint violated");
+      return false;
+    }
+  }
+
+  index_entry_ptrs.clear();
+  if (GetIndexCount() != 0) {
+    index_entry_ptrs.reserve(tuples.size());
+    for (auto location : locations) {
+      index_entry_ptrs.push_back(AllocateIndirection(location));
+    }
+
+    // Index checks and updates
+    if (InsertInIndexes(tuples, transaction, index_entry_ptrs) == false) {
+      LOG_TRACE("Index constraint violated");
+      index_entry_ptrs.clear();
+      return false;
+    }
+  } else {
+    index_entry_ptrs.resize(tuples.size(), nullptr);
+  }
+
+  // ForeignKey checks
+  if (check_fk) {
+    for (auto tuple : tuples) {
+      if (CheckForeignKeyConstraints(tuple, transaction) == false) {
+        LOG_TRACE("ForeignKey constraint violated");
+        return false;
+      }
+    }
+  }
+
+  IncreaseTupleCount(tuples.size());
+  return true;
+}
+
 // insert tuple into a table that is without index.
 ItemPointer DataTable::InsertTuple(const storage::Tuple *tuple) {
   ItemPointer location = GetEmptyTupleSlot(tuple);
@@ -389,24 +461,17 @@ ItemPointer DataTable::InsertTuple(const storage::Tuple *tuple) {
 }
 
 /**
- * @brief Insert a tuple into all indexes. If index is primary/unique,
- * check visibility of existing
- * index entries.
- * @warning This still doesn't guarantee serializability.
+ * @brief Allocate an indirection slot that points to the given location.
+ * Index entries of a tuple point to this slot rather than the tuple itself.
  *
- * @returns True on success, false if a visible entry exists (in case of
- *primary/unique).
+ * @returns The allocated slot.
  */
-bool DataTable::InsertInIndexes(const AbstractTuple *tuple,
-                                ItemPointer location,
-                                concurrency::TransactionContext *transaction,
-                                ItemPointer **index_entry_ptr) {
-  int index_count = GetIndexCount();
-
+ItemPointer *DataTable::AllocateIndirection(ItemPointer location) {
   size_t active_indirection_array_id =
       number_of_tuples_ % active_indirection_array_count_;
 
   size_t indirection_offset = INVALID_INDIRECTION_OFFSET;
+  ItemPointer *indirection = nullptr;
 
   while (true) {
     auto active_indirection_array =
@@ -414,19 +479,39 @@ bool DataTable::InsertInIndexes(const AbstractTuple *tuple,
     indirection_offset = active_indirection_array->AllocateIndirection();
 
     if (indirection_offset != INVALID_INDIRECTION_OFFSET) {
-      *index_entry_ptr =
+      indirection =
           active_indirection_array->GetIndirectionByOffset(indirection_offset);
       break;
     }
   }
 
-  (*index_entry_ptr)->block = location.block;
-  (*index_entry_ptr)->offset = location.offset;
+  indirection->block = location.block;
+  indirection->offset = location.offset;
 
   if (indirection_offset == INDIRECTION_ARRAY_MAX_SIZE - 1) {
     AddDefaultIndirectionArray(active_indirection_array_id);
   }
 
+  return indirection;
+}
+
+/**
+ * @brief Insert a tuple into all indexes. If index is primary/unique,
+ * check visibility of existing
+ * index entries.
+ * @warning This still doesn't guarantee serializability.
+ *
+ * @returns True on success, false if a visible entry exists (in case of
+ *primary/unique).
+ */
+bool DataTable::InsertInIndexes(const AbstractTuple *tuple,
+                                ItemPointer location,
+                                concurrency::TransactionContext *transaction,
+                                ItemPointer **index_entry_ptr) {
+  int index_count = GetIndexCount();
+
+  *index_entry_ptr = AllocateIndirection(location);
+
   auto &transaction_manager =
       concurrency::TransactionManagerFactory::GetInstance();
 
@@ -446,6 +531,13 @@ bool DataTable::InsertInIndexes(const AbstractTuple *tuple,
     std::unique_ptr<storage::Tuple> key(new storage::Tuple(index_schema, true));
     key->SetFromTuple(tuple, indexed_columns, index->GetPool());
 
+    // An index that is being built takes the entry into its side buffer.
+    // Uniqueness is checked when the buffer is merged
+    if (index->BufferInsert(key.get(), *index_entry_ptr)) {
+      success_count += 1;
+      continue;
+    }
+
     switch (index->GetIndexType()) {
       case IndexConstraintType::PRIMARY_KEY:
       case IndexConstraintType::UNIQUE: {
@@ -477,6 +569,81 @@ bool DataTable::InsertInIndexes(const AbstractTuple *tuple,
   return true;
 }
 
+/**
+ * @brief Insert a batch of tuples into all indexes. The keys of a batch are
+ * built into one buffer per index and handed to the index together, which
+ * inserts them in key order. For primary/unique indexes the keys of the batch
+ * must also be distinct.
+ *
+ * @returns True on success, false if a visible entry exists or the batch
+ * repeats a key (in case of primary/unique).
+ */
+bool DataTable::InsertInIndexes(
+    const std::vector<const AbstractTuple *> &tuples,
+    concurrency::TransactionContext *transaction,
+    const std::vector<ItemPointer *> &index_entry_ptrs) {
+  PELOTON_ASSERT(tuples.size() == index_entry_ptrs.size());
+  int index_count = GetIndexCount();
+
+  auto &transaction_manager =
+      concurrency::TransactionManagerFactory::GetInstance();
+
+  std::function<bool(const void *)> fn =
+      std::bind(&concurrency::TransactionManager::IsOccupied,
+                &transaction_manager, transaction, std::placeholders::_1);
+
+  std::vector<storage::Tuple> keys;
+  std::vector<const storage::Tuple *> batch_keys;
+  std::vector<ItemPointer *> batch_values;
+
+  // Since this is NOT protected by a lock, concurrent insert may happen.
+  for (int index_itr = index_count - 1; index_itr >= 0; --index_itr) {
+    auto index = GetIndex(index_itr);
+    if (index == nullptr) continue;
+    auto index_schema = index->GetKeySchema();
+    auto indexed_columns = index_schema->GetIndexedColumns();
+
+    // All keys of the batch live in one buffer
+    size_t key_length = index_schema->GetLength();
+    std::unique_ptr<char[]> key_data(new char[key_length * tuples.size()]());
+    keys.clear();
+    keys.reserve(tuples.size());
+    batch_keys.clear();
+    batch_values.clear();
+    for (size_t i = 0; i < tuples.size(); i++) {
+      keys.emplace_back(index_schema, key_data.get() + i * key_length);
+      keys.back().SetFromTuple(tuples[i], indexed_columns, index->GetPool());
+
+      // An index that is being built takes the entry into its side buffer.
+      // Uniqueness is checked when the buffer is merged
+      if (index->BufferInsert(&keys.back(), index_entry_ptrs[i]) == false) {
+        batch_keys.push_back(&keys.back());
+        batch_values.push_back(index_entry_ptrs[i]);
+      }
+    }
+
+    bool res = true;
+    switch (index->GetIndexType()) {
+      case IndexConstraintType::PRIMARY_KEY:
+      case IndexConstraintType::UNIQUE: {
+        res = index->InsertEntryBatch(batch_keys, batch_values, fn);
+      } break;
+
+      case IndexConstraintType::DEFAULT:
+      default:
+        index->InsertEntryBatch(batch_keys, batch_values, nullptr);
+        break;
+    }
+
+    if (res == false) {
+      return false;
+    }
+    LOG_TRACE("Index constraint check on %s passed.", index->GetName().c_str());
+  }
+
+  return true;
+}
+
 bool DataTable::InsertInSecondaryIndexes(
     const AbstractTuple *tuple, const TargetList *targets_ptr,
     concurrency::TransactionContext *transaction,
@@ -531,6 +698,10 @@ bool DataTable::InsertInSecondaryIndexes(
 
     key->SetFromTuple(tuple, indexed_columns, index->GetPool());
 
+    if (index->BufferInsert(key.get(), index_entry_ptr)) {
+      continue;
+    }
+
     switch (index->GetIndexType()) {
       case IndexConstraintType::PRIMARY_KEY:
       case IndexConstraintType::UNIQUE: {
@@ -990,6 +1161,7 @@ std::shared_ptr<storage::TileGroup> DataTable::GetTileGroupById(
 
 void DataTable::DropTileGroups() {
   auto storage_manager = storage::StorageManager::GetInstance();
+  auto zone_map_manager = storage::ZoneMapManager::GetInstance();
   auto tile_groups_size = tile_groups_.GetSize();
   std::size_t tile_groups_itr;
 
@@ -1000,6 +1172,7 @@ void DataTable::DropTileGroups() {
     if (tile_group_id != invalid_tile_group_id) {
       // drop tile group in catalog
       storage_manager->DropTileGroup(tile_group_id);
+      zone_map_manager->DropZoneMap(tile_group_id);
     }
   }
 
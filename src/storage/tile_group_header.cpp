@@ -13,6 +13,7 @@
 
 #include <iomanip>
 #include <iostream>
+#include <limits>
 #include <sstream>
 
 #include "common/container_tuple.h"
@@ -36,7 +37,9 @@ TileGroupHeader::TileGroupHeader(const BackendType &backend_type,
       tile_group(nullptr),
       num_tuple_slots(tuple_count),
       next_tuple_slot(0),
-      tile_header_lock() {
+      tile_header_lock(),
+      write_stamp(0),
+      all_visible_stamp(std::numeric_limits<uint64_t>::max()) {
   tuple_headers_.reset(new TupleHeader[tuple_count]);
 
   // Set MVCC Initial Value
@@ -12,14 +12,21 @@
 
 #include "storage/zone_map_manager.h"
 
+#include <cstring>
+#include <limits>
+
 #include "catalog/catalog.h"
+#include "catalog/schema.h"
 #include "catalog/zone_map_catalog.h"
 #include "catalog/database_catalog.h"
 #include "concurrency/transaction_context.h"
 #include "concurrency/transaction_manager_factory.h"
 #include "storage/storage_manager.h"
 #include "storage/data_table.h"
+#include "storage/tile_group.h"
+#include "storage/tile_group_header.h"
 #include "type/ephemeral_pool.h"
+#include "type/value_factory.h"
 
 namespace peloton {
 namespace storage {
@@ -89,25 +96,20 @@ void ZoneMapManager::CreateOrUpdateZoneMapForTileGroup(
 
   oid_t database_id = table->GetDatabaseOid();
   oid_t table_id = table->GetOid();
-  auto schema = table->GetSchema();
-  size_t num_columns = schema->GetColumnCount();
+  size_t num_columns = table->GetSchema()->GetColumnCount();
   auto tile_group = table->GetTileGroup(tile_group_idx);
 
+  std::shared_ptr<ZoneMap> zone_map;
+  {
+    std::lock_guard<std::mutex> lock(zone_map_lock_);
+    zone_map = BuildZoneMap(tile_group.get());
+    // Scans that are running keep the zone map they have looked up.
+    zone_maps_.Upsert(tile_group->GetTileGroupId(), zone_map);
+  }
+
   for (oid_t col_itr = 0; col_itr < num_columns; col_itr++) {
-    // Set temp min and temp max as the first value.
-    type::Value min = tile_group->GetValue(0, col_itr);
-    type::Value max = tile_group->GetValue(0, col_itr);
-    // Iterate over all tuples in this column
-    oid_t num_tuple_slots = tile_group->GetAllocatedTupleCount();
-    for (oid_t tuple_itr = 0; tuple_itr < num_tuple_slots; tuple_itr++) {
-      type::Value current_val = tile_group->GetValue(tuple_itr, col_itr);
-      if (current_val.CompareGreaterThan(max) == CmpBool::CmpTrue) {
-        max = current_val;
-      }
-      if (current_val.CompareLessThan(min) == CmpBool::CmpTrue) {
-        min = current_val;
-      }
-    }
+    const type::Value &min = zone_map->stats[col_itr].min;
+    const type::Value &max = zone_map->stats[col_itr].max;
     type::TypeId val_type = min.GetTypeId();
     std::string converted_min = min.ToString();
     std::string converted_max = max.ToString();
@@ -119,6 +121,200 @@ void ZoneMapManager::CreateOrUpdateZoneMapForTileGroup(
   }
 }
 
+/**
+ * @brief The function creates the zone maps of a tile group that has just
+ * been filled up and made immutable. No slot of the tile group is handed out
+ * anymore, so the zone maps only need to be widened by the versions that
+ * are still being written, which WidenZoneMap does when they commit. The
+ * zone maps are only kept in memory.
+ *
+ * @param tile_group The tile group
+ */
+void ZoneMapManager::CreateZoneMapForFullTileGroup(
+    storage::TileGroup *tile_group) {
+  PELOTON_ASSERT(tile_group->GetHeader()->GetImmutability() == true);
+  std::lock_guard<std::mutex> lock(zone_map_lock_);
+  zone_maps_.Upsert(tile_group->GetTileGroupId(), BuildZoneMap(tile_group));
+}
+
+/**
+ * @brief The function widens the zone maps of a tile group so that they
+ * cover the given version. It must be called for every version written into
+ * an immutable tile group before the version becomes visible.
+ *
+ * @param location The location of the version
+ */
+void ZoneMapManager::WidenZoneMap(const ItemPointer &location) {
+  auto tile_group =
+      storage::StorageManager::GetInstance()->GetTileGroup(location.block);
+  if (tile_group == nullptr) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(zone_map_lock_);
+  std::shared_ptr<const ZoneMap> zone_map;
+  if (!zone_maps_.Find(location.block, zone_map)) {
+    // It is created from the current contents of the tile group.
+    return;
+  }
+
+  std::shared_ptr<ZoneMap> widened_zone_map(new ZoneMap(*zone_map));
+  bool changed = false;
+  oid_t num_columns = static_cast<oid_t>(zone_map->stats.size());
+  for (oid_t col_itr = 0; col_itr < num_columns; col_itr++) {
+    changed |= AddValue(*widened_zone_map, col_itr,
+                        tile_group->GetValue(location.offset, col_itr));
+  }
+  if (changed) {
+    zone_maps_.Upsert(location.block, widened_zone_map);
+  }
+}
+
+/**
+ * @brief The function drops the zone maps of a tile group.
+ *
+ * @param tile_group_id The ID of the tile group
+ */
+void ZoneMapManager::DropZoneMap(oid_t tile_group_id) {
+  std::lock_guard<std::mutex> lock(zone_map_lock_);
+  zone_maps_.Erase(tile_group_id);
+}
+
+/**
+ * @brief The function computes the zone maps of every column of a tile group
+ * from every version in it.
+ *
+ * @param tile_group The tile group
+ *
+ * @return  The zone maps of the tile group
+ */
+std::shared_ptr<ZoneMap> ZoneMapManager::BuildZoneMap(
+    storage::TileGroup *tile_group) {
+  auto schema = tile_group->GetAbstractTable()->GetSchema();
+  oid_t num_columns = schema->GetColumnCount();
+
+  std::shared_ptr<ZoneMap> zone_map(new ZoneMap());
+  zone_map->stats.reserve(num_columns);
+  zone_map->raw_stats.reserve(num_columns);
+  for (oid_t col_itr = 0; col_itr < num_columns; col_itr++) {
+    type::Value null_value =
+        type::ValueFactory::GetNullValueByType(schema->GetType(col_itr));
+    zone_map->stats.push_back({null_value, null_value});
+
+    RawColumnStatistics raw_stats;
+    raw_stats.min_integer = std::numeric_limits<int64_t>::max();
+    raw_stats.max_integer = std::numeric_limits<int64_t>::min();
+    raw_stats.min_decimal = std::numeric_limits<double>::infinity();
+    raw_stats.max_decimal = -std::numeric_limits<double>::infinity();
+    raw_stats.null_count = 0;
+    zone_map->raw_stats.push_back(raw_stats);
+  }
+
+  oid_t num_tuple_slots = tile_group->GetAllocatedTupleCount();
+  for (oid_t tuple_itr = 0; tuple_itr < num_tuple_slots; tuple_itr++) {
+    for (oid_t col_itr = 0; col_itr < num_columns; col_itr++) {
+      AddValue(*zone_map, col_itr, tile_group->GetValue(tuple_itr, col_itr));
+    }
+  }
+  return zone_map;
+}
+
+bool ZoneMapManager::AddValue(ZoneMap &zone_map, oid_t column_id,
+                              const type::Value &value) {
+  RawColumnStatistics &raw_stats = zone_map.raw_stats[column_id];
+  if (value.IsNull()) {
+    raw_stats.null_count++;
+    return true;
+  }
+
+  // NULLs are skipped, since no comparison with them is ever true. The
+  // values may point into the tile group, so keep copies of them.
+  bool changed = false;
+  ColumnStatistics &stats = zone_map.stats[column_id];
+  if (stats.min.IsNull() ||
+      value.CompareLessThan(stats.min) == CmpBool::CmpTrue) {
+    stats.min = value.Copy();
+    changed = true;
+  }
+  if (stats.max.IsNull() ||
+      value.CompareGreaterThan(stats.max) == CmpBool::CmpTrue) {
+    stats.max = value.Copy();
+    changed = true;
+  }
+  if (!changed) {
+    return false;
+  }
+
+  type::TypeId column_type = value.GetTypeId();
+  if (!IsRawComparable(column_type, column_type)) {
+    return true;
+  }
+  if (column_type == type::TypeId::DECIMAL) {
+    double decimal = value.GetAs<double>();
+    raw_stats.min_decimal = std::min(raw_stats.min_decimal, decimal);
+    raw_stats.max_decimal = std::max(raw_stats.max_decimal, decimal);
+    return true;
+  }
+
+  int64_t integer;
+  switch (column_type) {
+    case type::TypeId::TINYINT:
+      integer = value.GetAs<int8_t>();
+      break;
+    case type::TypeId::SMALLINT:
+      integer = value.GetAs<int16_t>();
+      break;
+    case type::TypeId::INTEGER:
+      integer = value.GetAs<int32_t>();
+      break;
+    case type::TypeId::DATE:
+      integer = value.GetAs<uint32_t>();
+      break;
+    case type::TypeId::TIMESTAMP:
+      integer = value.GetAs<uint64_t>();
+      break;
+    default:
+      integer = value.GetAs<int64_t>();
+      break;
+  }
+  raw_stats.min_integer = std::min(raw_stats.min_integer, integer);
+  raw_stats.max_integer = std::max(raw_stats.max_integer, integer);
+  raw_stats.min_decimal = static_cast<double>(raw_stats.min_integer);
+  raw_stats.max_decimal = static_cast<double>(raw_stats.max_integer);
+  return true;
+}
+
+/**
+ * Checks whether a predicate on a column can be evaluated against the raw
+ * zone map of the column. Numeric types can be compared with each other,
+ * dates and timestamps only with their own type.
+ *
+ * @param column_type The type of the column
+ * @param predicate_type The type of the predicate value
+ *
+ * @return  True if the raw zone map can be used
+ */
+bool ZoneMapManager::IsRawComparable(type::TypeId column_type,
+                                     type::TypeId predicate_type) {
+  auto is_numeric = [](type::TypeId type_id) {
+    switch (type_id) {
+      case type::TypeId::TINYINT:
+      case type::TypeId::SMALLINT:
+      case type::TypeId::INTEGER:
+      case type::TypeId::BIGINT:
+      case type::TypeId::DECIMAL:
+        return true;
+      default:
+        return false;
+    }
+  };
+  if (column_type == type::TypeId::DATE ||
+      column_type == type::TypeId::TIMESTAMP) {
+    return predicate_type == column_type;
+  }
+  return is_numeric(column_type) && is_numeric(predicate_type);
+}
+
 /**
  * @brief The function inserts the catalog keys and values in the zone map table
  * present in catalog
@@ -217,9 +413,46 @@ ZoneMapManager::GetResultVectorAsZoneMap(
            GetValueAsOriginal(max_varchar, type_varchar)}));
 }
 
+/**
+ * Looks up the zone maps of a tile group.
+ *
+ * @param tile_group_id The ID of the tile group
+ *
+ * @return  The zone maps of the tile group, or nullptr if there are none
+ */
+std::shared_ptr<const ZoneMap> ZoneMapManager::GetZoneMap(
+    oid_t tile_group_id) const {
+  std::shared_ptr<const ZoneMap> zone_map;
+  if (!zone_maps_.Find(tile_group_id, zone_map)) {
+    return nullptr;
+  }
+  return zone_map;
+}
+
+/**
+ * Copies the raw zone maps of every column of a tile group into the given
+ * array. This is what generated scans call, they compare the raw values
+ * themselves.
+ *
+ * @param tile_group_id The ID of the tile group
+ * @param[out] raw_stats An array with an entry for every column
+ *
+ * @return  True if the tile group has zone maps
+ */
+bool ZoneMapManager::GetRawZoneMap(oid_t tile_group_id,
+                                   RawColumnStatistics *raw_stats) {
+  auto zone_map = GetZoneMap(tile_group_id);
+  if (zone_map == nullptr) {
+    return false;
+  }
+  std::memcpy(raw_stats, zone_map->raw_stats.data(),
+              zone_map->raw_stats.size() * sizeof(RawColumnStatistics));
+  return true;
+}
+
 /**
  * The function compares the predicate against the zone map for the column
- * present in catalog.
+ * kept in memory.
  *
  * @param parsed predicates array
  * @param num_predicates
@@ -231,44 +464,50 @@ ZoneMapManager::GetResultVectorAsZoneMap(
 bool ZoneMapManager::ShouldScanTileGroup(
     storage::PredicateInfo *parsed_predicates, int32_t num_predicates,
     storage::DataTable *table, int64_t tile_group_idx) {
+  if (num_predicates == 0) {
+    return true;
+  }
+
+  auto tile_group = table->GetTileGroup(tile_group_idx);
+  if (tile_group == nullptr) {
+    return true;
+  }
+  auto zone_map = GetZoneMap(tile_group->GetTileGroupId());
+  if (zone_map == nullptr) {
+    return true;
+  }
+
   for (int32_t i = 0; i < num_predicates; i++) {
     // Extract the col_id, operator and predicate_value
     int col_id = parsed_predicates[i].col_id;
     int comparison_operator = parsed_predicates[i].comparison_operator;
-    type::Value predicate_value = parsed_predicates[i].predicate_value;
+    const type::Value &predicate_value = parsed_predicates[i].predicate_value;
 
-    oid_t database_id = table->GetDatabaseOid();
-    oid_t table_id = table->GetOid();
+    const ColumnStatistics *stats = &zone_map->stats[col_id];
 
-    std::unique_ptr<ZoneMapManager::ColumnStatistics> stats =
-        GetZoneMapFromCatalog(database_id, table_id, tile_group_idx, col_id);
-
-    if (stats == nullptr) {
-      return true;
-    }
     switch (comparison_operator) {
       case (int)ExpressionType::COMPARE_EQUAL:
-        if (!CheckEqual(predicate_value, stats.get())) {
+        if (!CheckEqual(predicate_value, stats)) {
           return false;
         }
         break;
       case (int)ExpressionType::COMPARE_LESSTHAN:
-        if (!CheckLessThan(predicate_value, stats.get())) {
+        if (!CheckLessThan(predicate_value, stats)) {
           return false;
         }
         break;
       case (int)ExpressionType::COMPARE_LESSTHANOREQUALTO:
-        if (!CheckLessThanEquals(predicate_value, stats.get())) {
+        if (!CheckLessThanEquals(predicate_value, stats)) {
           return false;
         }
         break;
       case (int)ExpressionType::COMPARE_GREATERTHAN:
-        if (!CheckGreaterThan(predicate_value, stats.get())) {
+        if (!CheckGreaterThan(predicate_value, stats)) {
           return false;
         }
         break;
       case (int)ExpressionType::COMPARE_GREATERTHANOREQUALTO:
-        if (!CheckGreaterThanEquals(predicate_value, stats.get())) {
+        if (!CheckGreaterThanEquals(predicate_value, stats)) {
           return false;
         }
         break;
@@ -27,39 +27,41 @@ namespace type {
 Value ArrayType::GetElementAt(const Value &val, uint64_t idx) const {
   switch (val.GetElementType()) {
     case TypeId::BOOLEAN: {
-      std::vector<bool> vec = *(std::vector<bool> *)(val.value_.array);
+      const std::vector<bool> &vec = *(std::vector<bool> *)(val.value_.array);
       return ValueFactory::GetBooleanValue(vec.at(idx));
     }
     case TypeId::TINYINT: {
-      std::vector<int8_t> vec = *(std::vector<int8_t> *)(val.value_.array);
+      const std::vector<int8_t> &vec =
+          *(std::vector<int8_t> *)(val.value_.array);
       return ValueFactory::GetTinyIntValue((int8_t)vec.at(idx));
     }
     case TypeId::SMALLINT: {
-      std::vector<int16_t> vec =
+      const std::vector<int16_t> &vec =
           *(std::vector<int16_t> *)(val.value_.array);
       return ValueFactory::GetSmallIntValue((int16_t)vec.at(idx));
     }
     case TypeId::INTEGER: {
-      std::vector<int32_t> vec =
+      const std::vector<int32_t> &vec =
           *(std::vector<int32_t> *)(val.value_.array);
       return ValueFactory::GetIntegerValue((int32_t)vec.at(idx));
     }
     case TypeId::BIGINT: {
-      std::vector<int64_t> vec =
+      const std::vector<int64_t> &vec =
           *(std::vector<int64_t> *)(val.value_.array);
       return ValueFactory::GetBigIntValue((int64_t)vec.at(idx));
     }
     case TypeId::DECIMAL: {
-      std::vector<double> vec = *(std::vector<double> *)(val.value_.array);
+      const std::vector<double> &vec =
+          *(std::vector<double> *)(val.value_.array);
       return ValueFactory::GetDecimalValue((double)vec.at(idx));
     }
     case TypeId::TIMESTAMP: {
-      std::vector<uint64_t> vec =
+      const std::vector<uint64_t> &vec =
           *(std::vector<uint64_t> *)(val.value_.array);
       return ValueFactory::GetTimestampValue((uint64_t)vec.at(idx));
     }
     case TypeId::VARCHAR: {
-      std::vector<std::string> vec =
+      const std::vector<std::string> &vec =
           *(std::vector<std::string> *)(val.value_.array);
       return ValueFactory::GetVarcharValue(vec.at(idx));
     }
@@ -69,6 +71,31 @@ Value ArrayType::GetElementAt(const Value &val, uint64_t idx) const {
   throw Exception(ExceptionType::UNKNOWN_TYPE, "Element type is invalid.");
 }
 
+// Get the number of elements in this array
+uint64_t ArrayType::GetElementCount(const Value &val) const {
+  switch (val.GetElementType()) {
+    case TypeId::BOOLEAN:
+      return ((std::vector<bool> *)(val.value_.array))->size();
+    case TypeId::TINYINT:
+      return ((std::vector<int8_t> *)(val.value_.array))->size();
+    case TypeId::SMALLINT:
+      return ((std::vector<int16_t> *)(val.value_.array))->size();
+    case TypeId::INTEGER:
+      return ((std::vector<int32_t> *)(val.value_.array))->size();
+    case TypeId::BIGINT:
+      return ((std::vector<int64_t> *)(val.value_.array))->size();
+    case TypeId::DECIMAL:
+      return ((std::vector<double> *)(val.value_.array))->size();
+    case TypeId::TIMESTAMP:
+      return ((std::vector<uint64_t> *)(val.value_.array))->size();
+    case TypeId::VARCHAR:
+      return ((std::vector<std::string> *)(val.value_.array))->size();
+    default:
+      break;
+  }
+  throw Exception(ExceptionType::UNKNOWN_TYPE, "Element type is invalid.");
+}
+
 // Does this value exist in this array?
 Value ArrayType::InList(const Value &list, const Value &object) const {
   Value ele = (list.GetElementAt(0));
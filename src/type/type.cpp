@@ -403,6 +403,14 @@ TypeId Type::GetElementType(const Value& val UNUSED_ATTRIBUTE) const {
   return type_id_;
 }
 
+// Get the number of elements in this array
+uint64_t Type::GetElementCount(const Value& val UNUSED_ATTRIBUTE) const {
+  std::string msg =
+      StringUtil::Format("GetElementCount not implemented for type '%s'",
+                         TypeIdToString(type_id_).c_str());
+  throw peloton::NotImplementedException(msg);
+}
+
 // Does this value exist in this array?
 Value Type::InList(const Value& list UNUSED_ATTRIBUTE,
                    const Value& object UNUSED_ATTRIBUTE) const {
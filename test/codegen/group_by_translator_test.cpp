@@ -455,5 +455,147 @@ TEST_F(GroupByTranslatorTest, MinAndMax) {
               CmpBool::CmpTrue);
 }
 
+TEST_F(GroupByTranslatorTest, ParallelGroupingWithSum) {
+  //
+  // SELECT a, SUM(b), COUNT(*) FROM table GROUP BY a;
+  //
+  // The input is scanned in parallel. Each thread aggregates into its own
+  // partitioned hash table, which are then merged into the global one.
+  //
+
+  LOG_INFO("Query: SELECT a, SUM(b), COUNT(*) FROM table1 GROUP BY a;");
+
+  // 1) Set up projection (just a direct map)
+  DirectMapList direct_map_list = {{0, {0, 0}}, {1, {1, 0}}, {2, {1, 1}}};
+  std::unique_ptr<planner::ProjectInfo> proj_info{
+      new planner::ProjectInfo(TargetList{}, std::move(direct_map_list))};
+
+  // 2) Setup SUM() on column 'b' and COUNT(*)
+  auto *b_col =
+      new expression::TupleValueExpression(type::TypeId::INTEGER, 0, 1);
+  auto *tve_expr =
+      new expression::TupleValueExpression(type::TypeId::INTEGER, 0, 0);
+  std::vector<planner::AggregatePlan::AggTerm> agg_terms = {
+      {ExpressionType::AGGREGATE_SUM, b_col},
+      {ExpressionType::AGGREGATE_COUNT_STAR, tve_expr}};
+
+  // 3) The grouping column
+  std::vector<oid_t> gb_cols = {0};
+
+  // 4) The output schema
+  std::shared_ptr<const catalog::Schema> output_schema{
+      new catalog::Schema({{type::TypeId::INTEGER, 4, "COL_A"},
+                           {type::TypeId::BIGINT, 8, "SUM_B"},
+                           {type::TypeId::BIGINT, 8, "COUNT_*"}})};
+
+  // 5) Finally, the aggregation node
+  std::unique_ptr<planner::AbstractPlan> agg_plan{new planner::AggregatePlan(
+      std::move(proj_info), nullptr, std::move(agg_terms), std::move(gb_cols),
+      output_schema, AggregateType::HASH)};
+
+  // 6) The parallel scan that feeds the aggregation
+  std::unique_ptr<planner::AbstractPlan> scan_plan{new planner::SeqScanPlan(
+      &GetTestTable(TestTableId()), nullptr, {0, 1}, true)};
+
+  agg_plan->AddChild(std::move(scan_plan));
+
+  // Do binding
+  planner::BindingContext context;
+  agg_plan->PerformBinding(context);
+
+  // We collect the results of the query into an in-memory buffer
+  codegen::BufferingConsumer buffer{{0, 1, 2}, context};
+
+  // Compile and run
+  CompileAndExecute(*agg_plan, buffer);
+
+  // Check results
+  const auto &results = buffer.GetOutputTuples();
+  EXPECT_EQ(10, results.size());
+
+  // The grouping column is unique, so SUM(b) = a + 1 and COUNT(*) = 1
+  type::Value const_one = type::ValueFactory::GetBigIntValue(1);
+  for (const auto &tuple : results) {
+    auto a = tuple.GetValue(0).GetAs<int32_t>();
+    EXPECT_TRUE(tuple.GetValue(1).CompareEquals(
+                    type::ValueFactory::GetBigIntValue(a + 1)) ==
+                CmpBool::CmpTrue);
+    EXPECT_TRUE(tuple.GetValue(2).CompareEquals(const_one) ==
+                CmpBool::CmpTrue);
+  }
+}
+
+TEST_F(GroupByTranslatorTest, ParallelMinMaxAndCount) {
+  //
+  // SELECT MAX(a), MIN(b), COUNT(*) FROM table;
+  //
+  // The input is scanned in parallel. Each thread aggregates into its own
+  // buffer, which are then merged into the global one.
+  //
+
+  LOG_INFO("Query: SELECT MAX(a), MIN(b), COUNT(*) FROM table1;");
+
+  // 1) Set up projection (just a direct map)
+  DirectMapList direct_map_list = {{0, {1, 0}}, {1, {1, 1}}, {2, {1, 2}}};
+  std::unique_ptr<planner::ProjectInfo> proj_info{
+      new planner::ProjectInfo(TargetList{}, std::move(direct_map_list))};
+
+  // 2) Setup MAX() on column 'a', MIN() on 'b' and COUNT(*)
+  auto *a_col =
+      new expression::TupleValueExpression(type::TypeId::INTEGER, 0, 0);
+  auto *b_col =
+      new expression::TupleValueExpression(type::TypeId::INTEGER, 0, 1);
+  auto *tve_expr =
+      new expression::TupleValueExpression(type::TypeId::INTEGER, 0, 0);
+  std::vector<planner::AggregatePlan::AggTerm> agg_terms = {
+      {ExpressionType::AGGREGATE_MAX, a_col},
+      {ExpressionType::AGGREGATE_MIN, b_col},
+      {ExpressionType::AGGREGATE_COUNT_STAR, tve_expr}};
+
+  // 3) No grouping
+  std::vector<oid_t> gb_cols = {};
+
+  // 4) The output schema
+  std::shared_ptr<const catalog::Schema> output_schema{
+      new catalog::Schema({{type::TypeId::INTEGER, 4, "MAX_A"},
+                           {type::TypeId::INTEGER, 4, "MIN_B"},
+                           {type::TypeId::BIGINT, 8, "COUNT_*"}})};
+
+  // 5) Finally, the aggregation node
+  std::unique_ptr<planner::AbstractPlan> agg_plan{new planner::AggregatePlan(
+      std::move(proj_info), nullptr, std::move(agg_terms), std::move(gb_cols),
+      output_schema, AggregateType::HASH)};
+
+  // 6) The parallel scan that feeds the aggregation
+  std::unique_ptr<planner::AbstractPlan> scan_plan{new planner::SeqScanPlan(
+      &GetTestTable(TestTableId()), nullptr, {0, 1}, true)};
+
+  agg_plan->AddChild(std::move(scan_plan));
+
+  // Do binding
+  planner::BindingContext context;
+  agg_plan->PerformBinding(context);
+
+  // We collect the results of the query into an in-memory buffer
+  codegen::BufferingConsumer buffer{{0, 1, 2}, context};
+
+  // Compile it all
+  CompileAndExecute(*agg_plan, buffer);
+
+  // There should only be a single output row, with the same values as the
+  // serial aggregation
+  const auto &results = buffer.GetOutputTuples();
+  ASSERT_EQ(1, results.size());
+  EXPECT_TRUE(results[0].GetValue(0).CompareEquals(
+                  type::ValueFactory::GetBigIntValue(90)) ==
+              CmpBool::CmpTrue);
+  EXPECT_TRUE(results[0].GetValue(1).CompareEquals(
+                  type::ValueFactory::GetBigIntValue(1)) ==
+              CmpBool::CmpTrue);
+  EXPECT_TRUE(results[0].GetValue(2).CompareEquals(
+                  type::ValueFactory::GetBigIntValue(10)) ==
+              CmpBool::CmpTrue);
+}
+
 }  // namespace test
 }  // namespace peloton
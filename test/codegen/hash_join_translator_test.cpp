@@ -19,6 +19,7 @@
 #include "planner/hash_join_plan.h"
 #include "planner/hash_plan.h"
 #include "planner/seq_scan_plan.h"
+#include "settings/settings_manager.h"
 
 #include "codegen/testing_codegen_util.h"
 
@@ -127,5 +128,166 @@ TEST_F(HashJoinTranslatorTest, SingleHashJoinColumnTest) {
   }
 }
 
+TEST_F(HashJoinTranslatorTest, RadixPartitionedHashJoinTest) {
+  //
+  // SELECT
+  //   left_table.a, right_table.a, left_table.b, right_table.c,
+  // FROM
+  //   left_table
+  // JOIN
+  //   right_table ON left_table.a = right_table.a
+  //
+  // The join is radix-partitioned and both inputs are scanned in parallel
+  //
+
+  // Projection:  [left_table.a, right_table.a, left_table.b, right_table.c]
+  DirectMap dm1 = std::make_pair(0, std::make_pair(0, 0));
+  DirectMap dm2 = std::make_pair(1, std::make_pair(1, 0));
+  DirectMap dm3 = std::make_pair(2, std::make_pair(0, 1));
+  DirectMap dm4 = std::make_pair(3, std::make_pair(1, 2));
+  DirectMapList direct_map_list = {dm1, dm2, dm3, dm4};
+  std::unique_ptr<planner::ProjectInfo> projection{
+      new planner::ProjectInfo(TargetList{}, std::move(direct_map_list))};
+
+  // Output schema
+  auto schema = std::shared_ptr<const catalog::Schema>(
+      new catalog::Schema({TestingExecutorUtil::GetColumnInfo(0),
+                           TestingExecutorUtil::GetColumnInfo(0),
+                           TestingExecutorUtil::GetColumnInfo(1),
+                           TestingExecutorUtil::GetColumnInfo(2)}));
+
+  // Left and right hash keys
+  std::vector<ConstExpressionPtr> left_hash_keys;
+  left_hash_keys.emplace_back(ColRefExpr(type::TypeId::INTEGER, 0));
+
+  std::vector<ConstExpressionPtr> right_hash_keys;
+  right_hash_keys.emplace_back(ColRefExpr(type::TypeId::INTEGER, 0));
+
+  std::vector<ConstExpressionPtr> hash_keys;
+  hash_keys.emplace_back(ColRefExpr(type::TypeId::INTEGER, 0));
+
+  std::unique_ptr<planner::HashJoinPlan> hj_plan{
+      new planner::HashJoinPlan(JoinType::INNER, nullptr, std::move(projection),
+                                schema, left_hash_keys, right_hash_keys)};
+  hj_plan->SetRadixPartitionedFlag(true);
+  std::unique_ptr<planner::HashPlan> hash_plan{
+      new planner::HashPlan(hash_keys)};
+
+  std::unique_ptr<planner::AbstractPlan> left_scan{new planner::SeqScanPlan(
+      &GetLeftTable(), nullptr, {0, 1, 2}, true)};
+  std::unique_ptr<planner::AbstractPlan> right_scan{new planner::SeqScanPlan(
+      &GetRightTable(), nullptr, {0, 1, 2}, true)};
+
+  hash_plan->AddChild(std::move(right_scan));
+  hj_plan->AddChild(std::move(left_scan));
+  hj_plan->AddChild(std::move(hash_plan));
+
+  // Do binding
+  planner::BindingContext context;
+  hj_plan->PerformBinding(context);
+
+  // We collect the results of the query into an in-memory buffer
+  codegen::BufferingConsumer buffer{{0, 1, 2, 3}, context};
+
+  // COMPILE and run
+  CompileAndExecute(*hj_plan, buffer);
+
+  // Check results
+  const auto &results = buffer.GetOutputTuples();
+  // The left table has 20 rows, the right has 80, all of the left ones match
+  EXPECT_EQ(20, results.size());
+  for (const auto &tuple : results) {
+    // Check that the joins keys are actually equal
+    EXPECT_EQ(CmpBool::CmpTrue,
+              tuple.GetValue(0).CompareEquals(tuple.GetValue(1)));
+
+    // Check that the build-side attribute belongs to the matching row
+    EXPECT_EQ(tuple.GetValue(0).GetAs<int32_t>() + 1,
+              tuple.GetValue(2).GetAs<int32_t>());
+  }
+}
+
+TEST_F(HashJoinTranslatorTest, PrefetchingHashJoinTest) {
+  //
+  // SELECT
+  //   left_table.a, right_table.a, left_table.b, right_table.c,
+  // FROM
+  //   left_table
+  // JOIN
+  //   right_table ON left_table.a = right_table.a
+  //
+  // The probes into the hash table are group-prefetched
+  //
+
+  settings::SettingsManager::SetBool(
+      settings::SettingId::codegen_hash_join_prefetch, true);
+
+  // Projection:  [left_table.a, right_table.a, left_table.b, right_table.c]
+  DirectMap dm1 = std::make_pair(0, std::make_pair(0, 0));
+  DirectMap dm2 = std::make_pair(1, std::make_pair(1, 0));
+  DirectMap dm3 = std::make_pair(2, std::make_pair(0, 1));
+  DirectMap dm4 = std::make_pair(3, std::make_pair(1, 2));
+  DirectMapList direct_map_list = {dm1, dm2, dm3, dm4};
+  std::unique_ptr<planner::ProjectInfo> projection{
+      new planner::ProjectInfo(TargetList{}, std::move(direct_map_list))};
+
+  // Output schema
+  auto schema = std::shared_ptr<const catalog::Schema>(
+      new catalog::Schema({TestingExecutorUtil::GetColumnInfo(0),
+                           TestingExecutorUtil::GetColumnInfo(0),
+                           TestingExecutorUtil::GetColumnInfo(1),
+                           TestingExecutorUtil::GetColumnInfo(2)}));
+
+  // Left and right hash keys
+  std::vector<ConstExpressionPtr> left_hash_keys;
+  left_hash_keys.emplace_back(ColRefExpr(type::TypeId::INTEGER, 0));
+
+  std::vector<ConstExpressionPtr> right_hash_keys;
+  right_hash_keys.emplace_back(ColRefExpr(type::TypeId::INTEGER, 0));
+
+  std::vector<ConstExpressionPtr> hash_keys;
+  hash_keys.emplace_back(ColRefExpr(type::TypeId::INTEGER, 0));
+
+  std::unique_ptr<planner::HashJoinPlan> hj_plan{
+      new planner::HashJoinPlan(JoinType::INNER, nullptr, std::move(projection),
+                                schema, left_hash_keys, right_hash_keys)};
+  std::unique_ptr<planner::HashPlan> hash_plan{
+      new planner::HashPlan(hash_keys)};
+
+  std::unique_ptr<planner::AbstractPlan> left_scan{
+      new planner::SeqScanPlan(&GetLeftTable(), nullptr, {0, 1, 2})};
+  std::unique_ptr<planner::AbstractPlan> right_scan{
+      new planner::SeqScanPlan(&GetRightTable(), nullptr, {0, 1, 2})};
+
+  hash_plan->AddChild(std::move(right_scan));
+  hj_plan->AddChild(std::move(left_scan));
+  hj_plan->AddChild(std::move(hash_plan));
+
+  // Do binding
+  planner::BindingContext context;
+  hj_plan->PerformBinding(context);
+
+  // We collect the results of the query into an in-memory buffer
+  codegen::BufferingConsumer buffer{{0, 1, 2, 3}, context};
+
+  // COMPILE and run
+  CompileAndExecute(*hj_plan, buffer);
+
+  settings::SettingsManager::SetBool(
+      settings::SettingId::codegen_hash_join_prefetch, false);
+
+  // Check results
+  const auto &results = buffer.GetOutputTuples();
+  // The left table has 20 rows, the right has 80, all of the left ones match
+  EXPECT_EQ(20, results.size());
+  for (const auto &tuple : results) {
+    // Check that the joins keys are actually equal
+    EXPECT_EQ(CmpBool::CmpTrue,
+              tuple.GetValue(0).CompareEquals(tuple.GetValue(1)));
+    EXPECT_EQ(tuple.GetValue(0).GetAs<int32_t>() + 1,
+              tuple.GetValue(2).GetAs<int32_t>());
+  }
+}
+
 }  // namespace test
 }  // namespace peloton
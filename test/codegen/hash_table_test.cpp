@@ -42,6 +42,17 @@ struct Key {
     return h1 ^ (h2 + 0x9e3779b9 + (h1 << 6) + (h1 >> 2));
   }
 
+  // A hash whose high bits are well-mixed, as needed by partitioned tables
+  uint64_t PartitionHash() const {
+    uint64_t h = Hash();
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdLLU;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53LLU;
+    h ^= h >> 33;
+    return h;
+  }
+
   friend std::ostream &operator<<(std::ostream &os, const Key &k) {
     os << "Key[" << k.k1 << "," << k.k2 << "]";
     return os;
@@ -314,5 +325,131 @@ TEST_F(HashTableTest, ParallelMerge) {
   }
 }
 
+TEST_F(HashTableTest, PartitionedBuildAndProbe) {
+  codegen::util::HashTable build_table{GetMemPool(), sizeof(Key),
+                                       sizeof(Value)};
+  codegen::util::HashTable probe_table{GetMemPool(), sizeof(Key),
+                                       sizeof(Value)};
+
+  constexpr uint32_t to_insert = 50000;
+  constexpr uint32_t c1 = 4444;
+  constexpr uint32_t max_dups = 4;
+
+  std::vector<Key> keys;
+
+  // Insert keys, some of them duplicated
+  uint32_t num_inserts = 0;
+  for (uint32_t i = 0; i < to_insert; i++) {
+    uint32_t num_dups = 1 + (rand() % max_dups);
+    Key k{num_dups, i};
+    for (uint32_t dup = 0; dup < num_dups; dup++) {
+      Value v = {.v1 = k.k2, .v2 = 2, .v3 = 3, .v4 = c1};
+      build_table.TypedInsertLazy(k.PartitionHash(), k, v);
+      num_inserts++;
+    }
+    Value v = {.v1 = k.k2, .v2 = 0, .v3 = 0, .v4 = 0};
+    probe_table.TypedInsertLazy(k.PartitionHash(), k, v);
+
+    keys.emplace_back(k);
+  }
+
+  // The build side is too large to fit in cache, it should be partitioned
+  build_table.BuildPartitioned();
+  EXPECT_EQ(num_inserts, build_table.NumElements());
+  EXPECT_TRUE(build_table.IsPartitioned());
+  EXPECT_LT(1, build_table.NumPartitions());
+
+  // The probe side is partitioned exactly like the build side
+  probe_table.PartitionLazy(build_table);
+  EXPECT_EQ(to_insert, probe_table.NumElements());
+  EXPECT_EQ(build_table.NumPartitions(), probe_table.NumPartitions());
+
+  // Lookups should succeed
+  for (const auto &key : keys) {
+    uint32_t count = 0;
+    std::function<void(const Value &v)> f = [&key, &count, &c1](const Value &v) {
+      EXPECT_EQ(key.k2, v.v1)
+          << "Value's [v1] found in table doesn't match insert key";
+      EXPECT_EQ(c1, v.v4) << "Value's [v4] doesn't match constant";
+      count++;
+    };
+    build_table.TypedProbe(key.PartitionHash(), key, f);
+    EXPECT_EQ(key.k1, count) << key << " found " << count << " dups ...";
+  }
+}
+
+TEST_F(HashTableTest, ParallelPartitionedBuild) {
+  constexpr uint32_t num_threads = 4;
+  constexpr uint32_t to_insert = 20000;
+
+  // Allocate hash tables for each thread
+  executor::ExecutorContext exec_ctx{nullptr};
+
+  auto &thread_states = exec_ctx.GetThreadStates();
+  thread_states.Reset(sizeof(codegen::util::HashTable));
+  thread_states.Allocate(num_threads);
+
+  // The keys we insert
+  std::mutex keys_mutex;
+  std::vector<Key> keys;
+
+  // The global hash table
+  codegen::util::HashTable global_table{*exec_ctx.GetPool(), sizeof(Key),
+                                        sizeof(Value)};
+
+  auto add_key = [&keys_mutex, &keys](const Key &k) {
+    std::lock_guard<std::mutex> lock{keys_mutex};
+    keys.emplace_back(k);
+  };
+
+  // Insert function
+  auto insert_fn = [&add_key, &exec_ctx](uint64_t tid) {
+    auto *table = reinterpret_cast<codegen::util::HashTable *>(
+        exec_ctx.GetThreadStates().AccessThreadState(tid));
+    codegen::util::HashTable::Init(*table, exec_ctx, sizeof(Key),
+                                   sizeof(Value));
+
+    // Insert keys disjoint from other threads
+    for (uint32_t i = tid * to_insert, end = i + to_insert; i != end; i++) {
+      Key k{static_cast<uint32_t>(tid), i};
+      Value v = {.v1 = k.k2, .v2 = k.k1, .v3 = 3, .v4 = 4444};
+      table->TypedInsertLazy(k.PartitionHash(), k, v);
+
+      add_key(k);
+    }
+  };
+
+  // First insert into thread local tables in parallel
+  LaunchParallelTest(num_threads, insert_fn);
+
+  // Partition and build the global table from the thread-local tables
+  global_table.BuildPartitionedParallel(thread_states, 0);
+
+  // Clean up local tables, they should've been emptied
+  for (uint32_t tid = 0; tid < num_threads; tid++) {
+    auto *table = reinterpret_cast<codegen::util::HashTable *>(
+        thread_states.AccessThreadState(tid));
+    EXPECT_EQ(0, table->NumElements());
+    codegen::util::HashTable::Destroy(*table);
+  }
+
+  // Now probe global
+  EXPECT_EQ(to_insert * num_threads, global_table.NumElements());
+  EXPECT_TRUE(global_table.IsPartitioned());
+  for (const auto &key : keys) {
+    uint32_t count = 0;
+    std::function<void(const Value &v)> f = [&key, &count](const Value &v) {
+      EXPECT_EQ(key.k2, v.v1)
+          << "Value's [v1] found in table doesn't match insert key";
+      EXPECT_EQ(key.k1, v.v2) << "Key " << key << " inserted by thread "
+                              << key.k1 << " but value was inserted by thread "
+                              << v.v2;
+      count++;
+    };
+    global_table.TypedProbe(key.PartitionHash(), key, f);
+    EXPECT_EQ(1, count) << "Found duplicate keys in unique key test";
+  }
+}
+
 }  // namespace test
 }  // namespace peloton
\ No newline at end of file
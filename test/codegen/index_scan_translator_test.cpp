@@ -0,0 +1,192 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// index_scan_translator_test.cpp
+//
+// Identification: test/codegen/index_scan_translator_test.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "catalog/schema.h"
+#include "codegen/query_cache.h"
+#include "codegen/query_compiler.h"
+#include "expression/conjunction_expression.h"
+#include "index/index_factory.h"
+#include "planner/index_scan_plan.h"
+#include "storage/data_table.h"
+#include "type/value_factory.h"
+
+#include "codegen/testing_codegen_util.h"
+
+namespace peloton {
+namespace test {
+
+class IndexScanTranslatorTest : public PelotonCodeGenTest {
+ public:
+  IndexScanTranslatorTest() : PelotonCodeGenTest(), num_rows_to_insert(64) {
+    // Index column a of the test table before loading it
+    auto &table = GetTestTable(TestTableId());
+    auto *tuple_schema = table.GetSchema();
+    std::vector<oid_t> key_attrs = {0};
+    auto *key_schema = catalog::Schema::CopySchema(tuple_schema, key_attrs);
+    key_schema->SetIndexedColumns(key_attrs);
+
+    auto *index_metadata = new index::IndexMetadata(
+        "index_scan_test_index", IndexOid(), table.GetOid(),
+        table.GetDatabaseOid(), IndexType::BWTREE,
+        IndexConstraintType::DEFAULT, tuple_schema, key_schema, key_attrs,
+        false);
+    std::shared_ptr<index::Index> index(
+        index::IndexFactory::GetIndex(index_metadata));
+    table.AddIndex(index);
+
+    LoadTestTable(TestTableId(), num_rows_to_insert);
+  }
+
+  oid_t TestTableId() const { return test_table_oids[0]; }
+
+  oid_t IndexOid() const { return 1234; }
+
+  uint32_t NumRowsInTestTable() const { return num_rows_to_insert; }
+
+  // SELECT a, b FROM table WHERE <predicate>, where the index is probed using
+  // the given keys on column a
+  std::shared_ptr<planner::IndexScanPlan> IndexScan(
+      ExpressionPtr &&predicate, const std::vector<ExpressionType> &expr_types,
+      const std::vector<int32_t> &keys) {
+    std::vector<oid_t> key_column_ids;
+    std::vector<type::Value> values;
+    for (auto key : keys) {
+      key_column_ids.push_back(0);
+      values.push_back(type::ValueFactory::GetIntegerValue(key));
+    }
+    planner::IndexScanPlan::IndexScanDesc index_scan_desc(
+        IndexOid(), key_column_ids, expr_types, values, {});
+    return std::make_shared<planner::IndexScanPlan>(
+        &GetTestTable(TestTableId()), predicate.release(),
+        std::vector<oid_t>{0, 1}, index_scan_desc);
+  }
+
+ private:
+  uint32_t num_rows_to_insert = 64;
+};
+
+TEST_F(IndexScanTranslatorTest, PointLookup) {
+  //
+  // SELECT a, b FROM table where a = 200;
+  //
+
+  auto a_eq_200 =
+      CmpEqExpr(ColRefExpr(type::TypeId::INTEGER, 0), ConstIntExpr(200));
+  auto scan = IndexScan(std::move(a_eq_200), {ExpressionType::COMPARE_EQUAL},
+                        {200});
+  EXPECT_TRUE(codegen::QueryCompiler::IsSupported(*scan));
+
+  // Do binding
+  planner::BindingContext context;
+  scan->PerformBinding(context);
+
+  // Printing consumer
+  codegen::BufferingConsumer buffer{{0, 1}, context};
+
+  // COMPILE and execute
+  CompileAndExecute(*scan, buffer);
+
+  // Check output results
+  const auto &results = buffer.GetOutputTuples();
+  ASSERT_EQ(1, results.size());
+  EXPECT_EQ(CmpBool::CmpTrue, results[0].GetValue(0).CompareEquals(
+                                  type::ValueFactory::GetIntegerValue(200)));
+  EXPECT_EQ(CmpBool::CmpTrue, results[0].GetValue(1).CompareEquals(
+                                  type::ValueFactory::GetIntegerValue(201)));
+}
+
+TEST_F(IndexScanTranslatorTest, RangeScanWithPredicate) {
+  //
+  // SELECT a, b FROM table where a >= 100 AND a < 300 AND b > 150;
+  //
+
+  auto a_gte_100 =
+      CmpGteExpr(ColRefExpr(type::TypeId::INTEGER, 0), ConstIntExpr(100));
+  auto a_lt_300 =
+      CmpLtExpr(ColRefExpr(type::TypeId::INTEGER, 0), ConstIntExpr(300));
+  auto b_gt_150 =
+      CmpGtExpr(ColRefExpr(type::TypeId::INTEGER, 1), ConstIntExpr(150));
+  auto *a_range = new expression::ConjunctionExpression(
+      ExpressionType::CONJUNCTION_AND, a_gte_100.release(),
+      a_lt_300.release());
+  ExpressionPtr predicate{new expression::ConjunctionExpression(
+      ExpressionType::CONJUNCTION_AND, a_range, b_gt_150.release())};
+
+  auto scan = IndexScan(std::move(predicate),
+                        {ExpressionType::COMPARE_GREATERTHANOREQUALTO,
+                         ExpressionType::COMPARE_LESSTHAN},
+                        {100, 300});
+
+  // Do binding
+  planner::BindingContext context;
+  scan->PerformBinding(context);
+
+  // Printing consumer
+  codegen::BufferingConsumer buffer{{0, 1}, context};
+
+  // COMPILE and execute
+  CompileAndExecute(*scan, buffer);
+
+  // The rows with a in [160, 290], in index order
+  const auto &results = buffer.GetOutputTuples();
+  ASSERT_EQ(14, results.size());
+  for (uint32_t i = 0; i < results.size(); i++) {
+    int32_t a = 160 + 10 * i;
+    EXPECT_EQ(CmpBool::CmpTrue, results[i].GetValue(0).CompareEquals(
+                                    type::ValueFactory::GetIntegerValue(a)));
+  }
+}
+
+TEST_F(IndexScanTranslatorTest, ReuseCompiledLookup) {
+  //
+  // SELECT a, b FROM table where a = 40;
+  // SELECT a, b FROM table where a = 520;
+  //
+
+  auto scan_a = IndexScan(
+      CmpEqExpr(ColRefExpr(type::TypeId::INTEGER, 0), ConstIntExpr(40)),
+      {ExpressionType::COMPARE_EQUAL}, {40});
+  auto scan_b = IndexScan(
+      CmpEqExpr(ColRefExpr(type::TypeId::INTEGER, 0), ConstIntExpr(520)),
+      {ExpressionType::COMPARE_EQUAL}, {520});
+
+  // The keys are parameters, both lookups share the compiled query
+  EXPECT_EQ(scan_a->Hash(), scan_b->Hash());
+  EXPECT_TRUE(*scan_a == *scan_b);
+
+  planner::BindingContext context_a;
+  scan_a->PerformBinding(context_a);
+  planner::BindingContext context_b;
+  scan_b->PerformBinding(context_b);
+
+  codegen::QueryCache::Instance().Clear();
+
+  bool cached;
+  codegen::BufferingConsumer buffer_a{{0, 1}, context_a};
+  CompileAndExecuteCache(scan_a, buffer_a, cached);
+  EXPECT_FALSE(cached);
+  const auto &results_a = buffer_a.GetOutputTuples();
+  ASSERT_EQ(1, results_a.size());
+  EXPECT_EQ(40, results_a[0].GetValue(0).GetAs<int32_t>());
+
+  codegen::BufferingConsumer buffer_b{{0, 1}, context_b};
+  CompileAndExecuteCache(scan_b, buffer_b, cached);
+  EXPECT_TRUE(cached);
+  const auto &results_b = buffer_b.GetOutputTuples();
+  ASSERT_EQ(1, results_b.size());
+  EXPECT_EQ(520, results_b[0].GetValue(0).GetAs<int32_t>());
+
+  codegen::QueryCache::Instance().Clear();
+}
+
+}  // namespace test
+}  // namespace peloton
@@ -12,6 +12,8 @@
 
 #include "codegen/query_compiler.h"
 #include "common/harness.h"
+#include "expression/tuple_value_expression.h"
+#include "planner/aggregate_plan.h"
 #include "planner/limit_plan.h"
 #include "planner/order_by_plan.h"
 #include "planner/seq_scan_plan.h"
@@ -281,5 +283,101 @@ TEST_F(OrderByTranslatorTest, OrderWithLimitAndOffset) {
       }));
 }
 
+TEST_F(OrderByTranslatorTest, ParallelSortFeedingFinalOutput) {
+  //
+  // SELECT * FROM test_table ORDER BY b;
+  //
+  // The input is scanned and sorted in parallel. The sorted output feeds the
+  // query's consumer directly, so it must be delivered in order.
+  //
+
+  uint32_t num_test_rows = 1000;
+  LoadTestTable(TestTableId(), num_test_rows);
+
+  std::unique_ptr<planner::OrderByPlan> order_by_plan{
+      new planner::OrderByPlan({1}, {false}, {0, 1, 2, 3})};
+  std::unique_ptr<planner::SeqScanPlan> seq_scan_plan{new planner::SeqScanPlan(
+      &GetTestTable(TestTableId()), nullptr, {0, 1, 2, 3}, true)};
+
+  order_by_plan->AddChild(std::move(seq_scan_plan));
+
+  // Do binding
+  planner::BindingContext context;
+  order_by_plan->PerformBinding(context);
+
+  // We collect the results of the query into an in-memory buffer
+  codegen::BufferingConsumer buffer{{0, 1}, context};
+
+  // COMPILE and execute
+  CompileAndExecute(*order_by_plan, buffer);
+
+  // The results should be sorted in ascending order
+  auto &results = buffer.GetOutputTuples();
+  EXPECT_EQ(num_test_rows, results.size());
+  EXPECT_TRUE(std::is_sorted(
+      results.begin(), results.end(),
+      [](const codegen::WrappedTuple &t1, const codegen::WrappedTuple &t2) {
+        auto is_lt = t1.GetValue(1).CompareLessThan(t2.GetValue(1));
+        return is_lt == CmpBool::CmpTrue;
+      }));
+}
+
+TEST_F(OrderByTranslatorTest, ParallelScanOfSortedOutput) {
+  //
+  // SELECT COUNT(*), SUM(a) FROM (SELECT * FROM test_table ORDER BY b);
+  //
+  // The sorted output feeds an aggregation rather than the query's consumer,
+  // so the sorted tuples are scanned in parallel.
+  //
+
+  uint32_t num_test_rows = 1000;
+  LoadTestTable(TestTableId(), num_test_rows);
+
+  std::unique_ptr<planner::OrderByPlan> order_by_plan{
+      new planner::OrderByPlan({1}, {false}, {0, 1, 2, 3})};
+  std::unique_ptr<planner::SeqScanPlan> seq_scan_plan{new planner::SeqScanPlan(
+      &GetTestTable(TestTableId()), nullptr, {0, 1, 2, 3}, true)};
+  order_by_plan->AddChild(std::move(seq_scan_plan));
+
+  // The aggregation on top of the sort
+  DirectMapList direct_map_list = {{0, {1, 0}}, {1, {1, 1}}};
+  std::unique_ptr<planner::ProjectInfo> proj_info{
+      new planner::ProjectInfo(TargetList{}, std::move(direct_map_list))};
+  std::vector<planner::AggregatePlan::AggTerm> agg_terms = {
+      {ExpressionType::AGGREGATE_COUNT_STAR,
+       new expression::TupleValueExpression(type::TypeId::INTEGER, 0, 0)},
+      {ExpressionType::AGGREGATE_SUM,
+       new expression::TupleValueExpression(type::TypeId::INTEGER, 0, 0)}};
+  std::shared_ptr<const catalog::Schema> output_schema{
+      new catalog::Schema({{type::TypeId::BIGINT, 8, "COUNT_*"},
+                           {type::TypeId::BIGINT, 8, "SUM_A"}})};
+  std::unique_ptr<planner::AbstractPlan> agg_plan{new planner::AggregatePlan(
+      std::move(proj_info), nullptr, std::move(agg_terms), {}, output_schema,
+      AggregateType::HASH)};
+  agg_plan->AddChild(std::move(order_by_plan));
+
+  // Do binding
+  planner::BindingContext context;
+  agg_plan->PerformBinding(context);
+
+  // We collect the results of the query into an in-memory buffer
+  codegen::BufferingConsumer buffer{{0, 1}, context};
+
+  // COMPILE and execute
+  CompileAndExecute(*agg_plan, buffer);
+
+  // Every sorted tuple is seen exactly once. The values of column 'a' are
+  // 10 * i, so SUM(a) = 10 * (n - 1) * n / 2.
+  auto &results = buffer.GetOutputTuples();
+  ASSERT_EQ(1, results.size());
+  EXPECT_EQ(CmpBool::CmpTrue,
+            results[0].GetValue(0).CompareEquals(
+                type::ValueFactory::GetBigIntValue(num_test_rows)));
+  int64_t expected_sum = 10 * (num_test_rows - 1) * num_test_rows / 2;
+  EXPECT_EQ(CmpBool::CmpTrue,
+            results[0].GetValue(1).CompareEquals(
+                type::ValueFactory::GetBigIntValue(expected_sum)));
+}
+
 }  // namespace test
 }  // namespace peloton
\ No newline at end of file
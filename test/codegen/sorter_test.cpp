@@ -11,6 +11,7 @@
 //===----------------------------------------------------------------------===//
 
 #include <cstdlib>
+#include <mutex>
 #include <random>
 
 #include "common/harness.h"
@@ -174,6 +175,76 @@ TEST_F(SorterTest, ParallelSortTest) {
   }
 }
 
+// The state shared by all tasks of a parallel scan over a sorted sorter
+struct ScanState {
+  std::mutex mutex;
+  std::vector<std::pair<uint64_t, uint64_t>> ranges;
+};
+
+// The scan function for parallel scans. Records the range each task scans.
+static void RecordScanRange(void *query_state,
+                            UNUSED_ATTRIBUTE void *thread_state, uint64_t start,
+                            uint64_t end) {
+  auto *scan_state = reinterpret_cast<ScanState *>(query_state);
+  std::lock_guard<std::mutex> lock(scan_state->mutex);
+  scan_state->ranges.emplace_back(start, end);
+}
+
+TEST_F(SorterTest, ParallelSortAndScanWithEmptyRuns) {
+  uint32_t num_threads = 4;
+
+  // Allocate sorters for fake threads
+  auto &thread_states = ExecCtx().GetThreadStates();
+  thread_states.Reset(sizeof(codegen::util::Sorter));
+  thread_states.Allocate(num_threads);
+
+  // Only load every other sorter, the rest stay empty
+  uint32_t ntuples_per_sorter = 10000;
+  for (uint32_t i = 0; i < num_threads; i++) {
+    auto *sorter = reinterpret_cast<codegen::util::Sorter *>(
+        thread_states.AccessThreadState(i));
+    codegen::util::Sorter::Init(*sorter, ExecCtx(), CompareTuplesForAscending,
+                                sizeof(TestTuple));
+    if (i % 2 == 0) {
+      LoadSorter(*sorter, ntuples_per_sorter);
+    }
+  }
+
+  codegen::util::Sorter main_sorter{Pool(), CompareTuplesForAscending,
+                                    sizeof(TestTuple)};
+  main_sorter.SortParallel(thread_states, 0);
+
+  // Check main sorter is sorted and holds all tuples
+  CheckSorted(main_sorter, true);
+  uint64_t num_tuples = (num_threads / 2) * ntuples_per_sorter;
+  EXPECT_EQ(num_tuples, main_sorter.NumTuples());
+
+  for (uint32_t i = 0; i < num_threads; i++) {
+    auto *sorter = reinterpret_cast<codegen::util::Sorter *>(
+        thread_states.AccessThreadState(i));
+    codegen::util::Sorter::Destroy(*sorter);
+  }
+
+  // Scan the sorted result in parallel
+  ScanState scan_state;
+  thread_states.Reset(sizeof(uint64_t));
+  codegen::util::Sorter::ScanParallel(
+      &scan_state, thread_states, main_sorter,
+      reinterpret_cast<void *>(RecordScanRange));
+
+  // The scanned ranges must cover all tuples exactly once
+  auto &ranges = scan_state.ranges;
+  ASSERT_FALSE(ranges.empty());
+  std::sort(ranges.begin(), ranges.end());
+  uint64_t next_start = 0;
+  for (const auto &range : ranges) {
+    EXPECT_EQ(next_start, range.first);
+    EXPECT_LE(range.first, range.second);
+    next_start = range.second;
+  }
+  EXPECT_EQ(num_tuples, next_start);
+}
+
 TEST_F(SorterTest, SortForTopK) {
   auto test = [this](uint64_t num_inserts, uint64_t top_k) {
     // The sorter
@@ -12,6 +12,7 @@
 
 #include "storage/storage_manager.h"
 #include "catalog/catalog.h"
+#include "codegen/query_cache.h"
 #include "codegen/query_compiler.h"
 #include "common/harness.h"
 #include "concurrency/transaction_manager_factory.h"
@@ -150,5 +151,38 @@ TEST_F(ZoneMapScanTest, ScanwithConjunctionPredicate) {
   EXPECT_EQ(CmpBool::CmpTrue, results[0].GetValue(1).CompareEquals(
                                      type::ValueFactory::GetIntegerValue(21)));
 }
+
+TEST_F(ZoneMapScanTest, CachedScanWithDifferentConstants) {
+  auto &table = GetTestTable(TestTableId());
+  auto make_scan = [this, &table](int64_t val) {
+    // SELECT a, b, c FROM table where a >= val;
+    ExpressionPtr a_gte =
+        CmpGteExpr(ColRefExpr(type::TypeId::INTEGER, 0), ConstIntExpr(val));
+    return std::make_shared<planner::SeqScanPlan>(
+        &table, a_gte.release(), std::vector<oid_t>{0, 1, 2});
+  };
+
+  // The first scan prunes every tile group but the last
+  std::shared_ptr<planner::SeqScanPlan> scan_1 = make_scan(150);
+  planner::BindingContext context_1;
+  scan_1->PerformBinding(context_1);
+  codegen::BufferingConsumer buffer_1{{0, 1, 2}, context_1};
+  bool cached;
+  CompileAndExecuteCache(scan_1, buffer_1, cached);
+  EXPECT_FALSE(cached);
+  EXPECT_EQ(NumRowsInTestTable() - 15, buffer_1.GetOutputTuples().size());
+
+  // The second scan reuses the compiled query, and must prune with its own
+  // constant
+  std::shared_ptr<planner::SeqScanPlan> scan_2 = make_scan(20);
+  planner::BindingContext context_2;
+  scan_2->PerformBinding(context_2);
+  codegen::BufferingConsumer buffer_2{{0, 1, 2}, context_2};
+  CompileAndExecuteCache(scan_2, buffer_2, cached);
+  EXPECT_TRUE(cached);
+  EXPECT_EQ(NumRowsInTestTable() - 2, buffer_2.GetOutputTuples().size());
+
+  codegen::QueryCache::Instance().Clear();
+}
+}
 }
-}
\ No newline at end of file
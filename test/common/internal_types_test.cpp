@@ -511,7 +511,8 @@ TEST_F(InternalTypesTests, GarbageCollectionTypeTest) {
 TEST_F(InternalTypesTests, ProtocolTypeTest) {
   std::vector<ProtocolType> list = {
       ProtocolType::INVALID, 
-      ProtocolType::TIMESTAMP_ORDERING
+      ProtocolType::TIMESTAMP_ORDERING,
+      ProtocolType::OPTIMISTIC
   };
 
   // Make sure that ToString and FromString work
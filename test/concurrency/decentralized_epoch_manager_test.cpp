@@ -12,8 +12,10 @@
 
 
 #include "concurrency/epoch_manager_factory.h"
+#include "concurrency/decentralized_epoch_manager.h"
 #include "concurrency/testing_transaction_util.h"
 #include "common/harness.h"
+#include "settings/settings_manager.h"
 
 namespace peloton {
 namespace test {
@@ -137,6 +139,86 @@ TEST_F(DecentralizedEpochManagerTests, MultipleThreadsTest) {
 }
 
 
+TEST_F(DecentralizedEpochManagerTests, EpochStatisticsTest) {
+  auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+  epoch_manager.Reset();
+
+  epoch_manager.SetCurrentEpochId(2);
+  epoch_manager.RegisterThread(1);
+
+  // two transactions at epoch 2, one at epoch 4.
+  cid_t txn_id1 = epoch_manager.EnterEpoch(0, TimestampType::READ);
+  cid_t txn_id2 = epoch_manager.EnterEpoch(1, TimestampType::READ);
+  epoch_manager.SetCurrentEpochId(4);
+  cid_t txn_id3 = epoch_manager.EnterEpoch(1, TimestampType::READ);
+
+  EXPECT_EQ(3, epoch_manager.GetActiveTransactionCount());
+
+  // the transactions at epoch 2 hold back the expired epoch.
+  EXPECT_EQ(1, epoch_manager.GetExpiredEpochId());
+  EXPECT_EQ(3, epoch_manager.GetEpochLag());
+
+  epoch_manager.ExitEpoch(0, txn_id1 >> 32);
+  epoch_manager.ExitEpoch(1, txn_id2 >> 32);
+
+  EXPECT_EQ(1, epoch_manager.GetActiveTransactionCount());
+  EXPECT_EQ(3, epoch_manager.GetExpiredEpochId());
+  EXPECT_EQ(1, epoch_manager.GetEpochLag());
+
+  epoch_manager.ExitEpoch(1, txn_id3 >> 32);
+  EXPECT_EQ(0, epoch_manager.GetActiveTransactionCount());
+
+  epoch_manager.DeregisterThread(1);
+}
+
+TEST_F(DecentralizedEpochManagerTests, AdaptiveEpochLengthTest) {
+  auto &epoch_manager = concurrency::DecentralizedEpochManager::GetInstance();
+  epoch_manager.Reset();
+
+  uint64_t min_length =
+      settings::SettingsManager::GetInt(settings::SettingId::min_epoch_length);
+  uint64_t max_length =
+      settings::SettingsManager::GetInt(settings::SettingId::max_epoch_length);
+  uint64_t target_txn_count = settings::SettingsManager::GetInt(
+      settings::SettingId::epoch_target_txn_count);
+
+  EXPECT_EQ(EPOCH_LENGTH, epoch_manager.GetEpochLength());
+
+  // a loaded system shortens the epochs, down to the minimum length.
+  uint64_t last_length = epoch_manager.GetEpochLength();
+  epoch_manager.AdjustEpochLength(target_txn_count * 4);
+  EXPECT_LT(epoch_manager.GetEpochLength(), last_length);
+  for (int i = 0; i < 10; i++) {
+    epoch_manager.AdjustEpochLength(target_txn_count * 4);
+  }
+  EXPECT_EQ(min_length, epoch_manager.GetEpochLength());
+
+  // an idle system goes back to the maximum length.
+  epoch_manager.AdjustEpochLength(0);
+  EXPECT_EQ(max_length, epoch_manager.GetEpochLength());
+
+  // while logging, an epoch is never shorter than a group commit.
+  EXPECT_EQ(0, epoch_manager.GetPersistEpochLag());
+  epoch_manager.SetCurrentEpochId(10);
+  uint64_t flush_length = (min_length + max_length) / 2;
+  epoch_manager.ReportEpochFlush(7, flush_length * 1000);
+  EXPECT_EQ(3, epoch_manager.GetPersistEpochLag());
+  for (int i = 0; i < 10; i++) {
+    epoch_manager.AdjustEpochLength(target_txn_count * 4);
+  }
+  EXPECT_EQ(flush_length, epoch_manager.GetEpochLength());
+
+  // once logging stops, epochs may be as short as before.
+  epoch_manager.ReportEpochFlush(INVALID_EID, 0);
+  EXPECT_EQ(0, epoch_manager.GetPersistEpochLag());
+  for (int i = 0; i < 10; i++) {
+    epoch_manager.AdjustEpochLength(target_txn_count * 4);
+  }
+  EXPECT_EQ(min_length, epoch_manager.GetEpochLength());
+
+  epoch_manager.Reset();
+}
+
 }  // namespace test
 }  // namespace peloton
 
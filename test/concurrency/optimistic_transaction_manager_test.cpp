@@ -0,0 +1,111 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// optimistic_transaction_manager_test.cpp
+//
+// Identification: test/concurrency/optimistic_transaction_manager_test.cpp
+//
+// Copyright (c) 2015-18, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "concurrency/testing_transaction_util.h"
+#include "common/harness.h"
+
+namespace peloton {
+
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Optimistic TransactionContext Tests
+//===--------------------------------------------------------------------===//
+
+class OptimisticTransactionManagerTests : public PelotonTest {};
+
+// Reads are only recorded in the read write set
+TEST_F(OptimisticTransactionManagerTests, ReadTest) {
+  concurrency::TransactionManagerFactory::Configure(
+      ProtocolType::OPTIMISTIC, IsolationLevelType::SERIALIZABLE);
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  EXPECT_EQ(ProtocolType::OPTIMISTIC,
+            concurrency::TransactionManagerFactory::GetProtocol());
+
+  concurrency::EpochManagerFactory::GetInstance().Reset();
+  storage::DataTable *table = TestingTransactionUtil::CreateTable();
+
+  auto tile_group = table->GetTileGroup(0);
+  auto tile_group_header = tile_group->GetHeader();
+  ItemPointer location(tile_group->GetTileGroupId(), 0);
+  cid_t read_ts = tile_group_header->GetLastReaderCommitId(location.offset);
+
+  auto txn = txn_manager.BeginTransaction();
+  EXPECT_TRUE(
+      txn_manager.PerformRead(txn, location, tile_group_header, false));
+  EXPECT_EQ(read_ts, tile_group_header->GetLastReaderCommitId(location.offset));
+  EXPECT_EQ(RWType::READ, txn->GetRWType(location));
+  EXPECT_EQ(ResultType::SUCCESS, txn_manager.CommitTransaction(txn));
+
+  concurrency::TransactionManagerFactory::Configure(
+      ProtocolType::TIMESTAMP_ORDERING);
+}
+
+// A transaction whose read was overwritten before it committed aborts
+TEST_F(OptimisticTransactionManagerTests, ValidationTest) {
+  concurrency::TransactionManagerFactory::Configure(
+      ProtocolType::OPTIMISTIC, IsolationLevelType::SERIALIZABLE);
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+
+  {
+    concurrency::EpochManagerFactory::GetInstance().Reset();
+    storage::DataTable *table = TestingTransactionUtil::CreateTable();
+
+    TransactionScheduler scheduler(3, table, &txn_manager);
+    // T0 reads (0, ?)
+    // T1 updates (0, ?) to (0, 1)
+    // T1 commits
+    // T0 commits
+    scheduler.Txn(0).Read(0);
+    scheduler.Txn(1).Update(0, 1);
+    scheduler.Txn(1).Commit();
+    scheduler.Txn(0).Commit();
+
+    // observer
+    scheduler.Txn(2).Read(0);
+    scheduler.Txn(2).Commit();
+
+    scheduler.Run();
+
+    EXPECT_EQ(ResultType::ABORTED, scheduler.schedules[0].txn_result);
+    EXPECT_EQ(ResultType::SUCCESS, scheduler.schedules[1].txn_result);
+    EXPECT_EQ(ResultType::SUCCESS, scheduler.schedules[2].txn_result);
+
+    EXPECT_EQ(1, scheduler.schedules[2].results[0]);
+  }
+
+  {
+    concurrency::EpochManagerFactory::GetInstance().Reset();
+    storage::DataTable *table = TestingTransactionUtil::CreateTable();
+
+    TransactionScheduler scheduler(2, table, &txn_manager);
+    // T0 reads (0, ?)
+    // T0 commits
+    // T1 updates (0, ?) to (0, 1)
+    // T1 commits
+    scheduler.Txn(0).Read(0);
+    scheduler.Txn(0).Commit();
+    scheduler.Txn(1).Update(0, 1);
+    scheduler.Txn(1).Commit();
+
+    scheduler.Run();
+
+    EXPECT_EQ(ResultType::SUCCESS, scheduler.schedules[0].txn_result);
+    EXPECT_EQ(ResultType::SUCCESS, scheduler.schedules[1].txn_result);
+  }
+
+  concurrency::TransactionManagerFactory::Configure(
+      ProtocolType::TIMESTAMP_ORDERING);
+}
+
+}  // namespace test
+}  // namespace peloton
@@ -0,0 +1,114 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// read_write_set_test.cpp
+//
+// Identification: test/concurrency/read_write_set_test.cpp
+//
+// Copyright (c) 2015-18, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <thread>
+#include <vector>
+
+#include "common/harness.h"
+#include "concurrency/read_write_set.h"
+#include "concurrency/transaction_context.h"
+#include "trigger/trigger.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Read Write Set Tests
+//===--------------------------------------------------------------------===//
+
+class ReadWriteSetTests : public PelotonTest {};
+
+TEST_F(ReadWriteSetTests, SetAndFindTest) {
+  concurrency::ReadWriteSet rw_set;
+  EXPECT_TRUE(rw_set.empty());
+  EXPECT_EQ(nullptr, rw_set.Find(ItemPointer(0, 0)));
+
+  // Enough entries to grow the set a few times, in descending order
+  const oid_t tile_group_count = 10;
+  const oid_t tuple_count = 50;
+  for (oid_t block = tile_group_count; block > 0; block--) {
+    for (oid_t offset = tuple_count; offset > 0; offset--) {
+      rw_set.Set(ItemPointer(block, offset), RWType::READ);
+    }
+  }
+  EXPECT_EQ(tile_group_count * tuple_count, rw_set.size());
+
+  // Setting an existing location overwrites its type
+  rw_set.Set(ItemPointer(3, 7), RWType::UPDATE);
+  EXPECT_EQ(tile_group_count * tuple_count, rw_set.size());
+  EXPECT_EQ(RWType::UPDATE, *rw_set.Find(ItemPointer(3, 7)));
+  EXPECT_EQ(RWType::READ, *rw_set.Find(ItemPointer(7, 3)));
+  EXPECT_EQ(nullptr, rw_set.Find(ItemPointer(0, 1)));
+
+  rw_set.SortByTileGroup();
+  ItemPointer last(0, 0);
+  for (auto &entry : rw_set) {
+    EXPECT_TRUE(last < entry.first);
+    last = entry.first;
+  }
+
+  // The lookups still work after sorting
+  EXPECT_EQ(RWType::UPDATE, *rw_set.Find(ItemPointer(3, 7)));
+  for (oid_t block = 1; block <= tile_group_count; block++) {
+    EXPECT_NE(nullptr, rw_set.Find(ItemPointer(block, tuple_count)));
+  }
+
+  rw_set.Clear();
+  EXPECT_TRUE(rw_set.empty());
+  EXPECT_EQ(nullptr, rw_set.Find(ItemPointer(3, 7)));
+  rw_set.Set(ItemPointer(3, 7), RWType::INSERT);
+  EXPECT_EQ(RWType::INSERT, *rw_set.Find(ItemPointer(3, 7)));
+}
+
+TEST_F(ReadWriteSetTests, ConcurrentAccessTest) {
+  concurrency::TransactionContext txn(0, IsolationLevelType::SERIALIZABLE, 0);
+
+  // Worker threads of one transaction record reads, inserts and updates on
+  // their own tile group while the other threads keep growing the set. Every
+  // thread must still find its own entries with the type it recorded last
+  const oid_t thread_count = 4;
+  const oid_t tuple_count = 2000;
+  std::vector<std::thread> threads;
+  for (oid_t block = 1; block <= thread_count; block++) {
+    threads.emplace_back([&txn, block, tuple_count] {
+      for (oid_t offset = 0; offset < tuple_count; offset++) {
+        if (offset % 2 == 0) {
+          txn.RecordRead(ItemPointer(block, offset));
+        } else {
+          txn.RecordInsert(ItemPointer(block, offset));
+        }
+      }
+      for (oid_t offset = 0; offset < tuple_count; offset += 2) {
+        EXPECT_EQ(RWType::READ, txn.GetRWType(ItemPointer(block, offset)));
+        txn.RecordUpdate(ItemPointer(block, offset));
+      }
+      // A later read does not downgrade what the thread wrote
+      for (oid_t offset = 0; offset < tuple_count; offset++) {
+        txn.RecordRead(ItemPointer(block, offset));
+      }
+      for (oid_t offset = 0; offset < tuple_count; offset++) {
+        EXPECT_TRUE(txn.IsInRWSet(ItemPointer(block, offset)));
+        EXPECT_EQ(offset % 2 == 0 ? RWType::UPDATE : RWType::INSERT,
+                  txn.GetRWType(ItemPointer(block, offset)));
+      }
+      EXPECT_FALSE(txn.IsInRWSet(ItemPointer(block, tuple_count)));
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(thread_count * tuple_count, txn.GetReadWriteSet().size());
+}
+
+}  // namespace test
+}  // namespace peloton
@@ -29,5 +29,28 @@ TEST_F(TimestampOrderingTransactionManagerTests, Test) {
   EXPECT_TRUE(true);
 }
 
+TEST_F(TimestampOrderingTransactionManagerTests, WaitForOlderTransactionsTest) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  concurrency::EpochManagerFactory::GetInstance().Reset();
+  storage::DataTable *table = TestingTransactionUtil::CreateTable();
+
+  // the writer begins after the waiting transaction, so its insert is not in
+  // the snapshot of the waiting transaction
+  auto waiter = txn_manager.BeginTransaction();
+  auto writer = txn_manager.BeginTransaction();
+  EXPECT_TRUE(TestingTransactionUtil::ExecuteInsert(writer, table, 100, 100));
+
+  EXPECT_FALSE(txn_manager.WaitForOlderTransactions(waiter, 10));
+
+  EXPECT_EQ(ResultType::SUCCESS, txn_manager.CommitTransaction(writer));
+  EXPECT_TRUE(txn_manager.WaitForOlderTransactions(waiter, 10));
+
+  // the snapshot has moved past the commit of the writer
+  int result = -1;
+  EXPECT_TRUE(TestingTransactionUtil::ExecuteRead(waiter, table, 100, result));
+  EXPECT_EQ(100, result);
+  EXPECT_EQ(ResultType::SUCCESS, txn_manager.CommitTransaction(waiter));
+}
+
 }  // namespace test
 }  // namespace peloton
@@ -0,0 +1,62 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// transaction_context_pool_test.cpp
+//
+// Identification: test/concurrency/transaction_context_pool_test.cpp
+//
+// Copyright (c) 2015-18, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <thread>
+
+#include "common/harness.h"
+#include "concurrency/transaction_context.h"
+#include "concurrency/transaction_context_pool.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Transaction Context Pool Tests
+//===--------------------------------------------------------------------===//
+
+class TransactionContextPoolTests : public PelotonTest {};
+
+TEST_F(TransactionContextPoolTests, ReuseTest) {
+  auto &pool = concurrency::TransactionContextPool::GetInstance();
+
+  auto txn = pool.Acquire(0, IsolationLevelType::SERIALIZABLE, 10);
+  txn->RecordInsert(ItemPointer(1, 1));
+  txn->SetResult(ResultType::ABORTED);
+  txn->SetReadOnly();
+  pool.Release(txn);
+
+  // The thread gets its own context back, without the old state
+  auto reused = pool.Acquire(1, IsolationLevelType::SNAPSHOT, 20, 21);
+  EXPECT_EQ(txn, reused);
+  EXPECT_EQ(1, reused->GetThreadId());
+  EXPECT_EQ(20, reused->GetReadId());
+  EXPECT_EQ(21, reused->GetCommitId());
+  EXPECT_EQ(21, reused->GetTransactionId());
+  EXPECT_EQ(IsolationLevelType::SNAPSHOT, reused->GetIsolationLevel());
+  EXPECT_EQ(ResultType::SUCCESS, reused->GetResult());
+  EXPECT_FALSE(reused->IsReadOnly());
+  EXPECT_TRUE(reused->GetReadWriteSet().empty());
+  EXPECT_TRUE(reused->IsGCSetEmpty());
+
+  // A context released by another thread is handed back through the pool
+  std::thread gc_thread([&pool, reused] { pool.ReleaseShared(reused); });
+  gc_thread.join();
+
+  auto handed_off = pool.Acquire(0, IsolationLevelType::SERIALIZABLE, 30);
+  EXPECT_EQ(reused, handed_off);
+  EXPECT_EQ(30, handed_off->GetTransactionId());
+
+  pool.Release(handed_off);
+}
+
+}  // namespace test
+}  // namespace peloton
@@ -169,5 +169,75 @@ TEST_F(IndexScanTests, MultiColumnPredicateTest) {
   txn_manager.CommitTransaction(txn);
 }
 
+TEST_F(IndexScanTests, InListPredicateTest) {
+  // First, generate the table with index
+  std::unique_ptr<storage::DataTable> data_table(
+      TestingExecutorUtil::CreateAndPopulateTable());
+
+  // Column ids to be added to logical tile after scan.
+  std::vector<oid_t> column_ids({0, 1, 3});
+
+  //===--------------------------------------------------------------------===//
+  // ATTR 0 IN (30, 10, 1000, 50, 30) & ATTR 1 IN (11, 51, 31)
+  //===--------------------------------------------------------------------===//
+
+  auto index = data_table->GetIndex(1);
+  std::vector<oid_t> key_column_ids;
+  std::vector<ExpressionType> expr_types;
+  std::vector<type::Value> values;
+  std::vector<expression::AbstractExpression *> runtime_keys;
+
+  // The array values only refer to these
+  std::vector<int32_t> attr0_list({30, 10, 1000, 50, 30});
+  std::vector<int32_t> attr1_list({11, 51, 31});
+
+  key_column_ids.push_back(0);
+  key_column_ids.push_back(1);
+  expr_types.push_back(ExpressionType::COMPARE_IN);
+  expr_types.push_back(ExpressionType::COMPARE_IN);
+  values.push_back(
+      type::ValueFactory::GetArrayValue(attr0_list, type::TypeId::INTEGER));
+  values.push_back(
+      type::ValueFactory::GetArrayValue(attr1_list, type::TypeId::INTEGER));
+
+  // Create index scan desc
+
+  planner::IndexScanPlan::IndexScanDesc index_scan_desc(
+      index->GetOid(), key_column_ids, expr_types, values, runtime_keys);
+
+  expression::AbstractExpression *predicate = nullptr;
+
+  // Create plan node.
+  planner::IndexScanPlan node(data_table.get(), predicate, column_ids,
+                              index_scan_desc);
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(txn));
+
+  // Run the executor
+  executor::IndexScanExecutor executor(&node, context.get());
+
+  EXPECT_TRUE(executor.Init());
+
+  // Rows (10, 11), (30, 31) and (50, 51) match, in key order
+  std::vector<int32_t> attr0_results;
+  while (executor.Execute()) {
+    std::unique_ptr<executor::LogicalTile> result_tile(executor.GetOutput());
+    EXPECT_THAT(result_tile, NotNull());
+    for (oid_t tuple_id : *result_tile) {
+      attr0_results.push_back(
+          result_tile->GetValue(tuple_id, 0).GetAs<int32_t>());
+      EXPECT_EQ(result_tile->GetValue(tuple_id, 0).GetAs<int32_t>() + 1,
+                result_tile->GetValue(tuple_id, 1).GetAs<int32_t>());
+    }
+  }
+
+  EXPECT_EQ(std::vector<int32_t>({10, 30, 50}), attr0_results);
+
+  txn_manager.CommitTransaction(txn);
+}
+
 }  // namespace test
 }  // namespace peloton
@@ -50,6 +50,14 @@ class TestingIndexUtil {
 
   static void NonUniqueKeyMultiThreadedStressTest2(IndexType index_type);
 
+  static void ScanKeyBatchTest(IndexType index_type);
+
+  static void MemoryFootprintTest(IndexType index_type);
+
+  static void BulkInsertTest(IndexType index_type);
+
+  static void OnlineBuildTest(IndexType index_type);
+
   //===--------------------------------------------------------------------===//
   // Utility Methods
   //===--------------------------------------------------------------------===//
@@ -51,19 +51,26 @@ using IndexPtr = std::unique_ptr<index::Index, void (*)(index::Index *)>;
 class ArtIndexForTest : public index::ArtIndex {
   const Table &data_;
 
+  // Number of keys loaded from the backing vector
+  std::atomic<size_t> load_count_;
+
   static void LoadKey(void *ctx, TID tid, art::Key &key) {
     auto *index = reinterpret_cast<ArtIndexForTest *>(ctx);
     auto *ip = reinterpret_cast<const ItemPointer *>(tid);
     ASSERT_TRUE(ip->offset < index->data_.size());
+    index->load_count_++;
     index->ConstructArtKey(*index->data_[ip->offset].GetKey(), key);
   }
 
  public:
-  ArtIndexForTest(index::IndexMetadata *metadata, const Table &data)
-      : ArtIndex(metadata), data_(data) {
+  ArtIndexForTest(index::IndexMetadata *metadata, const Table &data,
+                  bool store_keys = false)
+      : ArtIndex(metadata, store_keys), data_(data), load_count_(0) {
     // The key loading function loads from an in-memory vector
     SetLoadKeyFunc(LoadKey, reinterpret_cast<void *>(this));
   }
+
+  size_t GetLoadCount() const { return load_count_.load(); }
 };
 
 // The base test class
@@ -71,9 +78,9 @@ class ArtIndexTests : public PelotonTest {
  public:
   ArtIndexTests() : index_(CreateTestIndex()) { GenerateTestInput(1); }
 
-  IndexPtr CreateTestIndex() const {
+  IndexPtr CreateTestIndex(bool store_keys = false) const {
     auto meta = TestingIndexUtil::BuildTestIndexMetadata(IndexType::ART, false);
-    return IndexPtr{new ArtIndexForTest(meta.release(), data_),
+    return IndexPtr{new ArtIndexForTest(meta.release(), data_, store_keys),
                     TestingIndexUtil::DestroyIndex};
   }
 
@@ -325,5 +332,162 @@ TEST_F(ArtIndexTests, NonUniqueKeyMultiThreadedStressTest) {
   }
 }
 
+TEST_F(ArtIndexTests, ScanKeyBatchTest) {
+  uint32_t scale_factor = 20;
+  GenerateTestInput(scale_factor);
+
+  // INDEX
+  auto &index = GetTestIndex();
+  auto &test_data = GetTestData();
+
+  LaunchParallelTest(1, ArtIndexTests::InsertHelper, &index, &test_data);
+
+  // Sorted keys, including some that are not in the index
+  std::vector<std::unique_ptr<storage::Tuple>> keys;
+  for (uint32_t i = 1; i <= scale_factor; i++) {
+    keys.push_back(CreateIndexKey(100 * i, "a"));
+    keys.push_back(CreateIndexKey(100 * i, "b"));
+    keys.push_back(CreateIndexKey(100 * i, "bb"));
+    keys.push_back(CreateIndexKey(100 * i, "c"));
+  }
+  keys.push_back(CreateIndexKey(100000, "f"));
+
+  std::vector<const storage::Tuple *> key_ptrs;
+  for (const auto &key : keys) {
+    key_ptrs.push_back(key.get());
+  }
+
+  // Every key must get exactly what a single key lookup returns
+  std::vector<std::vector<ItemPointer *>> results;
+  index.ScanKeyBatch(key_ptrs, results);
+  ASSERT_EQ(key_ptrs.size(), results.size());
+  for (size_t i = 0; i < key_ptrs.size(); i++) {
+    std::vector<ItemPointer *> location_ptrs;
+    index.ScanKey(key_ptrs[i], location_ptrs);
+    std::sort(location_ptrs.begin(), location_ptrs.end());
+    std::sort(results[i].begin(), results[i].end());
+    EXPECT_EQ(location_ptrs, results[i]);
+  }
+
+  // Unsorted keys are still answered correctly
+  std::reverse(key_ptrs.begin(), key_ptrs.end());
+  results.clear();
+  index.ScanKeyBatch(key_ptrs, results);
+  ASSERT_EQ(key_ptrs.size(), results.size());
+  EXPECT_EQ(0, results[0].size());
+  EXPECT_EQ(3, results[results.size() - 2].size());
+  EXPECT_EQ(1, results.back().size());
+}
+
+TEST_F(ArtIndexTests, MemoryFootprintTest) {
+  uint32_t scale_factor = 20;
+  GenerateTestInput(scale_factor);
+
+  // INDEX
+  auto &index = GetTestIndex();
+  auto &test_data = GetTestData();
+
+  std::unique_ptr<ItemPointer> dummy_tid{new ItemPointer()};
+
+  // The empty tree holds its root node
+  size_t empty_footprint = index.GetMemoryFootprint();
+  EXPECT_LT(0, empty_footprint);
+  EXPECT_EQ(0, index.GetGarbageFootprint());
+
+  LaunchParallelTest(1, ArtIndexTests::InsertHelper, &index, &test_data);
+
+  size_t insert_footprint = index.GetMemoryFootprint();
+  EXPECT_LT(empty_footprint, insert_footprint);
+  EXPECT_LE(index.GetGarbageFootprint(), insert_footprint);
+
+  // Shrinking leaves and nodes retires them to the epoch before freeing
+  LaunchParallelTest(1, ArtIndexTests::DeleteHelper, &index, &test_data,
+                     dummy_tid.get());
+  EXPECT_LE(index.GetGarbageFootprint(), index.GetMemoryFootprint());
+  EXPECT_LE(index.GetMemoryFootprint() - index.GetGarbageFootprint(),
+            insert_footprint);
+}
+
+TEST_F(ArtIndexTests, BulkInsertTest) {
+  // Enough entries to be split over several threads
+  uint32_t scale_factor = 1000;
+  GenerateTestInput(scale_factor);
+
+  // INDEX
+  auto &index = GetTestIndex();
+  auto &test_data = GetTestData();
+
+  // Feed the entries in reverse order, the index sorts them
+  std::vector<const storage::Tuple *> keys;
+  std::vector<ItemPointer *> values;
+  for (auto it = test_data.rbegin(); it != test_data.rend(); it++) {
+    keys.push_back(it->GetKey());
+    values.push_back(it->GetVal());
+  }
+  EXPECT_TRUE(index.BulkInsert(keys, values));
+
+  std::vector<ItemPointer *> location_ptrs;
+  index.ScanAllKeys(location_ptrs);
+  EXPECT_EQ(test_data.size(), location_ptrs.size());
+
+  // Every key finds its own value
+  for (size_t i = 0; i < test_data.size(); i += 13) {
+    location_ptrs.clear();
+    index.ScanKey(test_data[i].GetKey(), location_ptrs);
+    EXPECT_NE(location_ptrs.end(), std::find(location_ptrs.begin(),
+                                             location_ptrs.end(),
+                                             test_data[i].GetVal()));
+  }
+}
+
+TEST_F(ArtIndexTests, StoreKeysTest) {
+  // Enough entries for long compressed prefixes and several scan batches
+  uint32_t scale_factor = 1000;
+  GenerateTestInput(scale_factor);
+
+  // INDEX
+  IndexPtr index_ptr = CreateTestIndex(true);
+  auto &index = static_cast<ArtIndexForTest &>(*index_ptr);
+  auto &test_data = GetTestData();
+  EXPECT_TRUE(index.StoresKeys());
+
+  std::unique_ptr<ItemPointer> dummy_tid{new ItemPointer()};
+
+  size_t num_threads = 4;
+  LaunchParallelTest(num_threads, ArtIndexTests::InsertHelper, &index,
+                     &test_data);
+
+  std::vector<ItemPointer *> location_ptrs;
+  index.ScanAllKeys(location_ptrs);
+  EXPECT_EQ(test_data.size(), location_ptrs.size());
+
+  // Range scan from (100, a) to (100, c)
+  location_ptrs.clear();
+  index.ScanRange(test_data[0].GetKey(), test_data[4].GetKey(),
+                  location_ptrs);
+  EXPECT_EQ(5, location_ptrs.size());
+
+  LaunchParallelTest(num_threads, ArtIndexTests::DeleteHelper, &index,
+                     &test_data, dummy_tid.get());
+
+  // (100, a) and (400, d) lose their only value, (100, b) one of three
+  location_ptrs.clear();
+  index.ScanKey(test_data[0].GetKey(), location_ptrs);
+  EXPECT_EQ(0, location_ptrs.size());
+  location_ptrs.clear();
+  index.ScanKey(test_data[1].GetKey(), location_ptrs);
+  EXPECT_EQ(2, location_ptrs.size());
+  location_ptrs.clear();
+  index.ScanKey(test_data[5].GetKey(), location_ptrs);
+  EXPECT_EQ(0, location_ptrs.size());
+
+  location_ptrs.clear();
+  index.ScanAllKeys(location_ptrs);
+  EXPECT_EQ(test_data.size() / 7 * 4, location_ptrs.size());
+
+  // No key was ever loaded from the backing data
+  EXPECT_EQ(0, index.GetLoadCount());
+}
+
 }  // namespace test
-}  // namespace peloton
\ No newline at end of file
+}  // namespace peloton
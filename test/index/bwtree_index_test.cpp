@@ -65,5 +65,21 @@ TEST_F(BwTreeIndexTests, NonUniqueKeyMultiThreadedStressTest2) {
   TestingIndexUtil::NonUniqueKeyMultiThreadedStressTest2(IndexType::BWTREE);
 }
 
+TEST_F(BwTreeIndexTests, ScanKeyBatchTest) {
+  TestingIndexUtil::ScanKeyBatchTest(IndexType::BWTREE);
+}
+
+TEST_F(BwTreeIndexTests, MemoryFootprintTest) {
+  TestingIndexUtil::MemoryFootprintTest(IndexType::BWTREE);
+}
+
+TEST_F(BwTreeIndexTests, BulkInsertTest) {
+  TestingIndexUtil::BulkInsertTest(IndexType::BWTREE);
+}
+
+TEST_F(BwTreeIndexTests, OnlineBuildTest) {
+  TestingIndexUtil::OnlineBuildTest(IndexType::BWTREE);
+}
+
 }  // namespace test
 }  // namespace peloton
@@ -0,0 +1,136 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// hash_index_test.cpp
+//
+// Identification: test/index/hash_index_test.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "common/harness.h"
+#include "gtest/gtest.h"
+
+#include "common/exception.h"
+#include "index/index.h"
+#include "index/testing_index_util.h"
+#include "storage/tuple.h"
+#include "type/value_factory.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Hash Index Tests
+//===--------------------------------------------------------------------===//
+
+class HashIndexTests : public PelotonTest {};
+
+TEST_F(HashIndexTests, BasicTest) {
+  TestingIndexUtil::BasicTest(IndexType::HASH);
+}
+
+TEST_F(HashIndexTests, MultiMapInsertTest) {
+  TestingIndexUtil::MultiMapInsertTest(IndexType::HASH);
+}
+
+TEST_F(HashIndexTests, UniqueKeyInsertTest) {
+  TestingIndexUtil::UniqueKeyInsertTest(IndexType::HASH);
+}
+
+TEST_F(HashIndexTests, UniqueKeyDeleteTest) {
+  TestingIndexUtil::UniqueKeyDeleteTest(IndexType::HASH);
+}
+
+TEST_F(HashIndexTests, NonUniqueKeyDeleteTest) {
+  TestingIndexUtil::NonUniqueKeyDeleteTest(IndexType::HASH);
+}
+
+TEST_F(HashIndexTests, MultiThreadedInsertTest) {
+  TestingIndexUtil::MultiThreadedInsertTest(IndexType::HASH);
+}
+
+// The MultiThreaded scan tests expect partial key and range predicates to
+// return ordered index results. The hash index rejects them, so only point
+// queries are tested here (see PointQueryTest)
+
+TEST_F(HashIndexTests, NonUniqueKeyMultiThreadedStressTest) {
+  TestingIndexUtil::NonUniqueKeyMultiThreadedStressTest(IndexType::HASH);
+}
+
+TEST_F(HashIndexTests, NonUniqueKeyMultiThreadedStressTest2) {
+  TestingIndexUtil::NonUniqueKeyMultiThreadedStressTest2(IndexType::HASH);
+}
+
+TEST_F(HashIndexTests, PointQueryTest) {
+  auto pool = TestingHarness::GetInstance().GetTestingPool();
+  std::vector<ItemPointer *> location_ptrs;
+
+  std::unique_ptr<index::Index, void (*)(index::Index *)> index(
+      TestingIndexUtil::BuildIndex(IndexType::HASH, false),
+      TestingIndexUtil::DestroyIndex);
+  const catalog::Schema *key_schema = index->GetKeySchema();
+
+  size_t num_threads = 4;
+  size_t scale_factor = 1;
+  LaunchParallelTest(num_threads, TestingIndexUtil::InsertHelper, index.get(),
+                     pool, scale_factor);
+  LaunchParallelTest(num_threads, TestingIndexUtil::DeleteHelper, index.get(),
+                     pool, scale_factor);
+
+  std::unique_ptr<storage::Tuple> key0(new storage::Tuple(key_schema, true));
+  std::unique_ptr<storage::Tuple> key1(new storage::Tuple(key_schema, true));
+
+  key0->SetValue(0, type::ValueFactory::GetIntegerValue(100), pool);
+  key0->SetValue(1, type::ValueFactory::GetVarcharValue("a"), pool);
+  key1->SetValue(0, type::ValueFactory::GetIntegerValue(100), pool);
+  key1->SetValue(1, type::ValueFactory::GetVarcharValue("b"), pool);
+
+  type::Value key0_val0 = (key0->GetValue(0));
+  type::Value key0_val1 = (key0->GetValue(1));
+  type::Value key1_val0 = (key1->GetValue(0));
+  type::Value key1_val1 = (key1->GetValue(1));
+
+  // Equality on the whole key is answered by the hash table
+  index->ScanTest(
+      {key1_val0, key1_val1}, {0, 1},
+      {ExpressionType::COMPARE_EQUAL, ExpressionType::COMPARE_EQUAL},
+      ScanDirectionType::FORWARD, location_ptrs);
+  EXPECT_EQ(2, location_ptrs.size());
+  location_ptrs.clear();
+
+  index->ScanTest(
+      {key0_val0, key0_val1}, {0, 1},
+      {ExpressionType::COMPARE_EQUAL, ExpressionType::COMPARE_EQUAL},
+      ScanDirectionType::BACKWARD, location_ptrs);
+  EXPECT_EQ(0, location_ptrs.size());
+  location_ptrs.clear();
+
+  // A partial key cannot be hashed, and is never planned on a hash index
+  EXPECT_THROW(
+      index->ScanTest({key1_val0}, {0}, {ExpressionType::COMPARE_EQUAL},
+                      ScanDirectionType::FORWARD, location_ptrs),
+      IndexException);
+  EXPECT_EQ(0, location_ptrs.size());
+}
+
+TEST_F(HashIndexTests, MemoryFootprintTest) {
+  TestingIndexUtil::MemoryFootprintTest(IndexType::HASH);
+}
+
+TEST_F(HashIndexTests, ScanKeyBatchTest) {
+  TestingIndexUtil::ScanKeyBatchTest(IndexType::HASH);
+}
+
+TEST_F(HashIndexTests, BulkInsertTest) {
+  TestingIndexUtil::BulkInsertTest(IndexType::HASH);
+}
+
+TEST_F(HashIndexTests, OnlineBuildTest) {
+  TestingIndexUtil::OnlineBuildTest(IndexType::HASH);
+}
+
+}  // namespace test
+}  // namespace peloton
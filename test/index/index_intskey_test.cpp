@@ -17,6 +17,7 @@
 #include "common/platform.h"
 #include "common/timer.h"
 #include "index/index_factory.h"
+#include "index/scan_optimizer.h"
 #include "storage/tuple.h"
 #include "type/value_factory.h"
 
@@ -233,6 +234,139 @@ TEST_F(IndexIntsKeyTests, IndexIntsKeyTest) {
   }
 }
 
+TEST_F(IndexIntsKeyTests, RangeScanTest) {
+  auto pool = TestingHarness::GetInstance().GetTestingPool();
+  std::vector<type::TypeId> col_types = {type::TypeId::INTEGER,
+                                         type::TypeId::BIGINT};
+  std::unique_ptr<index::Index> index(BuildIndex(index_type, false, col_types));
+
+  // Keys span many leaf pages and include negative values on both columns
+  const int num_keys = 2000;
+  std::vector<std::unique_ptr<ItemPointer>> items;
+  for (int i = 0; i < num_keys; i++) {
+    storage::Tuple key(key_schema, true);
+    key.SetValue(0, type::ValueFactory::GetIntegerValue(i / 10 - 50), pool);
+    key.SetValue(1, type::ValueFactory::GetBigIntValue(i % 10 - 5), pool);
+    items.emplace_back(new ItemPointer(i, 0));
+    index->InsertEntry(&key, items.back().get());
+  }
+
+  // A >= -10 AND A <= 30 AND B >= -2 AND B < 3
+  std::vector<type::Value> value_list = {
+      type::ValueFactory::GetIntegerValue(-10),
+      type::ValueFactory::GetIntegerValue(30),
+      type::ValueFactory::GetBigIntValue(-2),
+      type::ValueFactory::GetBigIntValue(3)};
+  std::vector<oid_t> tuple_column_id_list = {0, 0, 1, 1};
+  std::vector<ExpressionType> expr_list = {
+      ExpressionType::COMPARE_GREATERTHANOREQUALTO,
+      ExpressionType::COMPARE_LESSTHANOREQUALTO,
+      ExpressionType::COMPARE_GREATERTHANOREQUALTO,
+      ExpressionType::COMPARE_LESSTHAN};
+  index::IndexScanPredicate isp;
+  isp.AddConjunctionScanPredicate(index.get(), value_list,
+                                  tuple_column_id_list, expr_list);
+
+  std::vector<ItemPointer *> location_ptrs;
+  index->Scan(value_list, tuple_column_id_list, expr_list,
+              ScanDirectionType::FORWARD, location_ptrs,
+              &isp.GetConjunctionList()[0]);
+
+  // Keys outside the bounds of B are filtered by the index. B = 3 is still
+  // returned since open bounds are left to the caller
+  EXPECT_EQ(41 * 6, location_ptrs.size());
+  for (size_t i = 0; i < location_ptrs.size(); i++) {
+    int key_id = static_cast<int>(location_ptrs[i]->block);
+    EXPECT_GE(key_id / 10 - 50, -10);
+    EXPECT_LE(key_id / 10 - 50, 30);
+    EXPECT_GE(key_id % 10 - 5, -2);
+    EXPECT_LE(key_id % 10 - 5, 3);
+    if (i > 0) {
+      EXPECT_LT(location_ptrs[i - 1]->block, location_ptrs[i]->block);
+    }
+  }
+
+  // Bounds that no key can satisfy
+  value_list[2] = type::ValueFactory::GetBigIntValue(4);
+  index::IndexScanPredicate empty_isp;
+  empty_isp.AddConjunctionScanPredicate(index.get(), value_list,
+                                        tuple_column_id_list, expr_list);
+  location_ptrs.clear();
+  index->Scan(value_list, tuple_column_id_list, expr_list,
+              ScanDirectionType::FORWARD, location_ptrs,
+              &empty_isp.GetConjunctionList()[0]);
+  EXPECT_EQ(0, location_ptrs.size());
+}
+
+TEST_F(IndexIntsKeyTests, RangeScanNullTest) {
+  auto pool = TestingHarness::GetInstance().GetTestingPool();
+  std::vector<type::TypeId> col_types = {type::TypeId::INTEGER,
+                                         type::TypeId::INTEGER};
+  std::unique_ptr<index::Index> index(BuildIndex(index_type, false, col_types));
+
+  // Every other key has a NULL in B
+  const int num_keys = 1000;
+  std::vector<std::unique_ptr<ItemPointer>> items;
+  for (int i = 0; i < num_keys; i++) {
+    storage::Tuple key(key_schema, true);
+    key.SetValue(0, type::ValueFactory::GetIntegerValue(i), pool);
+    if (i % 2 == 0) {
+      key.SetValue(1, type::ValueFactory::GetNullValueByType(
+                          type::TypeId::INTEGER), pool);
+    } else {
+      key.SetValue(1, type::ValueFactory::GetIntegerValue(i), pool);
+    }
+    items.emplace_back(new ItemPointer(i, 0));
+    index->InsertEntry(&key, items.back().get());
+  }
+
+  // A > 3 does not bound B, so the keys with a NULL in B are returned too
+  std::vector<type::Value> value_list = {
+      type::ValueFactory::GetIntegerValue(3)};
+  std::vector<oid_t> tuple_column_id_list = {0};
+  std::vector<ExpressionType> expr_list = {
+      ExpressionType::COMPARE_GREATERTHAN};
+  index::IndexScanPredicate isp;
+  isp.AddConjunctionScanPredicate(index.get(), value_list,
+                                  tuple_column_id_list, expr_list);
+
+  std::vector<ItemPointer *> location_ptrs;
+  index->Scan(value_list, tuple_column_id_list, expr_list,
+              ScanDirectionType::FORWARD, location_ptrs,
+              &isp.GetConjunctionList()[0]);
+
+  // A = 3 is still returned since open bounds are left to the caller
+  EXPECT_EQ(num_keys - 3, location_ptrs.size());
+  size_t null_count = 0;
+  for (auto location_ptr : location_ptrs) {
+    EXPECT_GE(location_ptr->block, 3U);
+    if (location_ptr->block % 2 == 0) {
+      null_count++;
+    }
+  }
+  EXPECT_EQ((num_keys - 4) / 2, null_count);
+
+  // A > 3 AND B >= 1 AND B <= 100 bounds B, which a NULL never satisfies
+  value_list.push_back(type::ValueFactory::GetIntegerValue(1));
+  value_list.push_back(type::ValueFactory::GetIntegerValue(100));
+  tuple_column_id_list.push_back(1);
+  tuple_column_id_list.push_back(1);
+  expr_list.push_back(ExpressionType::COMPARE_GREATERTHANOREQUALTO);
+  expr_list.push_back(ExpressionType::COMPARE_LESSTHANOREQUALTO);
+  index::IndexScanPredicate bounded_isp;
+  bounded_isp.AddConjunctionScanPredicate(index.get(), value_list,
+                                          tuple_column_id_list, expr_list);
+  location_ptrs.clear();
+  index->Scan(value_list, tuple_column_id_list, expr_list,
+              ScanDirectionType::FORWARD, location_ptrs,
+              &bounded_isp.GetConjunctionList()[0]);
+  for (auto location_ptr : location_ptrs) {
+    EXPECT_EQ(1U, location_ptr->block % 2);
+    EXPECT_LE(location_ptr->block, 100U);
+  }
+  EXPECT_EQ(49, location_ptrs.size());
+}
+
 // FIXME: The B-Tree core dumps. If we're not going to support then we should
 // probably drop it.
 // TEST_F(IndexIntsKeyTests, BTreeTest) {
@@ -13,8 +13,12 @@
 #include "common/harness.h"
 #include "gtest/gtest.h"
 
+#include "catalog/schema.h"
 #include "common/internal_types.h"
+#include "index/index.h"
 #include "index/testing_index_util.h"
+#include "storage/tuple.h"
+#include "type/value_factory.h"
 
 namespace peloton {
 namespace test {
@@ -26,45 +30,130 @@ namespace test {
 class SkipListIndexTests : public PelotonTest {};
 
 TEST_F(SkipListIndexTests, BasicTest) {
-  // TestingIndexUtil::BasicTest(IndexType::SKIPLIST);
-  EXPECT_EQ(2, 1+1);
+  TestingIndexUtil::BasicTest(IndexType::SKIPLIST);
+}
+
+TEST_F(SkipListIndexTests, MultiMapInsertTest) {
+  TestingIndexUtil::MultiMapInsertTest(IndexType::SKIPLIST);
+}
+
+TEST_F(SkipListIndexTests, UniqueKeyInsertTest) {
+  TestingIndexUtil::UniqueKeyInsertTest(IndexType::SKIPLIST);
+}
+
+TEST_F(SkipListIndexTests, UniqueKeyDeleteTest) {
+  TestingIndexUtil::UniqueKeyDeleteTest(IndexType::SKIPLIST);
+}
+
+TEST_F(SkipListIndexTests, NonUniqueKeyDeleteTest) {
+  TestingIndexUtil::NonUniqueKeyDeleteTest(IndexType::SKIPLIST);
+}
+
+TEST_F(SkipListIndexTests, MultiThreadedInsertTest) {
+  TestingIndexUtil::MultiThreadedInsertTest(IndexType::SKIPLIST);
 }
 
-//TEST_F(SkipListIndexTests, MultiMapInsertTest) {
-//  TestingIndexUtil::MultiMapInsertTest(IndexType::SKIPLIST);
-//}
-//
-//TEST_F(SkipListIndexTests, UniqueKeyInsertTest) {
-//  TestingIndexUtil::UniqueKeyInsertTest(IndexType::SKIPLIST);
-//}
-//
-//TEST_F(SkipListIndexTests, UniqueKeyDeleteTest) {
-//  TestingIndexUtil::UniqueKeyDeleteTest(IndexType::SKIPLIST);
-//}
-//
-//TEST_F(SkipListIndexTests, NonUniqueKeyDeleteTest) {
-//  TestingIndexUtil::NonUniqueKeyDeleteTest(IndexType::SKIPLIST);
-//}
-//
-//TEST_F(SkipListIndexTests, MultiThreadedInsertTest) {
-//  TestingIndexUtil::MultiThreadedInsertTest(IndexType::SKIPLIST);
-//}
-//
 //TEST_F(SkipListIndexTests, UniqueKeyMultiThreadedTest) {
 //  TestingIndexUtil::UniqueKeyMultiThreadedTest(IndexType::SKIPLIST);
 //}
-//
-//TEST_F(SkipListIndexTests, NonUniqueKeyMultiThreadedTest) {
-//  TestingIndexUtil::NonUniqueKeyMultiThreadedTest(IndexType::SKIPLIST);
-//}
-//
-//TEST_F(SkipListIndexTests, NonUniqueKeyMultiThreadedStressTest) {
-//  TestingIndexUtil::NonUniqueKeyMultiThreadedStressTest(IndexType::SKIPLIST);
-//}
-//
-//TEST_F(SkipListIndexTests, NonUniqueKeyMultiThreadedStressTest2) {
-//  TestingIndexUtil::NonUniqueKeyMultiThreadedStressTest2(IndexType::SKIPLIST);
-//}
+
+TEST_F(SkipListIndexTests, NonUniqueKeyMultiThreadedTest) {
+  TestingIndexUtil::NonUniqueKeyMultiThreadedTest(IndexType::SKIPLIST);
+}
+
+TEST_F(SkipListIndexTests, NonUniqueKeyMultiThreadedStressTest) {
+  TestingIndexUtil::NonUniqueKeyMultiThreadedStressTest(IndexType::SKIPLIST);
+}
+
+TEST_F(SkipListIndexTests, NonUniqueKeyMultiThreadedStressTest2) {
+  TestingIndexUtil::NonUniqueKeyMultiThreadedStressTest2(IndexType::SKIPLIST);
+}
+
+TEST_F(SkipListIndexTests, ScanDirectionTest) {
+  auto pool = TestingHarness::GetInstance().GetTestingPool();
+  std::vector<ItemPointer *> location_ptrs;
+
+  std::unique_ptr<index::Index, void (*)(index::Index *)> index(
+      TestingIndexUtil::BuildIndex(IndexType::SKIPLIST, false),
+      TestingIndexUtil::DestroyIndex);
+  const catalog::Schema *key_schema = index->GetKeySchema();
+
+  // Key i maps to the item pointer (i, 0)
+  const int num_keys = 10;
+  std::vector<ItemPointer> items;
+  for (int i = 0; i < num_keys; i++) {
+    items.emplace_back(i, 0);
+  }
+  for (int i = 0; i < num_keys; i++) {
+    std::unique_ptr<storage::Tuple> key(new storage::Tuple(key_schema, true));
+    key->SetValue(0, type::ValueFactory::GetIntegerValue(i), pool);
+    key->SetValue(1, type::ValueFactory::GetVarcharValue("a"), pool);
+    EXPECT_TRUE(index->InsertEntry(key.get(), &items[i]));
+  }
+
+  type::Value low = type::ValueFactory::GetIntegerValue(3);
+  type::Value high = type::ValueFactory::GetIntegerValue(6);
+
+  // a >= 3 AND a <= 6, ascending
+  index->ScanTest({low, high}, {0, 0},
+                  {ExpressionType::COMPARE_GREATERTHANOREQUALTO,
+                   ExpressionType::COMPARE_LESSTHANOREQUALTO},
+                  ScanDirectionType::FORWARD, location_ptrs);
+  ASSERT_EQ(4, location_ptrs.size());
+  for (int i = 0; i < 4; i++) {
+    EXPECT_EQ(3 + i, location_ptrs[i]->block);
+  }
+  location_ptrs.clear();
+
+  // The same range, descending
+  index->ScanTest({low, high}, {0, 0},
+                  {ExpressionType::COMPARE_GREATERTHANOREQUALTO,
+                   ExpressionType::COMPARE_LESSTHANOREQUALTO},
+                  ScanDirectionType::BACKWARD, location_ptrs);
+  ASSERT_EQ(4, location_ptrs.size());
+  for (int i = 0; i < 4; i++) {
+    EXPECT_EQ(6 - i, location_ptrs[i]->block);
+  }
+  location_ptrs.clear();
+
+  // Deleted keys are skipped in both directions
+  for (int i = 0; i < num_keys; i += 2) {
+    std::unique_ptr<storage::Tuple> key(new storage::Tuple(key_schema, true));
+    key->SetValue(0, type::ValueFactory::GetIntegerValue(i), pool);
+    key->SetValue(1, type::ValueFactory::GetVarcharValue("a"), pool);
+    EXPECT_TRUE(index->DeleteEntry(key.get(), &items[i]));
+  }
+
+  index->ScanAllKeys(location_ptrs);
+  EXPECT_EQ(num_keys / 2, location_ptrs.size());
+  location_ptrs.clear();
+
+  index->ScanTest({low, high}, {0, 0},
+                  {ExpressionType::COMPARE_GREATERTHANOREQUALTO,
+                   ExpressionType::COMPARE_LESSTHANOREQUALTO},
+                  ScanDirectionType::BACKWARD, location_ptrs);
+  ASSERT_EQ(2, location_ptrs.size());
+  EXPECT_EQ(5, location_ptrs[0]->block);
+  EXPECT_EQ(3, location_ptrs[1]->block);
+  location_ptrs.clear();
+
+  if (index->NeedGC() == true) {
+    index->PerformGC();
+  }
+  EXPECT_LT(0, index->GetMemoryFootprint());
+}
+
+TEST_F(SkipListIndexTests, ScanKeyBatchTest) {
+  TestingIndexUtil::ScanKeyBatchTest(IndexType::SKIPLIST);
+}
+
+TEST_F(SkipListIndexTests, BulkInsertTest) {
+  TestingIndexUtil::BulkInsertTest(IndexType::SKIPLIST);
+}
+
+TEST_F(SkipListIndexTests, OnlineBuildTest) {
+  TestingIndexUtil::OnlineBuildTest(IndexType::SKIPLIST);
+}
 
 }  // namespace test
 }  // namespace peloton
@@ -12,6 +12,8 @@
 
 #include "index/testing_index_util.h"
 
+#include <random>
+
 #include "gtest/gtest.h"
 
 #include "common/harness.h"
@@ -681,6 +683,246 @@ void TestingIndexUtil::NonUniqueKeyMultiThreadedStressTest2(
   location_ptrs.clear();
 }
 
+void TestingIndexUtil::ScanKeyBatchTest(const IndexType index_type) {
+  auto pool = TestingHarness::GetInstance().GetTestingPool();
+
+  // INDEX
+  std::unique_ptr<index::Index, void (*)(index::Index *)> index(
+      TestingIndexUtil::BuildIndex(index_type, false), DestroyIndex);
+  const catalog::Schema *key_schema = index->GetKeySchema();
+
+  size_t num_threads = 4;
+  size_t scale_factor = 10;
+  LaunchParallelTest(num_threads, TestingIndexUtil::InsertHelper, index.get(),
+                     pool, scale_factor);
+
+  // Sorted keys, with (x, "bb") and (1000 * x, "f") never inserted
+  std::vector<std::unique_ptr<storage::Tuple>> keys;
+  std::vector<const storage::Tuple *> key_ptrs;
+  std::vector<std::pair<int32_t, std::string>> key_values;
+  for (size_t scale_itr = 1; scale_itr <= scale_factor; scale_itr++) {
+    int32_t val = static_cast<int32_t>(scale_itr);
+    key_values.emplace_back(100 * val, "a");
+    key_values.emplace_back(100 * val, "b");
+    key_values.emplace_back(100 * val, "bb");
+    key_values.emplace_back(100 * val, "c");
+    key_values.emplace_back(400 * val, "d");
+    key_values.emplace_back(1000 * val, "f");
+  }
+  std::sort(key_values.begin(), key_values.end());
+  for (const auto &key_value : key_values) {
+    keys.emplace_back(new storage::Tuple(key_schema, true));
+    keys.back()->SetValue(
+        0, type::ValueFactory::GetIntegerValue(key_value.first), pool);
+    keys.back()->SetValue(
+        1, type::ValueFactory::GetVarcharValue(key_value.second), pool);
+    key_ptrs.push_back(keys.back().get());
+  }
+
+  // Every key must get exactly what a single key lookup returns
+  std::vector<std::vector<ItemPointer *>> results;
+  index->ScanKeyBatch(key_ptrs, results);
+  ASSERT_EQ(key_ptrs.size(), results.size());
+  for (size_t i = 0; i < key_ptrs.size(); i++) {
+    std::vector<ItemPointer *> location_ptrs;
+    index->ScanKey(key_ptrs[i], location_ptrs);
+    std::sort(location_ptrs.begin(), location_ptrs.end());
+    std::sort(results[i].begin(), results[i].end());
+    EXPECT_EQ(location_ptrs, results[i]);
+
+    if (key_values[i].second == "b") {
+      EXPECT_EQ(3, results[i].size());
+    } else if (key_values[i].second == "bb" || key_values[i].second == "f") {
+      EXPECT_EQ(0, results[i].size());
+    }
+  }
+
+  // Unsorted keys are still answered correctly
+  std::reverse(key_ptrs.begin(), key_ptrs.end());
+  std::reverse(key_values.begin(), key_values.end());
+  results.clear();
+  index->ScanKeyBatch(key_ptrs, results);
+  ASSERT_EQ(key_ptrs.size(), results.size());
+  for (size_t i = 0; i < key_ptrs.size(); i++) {
+    if (key_values[i].second == "b") {
+      EXPECT_EQ(3, results[i].size());
+    } else if (key_values[i].second == "bb" || key_values[i].second == "f") {
+      EXPECT_EQ(0, results[i].size());
+    } else {
+      EXPECT_EQ(1, results[i].size());
+    }
+  }
+}
+
+void TestingIndexUtil::MemoryFootprintTest(const IndexType index_type) {
+  auto pool = TestingHarness::GetInstance().GetTestingPool();
+
+  // INDEX
+  std::unique_ptr<index::Index, void (*)(index::Index *)> index(
+      TestingIndexUtil::BuildIndex(index_type, false), DestroyIndex);
+
+  // An empty index still holds its initial nodes
+  size_t empty_footprint = index->GetMemoryFootprint();
+  EXPECT_LT(0, empty_footprint);
+  EXPECT_EQ(0, index->GetGarbageFootprint());
+
+  // Single threaded, so that no chunk is grown on a node after it has been
+  // unlinked and the garbage sizes are exact
+  size_t num_threads = 1;
+  size_t scale_factor = 100;
+  LaunchParallelTest(num_threads, TestingIndexUtil::InsertHelper, index.get(),
+                     pool, scale_factor);
+
+  size_t insert_footprint = index->GetMemoryFootprint();
+  EXPECT_LT(empty_footprint, insert_footprint);
+  EXPECT_LE(index->GetGarbageFootprint(), insert_footprint);
+
+  LaunchParallelTest(num_threads, TestingIndexUtil::DeleteHelper, index.get(),
+                     pool, scale_factor);
+  EXPECT_LE(index->GetGarbageFootprint(), index->GetMemoryFootprint());
+
+  // Reclaiming garbage releases exactly the bytes that were pending
+  size_t garbage_footprint = index->GetGarbageFootprint();
+  size_t footprint = index->GetMemoryFootprint();
+  if (index->NeedGC() == true) {
+    index->PerformGC();
+    index->PerformGC();
+  }
+  EXPECT_EQ(footprint - garbage_footprint + index->GetGarbageFootprint(),
+            index->GetMemoryFootprint());
+}
+
+void TestingIndexUtil::BulkInsertTest(const IndexType index_type) {
+  auto pool = TestingHarness::GetInstance().GetTestingPool();
+
+  // INDEX
+  std::unique_ptr<index::Index, void (*)(index::Index *)> index(
+      TestingIndexUtil::BuildIndex(index_type, false), DestroyIndex);
+  const catalog::Schema *key_schema = index->GetKeySchema();
+
+  // Enough keys to fill many nodes and to be split over several threads.
+  // Every key has three values and the keys arrive in random order
+  size_t key_count = 10000;
+  size_t value_count = 3;
+  std::vector<int32_t> key_values;
+  for (size_t i = 0; i < key_count; i++) {
+    for (size_t j = 0; j < value_count; j++) {
+      key_values.push_back(static_cast<int32_t>(i));
+    }
+  }
+  std::mt19937 rng(0);
+  std::shuffle(key_values.begin(), key_values.end(), rng);
+
+  std::vector<std::unique_ptr<storage::Tuple>> keys;
+  std::vector<const storage::Tuple *> key_ptrs;
+  std::vector<std::unique_ptr<ItemPointer>> items;
+  std::vector<ItemPointer *> item_ptrs;
+  for (size_t i = 0; i < key_values.size(); i++) {
+    keys.emplace_back(new storage::Tuple(key_schema, true));
+    keys.back()->SetValue(
+        0, type::ValueFactory::GetIntegerValue(key_values[i]), pool);
+    keys.back()->SetValue(1, type::ValueFactory::GetVarcharValue("a"), pool);
+    key_ptrs.push_back(keys.back().get());
+
+    items.emplace_back(new ItemPointer(key_values[i], i));
+    item_ptrs.push_back(items.back().get());
+  }
+
+  // Build the empty index in one go
+  size_t half = key_ptrs.size() / 2;
+  EXPECT_TRUE(index->BulkInsert(
+      std::vector<const storage::Tuple *>(key_ptrs.begin(),
+                                          key_ptrs.begin() + half),
+      std::vector<ItemPointer *>(item_ptrs.begin(), item_ptrs.begin() + half)));
+
+  // Then add the rest to the non-empty index
+  EXPECT_TRUE(index->BulkInsert(
+      std::vector<const storage::Tuple *>(key_ptrs.begin() + half,
+                                          key_ptrs.end()),
+      std::vector<ItemPointer *>(item_ptrs.begin() + half, item_ptrs.end())));
+
+  std::vector<ItemPointer *> location_ptrs;
+  index->ScanAllKeys(location_ptrs);
+  EXPECT_EQ(key_ptrs.size(), location_ptrs.size());
+
+  // Every key finds exactly its own values
+  for (size_t i = 0; i < key_ptrs.size(); i += 97) {
+    location_ptrs.clear();
+    index->ScanKey(key_ptrs[i], location_ptrs);
+    EXPECT_EQ(value_count, location_ptrs.size());
+    for (auto location_ptr : location_ptrs) {
+      EXPECT_EQ(static_cast<oid_t>(key_values[i]), location_ptr->block);
+    }
+  }
+
+  // The same pair cannot be inserted twice
+  EXPECT_FALSE(index->BulkInsert({key_ptrs[0], key_ptrs[0]},
+                                 {item_ptrs[0], item_ptrs[0]}));
+
+  // A unique index rejects a batch with a duplicated key
+  std::unique_ptr<index::Index, void (*)(index::Index *)> unique_index(
+      TestingIndexUtil::BuildIndex(index_type, true), DestroyIndex);
+  EXPECT_FALSE(unique_index->BulkInsert(key_ptrs, item_ptrs));
+}
+
+void TestingIndexUtil::OnlineBuildTest(const IndexType index_type) {
+  auto pool = TestingHarness::GetInstance().GetTestingPool();
+
+  // INDEX
+  std::unique_ptr<index::Index, void (*)(index::Index *)> index(
+      TestingIndexUtil::BuildIndex(index_type, false), DestroyIndex);
+  const catalog::Schema *key_schema = index->GetKeySchema();
+
+  std::unique_ptr<storage::Tuple> key0(new storage::Tuple(key_schema, true));
+  std::unique_ptr<storage::Tuple> key1(new storage::Tuple(key_schema, true));
+  key0->SetValue(0, type::ValueFactory::GetIntegerValue(100), pool);
+  key0->SetValue(1, type::ValueFactory::GetVarcharValue("a"), pool);
+  key1->SetValue(0, type::ValueFactory::GetIntegerValue(200), pool);
+  key1->SetValue(1, type::ValueFactory::GetVarcharValue("b"), pool);
+
+  // Nothing is buffered before the build starts
+  EXPECT_FALSE(index->IsBuilding());
+  EXPECT_FALSE(index->BufferInsert(key0.get(), item0.get()));
+
+  index->StartBuild();
+  EXPECT_TRUE(index->IsBuilding());
+
+  // Writers insert key1 and delete key0 while the snapshot is loaded
+  EXPECT_TRUE(index->BufferInsert(key1.get(), item1.get()));
+  EXPECT_TRUE(index->BufferDelete(key0.get(), item0.get()));
+
+  // The key is copied, so the writer may reuse it
+  key1->SetValue(0, type::ValueFactory::GetIntegerValue(300), pool);
+
+  // The snapshot has key0
+  EXPECT_TRUE(index->BulkInsert({key0.get()}, {item0.get()}));
+
+  std::vector<ItemPointer *> location_ptrs;
+  index->ScanAllKeys(location_ptrs);
+  EXPECT_EQ(1, location_ptrs.size());
+
+  auto insert_func = [&index](const storage::Tuple *key,
+                              ItemPointer *location) {
+    return index->InsertEntry(key, location);
+  };
+  EXPECT_TRUE(index->FinishBuild(insert_func));
+  EXPECT_FALSE(index->IsBuilding());
+
+  // The merged index only has the buffered insert
+  location_ptrs.clear();
+  index->ScanAllKeys(location_ptrs);
+  EXPECT_EQ(1, location_ptrs.size());
+  EXPECT_EQ(item1->offset, location_ptrs[0]->offset);
+
+  location_ptrs.clear();
+  key1->SetValue(0, type::ValueFactory::GetIntegerValue(200), pool);
+  index->ScanKey(key1.get(), location_ptrs);
+  EXPECT_EQ(1, location_ptrs.size());
+
+  // Writers apply their changes themselves again
+  EXPECT_FALSE(index->BufferInsert(key0.get(), item0.get()));
+}
+
 std::unique_ptr<index::IndexMetadata> TestingIndexUtil::BuildTestIndexMetadata(
     const IndexType index_type, const bool unique_keys) {
   LOG_DEBUG("Build index type: %s [unique_keys=%s]",
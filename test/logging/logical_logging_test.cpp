@@ -0,0 +1,477 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// logical_logging_test.cpp
+//
+// Identification: test/logging/logical_logging_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <dirent.h>
+#include <cstring>
+
+#include "common/harness.h"
+#include "catalog/catalog.h"
+#include "catalog/catalog_defaults.h"
+#include "catalog/table_catalog.h"
+#include "concurrency/testing_transaction_util.h"
+#include "logging/logging_util.h"
+#include "logging/logical_checkpoint_manager.h"
+#include "logging/logical_log_manager.h"
+#include "storage/database.h"
+#include "storage/storage_manager.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Logical Logging Tests
+//===--------------------------------------------------------------------===//
+
+class LogicalLoggingTests : public PelotonTest {};
+
+static const std::vector<std::string> LOG_DIRS = {"logical_log_test_0",
+                                                  "logical_log_test_1"};
+
+static const std::string CHECKPOINT_DIR = "logical_checkpoint_test";
+
+static size_t GetDirectorySize(const std::string &dir_name) {
+  size_t total_size = 0;
+  DIR *dir = opendir(dir_name.c_str());
+  if (dir == nullptr) {
+    return 0;
+  }
+  struct dirent *file;
+  while ((file = readdir(dir)) != nullptr) {
+    if (strcmp(file->d_name, ".") == 0 || strcmp(file->d_name, "..") == 0) {
+      continue;
+    }
+    FileHandle file_handle;
+    std::string path = dir_name + "/" + file->d_name;
+    if (logging::LoggingUtil::OpenFile(path.c_str(), "rb", file_handle)) {
+      total_size += file_handle.size;
+      logging::LoggingUtil::CloseFile(file_handle);
+    }
+  }
+  closedir(dir);
+  return total_size;
+}
+
+TEST_F(LogicalLoggingTests, AsynchronousCommitTest) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  concurrency::EpochManagerFactory::GetInstance().Reset();
+
+  storage::DataTable *table = TestingTransactionUtil::CreateTable();
+
+  auto &log_manager = logging::LogicalLogManager::GetInstance();
+  log_manager.SetDirectories(LOG_DIRS);
+  log_manager.SetSynchronousCommit(false);
+  log_manager.StartLogging();
+
+  // the epoch does not advance, so nothing can be durable before logging
+  // stops.
+  {
+    TransactionScheduler scheduler(4, table, &txn_manager);
+    scheduler.Txn(0).Insert(100, 100);
+    scheduler.Txn(0).Commit();
+    scheduler.Txn(1).Update(0, 1);
+    scheduler.Txn(1).Commit();
+    scheduler.Txn(2).Delete(1);
+    scheduler.Txn(2).Commit();
+    // read-only transactions are not logged.
+    scheduler.Txn(3).Read(2);
+    scheduler.Txn(3).Commit();
+    scheduler.Run();
+
+    for (auto &schedule : scheduler.schedules) {
+      EXPECT_EQ(ResultType::SUCCESS, schedule.txn_result);
+    }
+  }
+
+  log_manager.StopLogging();
+
+  // stopping drains every worker, so the current epoch is durable.
+  eid_t current_eid =
+      concurrency::EpochManagerFactory::GetInstance().GetCurrentEpochId();
+  EXPECT_EQ(current_eid, log_manager.GetPersistEpochId());
+
+  // the first directory also holds the pepoch file.
+  EXPECT_LT(0, GetDirectorySize(LOG_DIRS[0]));
+
+  for (auto &dir : LOG_DIRS) {
+    logging::LoggingUtil::RemoveDirectory(dir.c_str(), false);
+  }
+}
+
+TEST_F(LogicalLoggingTests, SynchronousCommitTest) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+
+  thread_pool.Initialize(0, CONNECTION_THREAD_COUNT + 3);
+  concurrency::EpochManagerFactory::GetInstance().Reset();
+  concurrency::EpochManagerFactory::GetInstance().StartEpoch();
+
+  storage::DataTable *table = TestingTransactionUtil::CreateTable();
+
+  auto &log_manager = logging::LogicalLogManager::GetInstance();
+  log_manager.SetDirectories(LOG_DIRS);
+  log_manager.SetSynchronousCommit(true);
+  log_manager.StartLogging();
+
+  for (int i = 0; i < 3; ++i) {
+    auto txn = txn_manager.BeginTransaction();
+    EXPECT_TRUE(TestingTransactionUtil::ExecuteUpdate(txn, table, i, i + 1));
+
+    eid_t commit_eid =
+        concurrency::EpochManagerFactory::GetInstance().GetCurrentEpochId();
+    EXPECT_EQ(ResultType::SUCCESS, txn_manager.CommitTransaction(txn));
+
+    // the commit returns only after its epoch has been made durable.
+    EXPECT_LE(commit_eid, log_manager.GetPersistEpochId());
+  }
+
+  log_manager.StopLogging();
+
+  concurrency::EpochManagerFactory::GetInstance().StopEpoch();
+  thread_pool.Shutdown();
+
+  // a single worker is bound to the first logger.
+  EXPECT_LT(0, GetDirectorySize(LOG_DIRS[0]));
+
+  for (auto &dir : LOG_DIRS) {
+    logging::LoggingUtil::RemoveDirectory(dir.c_str(), false);
+  }
+}
+
+TEST_F(LogicalLoggingTests, RecoveryTest) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  concurrency::EpochManagerFactory::GetInstance().Reset();
+
+  // system catalogs are not recovered, so use an oid outside their range.
+  oid_t table_oid = (OID_FOR_USER_OFFSET + 1) | TABLE_OID_MASK;
+
+  auto &log_manager = logging::LogicalLogManager::GetInstance();
+  log_manager.SetDirectories(LOG_DIRS);
+  log_manager.SetSynchronousCommit(false);
+  log_manager.StartLogging();
+
+  // (0, 0) ... (9, 0)
+  storage::DataTable *table = TestingTransactionUtil::CreateTable(
+      10, "RECOVERY_TABLE", CATALOG_DATABASE_OID, table_oid, 1234, true);
+
+  {
+    TransactionScheduler scheduler(5, table, &txn_manager);
+    scheduler.Txn(0).Update(0, 100);
+    scheduler.Txn(0).Commit();
+    scheduler.Txn(1).Delete(1);
+    scheduler.Txn(1).Commit();
+    scheduler.Txn(2).Insert(20, 20);
+    scheduler.Txn(2).Commit();
+    scheduler.Txn(3).Update(2, 200);
+    scheduler.Txn(3).Update(2, 201);
+    scheduler.Txn(3).Commit();
+    // aborted transactions are never replayed.
+    scheduler.Txn(4).Update(3, 300);
+    scheduler.Txn(4).Abort();
+    scheduler.Run();
+  }
+
+  log_manager.StopLogging();
+
+  // restart with an empty table.
+  auto database = storage::StorageManager::GetInstance()->GetDatabaseWithOid(
+      CATALOG_DATABASE_OID);
+  database->DropTableWithOid(table_oid);
+  table = TestingTransactionUtil::CreateTable(
+      0, "RECOVERY_TABLE", CATALOG_DATABASE_OID, table_oid, 1234, true);
+
+  log_manager.SetDirectories(LOG_DIRS);
+  eid_t persist_eid = log_manager.DoRecovery(2);
+  EXPECT_NE(INVALID_EID, persist_eid);
+  EXPECT_LT(persist_eid, concurrency::EpochManagerFactory::GetInstance()
+                             .GetCurrentEpochId());
+
+  std::vector<std::pair<int, int>> expected = {
+      {0, 100}, {1, -1}, {2, 201}, {3, 0}, {9, 0}, {20, 20}};
+  auto txn = txn_manager.BeginTransaction();
+  for (auto &entry : expected) {
+    int result;
+    EXPECT_TRUE(
+        TestingTransactionUtil::ExecuteRead(txn, table, entry.first, result));
+    EXPECT_EQ(entry.second, result);
+  }
+  EXPECT_EQ(ResultType::SUCCESS, txn_manager.CommitTransaction(txn));
+
+  for (auto &dir : LOG_DIRS) {
+    logging::LoggingUtil::RemoveDirectory(dir.c_str(), false);
+  }
+}
+
+TEST_F(LogicalLoggingTests, UnknownTableRecoveryTest) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  concurrency::EpochManagerFactory::GetInstance().Reset();
+
+  oid_t table_oid = (OID_FOR_USER_OFFSET + 1) | TABLE_OID_MASK;
+
+  auto &log_manager = logging::LogicalLogManager::GetInstance();
+  log_manager.SetDirectories(LOG_DIRS);
+  log_manager.SetSynchronousCommit(false);
+  log_manager.StartLogging();
+
+  storage::DataTable *table = TestingTransactionUtil::CreateTable(
+      10, "RECOVERY_TABLE", CATALOG_DATABASE_OID, table_oid, 1234, true);
+  {
+    TransactionScheduler scheduler(1, table, &txn_manager);
+    scheduler.Txn(0).Update(0, 100);
+    scheduler.Txn(0).Commit();
+    scheduler.Run();
+  }
+
+  log_manager.StopLogging();
+
+  // restart without the table. its records must not be dropped silently.
+  auto database = storage::StorageManager::GetInstance()->GetDatabaseWithOid(
+      CATALOG_DATABASE_OID);
+  database->DropTableWithOid(table_oid);
+
+  log_manager.SetDirectories(LOG_DIRS);
+  EXPECT_THROW(log_manager.DoRecovery(2), CatalogException);
+
+  // the log is kept, so recovery succeeds once the table exists.
+  table = TestingTransactionUtil::CreateTable(
+      0, "RECOVERY_TABLE", CATALOG_DATABASE_OID, table_oid, 1234, true);
+  EXPECT_NE(INVALID_EID, log_manager.DoRecovery(2));
+
+  auto txn = txn_manager.BeginTransaction();
+  int result;
+  EXPECT_TRUE(TestingTransactionUtil::ExecuteRead(txn, table, 0, result));
+  EXPECT_EQ(100, result);
+  EXPECT_EQ(ResultType::SUCCESS, txn_manager.CommitTransaction(txn));
+
+  for (auto &dir : LOG_DIRS) {
+    logging::LoggingUtil::RemoveDirectory(dir.c_str(), false);
+  }
+}
+
+TEST_F(LogicalLoggingTests, EpochGapRecoveryTest) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+  epoch_manager.Reset();
+
+  oid_t table_oid = (OID_FOR_USER_OFFSET + 1) | TABLE_OID_MASK;
+
+  auto &log_manager = logging::LogicalLogManager::GetInstance();
+  log_manager.SetDirectories(LOG_DIRS);
+  log_manager.SetSynchronousCommit(false);
+  log_manager.StartLogging();
+
+  // (0, 0) ... (9, 0)
+  storage::DataTable *table = TestingTransactionUtil::CreateTable(
+      10, "RECOVERY_TABLE", CATALOG_DATABASE_OID, table_oid, 1234, true);
+
+  // the same worker commits in epochs that are far apart, and each commit
+  // must stay in the buffers of its own epoch.
+  std::vector<eid_t> commit_eids = {1, 257, 1000};
+  for (size_t i = 0; i < commit_eids.size(); ++i) {
+    epoch_manager.SetCurrentEpochId(commit_eids[i]);
+    auto txn = txn_manager.BeginTransaction();
+    EXPECT_TRUE(TestingTransactionUtil::ExecuteUpdate(txn, table, i, 100 + i));
+    EXPECT_EQ(ResultType::SUCCESS, txn_manager.CommitTransaction(txn));
+  }
+
+  log_manager.StopLogging();
+  EXPECT_EQ(commit_eids.back(), log_manager.GetPersistEpochId());
+
+  // restart with an empty table.
+  auto database = storage::StorageManager::GetInstance()->GetDatabaseWithOid(
+      CATALOG_DATABASE_OID);
+  database->DropTableWithOid(table_oid);
+  table = TestingTransactionUtil::CreateTable(
+      0, "RECOVERY_TABLE", CATALOG_DATABASE_OID, table_oid, 1234, true);
+
+  log_manager.SetDirectories(LOG_DIRS);
+  EXPECT_NE(INVALID_EID, log_manager.DoRecovery(2));
+
+  std::vector<std::pair<int, int>> expected = {
+      {0, 100}, {1, 101}, {2, 102}, {3, 0}};
+  auto txn = txn_manager.BeginTransaction();
+  for (auto &entry : expected) {
+    int result;
+    EXPECT_TRUE(
+        TestingTransactionUtil::ExecuteRead(txn, table, entry.first, result));
+    EXPECT_EQ(entry.second, result);
+  }
+  EXPECT_EQ(ResultType::SUCCESS, txn_manager.CommitTransaction(txn));
+
+  for (auto &dir : LOG_DIRS) {
+    logging::LoggingUtil::RemoveDirectory(dir.c_str(), false);
+  }
+}
+
+TEST_F(LogicalLoggingTests, CheckpointRecoveryTest) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+  epoch_manager.Reset();
+
+  oid_t table_oid = (OID_FOR_USER_OFFSET + 1) | TABLE_OID_MASK;
+
+  auto &log_manager = logging::LogicalLogManager::GetInstance();
+  log_manager.SetDirectories(LOG_DIRS);
+  log_manager.SetSynchronousCommit(false);
+  log_manager.StartLogging();
+
+  auto &checkpoint_manager = logging::LogicalCheckpointManager::GetInstance();
+  checkpoint_manager.SetDirectory(CHECKPOINT_DIR);
+
+  // (0, 0) ... (9, 0)
+  storage::DataTable *table = TestingTransactionUtil::CreateTable(
+      10, "RECOVERY_TABLE", CATALOG_DATABASE_OID, table_oid, 1234, true);
+
+  {
+    TransactionScheduler scheduler(2, table, &txn_manager);
+    scheduler.Txn(0).Update(0, 100);
+    scheduler.Txn(0).Commit();
+    scheduler.Txn(1).Delete(1);
+    scheduler.Txn(1).Commit();
+    scheduler.Run();
+  }
+
+  // let every transaction of the first epoch expire, so that the checkpoint
+  // covers them.
+  epoch_manager.SetCurrentEpochId(3);
+  epoch_manager.GetExpiredEpochId();
+  eid_t checkpoint_eid = checkpoint_manager.DoCheckpoint();
+  EXPECT_EQ(2, checkpoint_eid);
+
+  // the tail of the log is replayed on top of the checkpoint.
+  {
+    TransactionScheduler scheduler(3, table, &txn_manager);
+    scheduler.Txn(0).Update(2, 200);
+    scheduler.Txn(0).Commit();
+    scheduler.Txn(1).Insert(20, 20);
+    scheduler.Txn(1).Commit();
+    scheduler.Txn(2).Delete(0);
+    scheduler.Txn(2).Commit();
+    scheduler.Run();
+  }
+
+  log_manager.StopLogging();
+
+  // restart with an empty table.
+  auto database = storage::StorageManager::GetInstance()->GetDatabaseWithOid(
+      CATALOG_DATABASE_OID);
+  database->DropTableWithOid(table_oid);
+  table = TestingTransactionUtil::CreateTable(
+      0, "RECOVERY_TABLE", CATALOG_DATABASE_OID, table_oid, 1234, true);
+
+  log_manager.SetDirectories(LOG_DIRS);
+  eid_t recovered_eid = log_manager.DoRecovery(2, CHECKPOINT_DIR);
+  EXPECT_LE(checkpoint_eid, recovered_eid);
+  EXPECT_LT(recovered_eid, epoch_manager.GetCurrentEpochId());
+
+  std::vector<std::pair<int, int>> expected = {
+      {0, -1}, {1, -1}, {2, 200}, {3, 0}, {9, 0}, {20, 20}};
+  auto txn = txn_manager.BeginTransaction();
+  for (auto &entry : expected) {
+    int result;
+    EXPECT_TRUE(
+        TestingTransactionUtil::ExecuteRead(txn, table, entry.first, result));
+    EXPECT_EQ(entry.second, result);
+  }
+  EXPECT_EQ(ResultType::SUCCESS, txn_manager.CommitTransaction(txn));
+
+  for (auto &dir : LOG_DIRS) {
+    logging::LoggingUtil::RemoveDirectory(dir.c_str(), false);
+  }
+  logging::LoggingUtil::RemoveDirectory(CHECKPOINT_DIR.c_str(), false);
+}
+
+TEST_F(LogicalLoggingTests, CatalogRecoveryTest) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  concurrency::EpochManagerFactory::GetInstance().Reset();
+  auto catalog = catalog::Catalog::GetInstance();
+
+  auto &log_manager = logging::LogicalLogManager::GetInstance();
+  log_manager.SetDirectories(LOG_DIRS);
+  log_manager.SetSynchronousCommit(false);
+  log_manager.StartLogging();
+
+  // the database and the table are only known from the logged catalog.
+  auto txn = txn_manager.BeginTransaction();
+  catalog->CreateDatabase(txn, "recovery_db");
+  auto id_column = catalog::Column(
+      type::TypeId::INTEGER, type::Type::GetTypeSize(type::TypeId::INTEGER),
+      "id", true);
+  auto value_column = catalog::Column(
+      type::TypeId::INTEGER, type::Type::GetTypeSize(type::TypeId::INTEGER),
+      "value", true);
+  std::unique_ptr<catalog::Schema> table_schema(
+      new catalog::Schema({id_column, value_column}));
+  catalog->CreateTable(txn, "recovery_db", DEFAULT_SCHEMA_NAME,
+                       std::move(table_schema), "recovery_table", false);
+  auto table_object = catalog->GetTableCatalogEntry(
+      txn, "recovery_db", DEFAULT_SCHEMA_NAME, "recovery_table");
+  oid_t database_oid = table_object->GetDatabaseOid();
+  oid_t table_oid = table_object->GetTableOid();
+  catalog->AddPrimaryKeyConstraint(txn, database_oid, table_oid, {0},
+                                   "con_primary");
+  auto table = catalog->GetTableWithName(txn, "recovery_db",
+                                         DEFAULT_SCHEMA_NAME, "recovery_table");
+  EXPECT_EQ(ResultType::SUCCESS, txn_manager.CommitTransaction(txn));
+
+  // (0, 0) ... (9, 0), then (0, 100)
+  txn = txn_manager.BeginTransaction();
+  for (int i = 0; i < 10; i++) {
+    EXPECT_TRUE(TestingTransactionUtil::ExecuteInsert(txn, table, i, 0));
+  }
+  EXPECT_EQ(ResultType::SUCCESS, txn_manager.CommitTransaction(txn));
+  txn = txn_manager.BeginTransaction();
+  EXPECT_TRUE(TestingTransactionUtil::ExecuteUpdate(txn, table, 0, 100));
+  EXPECT_EQ(ResultType::SUCCESS, txn_manager.CommitTransaction(txn));
+
+  log_manager.StopLogging();
+
+  // restart without the database.
+  txn = txn_manager.BeginTransaction();
+  catalog->DropDatabaseWithName(txn, "recovery_db");
+  EXPECT_EQ(ResultType::SUCCESS, txn_manager.CommitTransaction(txn));
+  storage::StorageManager::GetInstance()->RemoveDatabaseFromStorageManager(
+      database_oid);
+
+  log_manager.SetDirectories(LOG_DIRS);
+  EXPECT_NE(INVALID_EID, log_manager.DoRecovery(2));
+
+  txn = txn_manager.BeginTransaction();
+  table = catalog->GetTableWithName(txn, "recovery_db", DEFAULT_SCHEMA_NAME,
+                                    "recovery_table");
+  EXPECT_EQ(table_oid, table->GetOid());
+  std::vector<std::pair<int, int>> expected = {
+      {0, 100}, {1, 0}, {9, 0}, {10, -1}};
+  for (auto &entry : expected) {
+    int result;
+    EXPECT_TRUE(
+        TestingTransactionUtil::ExecuteRead(txn, table, entry.first, result));
+    EXPECT_EQ(entry.second, result);
+  }
+
+  // the oids of the recovered objects are not handed out again.
+  std::unique_ptr<catalog::Schema> new_schema(
+      new catalog::Schema({id_column, value_column}));
+  catalog->CreateTable(txn, "recovery_db", DEFAULT_SCHEMA_NAME,
+                       std::move(new_schema), "new_table", false);
+  EXPECT_LT(table_oid,
+            catalog->GetTableCatalogEntry(txn, "recovery_db",
+                                          DEFAULT_SCHEMA_NAME, "new_table")
+                ->GetTableOid());
+  catalog->DropDatabaseWithName(txn, "recovery_db");
+  EXPECT_EQ(ResultType::SUCCESS, txn_manager.CommitTransaction(txn));
+
+  for (auto &dir : LOG_DIRS) {
+    logging::LoggingUtil::RemoveDirectory(dir.c_str(), false);
+  }
+}
+
+}  // namespace test
+}  // namespace peloton
@@ -0,0 +1,172 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// hash_prefetch_performance_test.cpp
+//
+// Identification: test/performance/hash_prefetch_performance_test.cpp
+//
+// Copyright (c) 2015-18, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "codegen/counting_consumer.h"
+#include "codegen/query_compiler.h"
+#include "common/harness.h"
+#include "expression/tuple_value_expression.h"
+#include "planner/aggregate_plan.h"
+#include "planner/hash_join_plan.h"
+#include "planner/hash_plan.h"
+#include "planner/seq_scan_plan.h"
+#include "settings/settings_manager.h"
+
+#include "codegen/testing_codegen_util.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Hash Prefetch Performance Tests
+//===--------------------------------------------------------------------===//
+
+// Compares the codegen hash join and hash aggregation with and without
+// group-prefetching of their hash tables. Both hash tables hold one entry per
+// row, so they are well beyond the size of the caches.
+class HashPrefetchPerformanceTest : public PelotonCodeGenTest {
+ public:
+  HashPrefetchPerformanceTest() : PelotonCodeGenTest() {
+    LoadTestTable(ProbeTableId(), kNumRows);
+    LoadTestTable(BuildTableId(), kNumRows);
+  }
+
+  ~HashPrefetchPerformanceTest() {
+    settings::SettingsManager::SetBool(
+        settings::SettingId::codegen_hash_join_prefetch, false);
+    settings::SettingsManager::SetBool(
+        settings::SettingId::codegen_hash_group_by_prefetch, false);
+  }
+
+  oid_t ProbeTableId() const { return test_table_oids[0]; }
+
+  oid_t BuildTableId() const { return test_table_oids[1]; }
+
+  // SELECT probe.a, build.a FROM probe JOIN build ON probe.a = build.a
+  std::unique_ptr<planner::AbstractPlan> CreateJoinPlan();
+
+  // SELECT a, COUNT(*) FROM probe GROUP BY a
+  std::unique_ptr<planner::AbstractPlan> CreateAggregatePlan();
+
+  // Return the average execution time of the plan in milliseconds
+  double Execute(planner::AbstractPlan &plan, uint64_t expected_count);
+
+  static constexpr uint32_t kNumRows = 1 << 20;
+  static constexpr uint32_t kNumIterations = 5;
+};
+
+std::unique_ptr<planner::AbstractPlan>
+HashPrefetchPerformanceTest::CreateJoinPlan() {
+  DirectMapList direct_map_list = {{0, {0, 0}}, {1, {1, 0}}};
+  std::unique_ptr<planner::ProjectInfo> projection{
+      new planner::ProjectInfo(TargetList{}, std::move(direct_map_list))};
+
+  auto schema = std::shared_ptr<const catalog::Schema>(
+      new catalog::Schema({TestingExecutorUtil::GetColumnInfo(0),
+                           TestingExecutorUtil::GetColumnInfo(0)}));
+
+  std::vector<ConstExpressionPtr> left_hash_keys;
+  left_hash_keys.emplace_back(ColRefExpr(type::TypeId::INTEGER, 0));
+  std::vector<ConstExpressionPtr> right_hash_keys;
+  right_hash_keys.emplace_back(ColRefExpr(type::TypeId::INTEGER, 0));
+  std::vector<ConstExpressionPtr> hash_keys;
+  hash_keys.emplace_back(ColRefExpr(type::TypeId::INTEGER, 0));
+
+  std::unique_ptr<planner::AbstractPlan> hj_plan{
+      new planner::HashJoinPlan(JoinType::INNER, nullptr, std::move(projection),
+                                schema, left_hash_keys, right_hash_keys)};
+  std::unique_ptr<planner::AbstractPlan> hash_plan{
+      new planner::HashPlan(hash_keys)};
+
+  hash_plan->AddChild(std::unique_ptr<planner::AbstractPlan>{
+      new planner::SeqScanPlan(&GetTestTable(BuildTableId()), nullptr, {0})});
+  hj_plan->AddChild(std::unique_ptr<planner::AbstractPlan>{
+      new planner::SeqScanPlan(&GetTestTable(ProbeTableId()), nullptr, {0})});
+  hj_plan->AddChild(std::move(hash_plan));
+  return hj_plan;
+}
+
+std::unique_ptr<planner::AbstractPlan>
+HashPrefetchPerformanceTest::CreateAggregatePlan() {
+  DirectMapList direct_map_list = {{0, {0, 0}}, {1, {1, 0}}};
+  std::unique_ptr<planner::ProjectInfo> proj_info{
+      new planner::ProjectInfo(TargetList{}, std::move(direct_map_list))};
+
+  auto *tve_expr =
+      new expression::TupleValueExpression(type::TypeId::INTEGER, 0, 0);
+  std::vector<planner::AggregatePlan::AggTerm> agg_terms = {
+      {ExpressionType::AGGREGATE_COUNT_STAR, tve_expr}};
+  std::vector<oid_t> gb_cols = {0};
+
+  std::shared_ptr<const catalog::Schema> output_schema{
+      new catalog::Schema({{type::TypeId::INTEGER, 4, "COL_A"},
+                           {type::TypeId::BIGINT, 8, "COUNT_A"}})};
+
+  std::unique_ptr<planner::AbstractPlan> agg_plan{new planner::AggregatePlan(
+      std::move(proj_info), nullptr, std::move(agg_terms), std::move(gb_cols),
+      output_schema, AggregateType::HASH)};
+  agg_plan->AddChild(std::unique_ptr<planner::AbstractPlan>{
+      new planner::SeqScanPlan(&GetTestTable(ProbeTableId()), nullptr, {0})});
+  return agg_plan;
+}
+
+double HashPrefetchPerformanceTest::Execute(planner::AbstractPlan &plan,
+                                            uint64_t expected_count) {
+  planner::BindingContext context;
+  plan.PerformBinding(context);
+
+  double total_runtime = 0;
+  for (uint32_t i = 0; i < kNumIterations; i++) {
+    // Use simple CountConsumer since we don't care about the result
+    codegen::CountingConsumer consumer;
+    auto stats = CompileAndExecute(plan, consumer);
+    EXPECT_EQ(expected_count, consumer.GetCount());
+    total_runtime += stats.runtime_stats.plan_ms;
+  }
+  return total_runtime / kNumIterations;
+}
+
+TEST_F(HashPrefetchPerformanceTest, HashJoinTest) {
+  auto plan = CreateJoinPlan();
+
+  settings::SettingsManager::SetBool(
+      settings::SettingId::codegen_hash_join_prefetch, false);
+  double no_prefetch_ms = Execute(*plan, kNumRows);
+
+  settings::SettingsManager::SetBool(
+      settings::SettingId::codegen_hash_join_prefetch, true);
+  double prefetch_ms = Execute(*plan, kNumRows);
+
+  LOG_INFO("Hash join over %u rows: %0.2f ms without prefetching, "
+           "%0.2f ms with prefetching (%0.2fx)",
+           kNumRows, no_prefetch_ms, prefetch_ms,
+           no_prefetch_ms / prefetch_ms);
+}
+
+TEST_F(HashPrefetchPerformanceTest, HashGroupByTest) {
+  auto plan = CreateAggregatePlan();
+
+  settings::SettingsManager::SetBool(
+      settings::SettingId::codegen_hash_group_by_prefetch, false);
+  double no_prefetch_ms = Execute(*plan, kNumRows);
+
+  settings::SettingsManager::SetBool(
+      settings::SettingId::codegen_hash_group_by_prefetch, true);
+  double prefetch_ms = Execute(*plan, kNumRows);
+
+  LOG_INFO("Hash aggregation over %u groups: %0.2f ms without prefetching, "
+           "%0.2f ms with prefetching (%0.2fx)",
+           kNumRows, no_prefetch_ms, prefetch_ms,
+           no_prefetch_ms / prefetch_ms);
+}
+
+}  // namespace test
+}  // namespace peloton
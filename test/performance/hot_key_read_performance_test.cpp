@@ -0,0 +1,105 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// hot_key_read_performance_test.cpp
+//
+// Identification: test/performance/hot_key_read_performance_test.cpp
+//
+// Copyright (c) 2015-18, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <atomic>
+#include <memory>
+
+#include "common/harness.h"
+#include "common/timer.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "executor/testing_executor_util.h"
+#include "storage/data_table.h"
+#include "storage/tile_group.h"
+#include "storage/tile_group_header.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Hot Key Read Tests
+//===--------------------------------------------------------------------===//
+
+class HotKeyReadPerformanceTests : public PelotonTest {};
+
+std::atomic<uint64_t> hot_key_read_count;
+
+//===------------------------------===//
+// Utility
+//===------------------------------===//
+
+// Every transaction reads the same tuple, so all the threads update the
+// last reader cid of a single tuple header
+void ReadHotKey(storage::DataTable *table, uint64_t txn_count,
+                UNUSED_ATTRIBUTE uint64_t thread_itr) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+
+  auto tile_group = table->GetTileGroup(0);
+  auto tile_group_header = tile_group->GetHeader();
+  ItemPointer location(tile_group->GetTileGroupId(), 0);
+
+  uint64_t read_count = 0;
+  for (uint64_t txn_itr = 0; txn_itr < txn_count; txn_itr++) {
+    auto txn = txn_manager.BeginTransaction(
+        thread_itr, IsolationLevelType::SERIALIZABLE, false);
+
+    if (txn_manager.PerformRead(txn, location, tile_group_header, false)) {
+      read_count++;
+    } else {
+      txn_manager.SetTransactionResult(txn, ResultType::FAILURE);
+    }
+
+    if (txn->GetResult() == ResultType::FAILURE) {
+      txn_manager.AbortTransaction(txn);
+    } else {
+      txn_manager.CommitTransaction(txn);
+    }
+  }
+
+  hot_key_read_count += read_count;
+}
+
+TEST_F(HotKeyReadPerformanceTests, ReadTest) {
+  // Control the scale
+  oid_t reader_threads_count = 8;
+  uint64_t txn_count_per_reader = 100000;
+
+  std::unique_ptr<storage::DataTable> data_table(
+      TestingExecutorUtil::CreateTable(TEST_TUPLES_PER_TILEGROUP, false));
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  TestingExecutorUtil::PopulateTable(data_table.get(), 1, false, false, false,
+                                     txn);
+  txn_manager.CommitTransaction(txn);
+
+  hot_key_read_count = 0;
+
+  Timer<> timer;
+
+  timer.Start();
+
+  LaunchParallelTest(reader_threads_count, ReadHotKey, data_table.get(),
+                     txn_count_per_reader);
+
+  timer.Stop();
+  UNUSED_ATTRIBUTE auto duration = timer.GetDuration();
+
+  LOG_INFO("Duration: %.2lf", duration);
+  LOG_INFO("Throughput: %.2lf reads/s", hot_key_read_count.load() / duration);
+
+  // Nobody writes the tuple, so no read may fail
+  EXPECT_EQ(reader_threads_count * txn_count_per_reader,
+            hot_key_read_count.load());
+}
+
+}  // namespace test
+}  // namespace peloton
@@ -247,6 +247,32 @@ static void DeleteTest2(index::Index *index, size_t num_thread, size_t num_key,
   return;
 }
 
+/*
+ * LookupTest() - Tests ScanKey() performance for each index type
+ *
+ * Every thread looks up the keys it inserted with InsertTest2(), so the
+ * lookups interleave in the same way as the inserts
+ */
+static void LookupTest(index::Index *index, size_t num_thread, size_t num_key,
+                       uint64_t thread_id) {
+  std::unique_ptr<storage::Tuple> key(new storage::Tuple(key_schema, true));
+  std::vector<ItemPointer *> location_ptrs;
+
+  size_t j = 0;
+  for (size_t i = thread_id; j < num_key; (i += num_thread), j++) {
+    auto key_value = type::ValueFactory::GetIntegerValue(i);
+
+    key->SetValue(0, key_value, nullptr);
+    key->SetValue(1, key_value, nullptr);
+
+    index->ScanKey(key.get(), location_ptrs);
+    EXPECT_EQ(1, location_ptrs.size());
+    location_ptrs.clear();
+  }
+
+  return;
+}
+
 /*
  * TestIndexPerformance() - Test driver for indices of a given type
  *
@@ -365,10 +391,64 @@ static void TestIndexPerformance(const IndexType &index_type) {
   return;
 }
 
+/*
+ * TestIndexThroughput() - Compares the throughput of indices of the given
+ * types on the same insert-heavy workload
+ *
+ * The threads first insert interleaved keys as in InsertTest2(), which
+ * contends on neighbouring keys, and then look all of them up again
+ */
+static void TestIndexThroughput(const std::vector<IndexType> &index_types) {
+  // Number of threads doing insert or lookup
+  size_t num_thread = 4;
+
+  // Number of keys inserted by each thread
+  size_t num_key = 1024 * 256;
+
+  double total_keys = static_cast<double>(num_thread * num_key);
+
+  for (const auto &index_type : index_types) {
+    std::unique_ptr<index::Index> index(BuildIndex(false, index_type));
+    Timer<> timer;
+
+    timer.Start();
+    LaunchParallelTest(num_thread, InsertTest2, index.get(), num_thread,
+                       num_key);
+    timer.Stop();
+    double insert_duration = timer.GetDuration();
+
+    if (index->NeedGC() == true) {
+      index->PerformGC();
+    }
+
+    timer.Reset();
+    timer.Start();
+    LaunchParallelTest(num_thread, LookupTest, index.get(), num_thread,
+                       num_key);
+    timer.Stop();
+    double lookup_duration = timer.GetDuration();
+
+    LOG_INFO("Throughput :: Type=%s; Insert=%.0lf keys/s; Lookup=%.0lf keys/s",
+             IndexTypeToString(index_type).c_str(),
+             total_keys / insert_duration, total_keys / lookup_duration);
+
+    delete tuple_schema;
+  }
+
+  return;
+}
+
 TEST_F(IndexPerformanceTests, BwTreeMultiThreadedTest) {
   TestIndexPerformance(IndexType::BWTREE);
 }
 
+TEST_F(IndexPerformanceTests, SkipListMultiThreadedTest) {
+  TestIndexPerformance(IndexType::SKIPLIST);
+
+  // The skip list is meant to replace the BwTree, so compare the two
+  TestIndexThroughput({IndexType::SKIPLIST, IndexType::BWTREE});
+}
+
 // TEST_F(IndexPerformanceTests, BTreeMultiThreadedTest) {
 //  TestIndexPerformance(IndexType::BTREE);
 //}
@@ -0,0 +1,113 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// recovery_performance_test.cpp
+//
+// Identification: test/performance/recovery_performance_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <string>
+#include <vector>
+
+#include "catalog/catalog_defaults.h"
+#include "common/harness.h"
+#include "common/timer.h"
+#include "concurrency/testing_transaction_util.h"
+#include "logging/logging_util.h"
+#include "logging/logical_log_manager.h"
+#include "logging/logical_log_replayer.h"
+#include "storage/database.h"
+#include "storage/storage_manager.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Recovery Performance Tests
+//===--------------------------------------------------------------------===//
+
+class RecoveryPerformanceTests : public PelotonTest {};
+
+static const std::vector<std::string> RECOVERY_LOG_DIRS = {
+    "recovery_perf_log_0", "recovery_perf_log_1"};
+
+static void LoadTable(storage::DataTable *table, int key_begin, int key_count,
+                      int txn_size, UNUSED_ATTRIBUTE uint64_t thread_itr) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+
+  for (int txn_begin = 0; txn_begin < key_count; txn_begin += txn_size) {
+    auto txn = txn_manager.BeginTransaction();
+    for (int key = txn_begin; key < txn_begin + txn_size && key < key_count;
+         ++key) {
+      int id = key_begin + (int)thread_itr * key_count + key;
+      TestingTransactionUtil::ExecuteInsert(txn, table, id, id);
+    }
+    txn_manager.CommitTransaction(txn);
+  }
+}
+
+TEST_F(RecoveryPerformanceTests, ReplayThroughputTest) {
+  // Control the scale
+  size_t loader_thread_count = 4;
+  int key_count_per_loader = 50000;
+  int txn_size = 10;
+  std::vector<size_t> recovery_thread_counts = {1, 2, 4};
+
+  concurrency::EpochManagerFactory::GetInstance().Reset();
+  oid_t table_oid = (OID_FOR_USER_OFFSET + 1) | TABLE_OID_MASK;
+
+  auto &log_manager = logging::LogicalLogManager::GetInstance();
+  log_manager.SetDirectories(RECOVERY_LOG_DIRS);
+  log_manager.SetSynchronousCommit(false);
+  log_manager.StartLogging();
+
+  storage::DataTable *table = TestingTransactionUtil::CreateTable(
+      0, "RECOVERY_TABLE", CATALOG_DATABASE_OID, table_oid, 1234, true);
+  LaunchParallelTest(loader_thread_count, LoadTable, table, 0,
+                     key_count_per_loader, txn_size);
+
+  log_manager.StopLogging();
+
+  std::string pepoch_file = RECOVERY_LOG_DIRS[0] + "/pepoch";
+  auto database = storage::StorageManager::GetInstance()->GetDatabaseWithOid(
+      CATALOG_DATABASE_OID);
+
+  for (auto recovery_thread_count : recovery_thread_counts) {
+    // restart with an empty table.
+    database->DropTableWithOid(table_oid);
+    table = TestingTransactionUtil::CreateTable(
+        0, "RECOVERY_TABLE", CATALOG_DATABASE_OID, table_oid, 1234, true);
+
+    logging::LogicalLogReplayer replayer(RECOVERY_LOG_DIRS, pepoch_file,
+                                         recovery_thread_count);
+
+    Timer<> timer;
+    timer.Start();
+
+    eid_t persist_eid = replayer.ReadPersistEpochId();
+    replayer.Replay(persist_eid);
+
+    timer.Stop();
+    double duration = timer.GetDuration();
+
+    EXPECT_EQ(loader_thread_count * key_count_per_loader,
+              replayer.GetRecoveredTupleCount());
+
+    double gigabytes =
+        (double)replayer.GetReplayedBytes() / (1024 * 1024 * 1024);
+    LOG_INFO("Recovery threads: %lu, replayed %.2lf MB in %.3lf s: %.3lf GB/s",
+             recovery_thread_count, gigabytes * 1024, duration,
+             gigabytes / duration);
+  }
+
+  for (auto &dir : RECOVERY_LOG_DIRS) {
+    logging::LoggingUtil::RemoveDirectory(dir.c_str(), false);
+  }
+}
+
+}  // namespace test
+}  // namespace peloton
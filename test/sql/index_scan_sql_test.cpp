@@ -17,7 +17,9 @@
 #include "common/harness.h"
 #include "concurrency/transaction_manager_factory.h"
 #include "executor/create_executor.h"
+#include "optimizer/optimizer.h"
 #include "planner/create_plan.h"
+#include "planner/index_scan_plan.h"
 
 namespace peloton {
 namespace test {
@@ -231,5 +233,54 @@ TEST_F(IndexScanSQLTests, SQLTest) {
   txn_manager.CommitTransaction(txn);
 }
 
+TEST_F(IndexScanSQLTests, InListTest) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  catalog::Catalog::GetInstance()->CreateDatabase(txn, DEFAULT_DB_NAME);
+  txn_manager.CommitTransaction(txn);
+
+  CreateAndLoadTable();
+
+  std::vector<ResultValue> result;
+  std::vector<FieldInfo> tuple_descriptor;
+  std::string error_message;
+  int rows_changed;
+  std::unique_ptr<optimizer::AbstractOptimizer> optimizer(
+      new optimizer::Optimizer());
+  TestingSQLUtil::ExecuteSQLQuery("CREATE INDEX i1 ON test USING HASH (a);",
+                                  result, tuple_descriptor, rows_changed,
+                                  error_message);
+
+  // A disjunction of equalities on a is an IN list, and the hash index
+  // probes one key per value
+  std::string query("SELECT b FROM test WHERE a = 1 OR a = 3 OR a = 4;");
+  txn = txn_manager.BeginTransaction();
+  auto plan = TestingSQLUtil::GeneratePlanWithOptimizer(optimizer, query, txn);
+  txn_manager.CommitTransaction(txn);
+  ASSERT_EQ(PlanNodeType::INDEXSCAN, plan->GetPlanNodeType());
+  auto index_scan_plan = static_cast<planner::IndexScanPlan *>(plan.get());
+  EXPECT_EQ(std::vector<ExpressionType>(3, ExpressionType::COMPARE_IN),
+            index_scan_plan->GetExprTypes());
+
+  TestingSQLUtil::ExecuteSQLQueryWithOptimizer(
+      optimizer, "SELECT b FROM test WHERE a = 1 OR a = 3 OR a = 4 ORDER BY b;",
+      result, tuple_descriptor, rows_changed, error_message);
+  ASSERT_EQ(2, result.size());
+  EXPECT_EQ("11", TestingSQLUtil::GetResultValueAsString(result, 0));
+  EXPECT_EQ("22", TestingSQLUtil::GetResultValueAsString(result, 1));
+
+  // Equalities on different columns are not an IN list
+  query = "SELECT b FROM test WHERE a = 1 OR b = 11;";
+  txn = txn_manager.BeginTransaction();
+  plan = TestingSQLUtil::GeneratePlanWithOptimizer(optimizer, query, txn);
+  txn_manager.CommitTransaction(txn);
+  EXPECT_EQ(PlanNodeType::SEQSCAN, plan->GetPlanNodeType());
+
+  // free the database just created
+  txn = txn_manager.BeginTransaction();
+  catalog::Catalog::GetInstance()->DropDatabaseWithName(txn, DEFAULT_DB_NAME);
+  txn_manager.CommitTransaction(txn);
+}
+
 }  // namespace test
 }  // namespace peloton
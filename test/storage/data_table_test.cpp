@@ -19,6 +19,8 @@
 #include "storage/database.h"
 
 #include "concurrency/transaction_manager_factory.h"
+#include "index/index.h"
+#include "type/value_factory.h"
 
 namespace peloton {
 namespace test {
@@ -87,5 +89,55 @@ TEST_F(DataTableTests, GlobalTableTest) {
   txn_manager.CommitTransaction(txn);
 }
 
+TEST_F(DataTableTests, InsertTuplesTest) {
+  const int tuple_count = TESTS_TUPLES_PER_TILEGROUP;
+  auto pool = TestingHarness::GetInstance().GetTestingPool();
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<storage::DataTable> data_table(
+      TestingExecutorUtil::CreateTable(tuple_count, true));
+
+  // Insert a batch that spans more than one tile group
+  std::vector<ItemPointer> locations;
+  for (int i = 0; i < tuple_count + 5; i++) {
+    auto tuple = TestingExecutorUtil::GetTuple(data_table.get(), i, pool);
+    locations.push_back(data_table->GetEmptyTupleSlot(tuple.get()));
+  }
+  std::vector<ItemPointer *> index_entry_ptrs;
+  EXPECT_TRUE(data_table->InsertTuples(locations, txn, index_entry_ptrs));
+  EXPECT_EQ(locations.size(), index_entry_ptrs.size());
+  for (size_t i = 0; i < locations.size(); i++) {
+    EXPECT_EQ(locations[i].block, index_entry_ptrs[i]->block);
+    EXPECT_EQ(locations[i].offset, index_entry_ptrs[i]->offset);
+    txn_manager.PerformInsert(txn, locations[i], index_entry_ptrs[i]);
+  }
+  EXPECT_EQ(locations.size(), data_table->GetTupleCount());
+
+  // Every tuple can be found through the primary key
+  auto pkey_index = data_table->GetIndex(0);
+  storage::Tuple key(pkey_index->GetKeySchema(), true);
+  for (size_t i = 0; i < locations.size(); i++) {
+    key.SetValue(0, type::ValueFactory::GetIntegerValue(
+                        TestingExecutorUtil::PopulatedValue(i, 0)),
+                 pool);
+    std::vector<ItemPointer *> result;
+    pkey_index->ScanKey(&key, result);
+    ASSERT_EQ(1, result.size());
+    EXPECT_EQ(index_entry_ptrs[i], result[0]);
+  }
+
+  // A batch that repeats a primary key is rejected
+  std::vector<ItemPointer> duplicate_locations;
+  for (int i : {tuple_count + 5, tuple_count + 6, tuple_count + 5}) {
+    auto tuple = TestingExecutorUtil::GetTuple(data_table.get(), i, pool);
+    duplicate_locations.push_back(data_table->GetEmptyTupleSlot(tuple.get()));
+  }
+  EXPECT_FALSE(data_table->InsertTuples(duplicate_locations, txn,
+                                        index_entry_ptrs));
+
+  txn_manager.AbortTransaction(txn);
+}
+
 }  // namespace test
 }  // namespace peloton
@@ -540,5 +540,43 @@ TEST_F(TileGroupTests, TileCopyTest) {
   EXPECT_TRUE(intended_behavior);
 }
 
+TEST_F(TileGroupTests, AllVisibleTest) {
+  storage::TileGroupHeader header(BackendType::MM, 4);
+  ItemPointer location(0, 0);
+  ItemPointer *indirection = &location;
+
+  // A new tile group is not all-visible until the GC marks it
+  EXPECT_FALSE(header.IsAllVisible());
+
+  auto tuple_slot_id = header.GetNextEmptyTupleSlot();
+  EXPECT_EQ(0, tuple_slot_id);
+  header.SetIndirection(tuple_slot_id, indirection);
+  header.SetTransactionId(tuple_slot_id, 1234);
+  uint64_t write_stamp = header.GetWriteStamp();
+  EXPECT_EQ(1, write_stamp);
+  header.SetTransactionId(tuple_slot_id, INITIAL_TXN_ID);
+  EXPECT_EQ(write_stamp, header.GetWriteStamp());
+
+  header.SetAllVisible(write_stamp);
+  EXPECT_TRUE(header.IsAllVisible());
+  EXPECT_TRUE(header.IsVisibleToAll(tuple_slot_id, indirection));
+
+  // An index entry must lead to the tuple through its own indirection
+  ItemPointer other_indirection(0, 0);
+  EXPECT_FALSE(header.IsVisibleToAll(tuple_slot_id, &other_indirection));
+
+  // Taking over a tuple clears the mark
+  EXPECT_TRUE(header.SetAtomicTransactionId(tuple_slot_id, 1235));
+  EXPECT_FALSE(header.IsAllVisible());
+  EXPECT_FALSE(header.IsVisibleToAll(tuple_slot_id, indirection));
+
+  // Marking with a stamp read before the write has no effect
+  header.SetTransactionId(tuple_slot_id, INITIAL_TXN_ID);
+  header.SetAllVisible(write_stamp);
+  EXPECT_FALSE(header.IsAllVisible());
+  header.SetAllVisible(header.GetWriteStamp());
+  EXPECT_TRUE(header.IsAllVisible());
+}
+
 }  // namespace test
 }  // namespace peloton
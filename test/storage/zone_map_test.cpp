@@ -29,6 +29,7 @@
 #include "catalog/zone_map_catalog.h"
 #include "expression/abstract_expression.h"
 #include "expression/expression_util.h"
+#include "concurrency/testing_transaction_util.h"
 #include "concurrency/transaction_manager_factory.h"
 
 namespace peloton {
@@ -418,6 +419,98 @@ TEST_F(ZoneMapTests, ZoneMapMultiColumnConjunctionPredicateTest) {
   pred4->ClearParsedPredicates();
   delete conj_pred;
 }
+
+TEST_F(ZoneMapTests, ZoneMapRawContentsTest) {
+  std::unique_ptr<storage::DataTable> data_table(CreateTestTable());
+  oid_t num_tile_groups = (data_table.get())->GetTileGroupCount();
+  storage::ZoneMapManager *zone_map_manager =
+      storage::ZoneMapManager::GetInstance();
+
+  std::vector<storage::RawColumnStatistics> raw_stats(4);
+  for (oid_t i = 0; i < num_tile_groups - 1; i++) {
+    oid_t tile_group_id = data_table->GetTileGroup(i)->GetTileGroupId();
+    auto zone_map = zone_map_manager->GetZoneMap(tile_group_id);
+    ASSERT_NE(nullptr, zone_map);
+    EXPECT_TRUE(
+        zone_map_manager->GetRawZoneMap(tile_group_id, raw_stats.data()));
+
+    int max = ((TESTS_TUPLES_PER_TILEGROUP * (i + 1)) - 1) * 10;
+    int min = (TESTS_TUPLES_PER_TILEGROUP * (i)) * 10;
+    // Integer Columns
+    for (int j = 0; j < 2; j++) {
+      EXPECT_EQ(min + j, raw_stats[j].min_integer);
+      EXPECT_EQ(max + j, raw_stats[j].max_integer);
+      EXPECT_EQ(min + j, zone_map->stats[j].min.GetAs<int>());
+      EXPECT_EQ(max + j, zone_map->stats[j].max.GetAs<int>());
+    }
+    // Decimal Column
+    EXPECT_EQ((double)(min + 2), raw_stats[2].min_decimal);
+    EXPECT_EQ((double)(max + 2), raw_stats[2].max_decimal);
+    EXPECT_EQ(0, raw_stats[2].null_count);
+  }
+
+  // The last tile group is still mutable, so it has no zone map.
+  oid_t last_tile_group_id =
+      data_table->GetTileGroup(num_tile_groups - 1)->GetTileGroupId();
+  EXPECT_EQ(nullptr, zone_map_manager->GetZoneMap(last_tile_group_id));
+  EXPECT_FALSE(
+      zone_map_manager->GetRawZoneMap(last_tile_group_id, raw_stats.data()));
+}
+
+TEST_F(ZoneMapTests, ZoneMapIncrementalMaintenanceTest) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  storage::ZoneMapManager *zone_map_manager =
+      storage::ZoneMapManager::GetInstance();
+  zone_map_manager->CreateZoneMapTableInCatalog();
+
+  // Only user tables are maintained.
+  oid_t table_oid = (OID_FOR_USER_OFFSET + 2) | TABLE_OID_MASK;
+  std::unique_ptr<storage::DataTable> data_table(
+      TestingTransactionUtil::CreateTable(0, "ZONE_MAP_TABLE",
+                                          CATALOG_DATABASE_OID, table_oid,
+                                          1234, true, 5));
+  auto tile_group = data_table->GetTileGroup(0);
+
+  // This insert is still running when the tile group fills up.
+  auto txn = txn_manager.BeginTransaction();
+  EXPECT_TRUE(
+      TestingTransactionUtil::ExecuteInsert(txn, data_table.get(), 0, 0));
+
+  auto fill_txn = txn_manager.BeginTransaction();
+  for (int id = 1; id < 5; id++) {
+    EXPECT_TRUE(TestingTransactionUtil::ExecuteInsert(
+        fill_txn, data_table.get(), id, id));
+  }
+  EXPECT_EQ(ResultType::SUCCESS, txn_manager.CommitTransaction(fill_txn));
+
+  // The full tile group is frozen and gets zone maps without any scan of the
+  // table.
+  EXPECT_TRUE(tile_group->GetHeader()->GetImmutability());
+  std::vector<storage::RawColumnStatistics> raw_stats(2);
+  EXPECT_TRUE(zone_map_manager->GetRawZoneMap(tile_group->GetTileGroupId(),
+                                              raw_stats.data()));
+  EXPECT_EQ(0, raw_stats[1].min_integer);
+  EXPECT_EQ(4, raw_stats[1].max_integer);
+
+  // The running transaction changes its own version in place, so the zone
+  // maps are widened when it commits.
+  EXPECT_TRUE(
+      TestingTransactionUtil::ExecuteUpdate(txn, data_table.get(), 0, 100));
+  EXPECT_EQ(ResultType::SUCCESS, txn_manager.CommitTransaction(txn));
+
+  EXPECT_TRUE(zone_map_manager->GetRawZoneMap(tile_group->GetTileGroupId(),
+                                              raw_stats.data()));
+  EXPECT_EQ(100, raw_stats[1].max_integer);
+
+  std::vector<storage::PredicateInfo> predicates = {
+      {1, (int)ExpressionType::COMPARE_GREATERTHAN,
+       type::ValueFactory::GetIntegerValue(50)}};
+  EXPECT_TRUE(zone_map_manager->ShouldScanTileGroup(predicates.data(), 1,
+                                                    data_table.get(), 0));
+  predicates[0].predicate_value = type::ValueFactory::GetIntegerValue(100);
+  EXPECT_FALSE(zone_map_manager->ShouldScanTileGroup(predicates.data(), 1,
+                                                     data_table.get(), 0));
+}
 }
 }  // End test namespace
 }  // End peloton namespace
\ No newline at end of file
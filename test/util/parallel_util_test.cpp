@@ -0,0 +1,69 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// parallel_util_test.cpp
+//
+// Identification: test/util/parallel_util_test.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "common/harness.h"
+#include "common/logger.h"
+
+#include <atomic>
+#include <functional>
+#include <random>
+
+#include "util/parallel_util.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// ParallelUtil Test
+//===--------------------------------------------------------------------===//
+
+class ParallelUtilTests : public PelotonTest {};
+
+TEST_F(ParallelUtilTests, ParallelForTest) {
+  for (size_t size : {(size_t)0, (size_t)1, (size_t)100,
+                      ParallelUtil::kMinPartitionSize * 7 + 3}) {
+    std::vector<int> visits(size, 0);
+    std::atomic<size_t> partitions(0);
+    ParallelUtil::ParallelFor(size, [&](size_t begin, size_t end) {
+      EXPECT_LE(begin, end);
+      for (size_t i = begin; i < end; i++) {
+        visits[i]++;
+      }
+      partitions++;
+    });
+
+    // Every position is visited exactly once
+    for (size_t i = 0; i < size; i++) {
+      EXPECT_EQ(1, visits[i]);
+    }
+    EXPECT_EQ(ParallelUtil::GetPartitionCount(size), partitions.load());
+  }
+}
+
+TEST_F(ParallelUtilTests, SortTest) {
+  std::mt19937 rng(0);
+  for (size_t size : {(size_t)0, (size_t)1, (size_t)1000,
+                      ParallelUtil::kMinPartitionSize * 5 + 11}) {
+    std::vector<int> values(size);
+    for (auto &value : values) {
+      value = rng() % 1000;
+    }
+    std::vector<int> expected = values;
+    std::sort(expected.begin(), expected.end(), std::greater<int>());
+
+    ParallelUtil::Sort(values.begin(), values.end(), std::greater<int>());
+    EXPECT_EQ(expected, values);
+  }
+}
+
+}  // namespace test
+}  // namespace peloton
@@ -12,11 +12,12 @@ using Deleter = void (*)(void *);
 
 struct Garbage {
   void *n;
+  std::size_t size;
   Deleter deleter_func;
 
-  Garbage() : n(nullptr), deleter_func() {}
-  Garbage(void *_n, Deleter _deleter_func)
-      : n(_n), deleter_func(_deleter_func) {
+  Garbage() : n(nullptr), size(0), deleter_func() {}
+  Garbage(void *_n, std::size_t _size, Deleter _deleter_func)
+      : n(_n), size(_size), deleter_func(_deleter_func) {
     assert(n);
     assert(deleter_func);
   }
@@ -49,7 +50,8 @@ class DeletionList {
 
   LabelDelete *head();
 
-  void add(void *n, Deleter deleter_func, uint64_t globalEpoch);
+  void add(void *n, std::size_t size, Deleter deleter_func,
+           uint64_t globalEpoch);
 
   void remove(LabelDelete *label, LabelDelete *prev);
 
@@ -89,6 +91,15 @@ class Epoch {
 
   size_t startGCThreshhold;
 
+  // Bytes of node memory currently allocated by the tree, including nodes
+  // that have been unlinked but not yet freed
+  std::atomic<uint64_t> allocatedBytes{0};
+
+  // Bytes of node memory unlinked and waiting for the epoch to pass
+  std::atomic<uint64_t> garbageBytes{0};
+
+  void freeGarbage(Garbage &garbage);
+
  public:
   Epoch(size_t startGCThreshhold) : startGCThreshhold(startGCThreshhold) {}
 
@@ -96,10 +107,23 @@ class Epoch {
 
   void enterEpoch(ThreadInfo &threadInfo);
 
-  void markNodeForDeletion(void *n, ThreadInfo &threadInfo);
-  void markNodeForDeletion(void *n, Deleter deleter_func,
+  void markNodeForDeletion(void *n, std::size_t size, ThreadInfo &threadInfo);
+  void markNodeForDeletion(void *n, std::size_t size, Deleter deleter_func,
                            ThreadInfo &threadInfo);
 
+  /// Record a node allocation of the given size
+  void trackAllocation(std::size_t size) {
+    allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+  }
+
+  std::size_t getAllocatedBytes() const {
+    return allocatedBytes.load(std::memory_order_relaxed);
+  }
+
+  std::size_t getGarbageBytes() const {
+    return garbageBytes.load(std::memory_order_relaxed);
+  }
+
   void exitEpochAndCleanup(ThreadInfo &threadInfo);
 
   void showDeleteRatio();
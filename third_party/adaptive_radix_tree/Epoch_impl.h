@@ -37,7 +37,8 @@ void DeletionList::remove(LabelDelete *label, LabelDelete *prev) {
   deleted += label->nodesCount;
 }
 
-void DeletionList::add(void *n, Deleter deleter_func, uint64_t globalEpoch) {
+void DeletionList::add(void *n, std::size_t size, Deleter deleter_func,
+                       uint64_t globalEpoch) {
   deletitionListCount++;
   LabelDelete *label;
   if (headDeletionList != nullptr &&
@@ -54,7 +55,7 @@ void DeletionList::add(void *n, Deleter deleter_func, uint64_t globalEpoch) {
     label->next = headDeletionList;
     headDeletionList = label;
   }
-  label->nodes[label->nodesCount] = Garbage{n, deleter_func};
+  label->nodes[label->nodesCount] = Garbage{n, size, deleter_func};
   label->nodesCount++;
   label->epoch = globalEpoch;
 
@@ -75,16 +76,24 @@ void stdOperatorDelete(void *n) {
 }
 }  // anonymous namespace
 
-void Epoch::markNodeForDeletion(void *n, ThreadInfo &threadInfo) {
-  markNodeForDeletion(n, stdOperatorDelete, threadInfo);
+void Epoch::markNodeForDeletion(void *n, std::size_t size,
+                                ThreadInfo &threadInfo) {
+  markNodeForDeletion(n, size, stdOperatorDelete, threadInfo);
 }
 
-void Epoch::markNodeForDeletion(void *n, Deleter deleter_func,
-                                ThreadInfo &threadInfo) {
-  threadInfo.getDeletionList().add(n, deleter_func, currentEpoch.load());
+void Epoch::markNodeForDeletion(void *n, std::size_t size,
+                                Deleter deleter_func, ThreadInfo &threadInfo) {
+  garbageBytes.fetch_add(size, std::memory_order_relaxed);
+  threadInfo.getDeletionList().add(n, size, deleter_func, currentEpoch.load());
   threadInfo.getDeletionList().thresholdCounter++;
 }
 
+void Epoch::freeGarbage(Garbage &garbage) {
+  garbage.Delete();
+  garbageBytes.fetch_sub(garbage.size, std::memory_order_relaxed);
+  allocatedBytes.fetch_sub(garbage.size, std::memory_order_relaxed);
+}
+
 void Epoch::exitEpochAndCleanup(ThreadInfo &threadInfo) {
   DeletionList &deletionList = threadInfo.getDeletionList();
   if ((deletionList.thresholdCounter & (64 - 1)) == 1) {
@@ -115,7 +124,7 @@ void Epoch::exitEpochAndCleanup(ThreadInfo &threadInfo) {
 
       if (cur->epoch < oldestEpoch) {
         for (std::size_t i = 0; i < cur->nodesCount; ++i) {
-          cur->nodes[i].Delete();
+          freeGarbage(cur->nodes[i]);
         }
         deletionList.remove(cur, prev);
       } else {
@@ -145,7 +154,7 @@ Epoch::~Epoch() {
 
       assert(cur->epoch < oldestEpoch);
       for (std::size_t i = 0; i < cur->nodesCount; ++i) {
-        cur->nodes[i].Delete();
+        freeGarbage(cur->nodes[i]);
       }
       deletionList->remove(cur, prev);
       cur = next;
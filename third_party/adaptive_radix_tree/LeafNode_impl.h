@@ -164,7 +164,7 @@ bool LeafNode::insertGrow(Node *n, TID val,
     }
 
     // We need to create a new external leaf
-    auto *newLeaf = LeafNode::create(4);
+    auto *newLeaf = LeafNode::create(4, 0, threadInfo);
     newLeaf->insertNoDupCheck(tid);
     newLeaf->insertNoDupCheck(val);
     Node::change(parent, parentKey, setExternal(newLeaf));
@@ -199,14 +199,17 @@ bool LeafNode::insertGrow(Node *n, TID val,
       return false;
     }
 
-    auto *newLeaf = LeafNode::create(leaf->capacity * 2);
+    auto *newLeaf =
+        LeafNode::create(leaf->capacity * 2, leaf->keyLen, threadInfo);
     leaf->copyTo(newLeaf);
     bool inserted = newLeaf->insert(val);
 
     Node::change(parent, parentKey, setExternal(newLeaf));
 
     leaf->writeUnlockObsolete();
-    threadInfo.getEpoch().markNodeForDeletion(leaf, doDeleteLeaf, threadInfo);
+    threadInfo.getEpoch().markNodeForDeletion(
+        leaf, LeafNode::sizeOf(leaf->capacity, leaf->keyLen), doDeleteLeaf,
+        threadInfo);
     parent->writeUnlock();
 
     return inserted;
@@ -229,7 +232,7 @@ bool LeafNode::insertGrow(Node *n, TID val,
 }
 
 bool LeafNode::removeShrink(Node *n, TID val, uint8_t parentKey, Node *parent,
-                            uint64_t pv, bool &needRestart,
+                            uint64_t pv, bool inlineLast, bool &needRestart,
                             ThreadInfo &threadInfo) {
   // Removal of an inlined leaf node must be handled outside this function
   // because we would need to know the node, its parent, its grand parent,
@@ -250,8 +253,17 @@ bool LeafNode::removeShrink(Node *n, TID val, uint8_t parentKey, Node *parent,
     return false;
   }
 
-  // If the leaf is under-full, we'll inline the remaining TID into the parent
-  if (leaf->count == 2) {
+  // A leaf that carries the key is unlinked by the caller when its last TID
+  // is removed. It got here because the leaf shrank concurrently, so retry
+  if (!inlineLast && leaf->count == 1) {
+    leaf->readUnlockOrRestart(v, needRestart);
+    needRestart = true;
+    return false;
+  }
+
+  // If the leaf is under-full, we'll inline the remaining TID into the parent.
+  // Leaves that carry the key are never inlined
+  if (inlineLast && leaf->count == 2) {
     parent->upgradeToWriteLockOrRestart(pv, needRestart);
     if (needRestart) return false;
 
@@ -265,7 +277,9 @@ bool LeafNode::removeShrink(Node *n, TID val, uint8_t parentKey, Node *parent,
     Node::change(parent, parentKey, LeafNode::setInlined(second));
 
     leaf->writeUnlockObsolete();
-    threadInfo.getEpoch().markNodeForDeletion(leaf, doDeleteLeaf, threadInfo);
+    threadInfo.getEpoch().markNodeForDeletion(
+        leaf, LeafNode::sizeOf(leaf->capacity, leaf->keyLen), doDeleteLeaf,
+        threadInfo);
     parent->writeUnlock();
     return true;
   }
@@ -281,10 +295,68 @@ bool LeafNode::removeShrink(Node *n, TID val, uint8_t parentKey, Node *parent,
   return true;
 }
 
-LeafNode *LeafNode::create(uint32_t capacity) {
-  void *mem = malloc(sizeof(LeafNode) + (sizeof(TID) * capacity));
+LeafNode *LeafNode::create(uint32_t capacity, uint32_t keyLen,
+                           ThreadInfo &threadInfo) {
+  void *mem = malloc(sizeOf(capacity, keyLen));
   assert(mem);
-  return new (mem) LeafNode(capacity);
+  threadInfo.getEpoch().trackAllocation(sizeOf(capacity, keyLen));
+  return new (mem) LeafNode(capacity, keyLen);
+}
+
+//===----------------------------------------------------------------------===//
+//
+// LEAVES WITH KEYS
+//
+//===----------------------------------------------------------------------===//
+
+Node *LeafNode::createWithKey(const Key &k, TID tid, ThreadInfo &threadInfo) {
+  // Most keys are unique, so start with room for a single TID
+  auto *leaf = LeafNode::create(1, k.getKeyLen(), threadInfo);
+  memcpy(leaf->getKeyData(), &k[0], k.getKeyLen());
+  leaf->insertNoDupCheck(tid);
+  return setExternal(leaf);
+}
+
+void LeafNode::loadKey(const Node *n, Key &key) {
+  assert(isExternal(n));
+  const auto *leaf = getExternal(n);
+  assert(leaf->keyLen > 0);
+  key.set(reinterpret_cast<const char *>(leaf->getKeyData()), leaf->keyLen);
+}
+
+bool LeafNode::lockIfOnly(Node *n, TID val, bool &needRestart) {
+  assert(isExternal(n));
+  auto *leaf = getExternal(n);
+
+  uint64_t v = leaf->readLockOrRestart(needRestart);
+  if (needRestart) return false;
+
+  if (leaf->count != 1 || leaf->vals[0] != val) {
+    leaf->readUnlockOrRestart(v, needRestart);
+    return false;
+  }
+
+  leaf->upgradeToWriteLockOrRestart(v, needRestart);
+  return !needRestart;
+}
+
+void LeafNode::unlock(Node *n) { getExternal(n)->writeUnlock(); }
+
+void LeafNode::unlinkLocked(Node *n, ThreadInfo &threadInfo) {
+  auto *leaf = getExternal(n);
+  leaf->writeUnlockObsolete();
+  threadInfo.getEpoch().markNodeForDeletion(
+      leaf, LeafNode::sizeOf(leaf->capacity, leaf->keyLen), doDeleteLeaf,
+      threadInfo);
+}
+
+void LeafNode::discard(Node *n, ThreadInfo &threadInfo) {
+  if (isExternal(n)) {
+    auto *leaf = getExternal(n);
+    threadInfo.getEpoch().markNodeForDeletion(
+        leaf, LeafNode::sizeOf(leaf->capacity, leaf->keyLen), doDeleteLeaf,
+        threadInfo);
+  }
 }
 
 //===----------------------------------------------------------------------===//
@@ -293,8 +365,8 @@ LeafNode *LeafNode::create(uint32_t capacity) {
 //
 //===----------------------------------------------------------------------===//
 
-LeafNode::LeafNode(uint32_t _capacity)
-    : lock(0), count(0), capacity(_capacity) {
+LeafNode::LeafNode(uint32_t _capacity, uint32_t _keyLen)
+    : lock(0), count(0), capacity(_capacity), keyLen(_keyLen) {
   memset(vals, 0, sizeof(TID) * capacity);
 }
 
@@ -359,6 +431,8 @@ void LeafNode::copyTo(LeafNode *other) const {
   for (uint32_t i = 0; i < count; i++) {
     other->insertNoDupCheck(vals[i]);
   }
+  assert(other->keyLen == keyLen);
+  memcpy(other->getKeyData(), getKeyData(), keyLen);
 }
 
 }  // namespace art
\ No newline at end of file
@@ -133,6 +133,9 @@ class Node {
 
   static void deleteNode(Node *node);
 
+  // Size in bytes of the allocation backing the given inner node
+  static std::size_t sizeOf(const Node *node);
+
   //===--------------------------------------------------------------------===//
   // NODE ACCESS
   //===--------------------------------------------------------------------===//
@@ -143,7 +146,8 @@ class Node {
   // Get any child of the current node.
   static Node *getAnyChild(const Node *n);
 
-  static TID getAnyChildTid(const Node *n, bool &needRestart);
+  // Get any leaf in the subtree rooted at the current node
+  static const Node *getAnyChildLeaf(const Node *n, bool &needRestart);
 
   static std::tuple<Node *, uint8_t> getSecondChild(Node *node, uint8_t k);
 
@@ -382,6 +386,9 @@ class LeafNode {
   OptimisticRWLock lock;
   uint32_t count;
   uint32_t capacity;
+  // Length of the full key stored after the values, zero if the tree does
+  // not store keys
+  uint32_t keyLen;
   TID vals[0];
 
  public:
@@ -406,14 +413,53 @@ class LeafNode {
                          uint8_t parentKey, Node *parent, uint64_t pv,
                          bool &needRestart, ThreadInfo &threadInfo);
   static bool removeShrink(Node *n, TID val, uint8_t parentKey, Node *parent,
-                           uint64_t pv, bool &needRestart,
+                           uint64_t pv, bool inlineLast, bool &needRestart,
                            ThreadInfo &threadInfo);
 
-  static LeafNode *create(uint32_t capacity);
+  static LeafNode *create(uint32_t capacity, uint32_t keyLen,
+                          ThreadInfo &threadInfo);
+
+  //===--------------------------------------------------------------------===//
+  // LEAVES WITH KEYS
+  //
+  // A tree that stores keys never inlines TIDs. Every key has an external
+  // leaf that holds a copy of the full key, which readers compare against
+  // instead of loading the key of a TID. The key never changes while the
+  // leaf is reachable, so it can be read without the leaf lock.
+  //===--------------------------------------------------------------------===//
+
+  // Create an external leaf holding the given key and TID
+  static Node *createWithKey(const Key &k, TID tid, ThreadInfo &threadInfo);
+
+  // Copy the key stored in the given external leaf
+  static void loadKey(const Node *n, Key &key);
+
+  // Write-lock the given external leaf if it holds only the given TID
+  static bool lockIfOnly(Node *n, TID val, bool &needRestart);
+
+  static void unlock(Node *n);
+
+  // Unlock a leaf locked through lockIfOnly() that has been unlinked from
+  // its parent and hand it to the epoch
+  static void unlinkLocked(Node *n, ThreadInfo &threadInfo);
+
+  // Hand a leaf that was never linked into the tree to the epoch
+  static void discard(Node *n, ThreadInfo &threadInfo);
+
+  // Size in bytes of a leaf able to hold the given number of TIDs and a key
+  // of the given length
+  static std::size_t sizeOf(uint32_t capacity, uint32_t keyLen) {
+    return sizeof(LeafNode) + (sizeof(TID) * capacity) + keyLen;
+  }
 
  private:
   // Private constructor, use factory method
-  explicit LeafNode(uint32_t capacity);
+  LeafNode(uint32_t capacity, uint32_t keyLen);
+
+  uint8_t *getKeyData() { return reinterpret_cast<uint8_t *>(vals + capacity); }
+  const uint8_t *getKeyData() const {
+    return reinterpret_cast<const uint8_t *>(vals + capacity);
+  }
 
   //===--------------------------------------------------------------------===//
   // LOCKING
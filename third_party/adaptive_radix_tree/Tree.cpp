@@ -9,7 +9,9 @@
 namespace art {
 
 Tree::Tree(LoadKeyFunction loadKey, void *ctx)
-    : root(new Node256(nullptr, 0)), keyLoader(loadKey, ctx), epoch(256) {}
+    : root(new Node256(nullptr, 0)), keyLoader(loadKey, ctx), epoch(256) {
+  epoch.trackAllocation(sizeof(Node256));
+}
 
 Tree::~Tree() {
   Node::deleteChildren(root);
@@ -26,10 +28,17 @@ void yield(int count) {
   }
 }
 
-TID Tree::checkKey(const TID tid, const Key &k) const {
+bool Tree::checkKey(const Node *leaf, const Key &k) const {
   Key kt;
-  keyLoader.load(tid, kt);
-  return (k == kt ? tid : 0);
+  keyLoader.load(leaf, kt);
+  return k == kt;
+}
+
+Node *Tree::newLeaf(const Key &k, TID tid, ThreadInfo &threadInfo) const {
+  if (keyLoader.storesKeys()) {
+    return LeafNode::createWithKey(k, tid, threadInfo);
+  }
+  return Node::setLeaf(tid);
 }
 
 void Tree::setLoadKeyFunc(Tree::LoadKeyFunction loadKey, void *ctx) {
@@ -84,7 +93,7 @@ restart:
           if (needRestart) goto restart;
 
           if (level < k.getKeyLen() - 1 || optimisticPrefixMatch) {
-            if (checkKey(results[0], k) == 0) {
+            if (!checkKey(node, k)) {
               // Optimistic prefix match failed
               results.clear();
               return false;
@@ -104,6 +113,143 @@ restart:
   }
 }
 
+void Tree::lookupBatch(const std::vector<Key> &keys,
+                       std::vector<std::vector<TID>> &results,
+                       ThreadInfo &threadEpochInfo) const {
+  EpochGuardReadonly epochGuard(threadEpochInfo);
+
+  // A node on the path of the previous key, with the version it had and the
+  // key level at which its prefix check started
+  struct PathEntry {
+    Node *node;
+    uint64_t version;
+    uint32_t level;
+    bool optimisticPrefixMatch;
+  };
+  std::vector<PathEntry> path;
+
+  results.resize(keys.size());
+
+  for (std::size_t i = 0; i < keys.size(); i++) {
+    const Key &k = keys[i];
+    std::vector<TID> &keyResults = results[i];
+
+    // Only nodes reached through bytes the two keys share are on the path of
+    // this key as well
+    if (i > 0) {
+      const Key &prev = keys[i - 1];
+      uint32_t common = 0;
+      uint32_t maxCommon = std::min(k.getKeyLen(), prev.getKeyLen());
+      while (common < maxCommon && k[common] == prev[common]) {
+        common++;
+      }
+      while (!path.empty() && path.back().level > common) {
+        path.pop_back();
+      }
+    }
+
+    int restartCount = 0;
+  restart:
+    if (restartCount++) yield(restartCount);
+    bool needRestart = false;
+    keyResults.clear();
+
+    Node *node;
+    Node *parentNode = nullptr;
+    uint64_t v;
+    uint32_t level;
+    bool optimisticPrefixMatch;
+
+    if (path.empty()) {
+      node = root;
+      level = 0;
+      optimisticPrefixMatch = false;
+      v = node->readLockOrRestart(needRestart);
+      if (needRestart) goto restart;
+      path.push_back({node, v, level, optimisticPrefixMatch});
+    } else {
+      // Resume at the deepest shared node. If it changed since the previous
+      // key passed it, the path might no longer lead there
+      const PathEntry &entry = path.back();
+      node = entry.node;
+      level = entry.level;
+      optimisticPrefixMatch = entry.optimisticPrefixMatch;
+      v = node->readLockOrRestart(needRestart);
+      if (needRestart || v != entry.version) {
+        path.clear();
+        goto restart;
+      }
+    }
+
+    while (true) {
+      switch (checkPrefix(node, k, level)) {  // Increases level
+        case CheckPrefixResult::NoMatch:
+          node->readUnlockOrRestart(v, needRestart);
+          if (needRestart) {
+            path.clear();
+            goto restart;
+          }
+          goto next_key;
+        case CheckPrefixResult::OptimisticMatch:
+          optimisticPrefixMatch = true;
+        // Fallthrough
+        case CheckPrefixResult::Match:
+          if (k.getKeyLen() <= level) {
+            goto next_key;
+          }
+          parentNode = node;
+          node = Node::getChild(k[level], parentNode);
+          parentNode->checkOrRestart(v, needRestart);
+          if (needRestart) {
+            path.clear();
+            goto restart;
+          }
+
+          if (node == nullptr) {
+            goto next_key;
+          }
+          if (Node::isLeaf(node)) {
+            parentNode->readUnlockOrRestart(v, needRestart);
+            if (needRestart) {
+              path.clear();
+              goto restart;
+            }
+
+            LeafNode::readLeaf(node, keyResults, needRestart);
+            if (needRestart) {
+              path.clear();
+              goto restart;
+            }
+
+            if (level < k.getKeyLen() - 1 || optimisticPrefixMatch) {
+              if (!checkKey(node, k)) {
+                keyResults.clear();
+              }
+            }
+            goto next_key;
+          }
+          level++;
+      }
+      uint64_t nv = node->readLockOrRestart(needRestart);
+      if (needRestart) {
+        path.clear();
+        goto restart;
+      }
+
+      parentNode->readUnlockOrRestart(v, needRestart);
+      if (needRestart) {
+        path.clear();
+        goto restart;
+      }
+      v = nv;
+      path.push_back({node, v, level, optimisticPrefixMatch});
+    }
+
+  next_key:
+    continue;
+  }
+}
+
 bool Tree::lookupRange(const Key &start, const Key &end, Key &continueKey,
                        std::vector<TID> &results, uint32_t softMaxResults,
                        ThreadInfo &threadEpochInfo) const {
@@ -117,7 +263,7 @@ bool Tree::lookupRange(const Key &start, const Key &end, Key &continueKey,
   }
 
   EpochGuard epochGuard(threadEpochInfo);
-  TID toContinue = 0;
+  const Node *toContinue = nullptr;
 
   // This function copies all leaves in the tree rooted at the provided node
   // into the result vector, stopping if the result size exceeds the limited
@@ -127,7 +273,7 @@ bool Tree::lookupRange(const Key &start, const Key &end, Key &continueKey,
                                                       bool &needRestart) {
         if (Node::isLeaf(node)) {
           if (results.size() >= softMaxResults) {
-            toContinue = Node::getLeaf(node);
+            toContinue = node;
             return;
           }
           LeafNode::readLeaf(node, results, needRestart);
@@ -141,7 +287,7 @@ bool Tree::lookupRange(const Key &start, const Key &end, Key &continueKey,
             const Node *n = std::get<1>(children[i]);
             copy(n, needRestart);
             if (needRestart) return;
-            if (toContinue != 0) {
+            if (toContinue != nullptr) {
               break;
             }
           }
@@ -223,7 +369,7 @@ bool Tree::lookupRange(const Key &start, const Key &end, Key &continueKey,
                 copy(n, needRestart);
                 if (needRestart) return;
               }
-              if (toContinue != 0) {
+              if (toContinue != nullptr) {
                 break;
               }
             }
@@ -300,7 +446,7 @@ bool Tree::lookupRange(const Key &start, const Key &end, Key &continueKey,
                 copy(n, needRestart);
                 if (needRestart) return;
               }
-              if (toContinue != 0) {
+              if (toContinue != nullptr) {
                 break;
               }
             }
@@ -319,6 +465,7 @@ restart:
   // Every restart means to clear the results we've collected so far
   // TODO(pmenon): We just need to restart search at last failed key
   results.clear();
+  toContinue = nullptr;
 
   uint32_t level = 0;
   Node *node = nullptr;
@@ -375,7 +522,7 @@ restart:
               findEnd(n, k, level + 1, node, v, needRestart);
               if (needRestart) goto restart;
             }
-            if (toContinue) {
+            if (toContinue != nullptr) {
               break;
             }
           }
@@ -404,7 +551,7 @@ restart:
     }
     break;
   }
-  if (toContinue != 0) {
+  if (toContinue != nullptr) {
     keyLoader.load(toContinue, continueKey);
     return true;
   } else {
@@ -460,9 +607,10 @@ restart:
         // 1) Create a new node which will be parent of the current node. Set
         //    common prefix and level to this node.
         auto newNode = new Node4(node->getPrefix(), nextLevel - level);
+        epoch.trackAllocation(sizeof(Node4));
 
         // 2)  Add node and (*k, tid) as children
-        newNode->insert(k[nextLevel], Node::setLeaf(tid));
+        newNode->insert(k[nextLevel], newLeaf(k, tid, epochInfo));
         newNode->insert(nonMatchingKey, node);
 
         // 3) UpgradeToWriteLockOrRestart, update parentNode to point to the new
@@ -487,10 +635,13 @@ restart:
     if (needRestart) goto restart;
 
     if (nextNode == nullptr) {
+      Node *leaf = newLeaf(k, tid, epochInfo);
       Node::insertAndUnlock(node, v, parentNode, parentVersion, parentKey,
-                            nodeKey, Node::setLeaf(tid), needRestart,
-                            epochInfo);
-      if (needRestart) goto restart;
+                            nodeKey, leaf, needRestart, epochInfo);
+      if (needRestart) {
+        LeafNode::discard(leaf, epochInfo);
+        goto restart;
+      }
       return true;
     }
 
@@ -501,7 +652,7 @@ restart:
 
     if (Node::isLeaf(nextNode)) {
       Key key;
-      keyLoader.load(Node::getLeaf(nextNode), key);
+      keyLoader.load(nextNode, key);
 
       if (key == k) {
         bool inserted = LeafNode::insertGrow(nextNode, tid, predicate, k[level],
@@ -520,7 +671,8 @@ restart:
       }
 
       auto n4 = new Node4(&k[level], prefixLength);
-      n4->insert(k[level + prefixLength], Node::setLeaf(tid));
+      epoch.trackAllocation(sizeof(Node4));
+      n4->insert(k[level + prefixLength], newLeaf(k, tid, epochInfo));
       n4->insert(key[level + prefixLength], nextNode);
       Node::change(node, k[level - 1], Node::setNonLeaf(n4));
       node->writeUnlock();
@@ -572,21 +724,37 @@ restart:
           return false;
         }
         if (Node::isLeaf(nextNode)) {
+          // A leaf that carries the key is unlinked like an inlined TID once
+          // its last TID is removed. It is locked along with its parent so
+          // that no TID can be added to it in the meantime
+          bool unlinkLeaf = false;
           if (LeafNode::isInlined(nextNode) && Node::getLeaf(nextNode) != tid) {
             return false;
           } else if (LeafNode::isExternal(nextNode)) {
-            return LeafNode::removeShrink(nextNode, tid, k[level], node, v,
-                                          needRestart, threadInfo);
+            unlinkLeaf = keyLoader.storesKeys() &&
+                         LeafNode::lockIfOnly(nextNode, tid, needRestart);
+            if (needRestart) goto restart;
+            if (!unlinkLeaf) {
+              bool removed = LeafNode::removeShrink(
+                  nextNode, tid, k[level], node, v, !keyLoader.storesKeys(),
+                  needRestart, threadInfo);
+              if (needRestart) goto restart;
+              return removed;
+            }
           }
 
           assert(parentNode == nullptr || node->getCount() != 1);
           if (node->getCount() == 2 && parentNode != nullptr) {
             parentNode->upgradeToWriteLockOrRestart(parentVersion, needRestart);
-            if (needRestart) goto restart;
+            if (needRestart) {
+              if (unlinkLeaf) LeafNode::unlock(nextNode);
+              goto restart;
+            }
 
             node->upgradeToWriteLockOrRestart(v, needRestart);
             if (needRestart) {
               parentNode->writeUnlock();
+              if (unlinkLeaf) LeafNode::unlock(nextNode);
               goto restart;
             }
             // 1. check remaining entries
@@ -600,12 +768,13 @@ restart:
 
               parentNode->writeUnlock();
               node->writeUnlockObsolete();
-              epoch.markNodeForDeletion(node, threadInfo);
+              epoch.markNodeForDeletion(node, Node::sizeOf(node), threadInfo);
             } else {
               secondNodeN->writeLockOrRestart(needRestart);
               if (needRestart) {
                 node->writeUnlock();
                 parentNode->writeUnlock();
+                if (unlinkLeaf) LeafNode::unlock(nextNode);
                 goto restart;
               }
 
@@ -617,13 +786,17 @@ restart:
               secondNodeN->writeUnlock();
 
               node->writeUnlockObsolete();
-              epoch.markNodeForDeletion(node, threadInfo);
+              epoch.markNodeForDeletion(node, Node::sizeOf(node), threadInfo);
             }
           } else {
             Node::removeAndUnlock(node, v, k[level], parentNode, parentVersion,
                                   parentKey, needRestart, threadInfo);
-            if (needRestart) goto restart;
+            if (needRestart) {
+              if (unlinkLeaf) LeafNode::unlock(nextNode);
+              goto restart;
+            }
           }
+          if (unlinkLeaf) LeafNode::unlinkLocked(nextNode, threadInfo);
           return true;
         }
         level++;
@@ -662,9 +835,9 @@ Tree::CheckPrefixPessimisticResult Tree::checkPrefixPessimistic(
     Key kt;
     for (uint32_t i = 0; i < n->getPrefixLength(); ++i) {
       if (i == maxStoredPrefixLength) {
-        auto anyTID = Node::getAnyChildTid(n, needRestart);
+        auto anyLeaf = Node::getAnyChildLeaf(n, needRestart);
         if (needRestart) return CheckPrefixPessimisticResult::Match;
-        keyLoader.load(anyTID, kt);
+        keyLoader.load(anyLeaf, kt);
       }
       uint8_t curKey =
           i >= maxStoredPrefixLength ? kt[level] : n->getPrefix()[i];
@@ -672,9 +845,9 @@ Tree::CheckPrefixPessimisticResult Tree::checkPrefixPessimistic(
         nonMatchingKey = curKey;
         if (n->getPrefixLength() > maxStoredPrefixLength) {
           if (i < maxStoredPrefixLength) {
-            auto anyTID = Node::getAnyChildTid(n, needRestart);
+            auto anyLeaf = Node::getAnyChildLeaf(n, needRestart);
             if (needRestart) return CheckPrefixPessimisticResult::Match;
-            keyLoader.load(anyTID, kt);
+            keyLoader.load(anyLeaf, kt);
           }
           memcpy(nonMatchingPrefix, &kt[0] + level + 1,
                  std::min((n->getPrefixLength() - (level - prevLevel) - 1),
@@ -700,9 +873,9 @@ Tree::PCCompareResults Tree::checkPrefixCompare(const Node *n, const Key &k,
     Key kt;
     for (uint32_t i = 0; i < n->getPrefixLength(); ++i) {
       if (i == maxStoredPrefixLength) {
-        auto anyTID = Node::getAnyChildTid(n, needRestart);
+        auto anyLeaf = Node::getAnyChildLeaf(n, needRestart);
         if (needRestart) return PCCompareResults::Equal;
-        keyLoader.load(anyTID, kt);
+        keyLoader.load(anyLeaf, kt);
       }
       uint8_t kLevel = (k.getKeyLen() > level) ? k[level] : fillKey;
 
@@ -727,9 +900,9 @@ Tree::PCEqualsResults Tree::checkPrefixEquals(const Node *n, uint32_t &level,
     Key kt;
     for (uint32_t i = 0; i < n->getPrefixLength(); ++i) {
       if (i == maxStoredPrefixLength) {
-        auto anyTID = Node::getAnyChildTid(n, needRestart);
+        auto anyLeaf = Node::getAnyChildLeaf(n, needRestart);
         if (needRestart) return PCEqualsResults::BothMatch;
-        keyLoader.load(anyTID, kt);
+        keyLoader.load(anyLeaf, kt);
       }
       uint8_t startLevel = (start.getKeyLen() > level) ? start[level] : 0;
       uint8_t endLevel = (end.getKeyLen() > level) ? end[level] : 255;
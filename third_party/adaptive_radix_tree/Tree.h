@@ -13,7 +13,8 @@ class Tree {
   using LoadKeyFunction = void (*)(void *ctx, TID tid, Key &key);
 
  public:
-  /// Constructor
+  /// Constructor. If no load-key function is given, the tree stores a copy of
+  /// the full key in every leaf and never has to load keys of TIDs.
   explicit Tree(LoadKeyFunction loadKey, void *arg);
 
   ~Tree();
@@ -30,6 +31,14 @@ class Tree {
   bool lookup(const Key &k, std::vector<TID> &results,
               ThreadInfo &threadEpochInfo) const;
 
+  /// Lookup TIDs for a batch of full keys. results[i] receives the TIDs of
+  /// keys[i]. A key resumes the descent at the deepest node that the
+  /// previous key passed through and whose path it shares, so sorted keys
+  /// skip the common part of their traversals.
+  void lookupBatch(const std::vector<Key> &keys,
+                   std::vector<std::vector<TID>> &results,
+                   ThreadInfo &threadEpochInfo) const;
+
   /// Looks up all key-value pairs between the provided start and end keys.
   /// Results are placed in the provided result vector (of the provided size).
   /// The actual number of results that were inserted is in the output parameter
@@ -51,10 +60,24 @@ class Tree {
   /// Remove the provided key-value pair from the tree
   bool remove(const Key &k, TID tid, ThreadInfo &epochInfo);
 
+  /// Has no effect if the tree stores the keys in its leaves
   void setLoadKeyFunc(LoadKeyFunction loadKey, void *ctx);
 
+  /// Whether the tree stores the full keys in its leaves
+  bool storesKeys() const { return keyLoader.storesKeys(); }
+
+  /// Bytes held by inner nodes and external leaves, including nodes that are
+  /// unlinked and waiting for garbage collection
+  std::size_t getMemoryUsage() const { return epoch.getAllocatedBytes(); }
+
+  /// Bytes held by unlinked nodes that the epoch has not yet reclaimed
+  std::size_t getGarbageMemoryUsage() const {
+    return epoch.getGarbageBytes();
+  }
+
  private:
-  // Class to help loading the key for a given TID
+  // Class to help loading the key for a given leaf, either from the leaf
+  // itself or through the load-key function
   class KeyLoader {
    private:
     LoadKeyFunction loadKey;
@@ -62,22 +85,32 @@ class Tree {
 
    public:
     KeyLoader(LoadKeyFunction _loadKey, void *_ctx)
-        : loadKey(nullptr), ctx(nullptr) {
-      reset(_loadKey, _ctx);
-    }
+        : loadKey(_loadKey), ctx(_ctx) {}
 
     void reset(LoadKeyFunction _loadKey, void *_ctx) {
       assert(_loadKey != nullptr);
+      if (storesKeys()) return;
       loadKey = _loadKey;
       ctx = _ctx;
     }
 
-    void load(TID tid, Key &key) const { loadKey(ctx, tid, key); }
+    bool storesKeys() const { return loadKey == nullptr; }
+
+    void load(const Node *leaf, Key &key) const {
+      if (storesKeys()) {
+        LeafNode::loadKey(leaf, key);
+      } else {
+        loadKey(ctx, Node::getLeaf(leaf), key);
+      }
+    }
   };
 
-  /// Function to check that the key for the provided TID is correct. This is
+  /// Function to check that the key of the provided leaf is correct. This is
   /// done by loading the key and performing a comparison with the provided key.
-  TID checkKey(TID tid, const Key &k) const;
+  bool checkKey(const Node *leaf, const Key &k) const;
+
+  /// Create the leaf for a new key
+  Node *newLeaf(const Key &k, TID tid, ThreadInfo &threadInfo) const;
 
   /// Optimistic prefix check
   enum class CheckPrefixResult : uint8_t { Match, NoMatch, OptimisticMatch };
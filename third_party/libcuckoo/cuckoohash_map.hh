@@ -552,6 +552,35 @@ public:
         return (st == ok);
     }
 
+    //! erase_fn runs \p fn on the value associated with \p key, and erases
+    //! the key-value pair if \p fn returns true. \p fn will be passed one
+    //! argument of type \p mapped_type& and can modify the argument. If \p
+    //! key is not there, it returns false, otherwise it returns true.
+    template <typename Eraser>
+    bool erase_fn(const key_type& key, Eraser fn) {
+        size_t hv = hashed_key(key);
+        auto b = snapshot_and_lock_two(hv);
+        const partial_t partial = partial_key(hv);
+        if (try_erase_bucket_fn(partial, key, fn, buckets_[b.i[0]])) {
+            return true;
+        }
+        return try_erase_bucket_fn(partial, key, fn, buckets_[b.i[1]]);
+    }
+
+    //! prefetch brings the two buckets \p key can live in into the cache,
+    //! without taking their locks. A batch of lookups can prefetch all of its
+    //! keys first, so that the cache misses overlap. If the table is resized
+    //! in the meantime the prefetched lines are just useless, since a
+    //! prefetch never faults.
+    void prefetch(const key_type& key) const {
+        size_t hv = hashed_key(key);
+        size_t hp = get_hashpower();
+        size_t i1 = index_hash(hp, hv);
+        size_t i2 = alt_index(hp, partial_key(hv), i1);
+        __builtin_prefetch(&buckets_[i1]);
+        __builtin_prefetch(&buckets_[i2]);
+    }
+
     //! upsert is a combination of update_fn and insert. It first tries updating
     //! the value associated with \p key using \p fn. If \p key is not in the
     //! table, then it runs an insert with \p key and \p val. It will always
@@ -1397,6 +1426,31 @@ private:
         return false;
     }
 
+    // try_erase_bucket_fn will search the bucket for the given key, run the
+    // given function on its value, and erase the key if the function returns
+    // true.
+    template <typename Eraser>
+    bool try_erase_bucket_fn(const partial_t partial, const key_type &key,
+                             Eraser fn, Bucket& b) {
+        for (size_t i = 0; i < slot_per_bucket; ++i) {
+            if (!b.occupied(i)) {
+                continue;
+            }
+            if (!is_simple && b.partial(i) != partial) {
+                continue;
+            }
+            if (key_eq()(b.key(i), key)) {
+                if (fn(b.val(i))) {
+                    b.eraseKV(i);
+                    num_deletes_[get_counterid()].num.fetch_add(
+                        1, std::memory_order_relaxed);
+                }
+                return true;
+            }
+        }
+        return false;
+    }
+
     // cuckoo_find searches the table for the given key and value, storing the
     // value in the val if it finds the key. It expects the locks to be taken
     // and released outside the function.